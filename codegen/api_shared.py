@@ -575,10 +575,12 @@ def outputfntables(namespace, data):
 
 	print("};\n");
 
-def outputfntabledecls(namespace, data):
+def outputfntabledecls(namespace, data, classes=None):
 	lastclass = ''
 	lastmethod = ''
 	fntablename = ''
+	# Each table starts on its own cache line so a hot interface never shares one with a cold table.
+	# Only the definitions are aligned, the table structs in openvr_capi.h keep their layout.
 	for method in data['methods']:
 		if (len(method) > 0):
 			returntype = method['returntype']
@@ -596,6 +598,8 @@ def outputfntabledecls(namespace, data):
 
 			if(namespace != getnamespace(classname)):
 				continue
+			if(classes is not None and classname not in classes):
+				continue
 
 			classname = getclasswithoutnamespace(classname)
 			if(classname != lastclass):
@@ -603,7 +607,7 @@ def outputfntabledecls(namespace, data):
 					print("};\n\n");
 
 				fntablename = method['classname'].replace('vr::', 'VR::').replace('::', '_') + '_FnTable'
-				print("static " + fntablename + " g_" + fntablename + " =\n{")
+				print("alignas( 64 ) static " + fntablename + " g_" + fntablename + " =\n{")
 				lastclass = classname
 
 			print('\t&' + fntablename + '_' + methodname + ',')
@@ -643,7 +647,46 @@ def outputfntableaccess(namespace, data):
 				print('FnTableRegistration autoreg_'+fntablename+'( '+classname+'_Version, &g_'+fntablename+' );')
 				lastclass = classname
 
-def outputfntablefuncs(namespace, data):
+# Returns the C++ structs that cross the C API by value, as ( C++ type, C type ) pairs.
+def fntablebyvaluestructs(namespace, data, classes=None):
+	structs = []
+	for method in data['methods']:
+		if(namespace != getnamespace(method['classname'])):
+			continue
+		if(classes is not None and method['classname'] not in classes):
+			continue
+		types = [method['returntype']]
+		if('params' in method):
+			types += [param['paramtype'] for param in method['params']]
+		for thetype in types:
+			if(thetype.startswith('struct ') and not thetype.endswith('*') and ctype(thetype) != thetype):
+				if((thetype[7:], ctype(thetype)) not in structs):
+					structs.append((thetype[7:], ctype(thetype)))
+	return structs
+
+# Returns the arguments a thunk passes on to the C++ method, converted from the C parameters.
+def fntablecallargs(method):
+	paramlist = []
+	if('params' in method):
+		for param in method['params']:
+			paramtype = param['paramtype']
+			cparamtype = ctype(paramtype)
+			if paramtype != cparamtype:
+				if paramtype.startswith('struct'):
+					paramlist.append('*('+paramtype+'*)&'+param['paramname'])
+				else:
+					paramlist.append('('+paramtype+')'+param['paramname'])
+			else:
+				paramlist.append(param['paramname'])
+	return paramlist
+
+def outputfntablefuncs(namespace, data, classes=None):
+	# The thunks hand these structs across by reinterpreting their storage instead of copying
+	# them member by member, which is only valid while both headers agree on the layout.
+	for cpptype, thectype in fntablebyvaluestructs(namespace, data, classes):
+		print('static_assert( sizeof( ' + thectype + ' ) == sizeof( ' + cpptype + ' ) && alignof( ' + thectype + ' ) == alignof( ' + cpptype + ' ), "' + getclasswithoutnamespace(cpptype) + ' differs between openvr_capi.h and openvr.h" );')
+	print('')
+
 	lastclass = ''
 	lastmethod = ''
 	instancename = ''
@@ -664,6 +707,8 @@ def outputfntablefuncs(namespace, data):
 
 			if(namespace != getnamespace(classname)):
 				continue
+			if(classes is not None and classname not in classes):
+				continue
 
 			classname = getclasswithoutnamespace(classname)
 			if(classname != lastclass):
@@ -684,18 +729,7 @@ def outputfntablefuncs(namespace, data):
 
 			print('('+", ".join(paramlist)+")\n{")
 
-			paramlist = []
-			if('params' in method):
-				for param in method['params']:
-					paramtype = param['paramtype']
-					cparamtype = ctype(paramtype)
-					if paramtype != cparamtype:
-						if paramtype.startswith('struct'):
-							paramlist.append('*('+paramtype+'*)&'+param['paramname'])
-						else:
-							paramlist.append('('+paramtype+')'+param['paramname'])
-					else:
-						paramlist.append(param['paramname'])
+			paramlist = fntablecallargs(method)
 
 			# if the method is a destructor
 			if(method['methodname'][:8] == 'Destruct'):
@@ -707,11 +741,13 @@ def outputfntablefuncs(namespace, data):
 					sys.stdout.write(", ".join(paramlist))
 				sys.stdout.write (');')
 			elif (creturntype.startswith('struct') and creturntype != returntype):
-				sys.stdout.write (returntype+' result = '+instancename+'->'+method['methodname']+'(')
+				# construct the C++ result straight into the C return slot rather than copying it over
+				sys.stdout.write (creturntype+' result;\n')
+				sys.stdout.write ('new ( &result ) '+returntype[7:]+'( '+instancename+'->'+method['methodname']+'(')
 				if('params' in method):
 					sys.stdout.write(", ".join(paramlist))
-				sys.stdout.write (');\n')
-				sys.stdout.write ('return *('+creturntype+'*)&result;')
+				sys.stdout.write (') );\n')
+				sys.stdout.write ('return result;')
 			else:
 				if creturntype != returntype:
 					sys.stdout.write ('return ('+creturntype+')'+instancename+'->'+method['methodname']+'(')
@@ -0,0 +1,183 @@
+import json
+import sys
+
+# English descriptions of EVRInitError values. These are not part of the json,
+# so they are maintained here; the code is appended from the json so the two
+# cannot drift apart. Values without a description report their ID instead.
+descriptions = {
+	'VRInitError_None' : 'No Error',
+
+	'VRInitError_Init_InstallationNotFound' : 'Installation Not Found',
+	'VRInitError_Init_InstallationCorrupt' : 'Installation Corrupt',
+	'VRInitError_Init_VRClientDLLNotFound' : 'vrclient Shared Lib Not Found',
+	'VRInitError_Init_FileNotFound' : 'File Not Found',
+	'VRInitError_Init_FactoryNotFound' : 'Factory Function Not Found',
+	'VRInitError_Init_InterfaceNotFound' : 'Interface Not Found',
+	'VRInitError_Init_InvalidInterface' : 'Invalid Interface',
+	'VRInitError_Init_UserConfigDirectoryInvalid' : 'User Config Directory Invalid',
+	'VRInitError_Init_HmdNotFound' : 'Hmd Not Found',
+	'VRInitError_Init_NotInitialized' : 'Not Initialized',
+	'VRInitError_Init_PathRegistryNotFound' : 'Installation path could not be located',
+	'VRInitError_Init_NoConfigPath' : 'Config path could not be located',
+	'VRInitError_Init_NoLogPath' : 'Log path could not be located',
+	'VRInitError_Init_PathRegistryNotWritable' : 'Unable to write path registry',
+	'VRInitError_Init_AppInfoInitFailed' : 'App info manager init failed',
+	'VRInitError_Init_Retry' : 'Internal Retry',
+	'VRInitError_Init_InitCanceledByUser' : 'User Canceled Init',
+	'VRInitError_Init_AnotherAppLaunching' : 'Another app was already launching',
+	'VRInitError_Init_SettingsInitFailed' : 'Settings manager init failed',
+	'VRInitError_Init_ShuttingDown' : 'VR system shutting down',
+	'VRInitError_Init_TooManyObjects' : 'Too many tracked objects',
+	'VRInitError_Init_NoServerForBackgroundApp' : 'Not starting vrserver for background app',
+	'VRInitError_Init_NotSupportedWithCompositor' : 'The requested interface is incompatible with the compositor and the compositor is running',
+	'VRInitError_Init_NotAvailableToUtilityApps' : 'This interface is not available to utility applications',
+	'VRInitError_Init_Internal' : 'vrserver internal error',
+	'VRInitError_Init_HmdDriverIdIsNone' : 'Hmd DriverId is invalid',
+	'VRInitError_Init_HmdNotFoundPresenceFailed' : 'Hmd Not Found Presence Failed',
+	'VRInitError_Init_VRMonitorNotFound' : 'VR Monitor Not Found',
+	'VRInitError_Init_VRMonitorStartupFailed' : 'VR Monitor startup failed',
+	'VRInitError_Init_LowPowerWatchdogNotSupported' : 'Low Power Watchdog Not Supported',
+	'VRInitError_Init_InvalidApplicationType' : 'Invalid Application Type',
+	'VRInitError_Init_NotAvailableToWatchdogApps' : 'Not available to watchdog apps',
+	'VRInitError_Init_WatchdogDisabledInSettings' : 'Watchdog disabled in settings',
+	'VRInitError_Init_VRDashboardNotFound' : 'VR Dashboard Not Found',
+	'VRInitError_Init_VRDashboardStartupFailed' : 'VR Dashboard startup failed',
+	'VRInitError_Init_VRHomeNotFound' : 'VR Home Not Found',
+	'VRInitError_Init_VRHomeStartupFailed' : 'VR home startup failed',
+	'VRInitError_Init_RebootingBusy' : 'Rebooting In Progress',
+	'VRInitError_Init_FirmwareUpdateBusy' : 'Firmware Update In Progress',
+	'VRInitError_Init_FirmwareRecoveryBusy' : 'Firmware Recovery In Progress',
+	'VRInitError_Init_USBServiceBusy' : 'USB Service Busy',
+	'VRInitError_Init_VRDashboardServicePending' : 'VR Dashboard startup failed, vrservice was pending for too long',
+	'VRInitError_Init_VRDashboardServiceTimeout' : 'VR Dashboard startup failed, attempt to communicate with vrservice timed out',
+	'VRInitError_Init_VRDashboardServiceStopped' : 'VR Dashboard startup failed, vrservice was stopped',
+	'VRInitError_Init_VRDashboardAlreadyStarted' : 'VR Dashboard startup failed, vrdashboard was already running',
+	'VRInitError_Init_VRDashboardCopyFailed' : 'VR Dashboard startup failed, required files did not copy correctly',
+	'VRInitError_Init_VRDashboardTokenFailure' : 'VR Dashboard startup failed, unable to create appropriate token',
+	'VRInitError_Init_VRDashboardEnvironmentFailure' : 'VR Dashboard startup failed, unable to create appropriate environment',
+	'VRInitError_Init_VRDashboardPathFailure' : 'VR Dashboard startup failed, path error',
+
+	'VRInitError_Driver_Failed' : 'Driver Failed',
+	'VRInitError_Driver_Unknown' : 'Driver Not Known',
+	'VRInitError_Driver_HmdUnknown' : 'HMD Not Known',
+	'VRInitError_Driver_NotLoaded' : 'Driver Not Loaded',
+	'VRInitError_Driver_RuntimeOutOfDate' : 'Driver runtime is out of date',
+	'VRInitError_Driver_HmdInUse' : 'HMD already in use by another application',
+	'VRInitError_Driver_NotCalibrated' : 'Device is not calibrated',
+	'VRInitError_Driver_CalibrationInvalid' : 'Device Calibration is invalid',
+	'VRInitError_Driver_HmdDisplayNotFound' : 'HMD detected over USB, but Monitor not found',
+	'VRInitError_Driver_TrackedDeviceInterfaceUnknown' : 'Driver Tracked Device Interface unknown',
+	'VRInitError_Driver_HmdDriverIdOutOfBounds' : 'Hmd DriverId is our of bounds',
+	'VRInitError_Driver_HmdDisplayMirrored' : 'HMD detected over USB, but Monitor may be mirrored instead of extended',
+	'VRInitError_Driver_HmdDisplayNotFoundLaptop' : 'On laptop, HMD detected over USB, but Monitor not found',
+	'VRInitError_Driver_PeerDriverNotInstalled' : 'The current HMD requires an additional driver that is not installed',
+	'VRInitError_Driver_WirelessHmdNotConnected' : 'A wireless HMD driver is present, but the wireless HMD has not connected yet',
+
+	'VRInitError_IPC_ServerInitFailed' : 'VR Server Init Failed',
+	'VRInitError_IPC_ConnectFailed' : 'Connect to VR Server Failed',
+	'VRInitError_IPC_SharedStateInitFailed' : 'Shared IPC State Init Failed',
+	'VRInitError_IPC_CompositorInitFailed' : 'Shared IPC Compositor Init Failed',
+	'VRInitError_IPC_MutexInitFailed' : 'Shared IPC Mutex Init Failed',
+	'VRInitError_IPC_Failed' : 'Shared IPC Failed',
+	'VRInitError_IPC_CompositorConnectFailed' : 'Shared IPC Compositor Connect Failed',
+	'VRInitError_IPC_CompositorInvalidConnectResponse' : 'Shared IPC Compositor Invalid Connect Response',
+	'VRInitError_IPC_ConnectFailedAfterMultipleAttempts' : 'Shared IPC Connect Failed After Multiple Attempts',
+	'VRInitError_IPC_ConnectFailedAfterTargetExited' : 'Shared IPC Connect Failed After Target Exited',
+	'VRInitError_IPC_NamespaceUnavailable' : 'Shared IPC Namespace Unavailable',
+
+	'VRInitError_Compositor_Failed' : 'Compositor failed to initialize',
+	'VRInitError_Compositor_D3D11HardwareRequired' : 'Compositor failed to find DX11 hardware',
+	'VRInitError_Compositor_FirmwareRequiresUpdate' : 'Compositor requires mandatory firmware update',
+	'VRInitError_Compositor_OverlayInitFailed' : 'Compositor initialization succeeded, but overlay init failed',
+	'VRInitError_Compositor_ScreenshotsInitFailed' : 'Compositor initialization succeeded, but screenshot init failed',
+	'VRInitError_Compositor_UnableToCreateDevice' : 'Compositor unable to create graphics device',
+	'VRInitError_Compositor_FailedToInitializeEncoder' : 'Driver unable to initialize video encoder',
+
+	# Oculus
+	'VRInitError_VendorSpecific_UnableToConnectToOculusRuntime' : 'Unable to connect to Oculus Runtime',
+	'VRInitError_VendorSpecific_OculusRuntimeBadInstall' : 'Unable to connect to Oculus Runtime, possible bad install',
+
+	# Lighthouse
+	'VRInitError_VendorSpecific_HmdFound_CantOpenDevice' : 'HMD found, but can not open device',
+	'VRInitError_VendorSpecific_HmdFound_UnableToRequestConfigStart' : 'HMD found, but unable to request config',
+	'VRInitError_VendorSpecific_HmdFound_NoStoredConfig' : 'HMD found, but no stored config',
+	'VRInitError_VendorSpecific_HmdFound_ConfigFailedSanityCheck' : 'HMD found, but failed configuration check',
+	'VRInitError_VendorSpecific_HmdFound_ConfigTooBig' : 'HMD found, but config too big',
+	'VRInitError_VendorSpecific_HmdFound_ConfigTooSmall' : 'HMD found, but config too small',
+	'VRInitError_VendorSpecific_HmdFound_UnableToInitZLib' : 'HMD found, but unable to init ZLib',
+	'VRInitError_VendorSpecific_HmdFound_CantReadFirmwareVersion' : 'HMD found, but problems with the data',
+	'VRInitError_VendorSpecific_HmdFound_UnableToSendUserDataStart' : 'HMD found, but problems with the data',
+	'VRInitError_VendorSpecific_HmdFound_UnableToGetUserDataStart' : 'HMD found, but problems with the data',
+	'VRInitError_VendorSpecific_HmdFound_UnableToGetUserDataNext' : 'HMD found, but problems with the data',
+	'VRInitError_VendorSpecific_HmdFound_UserDataAddressRange' : 'HMD found, but problems with the data',
+	'VRInitError_VendorSpecific_HmdFound_UserDataError' : 'HMD found, but problems with the data',
+	'VRInitError_VendorSpecific_HmdFound_UnexpectedConfiguration_1' : 'HMD found, but problems with the data',
+
+	'VRInitError_Steam_SteamInstallationNotFound' : 'Unable to find Steam installation',
+}
+
+def cstring(s):
+	return '"' + s.replace('\\', '\\\\').replace('"', '\\"') + '"'
+
+if len(sys.argv) != 2:
+	sys.exit(-1);
+json_path = sys.argv[1]
+
+with open(json_path) as data_file:
+	data = json.load(data_file)
+
+values = []
+for enum in data['enums']:
+	if(enum['enumname'] == 'vr::EVRInitError'):
+		for value in enum['values']:
+			values.append((int(value['value']), value['name']))
+if(len(values) == 0):
+	sys.stderr.write('vr::EVRInitError not found in ' + json_path + '\n')
+	sys.exit(-1);
+
+for name in descriptions:
+	if(name not in [v[1] for v in values]):
+		sys.stderr.write('description for unknown value ' + name + '\n')
+		sys.exit(-1);
+
+values.sort()
+byid = sorted(range(len(values)), key=lambda i: values[i][1])
+
+print ("""//========= Copyright Valve Corporation ============//
+//
+// Purpose: EVRInitError ID and description tables for hmderrors_public.cpp.
+// This file is auto-generated by codegen/hmderrors_tables.h.py, do not edit it.
+//
+//=============================================================================
+#pragma once
+
+#include <stdint.h>
+
+struct HmdErrorTableEntry_t
+{
+	vr::EVRInitError eError;
+	const char *pchID;
+	const char *pchEnglish;		// nullptr if there is no description
+};
+
+// Sorted by eError
+static constexpr HmdErrorTableEntry_t k_HmdErrorTable[] =
+{""")
+
+for (value, name) in values:
+	if(name in descriptions):
+		english = cstring('%s (%d)' % (descriptions[name], value))
+	else:
+		english = 'nullptr'
+	print ('\t{ vr::%s, %s, %s },' % (name, cstring(name), english))
+
+print ("""};
+
+// Indices into k_HmdErrorTable, sorted by pchID
+static constexpr uint16_t k_HmdErrorIndexByID[] =
+{""")
+
+for i in range(0, len(byid), 16):
+	print ('\t' + ', '.join([str(j) for j in byid[i:i + 16]]) + ',')
+
+print ("""};""")
@@ -41,6 +41,7 @@ print ("""//======= Copyright (c) Valve Corporation, All rights reserved. ======
 
 #include <stdlib.h>
 #include <assert.h>
+#include <new>
 
 #include "openvr.h"
 #include "ivrsystem.h"
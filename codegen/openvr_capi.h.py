@@ -296,9 +296,14 @@ print ("""
 // Global entry points
 S_API intptr_t VR_InitInternal( EVRInitError *peError, EVRApplicationType eType );
 S_API void VR_ShutdownInternal();
+typedef void (*VRInitAsyncCallback_t)( EVRInitError eError, void *pUserData );
+S_API EVRInitError VR_InitAsyncInternal( EVRApplicationType eApplicationType, const char *pStartupInfo, VRInitAsyncCallback_t pfnCallback, void *pUserData );
+S_API bool VR_PollInitAsyncInternal( bool bWait, EVRInitError *peError, uint32_t *punToken );
 S_API bool VR_IsHmdPresent();
 S_API intptr_t VR_GetGenericInterface( const char *pchInterfaceVersion, EVRInitError *peError );
 S_API bool VR_IsRuntimeInstalled();
+S_API void VR_SetHmdPresentProbeTTL( uint32_t unMilliseconds );
+S_API void VR_ReleaseHmdPresentProbe();
 S_API const char * VR_GetVRInitErrorAsSymbol( EVRInitError error );
 S_API const char * VR_GetVRInitErrorAsEnglishDescription( EVRInitError error );
 #endif
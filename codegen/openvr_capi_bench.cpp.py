@@ -0,0 +1,154 @@
+print ("""//======= Copyright (c) Valve Corporation, All rights reserved. ===============
+//
+// Purpose: Measures what a call through the flat C API function tables costs
+// over calling the C++ interface directly, for every interface method. Both
+// sides call into stub implementations that do no work, so the difference is
+// the table and thunk overhead alone.
+// This file is auto-generated, do not edit it.
+//
+//=============================================================================
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <chrono>
+#include <new>
+
+#include "openvr.h"
+#include "openvr_capi.h"
+
+#if defined( _MSC_VER )
+#define BENCH_NOINLINE __declspec( noinline )
+#else
+#define BENCH_NOINLINE __attribute__(( noinline ))
+#endif
+
+// Hides where a pointer came from, so neither side of a measurement can be devirtualized or folded away
+template < typename T >
+static T *Opaque( T *p )
+{
+	T *volatile pVolatile = p;
+	return pVolatile;
+}
+
+template < typename Fn >
+static double TimeCalls( uint32_t unIterations, Fn fn )
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for ( uint32_t i = 0; i < unIterations; i++ )
+		fn();
+	std::chrono::duration< double, std::nano > elapsed = std::chrono::steady_clock::now() - start;
+	return elapsed.count() / unIterations;
+}
+
+static uint32_t g_unMethods = 0;
+static double g_flTotalC = 0;
+static double g_flTotalCpp = 0;
+
+static void ReportCall( const char *pchName, double flNsC, double flNsCpp )
+{
+	printf( "%-64s %8.2f ns %8.2f ns %+8.2f ns\\n", pchName, flNsC, flNsCpp, flNsC - flNsCpp );
+	g_unMethods++;
+	g_flTotalC += flNsC;
+	g_flTotalCpp += flNsCpp;
+}
+
+#define BENCH_CALL( pchName, callC, callCpp ) \\
+	ReportCall( pchName, TimeCalls( unIterations, [&]{ callC; } ), TimeCalls( unIterations, [&]{ callCpp; } ) )
+
+""")
+
+
+import json
+import os
+import re
+import sys
+
+if len(sys.argv) != 2:
+	sys.exit(-1);
+json_path = sys.argv[1]
+
+with open(json_path) as data_file:
+	data = json.load(data_file)
+
+import api_shared
+from api_shared import ctype, getclasswithoutnamespace
+
+# Some interfaces in the json only exist in the runtime's private headers. The harness
+# can only stub out what openvr.h declares, so it reads that from next to the json.
+with open(os.path.join(os.path.dirname(json_path), 'openvr.h')) as header_file:
+	header = header_file.read()
+
+classes = []
+constmethods = {}
+for method in data['methods']:
+	classname = method['classname']
+	if(api_shared.getnamespace(classname) != 'vr' or classname in classes):
+		continue
+	body = re.search(r'\nclass ' + getclasswithoutnamespace(classname) + r'\n\{(.*?)\n\};', header, re.S)
+	if(body is None):
+		continue
+	classes.append(classname)
+	constmethods[classname] = re.findall(r'(\w+)\s*\([^;]*\)\s*const\s*=\s*0', body.group(1))
+
+api_shared.outputfntablefuncs('vr', data, classes)
+api_shared.outputfntabledecls('vr', data, classes)
+
+# stubs that do nothing but return a zeroed value
+for classname in classes:
+	shortname = getclasswithoutnamespace(classname)
+	print('class CStub' + shortname + ' : public ' + classname + '\n{\npublic:')
+	for method in data['methods']:
+		if(method['classname'] != classname):
+			continue
+		paramlist = []
+		if('params' in method):
+			for param in method['params']:
+				paramlist.append(param['paramtype'] + ' ' + param['paramname'])
+		qualifier = ' const' if method['methodname'] in constmethods[classname] else ''
+		body = '{}' if method['returntype'] == 'void' else '{ return {}; }'
+		print('\tBENCH_NOINLINE virtual ' + method['returntype'] + ' ' + method['methodname'] + '(' + ', '.join(paramlist) + ')' + qualifier + ' ' + body)
+	print('};\n')
+
+# one function per interface timing every method both ways
+for classname in classes:
+	shortname = getclasswithoutnamespace(classname)
+	fntablename = classname.replace('vr::', 'VR::').replace('::', '_') + '_FnTable'
+	print('static void Bench' + shortname + '( uint32_t unIterations )\n{')
+	print('\tCStub' + shortname + ' stub;')
+	print('\tg_p' + shortname + ' = Opaque( &stub );')
+	print('\t' + classname + ' *pInterface = Opaque< ' + classname + ' >( &stub );')
+	print('\t' + fntablename + ' *pTable = Opaque( &g_' + fntablename + ' );')
+	lastmethod = ''
+	count = 0
+	for method in data['methods']:
+		if(method['classname'] != classname):
+			continue
+		methodname = method['methodname']
+		if(methodname == lastmethod):
+			methodname = methodname + repr(count)
+			count = count + 1
+		else:
+			count = 0
+		lastmethod = method['methodname']
+
+		print('\t{')
+		argnames = []
+		if('params' in method):
+			for param in method['params']:
+				print('\t\t' + ctype(param['paramtype']) + ' ' + param['paramname'] + ' = {};')
+				argnames.append(param['paramname'])
+		print('\t\tBENCH_CALL( "' + shortname + '::' + methodname + '",')
+		print('\t\t\tpTable->' + methodname + '(' + ', '.join(argnames) + '),')
+		print('\t\t\tpInterface->' + method['methodname'] + '(' + ', '.join(api_shared.fntablecallargs(method)) + ') );')
+		print('\t}')
+	print('}\n')
+
+print('int main( int argc, char **argv )\n{')
+print('\tuint32_t unIterations = argc > 1 ? ( uint32_t )strtoul( argv[ 1 ], nullptr, 10 ) : 1000000;')
+print('\tif ( unIterations == 0 )\n\t\treturn 1;\n')
+print('\tprintf( "%-64s %11s %11s %11s\\n", "method", "C API", "C++", "overhead" );')
+for classname in classes:
+	print('\tBench' + getclasswithoutnamespace(classname) + '( unIterations );')
+print('\tprintf( "\\n%u methods, mean %.2f ns through the C API, %.2f ns through C++, %+.2f ns overhead per call\\n",')
+print('\t\tg_unMethods, g_flTotalC / g_unMethods, g_flTotalCpp / g_unMethods, ( g_flTotalC - g_flTotalCpp ) / g_unMethods );')
+print('\treturn 0;\n}')
@@ -52,10 +52,20 @@ print('[DllImportAttribute("openvr_api", EntryPoint = "VR_InitInternal2", Callin
 print('internal static extern uint InitInternal2(ref EVRInitError peError, EVRApplicationType eApplicationType,[In, MarshalAs(UnmanagedType.LPStr)] string pStartupInfo);')
 print('[DllImportAttribute("openvr_api", EntryPoint = "VR_ShutdownInternal", CallingConvention = CallingConvention.Cdecl)]')
 print('internal static extern void ShutdownInternal();')
+print('[UnmanagedFunctionPointer(CallingConvention.Cdecl)]')
+print('internal delegate void InitAsyncCallback(EVRInitError eError, IntPtr pUserData);')
+print('[DllImportAttribute("openvr_api", EntryPoint = "VR_InitAsyncInternal", CallingConvention = CallingConvention.Cdecl)]')
+print('internal static extern EVRInitError InitAsyncInternal(EVRApplicationType eApplicationType,[In, MarshalAs(UnmanagedType.LPStr)] string pStartupInfo, InitAsyncCallback pfnCallback, IntPtr pUserData);')
+print('[DllImportAttribute("openvr_api", EntryPoint = "VR_PollInitAsyncInternal", CallingConvention = CallingConvention.Cdecl)]')
+print('internal static extern bool PollInitAsyncInternal(bool bWait, ref EVRInitError peError, ref uint punToken);')
 print('[DllImportAttribute("openvr_api", EntryPoint = "VR_IsHmdPresent", CallingConvention = CallingConvention.Cdecl)]')
 print('internal static extern bool IsHmdPresent();')
 print('[DllImportAttribute("openvr_api", EntryPoint = "VR_IsRuntimeInstalled", CallingConvention = CallingConvention.Cdecl)]')
 print('internal static extern bool IsRuntimeInstalled();')
+print('[DllImportAttribute("openvr_api", EntryPoint = "VR_SetHmdPresentProbeTTL", CallingConvention = CallingConvention.Cdecl)]')
+print('internal static extern void SetHmdPresentProbeTTL(uint unMilliseconds);')
+print('[DllImportAttribute("openvr_api", EntryPoint = "VR_ReleaseHmdPresentProbe", CallingConvention = CallingConvention.Cdecl)]')
+print('internal static extern void ReleaseHmdPresentProbe();')
 print('[DllImportAttribute("openvr_api", EntryPoint = "VR_RuntimePath", CallingConvention = CallingConvention.Cdecl)]')
 print('internal static extern string RuntimePath();')
 print('[DllImportAttribute("openvr_api", EntryPoint = "VR_GetRuntimePath", CallingConvention = CallingConvention.Cdecl)]')
@@ -147,6 +157,16 @@ print("""
 	{
 		return OpenVRInterop.IsRuntimeInstalled();
 	}
+
+	public static void SetHmdPresentProbeTTL(uint unMilliseconds)
+	{
+		OpenVRInterop.SetHmdPresentProbeTTL(unMilliseconds);
+	}
+
+	public static void ReleaseHmdPresentProbe()
+	{
+		OpenVRInterop.ReleaseHmdPresentProbe();
+	}
 	
     public static string RuntimePath()
 	{
@@ -591,6 +611,34 @@ print("""
 	{
 		ShutdownInternal();
 	}
+
+	/** Starts initializing the runtime on a background thread. Use PollInitAsync to collect the result. */
+	public static EVRInitError InitAsync(EVRApplicationType eApplicationType = EVRApplicationType.VRApplication_Scene, string pchStartupInfo = "")
+	{
+		return OpenVRInterop.InitAsyncInternal(eApplicationType, pchStartupInfo, null, IntPtr.Zero);
+	}
+
+	/** Returns false while an InitAsync is still running, unless bWait is set. Once it has finished,
+	* returns true with the init's result, or Init_NotInitialized if there was nothing to collect. */
+	public static bool PollInitAsync(ref EVRInitError peError, bool bWait = false)
+	{
+		uint unToken = 0;
+		if (!OpenVRInterop.PollInitAsyncInternal(bWait, ref peError, ref unToken))
+			return false;
+
+		if (peError == EVRInitError.Init_NotInitialized)
+			return true;
+
+		VRToken = unToken;
+		OpenVRInternal_ModuleContext.Clear();
+
+		if (peError == EVRInitError.None && !IsInterfaceVersionValid(IVRSystem_Version))
+		{
+			ShutdownInternal();
+			peError = EVRInitError.Init_InterfaceNotFound;
+		}
+		return true;
+	}
 """)
 
 print("}\n\n");
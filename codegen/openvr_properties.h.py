@@ -0,0 +1,535 @@
+import json
+import sys
+
+if len(sys.argv) != 2:
+	sys.exit(-1);
+json_path = sys.argv[1]
+
+with open(json_path) as data_file:
+	data = json.load(data_file)
+
+# The kind of value a property holds is the suffix of its name. Array properties name
+# their element type in front of _Array.
+scalarkinds = [ 'Bool', 'Float', 'Int32', 'Uint64', 'String', 'Matrix34', 'Vector3' ]
+arraykinds = [ 'Float', 'Int32', 'Vector4', 'Matrix34' ]
+
+# properties whose names don't follow the suffix convention
+specialkinds = {
+	'Prop_ParentContainer' : 'Uint64' }
+
+# String properties that tend to hold paths or urls get a bigger inline buffer, so they
+# are still read with a single query. Matched without case, since names spell both Url and URL.
+longstringwords = [ 'path', 'url', 'icon', 'root' ]
+shortstringbuffer = 256
+longstringbuffer = 1024
+
+# Entries that mark ranges or are reserved, and _Binary, which has no type tag a client
+# could read it back with.
+def isreadable(name):
+	parts = name.split('_')
+	return not (name == 'Prop_Invalid' or parts[-1] in ('Start', 'End', 'Max', 'Binary') or 'Reserved' in parts)
+
+def propertykind(name):
+	if(name in specialkinds):
+		return specialkinds[name]
+	parts = name.split('_')
+	if(parts[-1] == 'Array' and parts[-2] in arraykinds):
+		return parts[-2] + 'Array'
+	if(parts[-1] in scalarkinds):
+		return parts[-1]
+	return None
+
+def stringbuffersize(name):
+	for word in longstringwords:
+		if(word in name.lower()):
+			return longstringbuffer
+	return shortstringbuffer
+
+def inlinebuffersize(name, kind):
+	if(kind == 'String'):
+		return stringbuffersize(name)
+	if(kind.endswith('Array')):
+		return shortstringbuffer
+	return 0
+
+properties = []
+for enum in data['enums']:
+	if(enum['enumname'] != 'vr::ETrackedDeviceProperty'):
+		continue
+	for value in enum['values']:
+		name = value['name']
+		if(not isreadable(name)):
+			continue
+		kind = propertykind(name)
+		if(kind is None):
+			sys.stderr.write('Skipping ' + name + ', its type can not be told from its name\n')
+			continue
+		properties.append((int(value['value']), name, kind))
+properties.sort()
+
+print ("""//======= Copyright (c) Valve Corporation, All rights reserved. ===============
+//
+// Purpose: Type-safe accessors for the ETrackedDeviceProperty values in openvr.h.
+// The type of every property and the buffer its reads start with are known at
+// compile time, so strings and arrays normally take a single query instead of
+// one to size the buffer and one to fill it.
+// This file is auto-generated, do not edit it.
+//
+//=============================================================================
+#pragma once
+
+#ifndef _OPENVR_PROPERTIES_H
+#define _OPENVR_PROPERTIES_H
+
+#include "openvr.h"
+
+#include <string.h>
+#include <string>
+#include <vector>
+
+namespace vr
+{
+
+/** The kind of value a property holds, taken from the suffix of its name */
+enum ETrackedPropertyValueKind
+{
+	TrackedPropertyValueKind_Bool,
+	TrackedPropertyValueKind_Float,
+	TrackedPropertyValueKind_Int32,
+	TrackedPropertyValueKind_Uint64,
+	TrackedPropertyValueKind_String,
+	TrackedPropertyValueKind_Matrix34,
+	TrackedPropertyValueKind_Vector3,
+	TrackedPropertyValueKind_FloatArray,
+	TrackedPropertyValueKind_Int32Array,
+	TrackedPropertyValueKind_Vector4Array,
+	TrackedPropertyValueKind_Matrix34Array,
+};
+
+struct TrackedPropertyDescriptor_t
+{
+	ETrackedDeviceProperty eProp;
+	ETrackedPropertyValueKind eKind;
+	uint32_t unInlineBufferSize;	// bytes the first read of a string or array offers
+	const char *pchName;
+};
+""")
+
+print('/** Every property a client can read, sorted by value */')
+print('static constexpr TrackedPropertyDescriptor_t k_TrackedPropertyDescriptors[] =\n{')
+for value, name, kind in properties:
+	print('\t{ ' + name + ', TrackedPropertyValueKind_' + kind + ', ' + str(inlinebuffersize(name, kind)) + ', "' + name + '" },')
+print('};\n')
+print('static constexpr uint32_t k_unTrackedPropertyDescriptorCount = sizeof( k_TrackedPropertyDescriptors ) / sizeof( k_TrackedPropertyDescriptors[ 0 ] );\n')
+
+print ("""/** Returns the descriptor for eProp, or nullptr if it isn't a property this file knows how to read */
+inline const TrackedPropertyDescriptor_t *FindTrackedPropertyDescriptor( ETrackedDeviceProperty eProp )
+{
+	uint32_t unLow = 0, unHigh = k_unTrackedPropertyDescriptorCount;
+	while ( unLow < unHigh )
+	{
+		uint32_t unMid = ( unLow + unHigh ) / 2;
+		if ( k_TrackedPropertyDescriptors[ unMid ].eProp < eProp )
+			unLow = unMid + 1;
+		else
+			unHigh = unMid;
+	}
+	if ( unLow == k_unTrackedPropertyDescriptorCount || k_TrackedPropertyDescriptors[ unLow ].eProp != eProp )
+		return nullptr;
+	return &k_TrackedPropertyDescriptors[ unLow ];
+}
+
+/** Reads a string property starting with the caller's buffer, and only asks a second time
+* if the value turns out not to fit. */
+inline std::string ReadTrackedDeviceStringProperty( IVRSystem *pSystem, TrackedDeviceIndex_t unDevice, ETrackedDeviceProperty eProp,
+	char *pchBuffer, uint32_t unBufferSize, ETrackedPropertyError *peError )
+{
+	ETrackedPropertyError eError = TrackedProp_Success;
+	uint32_t unRequired = pSystem->GetStringTrackedDeviceProperty( unDevice, eProp, pchBuffer, unBufferSize, &eError );
+	std::string sValue;
+	if ( eError == TrackedProp_BufferTooSmall && unRequired > unBufferSize )
+	{
+		sValue.resize( unRequired );
+		unRequired = pSystem->GetStringTrackedDeviceProperty( unDevice, eProp, &sValue[ 0 ], unRequired, &eError );
+		sValue.resize( eError == TrackedProp_Success && unRequired > 0 ? unRequired - 1 : 0 );
+	}
+	else if ( eError == TrackedProp_Success && unRequired > 0 )
+	{
+		sValue.assign( pchBuffer, unRequired - 1 );
+	}
+	if ( peError )
+		*peError = eError;
+	return sValue;
+}
+
+/** Reads a string property with one query unless it is longer than 255 characters */
+inline std::string GetTrackedDeviceStringProperty( IVRSystem *pSystem, TrackedDeviceIndex_t unDevice, ETrackedDeviceProperty eProp, ETrackedPropertyError *peError = nullptr )
+{
+	char rgchBuffer[ """ + str(shortstringbuffer) + """ ];
+	return ReadTrackedDeviceStringProperty( pSystem, unDevice, eProp, rgchBuffer, sizeof( rgchBuffer ), peError );
+}
+
+/** Reads an array property starting with room for unInlineCount elements */
+template < typename T >
+inline std::vector< T > ReadTrackedDeviceArrayProperty( IVRSystem *pSystem, TrackedDeviceIndex_t unDevice, ETrackedDeviceProperty eProp,
+	PropertyTypeTag_t unTag, uint32_t unInlineCount, ETrackedPropertyError *peError )
+{
+	std::vector< T > vecValue( unInlineCount );
+	ETrackedPropertyError eError = TrackedProp_Success;
+	uint32_t unRequired = pSystem->GetArrayTrackedDeviceProperty( unDevice, eProp, unTag, vecValue.data(), ( uint32_t )( vecValue.size() * sizeof( T ) ), &eError );
+	if ( eError == TrackedProp_BufferTooSmall && unRequired > vecValue.size() * sizeof( T ) )
+	{
+		vecValue.resize( ( unRequired + sizeof( T ) - 1 ) / sizeof( T ) );
+		unRequired = pSystem->GetArrayTrackedDeviceProperty( unDevice, eProp, unTag, vecValue.data(), ( uint32_t )( vecValue.size() * sizeof( T ) ), &eError );
+	}
+	vecValue.resize( eError == TrackedProp_Success ? unRequired / sizeof( T ) : 0 );
+	if ( peError )
+		*peError = eError;
+	return vecValue;
+}
+
+/** How each kind of value is read. unInlineBufferSize only matters for strings and arrays. */
+template < ETrackedPropertyValueKind eKind, uint32_t unInlineBufferSize >
+struct TrackedPropertyKindTraits;
+
+template < uint32_t unInlineBufferSize >
+struct TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, unInlineBufferSize >
+{
+	typedef bool ValueType;
+	static ValueType Read( IVRSystem *pSystem, TrackedDeviceIndex_t unDevice, ETrackedDeviceProperty eProp, ETrackedPropertyError *peError )
+	{
+		return pSystem->GetBoolTrackedDeviceProperty( unDevice, eProp, peError );
+	}
+};
+
+template < uint32_t unInlineBufferSize >
+struct TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, unInlineBufferSize >
+{
+	typedef float ValueType;
+	static ValueType Read( IVRSystem *pSystem, TrackedDeviceIndex_t unDevice, ETrackedDeviceProperty eProp, ETrackedPropertyError *peError )
+	{
+		return pSystem->GetFloatTrackedDeviceProperty( unDevice, eProp, peError );
+	}
+};
+
+template < uint32_t unInlineBufferSize >
+struct TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, unInlineBufferSize >
+{
+	typedef int32_t ValueType;
+	static ValueType Read( IVRSystem *pSystem, TrackedDeviceIndex_t unDevice, ETrackedDeviceProperty eProp, ETrackedPropertyError *peError )
+	{
+		return pSystem->GetInt32TrackedDeviceProperty( unDevice, eProp, peError );
+	}
+};
+
+template < uint32_t unInlineBufferSize >
+struct TrackedPropertyKindTraits< TrackedPropertyValueKind_Uint64, unInlineBufferSize >
+{
+	typedef uint64_t ValueType;
+	static ValueType Read( IVRSystem *pSystem, TrackedDeviceIndex_t unDevice, ETrackedDeviceProperty eProp, ETrackedPropertyError *peError )
+	{
+		return pSystem->GetUint64TrackedDeviceProperty( unDevice, eProp, peError );
+	}
+};
+
+template < uint32_t unInlineBufferSize >
+struct TrackedPropertyKindTraits< TrackedPropertyValueKind_Matrix34, unInlineBufferSize >
+{
+	typedef HmdMatrix34_t ValueType;
+	static ValueType Read( IVRSystem *pSystem, TrackedDeviceIndex_t unDevice, ETrackedDeviceProperty eProp, ETrackedPropertyError *peError )
+	{
+		return pSystem->GetMatrix34TrackedDeviceProperty( unDevice, eProp, peError );
+	}
+};
+
+template < uint32_t unInlineBufferSize >
+struct TrackedPropertyKindTraits< TrackedPropertyValueKind_Vector3, unInlineBufferSize >
+{
+	typedef HmdVector3_t ValueType;
+	static ValueType Read( IVRSystem *pSystem, TrackedDeviceIndex_t unDevice, ETrackedDeviceProperty eProp, ETrackedPropertyError *peError )
+	{
+		HmdVector3_t vValue = {};
+		ETrackedPropertyError eError = TrackedProp_Success;
+		if ( pSystem->GetArrayTrackedDeviceProperty( unDevice, eProp, k_unHmdVector3PropertyTag, &vValue, sizeof( vValue ), &eError ) != sizeof( vValue )
+			&& eError == TrackedProp_Success )
+		{
+			eError = TrackedProp_WrongDataType;
+		}
+		if ( peError )
+			*peError = eError;
+		return vValue;
+	}
+};
+
+template < uint32_t unInlineBufferSize >
+struct TrackedPropertyKindTraits< TrackedPropertyValueKind_String, unInlineBufferSize >
+{
+	typedef std::string ValueType;
+	static ValueType Read( IVRSystem *pSystem, TrackedDeviceIndex_t unDevice, ETrackedDeviceProperty eProp, ETrackedPropertyError *peError )
+	{
+		char rgchBuffer[ unInlineBufferSize ];
+		return ReadTrackedDeviceStringProperty( pSystem, unDevice, eProp, rgchBuffer, unInlineBufferSize, peError );
+	}
+};
+""")
+
+arraytypes = [
+	( 'FloatArray', 'float', 'k_unFloatPropertyTag' ),
+	( 'Int32Array', 'int32_t', 'k_unInt32PropertyTag' ),
+	( 'Vector4Array', 'HmdVector4_t', 'k_unHmdVector4PropertyTag' ),
+	( 'Matrix34Array', 'HmdMatrix34_t', 'k_unHmdMatrix34PropertyTag' ) ]
+for kind, elementtype, tag in arraytypes:
+	print('template < uint32_t unInlineBufferSize >')
+	print('struct TrackedPropertyKindTraits< TrackedPropertyValueKind_' + kind + ', unInlineBufferSize >\n{')
+	print('\ttypedef ' + elementtype + ' ElementType;')
+	print('\ttypedef std::vector< ElementType > ValueType;')
+	print('\tstatic const PropertyTypeTag_t k_unTag = ' + tag + ';')
+	print('\tstatic ValueType Read( IVRSystem *pSystem, TrackedDeviceIndex_t unDevice, ETrackedDeviceProperty eProp, ETrackedPropertyError *peError )\n\t{')
+	print('\t\treturn ReadTrackedDeviceArrayProperty< ElementType >( pSystem, unDevice, eProp, k_unTag, ( unInlineBufferSize + sizeof( ElementType ) - 1 ) / sizeof( ElementType ), peError );')
+	print('\t}\n};\n')
+
+print('/** Compile time information about a single property. k_unIndex is its position in k_TrackedPropertyDescriptors. */')
+print('template < ETrackedDeviceProperty eProp >\nstruct TrackedPropertyTraits;\n')
+for index, ( value, name, kind ) in enumerate(properties):
+	print('template <> struct TrackedPropertyTraits< ' + name + ' > : TrackedPropertyKindTraits< TrackedPropertyValueKind_' + kind + ', '
+		+ str(inlinebuffersize(name, kind)) + ' > { static constexpr uint32_t k_unIndex = ' + str(index) + '; };')
+
+print ("""
+/** Reads a property with the call and buffer its type needs, for example
+*	std::string sSerial = vr::GetTrackedDeviceProperty< vr::Prop_SerialNumber_String >( vr::VRSystem(), unDevice ); */
+template < ETrackedDeviceProperty eProp >
+inline typename TrackedPropertyTraits< eProp >::ValueType GetTrackedDeviceProperty( IVRSystem *pSystem, TrackedDeviceIndex_t unDevice, ETrackedPropertyError *peError = nullptr )
+{
+	return TrackedPropertyTraits< eProp >::Read( pSystem, unDevice, eProp, peError );
+}
+
+
+/** Every property of one device, read with one query per property in the common case.
+* Values are packed into a single buffer that is reused when the snapshot is captured again. */
+class CTrackedDevicePropertySnapshot
+{
+public:
+	CTrackedDevicePropertySnapshot() : m_unDevice( k_unTrackedDeviceIndexInvalid ), m_unQueryCount( 0 ) { Clear(); }
+
+	/** Reads every property in k_TrackedPropertyDescriptors. Returns how many of them the device provided. */
+	uint32_t Capture( IVRSystem *pSystem, TrackedDeviceIndex_t unDevice );
+	void Clear();
+
+	TrackedDeviceIndex_t GetDevice() const { return m_unDevice; }
+
+	/** Number of property queries the last Capture made */
+	uint32_t GetQueryCount() const { return m_unQueryCount; }
+
+	/** TrackedProp_UnknownProperty for properties this file doesn't describe */
+	ETrackedPropertyError GetError( ETrackedDeviceProperty eProp ) const;
+	bool BHasProperty( ETrackedDeviceProperty eProp ) const { return GetError( eProp ) == TrackedProp_Success; }
+
+	/** Typed reads, with the same defaults IVRSystem returns for missing values or the wrong type */
+	bool GetBool( ETrackedDeviceProperty eProp ) const { bool bValue = false; ReadValue( eProp, TrackedPropertyValueKind_Bool, &bValue, sizeof( bValue ) ); return bValue; }
+	float GetFloat( ETrackedDeviceProperty eProp ) const { float flValue = 0; ReadValue( eProp, TrackedPropertyValueKind_Float, &flValue, sizeof( flValue ) ); return flValue; }
+	int32_t GetInt32( ETrackedDeviceProperty eProp ) const { int32_t nValue = 0; ReadValue( eProp, TrackedPropertyValueKind_Int32, &nValue, sizeof( nValue ) ); return nValue; }
+	uint64_t GetUint64( ETrackedDeviceProperty eProp ) const { uint64_t ulValue = 0; ReadValue( eProp, TrackedPropertyValueKind_Uint64, &ulValue, sizeof( ulValue ) ); return ulValue; }
+	HmdMatrix34_t GetMatrix34( ETrackedDeviceProperty eProp ) const;
+	HmdVector3_t GetVector3( ETrackedDeviceProperty eProp ) const { HmdVector3_t vValue = {}; ReadValue( eProp, TrackedPropertyValueKind_Vector3, &vValue, sizeof( vValue ) ); return vValue; }
+
+	/** Returns "" when the device has no such string. Valid until the next Capture. */
+	const char *GetString( ETrackedDeviceProperty eProp ) const;
+
+	/** Returns the raw elements of an array property and their size in bytes. Valid until the next Capture. */
+	const void *GetArray( ETrackedDeviceProperty eProp, uint32_t *punSize ) const;
+
+private:
+	struct Value_t
+	{
+		ETrackedPropertyError eError;
+		uint32_t unOffset;
+		uint32_t unSize;
+	};
+
+	const Value_t *FindValue( ETrackedDeviceProperty eProp, ETrackedPropertyValueKind eKind ) const;
+	void ReadValue( ETrackedDeviceProperty eProp, ETrackedPropertyValueKind eKind, void *pValue, uint32_t unSize ) const;
+	uint32_t AppendValue( const void *pValue, uint32_t unSize );
+
+	TrackedDeviceIndex_t m_unDevice;
+	uint32_t m_unQueryCount;
+	Value_t m_rgValues[ k_unTrackedPropertyDescriptorCount ];
+	std::vector< char > m_bufValues;
+};
+
+
+inline void CTrackedDevicePropertySnapshot::Clear()
+{
+	m_unDevice = k_unTrackedDeviceIndexInvalid;
+	m_unQueryCount = 0;
+	for ( uint32_t i = 0; i < k_unTrackedPropertyDescriptorCount; i++ )
+	{
+		m_rgValues[ i ].eError = TrackedProp_InvalidDevice;
+		m_rgValues[ i ].unOffset = 0;
+		m_rgValues[ i ].unSize = 0;
+	}
+	m_bufValues.clear();
+}
+
+
+inline uint32_t CTrackedDevicePropertySnapshot::AppendValue( const void *pValue, uint32_t unSize )
+{
+	uint32_t unOffset = ( uint32_t )m_bufValues.size();
+	m_bufValues.insert( m_bufValues.end(), ( const char * )pValue, ( const char * )pValue + unSize );
+	return unOffset;
+}
+
+
+inline uint32_t CTrackedDevicePropertySnapshot::Capture( IVRSystem *pSystem, TrackedDeviceIndex_t unDevice )
+{
+	Clear();
+	m_unDevice = unDevice;
+
+	uint32_t unProvided = 0;
+	for ( uint32_t i = 0; i < k_unTrackedPropertyDescriptorCount; i++ )
+	{
+		const TrackedPropertyDescriptor_t &desc = k_TrackedPropertyDescriptors[ i ];
+		Value_t &value = m_rgValues[ i ];
+		value.eError = TrackedProp_Success;
+		value.unOffset = ( uint32_t )m_bufValues.size();
+		m_unQueryCount++;
+		switch ( desc.eKind )
+		{
+		case TrackedPropertyValueKind_Bool:
+		{
+			bool bValue = pSystem->GetBoolTrackedDeviceProperty( unDevice, desc.eProp, &value.eError );
+			value.unOffset = AppendValue( &bValue, sizeof( bValue ) );
+			break;
+		}
+		case TrackedPropertyValueKind_Float:
+		{
+			float flValue = pSystem->GetFloatTrackedDeviceProperty( unDevice, desc.eProp, &value.eError );
+			value.unOffset = AppendValue( &flValue, sizeof( flValue ) );
+			break;
+		}
+		case TrackedPropertyValueKind_Int32:
+		{
+			int32_t nValue = pSystem->GetInt32TrackedDeviceProperty( unDevice, desc.eProp, &value.eError );
+			value.unOffset = AppendValue( &nValue, sizeof( nValue ) );
+			break;
+		}
+		case TrackedPropertyValueKind_Uint64:
+		{
+			uint64_t ulValue = pSystem->GetUint64TrackedDeviceProperty( unDevice, desc.eProp, &value.eError );
+			value.unOffset = AppendValue( &ulValue, sizeof( ulValue ) );
+			break;
+		}
+		case TrackedPropertyValueKind_Matrix34:
+		{
+			HmdMatrix34_t matValue = pSystem->GetMatrix34TrackedDeviceProperty( unDevice, desc.eProp, &value.eError );
+			value.unOffset = AppendValue( &matValue, sizeof( matValue ) );
+			break;
+		}
+		case TrackedPropertyValueKind_Vector3:
+		{
+			HmdVector3_t vValue = TrackedPropertyKindTraits< TrackedPropertyValueKind_Vector3, 0 >::Read( pSystem, unDevice, desc.eProp, &value.eError );
+			value.unOffset = AppendValue( &vValue, sizeof( vValue ) );
+			break;
+		}
+		case TrackedPropertyValueKind_String:
+		{
+			// read straight into the end of the value buffer, growing it only for values longer than the descriptor expects
+			m_bufValues.resize( value.unOffset + desc.unInlineBufferSize );
+			uint32_t unRequired = pSystem->GetStringTrackedDeviceProperty( unDevice, desc.eProp, &m_bufValues[ value.unOffset ], desc.unInlineBufferSize, &value.eError );
+			if ( value.eError == TrackedProp_BufferTooSmall && unRequired > desc.unInlineBufferSize )
+			{
+				m_unQueryCount++;
+				m_bufValues.resize( value.unOffset + unRequired );
+				unRequired = pSystem->GetStringTrackedDeviceProperty( unDevice, desc.eProp, &m_bufValues[ value.unOffset ], unRequired, &value.eError );
+			}
+			m_bufValues.resize( value.unOffset + ( value.eError == TrackedProp_Success ? unRequired : 0 ) );
+			break;
+		}
+		default:
+		{
+			PropertyTypeTag_t unTag = k_unInvalidPropertyTag;
+			switch ( desc.eKind )
+			{
+			case TrackedPropertyValueKind_FloatArray: unTag = k_unFloatPropertyTag; break;
+			case TrackedPropertyValueKind_Int32Array: unTag = k_unInt32PropertyTag; break;
+			case TrackedPropertyValueKind_Vector4Array: unTag = k_unHmdVector4PropertyTag; break;
+			case TrackedPropertyValueKind_Matrix34Array: unTag = k_unHmdMatrix34PropertyTag; break;
+			default: break;
+			}
+			m_bufValues.resize( value.unOffset + desc.unInlineBufferSize );
+			uint32_t unRequired = pSystem->GetArrayTrackedDeviceProperty( unDevice, desc.eProp, unTag, &m_bufValues[ value.unOffset ], desc.unInlineBufferSize, &value.eError );
+			if ( value.eError == TrackedProp_BufferTooSmall && unRequired > desc.unInlineBufferSize )
+			{
+				m_unQueryCount++;
+				m_bufValues.resize( value.unOffset + unRequired );
+				unRequired = pSystem->GetArrayTrackedDeviceProperty( unDevice, desc.eProp, unTag, &m_bufValues[ value.unOffset ], unRequired, &value.eError );
+			}
+			m_bufValues.resize( value.unOffset + ( value.eError == TrackedProp_Success ? unRequired : 0 ) );
+			break;
+		}
+		}
+		value.unSize = ( uint32_t )m_bufValues.size() - value.unOffset;
+		if ( value.eError == TrackedProp_Success )
+			unProvided++;
+	}
+	return unProvided;
+}
+
+
+inline ETrackedPropertyError CTrackedDevicePropertySnapshot::GetError( ETrackedDeviceProperty eProp ) const
+{
+	const TrackedPropertyDescriptor_t *pDesc = FindTrackedPropertyDescriptor( eProp );
+	if ( !pDesc )
+		return TrackedProp_UnknownProperty;
+	return m_rgValues[ pDesc - k_TrackedPropertyDescriptors ].eError;
+}
+
+
+inline const CTrackedDevicePropertySnapshot::Value_t *CTrackedDevicePropertySnapshot::FindValue( ETrackedDeviceProperty eProp, ETrackedPropertyValueKind eKind ) const
+{
+	const TrackedPropertyDescriptor_t *pDesc = FindTrackedPropertyDescriptor( eProp );
+	if ( !pDesc || pDesc->eKind != eKind )
+		return nullptr;
+	const Value_t *pValue = &m_rgValues[ pDesc - k_TrackedPropertyDescriptors ];
+	return pValue->eError == TrackedProp_Success ? pValue : nullptr;
+}
+
+
+inline void CTrackedDevicePropertySnapshot::ReadValue( ETrackedDeviceProperty eProp, ETrackedPropertyValueKind eKind, void *pValue, uint32_t unSize ) const
+{
+	const Value_t *pStored = FindValue( eProp, eKind );
+	if ( pStored && pStored->unSize == unSize )
+		memcpy( pValue, &m_bufValues[ pStored->unOffset ], unSize );
+}
+
+
+inline HmdMatrix34_t CTrackedDevicePropertySnapshot::GetMatrix34( ETrackedDeviceProperty eProp ) const
+{
+	HmdMatrix34_t matValue = { { { 1, 0, 0, 0 }, { 0, 1, 0, 0 }, { 0, 0, 1, 0 } } };
+	ReadValue( eProp, TrackedPropertyValueKind_Matrix34, &matValue, sizeof( matValue ) );
+	return matValue;
+}
+
+
+inline const char *CTrackedDevicePropertySnapshot::GetString( ETrackedDeviceProperty eProp ) const
+{
+	const Value_t *pValue = FindValue( eProp, TrackedPropertyValueKind_String );
+	if ( !pValue || pValue->unSize == 0 )
+		return "";
+	return &m_bufValues[ pValue->unOffset ];
+}
+
+
+inline const void *CTrackedDevicePropertySnapshot::GetArray( ETrackedDeviceProperty eProp, uint32_t *punSize ) const
+{
+	const TrackedPropertyDescriptor_t *pDesc = FindTrackedPropertyDescriptor( eProp );
+	const Value_t *pValue = pDesc && pDesc->eKind >= TrackedPropertyValueKind_FloatArray ? FindValue( eProp, pDesc->eKind ) : nullptr;
+	if ( punSize )
+		*punSize = pValue ? pValue->unSize : 0;
+	if ( !pValue || pValue->unSize == 0 )
+		return nullptr;
+	return &m_bufValues[ pValue->unOffset ];
+}
+
+} // namespace vr
+
+#endif // _OPENVR_PROPERTIES_H""")
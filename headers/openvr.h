@@ -5449,6 +5449,21 @@ namespace vr
 	* invalid after this point */
 	inline void VR_Shutdown();
 
+	/** Called on the background thread when an init started with VR_InitAsync finishes. VR_PollInitAsync
+	* must still be called (from the callback or any other thread) before the interfaces can be used. */
+	typedef void ( VR_CALLTYPE *VRInitAsyncCallback_t )( EVRInitError eError, void *pUserData );
+
+	/** Starts the equivalent of VR_Init on a background thread, loading vrclient while the caller carries on
+	* with other work. Only one async init may be in flight at a time; VRInitError_Init_AlreadyRunning is
+	* returned otherwise. Use VR_PollInitAsync to find out when it has finished. */
+	inline EVRInitError VR_InitAsync( EVRApplicationType eApplicationType, const char *pStartupInfo = nullptr,
+		VRInitAsyncCallback_t pfnCallback = nullptr, void *pUserData = nullptr );
+
+	/** Returns false while an init started with VR_InitAsync is still running. Once it has finished this returns
+	* true exactly once, with the same results VR_Init would have produced. If bWait is true this blocks until then.
+	* Returns true with VRInitError_Init_NotInitialized if no async init was started. */
+	inline bool VR_PollInitAsync( EVRInitError *peError, IVRSystem **ppVRSystem = nullptr, bool bWait = false );
+
 	/** Returns true if there is an HMD attached. This check is as lightweight as possible and
 	* can be called outside of VR_Init/VR_Shutdown. It should be used when an application wants
 	* to know if initializing VR is a possibility but isn't ready to take that step yet.
@@ -5458,6 +5473,15 @@ namespace vr
 	/** Returns true if the OpenVR runtime is installed. */
 	VR_INTERFACE bool VR_CALLTYPE VR_IsRuntimeInstalled();
 
+	/** Sets how many milliseconds a VR_IsHmdPresent result is reused when it is called outside of
+	* VR_Init/VR_Shutdown. The runtime stays loaded between those calls either way, until the path
+	* registry changes or VR_ReleaseHmdPresentProbe is called. The default of 0 asks the runtime every time.
+	*/
+	VR_INTERFACE void VR_CALLTYPE VR_SetHmdPresentProbeTTL( uint32_t unMilliseconds );
+
+	/** Unloads the runtime that VR_IsHmdPresent keeps loaded between calls made outside of VR_Init/VR_Shutdown. */
+	VR_INTERFACE void VR_CALLTYPE VR_ReleaseHmdPresentProbe();
+
 	/** Returns where the OpenVR runtime is installed. */
 	VR_INTERFACE bool VR_GetRuntimePath( VR_OUT_STRING() char *pchPathBuffer, uint32_t unBufferSize, uint32_t *punRequiredBufferSize );
 	
@@ -5813,6 +5837,8 @@ namespace vr
 	
 	VR_INTERFACE uint32_t VR_CALLTYPE VR_InitInternal2( EVRInitError *peError, EVRApplicationType eApplicationType, const char *pStartupInfo );
 	VR_INTERFACE void VR_CALLTYPE VR_ShutdownInternal();
+	VR_INTERFACE EVRInitError VR_CALLTYPE VR_InitAsyncInternal( EVRApplicationType eApplicationType, const char *pStartupInfo, VRInitAsyncCallback_t pfnCallback, void *pUserData );
+	VR_INTERFACE bool VR_CALLTYPE VR_PollInitAsyncInternal( bool bWait, EVRInitError *peError, uint32_t *punToken );
 
 	/** Finds the active installation of vrclient.dll and initializes it */
 	inline IVRSystem *VR_Init( EVRInitError *peError, EVRApplicationType eApplicationType, const char *pStartupInfo )
@@ -5849,5 +5875,47 @@ namespace vr
 		VR_ShutdownInternal();
 	}
 
+	/** Starts initializing vrclient.dll on a background thread */
+	inline EVRInitError VR_InitAsync( EVRApplicationType eApplicationType, const char *pStartupInfo, VRInitAsyncCallback_t pfnCallback, void *pUserData )
+	{
+		return VR_InitAsyncInternal( eApplicationType, pStartupInfo, pfnCallback, pUserData );
+	}
+
+	/** Collects the result of VR_InitAsync once it is available */
+	inline bool VR_PollInitAsync( EVRInitError *peError, IVRSystem **ppVRSystem, bool bWait )
+	{
+		EVRInitError eError;
+		uint32_t unToken;
+		if ( !VR_PollInitAsyncInternal( bWait, &eError, &unToken ) )
+			return false;
+
+		IVRSystem *pVRSystem = nullptr;
+		if ( eError != VRInitError_Init_NotInitialized )
+		{
+			VRToken() = unToken;
+			COpenVRContext &ctx = OpenVRInternal_ModuleContext();
+			ctx.Clear();
+
+			if ( eError == VRInitError_None )
+			{
+				if ( VR_IsInterfaceVersionValid( IVRSystem_Version ) )
+				{
+					pVRSystem = VRSystem();
+				}
+				else
+				{
+					VR_ShutdownInternal();
+					eError = VRInitError_Init_InterfaceNotFound;
+				}
+			}
+		}
+
+		if ( peError )
+			*peError = eError;
+		if ( ppVRSystem )
+			*ppVRSystem = pVRSystem;
+		return true;
+	}
+
 #endif // OPENVR_INTERFACE_INTERNAL
 }
@@ -4569,10 +4569,20 @@ public class OpenVRInterop
 	internal static extern uint InitInternal2(ref EVRInitError peError, EVRApplicationType eApplicationType,[In, MarshalAs(UnmanagedType.LPStr)] string pStartupInfo);
 	[DllImportAttribute("openvr_api", EntryPoint = "VR_ShutdownInternal", CallingConvention = CallingConvention.Cdecl)]
 	internal static extern void ShutdownInternal();
+	[UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+	internal delegate void InitAsyncCallback(EVRInitError eError, IntPtr pUserData);
+	[DllImportAttribute("openvr_api", EntryPoint = "VR_InitAsyncInternal", CallingConvention = CallingConvention.Cdecl)]
+	internal static extern EVRInitError InitAsyncInternal(EVRApplicationType eApplicationType,[In, MarshalAs(UnmanagedType.LPStr)] string pStartupInfo, InitAsyncCallback pfnCallback, IntPtr pUserData);
+	[DllImportAttribute("openvr_api", EntryPoint = "VR_PollInitAsyncInternal", CallingConvention = CallingConvention.Cdecl)]
+	internal static extern bool PollInitAsyncInternal(bool bWait, ref EVRInitError peError, ref uint punToken);
 	[DllImportAttribute("openvr_api", EntryPoint = "VR_IsHmdPresent", CallingConvention = CallingConvention.Cdecl)]
 	internal static extern bool IsHmdPresent();
 	[DllImportAttribute("openvr_api", EntryPoint = "VR_IsRuntimeInstalled", CallingConvention = CallingConvention.Cdecl)]
 	internal static extern bool IsRuntimeInstalled();
+	[DllImportAttribute("openvr_api", EntryPoint = "VR_SetHmdPresentProbeTTL", CallingConvention = CallingConvention.Cdecl)]
+	internal static extern void SetHmdPresentProbeTTL(uint unMilliseconds);
+	[DllImportAttribute("openvr_api", EntryPoint = "VR_ReleaseHmdPresentProbe", CallingConvention = CallingConvention.Cdecl)]
+	internal static extern void ReleaseHmdPresentProbe();
 	[DllImportAttribute("openvr_api", EntryPoint = "VR_RuntimePath", CallingConvention = CallingConvention.Cdecl)]
 	internal static extern string RuntimePath();
 	[DllImportAttribute("openvr_api", EntryPoint = "VR_GetRuntimePath", CallingConvention = CallingConvention.Cdecl)]
@@ -7667,6 +7677,16 @@ public class OpenVR
 		return OpenVRInterop.IsRuntimeInstalled();
 	}
 
+	public static void SetHmdPresentProbeTTL(uint unMilliseconds)
+	{
+		OpenVRInterop.SetHmdPresentProbeTTL(unMilliseconds);
+	}
+
+	public static void ReleaseHmdPresentProbe()
+	{
+		OpenVRInterop.ReleaseHmdPresentProbe();
+	}
+
 	public static string RuntimePath()
 	{
 		try
@@ -8430,6 +8450,34 @@ public class OpenVR
 		ShutdownInternal();
 	}
 
+	/** Starts initializing the runtime on a background thread. Use PollInitAsync to collect the result. */
+	public static EVRInitError InitAsync(EVRApplicationType eApplicationType = EVRApplicationType.VRApplication_Scene, string pchStartupInfo = "")
+	{
+		return OpenVRInterop.InitAsyncInternal(eApplicationType, pchStartupInfo, null, IntPtr.Zero);
+	}
+
+	/** Returns false while an InitAsync is still running, unless bWait is set. Once it has finished,
+	* returns true with the init's result, or Init_NotInitialized if there was nothing to collect. */
+	public static bool PollInitAsync(ref EVRInitError peError, bool bWait = false)
+	{
+		uint unToken = 0;
+		if (!OpenVRInterop.PollInitAsyncInternal(bWait, ref peError, ref unToken))
+			return false;
+
+		if (peError == EVRInitError.Init_NotInitialized)
+			return true;
+
+		VRToken = unToken;
+		OpenVRInternal_ModuleContext.Clear();
+
+		if (peError == EVRInitError.None && !IsInterfaceVersionValid(IVRSystem_Version))
+		{
+			ShutdownInternal();
+			peError = EVRInitError.Init_InterfaceNotFound;
+		}
+		return true;
+	}
+
 }
 
 
@@ -3677,6 +3677,280 @@ inline bool CVRPropertyHelpers::IsPropertySet( PropertyContainerHandle_t ulConta
 	return error == TrackedProp_Success || error == TrackedProp_BufferTooSmall;
 }
 
+
+/** Collects property writes and reads for one container and sends them to the runtime with a single
+* WritePropertyBatch and a single ReadPropertyBatch call, instead of one call per property as the
+* CVRPropertyHelpers functions make. All storage is inside the object (about 1.4 KB), so it is intended to
+* be a local variable in Activate() and similar. The capacity covers a typical device's properties; a longer
+* list is sent in chunks of that size.
+*
+* Scalar and vector values are copied when they are added. String and array values are referenced, and
+* read destinations are written, when the batch is committed, so those must stay valid until then.
+* Writes are always sent before reads. If either list fills up, everything pending is committed early.
+* Anything still pending when the batch goes out of scope is committed by the destructor. That commit is
+* best-effort, since the destructor has nowhere to return its result: call Commit() to find out whether
+* everything succeeded, or pass per-entry error pointers.
+*
+* Each call takes an optional error pointer, which receives that entry's result when it is committed. The
+* Set* return values only report problems queuing the write, such as a NULL string. On failure a read
+* leaves its destination zeroed (or an empty string), as the CVRPropertyHelpers getters do. */
+class CVRPropertyBatch
+{
+public:
+	static const uint32_t k_unMaxWrites = 16;
+	static const uint32_t k_unMaxReads = 8;
+
+	CVRPropertyBatch( PropertyContainerHandle_t ulContainerHandle, IVRProperties *pProperties )
+		: m_ulContainerHandle( ulContainerHandle ), m_pProperties( pProperties ), m_unWriteCount( 0 ), m_unReadCount( 0 ), m_unCallCount( 0 ), m_eFirstError( TrackedProp_Success ) {}
+	~CVRPropertyBatch() { Commit(); }
+
+	ETrackedPropertyError SetBoolProperty( ETrackedDeviceProperty prop, bool bNewValue, ETrackedPropertyError *peError = nullptr ) { return AddValueWrite( prop, &bNewValue, sizeof( bNewValue ), k_unBoolPropertyTag, peError ); }
+	ETrackedPropertyError SetFloatProperty( ETrackedDeviceProperty prop, float fNewValue, ETrackedPropertyError *peError = nullptr ) { return AddValueWrite( prop, &fNewValue, sizeof( fNewValue ), k_unFloatPropertyTag, peError ); }
+	ETrackedPropertyError SetDoubleProperty( ETrackedDeviceProperty prop, double fNewValue, ETrackedPropertyError *peError = nullptr ) { return AddValueWrite( prop, &fNewValue, sizeof( fNewValue ), k_unDoublePropertyTag, peError ); }
+	ETrackedPropertyError SetInt32Property( ETrackedDeviceProperty prop, int32_t nNewValue, ETrackedPropertyError *peError = nullptr ) { return AddValueWrite( prop, &nNewValue, sizeof( nNewValue ), k_unInt32PropertyTag, peError ); }
+	ETrackedPropertyError SetUint64Property( ETrackedDeviceProperty prop, uint64_t ulNewValue, ETrackedPropertyError *peError = nullptr ) { return AddValueWrite( prop, &ulNewValue, sizeof( ulNewValue ), k_unUint64PropertyTag, peError ); }
+	ETrackedPropertyError SetVec2Property( ETrackedDeviceProperty prop, const HmdVector2_t & vNewValue, ETrackedPropertyError *peError = nullptr ) { return AddValueWrite( prop, &vNewValue, sizeof( vNewValue ), k_unHmdVector2PropertyTag, peError ); }
+	ETrackedPropertyError SetVec3Property( ETrackedDeviceProperty prop, const HmdVector3_t & vNewValue, ETrackedPropertyError *peError = nullptr ) { return AddValueWrite( prop, &vNewValue, sizeof( vNewValue ), k_unHmdVector3PropertyTag, peError ); }
+	ETrackedPropertyError SetVec4Property( ETrackedDeviceProperty prop, const HmdVector4_t & vNewValue, ETrackedPropertyError *peError = nullptr ) { return AddValueWrite( prop, &vNewValue, sizeof( vNewValue ), k_unHmdVector4PropertyTag, peError ); }
+
+	/** Queues a string write. The string is not copied and must stay valid until the batch is committed. */
+	ETrackedPropertyError SetStringProperty( ETrackedDeviceProperty prop, const char *pchNewValue, ETrackedPropertyError *peError = nullptr );
+
+	/** Queues a write of arbitrary typed data, which is not copied and must stay valid until the batch is committed. */
+	ETrackedPropertyError SetProperty( ETrackedDeviceProperty prop, const void *pvNewValue, uint32_t unNewValueSize, PropertyTypeTag_t unTag, ETrackedPropertyError *peError = nullptr );
+
+	/** Queues setting the error return value for a property */
+	ETrackedPropertyError SetPropertyError( ETrackedDeviceProperty prop, ETrackedPropertyError eError, ETrackedPropertyError *peError = nullptr );
+
+	/** Queues clearing any value or error set for the property */
+	ETrackedPropertyError EraseProperty( ETrackedDeviceProperty prop, ETrackedPropertyError *peError = nullptr );
+
+	/** Queue typed reads. The destination is filled in when the batch is committed. */
+	void GetBoolProperty( ETrackedDeviceProperty prop, bool *pbValue, ETrackedPropertyError *peError = nullptr ) { AddRead( prop, pbValue, sizeof( *pbValue ), k_unBoolPropertyTag, peError ); }
+	void GetFloatProperty( ETrackedDeviceProperty prop, float *pfValue, ETrackedPropertyError *peError = nullptr ) { AddRead( prop, pfValue, sizeof( *pfValue ), k_unFloatPropertyTag, peError ); }
+	void GetDoubleProperty( ETrackedDeviceProperty prop, double *pfValue, ETrackedPropertyError *peError = nullptr ) { AddRead( prop, pfValue, sizeof( *pfValue ), k_unDoublePropertyTag, peError ); }
+	void GetInt32Property( ETrackedDeviceProperty prop, int32_t *pnValue, ETrackedPropertyError *peError = nullptr ) { AddRead( prop, pnValue, sizeof( *pnValue ), k_unInt32PropertyTag, peError ); }
+	void GetUint64Property( ETrackedDeviceProperty prop, uint64_t *pulValue, ETrackedPropertyError *peError = nullptr ) { AddRead( prop, pulValue, sizeof( *pulValue ), k_unUint64PropertyTag, peError ); }
+	void GetVec2Property( ETrackedDeviceProperty prop, HmdVector2_t *pvValue, ETrackedPropertyError *peError = nullptr ) { AddRead( prop, pvValue, sizeof( *pvValue ), k_unHmdVector2PropertyTag, peError ); }
+	void GetVec3Property( ETrackedDeviceProperty prop, HmdVector3_t *pvValue, ETrackedPropertyError *peError = nullptr ) { AddRead( prop, pvValue, sizeof( *pvValue ), k_unHmdVector3PropertyTag, peError ); }
+	void GetVec4Property( ETrackedDeviceProperty prop, HmdVector4_t *pvValue, ETrackedPropertyError *peError = nullptr ) { AddRead( prop, pvValue, sizeof( *pvValue ), k_unHmdVector4PropertyTag, peError ); }
+
+	/** Queues a string read into a caller buffer. A string that doesn't fit reports TrackedProp_BufferTooSmall. */
+	void GetStringProperty( ETrackedDeviceProperty prop, VR_OUT_STRING() char *pchValue, uint32_t unBufferSize, ETrackedPropertyError *peError = nullptr ) { AddRead( prop, pchValue, unBufferSize, k_unStringPropertyTag, peError ); }
+
+	/** Sends everything pending in at most one write call and one read call. Returns TrackedProp_Success if every
+	* entry since the last Commit succeeded, including any sent early because a list filled up, otherwise the
+	* error of the first entry that failed. */
+	ETrackedPropertyError Commit();
+
+	/** Number of ReadPropertyBatch and WritePropertyBatch calls this batch has made */
+	uint32_t GetCallCount() const { return m_unCallCount; }
+
+private:
+	// large enough for the biggest fixed size property type, HmdVector4_t and the 64 bit types
+	union PropertyValue_t
+	{
+		uint64_t ulAlign;
+		double fAlign;
+		uint8_t rgubData[ 16 ];
+	};
+
+	ETrackedPropertyError AddValueWrite( ETrackedDeviceProperty prop, const void *pvValue, uint32_t unSize, PropertyTypeTag_t unTag, ETrackedPropertyError *peError );
+	PropertyWrite_t &AddWrite( ETrackedDeviceProperty prop, EPropertyWriteType writeType, ETrackedPropertyError *peError );
+	void AddRead( ETrackedDeviceProperty prop, void *pvBuffer, uint32_t unBufferSize, PropertyTypeTag_t unExpectedTag, ETrackedPropertyError *peError );
+	void SendPending();
+
+	PropertyContainerHandle_t m_ulContainerHandle;
+	IVRProperties *m_pProperties;
+
+	PropertyWrite_t m_rgWrites[ k_unMaxWrites ];
+	PropertyValue_t m_rgWriteValues[ k_unMaxWrites ];
+	ETrackedPropertyError *m_rgpWriteErrors[ k_unMaxWrites ];
+	uint32_t m_unWriteCount;
+
+	PropertyRead_t m_rgReads[ k_unMaxReads ];
+	PropertyTypeTag_t m_rgReadExpectedTags[ k_unMaxReads ];
+	ETrackedPropertyError *m_rgpReadErrors[ k_unMaxReads ];
+	uint32_t m_unReadCount;
+
+	uint32_t m_unCallCount;
+	ETrackedPropertyError m_eFirstError;	// first failure since the last Commit
+};
+
+
+inline PropertyWrite_t &CVRPropertyBatch::AddWrite( ETrackedDeviceProperty prop, EPropertyWriteType writeType, ETrackedPropertyError *peError )
+{
+	if ( m_unWriteCount == k_unMaxWrites )
+	{
+		SendPending();
+	}
+
+	uint32_t unIndex = m_unWriteCount++;
+	PropertyWrite_t &write = m_rgWrites[ unIndex ];
+	write.prop = prop;
+	write.writeType = writeType;
+	write.eSetError = TrackedProp_Success;
+	write.pvBuffer = nullptr;
+	write.unBufferSize = 0;
+	write.unTag = k_unInvalidPropertyTag;
+	write.eError = TrackedProp_Success;
+	m_rgpWriteErrors[ unIndex ] = peError;
+	return write;
+}
+
+
+inline ETrackedPropertyError CVRPropertyBatch::AddValueWrite( ETrackedDeviceProperty prop, const void *pvValue, uint32_t unSize, PropertyTypeTag_t unTag, ETrackedPropertyError *peError )
+{
+	PropertyWrite_t &write = AddWrite( prop, PropertyWrite_Set, peError );
+	PropertyValue_t &value = m_rgWriteValues[ &write - m_rgWrites ];
+
+	// this is memcpy without the dependency on string.h
+	const uint8_t *pubSrc = (const uint8_t *)pvValue;
+	for ( uint32_t i = 0; i < unSize; i++ )
+	{
+		value.rgubData[ i ] = pubSrc[ i ];
+	}
+
+	write.pvBuffer = value.rgubData;
+	write.unBufferSize = unSize;
+	write.unTag = unTag;
+	return TrackedProp_Success;
+}
+
+
+inline ETrackedPropertyError CVRPropertyBatch::SetStringProperty( ETrackedDeviceProperty prop, const char *pchNewValue, ETrackedPropertyError *peError )
+{
+	if ( !pchNewValue )
+	{
+		if ( peError )
+			*peError = TrackedProp_InvalidOperation;
+		return TrackedProp_InvalidOperation;
+	}
+
+	// this is strlen without the dependency on string.h
+	const char *pchCurr = pchNewValue;
+	while ( *pchCurr )
+	{
+		pchCurr++;
+	}
+
+	return SetProperty( prop, pchNewValue, (uint32_t)( pchCurr - pchNewValue ) + 1, k_unStringPropertyTag, peError );
+}
+
+
+inline ETrackedPropertyError CVRPropertyBatch::SetProperty( ETrackedDeviceProperty prop, const void *pvNewValue, uint32_t unNewValueSize, PropertyTypeTag_t unTag, ETrackedPropertyError *peError )
+{
+	PropertyWrite_t &write = AddWrite( prop, PropertyWrite_Set, peError );
+	write.pvBuffer = (void *)pvNewValue;
+	write.unBufferSize = unNewValueSize;
+	write.unTag = unTag;
+	return TrackedProp_Success;
+}
+
+
+inline ETrackedPropertyError CVRPropertyBatch::SetPropertyError( ETrackedDeviceProperty prop, ETrackedPropertyError eError, ETrackedPropertyError *peError )
+{
+	PropertyWrite_t &write = AddWrite( prop, PropertyWrite_SetError, peError );
+	write.eSetError = eError;
+	return TrackedProp_Success;
+}
+
+
+inline ETrackedPropertyError CVRPropertyBatch::EraseProperty( ETrackedDeviceProperty prop, ETrackedPropertyError *peError )
+{
+	AddWrite( prop, PropertyWrite_Erase, peError );
+	return TrackedProp_Success;
+}
+
+
+inline void CVRPropertyBatch::AddRead( ETrackedDeviceProperty prop, void *pvBuffer, uint32_t unBufferSize, PropertyTypeTag_t unExpectedTag, ETrackedPropertyError *peError )
+{
+	if ( m_unReadCount == k_unMaxReads )
+	{
+		SendPending();
+	}
+
+	uint32_t unIndex = m_unReadCount++;
+	PropertyRead_t &read = m_rgReads[ unIndex ];
+	read.prop = prop;
+	read.pvBuffer = pvBuffer;
+	read.unBufferSize = unBufferSize;
+	read.unTag = k_unInvalidPropertyTag;
+	read.unRequiredBufferSize = 0;
+	read.eError = TrackedProp_Success;
+	m_rgReadExpectedTags[ unIndex ] = unExpectedTag;
+	m_rgpReadErrors[ unIndex ] = peError;
+}
+
+
+inline ETrackedPropertyError CVRPropertyBatch::Commit()
+{
+	SendPending();
+
+	ETrackedPropertyError eFirstError = m_eFirstError;
+	m_eFirstError = TrackedProp_Success;
+	return eFirstError;
+}
+
+
+inline void CVRPropertyBatch::SendPending()
+{
+	if ( m_unWriteCount )
+	{
+		m_pProperties->WritePropertyBatch( m_ulContainerHandle, m_rgWrites, m_unWriteCount );
+		m_unCallCount++;
+
+		for ( uint32_t i = 0; i < m_unWriteCount; i++ )
+		{
+			ETrackedPropertyError eError = m_rgWrites[ i ].eError;
+			if ( m_rgpWriteErrors[ i ] )
+				*m_rgpWriteErrors[ i ] = eError;
+			if ( eError != TrackedProp_Success && m_eFirstError == TrackedProp_Success )
+				m_eFirstError = eError;
+		}
+		m_unWriteCount = 0;
+	}
+
+	if ( m_unReadCount )
+	{
+		m_pProperties->ReadPropertyBatch( m_ulContainerHandle, m_rgReads, m_unReadCount );
+		m_unCallCount++;
+
+		for ( uint32_t i = 0; i < m_unReadCount; i++ )
+		{
+			PropertyRead_t &read = m_rgReads[ i ];
+			ETrackedPropertyError eError = read.eError;
+			if ( read.unTag != m_rgReadExpectedTags[ i ] && eError == TrackedProp_Success )
+			{
+				eError = TrackedProp_WrongDataType;
+			}
+
+			if ( eError != TrackedProp_Success && read.pvBuffer && read.unBufferSize )
+			{
+				// same defaults the CVRPropertyHelpers getters return on failure
+				if ( m_rgReadExpectedTags[ i ] == k_unStringPropertyTag )
+				{
+					*(char *)read.pvBuffer = '\0';
+				}
+				else
+				{
+					uint8_t *pubDest = (uint8_t *)read.pvBuffer;
+					for ( uint32_t j = 0; j < read.unBufferSize; j++ )
+					{
+						pubDest[ j ] = 0;
+					}
+				}
+			}
+
+			if ( m_rgpReadErrors[ i ] )
+				*m_rgpReadErrors[ i ] = eError;
+			if ( eError != TrackedProp_Success && m_eFirstError == TrackedProp_Success )
+				m_eFirstError = eError;
+		}
+		m_unReadCount = 0;
+	}
+}
+
 }
 
 
@@ -0,0 +1,937 @@
+//======= Copyright (c) Valve Corporation, All rights reserved. ===============
+//
+// Purpose: Type-safe accessors for the ETrackedDeviceProperty values in openvr.h.
+// The type of every property and the buffer its reads start with are known at
+// compile time, so strings and arrays normally take a single query instead of
+// one to size the buffer and one to fill it.
+// This file is auto-generated, do not edit it.
+//
+//=============================================================================
+#pragma once
+
+#ifndef _OPENVR_PROPERTIES_H
+#define _OPENVR_PROPERTIES_H
+
+#include "openvr.h"
+
+#include <string.h>
+#include <string>
+#include <vector>
+
+namespace vr
+{
+
+/** The kind of value a property holds, taken from the suffix of its name */
+enum ETrackedPropertyValueKind
+{
+	TrackedPropertyValueKind_Bool,
+	TrackedPropertyValueKind_Float,
+	TrackedPropertyValueKind_Int32,
+	TrackedPropertyValueKind_Uint64,
+	TrackedPropertyValueKind_String,
+	TrackedPropertyValueKind_Matrix34,
+	TrackedPropertyValueKind_Vector3,
+	TrackedPropertyValueKind_FloatArray,
+	TrackedPropertyValueKind_Int32Array,
+	TrackedPropertyValueKind_Vector4Array,
+	TrackedPropertyValueKind_Matrix34Array,
+};
+
+struct TrackedPropertyDescriptor_t
+{
+	ETrackedDeviceProperty eProp;
+	ETrackedPropertyValueKind eKind;
+	uint32_t unInlineBufferSize;	// bytes the first read of a string or array offers
+	const char *pchName;
+};
+
+/** Every property a client can read, sorted by value */
+static constexpr TrackedPropertyDescriptor_t k_TrackedPropertyDescriptors[] =
+{
+	{ Prop_TrackingSystemName_String, TrackedPropertyValueKind_String, 256, "Prop_TrackingSystemName_String" },
+	{ Prop_ModelNumber_String, TrackedPropertyValueKind_String, 256, "Prop_ModelNumber_String" },
+	{ Prop_SerialNumber_String, TrackedPropertyValueKind_String, 256, "Prop_SerialNumber_String" },
+	{ Prop_RenderModelName_String, TrackedPropertyValueKind_String, 256, "Prop_RenderModelName_String" },
+	{ Prop_WillDriftInYaw_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_WillDriftInYaw_Bool" },
+	{ Prop_ManufacturerName_String, TrackedPropertyValueKind_String, 256, "Prop_ManufacturerName_String" },
+	{ Prop_TrackingFirmwareVersion_String, TrackedPropertyValueKind_String, 256, "Prop_TrackingFirmwareVersion_String" },
+	{ Prop_HardwareRevision_String, TrackedPropertyValueKind_String, 256, "Prop_HardwareRevision_String" },
+	{ Prop_AllWirelessDongleDescriptions_String, TrackedPropertyValueKind_String, 256, "Prop_AllWirelessDongleDescriptions_String" },
+	{ Prop_ConnectedWirelessDongle_String, TrackedPropertyValueKind_String, 256, "Prop_ConnectedWirelessDongle_String" },
+	{ Prop_DeviceIsWireless_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_DeviceIsWireless_Bool" },
+	{ Prop_DeviceIsCharging_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_DeviceIsCharging_Bool" },
+	{ Prop_DeviceBatteryPercentage_Float, TrackedPropertyValueKind_Float, 0, "Prop_DeviceBatteryPercentage_Float" },
+	{ Prop_StatusDisplayTransform_Matrix34, TrackedPropertyValueKind_Matrix34, 0, "Prop_StatusDisplayTransform_Matrix34" },
+	{ Prop_Firmware_UpdateAvailable_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_Firmware_UpdateAvailable_Bool" },
+	{ Prop_Firmware_ManualUpdate_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_Firmware_ManualUpdate_Bool" },
+	{ Prop_Firmware_ManualUpdateURL_String, TrackedPropertyValueKind_String, 1024, "Prop_Firmware_ManualUpdateURL_String" },
+	{ Prop_HardwareRevision_Uint64, TrackedPropertyValueKind_Uint64, 0, "Prop_HardwareRevision_Uint64" },
+	{ Prop_FirmwareVersion_Uint64, TrackedPropertyValueKind_Uint64, 0, "Prop_FirmwareVersion_Uint64" },
+	{ Prop_FPGAVersion_Uint64, TrackedPropertyValueKind_Uint64, 0, "Prop_FPGAVersion_Uint64" },
+	{ Prop_VRCVersion_Uint64, TrackedPropertyValueKind_Uint64, 0, "Prop_VRCVersion_Uint64" },
+	{ Prop_RadioVersion_Uint64, TrackedPropertyValueKind_Uint64, 0, "Prop_RadioVersion_Uint64" },
+	{ Prop_DongleVersion_Uint64, TrackedPropertyValueKind_Uint64, 0, "Prop_DongleVersion_Uint64" },
+	{ Prop_BlockServerShutdown_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_BlockServerShutdown_Bool" },
+	{ Prop_CanUnifyCoordinateSystemWithHmd_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_CanUnifyCoordinateSystemWithHmd_Bool" },
+	{ Prop_ContainsProximitySensor_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_ContainsProximitySensor_Bool" },
+	{ Prop_DeviceProvidesBatteryStatus_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_DeviceProvidesBatteryStatus_Bool" },
+	{ Prop_DeviceCanPowerOff_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_DeviceCanPowerOff_Bool" },
+	{ Prop_Firmware_ProgrammingTarget_String, TrackedPropertyValueKind_String, 256, "Prop_Firmware_ProgrammingTarget_String" },
+	{ Prop_DeviceClass_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_DeviceClass_Int32" },
+	{ Prop_HasCamera_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_HasCamera_Bool" },
+	{ Prop_DriverVersion_String, TrackedPropertyValueKind_String, 256, "Prop_DriverVersion_String" },
+	{ Prop_Firmware_ForceUpdateRequired_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_Firmware_ForceUpdateRequired_Bool" },
+	{ Prop_ViveSystemButtonFixRequired_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_ViveSystemButtonFixRequired_Bool" },
+	{ Prop_ParentDriver_Uint64, TrackedPropertyValueKind_Uint64, 0, "Prop_ParentDriver_Uint64" },
+	{ Prop_ResourceRoot_String, TrackedPropertyValueKind_String, 1024, "Prop_ResourceRoot_String" },
+	{ Prop_RegisteredDeviceType_String, TrackedPropertyValueKind_String, 256, "Prop_RegisteredDeviceType_String" },
+	{ Prop_InputProfilePath_String, TrackedPropertyValueKind_String, 1024, "Prop_InputProfilePath_String" },
+	{ Prop_NeverTracked_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_NeverTracked_Bool" },
+	{ Prop_NumCameras_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_NumCameras_Int32" },
+	{ Prop_CameraFrameLayout_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_CameraFrameLayout_Int32" },
+	{ Prop_CameraStreamFormat_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_CameraStreamFormat_Int32" },
+	{ Prop_AdditionalDeviceSettingsPath_String, TrackedPropertyValueKind_String, 1024, "Prop_AdditionalDeviceSettingsPath_String" },
+	{ Prop_Identifiable_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_Identifiable_Bool" },
+	{ Prop_BootloaderVersion_Uint64, TrackedPropertyValueKind_Uint64, 0, "Prop_BootloaderVersion_Uint64" },
+	{ Prop_AdditionalSystemReportData_String, TrackedPropertyValueKind_String, 256, "Prop_AdditionalSystemReportData_String" },
+	{ Prop_CompositeFirmwareVersion_String, TrackedPropertyValueKind_String, 256, "Prop_CompositeFirmwareVersion_String" },
+	{ Prop_Firmware_RemindUpdate_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_Firmware_RemindUpdate_Bool" },
+	{ Prop_PeripheralApplicationVersion_Uint64, TrackedPropertyValueKind_Uint64, 0, "Prop_PeripheralApplicationVersion_Uint64" },
+	{ Prop_ManufacturerSerialNumber_String, TrackedPropertyValueKind_String, 256, "Prop_ManufacturerSerialNumber_String" },
+	{ Prop_ComputedSerialNumber_String, TrackedPropertyValueKind_String, 256, "Prop_ComputedSerialNumber_String" },
+	{ Prop_EstimatedDeviceFirstUseTime_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_EstimatedDeviceFirstUseTime_Int32" },
+	{ Prop_DevicePowerUsage_Float, TrackedPropertyValueKind_Float, 0, "Prop_DevicePowerUsage_Float" },
+	{ Prop_IgnoreMotionForStandby_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_IgnoreMotionForStandby_Bool" },
+	{ Prop_ActualTrackingSystemName_String, TrackedPropertyValueKind_String, 256, "Prop_ActualTrackingSystemName_String" },
+	{ Prop_ReportsTimeSinceVSync_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_ReportsTimeSinceVSync_Bool" },
+	{ Prop_SecondsFromVsyncToPhotons_Float, TrackedPropertyValueKind_Float, 0, "Prop_SecondsFromVsyncToPhotons_Float" },
+	{ Prop_DisplayFrequency_Float, TrackedPropertyValueKind_Float, 0, "Prop_DisplayFrequency_Float" },
+	{ Prop_UserIpdMeters_Float, TrackedPropertyValueKind_Float, 0, "Prop_UserIpdMeters_Float" },
+	{ Prop_CurrentUniverseId_Uint64, TrackedPropertyValueKind_Uint64, 0, "Prop_CurrentUniverseId_Uint64" },
+	{ Prop_PreviousUniverseId_Uint64, TrackedPropertyValueKind_Uint64, 0, "Prop_PreviousUniverseId_Uint64" },
+	{ Prop_DisplayFirmwareVersion_Uint64, TrackedPropertyValueKind_Uint64, 0, "Prop_DisplayFirmwareVersion_Uint64" },
+	{ Prop_IsOnDesktop_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_IsOnDesktop_Bool" },
+	{ Prop_DisplayMCType_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_DisplayMCType_Int32" },
+	{ Prop_DisplayMCOffset_Float, TrackedPropertyValueKind_Float, 0, "Prop_DisplayMCOffset_Float" },
+	{ Prop_DisplayMCScale_Float, TrackedPropertyValueKind_Float, 0, "Prop_DisplayMCScale_Float" },
+	{ Prop_EdidVendorID_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_EdidVendorID_Int32" },
+	{ Prop_DisplayMCImageLeft_String, TrackedPropertyValueKind_String, 256, "Prop_DisplayMCImageLeft_String" },
+	{ Prop_DisplayMCImageRight_String, TrackedPropertyValueKind_String, 256, "Prop_DisplayMCImageRight_String" },
+	{ Prop_DisplayGCBlackClamp_Float, TrackedPropertyValueKind_Float, 0, "Prop_DisplayGCBlackClamp_Float" },
+	{ Prop_EdidProductID_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_EdidProductID_Int32" },
+	{ Prop_CameraToHeadTransform_Matrix34, TrackedPropertyValueKind_Matrix34, 0, "Prop_CameraToHeadTransform_Matrix34" },
+	{ Prop_DisplayGCType_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_DisplayGCType_Int32" },
+	{ Prop_DisplayGCOffset_Float, TrackedPropertyValueKind_Float, 0, "Prop_DisplayGCOffset_Float" },
+	{ Prop_DisplayGCScale_Float, TrackedPropertyValueKind_Float, 0, "Prop_DisplayGCScale_Float" },
+	{ Prop_DisplayGCPrescale_Float, TrackedPropertyValueKind_Float, 0, "Prop_DisplayGCPrescale_Float" },
+	{ Prop_DisplayGCImage_String, TrackedPropertyValueKind_String, 256, "Prop_DisplayGCImage_String" },
+	{ Prop_LensCenterLeftU_Float, TrackedPropertyValueKind_Float, 0, "Prop_LensCenterLeftU_Float" },
+	{ Prop_LensCenterLeftV_Float, TrackedPropertyValueKind_Float, 0, "Prop_LensCenterLeftV_Float" },
+	{ Prop_LensCenterRightU_Float, TrackedPropertyValueKind_Float, 0, "Prop_LensCenterRightU_Float" },
+	{ Prop_LensCenterRightV_Float, TrackedPropertyValueKind_Float, 0, "Prop_LensCenterRightV_Float" },
+	{ Prop_UserHeadToEyeDepthMeters_Float, TrackedPropertyValueKind_Float, 0, "Prop_UserHeadToEyeDepthMeters_Float" },
+	{ Prop_CameraFirmwareVersion_Uint64, TrackedPropertyValueKind_Uint64, 0, "Prop_CameraFirmwareVersion_Uint64" },
+	{ Prop_CameraFirmwareDescription_String, TrackedPropertyValueKind_String, 256, "Prop_CameraFirmwareDescription_String" },
+	{ Prop_DisplayFPGAVersion_Uint64, TrackedPropertyValueKind_Uint64, 0, "Prop_DisplayFPGAVersion_Uint64" },
+	{ Prop_DisplayBootloaderVersion_Uint64, TrackedPropertyValueKind_Uint64, 0, "Prop_DisplayBootloaderVersion_Uint64" },
+	{ Prop_DisplayHardwareVersion_Uint64, TrackedPropertyValueKind_Uint64, 0, "Prop_DisplayHardwareVersion_Uint64" },
+	{ Prop_AudioFirmwareVersion_Uint64, TrackedPropertyValueKind_Uint64, 0, "Prop_AudioFirmwareVersion_Uint64" },
+	{ Prop_CameraCompatibilityMode_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_CameraCompatibilityMode_Int32" },
+	{ Prop_ScreenshotHorizontalFieldOfViewDegrees_Float, TrackedPropertyValueKind_Float, 0, "Prop_ScreenshotHorizontalFieldOfViewDegrees_Float" },
+	{ Prop_ScreenshotVerticalFieldOfViewDegrees_Float, TrackedPropertyValueKind_Float, 0, "Prop_ScreenshotVerticalFieldOfViewDegrees_Float" },
+	{ Prop_DisplaySuppressed_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_DisplaySuppressed_Bool" },
+	{ Prop_DisplayAllowNightMode_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_DisplayAllowNightMode_Bool" },
+	{ Prop_DisplayMCImageWidth_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_DisplayMCImageWidth_Int32" },
+	{ Prop_DisplayMCImageHeight_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_DisplayMCImageHeight_Int32" },
+	{ Prop_DisplayMCImageNumChannels_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_DisplayMCImageNumChannels_Int32" },
+	{ Prop_SecondsFromPhotonsToVblank_Float, TrackedPropertyValueKind_Float, 0, "Prop_SecondsFromPhotonsToVblank_Float" },
+	{ Prop_DriverDirectModeSendsVsyncEvents_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_DriverDirectModeSendsVsyncEvents_Bool" },
+	{ Prop_DisplayDebugMode_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_DisplayDebugMode_Bool" },
+	{ Prop_GraphicsAdapterLuid_Uint64, TrackedPropertyValueKind_Uint64, 0, "Prop_GraphicsAdapterLuid_Uint64" },
+	{ Prop_DriverProvidedChaperonePath_String, TrackedPropertyValueKind_String, 1024, "Prop_DriverProvidedChaperonePath_String" },
+	{ Prop_ExpectedTrackingReferenceCount_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_ExpectedTrackingReferenceCount_Int32" },
+	{ Prop_ExpectedControllerCount_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_ExpectedControllerCount_Int32" },
+	{ Prop_NamedIconPathControllerLeftDeviceOff_String, TrackedPropertyValueKind_String, 1024, "Prop_NamedIconPathControllerLeftDeviceOff_String" },
+	{ Prop_NamedIconPathControllerRightDeviceOff_String, TrackedPropertyValueKind_String, 1024, "Prop_NamedIconPathControllerRightDeviceOff_String" },
+	{ Prop_NamedIconPathTrackingReferenceDeviceOff_String, TrackedPropertyValueKind_String, 1024, "Prop_NamedIconPathTrackingReferenceDeviceOff_String" },
+	{ Prop_DoNotApplyPrediction_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_DoNotApplyPrediction_Bool" },
+	{ Prop_CameraToHeadTransforms_Matrix34_Array, TrackedPropertyValueKind_Matrix34Array, 256, "Prop_CameraToHeadTransforms_Matrix34_Array" },
+	{ Prop_DistortionMeshResolution_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_DistortionMeshResolution_Int32" },
+	{ Prop_DriverIsDrawingControllers_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_DriverIsDrawingControllers_Bool" },
+	{ Prop_DriverRequestsApplicationPause_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_DriverRequestsApplicationPause_Bool" },
+	{ Prop_DriverRequestsReducedRendering_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_DriverRequestsReducedRendering_Bool" },
+	{ Prop_MinimumIpdStepMeters_Float, TrackedPropertyValueKind_Float, 0, "Prop_MinimumIpdStepMeters_Float" },
+	{ Prop_AudioBridgeFirmwareVersion_Uint64, TrackedPropertyValueKind_Uint64, 0, "Prop_AudioBridgeFirmwareVersion_Uint64" },
+	{ Prop_ImageBridgeFirmwareVersion_Uint64, TrackedPropertyValueKind_Uint64, 0, "Prop_ImageBridgeFirmwareVersion_Uint64" },
+	{ Prop_ImuToHeadTransform_Matrix34, TrackedPropertyValueKind_Matrix34, 0, "Prop_ImuToHeadTransform_Matrix34" },
+	{ Prop_ImuFactoryGyroBias_Vector3, TrackedPropertyValueKind_Vector3, 0, "Prop_ImuFactoryGyroBias_Vector3" },
+	{ Prop_ImuFactoryGyroScale_Vector3, TrackedPropertyValueKind_Vector3, 0, "Prop_ImuFactoryGyroScale_Vector3" },
+	{ Prop_ImuFactoryAccelerometerBias_Vector3, TrackedPropertyValueKind_Vector3, 0, "Prop_ImuFactoryAccelerometerBias_Vector3" },
+	{ Prop_ImuFactoryAccelerometerScale_Vector3, TrackedPropertyValueKind_Vector3, 0, "Prop_ImuFactoryAccelerometerScale_Vector3" },
+	{ Prop_ConfigurationIncludesLighthouse20Features_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_ConfigurationIncludesLighthouse20Features_Bool" },
+	{ Prop_AdditionalRadioFeatures_Uint64, TrackedPropertyValueKind_Uint64, 0, "Prop_AdditionalRadioFeatures_Uint64" },
+	{ Prop_CameraWhiteBalance_Vector4_Array, TrackedPropertyValueKind_Vector4Array, 256, "Prop_CameraWhiteBalance_Vector4_Array" },
+	{ Prop_CameraDistortionFunction_Int32_Array, TrackedPropertyValueKind_Int32Array, 256, "Prop_CameraDistortionFunction_Int32_Array" },
+	{ Prop_CameraDistortionCoefficients_Float_Array, TrackedPropertyValueKind_FloatArray, 256, "Prop_CameraDistortionCoefficients_Float_Array" },
+	{ Prop_ExpectedControllerType_String, TrackedPropertyValueKind_String, 256, "Prop_ExpectedControllerType_String" },
+	{ Prop_HmdTrackingStyle_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_HmdTrackingStyle_Int32" },
+	{ Prop_DriverProvidedChaperoneVisibility_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_DriverProvidedChaperoneVisibility_Bool" },
+	{ Prop_HmdColumnCorrectionSettingPrefix_String, TrackedPropertyValueKind_String, 256, "Prop_HmdColumnCorrectionSettingPrefix_String" },
+	{ Prop_CameraSupportsCompatibilityModes_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_CameraSupportsCompatibilityModes_Bool" },
+	{ Prop_SupportsRoomViewDepthProjection_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_SupportsRoomViewDepthProjection_Bool" },
+	{ Prop_DisplayAvailableFrameRates_Float_Array, TrackedPropertyValueKind_FloatArray, 256, "Prop_DisplayAvailableFrameRates_Float_Array" },
+	{ Prop_DisplaySupportsMultipleFramerates_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_DisplaySupportsMultipleFramerates_Bool" },
+	{ Prop_DisplayColorMultLeft_Vector3, TrackedPropertyValueKind_Vector3, 0, "Prop_DisplayColorMultLeft_Vector3" },
+	{ Prop_DisplayColorMultRight_Vector3, TrackedPropertyValueKind_Vector3, 0, "Prop_DisplayColorMultRight_Vector3" },
+	{ Prop_DisplaySupportsRuntimeFramerateChange_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_DisplaySupportsRuntimeFramerateChange_Bool" },
+	{ Prop_DisplaySupportsAnalogGain_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_DisplaySupportsAnalogGain_Bool" },
+	{ Prop_DisplayMinAnalogGain_Float, TrackedPropertyValueKind_Float, 0, "Prop_DisplayMinAnalogGain_Float" },
+	{ Prop_DisplayMaxAnalogGain_Float, TrackedPropertyValueKind_Float, 0, "Prop_DisplayMaxAnalogGain_Float" },
+	{ Prop_CameraExposureTime_Float, TrackedPropertyValueKind_Float, 0, "Prop_CameraExposureTime_Float" },
+	{ Prop_CameraGlobalGain_Float, TrackedPropertyValueKind_Float, 0, "Prop_CameraGlobalGain_Float" },
+	{ Prop_DashboardScale_Float, TrackedPropertyValueKind_Float, 0, "Prop_DashboardScale_Float" },
+	{ Prop_PeerButtonInfo_String, TrackedPropertyValueKind_String, 256, "Prop_PeerButtonInfo_String" },
+	{ Prop_Hmd_SupportsHDR10_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_Hmd_SupportsHDR10_Bool" },
+	{ Prop_Hmd_EnableParallelRenderCameras_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_Hmd_EnableParallelRenderCameras_Bool" },
+	{ Prop_DriverProvidedChaperoneJson_String, TrackedPropertyValueKind_String, 256, "Prop_DriverProvidedChaperoneJson_String" },
+	{ Prop_ForceSystemLayerUseAppPoses_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_ForceSystemLayerUseAppPoses_Bool" },
+	{ Prop_IpdUIRangeMinMeters_Float, TrackedPropertyValueKind_Float, 0, "Prop_IpdUIRangeMinMeters_Float" },
+	{ Prop_IpdUIRangeMaxMeters_Float, TrackedPropertyValueKind_Float, 0, "Prop_IpdUIRangeMaxMeters_Float" },
+	{ Prop_Hmd_SupportsHDCP14LegacyCompat_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_Hmd_SupportsHDCP14LegacyCompat_Bool" },
+	{ Prop_Hmd_SupportsMicMonitoring_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_Hmd_SupportsMicMonitoring_Bool" },
+	{ Prop_Hmd_SupportsDisplayPortTrainingMode_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_Hmd_SupportsDisplayPortTrainingMode_Bool" },
+	{ Prop_Hmd_SupportsRoomViewDirect_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_Hmd_SupportsRoomViewDirect_Bool" },
+	{ Prop_Hmd_SupportsAppThrottling_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_Hmd_SupportsAppThrottling_Bool" },
+	{ Prop_Hmd_SupportsGpuBusMonitoring_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_Hmd_SupportsGpuBusMonitoring_Bool" },
+	{ Prop_DriverDisplaysIPDChanges_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_DriverDisplaysIPDChanges_Bool" },
+	{ Prop_DSCVersion_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_DSCVersion_Int32" },
+	{ Prop_DSCSliceCount_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_DSCSliceCount_Int32" },
+	{ Prop_DSCBPPx16_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_DSCBPPx16_Int32" },
+	{ Prop_Hmd_MaxDistortedTextureWidth_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_Hmd_MaxDistortedTextureWidth_Int32" },
+	{ Prop_Hmd_MaxDistortedTextureHeight_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_Hmd_MaxDistortedTextureHeight_Int32" },
+	{ Prop_Hmd_AllowSupersampleFiltering_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_Hmd_AllowSupersampleFiltering_Bool" },
+	{ Prop_DriverRequestedMuraCorrectionMode_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_DriverRequestedMuraCorrectionMode_Int32" },
+	{ Prop_DriverRequestedMuraFeather_InnerLeft_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_DriverRequestedMuraFeather_InnerLeft_Int32" },
+	{ Prop_DriverRequestedMuraFeather_InnerRight_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_DriverRequestedMuraFeather_InnerRight_Int32" },
+	{ Prop_DriverRequestedMuraFeather_InnerTop_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_DriverRequestedMuraFeather_InnerTop_Int32" },
+	{ Prop_DriverRequestedMuraFeather_InnerBottom_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_DriverRequestedMuraFeather_InnerBottom_Int32" },
+	{ Prop_DriverRequestedMuraFeather_OuterLeft_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_DriverRequestedMuraFeather_OuterLeft_Int32" },
+	{ Prop_DriverRequestedMuraFeather_OuterRight_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_DriverRequestedMuraFeather_OuterRight_Int32" },
+	{ Prop_DriverRequestedMuraFeather_OuterTop_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_DriverRequestedMuraFeather_OuterTop_Int32" },
+	{ Prop_DriverRequestedMuraFeather_OuterBottom_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_DriverRequestedMuraFeather_OuterBottom_Int32" },
+	{ Prop_Audio_DefaultPlaybackDeviceId_String, TrackedPropertyValueKind_String, 256, "Prop_Audio_DefaultPlaybackDeviceId_String" },
+	{ Prop_Audio_DefaultRecordingDeviceId_String, TrackedPropertyValueKind_String, 256, "Prop_Audio_DefaultRecordingDeviceId_String" },
+	{ Prop_Audio_DefaultPlaybackDeviceVolume_Float, TrackedPropertyValueKind_Float, 0, "Prop_Audio_DefaultPlaybackDeviceVolume_Float" },
+	{ Prop_Audio_SupportsDualSpeakerAndJackOutput_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_Audio_SupportsDualSpeakerAndJackOutput_Bool" },
+	{ Prop_Audio_DriverManagesPlaybackVolumeControl_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_Audio_DriverManagesPlaybackVolumeControl_Bool" },
+	{ Prop_Audio_DriverPlaybackVolume_Float, TrackedPropertyValueKind_Float, 0, "Prop_Audio_DriverPlaybackVolume_Float" },
+	{ Prop_Audio_DriverPlaybackMute_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_Audio_DriverPlaybackMute_Bool" },
+	{ Prop_Audio_DriverManagesRecordingVolumeControl_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_Audio_DriverManagesRecordingVolumeControl_Bool" },
+	{ Prop_Audio_DriverRecordingVolume_Float, TrackedPropertyValueKind_Float, 0, "Prop_Audio_DriverRecordingVolume_Float" },
+	{ Prop_Audio_DriverRecordingMute_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_Audio_DriverRecordingMute_Bool" },
+	{ Prop_AttachedDeviceId_String, TrackedPropertyValueKind_String, 256, "Prop_AttachedDeviceId_String" },
+	{ Prop_SupportedButtons_Uint64, TrackedPropertyValueKind_Uint64, 0, "Prop_SupportedButtons_Uint64" },
+	{ Prop_Axis0Type_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_Axis0Type_Int32" },
+	{ Prop_Axis1Type_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_Axis1Type_Int32" },
+	{ Prop_Axis2Type_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_Axis2Type_Int32" },
+	{ Prop_Axis3Type_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_Axis3Type_Int32" },
+	{ Prop_Axis4Type_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_Axis4Type_Int32" },
+	{ Prop_ControllerRoleHint_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_ControllerRoleHint_Int32" },
+	{ Prop_FieldOfViewLeftDegrees_Float, TrackedPropertyValueKind_Float, 0, "Prop_FieldOfViewLeftDegrees_Float" },
+	{ Prop_FieldOfViewRightDegrees_Float, TrackedPropertyValueKind_Float, 0, "Prop_FieldOfViewRightDegrees_Float" },
+	{ Prop_FieldOfViewTopDegrees_Float, TrackedPropertyValueKind_Float, 0, "Prop_FieldOfViewTopDegrees_Float" },
+	{ Prop_FieldOfViewBottomDegrees_Float, TrackedPropertyValueKind_Float, 0, "Prop_FieldOfViewBottomDegrees_Float" },
+	{ Prop_TrackingRangeMinimumMeters_Float, TrackedPropertyValueKind_Float, 0, "Prop_TrackingRangeMinimumMeters_Float" },
+	{ Prop_TrackingRangeMaximumMeters_Float, TrackedPropertyValueKind_Float, 0, "Prop_TrackingRangeMaximumMeters_Float" },
+	{ Prop_ModeLabel_String, TrackedPropertyValueKind_String, 256, "Prop_ModeLabel_String" },
+	{ Prop_CanWirelessIdentify_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_CanWirelessIdentify_Bool" },
+	{ Prop_Nonce_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_Nonce_Int32" },
+	{ Prop_IconPathName_String, TrackedPropertyValueKind_String, 1024, "Prop_IconPathName_String" },
+	{ Prop_NamedIconPathDeviceOff_String, TrackedPropertyValueKind_String, 1024, "Prop_NamedIconPathDeviceOff_String" },
+	{ Prop_NamedIconPathDeviceSearching_String, TrackedPropertyValueKind_String, 1024, "Prop_NamedIconPathDeviceSearching_String" },
+	{ Prop_NamedIconPathDeviceSearchingAlert_String, TrackedPropertyValueKind_String, 1024, "Prop_NamedIconPathDeviceSearchingAlert_String" },
+	{ Prop_NamedIconPathDeviceReady_String, TrackedPropertyValueKind_String, 1024, "Prop_NamedIconPathDeviceReady_String" },
+	{ Prop_NamedIconPathDeviceReadyAlert_String, TrackedPropertyValueKind_String, 1024, "Prop_NamedIconPathDeviceReadyAlert_String" },
+	{ Prop_NamedIconPathDeviceNotReady_String, TrackedPropertyValueKind_String, 1024, "Prop_NamedIconPathDeviceNotReady_String" },
+	{ Prop_NamedIconPathDeviceStandby_String, TrackedPropertyValueKind_String, 1024, "Prop_NamedIconPathDeviceStandby_String" },
+	{ Prop_NamedIconPathDeviceAlertLow_String, TrackedPropertyValueKind_String, 1024, "Prop_NamedIconPathDeviceAlertLow_String" },
+	{ Prop_NamedIconPathDeviceStandbyAlert_String, TrackedPropertyValueKind_String, 1024, "Prop_NamedIconPathDeviceStandbyAlert_String" },
+	{ Prop_ParentContainer, TrackedPropertyValueKind_Uint64, 0, "Prop_ParentContainer" },
+	{ Prop_OverrideContainer_Uint64, TrackedPropertyValueKind_Uint64, 0, "Prop_OverrideContainer_Uint64" },
+	{ Prop_UserConfigPath_String, TrackedPropertyValueKind_String, 1024, "Prop_UserConfigPath_String" },
+	{ Prop_InstallPath_String, TrackedPropertyValueKind_String, 1024, "Prop_InstallPath_String" },
+	{ Prop_HasDisplayComponent_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_HasDisplayComponent_Bool" },
+	{ Prop_HasControllerComponent_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_HasControllerComponent_Bool" },
+	{ Prop_HasCameraComponent_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_HasCameraComponent_Bool" },
+	{ Prop_HasDriverDirectModeComponent_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_HasDriverDirectModeComponent_Bool" },
+	{ Prop_HasVirtualDisplayComponent_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_HasVirtualDisplayComponent_Bool" },
+	{ Prop_HasSpatialAnchorsSupport_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_HasSpatialAnchorsSupport_Bool" },
+	{ Prop_SupportsXrTextureSets_Bool, TrackedPropertyValueKind_Bool, 0, "Prop_SupportsXrTextureSets_Bool" },
+	{ Prop_ControllerType_String, TrackedPropertyValueKind_String, 256, "Prop_ControllerType_String" },
+	{ Prop_ControllerHandSelectionPriority_Int32, TrackedPropertyValueKind_Int32, 0, "Prop_ControllerHandSelectionPriority_Int32" },
+};
+
+static constexpr uint32_t k_unTrackedPropertyDescriptorCount = sizeof( k_TrackedPropertyDescriptors ) / sizeof( k_TrackedPropertyDescriptors[ 0 ] );
+
+/** Returns the descriptor for eProp, or nullptr if it isn't a property this file knows how to read */
+inline const TrackedPropertyDescriptor_t *FindTrackedPropertyDescriptor( ETrackedDeviceProperty eProp )
+{
+	uint32_t unLow = 0, unHigh = k_unTrackedPropertyDescriptorCount;
+	while ( unLow < unHigh )
+	{
+		uint32_t unMid = ( unLow + unHigh ) / 2;
+		if ( k_TrackedPropertyDescriptors[ unMid ].eProp < eProp )
+			unLow = unMid + 1;
+		else
+			unHigh = unMid;
+	}
+	if ( unLow == k_unTrackedPropertyDescriptorCount || k_TrackedPropertyDescriptors[ unLow ].eProp != eProp )
+		return nullptr;
+	return &k_TrackedPropertyDescriptors[ unLow ];
+}
+
+/** Reads a string property starting with the caller's buffer, and only asks a second time
+* if the value turns out not to fit. */
+inline std::string ReadTrackedDeviceStringProperty( IVRSystem *pSystem, TrackedDeviceIndex_t unDevice, ETrackedDeviceProperty eProp,
+	char *pchBuffer, uint32_t unBufferSize, ETrackedPropertyError *peError )
+{
+	ETrackedPropertyError eError = TrackedProp_Success;
+	uint32_t unRequired = pSystem->GetStringTrackedDeviceProperty( unDevice, eProp, pchBuffer, unBufferSize, &eError );
+	std::string sValue;
+	if ( eError == TrackedProp_BufferTooSmall && unRequired > unBufferSize )
+	{
+		sValue.resize( unRequired );
+		unRequired = pSystem->GetStringTrackedDeviceProperty( unDevice, eProp, &sValue[ 0 ], unRequired, &eError );
+		sValue.resize( eError == TrackedProp_Success && unRequired > 0 ? unRequired - 1 : 0 );
+	}
+	else if ( eError == TrackedProp_Success && unRequired > 0 )
+	{
+		sValue.assign( pchBuffer, unRequired - 1 );
+	}
+	if ( peError )
+		*peError = eError;
+	return sValue;
+}
+
+/** Reads a string property with one query unless it is longer than 255 characters */
+inline std::string GetTrackedDeviceStringProperty( IVRSystem *pSystem, TrackedDeviceIndex_t unDevice, ETrackedDeviceProperty eProp, ETrackedPropertyError *peError = nullptr )
+{
+	char rgchBuffer[ 256 ];
+	return ReadTrackedDeviceStringProperty( pSystem, unDevice, eProp, rgchBuffer, sizeof( rgchBuffer ), peError );
+}
+
+/** Reads an array property starting with room for unInlineCount elements */
+template < typename T >
+inline std::vector< T > ReadTrackedDeviceArrayProperty( IVRSystem *pSystem, TrackedDeviceIndex_t unDevice, ETrackedDeviceProperty eProp,
+	PropertyTypeTag_t unTag, uint32_t unInlineCount, ETrackedPropertyError *peError )
+{
+	std::vector< T > vecValue( unInlineCount );
+	ETrackedPropertyError eError = TrackedProp_Success;
+	uint32_t unRequired = pSystem->GetArrayTrackedDeviceProperty( unDevice, eProp, unTag, vecValue.data(), ( uint32_t )( vecValue.size() * sizeof( T ) ), &eError );
+	if ( eError == TrackedProp_BufferTooSmall && unRequired > vecValue.size() * sizeof( T ) )
+	{
+		vecValue.resize( ( unRequired + sizeof( T ) - 1 ) / sizeof( T ) );
+		unRequired = pSystem->GetArrayTrackedDeviceProperty( unDevice, eProp, unTag, vecValue.data(), ( uint32_t )( vecValue.size() * sizeof( T ) ), &eError );
+	}
+	vecValue.resize( eError == TrackedProp_Success ? unRequired / sizeof( T ) : 0 );
+	if ( peError )
+		*peError = eError;
+	return vecValue;
+}
+
+/** How each kind of value is read. unInlineBufferSize only matters for strings and arrays. */
+template < ETrackedPropertyValueKind eKind, uint32_t unInlineBufferSize >
+struct TrackedPropertyKindTraits;
+
+template < uint32_t unInlineBufferSize >
+struct TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, unInlineBufferSize >
+{
+	typedef bool ValueType;
+	static ValueType Read( IVRSystem *pSystem, TrackedDeviceIndex_t unDevice, ETrackedDeviceProperty eProp, ETrackedPropertyError *peError )
+	{
+		return pSystem->GetBoolTrackedDeviceProperty( unDevice, eProp, peError );
+	}
+};
+
+template < uint32_t unInlineBufferSize >
+struct TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, unInlineBufferSize >
+{
+	typedef float ValueType;
+	static ValueType Read( IVRSystem *pSystem, TrackedDeviceIndex_t unDevice, ETrackedDeviceProperty eProp, ETrackedPropertyError *peError )
+	{
+		return pSystem->GetFloatTrackedDeviceProperty( unDevice, eProp, peError );
+	}
+};
+
+template < uint32_t unInlineBufferSize >
+struct TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, unInlineBufferSize >
+{
+	typedef int32_t ValueType;
+	static ValueType Read( IVRSystem *pSystem, TrackedDeviceIndex_t unDevice, ETrackedDeviceProperty eProp, ETrackedPropertyError *peError )
+	{
+		return pSystem->GetInt32TrackedDeviceProperty( unDevice, eProp, peError );
+	}
+};
+
+template < uint32_t unInlineBufferSize >
+struct TrackedPropertyKindTraits< TrackedPropertyValueKind_Uint64, unInlineBufferSize >
+{
+	typedef uint64_t ValueType;
+	static ValueType Read( IVRSystem *pSystem, TrackedDeviceIndex_t unDevice, ETrackedDeviceProperty eProp, ETrackedPropertyError *peError )
+	{
+		return pSystem->GetUint64TrackedDeviceProperty( unDevice, eProp, peError );
+	}
+};
+
+template < uint32_t unInlineBufferSize >
+struct TrackedPropertyKindTraits< TrackedPropertyValueKind_Matrix34, unInlineBufferSize >
+{
+	typedef HmdMatrix34_t ValueType;
+	static ValueType Read( IVRSystem *pSystem, TrackedDeviceIndex_t unDevice, ETrackedDeviceProperty eProp, ETrackedPropertyError *peError )
+	{
+		return pSystem->GetMatrix34TrackedDeviceProperty( unDevice, eProp, peError );
+	}
+};
+
+template < uint32_t unInlineBufferSize >
+struct TrackedPropertyKindTraits< TrackedPropertyValueKind_Vector3, unInlineBufferSize >
+{
+	typedef HmdVector3_t ValueType;
+	static ValueType Read( IVRSystem *pSystem, TrackedDeviceIndex_t unDevice, ETrackedDeviceProperty eProp, ETrackedPropertyError *peError )
+	{
+		HmdVector3_t vValue = {};
+		ETrackedPropertyError eError = TrackedProp_Success;
+		if ( pSystem->GetArrayTrackedDeviceProperty( unDevice, eProp, k_unHmdVector3PropertyTag, &vValue, sizeof( vValue ), &eError ) != sizeof( vValue )
+			&& eError == TrackedProp_Success )
+		{
+			eError = TrackedProp_WrongDataType;
+		}
+		if ( peError )
+			*peError = eError;
+		return vValue;
+	}
+};
+
+template < uint32_t unInlineBufferSize >
+struct TrackedPropertyKindTraits< TrackedPropertyValueKind_String, unInlineBufferSize >
+{
+	typedef std::string ValueType;
+	static ValueType Read( IVRSystem *pSystem, TrackedDeviceIndex_t unDevice, ETrackedDeviceProperty eProp, ETrackedPropertyError *peError )
+	{
+		char rgchBuffer[ unInlineBufferSize ];
+		return ReadTrackedDeviceStringProperty( pSystem, unDevice, eProp, rgchBuffer, unInlineBufferSize, peError );
+	}
+};
+
+template < uint32_t unInlineBufferSize >
+struct TrackedPropertyKindTraits< TrackedPropertyValueKind_FloatArray, unInlineBufferSize >
+{
+	typedef float ElementType;
+	typedef std::vector< ElementType > ValueType;
+	static const PropertyTypeTag_t k_unTag = k_unFloatPropertyTag;
+	static ValueType Read( IVRSystem *pSystem, TrackedDeviceIndex_t unDevice, ETrackedDeviceProperty eProp, ETrackedPropertyError *peError )
+	{
+		return ReadTrackedDeviceArrayProperty< ElementType >( pSystem, unDevice, eProp, k_unTag, ( unInlineBufferSize + sizeof( ElementType ) - 1 ) / sizeof( ElementType ), peError );
+	}
+};
+
+template < uint32_t unInlineBufferSize >
+struct TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32Array, unInlineBufferSize >
+{
+	typedef int32_t ElementType;
+	typedef std::vector< ElementType > ValueType;
+	static const PropertyTypeTag_t k_unTag = k_unInt32PropertyTag;
+	static ValueType Read( IVRSystem *pSystem, TrackedDeviceIndex_t unDevice, ETrackedDeviceProperty eProp, ETrackedPropertyError *peError )
+	{
+		return ReadTrackedDeviceArrayProperty< ElementType >( pSystem, unDevice, eProp, k_unTag, ( unInlineBufferSize + sizeof( ElementType ) - 1 ) / sizeof( ElementType ), peError );
+	}
+};
+
+template < uint32_t unInlineBufferSize >
+struct TrackedPropertyKindTraits< TrackedPropertyValueKind_Vector4Array, unInlineBufferSize >
+{
+	typedef HmdVector4_t ElementType;
+	typedef std::vector< ElementType > ValueType;
+	static const PropertyTypeTag_t k_unTag = k_unHmdVector4PropertyTag;
+	static ValueType Read( IVRSystem *pSystem, TrackedDeviceIndex_t unDevice, ETrackedDeviceProperty eProp, ETrackedPropertyError *peError )
+	{
+		return ReadTrackedDeviceArrayProperty< ElementType >( pSystem, unDevice, eProp, k_unTag, ( unInlineBufferSize + sizeof( ElementType ) - 1 ) / sizeof( ElementType ), peError );
+	}
+};
+
+template < uint32_t unInlineBufferSize >
+struct TrackedPropertyKindTraits< TrackedPropertyValueKind_Matrix34Array, unInlineBufferSize >
+{
+	typedef HmdMatrix34_t ElementType;
+	typedef std::vector< ElementType > ValueType;
+	static const PropertyTypeTag_t k_unTag = k_unHmdMatrix34PropertyTag;
+	static ValueType Read( IVRSystem *pSystem, TrackedDeviceIndex_t unDevice, ETrackedDeviceProperty eProp, ETrackedPropertyError *peError )
+	{
+		return ReadTrackedDeviceArrayProperty< ElementType >( pSystem, unDevice, eProp, k_unTag, ( unInlineBufferSize + sizeof( ElementType ) - 1 ) / sizeof( ElementType ), peError );
+	}
+};
+
+/** Compile time information about a single property. k_unIndex is its position in k_TrackedPropertyDescriptors. */
+template < ETrackedDeviceProperty eProp >
+struct TrackedPropertyTraits;
+
+template <> struct TrackedPropertyTraits< Prop_TrackingSystemName_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 256 > { static constexpr uint32_t k_unIndex = 0; };
+template <> struct TrackedPropertyTraits< Prop_ModelNumber_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 256 > { static constexpr uint32_t k_unIndex = 1; };
+template <> struct TrackedPropertyTraits< Prop_SerialNumber_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 256 > { static constexpr uint32_t k_unIndex = 2; };
+template <> struct TrackedPropertyTraits< Prop_RenderModelName_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 256 > { static constexpr uint32_t k_unIndex = 3; };
+template <> struct TrackedPropertyTraits< Prop_WillDriftInYaw_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 4; };
+template <> struct TrackedPropertyTraits< Prop_ManufacturerName_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 256 > { static constexpr uint32_t k_unIndex = 5; };
+template <> struct TrackedPropertyTraits< Prop_TrackingFirmwareVersion_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 256 > { static constexpr uint32_t k_unIndex = 6; };
+template <> struct TrackedPropertyTraits< Prop_HardwareRevision_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 256 > { static constexpr uint32_t k_unIndex = 7; };
+template <> struct TrackedPropertyTraits< Prop_AllWirelessDongleDescriptions_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 256 > { static constexpr uint32_t k_unIndex = 8; };
+template <> struct TrackedPropertyTraits< Prop_ConnectedWirelessDongle_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 256 > { static constexpr uint32_t k_unIndex = 9; };
+template <> struct TrackedPropertyTraits< Prop_DeviceIsWireless_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 10; };
+template <> struct TrackedPropertyTraits< Prop_DeviceIsCharging_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 11; };
+template <> struct TrackedPropertyTraits< Prop_DeviceBatteryPercentage_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 12; };
+template <> struct TrackedPropertyTraits< Prop_StatusDisplayTransform_Matrix34 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Matrix34, 0 > { static constexpr uint32_t k_unIndex = 13; };
+template <> struct TrackedPropertyTraits< Prop_Firmware_UpdateAvailable_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 14; };
+template <> struct TrackedPropertyTraits< Prop_Firmware_ManualUpdate_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 15; };
+template <> struct TrackedPropertyTraits< Prop_Firmware_ManualUpdateURL_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 1024 > { static constexpr uint32_t k_unIndex = 16; };
+template <> struct TrackedPropertyTraits< Prop_HardwareRevision_Uint64 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Uint64, 0 > { static constexpr uint32_t k_unIndex = 17; };
+template <> struct TrackedPropertyTraits< Prop_FirmwareVersion_Uint64 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Uint64, 0 > { static constexpr uint32_t k_unIndex = 18; };
+template <> struct TrackedPropertyTraits< Prop_FPGAVersion_Uint64 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Uint64, 0 > { static constexpr uint32_t k_unIndex = 19; };
+template <> struct TrackedPropertyTraits< Prop_VRCVersion_Uint64 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Uint64, 0 > { static constexpr uint32_t k_unIndex = 20; };
+template <> struct TrackedPropertyTraits< Prop_RadioVersion_Uint64 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Uint64, 0 > { static constexpr uint32_t k_unIndex = 21; };
+template <> struct TrackedPropertyTraits< Prop_DongleVersion_Uint64 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Uint64, 0 > { static constexpr uint32_t k_unIndex = 22; };
+template <> struct TrackedPropertyTraits< Prop_BlockServerShutdown_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 23; };
+template <> struct TrackedPropertyTraits< Prop_CanUnifyCoordinateSystemWithHmd_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 24; };
+template <> struct TrackedPropertyTraits< Prop_ContainsProximitySensor_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 25; };
+template <> struct TrackedPropertyTraits< Prop_DeviceProvidesBatteryStatus_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 26; };
+template <> struct TrackedPropertyTraits< Prop_DeviceCanPowerOff_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 27; };
+template <> struct TrackedPropertyTraits< Prop_Firmware_ProgrammingTarget_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 256 > { static constexpr uint32_t k_unIndex = 28; };
+template <> struct TrackedPropertyTraits< Prop_DeviceClass_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 29; };
+template <> struct TrackedPropertyTraits< Prop_HasCamera_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 30; };
+template <> struct TrackedPropertyTraits< Prop_DriverVersion_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 256 > { static constexpr uint32_t k_unIndex = 31; };
+template <> struct TrackedPropertyTraits< Prop_Firmware_ForceUpdateRequired_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 32; };
+template <> struct TrackedPropertyTraits< Prop_ViveSystemButtonFixRequired_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 33; };
+template <> struct TrackedPropertyTraits< Prop_ParentDriver_Uint64 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Uint64, 0 > { static constexpr uint32_t k_unIndex = 34; };
+template <> struct TrackedPropertyTraits< Prop_ResourceRoot_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 1024 > { static constexpr uint32_t k_unIndex = 35; };
+template <> struct TrackedPropertyTraits< Prop_RegisteredDeviceType_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 256 > { static constexpr uint32_t k_unIndex = 36; };
+template <> struct TrackedPropertyTraits< Prop_InputProfilePath_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 1024 > { static constexpr uint32_t k_unIndex = 37; };
+template <> struct TrackedPropertyTraits< Prop_NeverTracked_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 38; };
+template <> struct TrackedPropertyTraits< Prop_NumCameras_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 39; };
+template <> struct TrackedPropertyTraits< Prop_CameraFrameLayout_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 40; };
+template <> struct TrackedPropertyTraits< Prop_CameraStreamFormat_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 41; };
+template <> struct TrackedPropertyTraits< Prop_AdditionalDeviceSettingsPath_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 1024 > { static constexpr uint32_t k_unIndex = 42; };
+template <> struct TrackedPropertyTraits< Prop_Identifiable_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 43; };
+template <> struct TrackedPropertyTraits< Prop_BootloaderVersion_Uint64 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Uint64, 0 > { static constexpr uint32_t k_unIndex = 44; };
+template <> struct TrackedPropertyTraits< Prop_AdditionalSystemReportData_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 256 > { static constexpr uint32_t k_unIndex = 45; };
+template <> struct TrackedPropertyTraits< Prop_CompositeFirmwareVersion_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 256 > { static constexpr uint32_t k_unIndex = 46; };
+template <> struct TrackedPropertyTraits< Prop_Firmware_RemindUpdate_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 47; };
+template <> struct TrackedPropertyTraits< Prop_PeripheralApplicationVersion_Uint64 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Uint64, 0 > { static constexpr uint32_t k_unIndex = 48; };
+template <> struct TrackedPropertyTraits< Prop_ManufacturerSerialNumber_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 256 > { static constexpr uint32_t k_unIndex = 49; };
+template <> struct TrackedPropertyTraits< Prop_ComputedSerialNumber_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 256 > { static constexpr uint32_t k_unIndex = 50; };
+template <> struct TrackedPropertyTraits< Prop_EstimatedDeviceFirstUseTime_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 51; };
+template <> struct TrackedPropertyTraits< Prop_DevicePowerUsage_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 52; };
+template <> struct TrackedPropertyTraits< Prop_IgnoreMotionForStandby_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 53; };
+template <> struct TrackedPropertyTraits< Prop_ActualTrackingSystemName_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 256 > { static constexpr uint32_t k_unIndex = 54; };
+template <> struct TrackedPropertyTraits< Prop_ReportsTimeSinceVSync_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 55; };
+template <> struct TrackedPropertyTraits< Prop_SecondsFromVsyncToPhotons_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 56; };
+template <> struct TrackedPropertyTraits< Prop_DisplayFrequency_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 57; };
+template <> struct TrackedPropertyTraits< Prop_UserIpdMeters_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 58; };
+template <> struct TrackedPropertyTraits< Prop_CurrentUniverseId_Uint64 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Uint64, 0 > { static constexpr uint32_t k_unIndex = 59; };
+template <> struct TrackedPropertyTraits< Prop_PreviousUniverseId_Uint64 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Uint64, 0 > { static constexpr uint32_t k_unIndex = 60; };
+template <> struct TrackedPropertyTraits< Prop_DisplayFirmwareVersion_Uint64 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Uint64, 0 > { static constexpr uint32_t k_unIndex = 61; };
+template <> struct TrackedPropertyTraits< Prop_IsOnDesktop_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 62; };
+template <> struct TrackedPropertyTraits< Prop_DisplayMCType_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 63; };
+template <> struct TrackedPropertyTraits< Prop_DisplayMCOffset_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 64; };
+template <> struct TrackedPropertyTraits< Prop_DisplayMCScale_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 65; };
+template <> struct TrackedPropertyTraits< Prop_EdidVendorID_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 66; };
+template <> struct TrackedPropertyTraits< Prop_DisplayMCImageLeft_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 256 > { static constexpr uint32_t k_unIndex = 67; };
+template <> struct TrackedPropertyTraits< Prop_DisplayMCImageRight_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 256 > { static constexpr uint32_t k_unIndex = 68; };
+template <> struct TrackedPropertyTraits< Prop_DisplayGCBlackClamp_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 69; };
+template <> struct TrackedPropertyTraits< Prop_EdidProductID_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 70; };
+template <> struct TrackedPropertyTraits< Prop_CameraToHeadTransform_Matrix34 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Matrix34, 0 > { static constexpr uint32_t k_unIndex = 71; };
+template <> struct TrackedPropertyTraits< Prop_DisplayGCType_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 72; };
+template <> struct TrackedPropertyTraits< Prop_DisplayGCOffset_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 73; };
+template <> struct TrackedPropertyTraits< Prop_DisplayGCScale_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 74; };
+template <> struct TrackedPropertyTraits< Prop_DisplayGCPrescale_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 75; };
+template <> struct TrackedPropertyTraits< Prop_DisplayGCImage_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 256 > { static constexpr uint32_t k_unIndex = 76; };
+template <> struct TrackedPropertyTraits< Prop_LensCenterLeftU_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 77; };
+template <> struct TrackedPropertyTraits< Prop_LensCenterLeftV_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 78; };
+template <> struct TrackedPropertyTraits< Prop_LensCenterRightU_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 79; };
+template <> struct TrackedPropertyTraits< Prop_LensCenterRightV_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 80; };
+template <> struct TrackedPropertyTraits< Prop_UserHeadToEyeDepthMeters_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 81; };
+template <> struct TrackedPropertyTraits< Prop_CameraFirmwareVersion_Uint64 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Uint64, 0 > { static constexpr uint32_t k_unIndex = 82; };
+template <> struct TrackedPropertyTraits< Prop_CameraFirmwareDescription_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 256 > { static constexpr uint32_t k_unIndex = 83; };
+template <> struct TrackedPropertyTraits< Prop_DisplayFPGAVersion_Uint64 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Uint64, 0 > { static constexpr uint32_t k_unIndex = 84; };
+template <> struct TrackedPropertyTraits< Prop_DisplayBootloaderVersion_Uint64 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Uint64, 0 > { static constexpr uint32_t k_unIndex = 85; };
+template <> struct TrackedPropertyTraits< Prop_DisplayHardwareVersion_Uint64 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Uint64, 0 > { static constexpr uint32_t k_unIndex = 86; };
+template <> struct TrackedPropertyTraits< Prop_AudioFirmwareVersion_Uint64 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Uint64, 0 > { static constexpr uint32_t k_unIndex = 87; };
+template <> struct TrackedPropertyTraits< Prop_CameraCompatibilityMode_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 88; };
+template <> struct TrackedPropertyTraits< Prop_ScreenshotHorizontalFieldOfViewDegrees_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 89; };
+template <> struct TrackedPropertyTraits< Prop_ScreenshotVerticalFieldOfViewDegrees_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 90; };
+template <> struct TrackedPropertyTraits< Prop_DisplaySuppressed_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 91; };
+template <> struct TrackedPropertyTraits< Prop_DisplayAllowNightMode_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 92; };
+template <> struct TrackedPropertyTraits< Prop_DisplayMCImageWidth_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 93; };
+template <> struct TrackedPropertyTraits< Prop_DisplayMCImageHeight_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 94; };
+template <> struct TrackedPropertyTraits< Prop_DisplayMCImageNumChannels_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 95; };
+template <> struct TrackedPropertyTraits< Prop_SecondsFromPhotonsToVblank_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 96; };
+template <> struct TrackedPropertyTraits< Prop_DriverDirectModeSendsVsyncEvents_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 97; };
+template <> struct TrackedPropertyTraits< Prop_DisplayDebugMode_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 98; };
+template <> struct TrackedPropertyTraits< Prop_GraphicsAdapterLuid_Uint64 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Uint64, 0 > { static constexpr uint32_t k_unIndex = 99; };
+template <> struct TrackedPropertyTraits< Prop_DriverProvidedChaperonePath_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 1024 > { static constexpr uint32_t k_unIndex = 100; };
+template <> struct TrackedPropertyTraits< Prop_ExpectedTrackingReferenceCount_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 101; };
+template <> struct TrackedPropertyTraits< Prop_ExpectedControllerCount_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 102; };
+template <> struct TrackedPropertyTraits< Prop_NamedIconPathControllerLeftDeviceOff_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 1024 > { static constexpr uint32_t k_unIndex = 103; };
+template <> struct TrackedPropertyTraits< Prop_NamedIconPathControllerRightDeviceOff_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 1024 > { static constexpr uint32_t k_unIndex = 104; };
+template <> struct TrackedPropertyTraits< Prop_NamedIconPathTrackingReferenceDeviceOff_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 1024 > { static constexpr uint32_t k_unIndex = 105; };
+template <> struct TrackedPropertyTraits< Prop_DoNotApplyPrediction_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 106; };
+template <> struct TrackedPropertyTraits< Prop_CameraToHeadTransforms_Matrix34_Array > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Matrix34Array, 256 > { static constexpr uint32_t k_unIndex = 107; };
+template <> struct TrackedPropertyTraits< Prop_DistortionMeshResolution_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 108; };
+template <> struct TrackedPropertyTraits< Prop_DriverIsDrawingControllers_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 109; };
+template <> struct TrackedPropertyTraits< Prop_DriverRequestsApplicationPause_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 110; };
+template <> struct TrackedPropertyTraits< Prop_DriverRequestsReducedRendering_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 111; };
+template <> struct TrackedPropertyTraits< Prop_MinimumIpdStepMeters_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 112; };
+template <> struct TrackedPropertyTraits< Prop_AudioBridgeFirmwareVersion_Uint64 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Uint64, 0 > { static constexpr uint32_t k_unIndex = 113; };
+template <> struct TrackedPropertyTraits< Prop_ImageBridgeFirmwareVersion_Uint64 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Uint64, 0 > { static constexpr uint32_t k_unIndex = 114; };
+template <> struct TrackedPropertyTraits< Prop_ImuToHeadTransform_Matrix34 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Matrix34, 0 > { static constexpr uint32_t k_unIndex = 115; };
+template <> struct TrackedPropertyTraits< Prop_ImuFactoryGyroBias_Vector3 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Vector3, 0 > { static constexpr uint32_t k_unIndex = 116; };
+template <> struct TrackedPropertyTraits< Prop_ImuFactoryGyroScale_Vector3 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Vector3, 0 > { static constexpr uint32_t k_unIndex = 117; };
+template <> struct TrackedPropertyTraits< Prop_ImuFactoryAccelerometerBias_Vector3 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Vector3, 0 > { static constexpr uint32_t k_unIndex = 118; };
+template <> struct TrackedPropertyTraits< Prop_ImuFactoryAccelerometerScale_Vector3 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Vector3, 0 > { static constexpr uint32_t k_unIndex = 119; };
+template <> struct TrackedPropertyTraits< Prop_ConfigurationIncludesLighthouse20Features_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 120; };
+template <> struct TrackedPropertyTraits< Prop_AdditionalRadioFeatures_Uint64 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Uint64, 0 > { static constexpr uint32_t k_unIndex = 121; };
+template <> struct TrackedPropertyTraits< Prop_CameraWhiteBalance_Vector4_Array > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Vector4Array, 256 > { static constexpr uint32_t k_unIndex = 122; };
+template <> struct TrackedPropertyTraits< Prop_CameraDistortionFunction_Int32_Array > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32Array, 256 > { static constexpr uint32_t k_unIndex = 123; };
+template <> struct TrackedPropertyTraits< Prop_CameraDistortionCoefficients_Float_Array > : TrackedPropertyKindTraits< TrackedPropertyValueKind_FloatArray, 256 > { static constexpr uint32_t k_unIndex = 124; };
+template <> struct TrackedPropertyTraits< Prop_ExpectedControllerType_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 256 > { static constexpr uint32_t k_unIndex = 125; };
+template <> struct TrackedPropertyTraits< Prop_HmdTrackingStyle_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 126; };
+template <> struct TrackedPropertyTraits< Prop_DriverProvidedChaperoneVisibility_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 127; };
+template <> struct TrackedPropertyTraits< Prop_HmdColumnCorrectionSettingPrefix_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 256 > { static constexpr uint32_t k_unIndex = 128; };
+template <> struct TrackedPropertyTraits< Prop_CameraSupportsCompatibilityModes_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 129; };
+template <> struct TrackedPropertyTraits< Prop_SupportsRoomViewDepthProjection_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 130; };
+template <> struct TrackedPropertyTraits< Prop_DisplayAvailableFrameRates_Float_Array > : TrackedPropertyKindTraits< TrackedPropertyValueKind_FloatArray, 256 > { static constexpr uint32_t k_unIndex = 131; };
+template <> struct TrackedPropertyTraits< Prop_DisplaySupportsMultipleFramerates_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 132; };
+template <> struct TrackedPropertyTraits< Prop_DisplayColorMultLeft_Vector3 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Vector3, 0 > { static constexpr uint32_t k_unIndex = 133; };
+template <> struct TrackedPropertyTraits< Prop_DisplayColorMultRight_Vector3 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Vector3, 0 > { static constexpr uint32_t k_unIndex = 134; };
+template <> struct TrackedPropertyTraits< Prop_DisplaySupportsRuntimeFramerateChange_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 135; };
+template <> struct TrackedPropertyTraits< Prop_DisplaySupportsAnalogGain_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 136; };
+template <> struct TrackedPropertyTraits< Prop_DisplayMinAnalogGain_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 137; };
+template <> struct TrackedPropertyTraits< Prop_DisplayMaxAnalogGain_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 138; };
+template <> struct TrackedPropertyTraits< Prop_CameraExposureTime_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 139; };
+template <> struct TrackedPropertyTraits< Prop_CameraGlobalGain_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 140; };
+template <> struct TrackedPropertyTraits< Prop_DashboardScale_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 141; };
+template <> struct TrackedPropertyTraits< Prop_PeerButtonInfo_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 256 > { static constexpr uint32_t k_unIndex = 142; };
+template <> struct TrackedPropertyTraits< Prop_Hmd_SupportsHDR10_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 143; };
+template <> struct TrackedPropertyTraits< Prop_Hmd_EnableParallelRenderCameras_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 144; };
+template <> struct TrackedPropertyTraits< Prop_DriverProvidedChaperoneJson_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 256 > { static constexpr uint32_t k_unIndex = 145; };
+template <> struct TrackedPropertyTraits< Prop_ForceSystemLayerUseAppPoses_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 146; };
+template <> struct TrackedPropertyTraits< Prop_IpdUIRangeMinMeters_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 147; };
+template <> struct TrackedPropertyTraits< Prop_IpdUIRangeMaxMeters_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 148; };
+template <> struct TrackedPropertyTraits< Prop_Hmd_SupportsHDCP14LegacyCompat_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 149; };
+template <> struct TrackedPropertyTraits< Prop_Hmd_SupportsMicMonitoring_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 150; };
+template <> struct TrackedPropertyTraits< Prop_Hmd_SupportsDisplayPortTrainingMode_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 151; };
+template <> struct TrackedPropertyTraits< Prop_Hmd_SupportsRoomViewDirect_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 152; };
+template <> struct TrackedPropertyTraits< Prop_Hmd_SupportsAppThrottling_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 153; };
+template <> struct TrackedPropertyTraits< Prop_Hmd_SupportsGpuBusMonitoring_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 154; };
+template <> struct TrackedPropertyTraits< Prop_DriverDisplaysIPDChanges_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 155; };
+template <> struct TrackedPropertyTraits< Prop_DSCVersion_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 156; };
+template <> struct TrackedPropertyTraits< Prop_DSCSliceCount_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 157; };
+template <> struct TrackedPropertyTraits< Prop_DSCBPPx16_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 158; };
+template <> struct TrackedPropertyTraits< Prop_Hmd_MaxDistortedTextureWidth_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 159; };
+template <> struct TrackedPropertyTraits< Prop_Hmd_MaxDistortedTextureHeight_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 160; };
+template <> struct TrackedPropertyTraits< Prop_Hmd_AllowSupersampleFiltering_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 161; };
+template <> struct TrackedPropertyTraits< Prop_DriverRequestedMuraCorrectionMode_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 162; };
+template <> struct TrackedPropertyTraits< Prop_DriverRequestedMuraFeather_InnerLeft_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 163; };
+template <> struct TrackedPropertyTraits< Prop_DriverRequestedMuraFeather_InnerRight_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 164; };
+template <> struct TrackedPropertyTraits< Prop_DriverRequestedMuraFeather_InnerTop_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 165; };
+template <> struct TrackedPropertyTraits< Prop_DriverRequestedMuraFeather_InnerBottom_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 166; };
+template <> struct TrackedPropertyTraits< Prop_DriverRequestedMuraFeather_OuterLeft_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 167; };
+template <> struct TrackedPropertyTraits< Prop_DriverRequestedMuraFeather_OuterRight_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 168; };
+template <> struct TrackedPropertyTraits< Prop_DriverRequestedMuraFeather_OuterTop_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 169; };
+template <> struct TrackedPropertyTraits< Prop_DriverRequestedMuraFeather_OuterBottom_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 170; };
+template <> struct TrackedPropertyTraits< Prop_Audio_DefaultPlaybackDeviceId_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 256 > { static constexpr uint32_t k_unIndex = 171; };
+template <> struct TrackedPropertyTraits< Prop_Audio_DefaultRecordingDeviceId_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 256 > { static constexpr uint32_t k_unIndex = 172; };
+template <> struct TrackedPropertyTraits< Prop_Audio_DefaultPlaybackDeviceVolume_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 173; };
+template <> struct TrackedPropertyTraits< Prop_Audio_SupportsDualSpeakerAndJackOutput_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 174; };
+template <> struct TrackedPropertyTraits< Prop_Audio_DriverManagesPlaybackVolumeControl_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 175; };
+template <> struct TrackedPropertyTraits< Prop_Audio_DriverPlaybackVolume_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 176; };
+template <> struct TrackedPropertyTraits< Prop_Audio_DriverPlaybackMute_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 177; };
+template <> struct TrackedPropertyTraits< Prop_Audio_DriverManagesRecordingVolumeControl_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 178; };
+template <> struct TrackedPropertyTraits< Prop_Audio_DriverRecordingVolume_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 179; };
+template <> struct TrackedPropertyTraits< Prop_Audio_DriverRecordingMute_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 180; };
+template <> struct TrackedPropertyTraits< Prop_AttachedDeviceId_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 256 > { static constexpr uint32_t k_unIndex = 181; };
+template <> struct TrackedPropertyTraits< Prop_SupportedButtons_Uint64 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Uint64, 0 > { static constexpr uint32_t k_unIndex = 182; };
+template <> struct TrackedPropertyTraits< Prop_Axis0Type_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 183; };
+template <> struct TrackedPropertyTraits< Prop_Axis1Type_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 184; };
+template <> struct TrackedPropertyTraits< Prop_Axis2Type_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 185; };
+template <> struct TrackedPropertyTraits< Prop_Axis3Type_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 186; };
+template <> struct TrackedPropertyTraits< Prop_Axis4Type_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 187; };
+template <> struct TrackedPropertyTraits< Prop_ControllerRoleHint_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 188; };
+template <> struct TrackedPropertyTraits< Prop_FieldOfViewLeftDegrees_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 189; };
+template <> struct TrackedPropertyTraits< Prop_FieldOfViewRightDegrees_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 190; };
+template <> struct TrackedPropertyTraits< Prop_FieldOfViewTopDegrees_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 191; };
+template <> struct TrackedPropertyTraits< Prop_FieldOfViewBottomDegrees_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 192; };
+template <> struct TrackedPropertyTraits< Prop_TrackingRangeMinimumMeters_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 193; };
+template <> struct TrackedPropertyTraits< Prop_TrackingRangeMaximumMeters_Float > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Float, 0 > { static constexpr uint32_t k_unIndex = 194; };
+template <> struct TrackedPropertyTraits< Prop_ModeLabel_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 256 > { static constexpr uint32_t k_unIndex = 195; };
+template <> struct TrackedPropertyTraits< Prop_CanWirelessIdentify_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 196; };
+template <> struct TrackedPropertyTraits< Prop_Nonce_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 197; };
+template <> struct TrackedPropertyTraits< Prop_IconPathName_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 1024 > { static constexpr uint32_t k_unIndex = 198; };
+template <> struct TrackedPropertyTraits< Prop_NamedIconPathDeviceOff_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 1024 > { static constexpr uint32_t k_unIndex = 199; };
+template <> struct TrackedPropertyTraits< Prop_NamedIconPathDeviceSearching_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 1024 > { static constexpr uint32_t k_unIndex = 200; };
+template <> struct TrackedPropertyTraits< Prop_NamedIconPathDeviceSearchingAlert_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 1024 > { static constexpr uint32_t k_unIndex = 201; };
+template <> struct TrackedPropertyTraits< Prop_NamedIconPathDeviceReady_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 1024 > { static constexpr uint32_t k_unIndex = 202; };
+template <> struct TrackedPropertyTraits< Prop_NamedIconPathDeviceReadyAlert_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 1024 > { static constexpr uint32_t k_unIndex = 203; };
+template <> struct TrackedPropertyTraits< Prop_NamedIconPathDeviceNotReady_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 1024 > { static constexpr uint32_t k_unIndex = 204; };
+template <> struct TrackedPropertyTraits< Prop_NamedIconPathDeviceStandby_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 1024 > { static constexpr uint32_t k_unIndex = 205; };
+template <> struct TrackedPropertyTraits< Prop_NamedIconPathDeviceAlertLow_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 1024 > { static constexpr uint32_t k_unIndex = 206; };
+template <> struct TrackedPropertyTraits< Prop_NamedIconPathDeviceStandbyAlert_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 1024 > { static constexpr uint32_t k_unIndex = 207; };
+template <> struct TrackedPropertyTraits< Prop_ParentContainer > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Uint64, 0 > { static constexpr uint32_t k_unIndex = 208; };
+template <> struct TrackedPropertyTraits< Prop_OverrideContainer_Uint64 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Uint64, 0 > { static constexpr uint32_t k_unIndex = 209; };
+template <> struct TrackedPropertyTraits< Prop_UserConfigPath_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 1024 > { static constexpr uint32_t k_unIndex = 210; };
+template <> struct TrackedPropertyTraits< Prop_InstallPath_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 1024 > { static constexpr uint32_t k_unIndex = 211; };
+template <> struct TrackedPropertyTraits< Prop_HasDisplayComponent_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 212; };
+template <> struct TrackedPropertyTraits< Prop_HasControllerComponent_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 213; };
+template <> struct TrackedPropertyTraits< Prop_HasCameraComponent_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 214; };
+template <> struct TrackedPropertyTraits< Prop_HasDriverDirectModeComponent_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 215; };
+template <> struct TrackedPropertyTraits< Prop_HasVirtualDisplayComponent_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 216; };
+template <> struct TrackedPropertyTraits< Prop_HasSpatialAnchorsSupport_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 217; };
+template <> struct TrackedPropertyTraits< Prop_SupportsXrTextureSets_Bool > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Bool, 0 > { static constexpr uint32_t k_unIndex = 218; };
+template <> struct TrackedPropertyTraits< Prop_ControllerType_String > : TrackedPropertyKindTraits< TrackedPropertyValueKind_String, 256 > { static constexpr uint32_t k_unIndex = 219; };
+template <> struct TrackedPropertyTraits< Prop_ControllerHandSelectionPriority_Int32 > : TrackedPropertyKindTraits< TrackedPropertyValueKind_Int32, 0 > { static constexpr uint32_t k_unIndex = 220; };
+
+/** Reads a property with the call and buffer its type needs, for example
+*	std::string sSerial = vr::GetTrackedDeviceProperty< vr::Prop_SerialNumber_String >( vr::VRSystem(), unDevice ); */
+template < ETrackedDeviceProperty eProp >
+inline typename TrackedPropertyTraits< eProp >::ValueType GetTrackedDeviceProperty( IVRSystem *pSystem, TrackedDeviceIndex_t unDevice, ETrackedPropertyError *peError = nullptr )
+{
+	return TrackedPropertyTraits< eProp >::Read( pSystem, unDevice, eProp, peError );
+}
+
+
+/** Every property of one device, read with one query per property in the common case.
+* Values are packed into a single buffer that is reused when the snapshot is captured again. */
+class CTrackedDevicePropertySnapshot
+{
+public:
+	CTrackedDevicePropertySnapshot() : m_unDevice( k_unTrackedDeviceIndexInvalid ), m_unQueryCount( 0 ) { Clear(); }
+
+	/** Reads every property in k_TrackedPropertyDescriptors. Returns how many of them the device provided. */
+	uint32_t Capture( IVRSystem *pSystem, TrackedDeviceIndex_t unDevice );
+	void Clear();
+
+	TrackedDeviceIndex_t GetDevice() const { return m_unDevice; }
+
+	/** Number of property queries the last Capture made */
+	uint32_t GetQueryCount() const { return m_unQueryCount; }
+
+	/** TrackedProp_UnknownProperty for properties this file doesn't describe */
+	ETrackedPropertyError GetError( ETrackedDeviceProperty eProp ) const;
+	bool BHasProperty( ETrackedDeviceProperty eProp ) const { return GetError( eProp ) == TrackedProp_Success; }
+
+	/** Typed reads, with the same defaults IVRSystem returns for missing values or the wrong type */
+	bool GetBool( ETrackedDeviceProperty eProp ) const { bool bValue = false; ReadValue( eProp, TrackedPropertyValueKind_Bool, &bValue, sizeof( bValue ) ); return bValue; }
+	float GetFloat( ETrackedDeviceProperty eProp ) const { float flValue = 0; ReadValue( eProp, TrackedPropertyValueKind_Float, &flValue, sizeof( flValue ) ); return flValue; }
+	int32_t GetInt32( ETrackedDeviceProperty eProp ) const { int32_t nValue = 0; ReadValue( eProp, TrackedPropertyValueKind_Int32, &nValue, sizeof( nValue ) ); return nValue; }
+	uint64_t GetUint64( ETrackedDeviceProperty eProp ) const { uint64_t ulValue = 0; ReadValue( eProp, TrackedPropertyValueKind_Uint64, &ulValue, sizeof( ulValue ) ); return ulValue; }
+	HmdMatrix34_t GetMatrix34( ETrackedDeviceProperty eProp ) const;
+	HmdVector3_t GetVector3( ETrackedDeviceProperty eProp ) const { HmdVector3_t vValue = {}; ReadValue( eProp, TrackedPropertyValueKind_Vector3, &vValue, sizeof( vValue ) ); return vValue; }
+
+	/** Returns "" when the device has no such string. Valid until the next Capture. */
+	const char *GetString( ETrackedDeviceProperty eProp ) const;
+
+	/** Returns the raw elements of an array property and their size in bytes. Valid until the next Capture. */
+	const void *GetArray( ETrackedDeviceProperty eProp, uint32_t *punSize ) const;
+
+private:
+	struct Value_t
+	{
+		ETrackedPropertyError eError;
+		uint32_t unOffset;
+		uint32_t unSize;
+	};
+
+	const Value_t *FindValue( ETrackedDeviceProperty eProp, ETrackedPropertyValueKind eKind ) const;
+	void ReadValue( ETrackedDeviceProperty eProp, ETrackedPropertyValueKind eKind, void *pValue, uint32_t unSize ) const;
+	uint32_t AppendValue( const void *pValue, uint32_t unSize );
+
+	TrackedDeviceIndex_t m_unDevice;
+	uint32_t m_unQueryCount;
+	Value_t m_rgValues[ k_unTrackedPropertyDescriptorCount ];
+	std::vector< char > m_bufValues;
+};
+
+
+inline void CTrackedDevicePropertySnapshot::Clear()
+{
+	m_unDevice = k_unTrackedDeviceIndexInvalid;
+	m_unQueryCount = 0;
+	for ( uint32_t i = 0; i < k_unTrackedPropertyDescriptorCount; i++ )
+	{
+		m_rgValues[ i ].eError = TrackedProp_InvalidDevice;
+		m_rgValues[ i ].unOffset = 0;
+		m_rgValues[ i ].unSize = 0;
+	}
+	m_bufValues.clear();
+}
+
+
+inline uint32_t CTrackedDevicePropertySnapshot::AppendValue( const void *pValue, uint32_t unSize )
+{
+	uint32_t unOffset = ( uint32_t )m_bufValues.size();
+	m_bufValues.insert( m_bufValues.end(), ( const char * )pValue, ( const char * )pValue + unSize );
+	return unOffset;
+}
+
+
+inline uint32_t CTrackedDevicePropertySnapshot::Capture( IVRSystem *pSystem, TrackedDeviceIndex_t unDevice )
+{
+	Clear();
+	m_unDevice = unDevice;
+
+	uint32_t unProvided = 0;
+	for ( uint32_t i = 0; i < k_unTrackedPropertyDescriptorCount; i++ )
+	{
+		const TrackedPropertyDescriptor_t &desc = k_TrackedPropertyDescriptors[ i ];
+		Value_t &value = m_rgValues[ i ];
+		value.eError = TrackedProp_Success;
+		value.unOffset = ( uint32_t )m_bufValues.size();
+		m_unQueryCount++;
+		switch ( desc.eKind )
+		{
+		case TrackedPropertyValueKind_Bool:
+		{
+			bool bValue = pSystem->GetBoolTrackedDeviceProperty( unDevice, desc.eProp, &value.eError );
+			value.unOffset = AppendValue( &bValue, sizeof( bValue ) );
+			break;
+		}
+		case TrackedPropertyValueKind_Float:
+		{
+			float flValue = pSystem->GetFloatTrackedDeviceProperty( unDevice, desc.eProp, &value.eError );
+			value.unOffset = AppendValue( &flValue, sizeof( flValue ) );
+			break;
+		}
+		case TrackedPropertyValueKind_Int32:
+		{
+			int32_t nValue = pSystem->GetInt32TrackedDeviceProperty( unDevice, desc.eProp, &value.eError );
+			value.unOffset = AppendValue( &nValue, sizeof( nValue ) );
+			break;
+		}
+		case TrackedPropertyValueKind_Uint64:
+		{
+			uint64_t ulValue = pSystem->GetUint64TrackedDeviceProperty( unDevice, desc.eProp, &value.eError );
+			value.unOffset = AppendValue( &ulValue, sizeof( ulValue ) );
+			break;
+		}
+		case TrackedPropertyValueKind_Matrix34:
+		{
+			HmdMatrix34_t matValue = pSystem->GetMatrix34TrackedDeviceProperty( unDevice, desc.eProp, &value.eError );
+			value.unOffset = AppendValue( &matValue, sizeof( matValue ) );
+			break;
+		}
+		case TrackedPropertyValueKind_Vector3:
+		{
+			HmdVector3_t vValue = TrackedPropertyKindTraits< TrackedPropertyValueKind_Vector3, 0 >::Read( pSystem, unDevice, desc.eProp, &value.eError );
+			value.unOffset = AppendValue( &vValue, sizeof( vValue ) );
+			break;
+		}
+		case TrackedPropertyValueKind_String:
+		{
+			// read straight into the end of the value buffer, growing it only for values longer than the descriptor expects
+			m_bufValues.resize( value.unOffset + desc.unInlineBufferSize );
+			uint32_t unRequired = pSystem->GetStringTrackedDeviceProperty( unDevice, desc.eProp, &m_bufValues[ value.unOffset ], desc.unInlineBufferSize, &value.eError );
+			if ( value.eError == TrackedProp_BufferTooSmall && unRequired > desc.unInlineBufferSize )
+			{
+				m_unQueryCount++;
+				m_bufValues.resize( value.unOffset + unRequired );
+				unRequired = pSystem->GetStringTrackedDeviceProperty( unDevice, desc.eProp, &m_bufValues[ value.unOffset ], unRequired, &value.eError );
+			}
+			m_bufValues.resize( value.unOffset + ( value.eError == TrackedProp_Success ? unRequired : 0 ) );
+			break;
+		}
+		default:
+		{
+			PropertyTypeTag_t unTag = k_unInvalidPropertyTag;
+			switch ( desc.eKind )
+			{
+			case TrackedPropertyValueKind_FloatArray: unTag = k_unFloatPropertyTag; break;
+			case TrackedPropertyValueKind_Int32Array: unTag = k_unInt32PropertyTag; break;
+			case TrackedPropertyValueKind_Vector4Array: unTag = k_unHmdVector4PropertyTag; break;
+			case TrackedPropertyValueKind_Matrix34Array: unTag = k_unHmdMatrix34PropertyTag; break;
+			default: break;
+			}
+			m_bufValues.resize( value.unOffset + desc.unInlineBufferSize );
+			uint32_t unRequired = pSystem->GetArrayTrackedDeviceProperty( unDevice, desc.eProp, unTag, &m_bufValues[ value.unOffset ], desc.unInlineBufferSize, &value.eError );
+			if ( value.eError == TrackedProp_BufferTooSmall && unRequired > desc.unInlineBufferSize )
+			{
+				m_unQueryCount++;
+				m_bufValues.resize( value.unOffset + unRequired );
+				unRequired = pSystem->GetArrayTrackedDeviceProperty( unDevice, desc.eProp, unTag, &m_bufValues[ value.unOffset ], unRequired, &value.eError );
+			}
+			m_bufValues.resize( value.unOffset + ( value.eError == TrackedProp_Success ? unRequired : 0 ) );
+			break;
+		}
+		}
+		value.unSize = ( uint32_t )m_bufValues.size() - value.unOffset;
+		if ( value.eError == TrackedProp_Success )
+			unProvided++;
+	}
+	return unProvided;
+}
+
+
+inline ETrackedPropertyError CTrackedDevicePropertySnapshot::GetError( ETrackedDeviceProperty eProp ) const
+{
+	const TrackedPropertyDescriptor_t *pDesc = FindTrackedPropertyDescriptor( eProp );
+	if ( !pDesc )
+		return TrackedProp_UnknownProperty;
+	return m_rgValues[ pDesc - k_TrackedPropertyDescriptors ].eError;
+}
+
+
+inline const CTrackedDevicePropertySnapshot::Value_t *CTrackedDevicePropertySnapshot::FindValue( ETrackedDeviceProperty eProp, ETrackedPropertyValueKind eKind ) const
+{
+	const TrackedPropertyDescriptor_t *pDesc = FindTrackedPropertyDescriptor( eProp );
+	if ( !pDesc || pDesc->eKind != eKind )
+		return nullptr;
+	const Value_t *pValue = &m_rgValues[ pDesc - k_TrackedPropertyDescriptors ];
+	return pValue->eError == TrackedProp_Success ? pValue : nullptr;
+}
+
+
+inline void CTrackedDevicePropertySnapshot::ReadValue( ETrackedDeviceProperty eProp, ETrackedPropertyValueKind eKind, void *pValue, uint32_t unSize ) const
+{
+	const Value_t *pStored = FindValue( eProp, eKind );
+	if ( pStored && pStored->unSize == unSize )
+		memcpy( pValue, &m_bufValues[ pStored->unOffset ], unSize );
+}
+
+
+inline HmdMatrix34_t CTrackedDevicePropertySnapshot::GetMatrix34( ETrackedDeviceProperty eProp ) const
+{
+	HmdMatrix34_t matValue = { { { 1, 0, 0, 0 }, { 0, 1, 0, 0 }, { 0, 0, 1, 0 } } };
+	ReadValue( eProp, TrackedPropertyValueKind_Matrix34, &matValue, sizeof( matValue ) );
+	return matValue;
+}
+
+
+inline const char *CTrackedDevicePropertySnapshot::GetString( ETrackedDeviceProperty eProp ) const
+{
+	const Value_t *pValue = FindValue( eProp, TrackedPropertyValueKind_String );
+	if ( !pValue || pValue->unSize == 0 )
+		return "";
+	return &m_bufValues[ pValue->unOffset ];
+}
+
+
+inline const void *CTrackedDevicePropertySnapshot::GetArray( ETrackedDeviceProperty eProp, uint32_t *punSize ) const
+{
+	const TrackedPropertyDescriptor_t *pDesc = FindTrackedPropertyDescriptor( eProp );
+	const Value_t *pValue = pDesc && pDesc->eKind >= TrackedPropertyValueKind_FloatArray ? FindValue( eProp, pDesc->eKind ) : nullptr;
+	if ( punSize )
+		*punSize = pValue ? pValue->unSize : 0;
+	if ( !pValue || pValue->unSize == 0 )
+		return nullptr;
+	return &m_bufValues[ pValue->unOffset ];
+}
+
+} // namespace vr
+
+#endif // _OPENVR_PROPERTIES_H
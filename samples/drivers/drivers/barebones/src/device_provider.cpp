@@ -70,4 +70,6 @@ void MyDeviceProvider::LeaveStandby()
 //-----------------------------------------------------------------------------
 void MyDeviceProvider::Cleanup()
 {
+	// Log anything still queued and stop the log thread before we're unloaded.
+	DriverLogShutdown();
 }
\ No newline at end of file
@@ -4,6 +4,9 @@
 #include "driverlog.h"
 #include "vrmath.h"
 
+#include <stdio.h>
+#include <string.h>
+
 // Let's create some variables for strings used in getting settings.
 // This is the section where all of the settings we want are stored. A section name can be anything,
 // but if you want to store driver specific settings, it's best to namespace the section with the driver identifier
@@ -17,6 +20,8 @@ static const char *my_controller_left_settings_section = "driver_handskeletonsim
 // These are the keys we want to retrieve the values for in the settings
 static const char *my_controller_settings_key_model_number = "model_number";
 static const char *my_controller_settings_key_serial_number = "serial_number";
+static const char *my_controller_settings_key_skeleton_angle_threshold = "skeleton_angle_threshold_degrees";
+static const char *my_controller_settings_key_skeleton_position_threshold = "skeleton_position_threshold_mm";
 
 
 MyControllerDeviceDriver::MyControllerDeviceDriver( vr::ETrackedControllerRole role )
@@ -41,6 +46,11 @@ MyControllerDeviceDriver::MyControllerDeviceDriver( vr::ETrackedControllerRole r
 		my_controller_settings_key_serial_number, serial_number, sizeof( serial_number ) );
 	my_controller_serial_number_ = serial_number;
 
+	// A skeleton is only sent again once some bone would rotate or move by more than these, so we're not sending ~1KB to vrserver for each
+	// motion range every millisecond when the hand has barely moved. Set them to 0 to send every change.
+	my_skeleton_update_settings_.angle_threshold_radians = DEG_TO_RAD( vr::VRSettings()->GetFloat( my_controller_main_settings_section, my_controller_settings_key_skeleton_angle_threshold ) );
+	my_skeleton_update_settings_.position_threshold_meters = vr::VRSettings()->GetFloat( my_controller_main_settings_section, my_controller_settings_key_skeleton_position_threshold ) / 1000.f;
+
 	// Here's an example of how to use our logging wrapper around IVRDriverLog
 	// In SteamVR logs (SteamVR Hamburger Menu > Developer Settings > Web console) drivers have a prefix of
 	// "<driver_name>:". You can search this in the top search bar to find the info that you've logged.
@@ -61,14 +71,18 @@ vr::EVRInitError MyControllerDeviceDriver::Activate( uint32_t unObjectId )
 	// The properties we want, so we call this to retrieve a handle to it.
 	vr::PropertyContainerHandle_t container = vr::VRProperties()->TrackedDeviceToPropertyContainer( my_controller_index_ );
 
+	// Rather than sending each property to vrserver on its own, we collect them in a batch
+	// and send them all at once when we commit it.
+	vr::CVRPropertyBatch props( container, vr::VRPropertiesRaw() );
+
 	// Let's begin setting up the properties now we've got our container.
 	// A list of properties available is contained in vr::ETrackedDeviceProperty.
 
 	// First, let's set the model number.
-	vr::VRProperties()->SetStringProperty( container, vr::Prop_ModelNumber_String, my_controller_model_number_.c_str() );
+	props.SetStringProperty( vr::Prop_ModelNumber_String, my_controller_model_number_.c_str() );
 
 	// Let's tell SteamVR our role which we received from the constructor earlier.
-	vr::VRProperties()->SetInt32Property( container, vr::Prop_ControllerRoleHint_Int32, my_controller_role_ );
+	props.SetInt32Property( vr::Prop_ControllerRoleHint_Int32, my_controller_role_ );
 
 
 	// Now let's set up our inputs
@@ -77,9 +91,11 @@ vr::EVRInitError MyControllerDeviceDriver::Activate( uint32_t unObjectId )
 	// As well as what default bindings should be for legacy apps.
 	// Note, we can use the wildcard {<driver_name>} to match the root folder location
 	// of our driver.
-	vr::VRProperties()->SetStringProperty( container, vr::Prop_InputProfilePath_String, "{indexcontroller}/input/index_controller_profile.json" );
-	vr::VRProperties()->SetStringProperty( container, vr::Prop_ControllerType_String, "knuckles" );
+	props.SetStringProperty( vr::Prop_InputProfilePath_String, "{indexcontroller}/input/index_controller_profile.json" );
+	props.SetStringProperty( vr::Prop_ControllerType_String, "knuckles" );
 
+	// The input components below use the properties we've set, so send them to vrserver now.
+	props.Commit();
 
 	// Let's set up some inputs for our curls. Not strictly needed, but cool to have.
 	vr::VRDriverInput()->CreateScalarComponent( container, "/input/finger/index", &input_handles_[ MyComponent_indexFinger ], vr::VRScalarType_Absolute, vr::VRScalarUnits_NormalizedOneSided );
@@ -98,16 +114,21 @@ vr::EVRInitError MyControllerDeviceDriver::Activate( uint32_t unObjectId )
 		&input_handles_[ MyComponent_skeleton ] // Bind the component to a handle.
 	);
 
-	// SteamVR wants skeletal data immediately.
-	MyInputThread();
-	MyInputThread();
+	// initialise our hand tracking simulation, which sends the skeletons to the component we just made
+	my_skeleton_updater_ = std::make_unique< MySkeletonUpdater >( my_controller_role_, input_handles_[ MyComponent_skeleton ], my_skeleton_update_settings_ );
 
-	// initialise our hand tracking simulation class
-	my_hand_simulation_ = std::make_unique< MyHandSimulation >();
+	// SteamVR wants skeletal data immediately.
+	MyUpdateSkeleton();
+	MyUpdateSkeleton();
 
-	// create a thread for updating our skeleton
+	// Have the driver's pose scheduler update our skeleton and pose every millisecond. It updates every device from one thread.
 	is_active_ = true;
-	my_input_thread_ = std::thread( &MyControllerDeviceDriver::MyInputThread, this );
+	my_pose_update_handle_ = PoseScheduler().AddDevice( my_controller_index_, std::chrono::milliseconds( 1 ), [ this ]( vr::DriverPose_t *pPose )
+		{
+			MyUpdateSkeleton();
+			*pPose = GetPose();
+			return true;
+		} );
 
 	// We've activated everything successfully!
 	// Let's tell SteamVR that by saying we don't have any errors.
@@ -133,6 +154,14 @@ void MyControllerDeviceDriver::DebugRequest( const char *pchRequest, char *pchRe
 {
 	if ( unResponseBufferSize >= 1 )
 		pchResponseBuffer[ 0 ] = 0;
+
+	// Report how many skeleton updates we've sent and how many were too small to bother with
+	if ( strcmp( pchRequest, "skeleton_stats" ) == 0 && my_skeleton_updater_ )
+	{
+		MySkeletonUpdateStats stats;
+		my_skeleton_updater_->GetStats( &stats );
+		snprintf( pchResponseBuffer, unResponseBufferSize, "sent %llu suppressed %llu", ( unsigned long long )stats.sent, ( unsigned long long )stats.suppressed );
+	}
 }
 
 //-----------------------------------------------------------------------------
@@ -155,7 +184,12 @@ void MyControllerDeviceDriver::Deactivate()
 
 	if ( is_active_.exchange( false ) )
 	{
-		my_input_thread_.join();
+		PoseScheduler().RemoveDevice( my_pose_update_handle_ );
+
+		MySkeletonUpdateStats stats;
+		my_skeleton_updater_->GetStats( &stats );
+		DriverLog( "Skeleton updates for %s: %llu sent, %llu suppressed", my_controller_serial_number_.c_str(), ( unsigned long long )stats.sent,
+			( unsigned long long )stats.suppressed );
 	}
 }
 
@@ -222,55 +256,49 @@ vr::DriverPose_t MyControllerDeviceDriver::GetPose()
 	return pose;
 }
 
-void MyControllerDeviceDriver::MyInputThread()
+//-----------------------------------------------------------------------------
+// Purpose: Steps the simulation by one frame and sends the new skeleton to the runtime.
+// The pose scheduler calls this every millisecond, just before it takes our pose.
+//-----------------------------------------------------------------------------
+void MyControllerDeviceDriver::MyUpdateSkeleton()
 {
-	while ( is_active_ )
+	if ( frame_ >= 4000 )
 	{
-		if ( frame_ >= 4000 )
-		{
-			frame_ = 0;
-		}
-
-		const int op = frame_ % 4000;
-		if ( op < 1000 ) // curl 0 -> 1
-		{
-			last_curl_ = last_curl_ + 0.001f;
-		}
-		else if ( op < 2000 ) // curl 1 -> 0
-		{
-			last_curl_ = last_curl_ - 0.001f;
-		}
-		else if ( op < 2500 ) // splay 0 -> 1
-		{
-			last_splay_ = last_splay_ + 0.002f;
-		}
-		else if ( op < 3500 ) // splay 1 -> -1
-		{
-			last_splay_ = last_splay_ - 0.002f;
-		}
-		else // splay -1 -> 0
-		{
-			last_splay_ = last_splay_ + 0.002f;
-		}
+		frame_ = 0;
+	}
 
+	const int op = frame_ % 4000;
+	if ( op < 1000 ) // curl 0 -> 1
+	{
+		last_curl_ = last_curl_ + 0.001f;
+	}
+	else if ( op < 2000 ) // curl 1 -> 0
+	{
+		last_curl_ = last_curl_ - 0.001f;
+	}
+	else if ( op < 2500 ) // splay 0 -> 1
+	{
+		last_splay_ = last_splay_ + 0.002f;
+	}
+	else if ( op < 3500 ) // splay 1 -> -1
+	{
+		last_splay_ = last_splay_ - 0.002f;
+	}
+	else // splay -1 -> 0
+	{
+		last_splay_ = last_splay_ + 0.002f;
+	}
 
-		vr::VRBoneTransform_t transforms[ 31 ];
-		// Pass our calculated curl and splay values to our skeleton simulation model to compute the bone transforms for.
-		my_hand_simulation_->ComputeSkeletonTransforms(
-			my_controller_role_, { last_curl_, last_curl_, last_curl_, last_curl_, last_curl_ }, { last_splay_, last_splay_, last_splay_, last_splay_, last_splay_ }, transforms );
-		// Update the skeleton components.
-		// Applications can choose between using a skeleton as if it's holding a controller, or an interpretation with having it without one.
-		// As ours is just a simulation, let's just set them to the same transforms.
-		vr::VRDriverInput()->UpdateSkeletonComponent( input_handles_[ MyComponent_skeleton ], vr::VRSkeletalMotionRange_WithController, transforms, 31 );
-		vr::VRDriverInput()->UpdateSkeletonComponent( input_handles_[ MyComponent_skeleton ], vr::VRSkeletalMotionRange_WithoutController, transforms, 31 );
 
+	const MyFingerCurls curls = { last_curl_, last_curl_, last_curl_, last_curl_, last_curl_ };
+	const MyFingerSplays splays = { last_splay_, last_splay_, last_splay_, last_splay_, last_splay_ };
 
-		// We'll also update our pose here as well
-		vr::VRServerDriverHost()->TrackedDevicePoseUpdated( my_controller_index_, GetPose(), sizeof( vr::DriverPose_t ) );
+	// Pass our calculated curl and splay values to our skeleton simulation model, which computes the bone transforms and updates the skeleton
+	// component if they've changed enough. Applications can choose between using a skeleton as if it's holding a controller, or an interpretation
+	// with having it without one. As ours is just a simulation, let's just give them the same values.
+	my_skeleton_updater_->Update( curls, splays, curls, splays );
 
-		frame_++;
-		std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
-	}
+	frame_++;
 }
 
 
@@ -5,9 +5,9 @@
 #include <atomic>
 #include <memory>
 #include <string>
-#include <thread>
 
-#include "hand_simulation.h"
+#include "posescheduler.h"
+#include "skeleton_updater.h"
 
 #include "openvr_driver.h"
 
@@ -52,11 +52,12 @@ public:
 	const std::string &MyGetSerialNumber();
 
 private:
-	void MyInputThread();
+	void MyUpdateSkeleton();
 
-	std::thread my_input_thread_;
+	PoseSchedulerHandle_t my_pose_update_handle_ = k_unPoseSchedulerHandleInvalid;
 
-	std::unique_ptr< MyHandSimulation > my_hand_simulation_;
+	MySkeletonUpdateSettings my_skeleton_update_settings_;
+	std::unique_ptr< MySkeletonUpdater > my_skeleton_updater_;
 
 	std::atomic< bool > is_active_ = false;
 
@@ -2,264 +2,415 @@
 // Inspired by Moshi Turner's code from Monado https://gitlab.freedesktop.org/monado/monado/-/blob/main/src/xrt/auxiliary/util/u_hand_simulation.c
 #include "hand_simulation.h"
 #include "vrmath.h"
+#include "vrmath_batch.h"
 
-struct HandSimSplayableJoint
-{
-	vr::HmdVector2_t swing = { 0.f, 0.f };
-	float twist = 0.f;
-};
+#include <algorithm>
+#include <math.h>
+#include <string.h>
 
 struct HandSimJoint
 {
-	float rotation = 0.f;
-};
+	HandSkeletonBone bone;
+	int finger; // which finger's curl and splay move it. thumb, index, middle, ring, pinky (in that order)
 
-struct HandSimThumb
-{
-	HandSimSplayableJoint metacarpal;
-	HandSimSplayableJoint proximal;
-	HandSimJoint distal;
-};
+	// Swing x curls the joint and swing y splays it, in degrees. Joints that don't splay are simple hinges.
+	float rest_swing_x;
+	float curl_swing_x; // per unit of curl
+	float rest_swing_y;
+	float splay_swing_y; // per unit of splay
 
-struct HandSimFinger
-{
-	HandSimSplayableJoint metacarpal;
-	HandSimSplayableJoint proximal;
-	HandSimJoint intermediate;
-	HandSimJoint distal;
-};
-
-struct HandSimHand
-{
-	vr::ETrackedControllerRole role; // Whether we're left or right handed
-
-	HandSimThumb thumb;
-
-	// index, middle, ring, pinky (in that order)
-	HandSimFinger fingers[4];
-};
-
-// rough finger lengths
-static const float finger_joint_lengths[5][5] = {
-	{ 0.05f, 0.05f, 0.035f, 0.025f, 0.f },	  // thumb
-	{ 0.03f, 0.073f, 0.045f, 0.025f, 0.02f }, // index
-	{ 0.01f, 0.091f, 0.049f, 0.03f, 0.02f },  // middle
-	{ 0.02f, 0.073f, 0.045f, 0.03f, 0.03f },  // ring
-	{ 0.03f, 0.067f, 0.03f, 0.025f, 0.02f },  // pinky
+	float length; // rough length of the bone
 };
 
 //-----------------------------------------------------------------------------
-// Purpose: Sets up a default open hand pose which can then be manipulated with curl and splay values.
+// Purpose: A default open hand pose, and how far each joint moves from it with curl and splay.
 // Much of this is very approximate.
 //-----------------------------------------------------------------------------
-static void InitHand(HandSimHand& out_hand)
-{
-	// Default curls for each of the fingers
-	for (auto& finger : out_hand.fingers)
-	{
-		finger.metacarpal.swing.v[1] = 0.f;
-		finger.metacarpal.twist = 0.f;
+static const HandSimJoint hand_metacarpals[ my_hand_metacarpal_count ] = {
+	// The thumb is curled, splayed and "twisted" into a default position, and splays along with its curl
+	{ eBone_Thumb0, 0, 10.f, 5.f, 40.f, 5.f, 0.05f },
+
+	// Give the fingers' metacarpals (the joints that connect to the wrist) some spread. They only curl a little.
+	{ eBone_IndexFinger0, 1, 0.f, 5.f, 13.f, 0.f, 0.03f },
+	{ eBone_MiddleFinger0, 2, 0.f, 5.f, 0.f, 0.f, 0.01f },
+	{ eBone_RingFinger0, 3, 0.f, 5.f, -15.f, 0.f, 0.02f },
+	{ eBone_PinkyFinger0, 4, 0.f, 5.f, -27.f, 0.f, 0.03f },
+};
 
-		finger.proximal.swing.v[1] = DEG_TO_RAD(10);
-		finger.intermediate.rotation = DEG_TO_RAD(5.f);
+static const HandSimJoint hand_joints[ my_hand_joint_count ] = {
+	{ eBone_Thumb1, 0, 0.f, 90.f, 0.f, 20.f, 0.05f },
+	{ eBone_Thumb2, 0, 0.f, 90.f, 0.f, 0.f, 0.035f },
 
-		finger.intermediate.rotation = DEG_TO_RAD(5.f);
-		finger.distal.rotation = DEG_TO_RAD(5.f);
-	}
+	// All fingers (except the thumb) have basically the same properties in terms of curl and splay.
+	// You can splay only the proximal, and curl the proximal, intermediate and distal joints.
+	{ eBone_IndexFinger1, 1, 0.f, 90.f, 3.f, 15.f, 0.073f },
+	{ eBone_IndexFinger2, 1, 5.f, 80.f, 0.f, 0.f, 0.045f },
+	{ eBone_IndexFinger3, 1, 5.f, 80.f, 0.f, 0.f, 0.025f },
 
-	// Curl, splay and "twist" the thumb into a default position
-	out_hand.thumb.metacarpal.swing.v[0] = DEG_TO_RAD(10);
-	out_hand.thumb.metacarpal.swing.v[1] = DEG_TO_RAD(40);
-	out_hand.thumb.metacarpal.twist = DEG_TO_RAD(70);
+	{ eBone_MiddleFinger1, 2, 0.f, 90.f, 0.f, 15.f, 0.091f },
+	{ eBone_MiddleFinger2, 2, 5.f, 80.f, 0.f, 0.f, 0.049f },
+	{ eBone_MiddleFinger3, 2, 5.f, 80.f, 0.f, 0.f, 0.03f },
 
-	out_hand.thumb.proximal.swing.v[0] = 0.f;
-	out_hand.thumb.proximal.swing.v[1] = 0.f;
-	out_hand.thumb.proximal.twist = 0.f;
+	{ eBone_RingFinger1, 3, 0.f, 90.f, -1.f, 15.f, 0.073f },
+	{ eBone_RingFinger2, 3, 5.f, 80.f, 0.f, 0.f, 0.045f },
+	{ eBone_RingFinger3, 3, 5.f, 80.f, 0.f, 0.f, 0.03f },
 
-	out_hand.thumb.distal.rotation = 0.f;
+	{ eBone_PinkyFinger1, 4, 0.f, 90.f, -2.f, 15.f, 0.067f },
+	{ eBone_PinkyFinger2, 4, 5.f, 80.f, 0.f, 0.f, 0.03f },
+	{ eBone_PinkyFinger3, 4, 5.f, 80.f, 0.f, 0.f, 0.025f },
+};
 
-	// Metacarpal splays for each of the fingers. Do this to add some spread to the fingers' metacarpal (the joints that connect to the wrist).
-	out_hand.fingers[0].metacarpal.swing.v[1] = DEG_TO_RAD(13.f);
-	out_hand.fingers[1].metacarpal.swing.v[1] = DEG_TO_RAD(-0.f);
-	out_hand.fingers[2].metacarpal.swing.v[1] = DEG_TO_RAD(-15.f);
-	out_hand.fingers[3].metacarpal.swing.v[1] = DEG_TO_RAD(-27.f);
+// The tips of the fingers don't rotate
+static const struct
+{
+	HandSkeletonBone bone;
+	float length;
+} hand_tips[] = {
+	{ eBone_Thumb3, 0.025f },
+	{ eBone_IndexFinger4, 0.02f },
+	{ eBone_MiddleFinger4, 0.02f },
+	{ eBone_RingFinger4, 0.03f },
+	{ eBone_PinkyFinger4, 0.02f },
+};
 
-	// Proximal splays for each of the fingers. Do this to add some spread to the finger's proximal joints. These joints are also the ones that splay with the values provided.
-	out_hand.fingers[0].proximal.swing.v[1] = DEG_TO_RAD(3.f);
-	out_hand.fingers[1].proximal.swing.v[1] = DEG_TO_RAD(0.f);
-	out_hand.fingers[2].proximal.swing.v[1] = DEG_TO_RAD(-1.f);
-	out_hand.fingers[3].proximal.swing.v[1] = DEG_TO_RAD(-2.f);
+//-----------------------------------------------------------------------------
+// Purpose: The rotation of a joint swung by swing_x and swing_y, with no twist. The same as HmdQuaternion_FromSwingTwist( swing, 0 ), whose x is always 0.
+// For a hinge (swing_y of 0) this is also the same as HmdQuaternion_FromEulerAngles( swing_x, 0, 0 ).
+//
+// That needs cos( theta / 2 ) and sin( theta / 2 ) / theta for a swing of theta. Both are even, so they're polynomials in theta squared, which we have
+// without a square root, and the second one needs no divide or special case at 0. These are their Taylor series to the x^12 term, which are within
+// 2e-7 of the exact values for any swing up to 180 degrees. Joints swing at most about 95 degrees for curls of 0-1 and splays of -1-1.
+//-----------------------------------------------------------------------------
+template < class F >
+static inline void SwingToQuaternion(F swing_x, F swing_y, F& out_w, F& out_y, F& out_z)
+{
+	// (theta / 2)^2
+	const F x2 = (swing_x * swing_x + swing_y * swing_y) * F::Set(0.25f);
+
+	F cos_half_theta = F::Set(1.f / 479001600.f);
+	cos_half_theta = cos_half_theta * x2 - F::Set(1.f / 3628800.f);
+	cos_half_theta = cos_half_theta * x2 + F::Set(1.f / 40320.f);
+	cos_half_theta = cos_half_theta * x2 - F::Set(1.f / 720.f);
+	cos_half_theta = cos_half_theta * x2 + F::Set(1.f / 24.f);
+	cos_half_theta = cos_half_theta * x2 - F::Set(1.f / 2.f);
+	cos_half_theta = cos_half_theta * x2 + F::Set(1.f);
+
+	// sin( theta / 2 ) / ( theta / 2 ), halved
+	F sin_half_theta_over_theta = F::Set(1.f / 6227020800.f);
+	sin_half_theta_over_theta = sin_half_theta_over_theta * x2 - F::Set(1.f / 39916800.f);
+	sin_half_theta_over_theta = sin_half_theta_over_theta * x2 + F::Set(1.f / 362880.f);
+	sin_half_theta_over_theta = sin_half_theta_over_theta * x2 - F::Set(1.f / 5040.f);
+	sin_half_theta_over_theta = sin_half_theta_over_theta * x2 + F::Set(1.f / 120.f);
+	sin_half_theta_over_theta = sin_half_theta_over_theta * x2 - F::Set(1.f / 6.f);
+	sin_half_theta_over_theta = (sin_half_theta_over_theta * x2 + F::Set(1.f)) * F::Set(0.5f);
+
+	out_w = cos_half_theta;
+	out_y = swing_y * sin_half_theta_over_theta;
+	out_z = swing_x * sin_half_theta_over_theta;
 }
 
 //-----------------------------------------------------------------------------
-// Purpose: All fingers (expect thumb) have basically the same properties in terms of curl and splay.
-// You can splay only the proximal, and curl the proximal, intermediate and distal joints.
-// This applies the curl and splay to these joints.
+// Purpose: Solves a batch of joints, one per lane. The curl and splay for each lane have already been picked out from its finger.
 //-----------------------------------------------------------------------------
-static void ApplyGenericFingerTransform(const float curl, const float splay, HandSimFinger& out_finger)
+struct HandSimJointKernel
 {
-	out_finger.metacarpal.swing.v[0] += DEG_TO_RAD(curl * 5.f); // the metacarpal only curls a little
-
-	out_finger.proximal.swing.v[0] += DEG_TO_RAD(curl * 90.f);
-	out_finger.proximal.swing.v[1] += DEG_TO_RAD(splay * 15.f);
+	const float* rest_swing_x;
+	const float* curl_swing_x;
+	const float* rest_swing_y;
+	const float* splay_swing_y;
+	const float* curl;
+	const float* splay;
+
+	float* out_w;
+	float* out_y;
+	float* out_z;
+
+	template < class F >
+	void Run(uint32_t i) const
+	{
+		const F swing_x = F::Load(rest_swing_x + i) + F::Load(curl_swing_x + i) * F::Load(curl + i);
+		const F swing_y = F::Load(rest_swing_y + i) + F::Load(splay_swing_y + i) * F::Load(splay + i);
 
-	out_finger.intermediate.rotation += DEG_TO_RAD(curl * 80.f);
-	out_finger.distal.rotation += DEG_TO_RAD(curl * 80.f);
-}
+		F w, y, z;
+		SwingToQuaternion(swing_x, swing_y, w, y, z);
 
+		w.Store(out_w + i);
+		y.Store(out_y + i);
+		z.Store(out_z + i);
+	}
+};
 
 //-----------------------------------------------------------------------------
-// Purpose: Takes an orientation and length of a joint and converts it to a vr::VRBoneTransform_t
-// We have to do convert the quaternion as we use vr::HmdQuaternion_t for our representation, but OpenVR wants vr::HmdQuaternionf_t
+// Purpose: Solves a batch of metacarpals. These also need their offset from the wrist rotated by their orientation.
 //-----------------------------------------------------------------------------
-static void ComputeBoneTransform(const vr::ETrackedControllerRole role, const vr::HmdQuaternion_t& orientation, const vr::HmdVector3_t& position, vr::VRBoneTransform_t& out_transform)
+struct HandSimMetacarpalKernel
 {
-	// Note that we use vr::HmdQuaternion_t but the Skeletal Input API needs vr::HmdQuaternionf_t, so we'll use this helper to convert
-	HmdQuaternion_ConvertQuaternion(orientation, out_transform.orientation);
+	HandSimJointKernel joint;
+	const float* length;
 
-	// Fit the HmdVector3_t into the HmdVector4_t that the Skeletal Input API accepts
-	HmdVector3_CovertVector(position, out_transform.position);
-	out_transform.position.v[3] = 1.f;
+	float* out_x;
+	float* out_position[ 3 ];
 
-	//"up" axis is flipped between hands, so inverse the joint length for the right hand, as we base all our computations of the left skeleton pose.
-	if (role == vr::TrackedControllerRole_RightHand)
+	template < class F >
+	void Run(uint32_t i) const
 	{
-		out_transform.position.v[0] *= -1.f;
+		const F swing_x = F::Load(joint.rest_swing_x + i) + F::Load(joint.curl_swing_x + i) * F::Load(joint.curl + i);
+		const F swing_y = F::Load(joint.rest_swing_y + i) + F::Load(joint.splay_swing_y + i) * F::Load(joint.splay + i);
+
+		F w, y, z;
+		SwingToQuaternion(swing_x, swing_y, w, y, z);
+
+		/*
+		The Skeletal Input API is designed to be used with common industry tools, such as Maya, to make it easier to move content from 3D editors into VR.
+		The way that FBX handles conversion to a different coordinate system is to transform the root bone (wrist), then counter-transform the root's children to account for the root's change, but then
+		leave the local coordinate systems of the remaining bones as-is This means that the metacarpals will be rotated 90 degrees from the wrist if trying to build a skeleton programmatically. So, we
+		apply this extra rotation to the metacarpals to account for this.
+
+		This is { 0.5, 0.5, -0.5, 0.5 } * orientation, multiplied out knowing orientation's x is 0.
+		*/
+		const F half = F::Set(0.5f);
+		const F bone_w = half * (w + y - z);
+		const F bone_x = half * (w - y - z);
+		const F bone_y = half * (y - z - w);
+		const F bone_z = half * (w + y + z);
+
+		// The offset is { length, 0, 0 }, so rotating it picks out the first column of the rotation matrix
+		const F two = F::Set(2.f);
+		const F bone_length = F::Load(length + i);
+		((F::Set(1.f) - two * (bone_y * bone_y + bone_z * bone_z)) * bone_length).Store(out_position[ 0 ] + i);
+		(two * (bone_x * bone_y + bone_w * bone_z) * bone_length).Store(out_position[ 1 ] + i);
+		(two * (bone_x * bone_z - bone_w * bone_y) * bone_length).Store(out_position[ 2 ] + i);
+
+		bone_w.Store(joint.out_w + i);
+		bone_x.Store(out_x + i);
+		bone_y.Store(joint.out_y + i);
+		bone_z.Store(joint.out_z + i);
 	}
-}
-
+};
 
 //-----------------------------------------------------------------------------
-// Purpose: This is just a little helper function to make our calls when trying to compute each bone a little simpler by specifying just a float for joint length, instead of the whole vector
+// Purpose: The kernels work on whole SIMD vectors, so round the lane count up to one. The extra lanes are zeroed and their results ignored.
 //-----------------------------------------------------------------------------
-static void ComputeBoneTransform(const vr::ETrackedControllerRole role, const vr::HmdQuaternion_t& orientation, const float joint_length, vr::VRBoneTransform_t& out_transform)
+static uint32_t RoundUpToVector(int lanes)
+{
+	return (lanes + 7) & ~7;
+}
+
+static void FillLanes(const HandSimJoint* joints, int joint_count, float (&rest_swing_x)[ my_hand_joint_lanes ], float (&curl_swing_x)[ my_hand_joint_lanes ],
+	float (&rest_swing_y)[ my_hand_joint_lanes ], float (&splay_swing_y)[ my_hand_joint_lanes ], float (&length)[ my_hand_joint_lanes ])
 {
-	ComputeBoneTransform(role, orientation, { joint_length, 0.f, 0.f }, out_transform);
+	memset(rest_swing_x, 0, sizeof(rest_swing_x));
+	memset(curl_swing_x, 0, sizeof(curl_swing_x));
+	memset(rest_swing_y, 0, sizeof(rest_swing_y));
+	memset(splay_swing_y, 0, sizeof(splay_swing_y));
+	memset(length, 0, sizeof(length));
+
+	// The same joints again for each motion range
+	for (int range = 0; range < 2; range++)
+	{
+		for (int joint = 0; joint < joint_count; joint++)
+		{
+			const int lane = range * joint_count + joint;
+			rest_swing_x[ lane ] = (float)DEG_TO_RAD(joints[ joint ].rest_swing_x);
+			curl_swing_x[ lane ] = (float)DEG_TO_RAD(joints[ joint ].curl_swing_x);
+			rest_swing_y[ lane ] = (float)DEG_TO_RAD(joints[ joint ].rest_swing_y);
+			splay_swing_y[ lane ] = (float)DEG_TO_RAD(joints[ joint ].splay_swing_y);
+			length[ lane ] = joints[ joint ].length;
+		}
+	}
 }
 
 //-----------------------------------------------------------------------------
-// Purpose: Takes an orientation and length of a joint and converts it to a vr::VRBoneTransform_t, but with the orientation applied to the offset
-// We have to do convert the quaternion as we use vr::HmdQuaternion_t for our representation, but OpenVR wants vr::HmdQuaternionf_t
+// Purpose: Works out everything that doesn't depend on the curls and splays up front.
 //-----------------------------------------------------------------------------
-static void ComputeBoneTransformMetacarpal(const vr::ETrackedControllerRole role, const vr::HmdQuaternion_t& orientation, const float joint_length, vr::VRBoneTransform_t& out_transform)
+MyHandSimulation::MyHandSimulation()
 {
-	const vr::HmdVector3_t offset = { joint_length, 0.f, 0.f };
+	FillLanes(hand_metacarpals, my_hand_metacarpal_count, metacarpal_lanes_.rest_swing_x, metacarpal_lanes_.curl_swing_x, metacarpal_lanes_.rest_swing_y,
+		metacarpal_lanes_.splay_swing_y, metacarpal_lanes_.length);
+	FillLanes(hand_joints, my_hand_joint_count, joint_lanes_.rest_swing_x, joint_lanes_.curl_swing_x, joint_lanes_.rest_swing_y, joint_lanes_.splay_swing_y,
+		joint_lanes_.length);
 
 	/*
-	The Skeletal Input API is designed to be used with common industry tools, such as Maya, to make it easier to move content from 3D editors into VR.
-	The way that FBX handles conversion to a different coordinate system is to transform the root bone (wrist), then counter-transform the root's children to account for the root's change, but then
-	leave the local coordinate systems of the remaining bones as-is This means that the metacarpals will be rotated 90 degrees from the wrist if trying to build a skeleton programmatically. So, we
-	apply this extra rotation to the metacarpals to account for this.
-	*/
-	vr::HmdQuaternion_t magic = { 0.5f, 0.5f, -0.5f, 0.5f };
-
-	vr::HmdQuaternion_t bone_orientation = magic * orientation;
+	A joint's swing angles move linearly with its finger's curl and splay, and a swing's rotation never moves further than its swing angles do, so a
+	joint rotates by at most the length of the change in its swing. Taking each finger's largest curl and splay swings separately only makes that
+	bound larger.
 
-	// Rotate the offset vector by the orientation
-	vr::HmdVector3_t bone_position = offset * bone_orientation;
-
-	//"up" axis is flipped between hands, so we need to inverse the x and y axis for the right hand, as all our calculations are based on the left hand currently.
-	if (role == vr::TrackedControllerRole_RightHand)
+	The metacarpals carry their offset from the wrist round with them, which moves by at most the angle times its length. The other joints' offsets
+	lie along their parent's x axis whatever their rotation, so they only rotate.
+	*/
+	memset(finger_motion_, 0, sizeof(finger_motion_));
+	for (const HandSimJoint& joint : hand_metacarpals)
 	{
-		std::swap(bone_orientation.w, bone_orientation.x);
-		std::swap(bone_orientation.y, bone_orientation.z);
-
-		bone_orientation.x *= -1.f;
-		bone_orientation.z *= -1.f;
+		FingerMotion& motion = finger_motion_[ joint.finger ];
+		motion.curl_radians = std::max(motion.curl_radians, fabsf((float)DEG_TO_RAD(joint.curl_swing_x)));
+		motion.splay_radians = std::max(motion.splay_radians, fabsf((float)DEG_TO_RAD(joint.splay_swing_y)));
+		motion.curl_meters = std::max(motion.curl_meters, fabsf((float)DEG_TO_RAD(joint.curl_swing_x)) * joint.length);
+		motion.splay_meters = std::max(motion.splay_meters, fabsf((float)DEG_TO_RAD(joint.splay_swing_y)) * joint.length);
+	}
+	for (const HandSimJoint& joint : hand_joints)
+	{
+		FingerMotion& motion = finger_motion_[ joint.finger ];
+		motion.curl_radians = std::max(motion.curl_radians, fabsf((float)DEG_TO_RAD(joint.curl_swing_x)));
+		motion.splay_radians = std::max(motion.splay_radians, fabsf((float)DEG_TO_RAD(joint.splay_swing_y)));
 	}
 
-	// pass off to put the position and orientation we've calculated into the skeleton
-	ComputeBoneTransform(role, bone_orientation, bone_position, out_transform);
+	for (int hand = 0; hand < 2; hand++)
+	{
+		vr::VRBoneTransform_t* rest_pose = rest_pose_[ hand ];
+
+		// Bones we don't simulate, such as the aux bones, are left at the origin
+		for (int bone = 0; bone < eBone_Count; bone++)
+		{
+			rest_pose[ bone ] = { { 0.f, 0.f, 0.f, 1.f }, { 1.f, 0.f, 0.f, 0.f } };
+		}
+
+		// root bone. This is just 0s. It's aligned to /pose/raw.
+		rest_pose[ eBone_Root ] = { { 0.000000f, 0.000000f, 0.000000f, 1.000000f }, { 1.000000f, -0.000000f, -0.000000f, 0.000000f } };
+
+		// wrist bone. This was taken from the index controller pose.
+		rest_pose[ eBone_Wrist ] = { { -0.034038f, 0.036503f, 0.164722f, 1.000000f }, { -0.055147f, -0.078608f, -0.920279f, 0.379296f } };
+
+		// Every bone but the metacarpals sits its joint length along x from its parent
+		for (const HandSimJoint& joint : hand_joints)
+		{
+			rest_pose[ joint.bone ].position.v[ 0 ] = joint.length;
+		}
+		for (const auto& tip : hand_tips)
+		{
+			rest_pose[ tip.bone ].position.v[ 0 ] = tip.length;
+		}
+
+		//"up" axis is flipped between hands, so inverse the x axis for the right hand, as we base all our computations of the left skeleton pose.
+		if (hand == 1)
+		{
+			for (int bone = eBone_Wrist; bone < eBone_Count; bone++)
+			{
+				rest_pose[ bone ].position.v[ 0 ] *= -1.f;
+			}
+
+			rest_pose[ eBone_Wrist ].orientation.y *= -1.f;
+			rest_pose[ eBone_Wrist ].orientation.z *= -1.f;
+		}
+	}
 }
 
 //-----------------------------------------------------------------------------
-// Purpose: Get the OpenVR bone index from a finger (index=0, middle=1...) and the bone position in the finger. Used in ComputeSkeletalTransforms
+// Purpose: Solves every finger of every motion range at once, then copies the results over the rest pose
 //-----------------------------------------------------------------------------
-static int CalculateBoneTransformPositionFromFinger(int finger, int bone_in_finger)
+void MyHandSimulation::Solve(vr::ETrackedControllerRole role, int range_count, const MyFingerCurls* curls, const MyFingerSplays* splays, vr::VRBoneTransform_t** out_transforms)
 {
-	const int bone_transform_finger_start_offset = eBone_IndexFinger0;
-
-	const int result = bone_transform_finger_start_offset + finger * 5 + bone_in_finger;
+	const bool is_right_hand = role == vr::TrackedControllerRole_RightHand;
 
-	return result;
-}
+	// Pick out each lane's curl and splay from its finger
+	float metacarpal_curl[ my_hand_metacarpal_lanes ] = {};
+	float metacarpal_splay[ my_hand_metacarpal_lanes ] = {};
+	float joint_curl[ my_hand_joint_lanes ] = {};
+	float joint_splay[ my_hand_joint_lanes ] = {};
 
-//-----------------------------------------------------------------------------
-// Purpose: Given the curls and splays, convert this to a vr::VRBoneTransform_t array
-//-----------------------------------------------------------------------------
-static void ComputeSkeletalTransforms(const HandSimHand& hand, vr::VRBoneTransform_t* out_transforms)
-{
-	// Do the thumb separately as it's special and not like the other fingers
-	ComputeBoneTransformMetacarpal(
-		hand.role, HmdQuaternion_FromSwingTwist(hand.thumb.metacarpal.swing, hand.thumb.metacarpal.twist), finger_joint_lengths[0][0], out_transforms[eBone_Thumb0]);
-	ComputeBoneTransform(hand.role, HmdQuaternion_FromSwingTwist(hand.thumb.proximal.swing, hand.thumb.metacarpal.twist), finger_joint_lengths[0][1], out_transforms[eBone_Thumb1]);
-	ComputeBoneTransform(hand.role, HmdQuaternion_FromEulerAngles(hand.thumb.distal.rotation, 0.f, 0.f), finger_joint_lengths[0][2], out_transforms[eBone_Thumb2]);
-	ComputeBoneTransform(hand.role, HmdQuaternion_Identity, finger_joint_lengths[0][3], out_transforms[eBone_Thumb3]);
-
-	// index, middle, ring, pinky
-	// We can do these all together as they all require the same calculations
-	for (int finger = 0; finger < 4; finger++)
+	for (int range = 0; range < range_count; range++)
 	{
-		ComputeBoneTransformMetacarpal(hand.role, HmdQuaternion_FromSwingTwist(hand.fingers[finger].metacarpal.swing, hand.fingers[finger].metacarpal.twist),
-			finger_joint_lengths[finger + 1][0], out_transforms[CalculateBoneTransformPositionFromFinger(finger, 0)]);
+		const float finger_curls[ 5 ] = { curls[ range ].thumb, curls[ range ].index, curls[ range ].middle, curls[ range ].ring, curls[ range ].pinky };
+		const float finger_splays[ 5 ] = { splays[ range ].thumb, splays[ range ].index, splays[ range ].middle, splays[ range ].ring, splays[ range ].pinky };
+
+		for (int joint = 0; joint < my_hand_metacarpal_count; joint++)
+		{
+			metacarpal_curl[ range * my_hand_metacarpal_count + joint ] = finger_curls[ hand_metacarpals[ joint ].finger ];
+			metacarpal_splay[ range * my_hand_metacarpal_count + joint ] = finger_splays[ hand_metacarpals[ joint ].finger ];
+		}
+		for (int joint = 0; joint < my_hand_joint_count; joint++)
+		{
+			joint_curl[ range * my_hand_joint_count + joint ] = finger_curls[ hand_joints[ joint ].finger ];
+			joint_splay[ range * my_hand_joint_count + joint ] = finger_splays[ hand_joints[ joint ].finger ];
+		}
+	}
 
-		ComputeBoneTransform(hand.role, HmdQuaternion_FromSwingTwist(hand.fingers[finger].proximal.swing, hand.fingers[finger].proximal.twist), finger_joint_lengths[finger + 1][1],
-			out_transforms[CalculateBoneTransformPositionFromFinger(finger, 1)]);
+	float metacarpal_w[ my_hand_metacarpal_lanes ], metacarpal_x[ my_hand_metacarpal_lanes ], metacarpal_y[ my_hand_metacarpal_lanes ], metacarpal_z[ my_hand_metacarpal_lanes ];
+	float metacarpal_position[ 3 ][ my_hand_metacarpal_lanes ];
+	float joint_w[ my_hand_joint_lanes ], joint_y[ my_hand_joint_lanes ], joint_z[ my_hand_joint_lanes ];
 
-		ComputeBoneTransform(hand.role, HmdQuaternion_FromEulerAngles(hand.fingers[finger].intermediate.rotation, 0.f, 0.f), finger_joint_lengths[finger + 1][2],
-			out_transforms[CalculateBoneTransformPositionFromFinger(finger, 2)]);
+	HandSimMetacarpalKernel metacarpal_kernel = {
+		{ metacarpal_lanes_.rest_swing_x, metacarpal_lanes_.curl_swing_x, metacarpal_lanes_.rest_swing_y, metacarpal_lanes_.splay_swing_y, metacarpal_curl,
+			metacarpal_splay, metacarpal_w, metacarpal_y, metacarpal_z },
+		metacarpal_lanes_.length,
+		metacarpal_x,
+		{ metacarpal_position[ 0 ], metacarpal_position[ 1 ], metacarpal_position[ 2 ] },
+	};
+	vrmath_batch::RunKernel(metacarpal_kernel, RoundUpToVector(range_count * my_hand_metacarpal_count));
 
-		ComputeBoneTransform(hand.role, HmdQuaternion_FromEulerAngles(hand.fingers[finger].distal.rotation, 0.f, 0.f), finger_joint_lengths[finger + 1][3],
-			out_transforms[CalculateBoneTransformPositionFromFinger(finger, 3)]);
+	HandSimJointKernel joint_kernel = { joint_lanes_.rest_swing_x, joint_lanes_.curl_swing_x, joint_lanes_.rest_swing_y, joint_lanes_.splay_swing_y, joint_curl, joint_splay,
+		joint_w, joint_y, joint_z };
+	vrmath_batch::RunKernel(joint_kernel, RoundUpToVector(range_count * my_hand_joint_count));
 
-		ComputeBoneTransform(hand.role, HmdQuaternion_Identity, finger_joint_lengths[finger + 1][4], out_transforms[CalculateBoneTransformPositionFromFinger(finger, 4)]);
+	for (int range = 0; range < range_count; range++)
+	{
+		vr::VRBoneTransform_t* transforms = out_transforms[ range ];
+		memcpy(transforms, rest_pose_[ is_right_hand ? 1 : 0 ], sizeof(rest_pose_[ 0 ]));
+
+		for (int joint = 0; joint < my_hand_metacarpal_count; joint++)
+		{
+			const int lane = range * my_hand_metacarpal_count + joint;
+			vr::VRBoneTransform_t& transform = transforms[ hand_metacarpals[ joint ].bone ];
+
+			//"up" axis is flipped between hands, so we need to inverse the x and y axis for the right hand, as all our calculations are based on the left hand currently.
+			if (is_right_hand)
+			{
+				transform.orientation = { metacarpal_x[ lane ], -metacarpal_w[ lane ], metacarpal_z[ lane ], -metacarpal_y[ lane ] };
+				transform.position.v[ 0 ] = -metacarpal_position[ 0 ][ lane ];
+			}
+			else
+			{
+				transform.orientation = { metacarpal_w[ lane ], metacarpal_x[ lane ], metacarpal_y[ lane ], metacarpal_z[ lane ] };
+				transform.position.v[ 0 ] = metacarpal_position[ 0 ][ lane ];
+			}
+			transform.position.v[ 1 ] = metacarpal_position[ 1 ][ lane ];
+			transform.position.v[ 2 ] = metacarpal_position[ 2 ][ lane ];
+		}
+
+		for (int joint = 0; joint < my_hand_joint_count; joint++)
+		{
+			const int lane = range * my_hand_joint_count + joint;
+			transforms[ hand_joints[ joint ].bone ].orientation = { joint_w[ lane ], 0.f, joint_y[ lane ], joint_z[ lane ] };
+		}
 	}
 }
 
 void MyHandSimulation::ComputeSkeletonTransforms(vr::ETrackedControllerRole role, const MyFingerCurls& curls, const MyFingerSplays& splays, vr::VRBoneTransform_t* out_transforms)
 {
-	// This is where we store our internal representation of curls and splays for the hand.
-	HandSimHand hand{};
-
-	// Set the handed-ness of the current skeleton (left or right hand)
-	hand.role = role;
-
-	// root bone. This is just 0s. It's aligned to /pose/raw.
-	out_transforms[0] = { { 0.000000f, 0.000000f, 0.000000f, 1.000000f }, { 1.000000f, -0.000000f, -0.000000f, 0.000000f } };
-
-	// wrist bone. This was taken from the index controller pose.
+	Solve(role, 1, &curls, &splays, &out_transforms);
+}
 
-	out_transforms[1] = { { -0.034038f, 0.036503f, 0.164722f, 1.000000f }, { -0.055147f, -0.078608f, -0.920279f, 0.379296f } };
+void MyHandSimulation::ComputeSkeletonTransforms(vr::ETrackedControllerRole role, const MyFingerCurls& curls_with_controller, const MyFingerSplays& splays_with_controller,
+	const MyFingerCurls& curls_without_controller, const MyFingerSplays& splays_without_controller, vr::VRBoneTransform_t* out_transforms_with_controller,
+	vr::VRBoneTransform_t* out_transforms_without_controller)
+{
+	const MyFingerCurls curls[ 2 ] = { curls_with_controller, curls_without_controller };
+	const MyFingerSplays splays[ 2 ] = { splays_with_controller, splays_without_controller };
+	vr::VRBoneTransform_t* out_transforms[ 2 ] = { out_transforms_with_controller, out_transforms_without_controller };
+	Solve(role, 2, curls, splays, out_transforms);
+}
 
-	//"up" axis is flipped between hands so invert
-	if (role == vr::TrackedControllerRole_RightHand)
+void MyHandSimulation::BoundBoneMotion(const MyFingerCurls& from_curls, const MyFingerSplays& from_splays, const MyFingerCurls& to_curls, const MyFingerSplays& to_splays,
+	float* out_radians, float* out_meters) const
+{
+	const float curl_change[ 5 ] = { to_curls.thumb - from_curls.thumb, to_curls.index - from_curls.index, to_curls.middle - from_curls.middle,
+		to_curls.ring - from_curls.ring, to_curls.pinky - from_curls.pinky };
+	const float splay_change[ 5 ] = { to_splays.thumb - from_splays.thumb, to_splays.index - from_splays.index, to_splays.middle - from_splays.middle,
+		to_splays.ring - from_splays.ring, to_splays.pinky - from_splays.pinky };
+
+	float radians_squared = 0.f;
+	float meters_squared = 0.f;
+	for (int finger = 0; finger < 5; finger++)
 	{
-		out_transforms[1].position.v[0] *= -1.f;
-
-		out_transforms[1].orientation.y *= -1.f;
-		out_transforms[1].orientation.z *= -1.f;
+		const FingerMotion& motion = finger_motion_[ finger ];
+		const float curl_radians = motion.curl_radians * curl_change[ finger ];
+		const float splay_radians = motion.splay_radians * splay_change[ finger ];
+		const float curl_meters = motion.curl_meters * curl_change[ finger ];
+		const float splay_meters = motion.splay_meters * splay_change[ finger ];
+
+		radians_squared = std::max(radians_squared, curl_radians * curl_radians + splay_radians * splay_radians);
+		meters_squared = std::max(meters_squared, curl_meters * curl_meters + splay_meters * splay_meters);
 	}
 
-	// Initialize a default hand pose
-	InitHand(hand);
-
-	// We need to apply the curls and splays separately to the thumb as it's special
-	hand.thumb.metacarpal.swing.v[0] += DEG_TO_RAD(curls.thumb * 5.f);
-	hand.thumb.metacarpal.swing.v[1] += DEG_TO_RAD(splays.thumb * 5.f);
-	hand.thumb.metacarpal.twist = 0.f;
-
-	hand.thumb.proximal.swing.v[0] += DEG_TO_RAD(curls.thumb * 90.f);
-	hand.thumb.proximal.swing.v[1] += DEG_TO_RAD(splays.thumb * 20.f);
-	hand.thumb.proximal.twist = 0.f;
-
-	hand.thumb.distal.rotation += DEG_TO_RAD(curls.thumb * 90.f);
-
-	// But we can batch up the fingers with a generic apply function.
-	ApplyGenericFingerTransform(curls.index, splays.index, hand.fingers[0]);
-	ApplyGenericFingerTransform(curls.middle, splays.middle, hand.fingers[1]);
-	ApplyGenericFingerTransform(curls.ring, splays.ring, hand.fingers[2]);
-	ApplyGenericFingerTransform(curls.pinky, splays.pinky, hand.fingers[3]);
-
-	// Now compute
-	ComputeSkeletalTransforms(hand, out_transforms);
-}
\ No newline at end of file
+	*out_radians = sqrtf(radians_squared);
+	*out_meters = sqrtf(meters_squared);
+}
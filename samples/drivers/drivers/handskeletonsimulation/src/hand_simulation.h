@@ -59,8 +59,57 @@ enum HandSkeletonBone : vr::BoneIndex_t
 	eBone_Count
 };
 
+// Joints that move with curl and splay, for one hand
+static const int my_hand_metacarpal_count = 5;
+static const int my_hand_joint_count = 14;
+
+// Room for both motion ranges, rounded up to a whole number of SIMD vectors
+static const int my_hand_metacarpal_lanes = 16;
+static const int my_hand_joint_lanes = 32;
+
 class MyHandSimulation
 {
 public:
+	MyHandSimulation();
+
 	void ComputeSkeletonTransforms( vr::ETrackedControllerRole role, const MyFingerCurls &curls, const MyFingerSplays &splays, vr::VRBoneTransform_t *out_transforms );
+
+	// Computes the skeletons for vr::VRSkeletalMotionRange_WithController and vr::VRSkeletalMotionRange_WithoutController together,
+	// which costs little more than computing one of them.
+	void ComputeSkeletonTransforms( vr::ETrackedControllerRole role, const MyFingerCurls &curls_with_controller, const MyFingerSplays &splays_with_controller,
+		const MyFingerCurls &curls_without_controller, const MyFingerSplays &splays_without_controller, vr::VRBoneTransform_t *out_transforms_with_controller,
+		vr::VRBoneTransform_t *out_transforms_without_controller );
+
+	// An upper bound on how far any bone rotates (in radians) and moves (in meters) relative to its parent when the curls and splays change from one
+	// set to the other. It's the same for either hand and motion range.
+	void BoundBoneMotion( const MyFingerCurls &from_curls, const MyFingerSplays &from_splays, const MyFingerCurls &to_curls, const MyFingerSplays &to_splays,
+		float *out_radians, float *out_meters ) const;
+
+private:
+	void Solve( vr::ETrackedControllerRole role, int range_count, const MyFingerCurls *curls, const MyFingerSplays *splays, vr::VRBoneTransform_t **out_transforms );
+
+	// The bones that never change, for the left and right hands
+	vr::VRBoneTransform_t rest_pose_[ 2 ][ eBone_Count ];
+
+	// Per joint constants, one lane per joint per motion range, in structure of arrays form
+	struct JointLanes
+	{
+		float rest_swing_x[ my_hand_joint_lanes ];
+		float curl_swing_x[ my_hand_joint_lanes ];
+		float rest_swing_y[ my_hand_joint_lanes ];
+		float splay_swing_y[ my_hand_joint_lanes ];
+		float length[ my_hand_joint_lanes ];
+	};
+	JointLanes metacarpal_lanes_;
+	JointLanes joint_lanes_;
+
+	// For each finger, the most any of its joints swings, and swings the offset it carries, per unit of curl and of splay
+	struct FingerMotion
+	{
+		float curl_radians;
+		float splay_radians;
+		float curl_meters;
+		float splay_meters;
+	};
+	FingerMotion finger_motion_[ 5 ];
 };
\ No newline at end of file
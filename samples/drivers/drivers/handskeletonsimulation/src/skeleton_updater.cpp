@@ -0,0 +1,92 @@
+//============ Copyright (c) Valve Corporation, All rights reserved. ============
+#include "skeleton_updater.h"
+
+#include <string.h>
+
+
+MySkeletonUpdater::MySkeletonUpdater( vr::ETrackedControllerRole role, vr::VRInputComponentHandle_t skeleton_handle, const MySkeletonUpdateSettings &settings )
+	: role_( role )
+	, skeleton_handle_( skeleton_handle )
+	, settings_( settings )
+	, sent_( 0 )
+	, suppressed_( 0 )
+{
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Whether any bone of a motion range would move past the thresholds if it were sent these inputs
+//-----------------------------------------------------------------------------
+bool MySkeletonUpdater::HasChangedEnough( int range, const MyFingerCurls &curls, const MyFingerSplays &splays ) const
+{
+	if ( !has_sent_[ range ] )
+		return true;
+
+	float radians, meters;
+	hand_simulation_.BoundBoneMotion( sent_curls_[ range ], sent_splays_[ range ], curls, splays, &radians, &meters );
+	return radians > settings_.angle_threshold_radians || meters > settings_.position_threshold_meters;
+}
+
+void MySkeletonUpdater::Update( const MyFingerCurls &curls_with_controller, const MyFingerSplays &splays_with_controller, const MyFingerCurls &curls_without_controller,
+	const MyFingerSplays &splays_without_controller )
+{
+	const MyFingerCurls curls[ 2 ] = { curls_with_controller, curls_without_controller };
+	const MyFingerSplays splays[ 2 ] = { splays_with_controller, splays_without_controller };
+	const vr::EVRSkeletalMotionRange motion_ranges[ 2 ] = { vr::VRSkeletalMotionRange_WithController, vr::VRSkeletalMotionRange_WithoutController };
+
+	// Drivers without separate poses for the two motion ranges send the same inputs for both, which only need checking and solving once
+	const bool same_inputs = memcmp( &curls[ 0 ], &curls[ 1 ], sizeof( MyFingerCurls ) ) == 0 && memcmp( &splays[ 0 ], &splays[ 1 ], sizeof( MyFingerSplays ) ) == 0;
+	const bool same_sent = has_sent_[ 0 ] == has_sent_[ 1 ] && memcmp( &sent_curls_[ 0 ], &sent_curls_[ 1 ], sizeof( MyFingerCurls ) ) == 0
+		&& memcmp( &sent_splays_[ 0 ], &sent_splays_[ 1 ], sizeof( MyFingerSplays ) ) == 0;
+
+	bool send[ 2 ];
+	send[ 0 ] = HasChangedEnough( 0, curls[ 0 ], splays[ 0 ] );
+	send[ 1 ] = same_inputs && same_sent ? send[ 0 ] : HasChangedEnough( 1, curls[ 1 ], splays[ 1 ] );
+
+	vr::VRBoneTransform_t transforms[ 2 ][ eBone_Count ];
+	const vr::VRBoneTransform_t *range_transforms[ 2 ] = { transforms[ 0 ], transforms[ 1 ] };
+	if ( send[ 0 ] && send[ 1 ] && same_inputs )
+	{
+		hand_simulation_.ComputeSkeletonTransforms( role_, curls[ 0 ], splays[ 0 ], transforms[ 0 ] );
+		range_transforms[ 1 ] = transforms[ 0 ];
+	}
+	else if ( send[ 0 ] && send[ 1 ] )
+	{
+		hand_simulation_.ComputeSkeletonTransforms( role_, curls[ 0 ], splays[ 0 ], curls[ 1 ], splays[ 1 ], transforms[ 0 ], transforms[ 1 ] );
+	}
+	else
+	{
+		for ( int range = 0; range < 2; range++ )
+		{
+			if ( send[ range ] )
+				hand_simulation_.ComputeSkeletonTransforms( role_, curls[ range ], splays[ range ], transforms[ range ] );
+		}
+	}
+
+	vr::IVRDriverInput *driver_input = driver_input_ ? driver_input_ : vr::VRDriverInput();
+	for ( int range = 0; range < 2; range++ )
+	{
+		if ( !send[ range ] )
+		{
+			suppressed_.fetch_add( 1, std::memory_order_relaxed );
+			continue;
+		}
+
+		driver_input->UpdateSkeletonComponent( skeleton_handle_, motion_ranges[ range ], range_transforms[ range ], eBone_Count );
+		sent_.fetch_add( 1, std::memory_order_relaxed );
+
+		has_sent_[ range ] = true;
+		sent_curls_[ range ] = curls[ range ];
+		sent_splays_[ range ] = splays[ range ];
+	}
+}
+
+void MySkeletonUpdater::GetStats( MySkeletonUpdateStats *out_stats ) const
+{
+	out_stats->sent = sent_.load( std::memory_order_relaxed );
+	out_stats->suppressed = suppressed_.load( std::memory_order_relaxed );
+}
+
+void MySkeletonUpdater::SetDriverInput( vr::IVRDriverInput *driver_input )
+{
+	driver_input_ = driver_input;
+}
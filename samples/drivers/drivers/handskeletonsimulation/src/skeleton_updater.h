@@ -0,0 +1,63 @@
+//============ Copyright (c) Valve Corporation, All rights reserved. ============
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+#include "hand_simulation.h"
+
+#include "openvr_driver.h"
+
+// How much a skeleton has to change before it's worth sending again
+struct MySkeletonUpdateSettings
+{
+	float angle_threshold_radians;	// how far any bone must have rotated relative to its parent
+	float position_threshold_meters; // or how far any bone must have moved relative to its parent
+};
+
+struct MySkeletonUpdateStats
+{
+	uint64_t sent;		 // UpdateSkeletonComponent calls made, one per motion range
+	uint64_t suppressed; // motion range updates skipped because no bone would have moved far enough
+};
+
+//-----------------------------------------------------------------------------
+// Purpose: Sends a hand's skeletons to the runtime, for both motion ranges, skipping the updates that wouldn't be noticed.
+//
+// Every joint of MyHandSimulation swings by an amount that's a linear blend of its open pose and its fully curled and fully splayed poses, so how far
+// any bone can have moved is known from how far the curls and splays have moved. Each motion range's inputs are compared against the ones it was last
+// sent with, so small changes add up until they're worth sending, and a skipped update costs neither the solve nor the call into vrserver.
+//-----------------------------------------------------------------------------
+class MySkeletonUpdater
+{
+public:
+	MySkeletonUpdater( vr::ETrackedControllerRole role, vr::VRInputComponentHandle_t skeleton_handle, const MySkeletonUpdateSettings &settings );
+
+	// Solves and sends the motion ranges that have changed enough since they were last sent. The first update always sends both.
+	void Update( const MyFingerCurls &curls_with_controller, const MyFingerSplays &splays_with_controller, const MyFingerCurls &curls_without_controller,
+		const MyFingerSplays &splays_without_controller );
+
+	void GetStats( MySkeletonUpdateStats *out_stats ) const;
+
+	// For testing. nullptr (the default) sends to vr::VRDriverInput().
+	void SetDriverInput( vr::IVRDriverInput *driver_input );
+
+private:
+	bool HasChangedEnough( int range, const MyFingerCurls &curls, const MyFingerSplays &splays ) const;
+
+	MyHandSimulation hand_simulation_;
+
+	vr::ETrackedControllerRole role_;
+	vr::VRInputComponentHandle_t skeleton_handle_;
+	MySkeletonUpdateSettings settings_;
+
+	vr::IVRDriverInput *driver_input_ = nullptr;
+
+	// The inputs each motion range was last sent with
+	bool has_sent_[ 2 ] = { false, false };
+	MyFingerCurls sent_curls_[ 2 ] = {};
+	MyFingerSplays sent_splays_[ 2 ] = {};
+
+	std::atomic< uint64_t > sent_;
+	std::atomic< uint64_t > suppressed_;
+};
@@ -64,14 +64,18 @@ vr::EVRInitError MyControllerDeviceDriver::Activate( uint32_t unObjectId )
 	// The properties we want, so we call this to retrieve a handle to it.
 	vr::PropertyContainerHandle_t container = vr::VRProperties()->TrackedDeviceToPropertyContainer( my_controller_index_ );
 
+	// Rather than sending each property to vrserver on its own, we collect them in a batch
+	// and send them all at once when we commit it.
+	vr::CVRPropertyBatch props( container, vr::VRPropertiesRaw() );
+
 	// Let's begin setting up the properties now we've got our container.
 	// A list of properties available is contained in vr::ETrackedDeviceProperty.
 
 	// First, let's set the model number.
-	vr::VRProperties()->SetStringProperty( container, vr::Prop_ModelNumber_String, my_controller_model_number_.c_str() );
+	props.SetStringProperty( vr::Prop_ModelNumber_String, my_controller_model_number_.c_str() );
 
 	// Let's tell SteamVR our role which we received from the constructor earlier.
-	vr::VRProperties()->SetInt32Property( container, vr::Prop_ControllerRoleHint_Int32, my_controller_role_ );
+	props.SetInt32Property( vr::Prop_ControllerRoleHint_Int32, my_controller_role_ );
 
 
 	// Now let's set up our inputs
@@ -80,12 +84,15 @@ vr::EVRInitError MyControllerDeviceDriver::Activate( uint32_t unObjectId )
 	// As well as what default bindings should be for legacy apps.
 	// Note, we can use the wildcard {<driver_name>} to match the root folder location
 	// of our driver.
-	vr::VRProperties()->SetStringProperty( container, vr::Prop_InputProfilePath_String, "{simplecontroller}/input/mycontroller_profile.json" );
+	props.SetStringProperty( vr::Prop_InputProfilePath_String, "{simplecontroller}/input/mycontroller_profile.json" );
 
 	// Let's set up handles for all of our components.
 	// Even though these are also defined in our input profile,
 	// We need to get handles to them to update the inputs.
 
+	// The input components below use the properties we've set, so send them to vrserver now.
+	props.Commit();
+
 	// Let's set up our "A" button. We've defined it to have a touch and a click component.
 	vr::VRDriverInput()->CreateBooleanComponent( container, "/input/a/touch", &input_handles_[ MyComponent_a_touch ] );
 	vr::VRDriverInput()->CreateBooleanComponent( container, "/input/a/click", &input_handles_[ MyComponent_a_click ] );
@@ -104,7 +111,14 @@ vr::EVRInitError MyControllerDeviceDriver::Activate( uint32_t unObjectId )
 	// These are global across the device, and you can only have one per device.
 	vr::VRDriverInput()->CreateHapticComponent( container, "/output/haptic", &input_handles_[ MyComponent_haptic ] );
 
-	my_pose_update_thread_ = std::thread( &MyControllerDeviceDriver::MyPoseUpdateThread, this );
+	// Have the driver's pose scheduler submit our pose every five milliseconds. It updates every device from one thread.
+	// In reality, you should update the pose whenever you have new data from your device, by pushing each sample
+	// from your data thread to a stream from PoseEventSubmitter().AddDevice() instead.
+	my_pose_update_handle_ = PoseScheduler().AddDevice( my_controller_index_, std::chrono::milliseconds( 5 ), [ this ]( vr::DriverPose_t *pPose )
+		{
+			*pPose = GetPose();
+			return true;
+		} );
 
 	// We've activated everything successfully!
 	// Let's tell SteamVR that by saying we don't have any errors.
@@ -195,19 +209,6 @@ vr::DriverPose_t MyControllerDeviceDriver::GetPose()
 	return pose;
 }
 
-void MyControllerDeviceDriver::MyPoseUpdateThread()
-{
-	while ( is_active_ )
-	{
-		// Inform the vrserver that our tracked device's pose has updated, giving it the pose returned by our GetPose().
-		vr::VRServerDriverHost()->TrackedDevicePoseUpdated( my_controller_index_, GetPose(), sizeof( vr::DriverPose_t ) );
-
-		// Update our pose every five milliseconds.
-		// In reality, you should update the pose whenever you have new data from your device.
-		std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
-	}
-}
-
 //-----------------------------------------------------------------------------
 // Purpose: This is called by vrserver when the device should enter standby mode.
 // The device should be put into whatever low power mode it has.
@@ -225,12 +226,12 @@ void MyControllerDeviceDriver::EnterStandby()
 //-----------------------------------------------------------------------------
 void MyControllerDeviceDriver::Deactivate()
 {
-	// Let's join our pose thread that's running
-	// by first checking then setting is_active_ to false to break out
-	// of the while loop, if it's running, then call .join() on the thread
+	// Let's stop our pose updates by first checking then setting is_active_ to false,
+	// then removing ourselves from the pose scheduler. Once RemoveDevice returns,
+	// the scheduler won't call GetPose for us again.
 	if ( is_active_.exchange( false ) )
 	{
-		my_pose_update_thread_.join();
+		PoseScheduler().RemoveDevice( my_pose_update_handle_ );
 	}
 
 	// unassign our controller index (we don't want to be calling vrserver anymore after Deactivate() has been called
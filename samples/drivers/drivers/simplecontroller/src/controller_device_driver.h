@@ -5,8 +5,8 @@
 #include <string>
 
 #include "openvr_driver.h"
+#include "posescheduler.h"
 #include <atomic>
-#include <thread>
 
 enum MyComponent
 {
@@ -50,8 +50,6 @@ public:
 	void MyRunFrame();
 	void MyProcessEvent( const vr::VREvent_t &vrevent );
 
-	void MyPoseUpdateThread();
-
 private:
 	std::atomic< vr::TrackedDeviceIndex_t > my_controller_index_;
 
@@ -63,5 +61,5 @@ private:
 	std::array< vr::VRInputComponentHandle_t, MyComponent_MAX > input_handles_;
 
 	std::atomic< bool > is_active_;
-	std::thread my_pose_update_thread_;
+	PoseSchedulerHandle_t my_pose_update_handle_ = k_unPoseSchedulerHandleInvalid;
 };
\ No newline at end of file
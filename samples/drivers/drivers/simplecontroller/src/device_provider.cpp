@@ -124,4 +124,7 @@ void MyDeviceProvider::Cleanup()
 	// Our controller devices will have already deactivated. Let's now destroy them.
 	my_left_controller_device_ = nullptr;
 	my_right_controller_device_ = nullptr;
+
+	// Log anything still queued and stop the log thread before we're unloaded.
+	DriverLogShutdown();
 }
\ No newline at end of file
@@ -70,38 +70,45 @@ vr::EVRInitError MyHMDControllerDeviceDriver::Activate( uint32_t unObjectId )
 	// The properties we want, so we call this to retrieve a handle to it.
 	vr::PropertyContainerHandle_t container = vr::VRProperties()->TrackedDeviceToPropertyContainer( device_index_ );
 
+	// Rather than sending each property to vrserver on its own, we collect them in a batch
+	// and send them all at once when we commit it.
+	vr::CVRPropertyBatch props( container, vr::VRPropertiesRaw() );
+
 	// Let's begin setting up the properties now we've got our container.
 	// A list of properties available is contained in vr::ETrackedDeviceProperty.
 
 	// First, let's set the model number.
-	vr::VRProperties()->SetStringProperty( container, vr::Prop_ModelNumber_String, my_hmd_model_number_.c_str() );
+	props.SetStringProperty( vr::Prop_ModelNumber_String, my_hmd_model_number_.c_str() );
 
 	// Next, display settings
 
 	// Get the ipd of the user from SteamVR settings
 	const float ipd = vr::VRSettings()->GetFloat( vr::k_pch_SteamVR_Section, vr::k_pch_SteamVR_IPD_Float );
-	vr::VRProperties()->SetFloatProperty( container, vr::Prop_UserIpdMeters_Float, ipd );
+	props.SetFloatProperty( vr::Prop_UserIpdMeters_Float, ipd );
 
 	// For HMDs, it's required that a refresh rate is set otherwise VRCompositor will fail to start.
-	vr::VRProperties()->SetFloatProperty( container, vr::Prop_DisplayFrequency_Float, 0.f );
+	props.SetFloatProperty( vr::Prop_DisplayFrequency_Float, 0.f );
 
 	// The distance from the user's eyes to the display in meters. This is used for reprojection.
-	vr::VRProperties()->SetFloatProperty( container, vr::Prop_UserHeadToEyeDepthMeters_Float, 0.f );
+	props.SetFloatProperty( vr::Prop_UserHeadToEyeDepthMeters_Float, 0.f );
 
 	// How long from the compositor to submit a frame to the time it takes to display it on the screen.
-	vr::VRProperties()->SetFloatProperty( container, vr::Prop_SecondsFromVsyncToPhotons_Float, 0.11f );
+	props.SetFloatProperty( vr::Prop_SecondsFromVsyncToPhotons_Float, 0.11f );
 
 	// avoid "not fullscreen" warnings from vrmonitor
-	vr::VRProperties()->SetBoolProperty( container, vr::Prop_IsOnDesktop_Bool, false );
+	props.SetBoolProperty( vr::Prop_IsOnDesktop_Bool, false );
 
-	vr::VRProperties()->SetBoolProperty(container, vr::Prop_DisplayDebugMode_Bool, true);
+	props.SetBoolProperty( vr::Prop_DisplayDebugMode_Bool, true );
 
 	// Now let's set up our inputs
 	// This tells the UI what to show the user for bindings for this controller,
 	// As well as what default bindings should be for legacy apps.
 	// Note, we can use the wildcard {<driver_name>} to match the root folder location
 	// of our driver.
-	vr::VRProperties()->SetStringProperty( container, vr::Prop_InputProfilePath_String, "{simplehmd}/input/mysimplehmd_profile.json" );
+	props.SetStringProperty( vr::Prop_InputProfilePath_String, "{simplehmd}/input/mysimplehmd_profile.json" );
+
+	// The input components below use the properties we've set, so send them to vrserver now.
+	props.Commit();
 
 	// Let's set up handles for all of our components.
 	// Even though these are also defined in our input profile,
@@ -109,7 +116,14 @@ vr::EVRInitError MyHMDControllerDeviceDriver::Activate( uint32_t unObjectId )
 	vr::VRDriverInput()->CreateBooleanComponent( container, "/input/system/touch", &my_input_handles_[ MyComponent_system_touch ] );
 	vr::VRDriverInput()->CreateBooleanComponent( container, "/input/system/click", &my_input_handles_[ MyComponent_system_click ] );
 
-	my_pose_update_thread_ = std::thread( &MyHMDControllerDeviceDriver::MyPoseUpdateThread, this );
+	// Have the driver's pose scheduler submit our pose every five milliseconds. It updates every device from one thread.
+	// In reality, you should update the pose whenever you have new data from your device, by pushing each sample
+	// from your data thread to a stream from PoseEventSubmitter().AddDevice() instead.
+	my_pose_update_handle_ = PoseScheduler().AddDevice( device_index_, std::chrono::milliseconds( 5 ), [ this ]( vr::DriverPose_t *pPose )
+		{
+			*pPose = GetPose();
+			return true;
+		} );
 
 	// We've activated everything successfully!
 	// Let's tell SteamVR that by saying we don't have any errors.
@@ -181,19 +195,6 @@ vr::DriverPose_t MyHMDControllerDeviceDriver::GetPose()
 	return pose;
 }
 
-void MyHMDControllerDeviceDriver::MyPoseUpdateThread()
-{
-	while ( is_active_ )
-	{
-		// Inform the vrserver that our tracked device's pose has updated, giving it the pose returned by our GetPose().
-		vr::VRServerDriverHost()->TrackedDevicePoseUpdated( device_index_, GetPose(), sizeof( vr::DriverPose_t ) );
-
-		// Update our pose every five milliseconds.
-		// In reality, you should update the pose whenever you have new data from your device.
-		std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
-	}
-}
-
 //-----------------------------------------------------------------------------
 // Purpose: This is called by vrserver when the device should enter standby mode.
 // The device should be put into whatever low power mode it has.
@@ -211,12 +212,12 @@ void MyHMDControllerDeviceDriver::EnterStandby()
 //-----------------------------------------------------------------------------
 void MyHMDControllerDeviceDriver::Deactivate()
 {
-	// Let's join our pose thread that's running
-	// by first checking then setting is_active_ to false to break out
-	// of the while loop, if it's running, then call .join() on the thread
+	// Let's stop our pose updates by first checking then setting is_active_ to false,
+	// then removing ourselves from the pose scheduler. Once RemoveDevice returns,
+	// the scheduler won't call GetPose for us again.
 	if ( is_active_.exchange( false ) )
 	{
-		my_pose_update_thread_.join();
+		PoseScheduler().RemoveDevice( my_pose_update_handle_ );
 	}
 
 	// unassign our controller index (we don't want to be calling vrserver anymore after Deactivate() has been called
@@ -5,8 +5,8 @@
 #include <string>
 
 #include "openvr_driver.h"
+#include "posescheduler.h"
 #include <atomic>
-#include <thread>
 
 enum MyComponent
 {
@@ -67,7 +67,6 @@ public:
 	const std::string &MyGetSerialNumber();
 	void MyRunFrame();
 	void MyProcessEvent( const vr::VREvent_t &vrevent );
-	void MyPoseUpdateThread();
 
 private:
 	std::unique_ptr< MyHMDDisplayComponent > my_display_component_;
@@ -79,6 +78,5 @@ private:
 	std::atomic< int > frame_number_;
 	std::atomic< bool > is_active_;
 	std::atomic< uint32_t > device_index_;
-
-	std::thread my_pose_update_thread_;
+	PoseSchedulerHandle_t my_pose_update_handle_ = k_unPoseSchedulerHandleInvalid;
 };
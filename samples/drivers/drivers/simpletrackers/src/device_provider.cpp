@@ -109,4 +109,7 @@ void MyDeviceProvider::Cleanup()
 	{
 		tracker = nullptr;
 	}
+
+	// Log anything still queued and stop the log thread before we're unloaded.
+	DriverLogShutdown();
 }
\ No newline at end of file
@@ -55,11 +55,15 @@ vr::EVRInitError MyTrackerDeviceDriver::Activate( uint32_t unObjectId )
 	// The properties we want, so we call this to retrieve a handle to it.
 	vr::PropertyContainerHandle_t container = vr::VRProperties()->TrackedDeviceToPropertyContainer( my_device_index_ );
 
+	// Rather than sending each property to vrserver on its own, we collect them in a batch
+	// and send them all at once when we commit it.
+	vr::CVRPropertyBatch props( container, vr::VRPropertiesRaw() );
+
 	// Let's begin setting up the properties now we've got our container.
 	// A list of properties available is contained in vr::ETrackedDeviceProperty.
 
 	// First, let's set the model number.
-	vr::VRProperties()->SetStringProperty( container, vr::Prop_ModelNumber_String, my_device_model_number_.c_str() );
+	props.SetStringProperty( vr::Prop_ModelNumber_String, my_device_model_number_.c_str() );
 
 	// Now let's set up our inputs
 
@@ -67,13 +71,15 @@ vr::EVRInitError MyTrackerDeviceDriver::Activate( uint32_t unObjectId )
 	// As well as what default bindings should be for legacy apps.
 	// Note, we can use the wildcard {<driver_name>} to match the root folder location
 	// of our driver.
-	vr::VRProperties()->SetStringProperty(
-		container, vr::Prop_InputProfilePath_String, "{simpletrackers}/input/mytracker_profile.json" );
+	props.SetStringProperty( vr::Prop_InputProfilePath_String, "{simpletrackers}/input/mytracker_profile.json" );
 
 	// Let's set up handles for all of our components.
 	// Even though these are also defined in our input profile,
 	// We need to get handles to them to update the inputs.
 
+	// The input components below use the properties we've set, so send them to vrserver now.
+	props.Commit();
+
 	// Let's set up our "A" button. We've defined it to have a touch and a click component.
 	vr::VRDriverInput()->CreateBooleanComponent( container, "/input/a/touch", &input_handles_[ MyComponent_a_touch ] );
 	vr::VRDriverInput()->CreateBooleanComponent( container, "/input/a/click", &input_handles_[ MyComponent_a_click ] );
@@ -90,7 +96,11 @@ vr::EVRInitError MyTrackerDeviceDriver::Activate( uint32_t unObjectId )
 	vr::VRDriverInput()->CreateBooleanComponent(
 		container, "/input/trigger/click", &input_handles_[ MyComponent_trigger_click ] );
 
-	my_pose_update_thread_ = std::thread( &MyTrackerDeviceDriver::MyPoseUpdateThread, this );
+	// Our tracker pretends to have its own data thread, like a real device reading samples off the wire would.
+	// It pushes each sample to a stream from the driver's pose event submitter, which sends it to vrserver as soon as
+	// it arrives, with the sample's age accounted for.
+	my_pose_stream_ = PoseEventSubmitter().AddDevice( my_device_index_ );
+	my_pose_thread_ = std::thread( &MyTrackerDeviceDriver::MyPoseThread, this );
 
 	// We've activated everything successfully!
 	// Let's tell SteamVR that by saying we don't have any errors.
@@ -181,19 +191,6 @@ vr::DriverPose_t MyTrackerDeviceDriver::GetPose()
 	return pose;
 }
 
-void MyTrackerDeviceDriver::MyPoseUpdateThread()
-{
-	while ( is_active_ )
-	{
-		// Inform the vrserver that our tracked device's pose has updated, giving it the pose returned by our GetPose().
-		vr::VRServerDriverHost()->TrackedDevicePoseUpdated( my_device_index_, GetPose(), sizeof( vr::DriverPose_t ) );
-
-		// Update our pose every five milliseconds.
-		// In reality, you should update the pose whenever you have new data from your device.
-		std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
-	}
-}
-
 //-----------------------------------------------------------------------------
 // Purpose: This is called by vrserver when the device should enter standby mode.
 // The device should be put into whatever low power mode it has.
@@ -211,12 +208,15 @@ void MyTrackerDeviceDriver::EnterStandby()
 //-----------------------------------------------------------------------------
 void MyTrackerDeviceDriver::Deactivate()
 {
-	// Let's join our pose thread that's running
-	// by first checking then setting is_active_ to false to break out
-	// of the while loop, if it's running, then call .join() on the thread
+	// Let's stop our pose thread by first checking then setting is_active_ to false, and waiting for it to exit.
+	// Nothing pushes to our stream after that, so we can remove it from the pose event submitter.
 	if ( is_active_.exchange( false ) )
 	{
-		my_pose_update_thread_.join();
+		if ( my_pose_thread_.joinable() )
+			my_pose_thread_.join();
+
+		PoseEventSubmitter().RemoveDevice( my_pose_stream_ );
+		my_pose_stream_ = nullptr;
 	}
 
 	// unassign our controller index (we don't want to be calling vrserver anymore after Deactivate() has been called
@@ -239,6 +239,23 @@ void MyTrackerDeviceDriver::MyRunFrame()
 }
 
 
+//-----------------------------------------------------------------------------
+// Purpose: Stands in for the thread a real device would read its tracking data on.
+// It's not part of the ITrackedDeviceServerDriver interface, we created it ourselves.
+//-----------------------------------------------------------------------------
+void MyTrackerDeviceDriver::MyPoseThread()
+{
+	while ( is_active_ )
+	{
+		// A real device would wait here for its next sample, and note when the sample was measured.
+		// Ours makes one up every two milliseconds.
+		const int64_t sample_time_ns = GetPoseClockNs();
+		my_pose_stream_->Push( GetPose(), sample_time_ns );
+
+		std::this_thread::sleep_for( std::chrono::milliseconds( 2 ) );
+	}
+}
+
 //-----------------------------------------------------------------------------
 // Purpose: This is called by our IServerTrackedDeviceProvider when it pops an event off the event queue.
 // It's not part of the ITrackedDeviceServerDriver interface, we created it ourselves.
@@ -5,6 +5,7 @@
 #include <string>
 
 #include "openvr_driver.h"
+#include "poseeventsubmitter.h"
 #include <atomic>
 #include <thread>
 
@@ -48,7 +49,7 @@ public:
 	void MyRunFrame();
 	void MyProcessEvent( const vr::VREvent_t &vrevent );
 
-	void MyPoseUpdateThread();
+	void MyPoseThread();
 
 private:
 	unsigned int my_tracker_id_;
@@ -61,5 +62,6 @@ private:
 	std::array< vr::VRInputComponentHandle_t, MyComponent_MAX > input_handles_;
 
 	std::atomic< bool > is_active_;
-	std::thread my_pose_update_thread_;
+	CPoseEventStream *my_pose_stream_ = nullptr;
+	std::thread my_pose_thread_;
 };
\ No newline at end of file
@@ -6,12 +6,15 @@ vr::EVRInitError ControllerDevice::Activate(uint32_t unObjectId) {
 	vr::VRDriverLog()->Log("ControllerDevice::Activate");
 
 	const vr::PropertyContainerHandle_t container = vr::VRProperties()->TrackedDeviceToPropertyContainer(unObjectId);
-	vr::VRProperties()->SetInt32Property(container, vr::Prop_ControllerRoleHint_Int32, role_);
+	vr::CVRPropertyBatch props(container, vr::VRPropertiesRaw());
 
-	vr::VRProperties()->SetStringProperty(container, vr::Prop_ModelNumber_String, "MySampleControllerModel_1");
+	props.SetInt32Property(vr::Prop_ControllerRoleHint_Int32, role_);
 
-	vr::VRProperties()->SetStringProperty(container, vr::Prop_InputProfilePath_String,
+	props.SetStringProperty(vr::Prop_ModelNumber_String, "MySampleControllerModel_1");
+
+	props.SetStringProperty(vr::Prop_InputProfilePath_String,
 		"{sample}/resources/input/sample_profile.json");
+	props.Commit();
 
 	vr::VRDriverInput()->CreateBooleanComponent(container, "/input/a/click", &input_handles_[kInputHandle_A_click]);
 	vr::VRDriverInput()->CreateBooleanComponent(container, "/input/a/touch", &input_handles_[kInputHandle_A_touch]);
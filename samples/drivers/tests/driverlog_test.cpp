@@ -0,0 +1,253 @@
+//============ Copyright (c) Valve Corporation, All rights reserved. ============
+// DriverLog against a mock IVRDriverLog: messages logged before vrserver's log is available are
+// counted as dropped, every message comes out exactly as vsnprintf would have formatted it, each
+// thread's messages stay in order, and overflow, oversized and rate limited messages are counted.
+// After DriverLogShutdown, messages are logged before DriverLog returns. Also times the calling
+// thread against formatting and logging synchronously, with the mock writing every line to a file.
+#include "driverlog.h"
+#include "test_common.h"
+
+#include <stdarg.h>
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class CMockDriverLog : public vr::IVRDriverLog
+{
+public:
+	void Log( const char *pchLogMessage ) override
+	{
+		std::lock_guard< std::mutex > lock( m_mutex );
+		m_vecLines.push_back( pchLogMessage );
+		if ( m_pFile )
+		{
+			fputs( pchLogMessage, m_pFile );
+			fputc( '\n', m_pFile );
+			fflush( m_pFile );
+		}
+	}
+
+	std::vector< std::string > TakeLines()
+	{
+		std::lock_guard< std::mutex > lock( m_mutex );
+		return std::move( m_vecLines );
+	}
+
+	FILE *m_pFile = nullptr;
+
+private:
+	std::mutex m_mutex;
+	std::vector< std::string > m_vecLines;
+};
+
+static CMockDriverLog g_log;
+
+class CMockDriverContext : public vr::IVRDriverContext
+{
+public:
+	void *GetGenericInterface( const char *pchInterfaceVersion, vr::EVRInitError *peError ) override
+	{
+		bool bFound = m_bLogAvailable && !strcmp( pchInterfaceVersion, vr::IVRDriverLog_Version );
+		if ( peError )
+			*peError = bFound ? vr::VRInitError_None : vr::VRInitError_Init_InterfaceNotFound;
+		return bFound ? &g_log : nullptr;
+	}
+
+	vr::DriverHandle_t GetDriverHandle() override { return 1; }
+
+	bool m_bLogAvailable = false;
+};
+
+static CMockDriverContext g_context;
+
+static std::string Vsnprintf( const char *pchFormat, ... )
+{
+	char rchBuffer[ 32 * 1024 ];
+	va_list args;
+	va_start( args, pchFormat );
+	vsnprintf( rchBuffer, sizeof( rchBuffer ), pchFormat, args );
+	va_end( args );
+	return rchBuffer;
+}
+
+// How the driver logged before: format on the calling thread and hand it straight to vrserver
+static void SyncDriverLog( const char *pchFormat, ... )
+{
+	char rchBuffer[ 1024 ];
+	va_list args;
+	va_start( args, pchFormat );
+	vsnprintf( rchBuffer, sizeof( rchBuffer ), pchFormat, args );
+	va_end( args );
+	vr::VRDriverLog()->Log( rchBuffer );
+}
+
+#define CHECK_FORMAT( ... ) \
+	do \
+	{ \
+		DriverLog( __VA_ARGS__ ); \
+		DriverLogFlush(); \
+		std::vector< std::string > vecLines = g_log.TakeLines(); \
+		std::string sExpected = Vsnprintf( __VA_ARGS__ ); \
+		if ( vecLines.size() != 1 || vecLines[ 0 ] != sExpected ) \
+		{ \
+			fprintf( stderr, "%s(%d): got [%s], expected [%s]\n", __FILE__, __LINE__, vecLines.empty() ? "<nothing>" : vecLines[ 0 ].c_str(), sExpected.c_str() ); \
+			g_nTestFailures++; \
+		} \
+	} while ( 0 )
+
+static void TestNoLog()
+{
+	for ( int i = 0; i < 3; i++ )
+		DriverLog( "before vrserver's log %d", i );
+	DriverLogFlush();
+
+	DriverLogStats_t stats;
+	DriverLogGetStats( &stats );
+	TEST_CHECK_EQUAL( stats.unDroppedNoLog, 3u );
+	TEST_CHECK_EQUAL( stats.unLogged, 0u );
+}
+
+enum ETestEnum { k_eTestEnum_Three = 3 };
+enum class ETestScoped : unsigned char { Seven = 7 };
+
+static void TestFormatting()
+{
+	std::string sLong( 5000, 'x' );
+	char rchArray[ 16 ] = "array";
+	CHECK_FORMAT( "plain" );
+	CHECK_FORMAT( "%d %5.2f %s|%-10s|", 42, 3.14159f, "str", "left" );
+	CHECK_FORMAT( "%*d|%.*f|%-*.*s|", 6, 7, 3, 2.5, 8, 2, "abcdef" );
+	CHECK_FORMAT( "%%%c%x%X%o%u", 'q', 255u, 0xabcU, 8, 4000000000u );
+	CHECK_FORMAT( "%lld %llu %ld %lu %zu %hhd %hd", -5ll, 18000000000000000000ull, -7l, 9ul, ( size_t )12, ( char )65, ( short )-2 );
+	CHECK_FORMAT( "%p %p", ( void * )&g_log, ( void * )nullptr );
+	CHECK_FORMAT( "%d %d", true, ( int )k_eTestEnum_Three );
+	CHECK_FORMAT( "%s|%s", sLong.c_str(), rchArray );
+	CHECK_FORMAT( "%e %g %a", 1e-20, 123456789.0, 1.5 );
+
+	const char *pchNull = nullptr;
+	DriverLog( "%d %d %s", k_eTestEnum_Three, ETestScoped::Seven, pchNull );
+	// incomplete conversions and missing arguments, which printf leaves undefined, are kept as written
+	DriverLog( "missing %d %s" );
+	DriverLog( "trailing %" );
+	DebugDriverLog( "debug %d", 1 );
+	DriverLogFlush();
+	std::vector< std::string > vecLines = g_log.TakeLines();
+	TEST_CHECK( vecLines.size() >= 3 );
+	if ( vecLines.size() >= 3 )
+	{
+		TEST_CHECK( vecLines[ 0 ] == "3 7 (null)" );
+		TEST_CHECK( vecLines[ 1 ] == "missing %d %s" );
+		TEST_CHECK( vecLines[ 2 ] == "trailing %" );
+	}
+}
+
+static void TestThreadOrder()
+{
+	std::vector< std::thread > vecThreads;
+	for ( int t = 0; t < 4; t++ )
+	{
+		vecThreads.emplace_back( [ t ]
+		{
+			for ( int i = 0; i < 50; i++ )
+			{
+				DriverLog( "%d %d", t, i );
+				std::this_thread::sleep_for( std::chrono::microseconds( 50 ) );
+			}
+		} );
+	}
+	for ( std::thread &thread : vecThreads )
+		thread.join();
+	DriverLogFlush();
+
+	std::vector< std::string > vecLines = g_log.TakeLines();
+	TEST_CHECK_EQUAL( vecLines.size(), 200u );
+	int rnLast[ 4 ] = { -1, -1, -1, -1 };
+	int nOutOfOrder = 0;
+	for ( const std::string &sLine : vecLines )
+	{
+		int nThread, nMessage;
+		if ( sscanf( sLine.c_str(), "%d %d", &nThread, &nMessage ) != 2 || nThread < 0 || nThread >= 4 || nMessage != rnLast[ nThread ] + 1 )
+			nOutOfOrder++;
+		else
+			rnLast[ nThread ] = nMessage;
+	}
+	TEST_CHECK_EQUAL( nOutOfOrder, 0 );
+}
+
+static void BenchmarkCaller()
+{
+	g_log.m_pFile = tmpfile();
+	int nMessages = BenchFull() ? 1000 : 150;
+	auto bench = [ nMessages ]( const char *pchLabel, void ( *pfnLog )( int ) )
+	{
+		std::vector< double > vecNs;
+		for ( int i = 0; i < nMessages; i++ )
+		{
+			auto start = std::chrono::steady_clock::now();
+			pfnLog( i );
+			vecNs.push_back( BenchSecondsSince( start ) * 1e9 );
+			std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+		}
+		std::sort( vecNs.begin(), vecNs.end() );
+		printf( "%-10s p50 %7.0fns p99 %7.0fns max %7.0fns\n", pchLabel, vecNs[ vecNs.size() / 2 ], vecNs[ vecNs.size() * 99 / 100 ], vecNs.back() );
+	};
+	bench( "sync", []( int i ) { SyncDriverLog( "Haptic event triggered for %s hand. Duration: %.2f, Frequency: %.2f, Amplitude: %.2f", "left", 0.1 * i, 120.0, 0.5 ); } );
+	bench( "DriverLog", []( int i ) { DriverLog( "Haptic event triggered for %s hand. Duration: %.2f, Frequency: %.2f, Amplitude: %.2f", "left", 0.1 * i, 120.0, 0.5 ); } );
+	DriverLogFlush();
+	fclose( g_log.m_pFile );
+	g_log.m_pFile = nullptr;
+	g_log.TakeLines();
+}
+
+static void TestOverflow()
+{
+	DriverLogStats_t before;
+	DriverLogGetStats( &before );
+	for ( int i = 0; i < 5000; i++ )
+		DriverLog( "flood %d %s", i, "some text here to take up space in the buffer" );
+	std::string sHuge( 20000, 'y' );
+	DriverLog( "%s", sHuge.c_str() );
+	DriverLogFlush();
+
+	DriverLogStats_t after;
+	DriverLogGetStats( &after );
+	std::vector< std::string > vecLines = g_log.TakeLines();
+	printf( "5001 messages: %zu lines, %llu dropped full, %llu too long, %llu rate limited\n", vecLines.size(),
+		( unsigned long long )( after.unDroppedFull - before.unDroppedFull ), ( unsigned long long )( after.unDroppedTooLong - before.unDroppedTooLong ),
+		( unsigned long long )( after.unDroppedRateLimited - before.unDroppedRateLimited ) );
+	TEST_CHECK_EQUAL( after.unDroppedTooLong - before.unDroppedTooLong, 1u );
+	TEST_CHECK( after.unDroppedRateLimited > before.unDroppedRateLimited );
+	TEST_CHECK( !vecLines.empty() && vecLines.back().find( "DriverLog dropped" ) == 0 );
+	TEST_CHECK_EQUAL( after.unLogged - before.unLogged + after.unDroppedFull - before.unDroppedFull + after.unDroppedRateLimited - before.unDroppedRateLimited, 5000u );
+}
+
+static void TestShutdown()
+{
+	// earn back a few messages' worth of rate limit after the flood
+	std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+	DriverLog( "before shutdown" );
+	DriverLogShutdown();
+	std::vector< std::string > vecLines = g_log.TakeLines();
+	TEST_CHECK( vecLines.size() == 1 && vecLines[ 0 ] == "before shutdown" );
+
+	// no thread to wait for, so it's there as soon as DriverLog returns, from any thread
+	DriverLog( "after shutdown %d", 1 );
+	std::thread( [] { DriverLog( "after shutdown %d", 2 ); } ).join();
+	vecLines = g_log.TakeLines();
+	TEST_CHECK( vecLines.size() == 2 && vecLines[ 0 ] == "after shutdown 1" && vecLines[ 1 ] == "after shutdown 2" );
+	DriverLogShutdown();
+}
+
+int main()
+{
+	vr::VRDriverContext() = &g_context;
+	TestNoLog();
+	g_context.m_bLogAvailable = true;
+	TestFormatting();
+	TestThreadOrder();
+	BenchmarkCaller();
+	TestOverflow();
+	TestShutdown();
+	return TestResult( "driverlog_test" );
+}
@@ -0,0 +1,11 @@
+//============ Copyright (c) Valve Corporation, All rights reserved. ============
+#pragma once
+
+#include "hand_simulation.h"
+
+// The hand skeleton solver from before MyHandSimulation built its bones from cached tables
+class MyReferenceHandSimulation
+{
+public:
+	void ComputeSkeletonTransforms( vr::ETrackedControllerRole role, const MyFingerCurls &curls, const MyFingerSplays &splays, vr::VRBoneTransform_t *out_transforms );
+};
@@ -0,0 +1,140 @@
+//============ Copyright (c) Valve Corporation, All rights reserved. ============
+// MyHandSimulation against a copy of the solver it replaced, over random curls and splays for both
+// hands: every bone the old solver set must come out the same to within float rounding, from the
+// single range call and from both slots of the two range call. Then times both solvers per call.
+#include "hand_simulation.h"
+#include "hand_simulation_reference.h"
+#include "test_common.h"
+
+#include <algorithm>
+#include <math.h>
+#include <random>
+
+// The reference never set the aux bones, so only the ones before them are compared
+static const int k_nComparedBones = eBone_Aux_Thumb;
+
+static std::mt19937 g_rng( 1 );
+static std::uniform_real_distribution< float > g_unit( 0.f, 1.f );
+static std::uniform_real_distribution< float > g_signed( -1.f, 1.f );
+
+static MyFingerCurls RandomCurls()
+{
+	return { g_unit( g_rng ), g_unit( g_rng ), g_unit( g_rng ), g_unit( g_rng ), g_unit( g_rng ) };
+}
+
+static MyFingerSplays RandomSplays()
+{
+	return { g_signed( g_rng ), g_signed( g_rng ), g_signed( g_rng ), g_signed( g_rng ), g_signed( g_rng ) };
+}
+
+struct MaxError_t
+{
+	double flOrientation = 0;
+	double flPosition = 0;
+};
+
+static void Compare( const vr::VRBoneTransform_t *pExpected, const vr::VRBoneTransform_t *pActual, MaxError_t *pError )
+{
+	for ( int nBone = 0; nBone < k_nComparedBones; nBone++ )
+	{
+		const vr::HmdQuaternionf_t &q0 = pExpected[ nBone ].orientation;
+		const vr::HmdQuaternionf_t &q1 = pActual[ nBone ].orientation;
+		pError->flOrientation = std::max( { pError->flOrientation, ( double )fabsf( q0.w - q1.w ), ( double )fabsf( q0.x - q1.x ),
+			( double )fabsf( q0.y - q1.y ), ( double )fabsf( q0.z - q1.z ) } );
+		for ( int i = 0; i < 4; i++ )
+			pError->flPosition = std::max( pError->flPosition, ( double )fabsf( pExpected[ nBone ].position.v[ i ] - pActual[ nBone ].position.v[ i ] ) );
+	}
+}
+
+static void TestMatchesReference()
+{
+	MyHandSimulation simulation;
+	MyReferenceHandSimulation reference;
+	MaxError_t error;
+	int nSamples = BenchFull() ? 200000 : 20000;
+	for ( int i = 0; i < nSamples; i++ )
+	{
+		vr::ETrackedControllerRole eRole = ( i & 1 ) ? vr::TrackedControllerRole_RightHand : vr::TrackedControllerRole_LeftHand;
+		MyFingerCurls curls = RandomCurls();
+		MyFingerSplays splays = RandomSplays();
+		MyFingerCurls otherCurls = RandomCurls();
+		MyFingerSplays otherSplays = RandomSplays();
+
+		// the ends of the ranges first
+		if ( i < 4 )
+		{
+			curls = i < 2 ? MyFingerCurls{ 0, 0, 0, 0, 0 } : MyFingerCurls{ 1, 1, 1, 1, 1 };
+			splays = i < 2 ? MyFingerSplays{ 0, 0, 0, 0, 0 } : MyFingerSplays{ -1, 1, -1, 1, -1 };
+		}
+
+		vr::VRBoneTransform_t rgExpected[ eBone_Count ], rgOtherExpected[ eBone_Count ];
+		vr::VRBoneTransform_t rgSingle[ eBone_Count ], rgWith[ eBone_Count ], rgWithout[ eBone_Count ];
+		reference.ComputeSkeletonTransforms( eRole, curls, splays, rgExpected );
+		reference.ComputeSkeletonTransforms( eRole, otherCurls, otherSplays, rgOtherExpected );
+		simulation.ComputeSkeletonTransforms( eRole, curls, splays, rgSingle );
+		simulation.ComputeSkeletonTransforms( eRole, otherCurls, otherSplays, curls, splays, rgWith, rgWithout );
+		Compare( rgExpected, rgSingle, &error );
+		Compare( rgOtherExpected, rgWith, &error );
+		Compare( rgExpected, rgWithout, &error );
+
+		// the aux bones start at rest now
+		if ( i == 0 )
+		{
+			for ( int nBone = eBone_Aux_Thumb; nBone < eBone_Count; nBone++ )
+				TEST_CHECK( rgSingle[ nBone ].orientation.w == 1.f && rgSingle[ nBone ].position.v[ 0 ] == 0.f );
+		}
+	}
+
+	printf( "%d samples: max orientation error %.3g, max position error %.3g m\n", nSamples, error.flOrientation, error.flPosition );
+	TEST_CHECK( error.flOrientation < 1e-6 );
+	TEST_CHECK( error.flPosition < 1e-6 );
+}
+
+template < typename Solve_t >
+static void BenchmarkSolver( const char *pchLabel, Solve_t solve )
+{
+	int nCalls = BenchFull() ? 2000000 : 200000;
+	MyFingerCurls curls = { 0.3f, 0.4f, 0.5f, 0.6f, 0.7f };
+	MyFingerSplays splays = { 0.1f, -0.2f, 0.3f, -0.4f, 0.5f };
+	vr::VRBoneTransform_t rgTransforms[ 2 ][ eBone_Count ];
+	float flSink = 0;
+	auto start = std::chrono::steady_clock::now();
+	for ( int i = 0; i < nCalls; i++ )
+	{
+		curls.index = ( i & 1023 ) * ( 1.f / 1024 );
+		solve( curls, splays, rgTransforms );
+		flSink += rgTransforms[ 0 ][ eBone_IndexFinger3 ].position.v[ 0 ];
+	}
+	printf( "%-32s %6.1f ns/call (%g)\n", pchLabel, BenchSecondsSince( start ) * 1e9 / nCalls, flSink );
+}
+
+static void BenchmarkSolvers()
+{
+	MyHandSimulation simulation;
+	MyReferenceHandSimulation reference;
+	const vr::ETrackedControllerRole eRole = vr::TrackedControllerRole_LeftHand;
+	BenchmarkSolver( "reference, one range", [ & ]( const MyFingerCurls &curls, const MyFingerSplays &splays, vr::VRBoneTransform_t ( *pTransforms )[ eBone_Count ] )
+	{
+		reference.ComputeSkeletonTransforms( eRole, curls, splays, pTransforms[ 0 ] );
+	} );
+	BenchmarkSolver( "reference, both ranges", [ & ]( const MyFingerCurls &curls, const MyFingerSplays &splays, vr::VRBoneTransform_t ( *pTransforms )[ eBone_Count ] )
+	{
+		reference.ComputeSkeletonTransforms( eRole, curls, splays, pTransforms[ 0 ] );
+		reference.ComputeSkeletonTransforms( eRole, curls, splays, pTransforms[ 1 ] );
+	} );
+	BenchmarkSolver( "MyHandSimulation, one range", [ & ]( const MyFingerCurls &curls, const MyFingerSplays &splays, vr::VRBoneTransform_t ( *pTransforms )[ eBone_Count ] )
+	{
+		simulation.ComputeSkeletonTransforms( eRole, curls, splays, pTransforms[ 0 ] );
+	} );
+	BenchmarkSolver( "MyHandSimulation, both ranges", [ & ]( const MyFingerCurls &curls, const MyFingerSplays &splays, vr::VRBoneTransform_t ( *pTransforms )[ eBone_Count ] )
+	{
+		simulation.ComputeSkeletonTransforms( eRole, curls, splays, curls, splays, pTransforms[ 0 ], pTransforms[ 1 ] );
+	} );
+}
+
+int main()
+{
+	TestMatchesReference();
+	BenchmarkSolvers();
+	return TestResult( "hand_simulation_test" );
+}
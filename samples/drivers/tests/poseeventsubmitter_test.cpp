@@ -0,0 +1,209 @@
+//============ Copyright (c) Valve Corporation, All rights reserved. ============
+// CPoseEventSubmitter against the mock server driver host: a push never loses the newest sample,
+// however far ahead of the submitter's thread the producer gets, and every sample is either sent
+// or counted as coalesced. Then four devices push at 1 kHz and the age of each pose when it reaches
+// the host is compared with a 5 ms CPoseScheduler polling the latest sample.
+#include "poseeventsubmitter.h"
+#include "mockserverdriverhost.h"
+#include "test_common.h"
+
+#include <algorithm>
+#include <atomic>
+
+static vr::DriverPose_t NumberedPose( int nSample )
+{
+	vr::DriverPose_t pose = {};
+	pose.poseIsValid = true;
+	pose.result = vr::TrackingResult_Running_OK;
+	pose.qRotation.w = 1.0;
+	pose.vecPosition[ 0 ] = nSample;
+	return pose;
+}
+
+static void TestSlot()
+{
+	CLatestValueSlot< int > slot;
+	int nValue = 0;
+	TEST_CHECK( !slot.Pop( &nValue ) );
+	TEST_CHECK( !slot.Push( 1 ) );
+	TEST_CHECK( slot.Push( 2 ) );
+	TEST_CHECK( slot.Push( 3 ) );
+	TEST_CHECK( slot.Pop( &nValue ) && nValue == 3 );
+	TEST_CHECK( !slot.Pop( &nValue ) );
+	TEST_CHECK( !slot.Push( 4 ) );
+	TEST_CHECK( slot.Pop( &nValue ) && nValue == 4 );
+
+	// the consumer only ever sees values go up, and always ends up with the last one
+	CLatestValueSlot< int > counter;
+	const int k_nPushes = 200000;
+	std::atomic< bool > bDone( false );
+	std::thread producer( [ & ]
+	{
+		for ( int i = 1; i <= k_nPushes; i++ )
+			counter.Push( i );
+		bDone = true;
+	} );
+	int nLast = 0;
+	int nBackwards = 0;
+	while ( true )
+	{
+		bool bWasDone = bDone.load();
+		int nPopped;
+		while ( counter.Pop( &nPopped ) )
+		{
+			if ( nPopped <= nLast )
+				nBackwards++;
+			nLast = nPopped;
+		}
+		if ( bWasDone )
+			break;
+	}
+	producer.join();
+	TEST_CHECK_EQUAL( nBackwards, 0 );
+	TEST_CHECK_EQUAL( nLast, k_nPushes );
+}
+
+static void TestNewestArrives()
+{
+	CMockServerDriverHost host;
+	CPoseEventSubmitter submitter;
+	submitter.SetServerDriverHost( &host );
+	CPoseEventStream *pStream = submitter.AddDevice( 1 );
+
+	// far more samples than the thread can send one at a time
+	const int k_nSamples = 1000;
+	for ( int i = 1; i <= k_nSamples; i++ )
+		pStream->Push( NumberedPose( i ), GetPoseClockNs() );
+	std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+
+	PoseEventStats_t stats;
+	pStream->GetStats( &stats );
+	printf( "%d pushes: %llu submitted, %llu coalesced\n", k_nSamples, ( unsigned long long )stats.unSubmitted, ( unsigned long long )stats.unCoalesced );
+	TEST_CHECK_EQUAL( stats.unPushed, ( uint64_t )k_nSamples );
+	TEST_CHECK_EQUAL( stats.unSubmitted + stats.unCoalesced, ( uint64_t )k_nSamples );
+
+	CMockServerDriverHost::DevicePoses_t poses = host.GetDevicePoses( 1 );
+	TEST_CHECK_EQUAL( poses.vecArrivals.size(), stats.unSubmitted );
+	TEST_CHECK_EQUAL( poses.lastPose.vecPosition[ 0 ], ( double )k_nSamples );
+
+	// one more after the thread has gone idle is sent on its own
+	pStream->Push( NumberedPose( k_nSamples + 1 ), GetPoseClockNs() );
+	std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+	TEST_CHECK_EQUAL( host.GetDevicePoses( 1 ).lastPose.vecPosition[ 0 ], ( double )( k_nSamples + 1 ) );
+	submitter.RemoveDevice( pStream );
+}
+
+// How old each pose was when it reached the host, from the poseTimeOffsets it was sent with
+static void ReportAges( const char *pchLabel, CMockServerDriverHost &host, int nDevices )
+{
+	std::vector< double > vecAgesUs;
+	for ( int nDevice = 0; nDevice < nDevices; nDevice++ )
+	{
+		for ( double flOffset : host.GetDevicePoses( nDevice ).vecPoseTimeOffsets )
+			vecAgesUs.push_back( -flOffset * 1e6 );
+	}
+	TEST_CHECK( !vecAgesUs.empty() );
+	if ( vecAgesUs.empty() )
+		return;
+	std::sort( vecAgesUs.begin(), vecAgesUs.end() );
+	printf( "%-10s %zu poses, age p50 %.1fus p99 %.1fus max %.1fus\n", pchLabel, vecAgesUs.size(),
+		vecAgesUs[ vecAgesUs.size() / 2 ], vecAgesUs[ vecAgesUs.size() * 99 / 100 ], vecAgesUs.back() );
+}
+
+// Calls sampleFn for every device once a millisecond until bRunning is cleared
+template < typename Sample_t >
+static void RunProducer( std::atomic< bool > &bRunning, Sample_t sampleFn )
+{
+	int64_t nNextNs = GetPoseClockNs();
+	while ( bRunning )
+	{
+		nNextNs += 1000000;
+		std::this_thread::sleep_until( std::chrono::steady_clock::time_point( std::chrono::nanoseconds( nNextNs ) ) );
+		sampleFn();
+	}
+}
+
+static void BenchmarkLatency()
+{
+	const int k_nDevices = 4;
+	std::chrono::milliseconds duration( BenchFull() ? 3000 : 500 );
+
+	// before: a data thread keeps the latest sample, which the scheduler polls every 5 ms
+	{
+		CMockServerDriverHost host;
+		CPoseScheduler scheduler;
+		scheduler.SetServerDriverHost( &host );
+		std::mutex mutex;
+		int64_t rgnSampleTimeNs[ k_nDevices ] = {};
+		std::vector< PoseSchedulerHandle_t > vecDevices;
+		for ( int nDevice = 0; nDevice < k_nDevices; nDevice++ )
+		{
+			vecDevices.push_back( scheduler.AddDevice( nDevice, std::chrono::milliseconds( 5 ), [ &, nDevice ]( vr::DriverPose_t *pPose )
+			{
+				std::lock_guard< std::mutex > lock( mutex );
+				*pPose = NumberedPose( 0 );
+				pPose->poseTimeOffset = ( double )( rgnSampleTimeNs[ nDevice ] - GetPoseClockNs() ) / 1e9;
+				return rgnSampleTimeNs[ nDevice ] != 0;
+			} ) );
+		}
+		std::atomic< bool > bRunning( true );
+		std::thread producer( [ & ]
+		{
+			RunProducer( bRunning, [ & ]
+			{
+				std::lock_guard< std::mutex > lock( mutex );
+				for ( int nDevice = 0; nDevice < k_nDevices; nDevice++ )
+					rgnSampleTimeNs[ nDevice ] = GetPoseClockNs();
+			} );
+		} );
+		std::this_thread::sleep_for( duration );
+		bRunning = false;
+		producer.join();
+		for ( PoseSchedulerHandle_t hDevice : vecDevices )
+			scheduler.RemoveDevice( hDevice );
+		ReportAges( "scheduler", host, k_nDevices );
+	}
+
+	// after: each device's data thread pushes every sample as it's measured
+	{
+		CMockServerDriverHost host;
+		CPoseEventSubmitter submitter;
+		submitter.SetServerDriverHost( &host );
+		std::vector< CPoseEventStream * > vecStreams;
+		for ( int nDevice = 0; nDevice < k_nDevices; nDevice++ )
+			vecStreams.push_back( submitter.AddDevice( nDevice ) );
+		std::atomic< bool > bRunning( true );
+		std::vector< std::thread > vecThreads;
+		for ( int nDevice = 0; nDevice < k_nDevices; nDevice++ )
+		{
+			CPoseEventStream *pStream = vecStreams[ nDevice ];
+			vecThreads.emplace_back( [ &bRunning, pStream ]
+			{
+				int nSample = 0;
+				RunProducer( bRunning, [ & ] { pStream->Push( NumberedPose( ++nSample ), GetPoseClockNs() ); } );
+			} );
+		}
+		std::this_thread::sleep_for( duration );
+		bRunning = false;
+		for ( std::thread &thread : vecThreads )
+			thread.join();
+		std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+
+		PoseEventStats_t stats;
+		vecStreams[ 0 ]->GetStats( &stats );
+		TEST_CHECK_EQUAL( stats.unSubmitted + stats.unCoalesced, stats.unPushed );
+		printf( "device 0: %llu pushed, %llu submitted, %llu coalesced\n", ( unsigned long long )stats.unPushed,
+			( unsigned long long )stats.unSubmitted, ( unsigned long long )stats.unCoalesced );
+		for ( CPoseEventStream *pStream : vecStreams )
+			submitter.RemoveDevice( pStream );
+		ReportAges( "event", host, k_nDevices );
+	}
+}
+
+int main()
+{
+	TestSlot();
+	TestNewestArrives();
+	BenchmarkLatency();
+	return TestResult( "poseeventsubmitter_test" );
+}
@@ -0,0 +1,207 @@
+//============ Copyright (c) Valve Corporation, All rights reserved. ============
+// CPoseScheduler against the mock server driver host: every device is updated at its own period,
+// a producer that returns false submits nothing, a removed device's producer is never called
+// again, and the thread stops and restarts as devices come and go, waking early for the change.
+// Then compares the spacing of the poses twelve devices submit with what a sleep_for thread per
+// device gets.
+#include "posescheduler.h"
+#include "mockserverdriverhost.h"
+#include "test_common.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+static vr::DriverPose_t ValidPose()
+{
+	vr::DriverPose_t pose = {};
+	pose.poseIsValid = true;
+	pose.result = vr::TrackingResult_Running_OK;
+	pose.qRotation.w = 1.0;
+	return pose;
+}
+
+static void TestPeriodsAndSkips()
+{
+	CMockServerDriverHost host;
+	CPoseScheduler scheduler;
+	scheduler.SetServerDriverHost( &host );
+
+	std::atomic< int > nSkipCalls( 0 );
+	PoseSchedulerHandle_t hFast = scheduler.AddDevice( 1, std::chrono::milliseconds( 2 ), []( vr::DriverPose_t *pPose ) { *pPose = ValidPose(); return true; } );
+	PoseSchedulerHandle_t hSlow = scheduler.AddDevice( 2, std::chrono::milliseconds( 10 ), []( vr::DriverPose_t *pPose ) { *pPose = ValidPose(); return true; } );
+	PoseSchedulerHandle_t hSkip = scheduler.AddDevice( 3, std::chrono::milliseconds( 5 ), [ &nSkipCalls ]( vr::DriverPose_t * ) { nSkipCalls++; return false; } );
+	TEST_CHECK( hFast != k_unPoseSchedulerHandleInvalid && hSlow != k_unPoseSchedulerHandleInvalid && hFast != hSlow );
+	std::this_thread::sleep_for( std::chrono::milliseconds( 300 ) );
+	scheduler.RemoveDevice( hFast );
+	scheduler.RemoveDevice( hSlow );
+	scheduler.RemoveDevice( hSkip );
+
+	size_t unFast = host.GetDevicePoses( 1 ).vecArrivals.size();
+	size_t unSlow = host.GetDevicePoses( 2 ).vecArrivals.size();
+	printf( "300ms: %zu poses at 2ms, %zu at 10ms, %d skipped\n", unFast, unSlow, nSkipCalls.load() );
+	// loose bounds, the machine running the test may be busy
+	TEST_CHECK( unFast >= 50 && unFast <= 200 );
+	TEST_CHECK( unSlow >= 10 && unSlow <= 40 );
+	TEST_CHECK( unFast > unSlow * 3 );
+	TEST_CHECK( nSkipCalls.load() >= 20 );
+	TEST_CHECK( host.GetDevicePoses( 3 ).vecArrivals.empty() );
+	TEST_CHECK( host.GetDevicePoses( 1 ).lastPose.poseIsValid );
+
+	PoseSchedulerStats_t stats;
+	TEST_CHECK( !scheduler.GetDeviceStats( hFast, &stats ) );
+	TEST_CHECK( !scheduler.GetDeviceStats( k_unPoseSchedulerHandleInvalid, &stats ) );
+}
+
+static void TestRemoveStopsProducer()
+{
+	CMockServerDriverHost host;
+	CPoseScheduler scheduler;
+	scheduler.SetServerDriverHost( &host );
+
+	// a second device keeps the thread running after the first is removed
+	PoseSchedulerHandle_t hOther = scheduler.AddDevice( 2, std::chrono::milliseconds( 1 ), []( vr::DriverPose_t *pPose ) { *pPose = ValidPose(); return true; } );
+	std::atomic< int > nCalls( 0 );
+	PoseSchedulerHandle_t hDevice = scheduler.AddDevice( 1, std::chrono::milliseconds( 1 ), [ &nCalls ]( vr::DriverPose_t *pPose )
+	{
+		nCalls++;
+		std::this_thread::sleep_for( std::chrono::microseconds( 200 ) );
+		*pPose = ValidPose();
+		return true;
+	} );
+	std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+
+	PoseSchedulerStats_t stats;
+	TEST_CHECK( scheduler.GetDeviceStats( hDevice, &stats ) && stats.unUpdates > 0 );
+	scheduler.RemoveDevice( hDevice );
+	int nCallsAtRemove = nCalls.load();
+	std::this_thread::sleep_for( std::chrono::milliseconds( 30 ) );
+	TEST_CHECK_EQUAL( nCalls.load(), nCallsAtRemove );
+	TEST_CHECK( scheduler.GetDeviceStats( hOther, &stats ) && stats.unUpdates > 0 );
+	scheduler.RemoveDevice( hOther );
+}
+
+static void TestThreadRestarts()
+{
+	CMockServerDriverHost host;
+	CPoseScheduler scheduler;
+	scheduler.SetServerDriverHost( &host );
+	for ( int i = 0; i < 50; i++ )
+	{
+		PoseSchedulerHandle_t hDevice = scheduler.AddDevice( 1, std::chrono::milliseconds( 1 ), []( vr::DriverPose_t *pPose ) { *pPose = ValidPose(); return true; } );
+		std::this_thread::sleep_for( std::chrono::milliseconds( 2 ) );
+		scheduler.RemoveDevice( hDevice );
+	}
+	TEST_CHECK( host.GetDevicePoses( 1 ).vecArrivals.size() >= 50 );
+}
+
+static void TestChangesWakeThread()
+{
+	CMockServerDriverHost host;
+	CPoseScheduler scheduler;
+	scheduler.SetServerDriverHost( &host );
+
+	// with only a slow device the thread sleeps most of a second at a time
+	PoseSchedulerHandle_t hSlow = scheduler.AddDevice( 1, std::chrono::milliseconds( 800 ), []( vr::DriverPose_t *pPose ) { *pPose = ValidPose(); return true; } );
+	std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+
+	// a device added now is updated straight away, not when the slow one is next due
+	auto added = std::chrono::steady_clock::now();
+	PoseSchedulerHandle_t hFast = scheduler.AddDevice( 2, std::chrono::milliseconds( 5 ), []( vr::DriverPose_t *pPose ) { *pPose = ValidPose(); return true; } );
+	while ( host.GetDevicePoses( 2 ).vecArrivals.empty() && BenchSecondsSince( added ) < 2.0 )
+		std::this_thread::sleep_for( std::chrono::microseconds( 100 ) );
+	double flFirstPoseMs = BenchSecondsSince( added ) * 1000;
+	std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+	scheduler.RemoveDevice( hFast );
+
+	// and removing the last device stops the thread without waiting out its sleep
+	auto removed = std::chrono::steady_clock::now();
+	scheduler.RemoveDevice( hSlow );
+	double flRemoveMs = BenchSecondsSince( removed ) * 1000;
+
+	printf( "beside an 800ms device: first pose %.2fms after AddDevice, last RemoveDevice took %.2fms\n", flFirstPoseMs, flRemoveMs );
+	TEST_CHECK( flFirstPoseMs < 100 );
+	TEST_CHECK( flRemoveMs < 100 );
+	TEST_CHECK( host.GetDevicePoses( 2 ).vecArrivals.size() >= 5 );
+	TEST_CHECK_EQUAL( host.GetDevicePoses( 1 ).vecArrivals.size(), 1 );
+}
+
+// How far the time between one device's poses strays from its period
+static void ReportIntervals( const char *pchLabel, CMockServerDriverHost &host, int nDevices, double flPeriodUs )
+{
+	std::vector< double > vecErrors;
+	for ( int nDevice = 0; nDevice < nDevices; nDevice++ )
+	{
+		CMockServerDriverHost::DevicePoses_t poses = host.GetDevicePoses( nDevice );
+		for ( size_t i = 1; i < poses.vecArrivals.size(); i++ )
+		{
+			double flIntervalUs = std::chrono::duration< double, std::micro >( poses.vecArrivals[ i ] - poses.vecArrivals[ i - 1 ] ).count();
+			vecErrors.push_back( fabs( flIntervalUs - flPeriodUs ) );
+		}
+	}
+	TEST_CHECK( !vecErrors.empty() );
+	if ( vecErrors.empty() )
+		return;
+	std::sort( vecErrors.begin(), vecErrors.end() );
+	double flMean = 0;
+	for ( double flError : vecErrors )
+		flMean += flError;
+	flMean /= vecErrors.size();
+	printf( "%-10s %zu intervals, error mean %.1fus p50 %.1fus p99 %.1fus max %.1fus\n", pchLabel, vecErrors.size(), flMean,
+		vecErrors[ vecErrors.size() / 2 ], vecErrors[ vecErrors.size() * 99 / 100 ], vecErrors.back() );
+}
+
+static void BenchmarkJitter()
+{
+	const int k_nDevices = 12;
+	const std::chrono::milliseconds k_period( 5 );
+	std::chrono::milliseconds duration( BenchFull() ? 3000 : 500 );
+	{
+		CMockServerDriverHost host;
+		CPoseScheduler scheduler;
+		scheduler.SetServerDriverHost( &host );
+		std::vector< PoseSchedulerHandle_t > vecDevices;
+		for ( int nDevice = 0; nDevice < k_nDevices; nDevice++ )
+			vecDevices.push_back( scheduler.AddDevice( nDevice, k_period, []( vr::DriverPose_t *pPose ) { *pPose = ValidPose(); return true; } ) );
+		std::this_thread::sleep_for( duration );
+		PoseSchedulerStats_t stats = scheduler.GetStats();
+		for ( PoseSchedulerHandle_t hDevice : vecDevices )
+			scheduler.RemoveDevice( hDevice );
+		TEST_CHECK( stats.unUpdates > 0 );
+		printf( "scheduler stats: %llu updates, %llu overruns, jitter mean %.1fus p99 %.1fus max %.1fus\n", ( unsigned long long )stats.unUpdates,
+			( unsigned long long )stats.unOverruns, stats.flMeanJitterUs, stats.flP99JitterUs, stats.flMaxJitterUs );
+		ReportIntervals( "scheduler", host, k_nDevices, 5000.0 );
+	}
+	{
+		CMockServerDriverHost host;
+		std::atomic< bool > bRunning( true );
+		std::vector< std::thread > vecThreads;
+		for ( int nDevice = 0; nDevice < k_nDevices; nDevice++ )
+		{
+			vecThreads.emplace_back( [ &, nDevice ]
+			{
+				while ( bRunning )
+				{
+					vr::DriverPose_t pose = ValidPose();
+					host.TrackedDevicePoseUpdated( nDevice, pose, sizeof( pose ) );
+					std::this_thread::sleep_for( k_period );
+				}
+			} );
+		}
+		std::this_thread::sleep_for( duration );
+		bRunning = false;
+		for ( std::thread &thread : vecThreads )
+			thread.join();
+		ReportIntervals( "sleep_for", host, k_nDevices, 5000.0 );
+	}
+}
+
+int main()
+{
+	TestPeriodsAndSkips();
+	TestRemoveStopsProducer();
+	TestThreadRestarts();
+	TestChangesWakeThread();
+	BenchmarkJitter();
+	return TestResult( "posescheduler_test" );
+}
@@ -0,0 +1,267 @@
+//============ Copyright (c) Valve Corporation, All rights reserved. ============
+// CVRPropertyBatch against a counting mock IVRProperties: the simple HMD's Activate() property set
+// stores the same values as the one call per property it used to make, in one call. Then per-entry
+// errors, lists longer than the batch holds (including an error latched from an early commit), the
+// destructor's commit, and the time taken for the Activate() set each way.
+#include <openvr_driver.h>
+#include "test_common.h"
+
+#include <string.h>
+#include <map>
+#include <string>
+#include <vector>
+
+class CMockProperties : public vr::IVRProperties
+{
+public:
+	struct Value_t
+	{
+		vr::PropertyTypeTag_t unTag;
+		std::vector< uint8_t > vecData;
+		bool operator==( const Value_t &other ) const { return unTag == other.unTag && vecData == other.vecData; }
+	};
+
+	vr::ETrackedPropertyError ReadPropertyBatch( vr::PropertyContainerHandle_t ulContainerHandle, vr::PropertyRead_t *pBatch, uint32_t unBatchEntryCount ) override
+	{
+		m_unReadCalls++;
+		SpendCallCost();
+		for ( uint32_t i = 0; i < unBatchEntryCount; i++ )
+		{
+			vr::PropertyRead_t &read = pBatch[ i ];
+			m_unReadEntries++;
+			auto iter = m_mapValues.find( read.prop );
+			if ( iter == m_mapValues.end() )
+			{
+				read.unTag = vr::k_unInvalidPropertyTag;
+				read.eError = vr::TrackedProp_UnknownProperty;
+				continue;
+			}
+			read.unTag = iter->second.unTag;
+			read.unRequiredBufferSize = (uint32_t)iter->second.vecData.size();
+			if ( read.unRequiredBufferSize > read.unBufferSize )
+			{
+				read.eError = vr::TrackedProp_BufferTooSmall;
+				continue;
+			}
+			memcpy( read.pvBuffer, iter->second.vecData.data(), read.unRequiredBufferSize );
+			read.eError = vr::TrackedProp_Success;
+		}
+		return vr::TrackedProp_Success;
+	}
+
+	vr::ETrackedPropertyError WritePropertyBatch( vr::PropertyContainerHandle_t ulContainerHandle, vr::PropertyWrite_t *pBatch, uint32_t unBatchEntryCount ) override
+	{
+		m_unWriteCalls++;
+		SpendCallCost();
+		for ( uint32_t i = 0; i < unBatchEntryCount; i++ )
+		{
+			vr::PropertyWrite_t &write = pBatch[ i ];
+			m_unWriteEntries++;
+			if ( write.prop == m_eReadOnlyProp )
+			{
+				write.eError = vr::TrackedProp_PermissionDenied;
+				continue;
+			}
+			if ( write.writeType == vr::PropertyWrite_Set )
+			{
+				const uint8_t *pubData = (const uint8_t *)write.pvBuffer;
+				m_mapValues[ write.prop ] = Value_t{ write.unTag, std::vector< uint8_t >( pubData, pubData + write.unBufferSize ) };
+			}
+			else
+			{
+				m_mapValues.erase( write.prop );
+			}
+			write.eError = vr::TrackedProp_Success;
+		}
+		return vr::TrackedProp_Success;
+	}
+
+	const char *GetPropErrorNameFromEnum( vr::ETrackedPropertyError error ) override { return "error"; }
+	vr::PropertyContainerHandle_t TrackedDeviceToPropertyContainer( vr::TrackedDeviceIndex_t nDevice ) override { return nDevice + 1; }
+
+	uint32_t Calls() const { return m_unReadCalls + m_unWriteCalls; }
+
+	std::map< vr::ETrackedDeviceProperty, Value_t > m_mapValues;
+	vr::ETrackedDeviceProperty m_eReadOnlyProp = vr::Prop_Invalid;
+	uint32_t m_unReadCalls = 0;
+	uint32_t m_unWriteCalls = 0;
+	uint32_t m_unReadEntries = 0;
+	uint32_t m_unWriteEntries = 0;
+
+	// how long each call spins, to stand in for crossing into vrserver
+	std::chrono::nanoseconds m_callCost{ 0 };
+
+private:
+	void SpendCallCost()
+	{
+		if ( m_callCost.count() == 0 )
+			return;
+		auto end = std::chrono::steady_clock::now() + m_callCost;
+		while ( std::chrono::steady_clock::now() < end )
+		{
+		}
+	}
+};
+
+static const char k_pchModelNumber[] = "MySimpleHMDModelNumber";
+
+// MyHMDControllerDeviceDriver::Activate's properties, one call each, as it set them before
+static void ActivateOneByOne( vr::IVRProperties *pProperties, vr::PropertyContainerHandle_t container, float flIpd )
+{
+	vr::CVRPropertyHelpers props( pProperties );
+	props.SetStringProperty( container, vr::Prop_ModelNumber_String, k_pchModelNumber );
+	props.SetFloatProperty( container, vr::Prop_UserIpdMeters_Float, flIpd );
+	props.SetFloatProperty( container, vr::Prop_DisplayFrequency_Float, 0.f );
+	props.SetFloatProperty( container, vr::Prop_UserHeadToEyeDepthMeters_Float, 0.f );
+	props.SetFloatProperty( container, vr::Prop_SecondsFromVsyncToPhotons_Float, 0.11f );
+	props.SetBoolProperty( container, vr::Prop_IsOnDesktop_Bool, false );
+	props.SetBoolProperty( container, vr::Prop_DisplayDebugMode_Bool, true );
+	props.SetStringProperty( container, vr::Prop_InputProfilePath_String, "{simplehmd}/input/mysimplehmd_profile.json" );
+}
+
+// ... and batched, as it sets them now
+static vr::ETrackedPropertyError ActivateBatched( vr::IVRProperties *pProperties, vr::PropertyContainerHandle_t container, float flIpd )
+{
+	vr::CVRPropertyBatch props( container, pProperties );
+	props.SetStringProperty( vr::Prop_ModelNumber_String, k_pchModelNumber );
+	props.SetFloatProperty( vr::Prop_UserIpdMeters_Float, flIpd );
+	props.SetFloatProperty( vr::Prop_DisplayFrequency_Float, 0.f );
+	props.SetFloatProperty( vr::Prop_UserHeadToEyeDepthMeters_Float, 0.f );
+	props.SetFloatProperty( vr::Prop_SecondsFromVsyncToPhotons_Float, 0.11f );
+	props.SetBoolProperty( vr::Prop_IsOnDesktop_Bool, false );
+	props.SetBoolProperty( vr::Prop_DisplayDebugMode_Bool, true );
+	props.SetStringProperty( vr::Prop_InputProfilePath_String, "{simplehmd}/input/mysimplehmd_profile.json" );
+	return props.Commit();
+}
+
+static void TestActivate()
+{
+	CMockProperties oneByOne, batched;
+	ActivateOneByOne( &oneByOne, 1, 0.063f );
+	TEST_CHECK_EQUAL( ActivateBatched( &batched, 1, 0.063f ), vr::TrackedProp_Success );
+
+	TEST_CHECK( oneByOne.m_mapValues == batched.m_mapValues );
+	TEST_CHECK_EQUAL( oneByOne.m_mapValues.size(), 8u );
+	TEST_CHECK_EQUAL( oneByOne.m_unWriteCalls, 8u );
+	TEST_CHECK_EQUAL( batched.m_unWriteCalls, 1u );
+	TEST_CHECK_EQUAL( batched.m_unWriteEntries, 8u );
+	TEST_CHECK_EQUAL( batched.m_unReadCalls, 0u );
+	printf( "Activate(): %u calls one by one, %u batched\n", oneByOne.Calls(), batched.Calls() );
+}
+
+static void TestEntryErrors()
+{
+	CMockProperties mock;
+	mock.m_eReadOnlyProp = vr::Prop_SerialNumber_String;
+	ActivateBatched( &mock, 1, 0.063f );
+
+	vr::CVRPropertyBatch props( 1, &mock );
+	vr::ETrackedPropertyError eModel = vr::TrackedProp_InvalidOperation, eSerial = vr::TrackedProp_Success, eNull = vr::TrackedProp_Success;
+	props.SetStringProperty( vr::Prop_ManufacturerName_String, "Valve", &eModel );
+	props.SetStringProperty( vr::Prop_SerialNumber_String, "1234", &eSerial );
+	TEST_CHECK_EQUAL( props.SetStringProperty( vr::Prop_TrackingSystemName_String, nullptr, &eNull ), vr::TrackedProp_InvalidOperation );
+	TEST_CHECK_EQUAL( eNull, vr::TrackedProp_InvalidOperation );
+
+	float flFrequency = -1.f, flMissing = -1.f;
+	int32_t nWrongType = -1;
+	char rchShort[ 4 ] = "xyz";
+	char rchModel[ 64 ] = {};
+	vr::ETrackedPropertyError eFrequency, eMissing, eWrongType, eShort, eLong;
+	props.GetFloatProperty( vr::Prop_DisplayFrequency_Float, &flFrequency, &eFrequency );
+	props.GetFloatProperty( vr::Prop_DisplayMCOffset_Float, &flMissing, &eMissing );
+	props.GetInt32Property( vr::Prop_UserIpdMeters_Float, &nWrongType, &eWrongType );
+	props.GetStringProperty( vr::Prop_ModelNumber_String, rchShort, sizeof( rchShort ), &eShort );
+	props.GetStringProperty( vr::Prop_ModelNumber_String, rchModel, sizeof( rchModel ), &eLong );
+
+	// the first failure is the serial number write, since writes go before reads
+	TEST_CHECK_EQUAL( props.Commit(), vr::TrackedProp_PermissionDenied );
+	TEST_CHECK_EQUAL( eModel, vr::TrackedProp_Success );
+	TEST_CHECK_EQUAL( eSerial, vr::TrackedProp_PermissionDenied );
+	TEST_CHECK( eFrequency == vr::TrackedProp_Success && flFrequency == 0.f );
+	TEST_CHECK( eMissing == vr::TrackedProp_UnknownProperty && flMissing == 0.f );
+	TEST_CHECK( eWrongType == vr::TrackedProp_WrongDataType && nWrongType == 0 );
+	TEST_CHECK( eShort == vr::TrackedProp_BufferTooSmall && rchShort[ 0 ] == '\0' );
+	TEST_CHECK( eLong == vr::TrackedProp_Success && !strcmp( rchModel, k_pchModelNumber ) );
+	TEST_CHECK_EQUAL( props.GetCallCount(), 2u );
+
+	// and nothing carries over into the next commit
+	props.SetFloatProperty( vr::Prop_DisplayFrequency_Float, 90.f );
+	TEST_CHECK_EQUAL( props.Commit(), vr::TrackedProp_Success );
+}
+
+static void TestOverflow()
+{
+	CMockProperties mock;
+	mock.m_eReadOnlyProp = vr::ETrackedDeviceProperty( 5001 );
+
+	// more writes and reads than the batch holds go out in chunks
+	const uint32_t k_unWrites = vr::CVRPropertyBatch::k_unMaxWrites * 2 + 5;
+	const uint32_t k_unReads = vr::CVRPropertyBatch::k_unMaxReads * 2 + 3;
+	std::vector< vr::ETrackedPropertyError > vecWriteErrors( k_unWrites, vr::TrackedProp_InvalidOperation );
+	std::vector< float > vecReads( k_unReads, -1.f );
+	std::vector< vr::ETrackedPropertyError > vecReadErrors( k_unReads, vr::TrackedProp_InvalidOperation );
+	{
+		vr::CVRPropertyBatch props( 1, &mock );
+		for ( uint32_t i = 0; i < k_unWrites; i++ )
+			props.SetFloatProperty( vr::ETrackedDeviceProperty( 5000 + i ), (float)i, &vecWriteErrors[ i ] );
+
+		// the read only property was in the first chunk, which went out before this Commit
+		TEST_CHECK_EQUAL( mock.m_unWriteCalls, 2u );
+		TEST_CHECK_EQUAL( props.Commit(), vr::TrackedProp_PermissionDenied );
+		TEST_CHECK_EQUAL( mock.m_unWriteCalls, 3u );
+		TEST_CHECK_EQUAL( mock.m_unWriteEntries, k_unWrites );
+		for ( uint32_t i = 0; i < k_unWrites; i++ )
+			TEST_CHECK_EQUAL( vecWriteErrors[ i ], i == 1 ? vr::TrackedProp_PermissionDenied : vr::TrackedProp_Success );
+
+		for ( uint32_t i = 0; i < k_unReads; i++ )
+			props.GetFloatProperty( vr::ETrackedDeviceProperty( 5000 + i ), &vecReads[ i ], &vecReadErrors[ i ] );
+		TEST_CHECK_EQUAL( mock.m_unReadCalls, 2u );
+		TEST_CHECK_EQUAL( props.Commit(), vr::TrackedProp_UnknownProperty );
+		TEST_CHECK_EQUAL( mock.m_unReadCalls, 3u );
+		for ( uint32_t i = 0; i < k_unReads; i++ )
+		{
+			if ( i == 1 )
+				TEST_CHECK( vecReadErrors[ i ] == vr::TrackedProp_UnknownProperty && vecReads[ i ] == 0.f );
+			else
+				TEST_CHECK( vecReadErrors[ i ] == vr::TrackedProp_Success && vecReads[ i ] == (float)i );
+		}
+		TEST_CHECK_EQUAL( props.GetCallCount(), 6u );
+
+		// left pending for the destructor
+		props.SetFloatProperty( vr::Prop_DisplayFrequency_Float, 120.f );
+	}
+	TEST_CHECK_EQUAL( mock.m_unWriteCalls, 4u );
+	TEST_CHECK( mock.m_mapValues.count( vr::Prop_DisplayFrequency_Float ) == 1 );
+}
+
+static void BenchmarkActivate()
+{
+	int nActivates = BenchFull() ? 200000 : 20000;
+	for ( int nCallCostNs : { 0, 2000 } )
+	{
+		CMockProperties mock;
+		mock.m_callCost = std::chrono::nanoseconds( nCallCostNs );
+		int nRuns = nCallCostNs ? nActivates / 20 : nActivates;
+
+		auto start = std::chrono::steady_clock::now();
+		for ( int i = 0; i < nRuns; i++ )
+			ActivateOneByOne( &mock, 1, 0.063f + i * 1e-6f );
+		double flOneByOneNs = BenchSecondsSince( start ) * 1e9 / nRuns;
+
+		start = std::chrono::steady_clock::now();
+		for ( int i = 0; i < nRuns; i++ )
+			ActivateBatched( &mock, 1, 0.063f + i * 1e-6f );
+		double flBatchedNs = BenchSecondsSince( start ) * 1e9 / nRuns;
+
+		printf( "Activate() properties, %4d ns per call: one by one %8.0f ns, batched %8.0f ns\n", nCallCostNs, flOneByOneNs, flBatchedNs );
+	}
+}
+
+int main()
+{
+	TestActivate();
+	TestEntryErrors();
+	TestOverflow();
+	BenchmarkActivate();
+	return TestResult( "propertybatch_test" );
+}
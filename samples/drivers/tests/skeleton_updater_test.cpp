@@ -0,0 +1,255 @@
+//============ Copyright (c) Valve Corporation, All rights reserved. ============
+// MySkeletonUpdater against a mock IVRDriverInput. BoundBoneMotion must never be less than how far
+// a bone actually moves, the skeleton vrserver last received must never be further than the
+// thresholds from the one the current inputs give, and unchanged inputs must send nothing. Then
+// replays a scripted open, close and splay cycle at 1 kHz at several thresholds and compares the
+// calls made and time spent with solving and sending every frame.
+#include "skeleton_updater.h"
+#include "vrmath.h"
+#include "test_common.h"
+
+#include <algorithm>
+#include <math.h>
+#include <random>
+#include <string.h>
+
+class CMockDriverInput : public vr::IVRDriverInput
+{
+public:
+	vr::EVRInputError CreateBooleanComponent( vr::PropertyContainerHandle_t, const char *, vr::VRInputComponentHandle_t * ) override { return vr::VRInputError_None; }
+	vr::EVRInputError UpdateBooleanComponent( vr::VRInputComponentHandle_t, bool, double ) override { return vr::VRInputError_None; }
+	vr::EVRInputError CreateScalarComponent( vr::PropertyContainerHandle_t, const char *, vr::VRInputComponentHandle_t *, vr::EVRScalarType, vr::EVRScalarUnits ) override { return vr::VRInputError_None; }
+	vr::EVRInputError UpdateScalarComponent( vr::VRInputComponentHandle_t, float, double ) override { return vr::VRInputError_None; }
+	vr::EVRInputError CreateHapticComponent( vr::PropertyContainerHandle_t, const char *, vr::VRInputComponentHandle_t * ) override { return vr::VRInputError_None; }
+	vr::EVRInputError CreateSkeletonComponent( vr::PropertyContainerHandle_t, const char *, const char *, const char *, vr::EVRSkeletalTrackingLevel, const vr::VRBoneTransform_t *, uint32_t,
+		vr::VRInputComponentHandle_t * ) override
+	{
+		return vr::VRInputError_None;
+	}
+
+	vr::EVRInputError UpdateSkeletonComponent( vr::VRInputComponentHandle_t ulComponent, vr::EVRSkeletalMotionRange eMotionRange, const vr::VRBoneTransform_t *pTransforms,
+		uint32_t unTransformCount ) override
+	{
+		int nRange = eMotionRange == vr::VRSkeletalMotionRange_WithController ? 0 : 1;
+		m_rgunCalls[ nRange ]++;
+		m_ulLastComponent = ulComponent;
+		memcpy( m_rgLast[ nRange ], pTransforms, std::min( unTransformCount, ( uint32_t )eBone_Count ) * sizeof( vr::VRBoneTransform_t ) );
+		return vr::VRInputError_None;
+	}
+
+	uint64_t m_rgunCalls[ 2 ] = {};
+	vr::VRInputComponentHandle_t m_ulLastComponent = vr::k_ulInvalidInputComponentHandle;
+	vr::VRBoneTransform_t m_rgLast[ 2 ][ eBone_Count ] = {};
+};
+
+static const vr::VRInputComponentHandle_t k_ulSkeletonHandle = 7;
+
+// The most any bone's transform differs between two skeletons, in radians and meters
+static void MaxBoneDifference( const vr::VRBoneTransform_t *pA, const vr::VRBoneTransform_t *pB, float *pflRadians, float *pflMeters )
+{
+	*pflRadians = 0;
+	*pflMeters = 0;
+	for ( int nBone = 0; nBone < eBone_Count; nBone++ )
+	{
+		const vr::HmdQuaternionf_t &p = pA[ nBone ].orientation;
+		const vr::HmdQuaternionf_t &q = pB[ nBone ].orientation;
+
+		// the angle of conj(p) * q
+		double w = p.w * q.w + p.x * q.x + p.y * q.y + p.z * q.z;
+		double x = p.w * q.x - p.x * q.w - p.y * q.z + p.z * q.y;
+		double y = p.w * q.y + p.x * q.z - p.y * q.w - p.z * q.x;
+		double z = p.w * q.z - p.x * q.y + p.y * q.x - p.z * q.w;
+		*pflRadians = std::max( *pflRadians, ( float )( 2 * atan2( sqrt( x * x + y * y + z * z ), fabs( w ) ) ) );
+
+		float flDistanceSquared = 0;
+		for ( int i = 0; i < 3; i++ )
+		{
+			float flDelta = pA[ nBone ].position.v[ i ] - pB[ nBone ].position.v[ i ];
+			flDistanceSquared += flDelta * flDelta;
+		}
+		*pflMeters = std::max( *pflMeters, sqrtf( flDistanceSquared ) );
+	}
+}
+
+static MyFingerCurls UniformCurls( float flCurl )
+{
+	return { flCurl, flCurl, flCurl, flCurl, flCurl };
+}
+
+static MyFingerSplays UniformSplays( float flSplay )
+{
+	return { flSplay, flSplay, flSplay, flSplay, flSplay };
+}
+
+static void TestBoundHolds()
+{
+	MyHandSimulation simulation;
+	std::mt19937 rng( 1 );
+	std::uniform_real_distribution< float > unit( 0.f, 1.f ), signedUnit( -1.f, 1.f ), nudge( -0.02f, 0.02f );
+	int nSamples = BenchFull() ? 200000 : 20000;
+	int nViolations = 0;
+	double flWorstAngleRatio = 0, flWorstPositionRatio = 0;
+	for ( int i = 0; i < nSamples; i++ )
+	{
+		// half the pairs far apart, half close together
+		bool bFar = ( i & 1 ) != 0;
+		float rflFrom[ 10 ], rflTo[ 10 ];
+		for ( int j = 0; j < 10; j++ )
+		{
+			rflFrom[ j ] = j < 5 ? unit( rng ) : signedUnit( rng );
+			rflTo[ j ] = bFar ? ( j < 5 ? unit( rng ) : signedUnit( rng ) ) : rflFrom[ j ] + nudge( rng );
+		}
+		MyFingerCurls fromCurls = { rflFrom[ 0 ], rflFrom[ 1 ], rflFrom[ 2 ], rflFrom[ 3 ], rflFrom[ 4 ] };
+		MyFingerSplays fromSplays = { rflFrom[ 5 ], rflFrom[ 6 ], rflFrom[ 7 ], rflFrom[ 8 ], rflFrom[ 9 ] };
+		MyFingerCurls toCurls = { rflTo[ 0 ], rflTo[ 1 ], rflTo[ 2 ], rflTo[ 3 ], rflTo[ 4 ] };
+		MyFingerSplays toSplays = { rflTo[ 5 ], rflTo[ 6 ], rflTo[ 7 ], rflTo[ 8 ], rflTo[ 9 ] };
+
+		float flBoundRadians, flBoundMeters;
+		simulation.BoundBoneMotion( fromCurls, fromSplays, toCurls, toSplays, &flBoundRadians, &flBoundMeters );
+		for ( vr::ETrackedControllerRole eRole : { vr::TrackedControllerRole_LeftHand, vr::TrackedControllerRole_RightHand } )
+		{
+			vr::VRBoneTransform_t rgFrom[ eBone_Count ], rgTo[ eBone_Count ];
+			simulation.ComputeSkeletonTransforms( eRole, fromCurls, fromSplays, rgFrom );
+			simulation.ComputeSkeletonTransforms( eRole, toCurls, toSplays, rgTo );
+			float flRadians, flMeters;
+			MaxBoneDifference( rgFrom, rgTo, &flRadians, &flMeters );
+			if ( flRadians > flBoundRadians * 1.0001f + 1e-6f || flMeters > flBoundMeters * 1.0001f + 1e-7f )
+				nViolations++;
+			if ( flBoundRadians > 1e-4f )
+				flWorstAngleRatio = std::max( flWorstAngleRatio, ( double )flRadians / flBoundRadians );
+			if ( flBoundMeters > 1e-6f )
+				flWorstPositionRatio = std::max( flWorstPositionRatio, ( double )flMeters / flBoundMeters );
+		}
+	}
+	printf( "%d pairs: bound broken %d times, actual/bound at most %.3f in angle and %.3f in position\n", nSamples, nViolations,
+		flWorstAngleRatio, flWorstPositionRatio );
+	TEST_CHECK_EQUAL( nViolations, 0 );
+}
+
+static void TestSuppression()
+{
+	CMockDriverInput input;
+	MySkeletonUpdateSettings settings = { ( float )DEG_TO_RAD( 0.5 ), 0.0005f };
+	MySkeletonUpdater updater( vr::TrackedControllerRole_RightHand, k_ulSkeletonHandle, settings );
+	updater.SetDriverInput( &input );
+
+	// the first update sends both ranges, even with all zero inputs
+	updater.Update( UniformCurls( 0 ), UniformSplays( 0 ), UniformCurls( 0 ), UniformSplays( 0 ) );
+	TEST_CHECK( input.m_rgunCalls[ 0 ] == 1 && input.m_rgunCalls[ 1 ] == 1 );
+	TEST_CHECK_EQUAL( input.m_ulLastComponent, k_ulSkeletonHandle );
+
+	// nothing changed, nothing sent
+	for ( int i = 0; i < 10; i++ )
+		updater.Update( UniformCurls( 0 ), UniformSplays( 0 ), UniformCurls( 0 ), UniformSplays( 0 ) );
+	TEST_CHECK( input.m_rgunCalls[ 0 ] == 1 && input.m_rgunCalls[ 1 ] == 1 );
+
+	// only the range whose inputs moved is sent
+	updater.Update( UniformCurls( 0 ), UniformSplays( 0 ), UniformCurls( 0.5f ), UniformSplays( 0 ) );
+	TEST_CHECK( input.m_rgunCalls[ 0 ] == 1 && input.m_rgunCalls[ 1 ] == 2 );
+
+	// and it went out with the right skeleton
+	MyHandSimulation simulation;
+	vr::VRBoneTransform_t rgExpected[ eBone_Count ];
+	simulation.ComputeSkeletonTransforms( vr::TrackedControllerRole_RightHand, UniformCurls( 0.5f ), UniformSplays( 0 ), rgExpected );
+	float flRadians, flMeters;
+	MaxBoneDifference( rgExpected, input.m_rgLast[ 1 ], &flRadians, &flMeters );
+	TEST_CHECK( flRadians < 1e-5f && flMeters < 1e-6f );
+
+	MySkeletonUpdateStats stats;
+	updater.GetStats( &stats );
+	TEST_CHECK_EQUAL( stats.sent, 3u );
+	TEST_CHECK_EQUAL( stats.suppressed, 21u );
+}
+
+// One 4 second cycle at 1 kHz: close the hand, open it, splay out, splay all the way in, and back
+static void StepCycle( int nFrame, float *pflCurl, float *pflSplay )
+{
+	int nStep = nFrame % 4000;
+	if ( nStep < 1000 )
+		*pflCurl += 0.001f;
+	else if ( nStep < 2000 )
+		*pflCurl -= 0.001f;
+	else if ( nStep < 2500 )
+		*pflSplay += 0.002f;
+	else if ( nStep < 3500 )
+		*pflSplay -= 0.002f;
+	else
+		*pflSplay += 0.002f;
+}
+
+static void BenchmarkThresholds()
+{
+	const int k_nFrames = BenchFull() ? 100000 : 20000;
+	MyHandSimulation simulation;
+	for ( float flThreshold : { 0.f, 0.1f, 0.25f, 0.5f, 1.f } )
+	{
+		// degrees and millimeters
+		MySkeletonUpdateSettings settings = { ( float )DEG_TO_RAD( flThreshold ), flThreshold / 1000.f };
+
+		// the skeleton vrserver has must stay within the thresholds of the one the inputs give
+		{
+			CMockDriverInput input;
+			MySkeletonUpdater updater( vr::TrackedControllerRole_LeftHand, k_ulSkeletonHandle, settings );
+			updater.SetDriverInput( &input );
+			float flCurl = 0, flSplay = 0, flMaxRadians = 0, flMaxMeters = 0;
+			for ( int nFrame = 0; nFrame < 4000; nFrame++ )
+			{
+				StepCycle( nFrame, &flCurl, &flSplay );
+				updater.Update( UniformCurls( flCurl ), UniformSplays( flSplay ), UniformCurls( flCurl ), UniformSplays( flSplay ) );
+
+				vr::VRBoneTransform_t rgTruth[ eBone_Count ];
+				simulation.ComputeSkeletonTransforms( vr::TrackedControllerRole_LeftHand, UniformCurls( flCurl ), UniformSplays( flSplay ), rgTruth );
+				for ( int nRange = 0; nRange < 2; nRange++ )
+				{
+					float flRadians, flMeters;
+					MaxBoneDifference( input.m_rgLast[ nRange ], rgTruth, &flRadians, &flMeters );
+					flMaxRadians = std::max( flMaxRadians, flRadians );
+					flMaxMeters = std::max( flMaxMeters, flMeters );
+				}
+			}
+			TEST_CHECK( flMaxRadians <= settings.angle_threshold_radians + 1e-5f );
+			TEST_CHECK( flMaxMeters <= settings.position_threshold_meters + 1e-6f );
+			printf( "threshold %.2f deg/%.2f mm: max error %.3f deg %.3f mm, ", flThreshold, flThreshold, flMaxRadians * 180 / M_PI, flMaxMeters * 1000 );
+		}
+
+		CMockDriverInput input;
+		MySkeletonUpdater updater( vr::TrackedControllerRole_LeftHand, k_ulSkeletonHandle, settings );
+		updater.SetDriverInput( &input );
+		float flCurl = 0, flSplay = 0;
+		auto start = std::chrono::steady_clock::now();
+		for ( int nFrame = 0; nFrame < k_nFrames; nFrame++ )
+		{
+			StepCycle( nFrame, &flCurl, &flSplay );
+			updater.Update( UniformCurls( flCurl ), UniformSplays( flSplay ), UniformCurls( flCurl ), UniformSplays( flSplay ) );
+		}
+		double flNsPerFrame = BenchSecondsSince( start ) * 1e9 / k_nFrames;
+		MySkeletonUpdateStats stats;
+		updater.GetStats( &stats );
+		printf( "%6.1f calls/s, %6.1f ns/frame\n", stats.sent / ( k_nFrames / 1000.0 ), flNsPerFrame );
+		if ( flThreshold > 0 )
+			TEST_CHECK( stats.suppressed > 0 );
+	}
+
+	// what the driver did before: solve once and send both ranges every frame
+	CMockDriverInput input;
+	float flCurl = 0, flSplay = 0;
+	auto start = std::chrono::steady_clock::now();
+	for ( int nFrame = 0; nFrame < k_nFrames; nFrame++ )
+	{
+		StepCycle( nFrame, &flCurl, &flSplay );
+		vr::VRBoneTransform_t rgTransforms[ eBone_Count ];
+		simulation.ComputeSkeletonTransforms( vr::TrackedControllerRole_LeftHand, UniformCurls( flCurl ), UniformSplays( flSplay ), rgTransforms );
+		input.UpdateSkeletonComponent( k_ulSkeletonHandle, vr::VRSkeletalMotionRange_WithController, rgTransforms, eBone_Count );
+		input.UpdateSkeletonComponent( k_ulSkeletonHandle, vr::VRSkeletalMotionRange_WithoutController, rgTransforms, eBone_Count );
+	}
+	double flNsPerFrame = BenchSecondsSince( start ) * 1e9 / k_nFrames;
+	printf( "every frame:                  %6.1f calls/s, %6.1f ns/frame\n", ( input.m_rgunCalls[ 0 ] + input.m_rgunCalls[ 1 ] ) / ( k_nFrames / 1000.0 ), flNsPerFrame );
+}
+
+int main()
+{
+	TestBoundHolds();
+	TestSuppression();
+	BenchmarkThresholds();
+	return TestResult( "skeleton_updater_test" );
+}
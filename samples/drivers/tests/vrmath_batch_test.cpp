@@ -0,0 +1,237 @@
+//============ Copyright (c) Valve Corporation, All rights reserved. ============
+// The batch vrmath kernels against a double precision reference and the scalar vrmath functions,
+// over random rotations with a third of them near 180 degrees. Every element must come out the
+// same whether it is computed in a full vector or in the scalar tail. Then times the batch kernels
+// against calling the scalar functions in a loop.
+#include "vrmath_batch.h"
+#include "test_common.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+static const uint32_t k_unElements = 10007;	// not a multiple of any vector width, so there is a tail
+
+struct QuaternionD_t
+{
+	double w, x, y, z;
+};
+
+static QuaternionD_t QuaternionFromAxisAngle( double flAxisX, double flAxisY, double flAxisZ, double flAngle )
+{
+	double flScale = sin( flAngle / 2 ) / sqrt( flAxisX * flAxisX + flAxisY * flAxisY + flAxisZ * flAxisZ );
+	return { cos( flAngle / 2 ), flAxisX * flScale, flAxisY * flScale, flAxisZ * flScale };
+}
+
+// L1 distance, treating q and -q as the same rotation
+static double RotationError( const QuaternionD_t &q, double w, double x, double y, double z )
+{
+	double flSame = fabs( q.w - w ) + fabs( q.x - x ) + fabs( q.y - y ) + fabs( q.z - z );
+	double flNegated = fabs( q.w + w ) + fabs( q.x + x ) + fabs( q.y + y ) + fabs( q.z + z );
+	return std::min( flSame, flNegated );
+}
+
+static double Error( double w0, double x0, double y0, double z0, double w1, double x1, double y1, double z1 )
+{
+	return fabs( w0 - w1 ) + fabs( x0 - x1 ) + fabs( y0 - y1 ) + fabs( z0 - z1 );
+}
+
+static void CheckError( const char *pchWhat, double flMaxError, double flLimit )
+{
+	printf( "%-24s max error %.3g\n", pchWhat, flMaxError );
+	if ( !( flMaxError <= flLimit ) )
+	{
+		fprintf( stderr, "%s: max error %.3g is over %.3g\n", pchWhat, flMaxError, flLimit );
+		g_nTestFailures++;
+	}
+}
+
+struct QuaternionArrays_t
+{
+	QuaternionArrays_t() : w( k_unElements ), x( k_unElements ), y( k_unElements ), z( k_unElements ) {}
+	HmdQuaternionBatch_t Batch( uint32_t unOffset = 0 ) { return { w.data() + unOffset, x.data() + unOffset, y.data() + unOffset, z.data() + unOffset }; }
+	std::vector< float > w, x, y, z;
+};
+
+static std::mt19937 g_rng( 1 );
+static std::uniform_real_distribution< double > g_unit( -1.0, 1.0 );
+
+static std::vector< QuaternionD_t > g_vecReference;
+static std::vector< float > g_rvecMatrix[ 3 ][ 3 ];
+
+static void BuildRotations()
+{
+	for ( int nRow = 0; nRow < 3; nRow++ )
+		for ( int nCol = 0; nCol < 3; nCol++ )
+			g_rvecMatrix[ nRow ][ nCol ].resize( k_unElements );
+
+	for ( uint32_t i = 0; i < k_unElements; i++ )
+	{
+		double flAngle = i % 3 == 0 ? M_PI - fabs( g_unit( g_rng ) ) * 1e-3 : g_unit( g_rng ) * M_PI;
+		QuaternionD_t q = QuaternionFromAxisAngle( g_unit( g_rng ), g_unit( g_rng ), g_unit( g_rng ), flAngle );
+		g_vecReference.push_back( q );
+
+		double m[ 3 ][ 3 ] = {
+			{ 1 - 2 * ( q.y * q.y + q.z * q.z ), 2 * ( q.x * q.y - q.w * q.z ), 2 * ( q.x * q.z + q.w * q.y ) },
+			{ 2 * ( q.x * q.y + q.w * q.z ), 1 - 2 * ( q.x * q.x + q.z * q.z ), 2 * ( q.y * q.z - q.w * q.x ) },
+			{ 2 * ( q.x * q.z - q.w * q.y ), 2 * ( q.y * q.z + q.w * q.x ), 1 - 2 * ( q.x * q.x + q.y * q.y ) } };
+		for ( int nRow = 0; nRow < 3; nRow++ )
+			for ( int nCol = 0; nCol < 3; nCol++ )
+				g_rvecMatrix[ nRow ][ nCol ][ i ] = ( float )m[ nRow ][ nCol ];
+	}
+}
+
+static HmdMatrix33Batch_t MatrixBatch( uint32_t unOffset = 0 )
+{
+	HmdMatrix33Batch_t batch;
+	for ( int nRow = 0; nRow < 3; nRow++ )
+		for ( int nCol = 0; nCol < 3; nCol++ )
+			batch.m[ nRow ][ nCol ] = g_rvecMatrix[ nRow ][ nCol ].data() + unOffset;
+	return batch;
+}
+
+static vr::HmdMatrix33_t Matrix( uint32_t i )
+{
+	vr::HmdMatrix33_t matrix;
+	for ( int nRow = 0; nRow < 3; nRow++ )
+		for ( int nCol = 0; nCol < 3; nCol++ )
+			matrix.m[ nRow ][ nCol ] = g_rvecMatrix[ nRow ][ nCol ][ i ];
+	return matrix;
+}
+
+static void TestFromMatrix()
+{
+	QuaternionArrays_t out;
+	HmdQuaternion_FromMatrixBatch( MatrixBatch(), out.Batch(), k_unElements );
+
+	double flMaxBatch = 0, flMaxScalar = 0;
+	int nLaneMismatches = 0, nNegativeW = 0;
+	for ( uint32_t i = 0; i < k_unElements; i++ )
+	{
+		flMaxBatch = std::max( flMaxBatch, RotationError( g_vecReference[ i ], out.w[ i ], out.x[ i ], out.y[ i ], out.z[ i ] ) );
+		vr::HmdQuaternion_t q = HmdQuaternion_FromMatrix( Matrix( i ) );
+		flMaxScalar = std::max( flMaxScalar, RotationError( g_vecReference[ i ], q.w, q.x, q.y, q.z ) );
+		if ( out.w[ i ] < 0 )
+			nNegativeW++;
+
+		// the same element on its own goes through the scalar tail
+		float rflSingle[ 4 ];
+		HmdQuaternionBatch_t single = { rflSingle, rflSingle + 1, rflSingle + 2, rflSingle + 3 };
+		HmdQuaternion_FromMatrixBatch( MatrixBatch( i ), single, 1 );
+		if ( rflSingle[ 0 ] != out.w[ i ] || rflSingle[ 1 ] != out.x[ i ] || rflSingle[ 2 ] != out.y[ i ] || rflSingle[ 3 ] != out.z[ i ] )
+			nLaneMismatches++;
+	}
+	CheckError( "FromMatrix batch", flMaxBatch, 2e-6 );
+	CheckError( "FromMatrix scalar", flMaxScalar, 2e-6 );
+	TEST_CHECK_EQUAL( nLaneMismatches, 0 );
+	TEST_CHECK_EQUAL( nNegativeW, 0 );
+}
+
+static void TestFromAngles()
+{
+	std::vector< float > vecA( k_unElements ), vecB( k_unElements ), vecC( k_unElements );
+	for ( uint32_t i = 0; i < k_unElements; i++ )
+	{
+		vecA[ i ] = ( float )( g_unit( g_rng ) * 10 );
+		vecB[ i ] = ( float )( g_unit( g_rng ) * 10 );
+		vecC[ i ] = ( float )( g_unit( g_rng ) * 10 );
+	}
+	// no swing at all takes a separate branch
+	vecA[ 0 ] = vecB[ 0 ] = 0.f;
+
+	QuaternionArrays_t out;
+	HmdQuaternion_FromEulerAnglesBatch( vecA.data(), vecB.data(), vecC.data(), out.Batch(), k_unElements );
+	double flMaxError = 0;
+	for ( uint32_t i = 0; i < k_unElements; i++ )
+	{
+		vr::HmdQuaternion_t q = HmdQuaternion_FromEulerAngles( vecA[ i ], vecB[ i ], vecC[ i ] );
+		flMaxError = std::max( flMaxError, RotationError( { q.w, q.x, q.y, q.z }, out.w[ i ], out.x[ i ], out.y[ i ], out.z[ i ] ) );
+	}
+	CheckError( "FromEulerAngles", flMaxError, 2e-6 );
+
+	HmdQuaternion_FromSwingTwistBatch( vecA.data(), vecB.data(), vecC.data(), out.Batch(), k_unElements );
+	flMaxError = 0;
+	for ( uint32_t i = 0; i < k_unElements; i++ )
+	{
+		vr::HmdVector2_t swing = { { vecA[ i ], vecB[ i ] } };
+		vr::HmdQuaternion_t q = HmdQuaternion_FromSwingTwist( swing, vecC[ i ] );
+		flMaxError = std::max( flMaxError, Error( q.w, q.x, q.y, q.z, out.w[ i ], out.x[ i ], out.y[ i ], out.z[ i ] ) );
+	}
+	CheckError( "FromSwingTwist", flMaxError, 1e-5 );
+}
+
+static void TestMultiplyAndRotate()
+{
+	QuaternionArrays_t lhs, rhs, product;
+	for ( uint32_t i = 0; i < k_unElements; i++ )
+	{
+		lhs.w[ i ] = ( float )g_unit( g_rng );
+		lhs.x[ i ] = ( float )g_unit( g_rng );
+		lhs.y[ i ] = ( float )g_unit( g_rng );
+		lhs.z[ i ] = ( float )g_unit( g_rng );
+	}
+	HmdQuaternion_NormalizeBatch( lhs.Batch(), lhs.Batch(), k_unElements );
+	HmdQuaternion_FromMatrixBatch( MatrixBatch(), rhs.Batch(), k_unElements );
+	HmdQuaternion_MultiplyBatch( lhs.Batch(), rhs.Batch(), product.Batch(), k_unElements );
+
+	double flMaxNorm = 0, flMaxProduct = 0;
+	for ( uint32_t i = 0; i < k_unElements; i++ )
+	{
+		double flNorm = sqrt( lhs.w[ i ] * lhs.w[ i ] + lhs.x[ i ] * lhs.x[ i ] + lhs.y[ i ] * lhs.y[ i ] + lhs.z[ i ] * lhs.z[ i ] );
+		flMaxNorm = std::max( flMaxNorm, fabs( flNorm - 1.0 ) );
+		vr::HmdQuaternion_t a = { lhs.w[ i ], lhs.x[ i ], lhs.y[ i ], lhs.z[ i ] };
+		vr::HmdQuaternion_t b = { rhs.w[ i ], rhs.x[ i ], rhs.y[ i ], rhs.z[ i ] };
+		vr::HmdQuaternion_t p = a * b;
+		flMaxProduct = std::max( flMaxProduct, Error( p.w, p.x, p.y, p.z, product.w[ i ], product.x[ i ], product.y[ i ], product.z[ i ] ) );
+	}
+	CheckError( "Normalize", flMaxNorm, 1e-6 );
+	CheckError( "Multiply", flMaxProduct, 1e-6 );
+
+	std::vector< float > rvecIn[ 3 ], rvecOut[ 3 ];
+	for ( int nAxis = 0; nAxis < 3; nAxis++ )
+	{
+		rvecOut[ nAxis ].resize( k_unElements );
+		for ( uint32_t i = 0; i < k_unElements; i++ )
+			rvecIn[ nAxis ].push_back( ( float )( g_unit( g_rng ) * 10 ) );
+	}
+	HmdVector3Batch_t in = { { rvecIn[ 0 ].data(), rvecIn[ 1 ].data(), rvecIn[ 2 ].data() } };
+	HmdVector3Batch_t out = { { rvecOut[ 0 ].data(), rvecOut[ 1 ].data(), rvecOut[ 2 ].data() } };
+	HmdVector3_RotateBatch( in, lhs.Batch(), out, k_unElements );
+	double flMaxRotate = 0;
+	for ( uint32_t i = 0; i < k_unElements; i++ )
+	{
+		vr::HmdQuaternion_t q = { lhs.w[ i ], lhs.x[ i ], lhs.y[ i ], lhs.z[ i ] };
+		vr::HmdVector3_t v = { { rvecIn[ 0 ][ i ], rvecIn[ 1 ][ i ], rvecIn[ 2 ][ i ] } };
+		vr::HmdVector3_t r = v * q;
+		flMaxRotate = std::max( flMaxRotate, Error( 0, r.v[ 0 ], r.v[ 1 ], r.v[ 2 ], 0, rvecOut[ 0 ][ i ], rvecOut[ 1 ][ i ], rvecOut[ 2 ][ i ] ) );
+	}
+	CheckError( "Rotate", flMaxRotate, 5e-5 );
+}
+
+static void BenchmarkFromMatrix()
+{
+	int nRounds = BenchFull() ? 200 : 10;
+	QuaternionArrays_t out;
+	auto start = std::chrono::steady_clock::now();
+	for ( int nRound = 0; nRound < nRounds; nRound++ )
+		HmdQuaternion_FromMatrixBatch( MatrixBatch(), out.Batch(), k_unElements );
+	double flBatchNs = BenchSecondsSince( start ) * 1e9 / ( ( double )nRounds * k_unElements );
+
+	double flSink = 0;
+	start = std::chrono::steady_clock::now();
+	for ( int nRound = 0; nRound < nRounds; nRound++ )
+		for ( uint32_t i = 0; i < k_unElements; i++ )
+			flSink += HmdQuaternion_FromMatrix( Matrix( i ) ).w;
+	double flScalarNs = BenchSecondsSince( start ) * 1e9 / ( ( double )nRounds * k_unElements );
+	printf( "FromMatrix: batch %.2f ns/element, scalar %.2f ns/element (%g)\n", flBatchNs, flScalarNs, flSink > 0 ? 1.0 : 0.0 );
+}
+
+int main()
+{
+	BuildRotations();
+	TestFromMatrix();
+	TestFromAngles();
+	TestMultiplyAndRotate();
+	BenchmarkFromMatrix();
+	return TestResult( "vrmath_batch_test" );
+}
@@ -1,41 +1,594 @@
 //============ Copyright (c) Valve Corporation, All rights reserved. ============
 #include "driverlog.h"
 
-#include <stdarg.h>
 #include <stdio.h>
 
-#if !defined( WIN32 )
-#define vsnprintf_s vsnprintf
-#endif
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
 
-static void DriverLogVarArgs( const char *pMsgFormat, va_list args )
+// Each thread that logs gets its own buffer of this size
+static const uint32_t k_unBufferSize = 64 * 1024;
+
+// Bigger messages are dropped rather than letting one of them fill the buffer
+static const uint32_t k_unMaxMessageSize = k_unBufferSize / 4;
+
+// How often the log thread formats and passes on what's been logged
+static const std::chrono::milliseconds k_flushInterval( 10 );
+
+// Past a burst, messages are logged at no more than this rate and the rest are dropped
+static const double k_flMessagesPerSecond = 200.0;
+static const double k_flMessageBurst = 500.0;
+
+struct MessageHeader_t
+{
+	uint32_t unSize;		// including the header, rounded up to 8. 0 means the rest of the buffer is unused.
+	uint32_t unArgsSize;
+	int64_t nTimeNs;
+	const char *pchFormat;
+};
+
+//-----------------------------------------------------------------------------
+// Purpose: One thread's messages on their way to the log thread. Messages are
+// variable length and never split across the end of the buffer.
+//-----------------------------------------------------------------------------
+struct ThreadBuffer_t
 {
-	char buf[ 1024 ];
-	vsnprintf_s( buf, sizeof( buf ), pMsgFormat, args );
+	alignas( 8 ) uint8_t rgBuffer[ k_unBufferSize ];
 
-	vr::VRDriverLog()->Log( buf );
+	// Positions that only ever increase, so full and empty look different. They're padded apart
+	// rather than aligned since these are allocated with new, which needn't honor alignas.
+	std::atomic< uint32_t > unWrite;
+	uint32_t unPendingWrite;	// where the message between BeginMessage and EndMessage ends. Logging thread only.
+	uint8_t rgPadding[ 64 ];
+	std::atomic< uint32_t > unRead;
+
+	std::atomic< uint64_t > unDroppedFull;
+	std::atomic< uint64_t > unDroppedTooLong;
+	std::atomic< bool > bThreadExited;
+};
+
+static int64_t GetTimeNs()
+{
+	return std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now().time_since_epoch() ).count();
 }
 
+//-----------------------------------------------------------------------------
+// Purpose: Owns every thread's buffer and the thread that empties them
+//-----------------------------------------------------------------------------
+class CDriverLogger
+{
+public:
+	CDriverLogger()
+		: m_bThreadRunning( false )
+		, m_bShutDown( false )
+		, m_unThreadGeneration( 0 )
+		, m_flTokens( k_flMessageBurst )
+		, m_nLastMessageTimeNs( 0 )
+		, m_unDroppedRateLimited( 0 )
+	{
+		memset( &m_stats, 0, sizeof( m_stats ) );
+	}
+
+	ThreadBuffer_t *AddThread()
+	{
+		ThreadBuffer_t *pBuffer = new ThreadBuffer_t;
+		pBuffer->unWrite = 0;
+		pBuffer->unRead = 0;
+		pBuffer->unPendingWrite = 0;
+		pBuffer->unDroppedFull = 0;
+		pBuffer->unDroppedTooLong = 0;
+		pBuffer->bThreadExited = false;
+
+		std::lock_guard< std::mutex > lock( m_mutex );
+		m_vecBuffers.push_back( pBuffer );
+		return pBuffer;
+	}
+
+	void EnsureThreadRunning()
+	{
+		if ( m_bThreadRunning.load( std::memory_order_relaxed ) || BShutDown() )
+			return;
+
+		std::lock_guard< std::mutex > lock( m_mutex );
+		if ( m_thread.joinable() || m_bShutDown.load( std::memory_order_relaxed ) )
+			return;
+		m_unThreadGeneration++;
+		m_thread = std::thread( &CDriverLogger::ThreadMain, this, m_unThreadGeneration );
+		m_bThreadRunning = true;
+	}
+
+	void Shutdown()
+	{
+		std::thread thread;
+		{
+			std::lock_guard< std::mutex > lock( m_mutex );
+			m_unThreadGeneration++;
+			m_bShutDown = true;
+			m_bThreadRunning = false;
+			thread = std::move( m_thread );
+			m_wakeCondition.notify_all();
+		}
+		if ( thread.joinable() )
+			thread.join();
+
+		Flush();
+	}
+
+	/** True once Shutdown has been called. Messages are then flushed by the thread that logged them. */
+	bool BShutDown() const
+	{
+		return m_bShutDown.load( std::memory_order_relaxed );
+	}
+
+	/** Formats and logs everything logged up to now, from the calling thread */
+	void Flush()
+	{
+		std::lock_guard< std::mutex > flushLock( m_flushMutex );
+
+		int64_t nFlushTimeNs = GetTimeNs();
+		std::vector< ThreadBuffer_t * > vecBuffers;
+		{
+			std::lock_guard< std::mutex > lock( m_mutex );
+			vecBuffers = m_vecBuffers;
+		}
+
+		// Log in time order across every thread. Messages from after we started are left for next time, so a
+		// thread that never stops logging can't keep us here.
+		vr::IVRDriverLog *pLog = vr::VRDriverLog();
+		while ( true )
+		{
+			ThreadBuffer_t *pOldest = nullptr;
+			const MessageHeader_t *pOldestHeader = nullptr;
+			for ( ThreadBuffer_t *pBuffer : vecBuffers )
+			{
+				const MessageHeader_t *pHeader = PeekNext( pBuffer );
+				if ( pHeader && pHeader->nTimeNs <= nFlushTimeNs && ( !pOldestHeader || pHeader->nTimeNs < pOldestHeader->nTimeNs ) )
+				{
+					pOldest = pBuffer;
+					pOldestHeader = pHeader;
+				}
+			}
+			if ( !pOldest )
+				break;
+
+			if ( !pLog )
+			{
+				m_stats.unDroppedNoLog++;
+			}
+			else if ( TakeToken( pOldestHeader->nTimeNs ) )
+			{
+				m_message.clear();
+				FormatArgs( pOldestHeader, &m_message );
+				pLog->Log( m_message.c_str() );
+				m_stats.unLogged++;
+			}
+			else
+			{
+				m_unDroppedRateLimited++;
+			}
 
-void DriverLog( const char *pMsgFormat, ... )
+			pOldest->unRead.store( pOldest->unRead.load( std::memory_order_relaxed ) + pOldestHeader->unSize, std::memory_order_release );
+		}
+
+		// Say what was lost. This is only logged once per flush, so it doesn't count against the rate.
+		uint64_t unDroppedFull = 0;
+		uint64_t unDroppedTooLong = 0;
+		for ( ThreadBuffer_t *pBuffer : vecBuffers )
+		{
+			unDroppedFull += pBuffer->unDroppedFull.exchange( 0, std::memory_order_relaxed );
+			unDroppedTooLong += pBuffer->unDroppedTooLong.exchange( 0, std::memory_order_relaxed );
+		}
+		if ( unDroppedFull || unDroppedTooLong || m_unDroppedRateLimited )
+		{
+			char rchMessage[ 256 ];
+			snprintf( rchMessage, sizeof( rchMessage ), "DriverLog dropped %llu messages: %llu with the buffer full, %llu too long, %llu over the rate limit",
+				( unsigned long long )( unDroppedFull + unDroppedTooLong + m_unDroppedRateLimited ), ( unsigned long long )unDroppedFull,
+				( unsigned long long )unDroppedTooLong, ( unsigned long long )m_unDroppedRateLimited );
+			if ( pLog )
+				pLog->Log( rchMessage );
+
+			m_stats.unDroppedFull += unDroppedFull;
+			m_stats.unDroppedTooLong += unDroppedTooLong;
+			m_stats.unDroppedRateLimited += m_unDroppedRateLimited;
+			m_unDroppedRateLimited = 0;
+		}
+
+		// Free the buffers of threads that have exited once we've logged everything in them
+		std::lock_guard< std::mutex > lock( m_mutex );
+		for ( auto iter = m_vecBuffers.begin(); iter != m_vecBuffers.end(); )
+		{
+			ThreadBuffer_t *pBuffer = *iter;
+			if ( pBuffer->bThreadExited.load( std::memory_order_acquire ) && !PeekNext( pBuffer ) )
+			{
+				delete pBuffer;
+				iter = m_vecBuffers.erase( iter );
+			}
+			else
+			{
+				++iter;
+			}
+		}
+	}
+
+	void GetStats( DriverLogStats_t *pStats )
+	{
+		std::lock_guard< std::mutex > flushLock( m_flushMutex );
+		*pStats = m_stats;
+	}
+
+private:
+	void ThreadMain( uint32_t unGeneration )
+	{
+		std::unique_lock< std::mutex > lock( m_mutex );
+		while ( m_unThreadGeneration == unGeneration )
+		{
+			m_wakeCondition.wait_for( lock, k_flushInterval );
+			if ( m_unThreadGeneration != unGeneration )
+				break;
+
+			lock.unlock();
+			Flush();
+			lock.lock();
+		}
+	}
+
+	/** Returns the oldest message in the buffer, or nullptr if it's empty. Skips the unused end of the buffer. */
+	static const MessageHeader_t *PeekNext( ThreadBuffer_t *pBuffer )
+	{
+		while ( true )
+		{
+			uint32_t unRead = pBuffer->unRead.load( std::memory_order_relaxed );
+			if ( unRead == pBuffer->unWrite.load( std::memory_order_acquire ) )
+				return nullptr;
+
+			uint32_t unOffset = unRead & ( k_unBufferSize - 1 );
+			const MessageHeader_t *pHeader = ( const MessageHeader_t * )&pBuffer->rgBuffer[ unOffset ];
+			if ( pHeader->unSize != 0 )
+				return pHeader;
+
+			pBuffer->unRead.store( unRead + ( k_unBufferSize - unOffset ), std::memory_order_release );
+		}
+	}
+
+	bool TakeToken( int64_t nMessageTimeNs )
+	{
+		if ( nMessageTimeNs > m_nLastMessageTimeNs )
+		{
+			m_flTokens = std::min( k_flMessageBurst, m_flTokens + ( double )( nMessageTimeNs - m_nLastMessageTimeNs ) * k_flMessagesPerSecond / 1e9 );
+			m_nLastMessageTimeNs = nMessageTimeNs;
+		}
+		if ( m_flTokens < 1.0 )
+			return false;
+		m_flTokens -= 1.0;
+		return true;
+	}
+
+	static void FormatArgs( const MessageHeader_t *pHeader, std::string *pMessage );
+
+	std::mutex m_mutex;
+	std::vector< ThreadBuffer_t * > m_vecBuffers;
+	std::condition_variable m_wakeCondition;
+	std::atomic< bool > m_bThreadRunning;
+	std::atomic< bool > m_bShutDown;	// set for good by Shutdown, so the thread isn't started again
+	std::thread m_thread;
+	uint32_t m_unThreadGeneration;	// the thread exits once this no longer matches the value it was started with
+
+	// everything below is only touched with the flush lock held
+	std::mutex m_flushMutex;
+	std::string m_message;
+	double m_flTokens;
+	int64_t m_nLastMessageTimeNs;
+	uint64_t m_unDroppedRateLimited;
+	DriverLogStats_t m_stats;
+};
+
+
+struct Arg_t
+{
+	uint8_t eType;
+	union
+	{
+		int n;
+		unsigned int un;
+		long l;
+		unsigned long ul;
+		long long ll;
+		unsigned long long ull;
+		double fl;
+		const void *p;
+		const char *pch;
+	};
+};
+
+static bool ReadArg( const uint8_t **ppArgs, const uint8_t *pArgsEnd, Arg_t *pArg )
 {
-	va_list args;
-	va_start( args, pMsgFormat );
+	const uint8_t *p = *ppArgs;
+	if ( p >= pArgsEnd )
+		return false;
 
-	DriverLogVarArgs( pMsgFormat, args );
+	pArg->eType = *p++;
+	switch ( pArg->eType )
+	{
+	case driverlog::k_eArgInt: memcpy( &pArg->n, p, sizeof( pArg->n ) ); p += sizeof( pArg->n ); break;
+	case driverlog::k_eArgUnsignedInt: memcpy( &pArg->un, p, sizeof( pArg->un ) ); p += sizeof( pArg->un ); break;
+	case driverlog::k_eArgLong: memcpy( &pArg->l, p, sizeof( pArg->l ) ); p += sizeof( pArg->l ); break;
+	case driverlog::k_eArgUnsignedLong: memcpy( &pArg->ul, p, sizeof( pArg->ul ) ); p += sizeof( pArg->ul ); break;
+	case driverlog::k_eArgLongLong: memcpy( &pArg->ll, p, sizeof( pArg->ll ) ); p += sizeof( pArg->ll ); break;
+	case driverlog::k_eArgUnsignedLongLong: memcpy( &pArg->ull, p, sizeof( pArg->ull ) ); p += sizeof( pArg->ull ); break;
+	case driverlog::k_eArgDouble: memcpy( &pArg->fl, p, sizeof( pArg->fl ) ); p += sizeof( pArg->fl ); break;
+	case driverlog::k_eArgPointer: memcpy( &pArg->p, p, sizeof( pArg->p ) ); p += sizeof( pArg->p ); break;
+	case driverlog::k_eArgString:
+	{
+		uint32_t unLength;
+		memcpy( &unLength, p, sizeof( unLength ) );
+		p += sizeof( unLength );
+		if ( unLength == UINT32_MAX )
+		{
+			pArg->pch = "(null)";
+			p += 1;
+		}
+		else
+		{
+			pArg->pch = ( const char * )p;
+			p += unLength + 1;
+		}
+		break;
+	}
+	default:
+		return false;
+	}
 
-	va_end( args );
+	*ppArgs = p;
+	return true;
 }
 
+static int ArgToInt( const Arg_t &arg )
+{
+	switch ( arg.eType )
+	{
+	case driverlog::k_eArgInt: return arg.n;
+	case driverlog::k_eArgUnsignedInt: return ( int )arg.un;
+	case driverlog::k_eArgLong: return ( int )arg.l;
+	case driverlog::k_eArgUnsignedLong: return ( int )arg.ul;
+	case driverlog::k_eArgLongLong: return ( int )arg.ll;
+	case driverlog::k_eArgUnsignedLongLong: return ( int )arg.ull;
+	default: return 0;
+	}
+}
 
-void DebugDriverLog( const char *pMsgFormat, ... )
+template < class T >
+static void AppendConversion( std::string *pMessage, const char *pchSpec, const int *pnStars, int nStars, T value )
 {
-#ifdef _DEBUG
-	va_list args;
-	va_start( args, pMsgFormat );
+	char rchBuffer[ 256 ];
+	int nLength;
+	switch ( nStars )
+	{
+	case 0: nLength = snprintf( rchBuffer, sizeof( rchBuffer ), pchSpec, value ); break;
+	case 1: nLength = snprintf( rchBuffer, sizeof( rchBuffer ), pchSpec, pnStars[ 0 ], value ); break;
+	default: nLength = snprintf( rchBuffer, sizeof( rchBuffer ), pchSpec, pnStars[ 0 ], pnStars[ 1 ], value ); break;
+	}
+	if ( nLength < 0 )
+		return;
 
-	DriverLogVarArgs( pMsgFormat, args );
+	if ( nLength < ( int )sizeof( rchBuffer ) )
+	{
+		pMessage->append( rchBuffer, nLength );
+		return;
+	}
+
+	// too big for the stack, so format it again straight into the message
+	size_t unStart = pMessage->size();
+	pMessage->resize( unStart + nLength + 1 );
+	switch ( nStars )
+	{
+	case 0: snprintf( &( *pMessage )[ unStart ], nLength + 1, pchSpec, value ); break;
+	case 1: snprintf( &( *pMessage )[ unStart ], nLength + 1, pchSpec, pnStars[ 0 ], value ); break;
+	default: snprintf( &( *pMessage )[ unStart ], nLength + 1, pchSpec, pnStars[ 0 ], pnStars[ 1 ], value ); break;
+	}
+	pMessage->resize( unStart + nLength );
+}
 
-	va_end( args );
-#endif
+//-----------------------------------------------------------------------------
+// Purpose: Does what vsnprintf would have done when the message was logged.
+// Each conversion is handed to snprintf with the argument's original type.
+//-----------------------------------------------------------------------------
+void CDriverLogger::FormatArgs( const MessageHeader_t *pHeader, std::string *pMessage )
+{
+	const uint8_t *pArgs = ( const uint8_t * )( pHeader + 1 );
+	const uint8_t *pArgsEnd = pArgs + pHeader->unArgsSize;
+
+	const char *pch = pHeader->pchFormat;
+	while ( *pch )
+	{
+		const char *pchPercent = strchr( pch, '%' );
+		if ( !pchPercent )
+		{
+			pMessage->append( pch );
+			break;
+		}
+		pMessage->append( pch, pchPercent - pch );
+
+		pch = pchPercent + 1;
+		if ( *pch == '%' )
+		{
+			pMessage->push_back( '%' );
+			pch++;
+			continue;
+		}
+
+		int rnStars[ 2 ];
+		int nStars = 0;
+		Arg_t arg;
+		bool bMissingArg = false;
+
+		while ( *pch && strchr( "-+ #0'", *pch ) )
+			pch++;
+		for ( int nField = 0; nField < 2; nField++ )
+		{
+			// width, then precision
+			if ( nField == 1 )
+			{
+				if ( *pch != '.' )
+					break;
+				pch++;
+			}
+			if ( *pch == '*' )
+			{
+				pch++;
+				if ( ReadArg( &pArgs, pArgsEnd, &arg ) )
+					rnStars[ nStars++ ] = ArgToInt( arg );
+				else
+					bMissingArg = true;
+			}
+			while ( *pch >= '0' && *pch <= '9' )
+				pch++;
+		}
+		while ( *pch && strchr( "hlLqjztI", *pch ) )
+		{
+			// MSVC's I32 and I64
+			if ( *pch == 'I' && ( ( pch[ 1 ] == '3' && pch[ 2 ] == '2' ) || ( pch[ 1 ] == '6' && pch[ 2 ] == '4' ) ) )
+				pch += 2;
+			pch++;
+		}
+		if ( !*pch )
+		{
+			pMessage->append( pchPercent );
+			break;
+		}
+
+		char chConversion = *pch++;
+		char rchSpec[ 32 ];
+		size_t unSpecLength = pch - pchPercent;
+		if ( bMissingArg || unSpecLength >= sizeof( rchSpec ) || !ReadArg( &pArgs, pArgsEnd, &arg ) )
+		{
+			pMessage->append( pchPercent, unSpecLength );
+			continue;
+		}
+		if ( chConversion == 'n' )
+			continue;
+
+		memcpy( rchSpec, pchPercent, unSpecLength );
+		rchSpec[ unSpecLength ] = '\0';
+
+		switch ( arg.eType )
+		{
+		case driverlog::k_eArgInt: AppendConversion( pMessage, rchSpec, rnStars, nStars, arg.n ); break;
+		case driverlog::k_eArgUnsignedInt: AppendConversion( pMessage, rchSpec, rnStars, nStars, arg.un ); break;
+		case driverlog::k_eArgLong: AppendConversion( pMessage, rchSpec, rnStars, nStars, arg.l ); break;
+		case driverlog::k_eArgUnsignedLong: AppendConversion( pMessage, rchSpec, rnStars, nStars, arg.ul ); break;
+		case driverlog::k_eArgLongLong: AppendConversion( pMessage, rchSpec, rnStars, nStars, arg.ll ); break;
+		case driverlog::k_eArgUnsignedLongLong: AppendConversion( pMessage, rchSpec, rnStars, nStars, arg.ull ); break;
+		case driverlog::k_eArgDouble: AppendConversion( pMessage, rchSpec, rnStars, nStars, arg.fl ); break;
+		case driverlog::k_eArgPointer: AppendConversion( pMessage, rchSpec, rnStars, nStars, arg.p ); break;
+		case driverlog::k_eArgString: AppendConversion( pMessage, rchSpec, rnStars, nStars, arg.pch ); break;
+		}
+	}
+}
+
+
+static CDriverLogger &DriverLogger()
+{
+	// never destroyed, so threads can still log during static destruction
+	static CDriverLogger *s_pLogger = new CDriverLogger;
+	return *s_pLogger;
+}
+
+// Tells the log thread when a thread exits, so it can free its buffer once it's empty
+class CThreadBufferOwner
+{
+public:
+	CThreadBufferOwner() : m_pBuffer( nullptr ) {}
+	~CThreadBufferOwner()
+	{
+		if ( m_pBuffer )
+			m_pBuffer->bThreadExited.store( true, std::memory_order_release );
+	}
+
+	ThreadBuffer_t *m_pBuffer;
+};
+
+// A plain pointer for the fast path, since a thread_local with a destructor costs a check on every access
+static thread_local ThreadBuffer_t *t_pBuffer = nullptr;
+static thread_local CThreadBufferOwner t_bufferOwner;
+
+
+uint8_t *driverlog::BeginMessage( const char *pchFormat, uint32_t unArgsSize )
+{
+	ThreadBuffer_t *pBuffer = t_pBuffer;
+	if ( !pBuffer )
+	{
+		pBuffer = DriverLogger().AddThread();
+		t_pBuffer = pBuffer;
+		t_bufferOwner.m_pBuffer = pBuffer;
+	}
+	DriverLogger().EnsureThreadRunning();
+
+	uint32_t unSize = ( uint32_t )( ( sizeof( MessageHeader_t ) + unArgsSize + 7 ) & ~7 );
+	if ( unArgsSize > k_unMaxMessageSize || unSize > k_unMaxMessageSize )
+	{
+		pBuffer->unDroppedTooLong.fetch_add( 1, std::memory_order_relaxed );
+		return nullptr;
+	}
+
+	uint32_t unWrite = pBuffer->unWrite.load( std::memory_order_relaxed );
+	uint32_t unFree = k_unBufferSize - ( unWrite - pBuffer->unRead.load( std::memory_order_acquire ) );
+	uint32_t unOffset = unWrite & ( k_unBufferSize - 1 );
+	uint32_t unToEnd = k_unBufferSize - unOffset;
+
+	// Messages are never split, so if this one doesn't fit before the end of the buffer, mark the end unused and start over at the front
+	uint32_t unSkip = unSize > unToEnd ? unToEnd : 0;
+	if ( unSkip + unSize > unFree )
+	{
+		pBuffer->unDroppedFull.fetch_add( 1, std::memory_order_relaxed );
+		return nullptr;
+	}
+	if ( unSkip )
+	{
+		uint32_t unUnused = 0;
+		memcpy( &pBuffer->rgBuffer[ unOffset ], &unUnused, sizeof( unUnused ) );
+		unOffset = 0;
+	}
+
+	MessageHeader_t *pHeader = ( MessageHeader_t * )&pBuffer->rgBuffer[ unOffset ];
+	pHeader->unSize = unSize;
+	pHeader->unArgsSize = unArgsSize;
+	pHeader->nTimeNs = GetTimeNs();
+	pHeader->pchFormat = pchFormat;
+	pBuffer->unPendingWrite = unWrite + unSkip + unSize;
+	return ( uint8_t * )( pHeader + 1 );
+}
+
+
+void driverlog::EndMessage()
+{
+	ThreadBuffer_t *pBuffer = t_pBuffer;
+	pBuffer->unWrite.store( pBuffer->unPendingWrite, std::memory_order_release );
+
+	// There's no thread to pass it on once the log has been shut down. A message that races with
+	// the shutdown itself is left for the next flush.
+	if ( DriverLogger().BShutDown() )
+		DriverLogger().Flush();
+}
+
+
+void DriverLogFlush()
+{
+	DriverLogger().Flush();
+}
+
+
+void DriverLogShutdown()
+{
+	DriverLogger().Shutdown();
+}
+
+
+void DriverLogGetStats( DriverLogStats_t *pStats )
+{
+	DriverLogger().GetStats( pStats );
 }
@@ -4,6 +4,193 @@
 #include <string>
 #include <openvr_driver.h>
 
-extern void DriverLog( const char *pchFormat, ... );
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
 
-extern void DebugDriverLog( const char *pchFormat, ... );
\ No newline at end of file
+#define DRIVERLOG_LEVEL_DEBUG 0
+#define DRIVERLOG_LEVEL_INFO 1
+#define DRIVERLOG_LEVEL_NONE 2
+
+// Calls below this level compile to nothing. Set it for the whole project to change it.
+#ifndef DRIVERLOG_MIN_LEVEL
+#ifdef _DEBUG
+#define DRIVERLOG_MIN_LEVEL DRIVERLOG_LEVEL_DEBUG
+#else
+#define DRIVERLOG_MIN_LEVEL DRIVERLOG_LEVEL_INFO
+#endif
+#endif
+
+struct DriverLogStats_t
+{
+	uint64_t unLogged;				// messages passed to vrserver
+	uint64_t unDroppedFull;			// messages dropped because their thread's buffer was full
+	uint64_t unDroppedTooLong;		// messages dropped because their arguments didn't fit in a buffer
+	uint64_t unDroppedRateLimited;	// messages dropped because too many were logged at once
+	uint64_t unDroppedNoLog;		// messages dropped because vr::VRDriverLog() wasn't available
+};
+
+namespace driverlog
+{
+	// Arguments are stored as the type printf would have received them as, so they can be
+	// formatted later exactly as they would have been now. Strings are copied.
+	enum EArgType : uint8_t
+	{
+		k_eArgInt,
+		k_eArgUnsignedInt,
+		k_eArgLong,
+		k_eArgUnsignedLong,
+		k_eArgLongLong,
+		k_eArgUnsignedLongLong,
+		k_eArgDouble,
+		k_eArgPointer,
+		k_eArgString,
+	};
+
+	struct StringArg_t
+	{
+		const char *pch;
+		uint32_t unLength;
+	};
+
+	inline int Promote( bool b ) { return b; }
+	inline int Promote( char c ) { return c; }
+	inline int Promote( signed char c ) { return c; }
+	inline int Promote( unsigned char c ) { return c; }
+	inline int Promote( short n ) { return n; }
+	inline int Promote( unsigned short n ) { return n; }
+	inline int Promote( int n ) { return n; }
+	inline unsigned int Promote( unsigned int n ) { return n; }
+	inline long Promote( long n ) { return n; }
+	inline unsigned long Promote( unsigned long n ) { return n; }
+	inline long long Promote( long long n ) { return n; }
+	inline unsigned long long Promote( unsigned long long n ) { return n; }
+	inline double Promote( float fl ) { return fl; }
+	inline double Promote( double fl ) { return fl; }
+	inline const void *Promote( std::nullptr_t ) { return nullptr; }
+	inline StringArg_t Promote( const char *pch ) { StringArg_t arg = { pch, pch ? ( uint32_t )strlen( pch ) : 0 }; return arg; }
+	inline StringArg_t Promote( char *pch ) { return Promote( ( const char * )pch ); }
+
+	// Only char strings are copied. Any other pointer is logged as its address, which for a wide
+	// string would be read back as an address long after the string itself may be gone.
+	template < class T >
+	inline const void *Promote( T *p )
+	{
+		typedef typename std::remove_cv< T >::type Pointee_t;
+		static_assert( !std::is_same< Pointee_t, wchar_t >::value && !std::is_same< Pointee_t, char16_t >::value && !std::is_same< Pointee_t, char32_t >::value,
+			"DriverLog only copies char strings. Convert wide strings to UTF-8, or cast to const void * to log the address." );
+		return p;
+	}
+
+	template < class T >
+	inline typename std::enable_if< std::is_enum< T >::value, decltype( Promote( ( typename std::underlying_type< T >::type )0 ) ) >::type Promote( T e )
+	{
+		return Promote( ( typename std::underlying_type< T >::type )e );
+	}
+
+	template < class T >
+	inline typename std::enable_if< !std::is_enum< T >::value && !std::is_pointer< T >::value && !std::is_array< T >::value, int >::type Promote( const T & )
+	{
+		static_assert( sizeof( T ) == 0, "DriverLog only takes the arguments printf does. Pass std::string with c_str()." );
+		return 0;
+	}
+
+	template < class T > struct ArgType;
+	template <> struct ArgType< int > { static const uint8_t k_eType = k_eArgInt; };
+	template <> struct ArgType< unsigned int > { static const uint8_t k_eType = k_eArgUnsignedInt; };
+	template <> struct ArgType< long > { static const uint8_t k_eType = k_eArgLong; };
+	template <> struct ArgType< unsigned long > { static const uint8_t k_eType = k_eArgUnsignedLong; };
+	template <> struct ArgType< long long > { static const uint8_t k_eType = k_eArgLongLong; };
+	template <> struct ArgType< unsigned long long > { static const uint8_t k_eType = k_eArgUnsignedLongLong; };
+	template <> struct ArgType< double > { static const uint8_t k_eType = k_eArgDouble; };
+	template <> struct ArgType< const void * > { static const uint8_t k_eType = k_eArgPointer; };
+
+	template < class T >
+	inline uint32_t EncodedSize( const T & ) { return 1 + sizeof( T ); }
+	inline uint32_t EncodedSize( const StringArg_t &arg ) { return 1 + sizeof( uint32_t ) + arg.unLength + 1; }
+
+	template < class T >
+	inline uint8_t *Encode( uint8_t *p, const T &value )
+	{
+		*p = ArgType< T >::k_eType;
+		memcpy( p + 1, &value, sizeof( T ) );
+		return p + 1 + sizeof( T );
+	}
+
+	inline uint8_t *Encode( uint8_t *p, const StringArg_t &arg )
+	{
+		// null is stored as the maximum length, so it can still be printed as "(null)"
+		uint32_t unLength = arg.pch ? arg.unLength : UINT32_MAX;
+		*p = k_eArgString;
+		memcpy( p + 1, &unLength, sizeof( uint32_t ) );
+		p += 1 + sizeof( uint32_t );
+		if ( arg.pch )
+			memcpy( p, arg.pch, arg.unLength );
+		p[ arg.unLength ] = '\0';
+		return p + arg.unLength + 1;
+	}
+
+	inline uint32_t ArgsSize() { return 0; }
+
+	template < class T, class... Rest >
+	inline uint32_t ArgsSize( const T &arg, const Rest &... rest ) { return EncodedSize( arg ) + ArgsSize( rest... ); }
+
+	inline void EncodeArgs( uint8_t * ) {}
+
+	template < class T, class... Rest >
+	inline void EncodeArgs( uint8_t *p, const T &arg, const Rest &... rest ) { EncodeArgs( Encode( p, arg ), rest... ); }
+
+	/** Reserves space for a message in the calling thread's buffer, or returns nullptr if there isn't any */
+	uint8_t *BeginMessage( const char *pchFormat, uint32_t unArgsSize );
+
+	/** Makes the message from BeginMessage visible to the log thread */
+	void EndMessage();
+
+	/** Takes the arguments of a call compiled out by DRIVERLOG_MIN_LEVEL, so they don't count as unused */
+	template < class... Args >
+	inline void Discard( const Args &... ) {}
+
+	template < class... Args >
+	inline void Write( const char *pchFormat, const Args &... args )
+	{
+		uint8_t *p = BeginMessage( pchFormat, ArgsSize( args... ) );
+		if ( !p )
+			return;
+		EncodeArgs( p, args... );
+		EndMessage();
+	}
+}
+
+/** Logs a printf style message to vrserver.txt. The format string must outlive the driver, so use a
+* literal. The arguments are copied and the message is formatted and logged later on a background
+* thread, so this never blocks on vrserver and can be called from time critical threads. */
+template < class... Args >
+inline void DriverLog( const char *pchFormat, const Args &... args )
+{
+#if DRIVERLOG_MIN_LEVEL <= DRIVERLOG_LEVEL_INFO
+	driverlog::Write( pchFormat, driverlog::Promote( args )... );
+#else
+	driverlog::Discard( pchFormat, args... );
+#endif
+}
+
+/** DriverLog for debug builds. Compiled out unless DRIVERLOG_MIN_LEVEL is DRIVERLOG_LEVEL_DEBUG. */
+template < class... Args >
+inline void DebugDriverLog( const char *pchFormat, const Args &... args )
+{
+#if DRIVERLOG_MIN_LEVEL <= DRIVERLOG_LEVEL_DEBUG
+	driverlog::Write( pchFormat, driverlog::Promote( args )... );
+#else
+	driverlog::Discard( pchFormat, args... );
+#endif
+}
+
+/** Blocks until every message logged before the call has been passed to vrserver */
+extern void DriverLogFlush();
+
+/** Flushes the log and stops its thread. Call this from IServerTrackedDeviceProvider::Cleanup so the
+* thread doesn't outlive the driver. The thread is never started again: anything logged afterwards is
+* formatted and passed to vrserver on the calling thread before DriverLog returns. */
+extern void DriverLogShutdown();
+
+extern void DriverLogGetStats( DriverLogStats_t *pStats );
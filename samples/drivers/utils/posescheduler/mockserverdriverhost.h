@@ -0,0 +1,74 @@
+//============ Copyright (c) Valve Corporation, All rights reserved. ============
+#pragma once
+
+#include <openvr_driver.h>
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// Purpose: A stand in for vrserver's IVRServerDriverHost, for running pose
+// code outside of SteamVR. Pass it to CPoseScheduler::SetServerDriverHost.
+// Records when each device's poses arrive so their timing can be checked.
+//-----------------------------------------------------------------------------
+class CMockServerDriverHost : public vr::IVRServerDriverHost
+{
+public:
+	struct DevicePoses_t
+	{
+		vr::DriverPose_t lastPose;
+		std::vector< std::chrono::steady_clock::time_point > vecArrivals;
+		std::vector< double > vecPoseTimeOffsets;	// how old the runtime was told each pose was, negated
+	};
+
+	bool TrackedDeviceAdded( const char *pchDeviceSerialNumber, vr::ETrackedDeviceClass eDeviceClass, vr::ITrackedDeviceServerDriver *pDriver ) override { return true; }
+
+	void TrackedDevicePoseUpdated( uint32_t unWhichDevice, const vr::DriverPose_t &newPose, uint32_t unPoseStructSize ) override
+	{
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		std::lock_guard< std::mutex > lock( m_mutex );
+		DevicePoses_t &device = m_mapDevices[ unWhichDevice ];
+		device.lastPose = newPose;
+		device.vecArrivals.push_back( now );
+		device.vecPoseTimeOffsets.push_back( newPose.poseTimeOffset );
+	}
+
+	void VsyncEvent( double vsyncTimeOffsetSeconds ) override {}
+	void VendorSpecificEvent( uint32_t unWhichDevice, vr::EVREventType eventType, const vr::VREvent_Data_t &eventData, double eventTimeOffset ) override {}
+	bool IsExiting() override { return false; }
+	bool PollNextEvent( vr::VREvent_t *pEvent, uint32_t uncbVREvent ) override { return false; }
+
+	void GetRawTrackedDevicePoses( float fPredictedSecondsFromNow, vr::TrackedDevicePose_t *pTrackedDevicePoseArray, uint32_t unTrackedDevicePoseArrayCount ) override
+	{
+		for ( uint32_t i = 0; i < unTrackedDevicePoseArrayCount; i++ )
+		{
+			vr::TrackedDevicePose_t &pose = pTrackedDevicePoseArray[ i ];
+			pose = {};
+			pose.mDeviceToAbsoluteTracking.m[ 0 ][ 0 ] = 1.f;
+			pose.mDeviceToAbsoluteTracking.m[ 1 ][ 1 ] = 1.f;
+			pose.mDeviceToAbsoluteTracking.m[ 2 ][ 2 ] = 1.f;
+			pose.bPoseIsValid = true;
+			pose.bDeviceIsConnected = true;
+			pose.eTrackingResult = vr::TrackingResult_Running_OK;
+		}
+	}
+
+	void RequestRestart( const char *pchLocalizedReason, const char *pchExecutableToStart, const char *pchArguments, const char *pchWorkingDirectory ) override {}
+	uint32_t GetFrameTimings( vr::Compositor_FrameTiming *pTiming, uint32_t nFrames ) override { return 0; }
+	void SetDisplayEyeToHead( uint32_t unWhichDevice, const vr::HmdMatrix34_t &eyeToHeadLeft, const vr::HmdMatrix34_t &eyeToHeadRight ) override {}
+	void SetDisplayProjectionRaw( uint32_t unWhichDevice, const vr::HmdRect2_t &eyeLeft, const vr::HmdRect2_t &eyeRight ) override {}
+	void SetRecommendedRenderTargetSize( uint32_t unWhichDevice, uint32_t nWidth, uint32_t nHeight ) override {}
+
+	/** A copy of everything received for a device so far */
+	DevicePoses_t GetDevicePoses( uint32_t unWhichDevice )
+	{
+		std::lock_guard< std::mutex > lock( m_mutex );
+		return m_mapDevices[ unWhichDevice ];
+	}
+
+private:
+	std::mutex m_mutex;
+	std::map< uint32_t, DevicePoses_t > m_mapDevices;
+};
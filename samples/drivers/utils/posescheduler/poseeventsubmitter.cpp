@@ -0,0 +1,183 @@
+//============ Copyright (c) Valve Corporation, All rights reserved. ============
+#include "poseeventsubmitter.h"
+
+#include <algorithm>
+
+
+CPoseEventStream::CPoseEventStream( CPoseEventSubmitter *pSubmitter, vr::TrackedDeviceIndex_t unDeviceIndex )
+	: m_pSubmitter( pSubmitter )
+	, m_unDeviceIndex( unDeviceIndex )
+	, m_unPushed( 0 )
+	, m_unSubmitted( 0 )
+	, m_unCoalesced( 0 )
+{
+}
+
+
+void CPoseEventStream::Push( const vr::DriverPose_t &pose, int64_t nSampleTimeNs )
+{
+	m_unPushed.fetch_add( 1, std::memory_order_relaxed );
+
+	Sample_t sample;
+	sample.pose = pose;
+	sample.nSampleTimeNs = nSampleTimeNs;
+	if ( m_slot.Push( sample ) )
+	{
+		// the thread hadn't sent the previous sample yet, and now never will
+		m_unCoalesced.fetch_add( 1, std::memory_order_relaxed );
+	}
+
+	m_pSubmitter->Wake();
+}
+
+
+void CPoseEventStream::GetStats( PoseEventStats_t *pStats ) const
+{
+	pStats->unPushed = m_unPushed.load( std::memory_order_relaxed );
+	pStats->unSubmitted = m_unSubmitted.load( std::memory_order_relaxed );
+	pStats->unCoalesced = m_unCoalesced.load( std::memory_order_relaxed );
+}
+
+
+CPoseEventSubmitter::CPoseEventSubmitter()
+	: m_pHost( nullptr )
+	, m_bWakePending( false )
+	, m_unThreadGeneration( 0 )
+{
+}
+
+
+CPoseEventSubmitter::~CPoseEventSubmitter()
+{
+	std::thread thread;
+	{
+		std::lock_guard< std::mutex > lock( m_mutex );
+		for ( CPoseEventStream *pStream : m_vecStreams )
+			delete pStream;
+		m_vecStreams.clear();
+		m_unThreadGeneration++;
+		thread = std::move( m_thread );
+	}
+	if ( thread.joinable() )
+	{
+		Wake();
+		thread.join();
+	}
+}
+
+
+CPoseEventStream *CPoseEventSubmitter::AddDevice( vr::TrackedDeviceIndex_t unDeviceIndex )
+{
+	std::lock_guard< std::mutex > lock( m_mutex );
+
+	CPoseEventStream *pStream = new CPoseEventStream( this, unDeviceIndex );
+	m_vecStreams.push_back( pStream );
+
+	if ( !m_thread.joinable() )
+	{
+		m_unThreadGeneration++;
+		m_thread = std::thread( &CPoseEventSubmitter::ThreadMain, this, m_unThreadGeneration );
+	}
+
+	return pStream;
+}
+
+
+void CPoseEventSubmitter::RemoveDevice( CPoseEventStream *pStream )
+{
+	if ( !pStream )
+		return;
+
+	std::thread thread;
+	{
+		// the thread only looks at streams with the lock held, so once we have it it's done with this one
+		std::lock_guard< std::mutex > lock( m_mutex );
+		m_vecStreams.erase( std::remove( m_vecStreams.begin(), m_vecStreams.end(), pStream ), m_vecStreams.end() );
+		delete pStream;
+
+		if ( m_vecStreams.empty() )
+		{
+			m_unThreadGeneration++;
+			thread = std::move( m_thread );
+		}
+	}
+
+	// wait for the thread to exit so it can't outlive the driver
+	if ( thread.joinable() )
+	{
+		Wake();
+		thread.join();
+	}
+}
+
+
+void CPoseEventSubmitter::SetServerDriverHost( vr::IVRServerDriverHost *pHost )
+{
+	std::lock_guard< std::mutex > lock( m_mutex );
+	m_pHost = pHost;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Wakes the thread. Only the first push after it goes idle takes the
+// lock; the ones after that see the wake already pending.
+//-----------------------------------------------------------------------------
+void CPoseEventSubmitter::Wake()
+{
+	if ( m_bWakePending.exchange( true ) )
+		return;
+
+	std::lock_guard< std::mutex > lock( m_wakeMutex );
+	m_wakeCondition.notify_one();
+}
+
+
+void CPoseEventSubmitter::ThreadMain( uint32_t unGeneration )
+{
+	struct PendingPose_t
+	{
+		vr::TrackedDeviceIndex_t unDeviceIndex;
+		vr::DriverPose_t pose;
+	};
+	std::vector< PendingPose_t > vecPending;
+
+	while ( true )
+	{
+		{
+			std::unique_lock< std::mutex > wakeLock( m_wakeMutex );
+			m_wakeCondition.wait( wakeLock, [ this ] { return m_bWakePending.exchange( false ); } );
+		}
+
+		std::lock_guard< std::mutex > lock( m_mutex );
+		if ( m_unThreadGeneration != unGeneration )
+			return;
+
+		// Take the newest sample from every device, then send them together
+		vecPending.clear();
+		for ( CPoseEventStream *pStream : m_vecStreams )
+		{
+			CPoseEventStream::Sample_t sample;
+			if ( !pStream->m_slot.Pop( &sample ) )
+				continue;
+
+			PendingPose_t pending;
+			pending.unDeviceIndex = pStream->m_unDeviceIndex;
+			pending.pose = sample.pose;
+			pending.pose.poseTimeOffset += ( double )( sample.nSampleTimeNs - GetPoseClockNs() ) / 1e9;
+			vecPending.push_back( pending );
+			pStream->m_unSubmitted.fetch_add( 1, std::memory_order_relaxed );
+		}
+
+		vr::IVRServerDriverHost *pHost = m_pHost ? m_pHost : vr::VRServerDriverHost();
+		for ( const PendingPose_t &pending : vecPending )
+			pHost->TrackedDevicePoseUpdated( pending.unDeviceIndex, pending.pose, sizeof( vr::DriverPose_t ) );
+	}
+}
+
+
+CPoseEventSubmitter &PoseEventSubmitter()
+{
+	// never destroyed, so a device deactivated from a static destructor can still remove itself
+	static CPoseEventSubmitter *s_pSubmitter = new CPoseEventSubmitter;
+	return *s_pSubmitter;
+}
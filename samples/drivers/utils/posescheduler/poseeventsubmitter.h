@@ -0,0 +1,100 @@
+//============ Copyright (c) Valve Corporation, All rights reserved. ============
+#pragma once
+
+#include "posescheduler.h"
+#include "poseslot.h"
+
+#include <openvr_driver.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct PoseEventStats_t
+{
+	uint64_t unPushed;			// samples handed to Push
+	uint64_t unSubmitted;		// poses sent to vrserver
+	uint64_t unCoalesced;		// samples replaced by a newer one before they were sent
+};
+
+class CPoseEventSubmitter;
+
+//-----------------------------------------------------------------------------
+// Purpose: One device's connection to the submitter. The device's data thread
+// pushes samples into it as they arrive.
+//-----------------------------------------------------------------------------
+class CPoseEventStream
+{
+public:
+	/** Hands a pose to the submitter without blocking. It replaces any earlier sample that hasn't
+	* been sent yet, so the newest sample is never the one lost. nSampleTimeNs is when the data was
+	* measured, on the GetPoseClockNs clock. It's turned into poseTimeOffset when the pose is sent,
+	* so the runtime predicts from the time of the sample rather than the time of the call. Only one
+	* thread may push to a stream. */
+	void Push( const vr::DriverPose_t &pose, int64_t nSampleTimeNs );
+
+	void GetStats( PoseEventStats_t *pStats ) const;
+
+private:
+	friend class CPoseEventSubmitter;
+
+	struct Sample_t
+	{
+		vr::DriverPose_t pose;
+		int64_t nSampleTimeNs;
+	};
+
+	CPoseEventStream( CPoseEventSubmitter *pSubmitter, vr::TrackedDeviceIndex_t unDeviceIndex );
+
+	CPoseEventSubmitter *m_pSubmitter;
+	vr::TrackedDeviceIndex_t m_unDeviceIndex;
+	CLatestValueSlot< Sample_t > m_slot;
+
+	std::atomic< uint64_t > m_unPushed;
+	std::atomic< uint64_t > m_unSubmitted;
+	std::atomic< uint64_t > m_unCoalesced;
+};
+
+//-----------------------------------------------------------------------------
+// Purpose: Sends poses to vrserver as soon as devices produce them, from one
+// thread shared by every device. If a device produces several samples before
+// the thread gets to it, only the newest is sent. Data threads never wait on
+// vrserver: a push only takes a lock to wake the thread when it's idle.
+//-----------------------------------------------------------------------------
+class CPoseEventSubmitter
+{
+public:
+	CPoseEventSubmitter();
+	~CPoseEventSubmitter();
+
+	/** The thread is started with the first device */
+	CPoseEventStream *AddDevice( vr::TrackedDeviceIndex_t unDeviceIndex );
+
+	/** Deletes the stream. Nothing may push to it once this is called. Removing the last device stops the thread. */
+	void RemoveDevice( CPoseEventStream *pStream );
+
+	/** Where poses are submitted. nullptr, the default, means vr::VRServerDriverHost(). */
+	void SetServerDriverHost( vr::IVRServerDriverHost *pHost );
+
+private:
+	friend class CPoseEventStream;
+
+	void Wake();
+	void ThreadMain( uint32_t unGeneration );
+
+	std::mutex m_mutex;		// held while sending, and for changes to the device list
+	std::vector< CPoseEventStream * > m_vecStreams;
+	vr::IVRServerDriverHost *m_pHost;
+
+	std::mutex m_wakeMutex;
+	std::condition_variable m_wakeCondition;
+	std::atomic< bool > m_bWakePending;
+
+	std::thread m_thread;
+	uint32_t m_unThreadGeneration;	// a thread exits once this no longer matches the value it was started with
+};
+
+/** The submitter shared by every device in the driver */
+CPoseEventSubmitter &PoseEventSubmitter();
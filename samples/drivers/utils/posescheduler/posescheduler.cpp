@@ -0,0 +1,332 @@
+//============ Copyright (c) Valve Corporation, All rights reserved. ============
+#include "posescheduler.h"
+
+#include <algorithm>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined( _WIN32 )
+#include <windows.h>
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#elif defined( __linux__ )
+#include <time.h>
+#endif
+
+// Devices due within this much of a wakeup are updated in it rather than waking again just after
+static const int64_t k_nBatchWindowNs = 200000;
+
+int64_t GetPoseClockNs()
+{
+#if defined( _WIN32 )
+	static LARGE_INTEGER s_frequency = []
+	{
+		LARGE_INTEGER frequency;
+		QueryPerformanceFrequency( &frequency );
+		return frequency;
+	}();
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter( &counter );
+	return ( int64_t )( ( double )counter.QuadPart * 1e9 / ( double )s_frequency.QuadPart );
+#elif defined( __linux__ )
+	timespec now;
+	clock_gettime( CLOCK_MONOTONIC, &now );
+	return ( int64_t )now.tv_sec * 1000000000 + now.tv_nsec;
+#else
+	return std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now().time_since_epoch() ).count();
+#endif
+}
+
+#if defined( _WIN32 )
+// Condition variable timeouts are rounded to the system timer tick on Windows, so the thread
+// waits on one until this long before a deadline and sleeps the rest on a high resolution timer,
+// which a new device can't interrupt. Elsewhere the whole wait is on the condition variable.
+static const int64_t k_nPreciseSleepNs = 2000000;
+
+//-----------------------------------------------------------------------------
+// Purpose: Sleeps until an absolute time from GetPoseClockNs
+//-----------------------------------------------------------------------------
+class CDeadlineTimer
+{
+public:
+	CDeadlineTimer()
+	{
+		// the high resolution timer is only available on Windows 10 1803 and up
+		m_hTimer = CreateWaitableTimerExW( nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS );
+		if ( !m_hTimer )
+			m_hTimer = CreateWaitableTimerExW( nullptr, nullptr, 0, TIMER_ALL_ACCESS );
+	}
+
+	~CDeadlineTimer()
+	{
+		if ( m_hTimer )
+			CloseHandle( m_hTimer );
+	}
+
+	void SleepUntil( int64_t nDeadlineNs )
+	{
+		int64_t nWaitNs = nDeadlineNs - GetPoseClockNs();
+		if ( nWaitNs <= 0 )
+			return;
+
+		// waitable timers only take absolute times on the system clock, so wait for the equivalent relative time
+		LARGE_INTEGER dueTime;
+		dueTime.QuadPart = -std::max< int64_t >( nWaitNs / 100, 1 );
+		if ( m_hTimer && SetWaitableTimer( m_hTimer, &dueTime, 0, nullptr, nullptr, FALSE ) )
+			WaitForSingleObject( m_hTimer, INFINITE );
+		else
+			std::this_thread::sleep_for( std::chrono::nanoseconds( nWaitNs ) );
+	}
+
+private:
+	HANDLE m_hTimer;
+};
+#else
+static const int64_t k_nPreciseSleepNs = 0;
+#endif
+
+
+CPoseScheduler::CPoseScheduler()
+	: m_hNextDevice( 1 )
+	, m_pHost( nullptr )
+	, m_unThreadGeneration( 0 )
+	, m_unWakeups( 0 )
+{
+}
+
+
+CPoseScheduler::~CPoseScheduler()
+{
+	std::thread thread;
+	{
+		std::lock_guard< std::mutex > lock( m_mutex );
+		m_vecDevices.clear();
+		m_unThreadGeneration++;
+		thread = std::move( m_thread );
+	}
+	m_cvWakeup.notify_all();
+	if ( thread.joinable() )
+		thread.join();
+}
+
+
+PoseSchedulerHandle_t CPoseScheduler::AddDevice( vr::TrackedDeviceIndex_t unDeviceIndex, std::chrono::microseconds period, PoseProducer_t producer )
+{
+	if ( !producer || period.count() <= 0 )
+		return k_unPoseSchedulerHandleInvalid;
+
+	std::lock_guard< std::mutex > lock( m_mutex );
+
+	Device_t device;
+	memset( device.rJitterHistogram, 0, sizeof( device.rJitterHistogram ) );
+	device.hDevice = m_hNextDevice++;
+	device.unDeviceIndex = unDeviceIndex;
+	device.nPeriodNs = std::chrono::duration_cast< std::chrono::nanoseconds >( period ).count();
+	device.nDeadlineNs = GetPoseClockNs();
+	device.producer = std::move( producer );
+	device.unUpdates = 0;
+	device.unOverruns = 0;
+	device.nJitterSumNs = 0;
+	device.nJitterMaxNs = 0;
+	m_vecDevices.push_back( std::move( device ) );
+
+	if ( !m_thread.joinable() )
+	{
+		m_unThreadGeneration++;
+		m_thread = std::thread( &CPoseScheduler::ThreadMain, this, m_unThreadGeneration );
+	}
+	else
+	{
+		// the thread may be asleep until another device's deadline, so wake it for this one's first update
+		m_unWakeups++;
+		m_cvWakeup.notify_all();
+	}
+
+	return m_vecDevices.back().hDevice;
+}
+
+
+void CPoseScheduler::RemoveDevice( PoseSchedulerHandle_t hDevice )
+{
+	std::thread thread;
+	{
+		// producers run with the lock held, so once we have it this device's producer is finished
+		std::lock_guard< std::mutex > lock( m_mutex );
+		m_vecDevices.erase( std::remove_if( m_vecDevices.begin(), m_vecDevices.end(), [ hDevice ]( const Device_t &device ) { return device.hDevice == hDevice; } ),
+			m_vecDevices.end() );
+
+		if ( m_vecDevices.empty() )
+		{
+			m_unThreadGeneration++;
+			thread = std::move( m_thread );
+		}
+
+		// either way the thread's next wakeup may have been for this device
+		m_unWakeups++;
+	}
+	m_cvWakeup.notify_all();
+
+	// wait for the thread to exit so it can't outlive the driver
+	if ( thread.joinable() )
+		thread.join();
+}
+
+
+void CPoseScheduler::AddStats( const Device_t &device, PoseSchedulerStats_t *pStats, uint64_t *pHistogram, int64_t *pJitterSumNs )
+{
+	pStats->unUpdates += device.unUpdates;
+	pStats->unOverruns += device.unOverruns;
+	pStats->flMaxJitterUs = std::max( pStats->flMaxJitterUs, ( double )device.nJitterMaxNs / 1000.0 );
+	*pJitterSumNs += device.nJitterSumNs;
+	for ( uint32_t i = 0; i <= k_unJitterBuckets; i++ )
+		pHistogram[ i ] += device.rJitterHistogram[ i ];
+}
+
+
+void CPoseScheduler::FinishStats( PoseSchedulerStats_t *pStats, const uint64_t *pHistogram, int64_t nJitterSumNs )
+{
+	if ( pStats->unUpdates == 0 )
+		return;
+
+	pStats->flMeanJitterUs = ( double )nJitterSumNs / 1000.0 / ( double )pStats->unUpdates;
+
+	uint64_t unBelow = 0;
+	uint64_t unP99 = ( pStats->unUpdates * 99 + 99 ) / 100;
+	uint32_t unBucket = 0;
+	for ( ; unBucket < k_unJitterBuckets; unBucket++ )
+	{
+		unBelow += pHistogram[ unBucket ];
+		if ( unBelow >= unP99 )
+			break;
+	}
+	pStats->flP99JitterUs = unBucket < k_unJitterBuckets ? ( double )( ( unBucket + 1 ) * k_nJitterBucketNs ) / 1000.0 : pStats->flMaxJitterUs;
+}
+
+
+bool CPoseScheduler::GetDeviceStats( PoseSchedulerHandle_t hDevice, PoseSchedulerStats_t *pStats )
+{
+	std::lock_guard< std::mutex > lock( m_mutex );
+	for ( const Device_t &device : m_vecDevices )
+	{
+		if ( device.hDevice != hDevice )
+			continue;
+
+		PoseSchedulerStats_t stats = {};
+		uint64_t rHistogram[ k_unJitterBuckets + 1 ] = {};
+		int64_t nJitterSumNs = 0;
+		AddStats( device, &stats, rHistogram, &nJitterSumNs );
+		FinishStats( &stats, rHistogram, nJitterSumNs );
+		*pStats = stats;
+		return true;
+	}
+	return false;
+}
+
+
+PoseSchedulerStats_t CPoseScheduler::GetStats()
+{
+	std::lock_guard< std::mutex > lock( m_mutex );
+
+	PoseSchedulerStats_t stats = {};
+	uint64_t rHistogram[ k_unJitterBuckets + 1 ] = {};
+	int64_t nJitterSumNs = 0;
+	for ( const Device_t &device : m_vecDevices )
+		AddStats( device, &stats, rHistogram, &nJitterSumNs );
+	FinishStats( &stats, rHistogram, nJitterSumNs );
+	return stats;
+}
+
+
+void CPoseScheduler::SetServerDriverHost( vr::IVRServerDriverHost *pHost )
+{
+	std::lock_guard< std::mutex > lock( m_mutex );
+	m_pHost = pHost;
+}
+
+
+void CPoseScheduler::ThreadMain( uint32_t unGeneration )
+{
+#if defined( _WIN32 )
+	CDeadlineTimer timer;
+#endif
+
+	struct PendingPose_t
+	{
+		vr::TrackedDeviceIndex_t unDeviceIndex;
+		vr::DriverPose_t pose;
+	};
+	std::vector< PendingPose_t > vecPending;
+
+	std::unique_lock< std::mutex > lock( m_mutex );
+	while ( true )
+	{
+		if ( m_unThreadGeneration != unGeneration || m_vecDevices.empty() )
+			return;
+
+		int64_t nNowNs = GetPoseClockNs();
+
+		// Produce every pose that's due before submitting any of them, so one slow
+		// producer doesn't hold back the submissions of the others
+		vecPending.clear();
+		for ( Device_t &device : m_vecDevices )
+		{
+			if ( device.nDeadlineNs > nNowNs + k_nBatchWindowNs )
+				continue;
+
+			int64_t nStartNs = GetPoseClockNs();
+			int64_t nJitterNs = llabs( nStartNs - device.nDeadlineNs );
+			device.unUpdates++;
+			device.nJitterSumNs += nJitterNs;
+			device.nJitterMaxNs = std::max( device.nJitterMaxNs, nJitterNs );
+			device.rJitterHistogram[ std::min< int64_t >( nJitterNs / k_nJitterBucketNs, k_unJitterBuckets ) ]++;
+
+			PendingPose_t pending;
+			pending.unDeviceIndex = device.unDeviceIndex;
+			if ( device.producer( &pending.pose ) )
+				vecPending.push_back( pending );
+
+			// Stay on the original grid. If we've fallen a whole period or more behind, skip those updates rather than bunching them up.
+			device.nDeadlineNs += device.nPeriodNs;
+			int64_t nAfterNs = GetPoseClockNs();
+			if ( device.nDeadlineNs <= nAfterNs )
+			{
+				int64_t nMissed = ( nAfterNs - device.nDeadlineNs ) / device.nPeriodNs + 1;
+				device.unOverruns += ( uint64_t )nMissed;
+				device.nDeadlineNs += nMissed * device.nPeriodNs;
+			}
+		}
+
+		vr::IVRServerDriverHost *pHost = m_pHost ? m_pHost : vr::VRServerDriverHost();
+		for ( const PendingPose_t &pending : vecPending )
+			pHost->TrackedDevicePoseUpdated( pending.unDeviceIndex, pending.pose, sizeof( vr::DriverPose_t ) );
+
+		int64_t nNextDeadlineNs = m_vecDevices.front().nDeadlineNs;
+		for ( const Device_t &device : m_vecDevices )
+			nNextDeadlineNs = std::min( nNextDeadlineNs, device.nDeadlineNs );
+
+		// Adding or removing a device wakes us early, so a new device's first update isn't held
+		// back by a sleep planned before it existed
+		uint64_t unWakeups = m_unWakeups;
+		std::chrono::steady_clock::time_point wakeTime = std::chrono::steady_clock::now() + std::chrono::nanoseconds( nNextDeadlineNs - k_nPreciseSleepNs - GetPoseClockNs() );
+		auto bWakeEarly = [ & ] { return m_unWakeups != unWakeups || m_unThreadGeneration != unGeneration; };
+#if defined( _WIN32 )
+		if ( !m_cvWakeup.wait_until( lock, wakeTime, bWakeEarly ) )
+		{
+			lock.unlock();
+			timer.SleepUntil( nNextDeadlineNs );
+			lock.lock();
+		}
+#else
+		m_cvWakeup.wait_until( lock, wakeTime, bWakeEarly );
+#endif
+	}
+}
+
+
+CPoseScheduler &PoseScheduler()
+{
+	// never destroyed, so a device deactivated from a static destructor can still remove itself
+	static CPoseScheduler *s_pScheduler = new CPoseScheduler;
+	return *s_pScheduler;
+}
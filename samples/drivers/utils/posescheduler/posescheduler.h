@@ -0,0 +1,93 @@
+//============ Copyright (c) Valve Corporation, All rights reserved. ============
+#pragma once
+
+#include <openvr_driver.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+typedef uint32_t PoseSchedulerHandle_t;
+static const PoseSchedulerHandle_t k_unPoseSchedulerHandleInvalid = 0;
+
+struct PoseSchedulerStats_t
+{
+	uint64_t unUpdates;			// times the producer was called
+	uint64_t unOverruns;		// deadlines skipped because an update ran more than a whole period late
+	double flMeanJitterUs;		// distance between when an update ran and its deadline
+	double flP99JitterUs;		// to the nearest 10us, up to 2ms
+	double flMaxJitterUs;
+};
+
+//-----------------------------------------------------------------------------
+// Purpose: Runs every device's pose updates from one thread. Each device has
+// its own period and is updated against absolute deadlines, so timing doesn't
+// drift with how long the updates take. Devices that are due at about the same
+// time are produced together and then submitted back to back.
+//-----------------------------------------------------------------------------
+class CPoseScheduler
+{
+public:
+	/** Fills in the device's pose. Return false to skip submitting it this time. Called on the scheduler thread. */
+	typedef std::function< bool( vr::DriverPose_t *pPose ) > PoseProducer_t;
+
+	CPoseScheduler();
+	~CPoseScheduler();
+
+	/** Starts updating a device. Its first update is right away, and the thread is started with the first device. */
+	PoseSchedulerHandle_t AddDevice( vr::TrackedDeviceIndex_t unDeviceIndex, std::chrono::microseconds period, PoseProducer_t producer );
+
+	/** Stops updating a device. Once this returns its producer isn't running and won't be called again.
+	* Removing the last device stops the thread. Don't call this from a producer. */
+	void RemoveDevice( PoseSchedulerHandle_t hDevice );
+
+	bool GetDeviceStats( PoseSchedulerHandle_t hDevice, PoseSchedulerStats_t *pStats );
+
+	/** Every device combined */
+	PoseSchedulerStats_t GetStats();
+
+	/** Where poses are submitted. nullptr, the default, means vr::VRServerDriverHost(). */
+	void SetServerDriverHost( vr::IVRServerDriverHost *pHost );
+
+private:
+	static const uint32_t k_unJitterBuckets = 200;
+	static const int64_t k_nJitterBucketNs = 10000;
+
+	struct Device_t
+	{
+		PoseSchedulerHandle_t hDevice;
+		vr::TrackedDeviceIndex_t unDeviceIndex;
+		int64_t nPeriodNs;
+		int64_t nDeadlineNs;
+		PoseProducer_t producer;
+
+		uint64_t unUpdates;
+		uint64_t unOverruns;
+		int64_t nJitterSumNs;
+		int64_t nJitterMaxNs;
+		uint32_t rJitterHistogram[ k_unJitterBuckets + 1 ];
+	};
+
+	void ThreadMain( uint32_t unGeneration );
+	static void AddStats( const Device_t &device, PoseSchedulerStats_t *pStats, uint64_t *pHistogram, int64_t *pJitterSumNs );
+	static void FinishStats( PoseSchedulerStats_t *pStats, const uint64_t *pHistogram, int64_t nJitterSumNs );
+
+	std::mutex m_mutex;
+	std::vector< Device_t > m_vecDevices;
+	PoseSchedulerHandle_t m_hNextDevice;
+	vr::IVRServerDriverHost *m_pHost;
+
+	std::thread m_thread;
+	uint32_t m_unThreadGeneration;	// a thread exits once this no longer matches the value it was started with
+	std::condition_variable m_cvWakeup;
+	uint64_t m_unWakeups;			// bumped to end the thread's sleep early when the devices change
+};
+
+/** The monotonic clock the scheduler runs on, in nanoseconds */
+int64_t GetPoseClockNs();
+
+/** The scheduler shared by every device in the driver */
+CPoseScheduler &PoseScheduler();
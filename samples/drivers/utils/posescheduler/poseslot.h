@@ -0,0 +1,52 @@
+//============ Copyright (c) Valve Corporation, All rights reserved. ============
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// Purpose: Hands the newest value from exactly one producer thread to exactly
+// one consumer thread. A push always lands, replacing a value the consumer
+// hasn't taken yet, so the consumer only ever sees the latest one. Neither
+// side ever blocks or allocates. Three buffers: one each for the two threads
+// to work in, and one in the middle that they swap with.
+//-----------------------------------------------------------------------------
+template < class T >
+class CLatestValueSlot
+{
+public:
+	CLatestValueSlot() : m_unBack( 0 ), m_unFront( 1 ), m_unMiddle( 2 ) {}
+
+	/** Producer only. Returns true if this replaced a value the consumer never took. */
+	bool Push( const T &item )
+	{
+		m_rgItems[ m_unBack ] = item;
+		uint32_t unOld = m_unMiddle.exchange( m_unBack | k_unFresh, std::memory_order_acq_rel );
+		m_unBack = unOld & k_unIndexMask;
+		return ( unOld & k_unFresh ) != 0;
+	}
+
+	/** Consumer only. Returns false if nothing was pushed since the last Pop. */
+	bool Pop( T *pItem )
+	{
+		// only a push can set the flag, so if it's set now it still will be at the exchange
+		if ( !( m_unMiddle.load( std::memory_order_relaxed ) & k_unFresh ) )
+			return false;
+
+		uint32_t unOld = m_unMiddle.exchange( m_unFront, std::memory_order_acq_rel );
+		m_unFront = unOld & k_unIndexMask;
+		*pItem = m_rgItems[ m_unFront ];
+		return true;
+	}
+
+private:
+	static const uint32_t k_unIndexMask = 3;
+	static const uint32_t k_unFresh = 4;	// set on the middle index when it holds a value not yet popped
+
+	T m_rgItems[ 3 ];
+
+	// each only touched by its own thread; on separate cache lines so the two threads don't contend for them
+	alignas( 64 ) uint32_t m_unBack;
+	alignas( 64 ) uint32_t m_unFront;
+	alignas( 64 ) std::atomic< uint32_t > m_unMiddle;
+};
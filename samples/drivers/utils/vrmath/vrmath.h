@@ -21,25 +21,65 @@ static const vr::HmdVector3_t HmdVector3_Down = { 0, -1.f, 0 };
 static const vr::HmdVector3_t HmdVector3_Forward = { 0, 0, -1.f };
 static const vr::HmdVector3_t HmdVector3_Backward = { 0, 0, 1.f };
 
-// 3x3 or 3x4 matrix
+// 3x3 or 3x4 matrix. Takes the root of the largest of 4w^2, 4x^2, 4y^2 and 4z^2 and gets the
+// other components from the off diagonal terms, which stays accurate for rotations near 180
+// degrees where w is close to zero. w is never negative.
 template < class T >
 vr::HmdQuaternion_t HmdQuaternion_FromMatrix( const T &matrix )
 {
 	vr::HmdQuaternion_t q{};
 
-	q.w = sqrt( fmax( 0, 1 + matrix.m[ 0 ][ 0 ] + matrix.m[ 1 ][ 1 ] + matrix.m[ 2 ][ 2 ] ) ) / 2;
-	q.x = sqrt( fmax( 0, 1 + matrix.m[ 0 ][ 0 ] - matrix.m[ 1 ][ 1 ] - matrix.m[ 2 ][ 2 ] ) ) / 2;
-	q.y = sqrt( fmax( 0, 1 - matrix.m[ 0 ][ 0 ] + matrix.m[ 1 ][ 1 ] - matrix.m[ 2 ][ 2 ] ) ) / 2;
-	q.z = sqrt( fmax( 0, 1 - matrix.m[ 0 ][ 0 ] - matrix.m[ 1 ][ 1 ] + matrix.m[ 2 ][ 2 ] ) ) / 2;
+	const double m00 = matrix.m[ 0 ][ 0 ], m11 = matrix.m[ 1 ][ 1 ], m22 = matrix.m[ 2 ][ 2 ];
+	const double dw = 1 + m00 + m11 + m22;
+	const double dx = 1 + m00 - m11 - m22;
+	const double dy = 1 - m00 + m11 - m22;
+	const double dz = 1 - m00 - m11 + m22;
 
-	q.x = copysign( q.x, matrix.m[ 2 ][ 1 ] - matrix.m[ 1 ][ 2 ] );
-	q.y = copysign( q.y, matrix.m[ 0 ][ 2 ] - matrix.m[ 2 ][ 0 ] );
-	q.z = copysign( q.z, matrix.m[ 1 ][ 0 ] - matrix.m[ 0 ][ 1 ] );
+	if ( dw >= dx && dw >= dy && dw >= dz )
+	{
+		const double s = sqrt( dw );
+		q.w = s / 2;
+		q.x = ( matrix.m[ 2 ][ 1 ] - matrix.m[ 1 ][ 2 ] ) / ( 2 * s );
+		q.y = ( matrix.m[ 0 ][ 2 ] - matrix.m[ 2 ][ 0 ] ) / ( 2 * s );
+		q.z = ( matrix.m[ 1 ][ 0 ] - matrix.m[ 0 ][ 1 ] ) / ( 2 * s );
+	}
+	else if ( dx >= dy && dx >= dz )
+	{
+		const double s = sqrt( dx );
+		q.w = ( matrix.m[ 2 ][ 1 ] - matrix.m[ 1 ][ 2 ] ) / ( 2 * s );
+		q.x = s / 2;
+		q.y = ( matrix.m[ 0 ][ 1 ] + matrix.m[ 1 ][ 0 ] ) / ( 2 * s );
+		q.z = ( matrix.m[ 0 ][ 2 ] + matrix.m[ 2 ][ 0 ] ) / ( 2 * s );
+	}
+	else if ( dy >= dz )
+	{
+		const double s = sqrt( dy );
+		q.w = ( matrix.m[ 0 ][ 2 ] - matrix.m[ 2 ][ 0 ] ) / ( 2 * s );
+		q.x = ( matrix.m[ 0 ][ 1 ] + matrix.m[ 1 ][ 0 ] ) / ( 2 * s );
+		q.y = s / 2;
+		q.z = ( matrix.m[ 1 ][ 2 ] + matrix.m[ 2 ][ 1 ] ) / ( 2 * s );
+	}
+	else
+	{
+		const double s = sqrt( dz );
+		q.w = ( matrix.m[ 1 ][ 0 ] - matrix.m[ 0 ][ 1 ] ) / ( 2 * s );
+		q.x = ( matrix.m[ 0 ][ 2 ] + matrix.m[ 2 ][ 0 ] ) / ( 2 * s );
+		q.y = ( matrix.m[ 1 ][ 2 ] + matrix.m[ 2 ][ 1 ] ) / ( 2 * s );
+		q.z = s / 2;
+	}
+
+	if ( q.w < 0 )
+	{
+		q.w = -q.w;
+		q.x = -q.x;
+		q.y = -q.y;
+		q.z = -q.z;
+	}
 
 	return q;
 }
 
-static vr::HmdQuaternion_t HmdQuaternion_FromSwingTwist( const vr::HmdVector2_t &swing, const float twist )
+inline vr::HmdQuaternion_t HmdQuaternion_FromSwingTwist( const vr::HmdVector2_t &swing, const float twist )
 {
 	vr::HmdQuaternion_t result{};
 
@@ -80,7 +120,7 @@ static vr::HmdQuaternion_t HmdQuaternion_FromSwingTwist( const vr::HmdVector2_t
 	return result;
 }
 
-static vr::HmdQuaternion_t HmdQuaternion_Normalize( const vr::HmdQuaternion_t &q )
+inline vr::HmdQuaternion_t HmdQuaternion_Normalize( const vr::HmdQuaternion_t &q )
 {
 	vr::HmdQuaternion_t result{};
 	double n = sqrt( q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w );
@@ -93,7 +133,7 @@ static vr::HmdQuaternion_t HmdQuaternion_Normalize( const vr::HmdQuaternion_t &q
 	return result;
 }
 
-static vr::HmdQuaternion_t HmdQuaternion_FromEulerAngles(double roll, double pitch, double yaw) {
+inline vr::HmdQuaternion_t HmdQuaternion_FromEulerAngles(double roll, double pitch, double yaw) {
   double cr = cos(roll * 0.5);
   double sr = sin(roll * 0.5);
   double cp = cos(pitch * 0.5);
@@ -119,12 +159,12 @@ void HmdQuaternion_ConvertQuaternion( const T &in_quaternion, Q &out_quaternion
 	out_quaternion.z = in_quaternion.z;
 }
 
-static vr::HmdQuaternion_t operator-( const vr::HmdQuaternion_t &q )
+inline vr::HmdQuaternion_t operator-( const vr::HmdQuaternion_t &q )
 {
 	return { q.w, -q.x, -q.y, -q.z };
 }
 
-static vr::HmdQuaternion_t operator*( const vr::HmdQuaternion_t &lhs, const vr::HmdQuaternion_t &rhs )
+inline vr::HmdQuaternion_t operator*( const vr::HmdQuaternion_t &lhs, const vr::HmdQuaternion_t &rhs )
 {
 	return {
 		lhs.w * rhs.w - lhs.x * rhs.x - lhs.y * rhs.y - lhs.z * rhs.z,
@@ -134,13 +174,13 @@ static vr::HmdQuaternion_t operator*( const vr::HmdQuaternion_t &lhs, const vr::
 	};
 }
 
-static vr::HmdVector3_t HmdVector3_From34Matrix( const vr::HmdMatrix34_t &matrix )
+inline vr::HmdVector3_t HmdVector3_From34Matrix( const vr::HmdMatrix34_t &matrix )
 {
 	return { matrix.m[ 0 ][ 3 ], matrix.m[ 1 ][ 3 ], matrix.m[ 2 ][ 3 ] };
 }
 
 
-static vr::HmdVector3_t operator+( const vr::HmdMatrix34_t &matrix, const vr::HmdVector3_t &vec )
+inline vr::HmdVector3_t operator+( const vr::HmdMatrix34_t &matrix, const vr::HmdVector3_t &vec )
 {
 	vr::HmdVector3_t vector{};
 
@@ -151,7 +191,7 @@ static vr::HmdVector3_t operator+( const vr::HmdMatrix34_t &matrix, const vr::Hm
 	return vector;
 }
 
-static vr::HmdVector3_t operator*( const vr::HmdMatrix33_t &matrix, const vr::HmdVector3_t &vec )
+inline vr::HmdVector3_t operator*( const vr::HmdMatrix33_t &matrix, const vr::HmdVector3_t &vec )
 {
 	vr::HmdVector3_t result{};
 
@@ -162,28 +202,28 @@ static vr::HmdVector3_t operator*( const vr::HmdMatrix33_t &matrix, const vr::Hm
 	return result;
 }
 
-static vr::HmdVector3_t operator-( const vr::HmdVector3_t &vec, const vr::HmdMatrix34_t &matrix )
+inline vr::HmdVector3_t operator-( const vr::HmdVector3_t &vec, const vr::HmdMatrix34_t &matrix )
 {
 	return { vec.v[ 0 ] - matrix.m[ 0 ][ 3 ], vec.v[ 1 ] - matrix.m[ 1 ][ 3 ], vec.v[ 2 ] - matrix.m[ 2 ][ 3 ] };
 }
 
-static vr::HmdVector3d_t operator+( const vr::HmdVector3d_t &vec1, const vr::HmdVector3d_t &vec2 )
+inline vr::HmdVector3d_t operator+( const vr::HmdVector3d_t &vec1, const vr::HmdVector3d_t &vec2 )
 {
 	return { vec1.v[ 0 ] + vec2.v[ 0 ], vec1.v[ 1 ] + vec2.v[ 1 ], vec1.v[ 2 ] + vec2.v[ 2 ] };
 }
 
 
-static vr::HmdVector3_t operator+( const vr::HmdVector3_t &vec1, const vr::HmdVector3_t &vec2 )
+inline vr::HmdVector3_t operator+( const vr::HmdVector3_t &vec1, const vr::HmdVector3_t &vec2 )
 {
 	return { vec1.v[ 0 ] + vec2.v[ 0 ], vec1.v[ 1 ] + vec2.v[ 1 ], vec1.v[ 2 ] + vec2.v[ 2 ] };
 }
 
-static vr::HmdVector3d_t operator-( const vr::HmdVector3d_t &vec1, const vr::HmdVector3d_t &vec2 )
+inline vr::HmdVector3d_t operator-( const vr::HmdVector3d_t &vec1, const vr::HmdVector3d_t &vec2 )
 {
 	return { vec1.v[ 0 ] - vec2.v[ 0 ], vec1.v[ 1 ] - vec2.v[ 1 ], vec1.v[ 2 ] - vec2.v[ 2 ] };
 }
 
-static vr::HmdVector3_t operator*( const vr::HmdVector3_t &vec, const vr::HmdQuaternion_t &q )
+inline vr::HmdVector3_t operator*( const vr::HmdVector3_t &vec, const vr::HmdQuaternion_t &q )
 {
 	const vr::HmdQuaternion_t qvec = { 0.0, vec.v[ 0 ], vec.v[ 1 ], vec.v[ 2 ] };
 
@@ -0,0 +1,458 @@
+//============ Copyright (c) Valve Corporation, All rights reserved. ============
+#pragma once
+
+// Batch versions of the vrmath functions, for drivers that update many poses or bones at once.
+// Data is laid out as structure of arrays: element i of a batch of quaternions is
+// { w[ i ], x[ i ], y[ i ], z[ i ] }. Everything is computed in float, and the elements that don't
+// fill a whole vector go through the same code one lane at a time, so an element's result doesn't
+// depend on where it sits in the batch.
+//
+// Uses AVX when the compiler targets it, otherwise SSE2 or NEON, otherwise plain scalar code.
+// Arrays don't need any particular alignment. Outputs may be the same arrays as the inputs.
+
+#include "vrmath.h"
+#include <stdint.h>
+
+#if defined( __AVX__ )
+#include <immintrin.h>
+#define VRMATH_BATCH_AVX 1
+#elif defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#include <emmintrin.h>
+#define VRMATH_BATCH_SSE2 1
+#elif defined( __aarch64__ ) || defined( _M_ARM64 )
+#include <arm_neon.h>
+#define VRMATH_BATCH_NEON 1
+#endif
+
+struct HmdQuaternionBatch_t
+{
+	float *w;
+	float *x;
+	float *y;
+	float *z;
+};
+
+struct HmdVector3Batch_t
+{
+	float *v[ 3 ];
+};
+
+// Only the rotation part of a 3x3 or 3x4 matrix is used
+struct HmdMatrix33Batch_t
+{
+	const float *m[ 3 ][ 3 ];
+};
+
+namespace vrmath_batch
+{
+	//-----------------------------------------------------------------------------
+	// Purpose: A single lane. Used for the scalar fallback and for the tail of
+	//			every batch.
+	//-----------------------------------------------------------------------------
+	struct FloatX1
+	{
+		typedef bool Mask;
+		static const uint32_t k_unLanes = 1;
+
+		static FloatX1 Load( const float *p ) { FloatX1 r; r.v = *p; return r; }
+		static FloatX1 Set( float f ) { FloatX1 r; r.v = f; return r; }
+		void Store( float *p ) const { *p = v; }
+
+		float v;
+	};
+
+	inline FloatX1 operator+( FloatX1 a, FloatX1 b ) { return FloatX1::Set( a.v + b.v ); }
+	inline FloatX1 operator-( FloatX1 a, FloatX1 b ) { return FloatX1::Set( a.v - b.v ); }
+	inline FloatX1 operator*( FloatX1 a, FloatX1 b ) { return FloatX1::Set( a.v * b.v ); }
+	inline FloatX1 operator/( FloatX1 a, FloatX1 b ) { return FloatX1::Set( a.v / b.v ); }
+	inline FloatX1 operator-( FloatX1 a ) { return FloatX1::Set( -a.v ); }
+	inline FloatX1 Sqrt( FloatX1 a ) { return FloatX1::Set( std::sqrt( a.v ) ); }
+	inline FloatX1 Max( FloatX1 a, FloatX1 b ) { return FloatX1::Set( a.v > b.v ? a.v : b.v ); }
+	inline FloatX1 Floor( FloatX1 a ) { return FloatX1::Set( std::floor( a.v ) ); }
+	inline bool CmpGt( FloatX1 a, FloatX1 b ) { return a.v > b.v; }
+	inline bool CmpGe( FloatX1 a, FloatX1 b ) { return a.v >= b.v; }
+	inline bool CmpLt( FloatX1 a, FloatX1 b ) { return a.v < b.v; }
+	inline bool CmpEq( FloatX1 a, FloatX1 b ) { return a.v == b.v; }
+	inline FloatX1 Select( bool bMask, FloatX1 a, FloatX1 b ) { return bMask ? a : b; }
+	inline bool AndNot( bool a, bool b ) { return a && !b; }
+
+#if defined( VRMATH_BATCH_AVX )
+	struct MaskX8 { __m256 v; };
+	inline MaskX8 operator&( MaskX8 a, MaskX8 b ) { MaskX8 r = { _mm256_and_ps( a.v, b.v ) }; return r; }
+	inline MaskX8 operator|( MaskX8 a, MaskX8 b ) { MaskX8 r = { _mm256_or_ps( a.v, b.v ) }; return r; }
+	inline MaskX8 operator!( MaskX8 a ) { MaskX8 r = { _mm256_xor_ps( a.v, _mm256_castsi256_ps( _mm256_set1_epi32( -1 ) ) ) }; return r; }
+	inline MaskX8 AndNot( MaskX8 a, MaskX8 b ) { MaskX8 r = { _mm256_andnot_ps( b.v, a.v ) }; return r; }
+
+	struct FloatX8
+	{
+		typedef MaskX8 Mask;
+		static const uint32_t k_unLanes = 8;
+
+		static FloatX8 Load( const float *p ) { FloatX8 r = { _mm256_loadu_ps( p ) }; return r; }
+		static FloatX8 Set( float f ) { FloatX8 r = { _mm256_set1_ps( f ) }; return r; }
+		void Store( float *p ) const { _mm256_storeu_ps( p, v ); }
+
+		__m256 v;
+	};
+
+	inline FloatX8 operator+( FloatX8 a, FloatX8 b ) { FloatX8 r = { _mm256_add_ps( a.v, b.v ) }; return r; }
+	inline FloatX8 operator-( FloatX8 a, FloatX8 b ) { FloatX8 r = { _mm256_sub_ps( a.v, b.v ) }; return r; }
+	inline FloatX8 operator*( FloatX8 a, FloatX8 b ) { FloatX8 r = { _mm256_mul_ps( a.v, b.v ) }; return r; }
+	inline FloatX8 operator/( FloatX8 a, FloatX8 b ) { FloatX8 r = { _mm256_div_ps( a.v, b.v ) }; return r; }
+	inline FloatX8 operator-( FloatX8 a ) { FloatX8 r = { _mm256_xor_ps( a.v, _mm256_set1_ps( -0.f ) ) }; return r; }
+	inline FloatX8 Sqrt( FloatX8 a ) { FloatX8 r = { _mm256_sqrt_ps( a.v ) }; return r; }
+	inline FloatX8 Max( FloatX8 a, FloatX8 b ) { FloatX8 r = { _mm256_max_ps( a.v, b.v ) }; return r; }
+	inline FloatX8 Floor( FloatX8 a ) { FloatX8 r = { _mm256_floor_ps( a.v ) }; return r; }
+	inline MaskX8 CmpGt( FloatX8 a, FloatX8 b ) { MaskX8 r = { _mm256_cmp_ps( a.v, b.v, _CMP_GT_OQ ) }; return r; }
+	inline MaskX8 CmpGe( FloatX8 a, FloatX8 b ) { MaskX8 r = { _mm256_cmp_ps( a.v, b.v, _CMP_GE_OQ ) }; return r; }
+	inline MaskX8 CmpLt( FloatX8 a, FloatX8 b ) { MaskX8 r = { _mm256_cmp_ps( a.v, b.v, _CMP_LT_OQ ) }; return r; }
+	inline MaskX8 CmpEq( FloatX8 a, FloatX8 b ) { MaskX8 r = { _mm256_cmp_ps( a.v, b.v, _CMP_EQ_OQ ) }; return r; }
+	inline FloatX8 Select( MaskX8 mask, FloatX8 a, FloatX8 b ) { FloatX8 r = { _mm256_or_ps( _mm256_and_ps( mask.v, a.v ), _mm256_andnot_ps( mask.v, b.v ) ) }; return r; }
+
+	typedef FloatX8 FloatXN;
+#elif defined( VRMATH_BATCH_SSE2 )
+	struct MaskX4 { __m128 v; };
+	inline MaskX4 operator&( MaskX4 a, MaskX4 b ) { MaskX4 r = { _mm_and_ps( a.v, b.v ) }; return r; }
+	inline MaskX4 operator|( MaskX4 a, MaskX4 b ) { MaskX4 r = { _mm_or_ps( a.v, b.v ) }; return r; }
+	inline MaskX4 operator!( MaskX4 a ) { MaskX4 r = { _mm_xor_ps( a.v, _mm_castsi128_ps( _mm_set1_epi32( -1 ) ) ) }; return r; }
+	inline MaskX4 AndNot( MaskX4 a, MaskX4 b ) { MaskX4 r = { _mm_andnot_ps( b.v, a.v ) }; return r; }
+
+	struct FloatX4
+	{
+		typedef MaskX4 Mask;
+		static const uint32_t k_unLanes = 4;
+
+		static FloatX4 Load( const float *p ) { FloatX4 r = { _mm_loadu_ps( p ) }; return r; }
+		static FloatX4 Set( float f ) { FloatX4 r = { _mm_set1_ps( f ) }; return r; }
+		void Store( float *p ) const { _mm_storeu_ps( p, v ); }
+
+		__m128 v;
+	};
+
+	inline FloatX4 operator+( FloatX4 a, FloatX4 b ) { FloatX4 r = { _mm_add_ps( a.v, b.v ) }; return r; }
+	inline FloatX4 operator-( FloatX4 a, FloatX4 b ) { FloatX4 r = { _mm_sub_ps( a.v, b.v ) }; return r; }
+	inline FloatX4 operator*( FloatX4 a, FloatX4 b ) { FloatX4 r = { _mm_mul_ps( a.v, b.v ) }; return r; }
+	inline FloatX4 operator/( FloatX4 a, FloatX4 b ) { FloatX4 r = { _mm_div_ps( a.v, b.v ) }; return r; }
+	inline FloatX4 operator-( FloatX4 a ) { FloatX4 r = { _mm_xor_ps( a.v, _mm_set1_ps( -0.f ) ) }; return r; }
+	inline FloatX4 Sqrt( FloatX4 a ) { FloatX4 r = { _mm_sqrt_ps( a.v ) }; return r; }
+	inline FloatX4 Max( FloatX4 a, FloatX4 b ) { FloatX4 r = { _mm_max_ps( a.v, b.v ) }; return r; }
+	inline MaskX4 CmpGt( FloatX4 a, FloatX4 b ) { MaskX4 r = { _mm_cmpgt_ps( a.v, b.v ) }; return r; }
+	inline MaskX4 CmpGe( FloatX4 a, FloatX4 b ) { MaskX4 r = { _mm_cmpge_ps( a.v, b.v ) }; return r; }
+	inline MaskX4 CmpLt( FloatX4 a, FloatX4 b ) { MaskX4 r = { _mm_cmplt_ps( a.v, b.v ) }; return r; }
+	inline MaskX4 CmpEq( FloatX4 a, FloatX4 b ) { MaskX4 r = { _mm_cmpeq_ps( a.v, b.v ) }; return r; }
+	inline FloatX4 Select( MaskX4 mask, FloatX4 a, FloatX4 b ) { FloatX4 r = { _mm_or_ps( _mm_and_ps( mask.v, a.v ), _mm_andnot_ps( mask.v, b.v ) ) }; return r; }
+
+	// SSE2 has no floor. Only called on values well inside the int range.
+	inline FloatX4 Floor( FloatX4 a )
+	{
+		FloatX4 t = { _mm_cvtepi32_ps( _mm_cvttps_epi32( a.v ) ) };
+		return Select( CmpGt( t, a ), t - FloatX4::Set( 1.f ), t );
+	}
+
+	typedef FloatX4 FloatXN;
+#elif defined( VRMATH_BATCH_NEON )
+	struct MaskX4 { uint32x4_t v; };
+	inline MaskX4 operator&( MaskX4 a, MaskX4 b ) { MaskX4 r = { vandq_u32( a.v, b.v ) }; return r; }
+	inline MaskX4 operator|( MaskX4 a, MaskX4 b ) { MaskX4 r = { vorrq_u32( a.v, b.v ) }; return r; }
+	inline MaskX4 operator!( MaskX4 a ) { MaskX4 r = { vmvnq_u32( a.v ) }; return r; }
+	inline MaskX4 AndNot( MaskX4 a, MaskX4 b ) { MaskX4 r = { vbicq_u32( a.v, b.v ) }; return r; }
+
+	struct FloatX4
+	{
+		typedef MaskX4 Mask;
+		static const uint32_t k_unLanes = 4;
+
+		static FloatX4 Load( const float *p ) { FloatX4 r = { vld1q_f32( p ) }; return r; }
+		static FloatX4 Set( float f ) { FloatX4 r = { vdupq_n_f32( f ) }; return r; }
+		void Store( float *p ) const { vst1q_f32( p, v ); }
+
+		float32x4_t v;
+	};
+
+	inline FloatX4 operator+( FloatX4 a, FloatX4 b ) { FloatX4 r = { vaddq_f32( a.v, b.v ) }; return r; }
+	inline FloatX4 operator-( FloatX4 a, FloatX4 b ) { FloatX4 r = { vsubq_f32( a.v, b.v ) }; return r; }
+	inline FloatX4 operator*( FloatX4 a, FloatX4 b ) { FloatX4 r = { vmulq_f32( a.v, b.v ) }; return r; }
+	inline FloatX4 operator/( FloatX4 a, FloatX4 b ) { FloatX4 r = { vdivq_f32( a.v, b.v ) }; return r; }
+	inline FloatX4 operator-( FloatX4 a ) { FloatX4 r = { vnegq_f32( a.v ) }; return r; }
+	inline FloatX4 Sqrt( FloatX4 a ) { FloatX4 r = { vsqrtq_f32( a.v ) }; return r; }
+	inline FloatX4 Max( FloatX4 a, FloatX4 b ) { FloatX4 r = { vmaxq_f32( a.v, b.v ) }; return r; }
+	inline FloatX4 Floor( FloatX4 a ) { FloatX4 r = { vrndmq_f32( a.v ) }; return r; }
+	inline MaskX4 CmpGt( FloatX4 a, FloatX4 b ) { MaskX4 r = { vcgtq_f32( a.v, b.v ) }; return r; }
+	inline MaskX4 CmpGe( FloatX4 a, FloatX4 b ) { MaskX4 r = { vcgeq_f32( a.v, b.v ) }; return r; }
+	inline MaskX4 CmpLt( FloatX4 a, FloatX4 b ) { MaskX4 r = { vcltq_f32( a.v, b.v ) }; return r; }
+	inline MaskX4 CmpEq( FloatX4 a, FloatX4 b ) { MaskX4 r = { vceqq_f32( a.v, b.v ) }; return r; }
+	inline FloatX4 Select( MaskX4 mask, FloatX4 a, FloatX4 b ) { FloatX4 r = { vbslq_f32( mask.v, a.v, b.v ) }; return r; }
+
+	typedef FloatX4 FloatXN;
+#endif
+
+	//-----------------------------------------------------------------------------
+	// Purpose: Sine and cosine of the same angle. Reduces to [-pi/4, pi/4] and
+	//			uses the cephes sinf/cosf polynomials, which are good to a couple of
+	//			ulp for angles in the few thousand radian range poses deal with.
+	//			Written once for every lane width so the vector and scalar paths
+	//			agree.
+	//-----------------------------------------------------------------------------
+	template < class F >
+	inline void SinCos( F x, F &sinOut, F &cosOut )
+	{
+		typedef typename F::Mask Mask;
+
+		// nearest multiple of pi/2, and which quadrant that puts x in
+		F j = Floor( x * F::Set( 0.636619772f ) + F::Set( 0.5f ) );
+		F quadrant = j - F::Set( 4.f ) * Floor( j * F::Set( 0.25f ) );
+
+		// pi/2 split in three so the reduction stays exact
+		F r = x - j * F::Set( 1.5703125f );
+		r = r - j * F::Set( 4.837512969970703125e-4f );
+		r = r - j * F::Set( 7.54978995489188216e-8f );
+
+		F r2 = r * r;
+		F s = ( ( F::Set( -1.9515295891e-4f ) * r2 + F::Set( 8.3321608736e-3f ) ) * r2 + F::Set( -1.6666654611e-1f ) ) * r2 * r + r;
+		F c = ( ( F::Set( 2.443315711809948e-5f ) * r2 + F::Set( -1.388731625493765e-3f ) ) * r2 + F::Set( 4.166664568298827e-2f ) ) * r2 * r2
+			- F::Set( 0.5f ) * r2 + F::Set( 1.f );
+
+		Mask bOdd = CmpEq( quadrant, F::Set( 1.f ) ) | CmpEq( quadrant, F::Set( 3.f ) );
+		Mask bNegateSin = CmpGe( quadrant, F::Set( 2.f ) );
+		Mask bNegateCos = CmpEq( quadrant, F::Set( 1.f ) ) | CmpEq( quadrant, F::Set( 2.f ) );
+
+		F sinR = Select( bOdd, c, s );
+		F cosR = Select( bOdd, s, c );
+		sinOut = Select( bNegateSin, -sinR, sinR );
+		cosOut = Select( bNegateCos, -cosR, cosR );
+	}
+
+	//-----------------------------------------------------------------------------
+	// Purpose: Runs a kernel over every element, a whole vector at a time where
+	//			possible and then one lane at a time for what's left.
+	//-----------------------------------------------------------------------------
+	template < class K >
+	inline void RunKernel( const K &kernel, uint32_t unCount )
+	{
+		uint32_t i = 0;
+#if defined( VRMATH_BATCH_AVX ) || defined( VRMATH_BATCH_SSE2 ) || defined( VRMATH_BATCH_NEON )
+		for ( ; i + FloatXN::k_unLanes <= unCount; i += FloatXN::k_unLanes )
+			kernel.template Run< FloatXN >( i );
+#endif
+		for ( ; i < unCount; i++ )
+			kernel.template Run< FloatX1 >( i );
+	}
+
+	template < class F >
+	inline void StoreQuaternion( const HmdQuaternionBatch_t &out, uint32_t i, F w, F x, F y, F z )
+	{
+		w.Store( out.w + i );
+		x.Store( out.x + i );
+		y.Store( out.y + i );
+		z.Store( out.z + i );
+	}
+
+	struct NormalizeKernel_t
+	{
+		HmdQuaternionBatch_t in;
+		HmdQuaternionBatch_t out;
+
+		template < class F >
+		void Run( uint32_t i ) const
+		{
+			F w = F::Load( in.w + i ), x = F::Load( in.x + i ), y = F::Load( in.y + i ), z = F::Load( in.z + i );
+			F n = Sqrt( w * w + x * x + y * y + z * z );
+			StoreQuaternion( out, i, w / n, x / n, y / n, z / n );
+		}
+	};
+
+	struct MultiplyKernel_t
+	{
+		HmdQuaternionBatch_t lhs;
+		HmdQuaternionBatch_t rhs;
+		HmdQuaternionBatch_t out;
+
+		template < class F >
+		void Run( uint32_t i ) const
+		{
+			F lw = F::Load( lhs.w + i ), lx = F::Load( lhs.x + i ), ly = F::Load( lhs.y + i ), lz = F::Load( lhs.z + i );
+			F rw = F::Load( rhs.w + i ), rx = F::Load( rhs.x + i ), ry = F::Load( rhs.y + i ), rz = F::Load( rhs.z + i );
+			StoreQuaternion( out, i,
+				lw * rw - lx * rx - ly * ry - lz * rz,
+				lw * rx + lx * rw + ly * rz - lz * ry,
+				lw * ry - lx * rz + ly * rw + lz * rx,
+				lw * rz + lx * ry - ly * rx + lz * rw );
+		}
+	};
+
+	struct RotateKernel_t
+	{
+		HmdVector3Batch_t in;
+		HmdQuaternionBatch_t q;
+		HmdVector3Batch_t out;
+
+		template < class F >
+		void Run( uint32_t i ) const
+		{
+			F vx = F::Load( in.v[ 0 ] + i ), vy = F::Load( in.v[ 1 ] + i ), vz = F::Load( in.v[ 2 ] + i );
+			F qw = F::Load( q.w + i ), qx = F::Load( q.x + i ), qy = F::Load( q.y + i ), qz = F::Load( q.z + i );
+
+			// v + w * t + u x t, with t = 2 * ( u x v ). Same as q * v * -q for a unit q.
+			F two = F::Set( 2.f );
+			F tx = two * ( qy * vz - qz * vy );
+			F ty = two * ( qz * vx - qx * vz );
+			F tz = two * ( qx * vy - qy * vx );
+
+			( vx + qw * tx + ( qy * tz - qz * ty ) ).Store( out.v[ 0 ] + i );
+			( vy + qw * ty + ( qz * tx - qx * tz ) ).Store( out.v[ 1 ] + i );
+			( vz + qw * tz + ( qx * ty - qy * tx ) ).Store( out.v[ 2 ] + i );
+		}
+	};
+
+	struct FromMatrixKernel_t
+	{
+		HmdMatrix33Batch_t in;
+		HmdQuaternionBatch_t out;
+
+		template < class F >
+		void Run( uint32_t i ) const
+		{
+			typedef typename F::Mask Mask;
+
+			F m00 = F::Load( in.m[ 0 ][ 0 ] + i ), m01 = F::Load( in.m[ 0 ][ 1 ] + i ), m02 = F::Load( in.m[ 0 ][ 2 ] + i );
+			F m10 = F::Load( in.m[ 1 ][ 0 ] + i ), m11 = F::Load( in.m[ 1 ][ 1 ] + i ), m12 = F::Load( in.m[ 1 ][ 2 ] + i );
+			F m20 = F::Load( in.m[ 2 ][ 0 ] + i ), m21 = F::Load( in.m[ 2 ][ 1 ] + i ), m22 = F::Load( in.m[ 2 ][ 2 ] + i );
+
+			// 4w^2, 4x^2, 4y^2 and 4z^2. Taking the root of the largest one keeps it well away
+			// from zero, and the other three components come from the off diagonal terms.
+			F one = F::Set( 1.f );
+			F dw = one + m00 + m11 + m22;
+			F dx = one + m00 - m11 - m22;
+			F dy = one - m00 + m11 - m22;
+			F dz = one - m00 - m11 + m22;
+
+			Mask bW = CmpGe( dw, Max( dx, Max( dy, dz ) ) );
+			Mask bX = AndNot( CmpGe( dx, Max( dy, dz ) ), bW );
+			Mask bY = AndNot( CmpGe( dy, dz ), bW | bX );
+			Mask bZ = !( bW | bX | bY );
+
+			F d = Select( bW, dw, Select( bX, dx, Select( bY, dy, dz ) ) );
+			F s = Sqrt( d );
+			F half = F::Set( 0.5f ) * s;
+			F inv = F::Set( 0.5f ) / s;
+
+			F a = m21 - m12;		// 4wx
+			F b = m02 - m20;		// 4wy
+			F c = m10 - m01;		// 4wz
+			F e = m01 + m10;		// 4xy
+			F f = m02 + m20;		// 4xz
+			F g = m12 + m21;		// 4yz
+
+			F w = Select( bW, half, Select( bX, a, Select( bY, b, c ) ) * inv );
+			F x = Select( bX, half, Select( bW, a, Select( bY, e, f ) ) * inv );
+			F y = Select( bY, half, Select( bW, b, Select( bX, e, g ) ) * inv );
+			F z = Select( bZ, half, Select( bW, c, Select( bX, f, g ) ) * inv );
+
+			// same sign convention as HmdQuaternion_FromMatrix
+			Mask bFlip = CmpLt( w, F::Set( 0.f ) );
+			StoreQuaternion( out, i, Select( bFlip, -w, w ), Select( bFlip, -x, x ), Select( bFlip, -y, y ), Select( bFlip, -z, z ) );
+		}
+	};
+
+	struct FromEulerAnglesKernel_t
+	{
+		const float *pRoll;
+		const float *pPitch;
+		const float *pYaw;
+		HmdQuaternionBatch_t out;
+
+		template < class F >
+		void Run( uint32_t i ) const
+		{
+			F half = F::Set( 0.5f );
+			F sr, cr, sp, cp, sy, cy;
+			SinCos( F::Load( pRoll + i ) * half, sr, cr );
+			SinCos( F::Load( pPitch + i ) * half, sp, cp );
+			SinCos( F::Load( pYaw + i ) * half, sy, cy );
+
+			StoreQuaternion( out, i,
+				cr * cp * cy + sr * sp * sy,
+				cr * sp * cy + sr * cp * sy,
+				cr * cp * sy - sr * sp * cy,
+				sr * cp * cy - cr * sp * sy );
+		}
+	};
+
+	struct FromSwingTwistKernel_t
+	{
+		const float *pSwingX;
+		const float *pSwingY;
+		const float *pTwist;
+		HmdQuaternionBatch_t out;
+
+		template < class F >
+		void Run( uint32_t i ) const
+		{
+			typedef typename F::Mask Mask;
+
+			F swingX = F::Load( pSwingX + i ), swingY = F::Load( pSwingY + i );
+			F half = F::Set( 0.5f );
+
+			F swingSquared = swingX * swingX + swingY * swingY;
+			Mask bSwing = CmpGt( swingSquared, F::Set( 0.f ) );
+			F theta = Select( bSwing, Sqrt( swingSquared ), F::Set( 1.f ) );
+
+			F sinSwing, cosSwing, sinTwist, cosTwist;
+			SinCos( theta * half, sinSwing, cosSwing );
+			SinCos( F::Load( pTwist + i ) * half, sinTwist, cosTwist );
+
+			// with no swing, sin( theta / 2 ) / theta tends to 1/2
+			cosSwing = Select( bSwing, cosSwing, F::Set( 1.f ) );
+			F sinSwingOverTheta = Select( bSwing, sinSwing / theta, half );
+
+			StoreQuaternion( out, i,
+				cosSwing * cosTwist,
+				cosSwing * sinTwist,
+				( swingY * cosTwist - swingX * sinTwist ) * sinSwingOverTheta,
+				( swingX * cosTwist + swingY * sinTwist ) * sinSwingOverTheta );
+		}
+	};
+}
+
+/** Normalizes each quaternion. out may be in. */
+inline void HmdQuaternion_NormalizeBatch( const HmdQuaternionBatch_t &in, const HmdQuaternionBatch_t &out, uint32_t unCount )
+{
+	vrmath_batch::NormalizeKernel_t kernel = { in, out };
+	vrmath_batch::RunKernel( kernel, unCount );
+}
+
+/** out[ i ] = lhs[ i ] * rhs[ i ]. out may be either input. */
+inline void HmdQuaternion_MultiplyBatch( const HmdQuaternionBatch_t &lhs, const HmdQuaternionBatch_t &rhs, const HmdQuaternionBatch_t &out, uint32_t unCount )
+{
+	vrmath_batch::MultiplyKernel_t kernel = { lhs, rhs, out };
+	vrmath_batch::RunKernel( kernel, unCount );
+}
+
+/** Rotates each vector by the matching unit quaternion, like operator*( HmdVector3_t, HmdQuaternion_t ). out may be in. */
+inline void HmdVector3_RotateBatch( const HmdVector3Batch_t &in, const HmdQuaternionBatch_t &q, const HmdVector3Batch_t &out, uint32_t unCount )
+{
+	vrmath_batch::RotateKernel_t kernel = { in, q, out };
+	vrmath_batch::RunKernel( kernel, unCount );
+}
+
+/** Batch HmdQuaternion_FromMatrix. Picks the best conditioned of the four ways to extract the
+* quaternion per element, so rotations near 180 degrees keep full precision. w is never negative. */
+inline void HmdQuaternion_FromMatrixBatch( const HmdMatrix33Batch_t &in, const HmdQuaternionBatch_t &out, uint32_t unCount )
+{
+	vrmath_batch::FromMatrixKernel_t kernel = { in, out };
+	vrmath_batch::RunKernel( kernel, unCount );
+}
+
+/** Batch HmdQuaternion_FromEulerAngles, in radians */
+inline void HmdQuaternion_FromEulerAnglesBatch( const float *pRoll, const float *pPitch, const float *pYaw, const HmdQuaternionBatch_t &out, uint32_t unCount )
+{
+	vrmath_batch::FromEulerAnglesKernel_t kernel = { pRoll, pPitch, pYaw, out };
+	vrmath_batch::RunKernel( kernel, unCount );
+}
+
+/** Batch HmdQuaternion_FromSwingTwist, with the two swing components in separate arrays */
+inline void HmdQuaternion_FromSwingTwistBatch( const float *pSwingX, const float *pSwingY, const float *pTwist, const HmdQuaternionBatch_t &out, uint32_t unCount )
+{
+	vrmath_batch::FromSwingTwistKernel_t kernel = { pSwingX, pSwingY, pTwist, out };
+	vrmath_batch::RunKernel( kernel, unCount );
+}
@@ -13,6 +13,7 @@
 #include <cstdlib>
 
 #include <openvr.h>
+#include <openvr_properties.h>
 
 #include "shared/lodepng.h"
 #include "shared/Matrices.h"
@@ -365,15 +366,8 @@ CMainApplication::~CMainApplication()
 //-----------------------------------------------------------------------------
 std::string GetTrackedDeviceString( vr::IVRSystem *pHmd, vr::TrackedDeviceIndex_t unDevice, vr::TrackedDeviceProperty prop, vr::TrackedPropertyError *peError = NULL )
 {
-	uint32_t unRequiredBufferLen = pHmd->GetStringTrackedDeviceProperty( unDevice, prop, NULL, 0, peError );
-	if( unRequiredBufferLen == 0 )
-		return "";
-
-	char *pchBuffer = new char[ unRequiredBufferLen ];
-	unRequiredBufferLen = pHmd->GetStringTrackedDeviceProperty( unDevice, prop, pchBuffer, unRequiredBufferLen, peError );
-	std::string sResult = pchBuffer;
-	delete [] pchBuffer;
-	return sResult;
+	// one query unless the string is unusually long
+	return vr::GetTrackedDeviceStringProperty( pHmd, unDevice, prop, peError );
 }
 
 //-----------------------------------------------------------------------------
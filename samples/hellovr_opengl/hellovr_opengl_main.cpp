@@ -17,6 +17,7 @@
 #include <cstdlib>
 
 #include <openvr.h>
+#include <openvr_properties.h>
 
 #include "shared/lodepng.h"
 #include "shared/Matrices.h"
@@ -415,15 +416,8 @@ CMainApplication::~CMainApplication()
 //-----------------------------------------------------------------------------
 std::string GetTrackedDeviceString( vr::TrackedDeviceIndex_t unDevice, vr::TrackedDeviceProperty prop, vr::TrackedPropertyError *peError = NULL )
 {
-	uint32_t unRequiredBufferLen = vr::VRSystem()->GetStringTrackedDeviceProperty( unDevice, prop, NULL, 0, peError );
-	if( unRequiredBufferLen == 0 )
-		return "";
-
-	char *pchBuffer = new char[ unRequiredBufferLen ];
-	unRequiredBufferLen = vr::VRSystem()->GetStringTrackedDeviceProperty( unDevice, prop, pchBuffer, unRequiredBufferLen, peError );
-	std::string sResult = pchBuffer;
-	delete [] pchBuffer;
-	return sResult;
+	// one query unless the string is unusually long
+	return vr::GetTrackedDeviceStringProperty( vr::VRSystem(), unDevice, prop, peError );
 }
 
 
@@ -14,6 +14,7 @@
 #include <cstdlib>
 #include <inttypes.h>
 #include <openvr.h>
+#include <openvr_properties.h>
 #include <deque>
 
 #include "shared/lodepng.h"
@@ -571,15 +572,8 @@ CMainApplication::~CMainApplication()
 //-----------------------------------------------------------------------------
 std::string GetTrackedDeviceString( vr::IVRSystem *pHmd, vr::TrackedDeviceIndex_t unDevice, vr::TrackedDeviceProperty prop, vr::TrackedPropertyError *peError = NULL )
 {
-	uint32_t unRequiredBufferLen = pHmd->GetStringTrackedDeviceProperty( unDevice, prop, NULL, 0, peError );
-	if( unRequiredBufferLen == 0 )
-		return "";
-
-	char *pchBuffer = new char[ unRequiredBufferLen ];
-	unRequiredBufferLen = pHmd->GetStringTrackedDeviceProperty( unDevice, prop, pchBuffer, unRequiredBufferLen, peError );
-	std::string sResult = pchBuffer;
-	delete [] pchBuffer;
-	return sResult;
+	// one query unless the string is unusually long
+	return vr::GetTrackedDeviceStringProperty( pHmd, unDevice, prop, peError );
 }
 
 //-----------------------------------------------------------------------------
@@ -1,6 +1,7 @@
 //========= Copyright Valve Corporation ============//
 
 #include "hmd_opencv_sandbox.h"
+#include <openvr_properties.h>
 #include "chew.h"
 
 CMainApplication * APP;
@@ -118,15 +119,8 @@ CMainApplication::~CMainApplication()
 //-----------------------------------------------------------------------------
 std::string GetTrackedDeviceString( vr::TrackedDeviceIndex_t unDevice, vr::TrackedDeviceProperty prop, vr::TrackedPropertyError *peError = NULL )
 {
-	uint32_t unRequiredBufferLen = vr::VRSystem()->GetStringTrackedDeviceProperty( unDevice, prop, NULL, 0, peError );
-	if( unRequiredBufferLen == 0 )
-		return "";
-
-	char *pchBuffer = new char[ unRequiredBufferLen ];
-	unRequiredBufferLen = vr::VRSystem()->GetStringTrackedDeviceProperty( unDevice, prop, pchBuffer, unRequiredBufferLen, peError );
-	std::string sResult = pchBuffer;
-	delete [] pchBuffer;
-	return sResult;
+	// one query unless the string is unusually long
+	return vr::GetTrackedDeviceStringProperty( vr::VRSystem(), unDevice, prop, peError );
 }
 
 
@@ -1440,12 +1440,7 @@ private:
 
   bool readToken(Token& token);
   void skipSpaces();
-  bool match(Location pattern, int patternLength);
-  bool readComment();
-  bool readCStyleComment();
-  bool readCppStyleComment();
-  bool readString();
-  void readNumber();
+  void collectComment(Location commentBegin);
   bool readValue();
   bool readObject(Token& token);
   bool readArray(Token& token);
@@ -0,0 +1,147 @@
+//========= Copyright Valve Corporation ============//
+// Buffered JSON output for jsoncpp values, byte-identical to the writers in the amalgamation.
+#pragma once
+
+#include <json/json.h>
+#include <string>
+#include <stddef.h>
+
+namespace Json {
+
+/** \brief Writes a Value into a reusable buffer instead of through a chain of
+ * temporary strings.
+ *
+ * A default-constructed BufferedWriter produces exactly the same bytes as a
+ * default FastWriter; one constructed from a StreamWriterBuilder produces
+ * exactly what that builder's StreamWriter would. The output buffer is kept
+ * between calls and grows geometrically, so writing documents of a similar
+ * size again does not allocate, and strings are checked for characters that
+ * need escaping 16 bytes at a time and copied in one piece when there are
+ * none.
+ *
+ * Besides returning a string, the document can be written straight into
+ * caller memory sized with measure() (e.g. a mapped file), to a file
+ * descriptor, or to any Sink, a chunk at a time.
+ *
+ * Usage:
+ * \code
+ * Json::StreamWriterBuilder builder;
+ * Json::BufferedWriter writer(builder);
+ * std::string const& document = writer.write(root);
+ * \endcode
+ */
+class BufferedWriter {
+public:
+  /** \brief Receives the output of write(Value const&, Sink&) in pieces.
+   */
+  class Sink {
+  public:
+    virtual ~Sink();
+    /// Consume size bytes. Return false to abandon the rest of the document.
+    virtual bool write(char const* data, size_t size) = 0;
+  };
+
+  /// Same output as a default FastWriter.
+  BufferedWriter();
+  /** Same output as builder.newStreamWriter().
+   * \throw std::exception for the settings newStreamWriter() rejects.
+   */
+  explicit BufferedWriter(StreamWriterBuilder const& builder);
+
+  /// Same as FastWriter::enableYAMLCompatibility().
+  void enableYAMLCompatibility();
+  /// Same as FastWriter::dropNullPlaceholders().
+  void dropNullPlaceholders();
+  /// Same as FastWriter::omitEndingLineFeed().
+  void omitEndingLineFeed();
+
+  /** \brief Serialize root into the writer's own buffer.
+   * \return The document, valid until the next call on this writer.
+   */
+  std::string const& write(Value const& root);
+
+  /** \brief Serialize root into caller memory.
+   * Works like snprintf: at most capacity bytes are stored and the size of the
+   * whole document is returned. No terminating zero is added.
+   */
+  size_t write(Value const& root, char* dest, size_t capacity);
+
+  /// Size in bytes of the document for root.
+  size_t measure(Value const& root) { return write(root, NULL, 0); }
+
+  /** \brief Serialize root to sink, passing on the buffer each time it fills.
+   * \return false if sink.write() failed.
+   */
+  bool write(Value const& root, Sink& sink);
+
+  /** \brief Serialize root to an open file descriptor.
+   * \return false if a write to fd failed.
+   */
+  bool writeToFd(Value const& root, int fd);
+
+  /// Buffer size used by write(root, sink) and writeToFd(), 64 KiB by default.
+  void setChunkSize(size_t size);
+
+private:
+  BufferedWriter(BufferedWriter const&);
+  void operator=(BufferedWriter const&);
+
+  // Where the document goes.
+  enum Target {
+    targetBuffer, ///< buffer_, grown as needed
+    targetMemory, ///< caller memory, the rest is only counted
+    targetSink    ///< buffer_ as a fixed chunk, flushed to sink_
+  };
+
+  void beginOutput(Target target, char* dest, size_t capacity, Sink* sink);
+  size_t endOutput();
+  void writeRoot(Value const& root);
+  void writeFastValue(Value const& value);
+  void writeStyledValue(Value const& value);
+  void writeStyledArray(Value const& value);
+  bool writeSingleLineArray(Value const& value);
+  void writeScalar(Value const& value);
+  size_t formatScalar(Value const& value, char* dest, size_t capacity);
+  void writeQuoted(char const* str, size_t length);
+  void writeIndent();
+  void writeWithIndent(char const* text, size_t length);
+  void writeCommentBeforeValue(Value const& root);
+  void writeCommentAfterValueOnSameLine(Value const& root);
+
+  void put(char c) {
+    if (cursor_ != limit_)
+      *cursor_++ = c;
+    else
+      overflow(&c, 1);
+  }
+  void put(char const* data, size_t size);
+  void put(std::string const& text) { put(text.data(), text.size()); }
+  void overflow(char const* data, size_t size);
+
+  // Settings, with the same meaning as in the builder's StreamWriter.
+  bool styled_;
+  bool comments_;
+  bool useSpecialFloats_;
+  unsigned int precision_;
+  std::string indentation_;
+  std::string colonSymbol_;
+  std::string nullSymbol_;
+  std::string endingLineFeedSymbol_;
+  size_t chunkSize_;
+
+  // Styled layout state.
+  std::string indentString_;
+  bool indented_;
+
+  // Output state.
+  Target target_;
+  std::string buffer_;
+  char* begin_;
+  char* cursor_;
+  char* limit_;
+  size_t flushed_; ///< bytes before begin_: sent to sink_ or past capacity
+  Sink* sink_;
+  bool failed_;
+};
+
+} // namespace Json
@@ -0,0 +1,329 @@
+//========= Copyright Valve Corporation ============//
+// Read-only JSON documents whose nodes and strings all live in one arena. Used for config
+// files that are parsed, queried and thrown away; Json::Value remains the editable form.
+#pragma once
+
+#include <json/json.h>
+#include <string>
+#include <vector>
+#include <iterator>
+#include <cstddef>
+
+namespace Json {
+
+/** \brief Bump allocator that owns every node and string of a FlatDocument.
+ *
+ * Memory is carved out of large blocks and is only given back when the arena
+ * is cleared or destroyed, so a whole document is released in one step no
+ * matter how many values it holds.
+ */
+class FlatArena {
+public:
+  FlatArena();
+  ~FlatArena();
+
+  /// Return size bytes aligned to align (a power of two). Never returns NULL.
+  void* allocate(size_t size, size_t align = 8);
+  /// Make sure the next size bytes can be handed out from a single block.
+  void reserve(size_t size);
+  /// Release every block.
+  void clear();
+
+  /// Bytes handed out by allocate() since the last clear().
+  size_t bytesUsed() const { return used_; }
+  /// Bytes held in blocks since the last clear().
+  size_t bytesReserved() const { return reserved_; }
+
+private:
+  FlatArena(FlatArena const&);
+  void operator=(FlatArena const&);
+
+  struct Block {
+    Block* next_;
+    size_t size_;
+  };
+  void addBlock(size_t minSize);
+
+  Block* head_;
+  char* cursor_;
+  char* limit_;
+  size_t used_;
+  size_t reserved_;
+};
+
+/** \brief Read-only JSON value whose storage lives in a FlatDocument's arena.
+ *
+ * Arrays are contiguous runs of FlatValue and objects are arrays of members
+ * sorted by key (in the same order Value iterates them), so lookups are a
+ * binary search over adjacent memory. Strings are null-terminated copies in
+ * the arena.
+ *
+ * The const accessors mirror those of #Value and behave the same way for the
+ * same document, including the conversions done by the as*() methods, so
+ * read-only code only needs to change the type it takes. Use toValue() to get
+ * a mutable deep copy.
+ *
+ * A FlatValue is only valid while the FlatDocument it came from is alive and
+ * has not been re-parsed.
+ */
+class FlatValue {
+  friend class FlatDocument;
+  friend class FlatBuilder;
+
+public:
+  typedef std::vector<std::string> Members;
+  typedef Json::UInt UInt;
+  typedef Json::Int Int;
+#if defined(JSON_HAS_INT64)
+  typedef Json::UInt64 UInt64;
+  typedef Json::Int64 Int64;
+#endif // defined(JSON_HAS_INT64)
+  typedef Json::LargestInt LargestInt;
+  typedef Json::LargestUInt LargestUInt;
+  typedef Json::ArrayIndex ArrayIndex;
+
+  class const_iterator;
+  typedef const_iterator iterator;
+
+  /// Shared null value, returned for missing members and out of range indices.
+  static const FlatValue& nullRef;
+
+  /// Construct a null value.
+  FlatValue();
+
+  ValueType type() const { return static_cast<ValueType>(type_); }
+
+  const char* asCString() const; ///< Embedded zeroes could cause you trouble!
+  std::string asString() const; ///< Embedded zeroes are possible.
+  /** Get raw char* of string-value.
+   *  \return false if !string. (Seg-fault if str or end are NULL.)
+   */
+  bool getString(char const** begin, char const** end) const;
+  Int asInt() const;
+  UInt asUInt() const;
+#if defined(JSON_HAS_INT64)
+  Int64 asInt64() const;
+  UInt64 asUInt64() const;
+#endif // if defined(JSON_HAS_INT64)
+  LargestInt asLargestInt() const;
+  LargestUInt asLargestUInt() const;
+  float asFloat() const;
+  double asDouble() const;
+  bool asBool() const;
+
+  bool isNull() const { return type_ == nullValue; }
+  bool isBool() const { return type_ == booleanValue; }
+  bool isInt() const;
+  bool isInt64() const;
+  bool isUInt() const;
+  bool isUInt64() const;
+  bool isIntegral() const;
+  bool isDouble() const;
+  bool isNumeric() const;
+  bool isString() const { return type_ == stringValue; }
+  bool isArray() const { return type_ == arrayValue; }
+  bool isObject() const { return type_ == objectValue; }
+
+  bool isConvertibleTo(ValueType other) const;
+
+  /// Number of values in array or object
+  ArrayIndex size() const;
+
+  /// \brief Return true if empty array, empty object, or null;
+  /// otherwise, false.
+  bool empty() const;
+
+  /// Return isNull()
+  bool operator!() const { return isNull(); }
+
+  /// Access an array element (zero based index ), or nullRef if out of range.
+  /// \pre type() is arrayValue or nullValue
+  const FlatValue& operator[](ArrayIndex index) const;
+  /// Access an array element (zero based index ), or nullRef if out of range.
+  /// \pre type() is arrayValue or nullValue
+  const FlatValue& operator[](int index) const;
+  /// If the array contains at least index+1 elements, returns the element
+  /// value, otherwise returns defaultValue.
+  /// \note deep copy
+  Value get(ArrayIndex index, const Value& defaultValue) const;
+  /// Return true if index < size().
+  bool isValidIndex(ArrayIndex index) const { return index < size(); }
+
+  /// Access an object value by name, returns nullRef if there is no member
+  /// with that name.
+  const FlatValue& operator[](const char* key) const;
+  /// Access an object value by name, returns nullRef if there is no member
+  /// with that name.
+  /// \param key may contain embedded nulls.
+  const FlatValue& operator[](const std::string& key) const;
+  /// Return the member named key if it exist, defaultValue otherwise.
+  /// \note deep copy
+  Value get(const char* key, const Value& defaultValue) const;
+  /// Return the member named key if it exist, defaultValue otherwise.
+  /// \note deep copy
+  /// \note key may contain embedded nulls.
+  Value get(const char* begin, const char* end, const Value& defaultValue) const;
+  /// Return the member named key if it exist, defaultValue otherwise.
+  /// \note deep copy
+  /// \param key may contain embedded nulls.
+  Value get(const std::string& key, const Value& defaultValue) const;
+  /// Most general and efficient version of isMember()const, get()const,
+  /// and operator[]const
+  /// \pre type() is objectValue or nullValue
+  FlatValue const* find(char const* begin, char const* end) const;
+
+  /// Return true if the object has a member named key.
+  /// \note 'key' must be null-terminated.
+  bool isMember(const char* key) const;
+  /// Return true if the object has a member named key.
+  /// \param key may contain embedded nulls.
+  bool isMember(const std::string& key) const;
+  /// Same as isMember(std::string const& key)const
+  bool isMember(const char* begin, const char* end) const;
+
+  /// \brief Return a list of the member names.
+  ///
+  /// If null, return an empty list.
+  /// \pre type() is objectValue or nullValue
+  Members getMemberNames() const;
+
+  std::string toStyledString() const;
+
+  const_iterator begin() const;
+  const_iterator end() const;
+
+  /// Deep copy into a regular, mutable Value.
+  Value toValue() const;
+
+private:
+  struct Member;
+
+  /// Scalar payload as a Value, so conversions share Value's rules.
+  Value scalarValue() const;
+
+  union ValueHolder {
+    LargestInt int_;
+    LargestUInt uint_;
+    double real_;
+    bool bool_;
+    const char* string_;       // null-terminated, length in size_
+    const FlatValue* elements_; // size_ elements
+    const Member* members_;     // size_ members, sorted by key
+  } value_;
+  ArrayIndex size_;
+  unsigned char type_;
+};
+
+struct FlatValue::Member {
+  const char* key_; // null-terminated
+  unsigned keyLength_;
+  FlatValue value_;
+};
+
+/** \brief Iterator over the elements of an array or the members of an object.
+ *
+ * Mirrors ValueConstIterator.
+ */
+class FlatValue::const_iterator {
+  friend class FlatValue;
+
+public:
+  typedef std::bidirectional_iterator_tag iterator_category;
+  typedef std::ptrdiff_t difference_type;
+  typedef const FlatValue value_type;
+  typedef const FlatValue& reference;
+  typedef const FlatValue* pointer;
+
+  const_iterator() : owner_(NULL), index_(0) {}
+
+  reference operator*() const;
+  pointer operator->() const { return &**this; }
+
+  const_iterator& operator++() { ++index_; return *this; }
+  const_iterator operator++(int) { const_iterator temp(*this); ++index_; return temp; }
+  const_iterator& operator--() { --index_; return *this; }
+  const_iterator operator--(int) { const_iterator temp(*this); --index_; return temp; }
+
+  bool operator==(const const_iterator& other) const {
+    return owner_ == other.owner_ && index_ == other.index_;
+  }
+  bool operator!=(const const_iterator& other) const { return !(*this == other); }
+  difference_type operator-(const const_iterator& other) const {
+    return difference_type(index_) - difference_type(other.index_);
+  }
+
+  /// Return either the index or the member name of the referenced value as a
+  /// Value.
+  Value key() const;
+  /// Return the index of the referenced Value, or -1 if it is not an
+  /// arrayValue.
+  UInt index() const;
+  /// Return the member name of the referenced Value, or "" if it is not an
+  /// objectValue.
+  /// \note Avoid `c_str()` on result, as embedded zeroes are possible.
+  std::string name() const;
+  /// Return the member name of the referenced Value, or NULL if it is not an
+  /// objectValue.
+  char const* memberName(char const** end) const;
+
+private:
+  const_iterator(const FlatValue* owner, ArrayIndex index)
+    : owner_(owner), index_(index) {}
+
+  const FlatValue* owner_;
+  ArrayIndex index_;
+};
+
+/** \brief Opt-in parse mode that places a whole document in a FlatArena.
+ *
+ * Accepts the same input as a CharReader from a default-configured
+ * CharReaderBuilder (comments allowed, trailing text ignored, nesting limited
+ * to 1000 levels) and produces the same values, but comments are not kept.
+ * Parsing does one allocation per arena block instead of several per node,
+ * and destroying or re-parsing the document frees everything at once.
+ *
+ * Usage:
+ * \code
+ * Json::FlatDocument doc;
+ * std::string errs;
+ * if (doc.parse(begin, end, &errs))
+ *   use(doc.root()["runtime"][0u].asString());
+ * \endcode
+ */
+class FlatDocument {
+public:
+  FlatDocument();
+  ~FlatDocument();
+
+  /** \brief Read a Value from a <a HREF="http://www.json.org">JSON</a>
+   document, replacing any previous contents.
+
+   * \param beginDoc Pointer on the beginning of the UTF-8 encoded string
+   *                 of the document to read.
+   * \param endDoc Pointer on the end of the UTF-8 encoded string of the
+   *               document to read. Must be >= beginDoc.
+   * \param errs [out] Formatted error messages (if not NULL)
+   *        a user friendly string that lists errors in the parsed
+   * document.
+   * \return \c true if the document was successfully parsed, \c false if an
+   error occurred.
+   */
+  bool parse(char const* beginDoc, char const* endDoc, std::string* errs);
+
+  /// Root of the last successful parse, or a null value.
+  const FlatValue& root() const { return root_; }
+
+  /// Free every value.
+  void clear();
+
+  const FlatArena& arena() const { return arena_; }
+
+private:
+  FlatDocument(FlatDocument const&);
+  void operator=(FlatDocument const&);
+
+  FlatArena arena_;
+  FlatValue root_;
+};
+
+} // namespace Json
@@ -0,0 +1,222 @@
+//========= Copyright Valve Corporation ============//
+// Event driven JSON reading on top of jsoncpp, and the tokenizer that it shares with
+// Json::Reader and the CharReaderBuilder reader.
+#pragma once
+
+#include <json/json.h>
+#include <string>
+#include <vector>
+
+namespace Json {
+
+/// Kinds of token found by scanJsonToken(). The values up to jsonTokenError
+/// line up with Reader's and OurReader's own token types.
+enum JsonTokenType {
+  jsonTokenEndOfStream = 0,
+  jsonTokenObjectBegin,
+  jsonTokenObjectEnd,
+  jsonTokenArrayBegin,
+  jsonTokenArrayEnd,
+  jsonTokenString,
+  jsonTokenNumber,
+  jsonTokenTrue,
+  jsonTokenFalse,
+  jsonTokenNull,
+  jsonTokenArraySeparator,
+  jsonTokenMemberSeparator,
+  jsonTokenComment,
+  jsonTokenError,
+  jsonTokenNaN,    ///< only with allowSpecialFloats
+  jsonTokenPosInf, ///< only with allowSpecialFloats
+  jsonTokenNegInf, ///< only with allowSpecialFloats
+  jsonTokenIncomplete ///< only if !final: more input is needed
+};
+
+/** \brief Find the extent of the token that starts at begin.
+ *
+ * This is the tokenizer of Reader, OurReader and SaxReader. Spaces must
+ * already have been skipped. *tokenEnd is set to the end of the token, or of
+ * the text that was rejected for a jsonTokenError.
+ *
+ * \param final true if no input follows end. Otherwise a token that runs up
+ *              to end is reported as jsonTokenIncomplete, since more input
+ *              could still extend or complete it.
+ */
+JsonTokenType scanJsonToken(char const* begin, char const* end, bool final,
+                            bool allowSingleQuotes, bool allowSpecialFloats,
+                            char const** tokenEnd);
+
+/** \brief Receives the events of a SaxReader.
+ *
+ * Every callback returns true to keep going or false to stop the parse early;
+ * the reader then ignores the rest of the input without reporting an error.
+ * The default implementations accept and ignore the event.
+ *
+ * Strings and keys are passed decoded (escapes resolved) and are only valid
+ * for the duration of the call.
+ */
+class SaxHandler {
+public:
+  virtual ~SaxHandler();
+
+  virtual bool onStartObject();
+  /// Name of the next member of the innermost object.
+  virtual bool onKey(char const* begin, char const* end);
+  virtual bool onEndObject();
+  virtual bool onStartArray();
+  virtual bool onEndArray();
+  virtual bool onNull();
+  virtual bool onBool(bool value);
+  /// Integers are reported the way Reader stores them: negative numbers and
+  /// those up to Value::maxInt as LargestInt, larger ones as LargestUInt and
+  /// anything that does not fit either as a double.
+  virtual bool onInt(LargestInt value);
+  virtual bool onUInt(LargestUInt value);
+  virtual bool onDouble(double value);
+  virtual bool onString(char const* begin, char const* end);
+};
+
+/** \brief Event driven <a HREF="http://www.json.org">JSON</a> reader.
+ *
+ * Accepts the same documents as a CharReader from a default-configured
+ * CharReaderBuilder (comments allowed, trailing text ignored, nesting limited
+ * to 1000 levels) but builds nothing; instead the handler is called as each
+ * value is read.
+ *
+ * Input may be supplied in chunks of any size with feed(). Only a token that
+ * straddles two chunks is copied, so memory use is bounded by the longest
+ * token and the nesting depth rather than by the document.
+ *
+ * Usage:
+ * \code
+ * Json::SaxReader reader(handler);
+ * while (size_t n = fread(buf, 1, sizeof(buf), f))
+ *   if (!reader.feed(buf, buf + n))
+ *     break;
+ * if (!reader.finish())
+ *   std::cerr << reader.getFormattedErrorMessages();
+ * \endcode
+ */
+class SaxReader {
+public:
+  explicit SaxReader(SaxHandler& handler);
+
+  /// Forget any partial document so a new one can be fed.
+  void reset();
+
+  /** \brief Read the next piece of the document.
+   * \return false if a syntax error was found. Input that arrives after the
+   *         root value is complete, or after the handler stopped the parse,
+   *         is ignored.
+   */
+  bool feed(char const* begin, char const* end);
+
+  /** \brief Signal the end of the input.
+   * \return true if a complete value was read or the handler stopped the
+   *         parse early, false on a syntax error or a truncated document.
+   */
+  bool finish();
+
+  /// reset(), feed() and finish() for a document held in one buffer.
+  bool parse(char const* beginDoc, char const* endDoc);
+
+  /// True once the root value has been read completely.
+  bool isComplete() const { return status_ == statusComplete; }
+  /// True if a handler callback returned false.
+  bool wasStopped() const { return status_ == statusStopped; }
+  /// False once a syntax error has been found.
+  bool good() const { return status_ != statusFailed; }
+
+  /// Same format as CharReader's error string; empty if good().
+  std::string getFormattedErrorMessages() const;
+
+  /// Maximum nesting depth, 1000 by default.
+  void setStackLimit(unsigned limit) { stackLimit_ = limit; }
+
+private:
+  SaxReader(SaxReader const&);
+  void operator=(SaxReader const&);
+
+  typedef char Char;
+  typedef const Char* Location;
+
+  enum Status {
+    statusParsing,
+    statusComplete,
+    statusStopped,
+    statusFailed
+  };
+
+  // What the next token has to be.
+  enum Mode {
+    modeValue,
+    modeArrayFirst,      ///< just after '[': only spaces before a ']'
+    modeArrayNext,       ///< ',' or ']'
+    modeKey,             ///< member name, or '}'
+    modeColon,
+    modeObjectNext,      ///< ',' or '}' or a comment
+    modeObjectComment    ///< after a comment, anything but '}' separates
+  };
+
+  class Token {
+  public:
+    JsonTokenType type_;
+    Location start_;
+    Location end_;
+  };
+
+  // Container kinds on the nesting stack. The object kinds remember whether
+  // the last member name was empty, which decides if '}' may follow ','.
+  enum Frame {
+    frameArray,
+    frameObject,
+    frameObjectEmptyKey
+  };
+
+  Location run(Location begin, Location end, bool final, bool singleToken);
+  bool dispatch(Token& token, Location& current);
+  bool valueDone();
+  bool decodeNumber(Token& token);
+  bool decodeDouble(Token& token);
+  bool decodeString(Token& token, char const** begin, char const** end);
+  bool decodeUnicodeCodePoint(Token& token,
+                              Location& current,
+                              Location end,
+                              unsigned int& unicode);
+  bool decodeUnicodeEscapeSequence(Token& token,
+                                   Location& current,
+                                   Location end,
+                                   unsigned int& unicode);
+  bool stop(bool keepGoing);
+  bool addError(const std::string& message, Token& token, Location extra = 0);
+  size_t offsetOf(Location location) const {
+    return windowOffset_ + size_t(location - window_);
+  }
+  void countLines(size_t uptoOffset);
+  std::string getLocationLineAndColumn(size_t offset);
+
+  SaxHandler& handler_;
+  Status status_;
+  Mode mode_;
+  std::vector<unsigned char> stack_;
+  unsigned stackLimit_;
+
+  // The window being scanned: the caller's chunk, or carry_ while a token
+  // split across chunks is completed.
+  Location window_;
+  size_t windowOffset_;
+  size_t fedOffset_;  ///< document offset of the end of the input so far
+  std::string carry_; ///< start of a token cut off by the end of a chunk
+  size_t carryOffset_;
+  std::string scratch_; ///< decoded strings that contain escapes
+
+  // Line bookkeeping for error messages, covering [0, countedOffset_).
+  size_t countedOffset_;
+  int line_;
+  size_t lineStartOffset_;
+  bool lastWasCR_;
+
+  std::string errors_;
+};
+
+} // namespace Json
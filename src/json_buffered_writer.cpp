@@ -0,0 +1,638 @@
+//========= Copyright Valve Corporation ============//
+#include <json/json_buffered_writer.h>
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define JSON_WRITER_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define JSON_WRITER_NEON
+#endif
+
+namespace Json {
+
+// Write the decimal digits of value to dest (at least 20 bytes) and return
+// how many there are.
+static size_t formatUInt(LargestUInt value, char* dest) {
+  char digits[20];
+  char* current = digits + sizeof(digits);
+  do {
+    *--current = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  size_t length = static_cast<size_t>(digits + sizeof(digits) - current);
+  memcpy(dest, current, length);
+  return length;
+}
+
+// Format value into buffer the way valueToString(double, bool, unsigned) in
+// jsoncpp.cpp does, and return the length of the text.
+static size_t formatDouble(double value, bool useSpecialFloats,
+                           unsigned int precision, char (&buffer)[32]) {
+  int len;
+  if (std::isfinite(value)) {
+    char formatString[6];
+    snprintf(formatString, sizeof(formatString), "%%.%ug", precision);
+    // JSON doesn't tell reals from integers, so there is no need for the
+    // alternative form that always has a decimal point.
+    len = snprintf(buffer, sizeof(buffer), formatString, value);
+  } else if (value != value) {
+    len = snprintf(buffer, sizeof(buffer), useSpecialFloats ? "NaN" : "null");
+  } else if (value < 0) {
+    len = snprintf(buffer, sizeof(buffer),
+                   useSpecialFloats ? "-Infinity" : "-1e+9999");
+  } else {
+    len = snprintf(buffer, sizeof(buffer),
+                   useSpecialFloats ? "Infinity" : "1e+9999");
+  }
+  // Whatever the locale, the decimal separator is a '.'.
+  for (int i = 0; i < len; ++i) {
+    if (buffer[i] == ',')
+      buffer[i] = '.';
+  }
+  return strlen(buffer);
+}
+
+// Return the first character in [begin, end) that valueToQuotedStringN()
+// escapes: '"', '\\' and anything below 0x20, NUL included.
+static char const* findCharacterToEscape(char const* begin, char const* end) {
+  char const* cur = begin;
+
+#if defined(JSON_WRITER_SSE2)
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  const __m128i control = _mm_set1_epi8(0x1F);
+  while (end - cur >= 16) {
+    __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur));
+    __m128i hits = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(chars, quote), _mm_cmpeq_epi8(chars, backslash)),
+        _mm_cmpeq_epi8(_mm_max_epu8(chars, control), control));
+    if (_mm_movemask_epi8(hits) != 0)
+      break;
+    cur += 16;
+  }
+#elif defined(JSON_WRITER_NEON)
+  const uint8x16_t quote = vdupq_n_u8('"');
+  const uint8x16_t backslash = vdupq_n_u8('\\');
+  const uint8x16_t control = vdupq_n_u8(0x20);
+  while (end - cur >= 16) {
+    uint8x16_t chars = vld1q_u8(reinterpret_cast<const uint8_t*>(cur));
+    uint8x16_t hits = vorrq_u8(
+        vorrq_u8(vceqq_u8(chars, quote), vceqq_u8(chars, backslash)),
+        vcltq_u8(chars, control));
+    if (vmaxvq_u8(hits) != 0)
+      break;
+    cur += 16;
+  }
+#else
+  const UInt64 ones = 0x0101010101010101ull;
+  const UInt64 highs = 0x8080808080808080ull;
+  while (end - cur >= 8) {
+    UInt64 chars;
+    memcpy(&chars, cur, sizeof(chars));
+    UInt64 quotes = chars ^ (ones * '"');
+    UInt64 backslashes = chars ^ (ones * '\\');
+    UInt64 hits = ((chars - ones * 0x20) & ~chars) |
+                  ((quotes - ones) & ~quotes) |
+                  ((backslashes - ones) & ~backslashes);
+    if (hits & highs)
+      break;
+    cur += 8;
+  }
+#endif
+
+  while (cur != end && *cur != '"' && *cur != '\\' &&
+         static_cast<unsigned char>(*cur) >= 0x20)
+    ++cur;
+  return cur;
+}
+
+// Write the escape sequence valueToQuotedStringN() uses for c into out (at
+// least 6 bytes) and return its length.
+static size_t escapeCharacter(char c, char* out) {
+  static const char hexDigits[] = "0123456789ABCDEF";
+  out[0] = '\\';
+  switch (c) {
+  case '\"': out[1] = '"'; return 2;
+  case '\\': out[1] = '\\'; return 2;
+  case '\b': out[1] = 'b'; return 2;
+  case '\f': out[1] = 'f'; return 2;
+  case '\n': out[1] = 'n'; return 2;
+  case '\r': out[1] = 'r'; return 2;
+  case '\t': out[1] = 't'; return 2;
+  default:
+    out[1] = 'u';
+    out[2] = '0';
+    out[3] = '0';
+    out[4] = hexDigits[(static_cast<unsigned char>(c) >> 4) & 0xF];
+    out[5] = hexDigits[static_cast<unsigned char>(c) & 0xF];
+    return 6;
+  }
+}
+
+// Steps through an array in index order, yielding nullRef for the holes a
+// sparse array can have, without a map lookup per element.
+class ArrayElementCursor {
+public:
+  explicit ArrayElementCursor(Value const& array)
+      : current_(array.begin()), end_(array.end()), index_(0) {}
+  Value const& next() {
+    if (current_ != end_ && current_.index() == index_) {
+      Value const& element = *current_;
+      ++current_;
+      ++index_;
+      return element;
+    }
+    ++index_;
+    return Value::nullRef;
+  }
+
+private:
+  Value::const_iterator current_;
+  Value::const_iterator end_;
+  ArrayIndex index_;
+};
+
+class FileDescriptorSink : public BufferedWriter::Sink {
+public:
+  explicit FileDescriptorSink(int fd) : fd_(fd) {}
+  bool write(char const* data, size_t size) {
+    while (size != 0) {
+#if defined(_WIN32)
+      int written = _write(fd_, data, static_cast<unsigned>(std::min<size_t>(size, 1u << 30)));
+#else
+      ssize_t written = ::write(fd_, data, size);
+#endif
+      if (written < 0) {
+        if (errno == EINTR)
+          continue;
+        return false;
+      }
+      data += written;
+      size -= static_cast<size_t>(written);
+    }
+    return true;
+  }
+
+private:
+  int fd_;
+};
+
+// Same as BuiltStyledStreamWriter::rightMargin_.
+static const unsigned int kStyledRightMargin = 74;
+
+BufferedWriter::Sink::~Sink() {}
+
+BufferedWriter::BufferedWriter()
+    : styled_(false), comments_(false), useSpecialFloats_(false),
+      precision_(17), colonSymbol_(":"), nullSymbol_("null"),
+      endingLineFeedSymbol_("\n"), chunkSize_(64 * 1024), indented_(false),
+      target_(targetBuffer), begin_(NULL), cursor_(NULL), limit_(NULL),
+      flushed_(0), sink_(NULL), failed_(false) {}
+
+BufferedWriter::BufferedWriter(StreamWriterBuilder const& builder)
+    : styled_(true), comments_(false), useSpecialFloats_(false),
+      precision_(17), chunkSize_(64 * 1024), indented_(false),
+      target_(targetBuffer), begin_(NULL), cursor_(NULL), limit_(NULL),
+      flushed_(0), sink_(NULL), failed_(false) {
+  // The same reading of the settings as StreamWriterBuilder::newStreamWriter().
+  Value const& settings = builder.settings_;
+  std::string commentStyle = settings["commentStyle"].asString();
+  if (commentStyle == "All") {
+    comments_ = true;
+  } else if (commentStyle != "None") {
+    throwRuntimeError("commentStyle must be 'All' or 'None'");
+  }
+  indentation_ = settings["indentation"].asString();
+  colonSymbol_ = " : ";
+  if (settings["enableYAMLCompatibility"].asBool()) {
+    colonSymbol_ = ": ";
+  } else if (indentation_.empty()) {
+    colonSymbol_ = ":";
+  }
+  nullSymbol_ = settings["dropNullPlaceholders"].asBool() ? "" : "null";
+  useSpecialFloats_ = settings["useSpecialFloats"].asBool();
+  precision_ = settings["precision"].asUInt();
+  if (precision_ > 17)
+    precision_ = 17;
+}
+
+void BufferedWriter::enableYAMLCompatibility() { colonSymbol_ = ": "; }
+
+void BufferedWriter::dropNullPlaceholders() { nullSymbol_ = ""; }
+
+void BufferedWriter::omitEndingLineFeed() { endingLineFeedSymbol_ = ""; }
+
+void BufferedWriter::setChunkSize(size_t size) { chunkSize_ = size < 64 ? 64 : size; }
+
+std::string const& BufferedWriter::write(Value const& root) {
+  beginOutput(targetBuffer, NULL, 0, NULL);
+  writeRoot(root);
+  endOutput();
+  return buffer_;
+}
+
+size_t BufferedWriter::write(Value const& root, char* dest, size_t capacity) {
+  beginOutput(targetMemory, dest, capacity, NULL);
+  writeRoot(root);
+  return endOutput();
+}
+
+bool BufferedWriter::write(Value const& root, Sink& sink) {
+  beginOutput(targetSink, NULL, 0, &sink);
+  writeRoot(root);
+  endOutput();
+  return !failed_;
+}
+
+bool BufferedWriter::writeToFd(Value const& root, int fd) {
+  FileDescriptorSink sink(fd);
+  return write(root, sink);
+}
+
+void BufferedWriter::beginOutput(Target target, char* dest, size_t capacity, Sink* sink) {
+  target_ = target;
+  sink_ = sink;
+  flushed_ = 0;
+  failed_ = false;
+  if (target == targetMemory) {
+    begin_ = dest;
+    limit_ = dest + capacity;
+  } else {
+    // Reuse whatever the buffer grew to last time.
+    size_t size = target == targetSink ? chunkSize_ : buffer_.capacity();
+    if (buffer_.size() < size)
+      buffer_.resize(size);
+    begin_ = &buffer_[0];
+    limit_ = begin_ + size;
+  }
+  cursor_ = begin_;
+}
+
+size_t BufferedWriter::endOutput() {
+  size_t length = static_cast<size_t>(cursor_ - begin_);
+  if (target_ == targetSink && length != 0 && !failed_)
+    failed_ = !sink_->write(begin_, length);
+  if (target_ == targetBuffer)
+    buffer_.resize(length);
+  begin_ = cursor_ = limit_ = NULL;
+  sink_ = NULL;
+  return flushed_ + length;
+}
+
+inline void BufferedWriter::put(char const* data, size_t size) {
+  if (static_cast<size_t>(limit_ - cursor_) >= size) {
+    memcpy(cursor_, data, size);
+    cursor_ += size;
+  } else {
+    overflow(data, size);
+  }
+}
+
+void BufferedWriter::overflow(char const* data, size_t size) {
+  switch (target_) {
+  case targetBuffer: {
+    size_t length = static_cast<size_t>(cursor_ - begin_);
+    buffer_.resize(std::max(std::max(buffer_.size() * 2, length + size), size_t(256)));
+    begin_ = &buffer_[0];
+    cursor_ = begin_ + length;
+    limit_ = begin_ + buffer_.size();
+    memcpy(cursor_, data, size);
+    cursor_ += size;
+  } break;
+  case targetMemory: {
+    // Fill what is left and only count the rest.
+    size_t room = static_cast<size_t>(limit_ - cursor_);
+    if (room != 0)
+      memcpy(cursor_, data, room);
+    cursor_ = limit_;
+    flushed_ += size - room;
+  } break;
+  case targetSink: {
+    size_t length = static_cast<size_t>(cursor_ - begin_);
+    if (length != 0 && !failed_)
+      failed_ = !sink_->write(begin_, length);
+    flushed_ += length;
+    cursor_ = begin_;
+    if (size < static_cast<size_t>(limit_ - begin_)) {
+      memcpy(cursor_, data, size);
+      cursor_ += size;
+    } else {
+      if (!failed_)
+        failed_ = !sink_->write(data, size);
+      flushed_ += size;
+    }
+  } break;
+  }
+}
+
+void BufferedWriter::writeRoot(Value const& root) {
+  if (styled_) {
+    indentString_.clear();
+    indented_ = true;
+    writeCommentBeforeValue(root);
+    if (!indented_) writeIndent();
+    indented_ = true;
+    writeStyledValue(root);
+    writeCommentAfterValueOnSameLine(root);
+  } else {
+    writeFastValue(root);
+  }
+  put(endingLineFeedSymbol_);
+}
+
+void BufferedWriter::writeFastValue(Value const& value) {
+  switch (value.type()) {
+  case arrayValue: {
+    put('[');
+    ArrayIndex size = value.size();
+    ArrayElementCursor elements(value);
+    for (ArrayIndex index = 0; index < size; ++index) {
+      if (index > 0)
+        put(',');
+      writeFastValue(elements.next());
+    }
+    put(']');
+  } break;
+  case objectValue: {
+    put('{');
+    Value::const_iterator end = value.end();
+    for (Value::const_iterator it = value.begin(); it != end; ++it) {
+      if (it != value.begin())
+        put(',');
+      char const* nameEnd;
+      char const* name = it.memberName(&nameEnd);
+      writeQuoted(name, static_cast<size_t>(nameEnd - name));
+      put(colonSymbol_);
+      writeFastValue(*it);
+    }
+    put('}');
+  } break;
+  default:
+    writeScalar(value);
+    break;
+  }
+}
+
+void BufferedWriter::writeStyledValue(Value const& value) {
+  switch (value.type()) {
+  case arrayValue:
+    writeStyledArray(value);
+    break;
+  case objectValue: {
+    if (value.size() == 0) {
+      put("{}", 2);
+      break;
+    }
+    writeWithIndent("{", 1);
+    indentString_ += indentation_;
+    Value::const_iterator it = value.begin();
+    Value::const_iterator end = value.end();
+    for (;;) {
+      Value const& childValue = *it;
+      writeCommentBeforeValue(childValue);
+      if (!indented_) writeIndent();
+      char const* nameEnd;
+      char const* name = it.memberName(&nameEnd);
+      writeQuoted(name, static_cast<size_t>(nameEnd - name));
+      indented_ = false;
+      put(colonSymbol_);
+      writeStyledValue(childValue);
+      if (++it == end) {
+        writeCommentAfterValueOnSameLine(childValue);
+        break;
+      }
+      put(',');
+      writeCommentAfterValueOnSameLine(childValue);
+    }
+    indentString_.resize(indentString_.size() - indentation_.size());
+    writeWithIndent("}", 1);
+  } break;
+  default:
+    writeScalar(value);
+    break;
+  }
+}
+
+void BufferedWriter::writeStyledArray(Value const& value) {
+  ArrayIndex size = value.size();
+  if (size == 0) {
+    put("[]", 2);
+    return;
+  }
+  // With comments on, BuiltStyledStreamWriter always puts one value per line.
+  if (!comments_ && writeSingleLineArray(value))
+    return;
+  writeWithIndent("[", 1);
+  indentString_ += indentation_;
+  ArrayElementCursor elements(value);
+  for (ArrayIndex index = 0;;) {
+    Value const& childValue = elements.next();
+    writeCommentBeforeValue(childValue);
+    if (!indented_) writeIndent();
+    indented_ = true;
+    writeStyledValue(childValue);
+    indented_ = false;
+    if (++index == size) {
+      writeCommentAfterValueOnSameLine(childValue);
+      break;
+    }
+    put(',');
+    writeCommentAfterValueOnSameLine(childValue);
+  }
+  indentString_.resize(indentString_.size() - indentation_.size());
+  writeWithIndent("]", 1);
+}
+
+// BuiltStyledStreamWriter::isMultineArray() without building a string per
+// element: the elements are formatted into a line buffer that is only written
+// out if the whole array fits on one line. Returns false, having written
+// nothing, if it does not.
+bool BufferedWriter::writeSingleLineArray(Value const& value) {
+  ArrayIndex size = value.size();
+  if (size * 3 >= kStyledRightMargin)
+    return false;
+  char line[kStyledRightMargin];
+  // '[ ' + ' ]' plus what is in line must stay below the margin.
+  size_t const maxLength = kStyledRightMargin - 4;
+  size_t length = 0;
+  ArrayElementCursor elements(value);
+  for (ArrayIndex index = 0; index < size; ++index) {
+    Value const& childValue = elements.next();
+    if ((childValue.isArray() || childValue.isObject()) && childValue.size() > 0)
+      return false;
+    if (childValue.hasComment(commentBefore) ||
+        childValue.hasComment(commentAfterOnSameLine) ||
+        childValue.hasComment(commentAfter))
+      return false;
+    if (index > 0) {
+      if (maxLength - length <= 2)
+        return false;
+      line[length++] = ',';
+      line[length++] = ' ';
+    }
+    size_t childLength = formatScalar(childValue, line + length, maxLength - length);
+    if (childLength >= maxLength - length)
+      return false;
+    length += childLength;
+  }
+  put('[');
+  if (!indentation_.empty()) put(' ');
+  put(line, length);
+  if (!indentation_.empty()) put(' ');
+  put(']');
+  return true;
+}
+
+// Format a scalar or an empty container into dest. Returns its length; the
+// text is only stored if that is less than capacity.
+size_t BufferedWriter::formatScalar(Value const& value, char* dest, size_t capacity) {
+  char buffer[32];
+  char const* text = buffer;
+  size_t length = 0;
+  switch (value.type()) {
+  case nullValue:
+    text = nullSymbol_.data();
+    length = nullSymbol_.size();
+    break;
+  case intValue: {
+    LargestInt number = value.asLargestInt();
+    // Negate in the unsigned domain so minLargestInt does not overflow.
+    LargestUInt magnitude = LargestUInt(number);
+    if (number < 0) {
+      buffer[0] = '-';
+      magnitude = LargestUInt(0) - magnitude;
+    }
+    length = (number < 0 ? 1 : 0) +
+             formatUInt(magnitude, buffer + (number < 0 ? 1 : 0));
+  } break;
+  case uintValue:
+    length = formatUInt(value.asLargestUInt(), buffer);
+    break;
+  case realValue:
+    length = formatDouble(value.asDouble(), useSpecialFloats_, precision_, buffer);
+    break;
+  case booleanValue:
+    text = value.asBool() ? "true" : "false";
+    length = strlen(text);
+    break;
+  case stringValue: {
+    char const* str;
+    char const* end;
+    if (!value.getString(&str, &end))
+      return 0;
+    size_t quoted = static_cast<size_t>(end - str) + 2;
+    if (quoted >= capacity)
+      return quoted;
+    // Short enough to be worth escaping straight into dest.
+    char* out = dest;
+    *out++ = '"';
+    for (char const* c = str; c != end; ++c) {
+      char escaped[6];
+      size_t escapedLength = 1;
+      if (*c == '"' || *c == '\\' || static_cast<unsigned char>(*c) < 0x20)
+        escapedLength = escapeCharacter(*c, escaped);
+      else
+        escaped[0] = *c;
+      if (static_cast<size_t>(out - dest) + escapedLength + 1 >= capacity)
+        return capacity;
+      memcpy(out, escaped, escapedLength);
+      out += escapedLength;
+    }
+    *out++ = '"';
+    return static_cast<size_t>(out - dest);
+  }
+  case arrayValue:
+    text = "[]";
+    length = 2;
+    break;
+  case objectValue:
+    text = "{}";
+    length = 2;
+    break;
+  }
+  if (length < capacity)
+    memcpy(dest, text, length);
+  return length;
+}
+
+void BufferedWriter::writeScalar(Value const& value) {
+  if (value.type() == stringValue) {
+    char const* str;
+    char const* end;
+    if (value.getString(&str, &end))
+      writeQuoted(str, static_cast<size_t>(end - str));
+    return;
+  }
+  char buffer[32];
+  put(buffer, formatScalar(value, buffer, sizeof(buffer)));
+}
+
+void BufferedWriter::writeQuoted(char const* str, size_t length) {
+  char const* end = str + length;
+  put('"');
+  for (;;) {
+    char const* special = findCharacterToEscape(str, end);
+    put(str, static_cast<size_t>(special - str));
+    if (special == end)
+      break;
+    char escaped[6];
+    put(escaped, escapeCharacter(*special, escaped));
+    str = special + 1;
+  }
+  put('"');
+}
+
+void BufferedWriter::writeIndent() {
+  if (!indentation_.empty()) {
+    put('\n');
+    put(indentString_);
+  }
+}
+
+void BufferedWriter::writeWithIndent(char const* text, size_t length) {
+  if (!indented_) writeIndent();
+  put(text, length);
+  indented_ = false;
+}
+
+void BufferedWriter::writeCommentBeforeValue(Value const& root) {
+  if (!comments_ || !root.hasComment(commentBefore))
+    return;
+
+  if (!indented_) writeIndent();
+  const std::string comment = root.getComment(commentBefore);
+  for (size_t i = 0; i < comment.size(); ++i) {
+    put(comment[i]);
+    if (comment[i] == '\n' && i + 1 < comment.size() && comment[i + 1] == '/')
+      put(indentString_);
+  }
+  indented_ = false;
+}
+
+void BufferedWriter::writeCommentAfterValueOnSameLine(Value const& root) {
+  if (!comments_)
+    return;
+  if (root.hasComment(commentAfterOnSameLine)) {
+    put(' ');
+    put(root.getComment(commentAfterOnSameLine));
+  }
+
+  if (root.hasComment(commentAfter)) {
+    writeIndent();
+    put(root.getComment(commentAfter));
+  }
+}
+
+} // namespace Json
@@ -0,0 +1,689 @@
+//========= Copyright Valve Corporation ============//
+#include <json/json_flat.h>
+#include <json/json_sax.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+
+namespace Json {
+
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+// class FlatArena
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+
+// Smallest block the arena asks the system for. Later blocks grow with the
+// total so a large document only needs a handful of allocations.
+static const size_t kFlatArenaMinBlockSize = 64 * 1024;
+
+FlatArena::FlatArena()
+    : head_(NULL), cursor_(NULL), limit_(NULL), used_(0), reserved_(0) {}
+
+FlatArena::~FlatArena() { clear(); }
+
+void FlatArena::addBlock(size_t minSize) {
+  size_t size = std::max(kFlatArenaMinBlockSize, reserved_ / 2);
+  if (size < minSize)
+    size = minSize;
+  Block* block = static_cast<Block*>(::operator new(sizeof(Block) + size));
+  block->next_ = head_;
+  block->size_ = size;
+  head_ = block;
+  cursor_ = reinterpret_cast<char*>(block + 1);
+  limit_ = cursor_ + size;
+  reserved_ += size;
+}
+
+static inline char* alignFlatPointer(char* p, size_t align) {
+  return reinterpret_cast<char*>(
+      (reinterpret_cast<size_t>(p) + (align - 1)) & ~(align - 1));
+}
+
+void* FlatArena::allocate(size_t size, size_t align) {
+  char* p = alignFlatPointer(cursor_, align);
+  if (cursor_ == NULL || p > limit_ || size > size_t(limit_ - p)) {
+    addBlock(size + align);
+    p = alignFlatPointer(cursor_, align);
+  }
+  cursor_ = p + size;
+  used_ += size;
+  return p;
+}
+
+void FlatArena::reserve(size_t size) {
+  if (cursor_ == NULL || size_t(limit_ - cursor_) < size)
+    addBlock(size);
+}
+
+void FlatArena::clear() {
+  while (head_) {
+    Block* next = head_->next_;
+    ::operator delete(head_);
+    head_ = next;
+  }
+  cursor_ = NULL;
+  limit_ = NULL;
+  used_ = 0;
+  reserved_ = 0;
+}
+
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+// class FlatBuilder
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+
+/* Builds a FlatValue tree in an arena from the events of a SaxReader.
+ *
+ * Children are collected on scratch stacks that are reused for the whole
+ * document; when a container closes, its children are copied to the arena in
+ * one piece, so every array and object ends up contiguous.
+ */
+class FlatBuilder : public SaxHandler {
+public:
+  explicit FlatBuilder(FlatArena& arena);
+
+  const FlatValue& root() const { return root_; }
+
+  virtual bool onStartObject();
+  virtual bool onKey(char const* begin, char const* end);
+  virtual bool onEndObject();
+  virtual bool onStartArray();
+  virtual bool onEndArray();
+  virtual bool onNull();
+  virtual bool onBool(bool value);
+  virtual bool onInt(LargestInt value);
+  virtual bool onUInt(LargestUInt value);
+  virtual bool onDouble(double value);
+  virtual bool onString(char const* begin, char const* end);
+
+private:
+  FlatBuilder(FlatBuilder const&);
+  void operator=(FlatBuilder const&);
+
+  typedef FlatValue::Member Member;
+  struct MemberLess {
+    bool operator()(const Member& a, const Member& b) const;
+  };
+
+  // An open array or object, and the name it will be stored under in its
+  // parent (if that is an object).
+  struct Frame {
+    bool isObject_;
+    size_t mark_;
+    const char* key_;
+    unsigned keyLength_;
+  };
+
+  const char* copyString(char const* begin, char const* end);
+  void startContainer(bool isObject);
+  bool addValue(const FlatValue& value);
+  void finishArray(FlatValue& value, size_t mark);
+  void finishObject(FlatValue& value, size_t mark);
+
+  FlatArena& arena_;
+  std::vector<FlatValue> values_;
+  std::vector<Member> members_;
+  std::vector<Frame> frames_;
+  const char* key_;
+  unsigned keyLength_;
+  FlatValue root_;
+};
+
+FlatBuilder::FlatBuilder(FlatArena& arena)
+    : arena_(arena), key_(NULL), keyLength_(0) {}
+
+const char* FlatBuilder::copyString(char const* begin, char const* end) {
+  size_t length = size_t(end - begin);
+  char* copy = static_cast<char*>(arena_.allocate(length + 1, 1));
+  memcpy(copy, begin, length);
+  copy[length] = 0;
+  return copy;
+}
+
+void FlatBuilder::startContainer(bool isObject) {
+  Frame frame;
+  frame.isObject_ = isObject;
+  frame.mark_ = isObject ? members_.size() : values_.size();
+  frame.key_ = key_;
+  frame.keyLength_ = keyLength_;
+  frames_.push_back(frame);
+}
+
+bool FlatBuilder::addValue(const FlatValue& value) {
+  if (frames_.empty()) {
+    root_ = value;
+  } else if (frames_.back().isObject_) {
+    Member member;
+    member.key_ = key_;
+    member.keyLength_ = keyLength_;
+    member.value_ = value;
+    members_.push_back(member);
+  } else {
+    values_.push_back(value);
+  }
+  return true;
+}
+
+bool FlatBuilder::onStartObject() {
+  startContainer(true);
+  return true;
+}
+
+bool FlatBuilder::onKey(char const* begin, char const* end) {
+  key_ = copyString(begin, end);
+  keyLength_ = unsigned(end - begin);
+  return true;
+}
+
+bool FlatBuilder::onEndObject() {
+  Frame frame = frames_.back();
+  frames_.pop_back();
+  FlatValue value;
+  finishObject(value, frame.mark_);
+  key_ = frame.key_;
+  keyLength_ = frame.keyLength_;
+  return addValue(value);
+}
+
+bool FlatBuilder::onStartArray() {
+  startContainer(false);
+  return true;
+}
+
+bool FlatBuilder::onEndArray() {
+  Frame frame = frames_.back();
+  frames_.pop_back();
+  FlatValue value;
+  finishArray(value, frame.mark_);
+  key_ = frame.key_;
+  keyLength_ = frame.keyLength_;
+  return addValue(value);
+}
+
+bool FlatBuilder::onNull() { return addValue(FlatValue()); }
+
+bool FlatBuilder::onBool(bool b) {
+  FlatValue value;
+  value.type_ = booleanValue;
+  value.value_.bool_ = b;
+  return addValue(value);
+}
+
+bool FlatBuilder::onInt(LargestInt i) {
+  FlatValue value;
+  value.type_ = intValue;
+  value.value_.int_ = i;
+  return addValue(value);
+}
+
+bool FlatBuilder::onUInt(LargestUInt u) {
+  FlatValue value;
+  value.type_ = uintValue;
+  value.value_.uint_ = u;
+  return addValue(value);
+}
+
+bool FlatBuilder::onDouble(double d) {
+  FlatValue value;
+  value.type_ = realValue;
+  value.value_.real_ = d;
+  return addValue(value);
+}
+
+bool FlatBuilder::onString(char const* begin, char const* end) {
+  if (size_t(end - begin) >= 0xFFFFFFFFu)
+    return false;
+  FlatValue value;
+  value.type_ = stringValue;
+  value.value_.string_ = copyString(begin, end);
+  value.size_ = ArrayIndex(end - begin);
+  return addValue(value);
+}
+
+void FlatBuilder::finishArray(FlatValue& value, size_t mark) {
+  size_t count = values_.size() - mark;
+  value.type_ = arrayValue;
+  value.size_ = ArrayIndex(count);
+  value.value_.elements_ = NULL;
+  if (count) {
+    FlatValue* elements = static_cast<FlatValue*>(
+        arena_.allocate(count * sizeof(FlatValue)));
+    memcpy(elements, &values_[mark], count * sizeof(FlatValue));
+    value.value_.elements_ = elements;
+    values_.resize(mark);
+  }
+}
+
+// Same ordering as Value::CZString, so members come out in the order a Value
+// would iterate them.
+static inline int compareFlatKeys(const char* a, unsigned aLength,
+                                  const char* b, unsigned bLength) {
+  int comp = memcmp(a, b, std::min(aLength, bLength));
+  if (comp != 0)
+    return comp;
+  return aLength < bLength ? -1 : (aLength > bLength ? 1 : 0);
+}
+
+bool FlatBuilder::MemberLess::operator()(const Member& a,
+                                         const Member& b) const {
+  return compareFlatKeys(a.key_, a.keyLength_, b.key_, b.keyLength_) < 0;
+}
+
+void FlatBuilder::finishObject(FlatValue& value, size_t mark) {
+  size_t count = members_.size() - mark;
+  value.type_ = objectValue;
+  value.size_ = 0;
+  value.value_.members_ = NULL;
+  if (!count)
+    return;
+
+  // Files written by jsoncpp already have their keys in order, so check for
+  // that before paying for a sort. The sort is stable so that, as with Value,
+  // the last of several members with the same name wins.
+  Member* first = &members_[mark];
+  Member* last = first + count;
+  bool sorted = true;
+  for (Member* it = first + 1; it < last && sorted; ++it)
+    sorted = compareFlatKeys(it[-1].key_, it[-1].keyLength_, it->key_,
+                             it->keyLength_) < 0;
+  if (!sorted) {
+    // Insertion sort is stable too and, unlike stable_sort, does not allocate
+    // a temporary buffer for the small objects that make up most documents.
+    if (count <= 16) {
+      for (Member* it = first + 1; it < last; ++it) {
+        Member member = *it;
+        Member* hole = it;
+        for (; hole > first && MemberLess()(member, hole[-1]); --hole)
+          *hole = hole[-1];
+        *hole = member;
+      }
+    } else {
+      std::stable_sort(first, last, MemberLess());
+    }
+    Member* out = first;
+    for (Member* it = first + 1; it < last; ++it) {
+      if (compareFlatKeys(out->key_, out->keyLength_, it->key_,
+                          it->keyLength_) == 0)
+        *out = *it;
+      else
+        *++out = *it;
+    }
+    count = size_t(out - first) + 1;
+  }
+
+  Member* members =
+      static_cast<Member*>(arena_.allocate(count * sizeof(Member)));
+  memcpy(members, first, count * sizeof(Member));
+  value.size_ = ArrayIndex(count);
+  value.value_.members_ = members;
+  members_.resize(mark);
+}
+
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+// class FlatDocument
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+
+FlatDocument::FlatDocument() {}
+
+FlatDocument::~FlatDocument() {}
+
+bool FlatDocument::parse(char const* beginDoc, char const* endDoc,
+                         std::string* errs) {
+  clear();
+  // Decoded strings never outgrow their source text, so for most documents
+  // this is the only block the arena needs for them.
+  arena_.reserve(size_t(endDoc - beginDoc));
+  FlatBuilder builder(arena_);
+  SaxReader reader(builder);
+  // The builder never stops early, so anything short of a complete document
+  // is an error.
+  bool ok = reader.parse(beginDoc, endDoc) && reader.isComplete();
+  if (errs) {
+    *errs = reader.getFormattedErrorMessages();
+  }
+  if (!ok) {
+    clear();
+    return false;
+  }
+  root_ = builder.root();
+  return true;
+}
+
+void FlatDocument::clear() {
+  root_ = FlatValue();
+  arena_.clear();
+}
+
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+// class FlatValue
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+
+static const FlatValue kFlatNull;
+const FlatValue& FlatValue::nullRef = kFlatNull;
+
+FlatValue::FlatValue() : size_(0), type_(nullValue) {
+  value_.uint_ = 0;
+}
+
+Value FlatValue::scalarValue() const {
+  switch (type_) {
+  case intValue:
+    return Value(value_.int_);
+  case uintValue:
+    return Value(value_.uint_);
+  case realValue:
+    return Value(value_.real_);
+  case booleanValue:
+    return Value(value_.bool_);
+  case stringValue:
+    return Value(value_.string_, value_.string_ + size_);
+  default:
+    // null, or an array or object without its members
+    return Value(static_cast<ValueType>(type_));
+  }
+}
+
+const char* FlatValue::asCString() const {
+  JSON_ASSERT_MESSAGE(type_ == stringValue,
+                      "in Json::FlatValue::asCString(): requires stringValue");
+  return value_.string_;
+}
+
+std::string FlatValue::asString() const {
+  if (type_ == stringValue)
+    return std::string(value_.string_, size_);
+  return scalarValue().asString();
+}
+
+bool FlatValue::getString(char const** str, char const** cend) const {
+  if (type_ != stringValue)
+    return false;
+  *str = value_.string_;
+  *cend = value_.string_ + size_;
+  return true;
+}
+
+FlatValue::Int FlatValue::asInt() const { return scalarValue().asInt(); }
+
+FlatValue::UInt FlatValue::asUInt() const { return scalarValue().asUInt(); }
+
+#if defined(JSON_HAS_INT64)
+FlatValue::Int64 FlatValue::asInt64() const { return scalarValue().asInt64(); }
+
+FlatValue::UInt64 FlatValue::asUInt64() const {
+  return scalarValue().asUInt64();
+}
+#endif // if defined(JSON_HAS_INT64)
+
+FlatValue::LargestInt FlatValue::asLargestInt() const {
+  return scalarValue().asLargestInt();
+}
+
+FlatValue::LargestUInt FlatValue::asLargestUInt() const {
+  return scalarValue().asLargestUInt();
+}
+
+float FlatValue::asFloat() const { return scalarValue().asFloat(); }
+
+double FlatValue::asDouble() const { return scalarValue().asDouble(); }
+
+bool FlatValue::asBool() const {
+  if (type_ == booleanValue)
+    return value_.bool_;
+  return scalarValue().asBool();
+}
+
+bool FlatValue::isInt() const {
+  return isNumeric() && scalarValue().isInt();
+}
+
+bool FlatValue::isInt64() const {
+  return isNumeric() && scalarValue().isInt64();
+}
+
+bool FlatValue::isUInt() const {
+  return isNumeric() && scalarValue().isUInt();
+}
+
+bool FlatValue::isUInt64() const {
+  return isNumeric() && scalarValue().isUInt64();
+}
+
+bool FlatValue::isIntegral() const {
+  return isNumeric() && scalarValue().isIntegral();
+}
+
+bool FlatValue::isDouble() const { return isNumeric(); }
+
+bool FlatValue::isNumeric() const {
+  return type_ == intValue || type_ == uintValue || type_ == realValue;
+}
+
+bool FlatValue::isConvertibleTo(ValueType other) const {
+  if (type_ == arrayValue || type_ == objectValue) {
+    if (other == nullValue)
+      return size_ == 0;
+    return Value(static_cast<ValueType>(type_)).isConvertibleTo(other);
+  }
+  return scalarValue().isConvertibleTo(other);
+}
+
+ArrayIndex FlatValue::size() const {
+  if (type_ == arrayValue || type_ == objectValue)
+    return size_;
+  return 0;
+}
+
+bool FlatValue::empty() const {
+  if (isNull() || isArray() || isObject())
+    return size() == 0u;
+  return false;
+}
+
+const FlatValue& FlatValue::operator[](ArrayIndex index) const {
+  JSON_ASSERT_MESSAGE(
+      type_ == nullValue || type_ == arrayValue,
+      "in Json::FlatValue::operator[](ArrayIndex)const: requires arrayValue");
+  if (type_ == nullValue || index >= size_)
+    return nullRef;
+  return value_.elements_[index];
+}
+
+const FlatValue& FlatValue::operator[](int index) const {
+  JSON_ASSERT_MESSAGE(
+      index >= 0,
+      "in Json::FlatValue::operator[](int index) const: index cannot be negative");
+  return (*this)[ArrayIndex(index)];
+}
+
+// Value::get() is the only way to attach a fallback to a Value, so hand the
+// converted value to it through a one-element array.
+static Value withDefault(Value value, const Value& defaultValue) {
+  Value holder(arrayValue);
+  holder.resize(1);
+  holder[0u].swap(value);
+  return holder.get(0u, defaultValue);
+}
+
+Value FlatValue::get(ArrayIndex index, const Value& defaultValue) const {
+  const FlatValue* value = &((*this)[index]);
+  if (value == &nullRef)
+    return defaultValue;
+  return withDefault(value->toValue(), defaultValue);
+}
+
+FlatValue const* FlatValue::find(char const* key, char const* cend) const {
+  JSON_ASSERT_MESSAGE(
+      type_ == nullValue || type_ == objectValue,
+      "in Json::FlatValue::find(key, end, found): requires objectValue or nullValue");
+  if (type_ == nullValue)
+    return NULL;
+  unsigned keyLength = static_cast<unsigned>(cend - key);
+  const Member* first = value_.members_;
+  size_t count = size_;
+  while (count > 0) {
+    size_t half = count / 2;
+    const Member* middle = first + half;
+    if (compareFlatKeys(middle->key_, middle->keyLength_, key, keyLength) < 0) {
+      first = middle + 1;
+      count -= half + 1;
+    } else {
+      count = half;
+    }
+  }
+  if (first == value_.members_ + size_ ||
+      compareFlatKeys(first->key_, first->keyLength_, key, keyLength) != 0)
+    return NULL;
+  return &first->value_;
+}
+
+const FlatValue& FlatValue::operator[](const char* key) const {
+  FlatValue const* found = find(key, key + strlen(key));
+  if (!found)
+    return nullRef;
+  return *found;
+}
+
+const FlatValue& FlatValue::operator[](const std::string& key) const {
+  FlatValue const* found = find(key.data(), key.data() + key.length());
+  if (!found)
+    return nullRef;
+  return *found;
+}
+
+Value FlatValue::get(char const* key, char const* cend,
+                     Value const& defaultValue) const {
+  FlatValue const* found = find(key, cend);
+  if (!found)
+    return defaultValue;
+  return withDefault(found->toValue(), defaultValue);
+}
+
+Value FlatValue::get(char const* key, Value const& defaultValue) const {
+  return get(key, key + strlen(key), defaultValue);
+}
+
+Value FlatValue::get(std::string const& key, Value const& defaultValue) const {
+  return get(key.data(), key.data() + key.length(), defaultValue);
+}
+
+bool FlatValue::isMember(char const* key, char const* cend) const {
+  return find(key, cend) != NULL;
+}
+
+bool FlatValue::isMember(char const* key) const {
+  return isMember(key, key + strlen(key));
+}
+
+bool FlatValue::isMember(std::string const& key) const {
+  return isMember(key.data(), key.data() + key.length());
+}
+
+FlatValue::Members FlatValue::getMemberNames() const {
+  JSON_ASSERT_MESSAGE(
+      type_ == nullValue || type_ == objectValue,
+      "in Json::FlatValue::getMemberNames(), value must be objectValue");
+  Members members;
+  if (type_ == nullValue)
+    return members;
+  members.reserve(size_);
+  for (ArrayIndex index = 0; index < size_; ++index) {
+    const Member& member = value_.members_[index];
+    members.push_back(std::string(member.key_, member.keyLength_));
+  }
+  return members;
+}
+
+std::string FlatValue::toStyledString() const {
+  return toValue().toStyledString();
+}
+
+FlatValue::const_iterator FlatValue::begin() const {
+  return const_iterator(this, 0);
+}
+
+FlatValue::const_iterator FlatValue::end() const {
+  return const_iterator(this, size());
+}
+
+Value FlatValue::toValue() const {
+  switch (type_) {
+  case arrayValue: {
+    Value result(arrayValue);
+    if (size_)
+      result.resize(size_);
+    for (ArrayIndex index = 0; index < size_; ++index)
+      result[index] = value_.elements_[index].toValue();
+    return result;
+  }
+  case objectValue: {
+    Value result(objectValue);
+    for (ArrayIndex index = 0; index < size_; ++index) {
+      const Member& member = value_.members_[index];
+      result[std::string(member.key_, member.keyLength_)] =
+          member.value_.toValue();
+    }
+    return result;
+  }
+  default:
+    return scalarValue();
+  }
+}
+
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+// class FlatValue::const_iterator
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+
+FlatValue::const_iterator::reference FlatValue::const_iterator::
+operator*() const {
+  if (owner_->type_ == objectValue)
+    return owner_->value_.members_[index_].value_;
+  return owner_->value_.elements_[index_];
+}
+
+Value FlatValue::const_iterator::key() const {
+  if (owner_->type_ == objectValue) {
+    const Member& member = owner_->value_.members_[index_];
+    return Value(member.key_, member.key_ + member.keyLength_);
+  }
+  return Value(index_);
+}
+
+UInt FlatValue::const_iterator::index() const {
+  if (owner_->type_ == objectValue)
+    return Value::UInt(-1);
+  return index_;
+}
+
+std::string FlatValue::const_iterator::name() const {
+  char const* end;
+  char const* key = memberName(&end);
+  if (!key)
+    return std::string();
+  return std::string(key, end);
+}
+
+char const* FlatValue::const_iterator::memberName(char const** end) const {
+  if (owner_->type_ != objectValue) {
+    *end = NULL;
+    return NULL;
+  }
+  const Member& member = owner_->value_.members_[index_];
+  *end = member.key_ + member.keyLength_;
+  return member.key_;
+}
+
+} // namespace Json
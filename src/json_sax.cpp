@@ -0,0 +1,716 @@
+//========= Copyright Valve Corporation ============//
+#include <json/json_sax.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace Json {
+
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+// scanJsonToken
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+
+// A literal that does not match ends mismatchLength characters in, where
+// Reader::match() used to leave it.
+static JsonTokenType scanLiteral(char const* begin, char const* end,
+                                 bool final, char const* literal,
+                                 size_t length, size_t mismatchLength,
+                                 JsonTokenType type, char const** tokenEnd) {
+  size_t available = std::min(length, size_t(end - begin));
+  if (memcmp(begin, literal, available) != 0 ||
+      (available < length && final)) {
+    *tokenEnd = begin + mismatchLength;
+    return jsonTokenError;
+  }
+  if (available < length) {
+    *tokenEnd = end;
+    return jsonTokenIncomplete;
+  }
+  *tokenEnd = begin + length;
+  return type;
+}
+
+JsonTokenType scanJsonToken(char const* begin, char const* end, bool final,
+                            bool allowSingleQuotes, bool allowSpecialFloats,
+                            char const** tokenEnd) {
+  *tokenEnd = begin + 1;
+  if (begin == end) {
+    *tokenEnd = begin;
+    return final ? jsonTokenEndOfStream : jsonTokenIncomplete;
+  }
+  char const* p = begin + 1;
+  switch (*begin) {
+  case '{':
+    return jsonTokenObjectBegin;
+  case '}':
+    return jsonTokenObjectEnd;
+  case '[':
+    return jsonTokenArrayBegin;
+  case ']':
+    return jsonTokenArrayEnd;
+  case ',':
+    return jsonTokenArraySeparator;
+  case ':':
+    return jsonTokenMemberSeparator;
+  case 0:
+    return jsonTokenEndOfStream;
+  case '\'':
+    if (!allowSingleQuotes)
+      return jsonTokenError;
+    // fall through
+  case '"':
+    for (;;) {
+      char const* quote =
+          static_cast<char const*>(memchr(p, *begin, size_t(end - p)));
+      if (!quote) {
+        *tokenEnd = end;
+        return final ? jsonTokenError : jsonTokenIncomplete;
+      }
+      // The quote is escaped if an odd number of backslashes precede it.
+      char const* slash = quote;
+      while (slash > begin + 1 && slash[-1] == '\\')
+        --slash;
+      p = quote + 1;
+      if (((quote - slash) & 1) == 0) {
+        *tokenEnd = p;
+        return jsonTokenString;
+      }
+    }
+  case '/':
+    if (p == end)
+      return final ? jsonTokenError : jsonTokenIncomplete;
+    if (*p == '*') {
+      for (p = begin + 2; p < end; ++p) {
+        p = static_cast<char const*>(memchr(p, '*', size_t(end - p)));
+        if (!p || p + 1 == end)
+          break;
+        if (p[1] == '/') {
+          *tokenEnd = p + 2;
+          return jsonTokenComment;
+        }
+      }
+      *tokenEnd = end;
+      return final ? jsonTokenError : jsonTokenIncomplete;
+    }
+    if (*p == '/') {
+      for (p = begin + 2; p != end; ++p) {
+        if (*p == '\n') {
+          *tokenEnd = p + 1;
+          return jsonTokenComment;
+        }
+        if (*p == '\r') {
+          // Consume DOS EOL, which may not have arrived yet.
+          if (p + 1 == end && !final)
+            break;
+          *tokenEnd = (p + 1 != end && p[1] == '\n') ? p + 2 : p + 1;
+          return jsonTokenComment;
+        }
+      }
+      *tokenEnd = end;
+      return (p == end && final) ? jsonTokenComment : jsonTokenIncomplete;
+    }
+    *tokenEnd = p + 1;
+    return jsonTokenError;
+  case '-':
+    if (p == end && !final)
+      return jsonTokenIncomplete;
+    if (p != end && *p == 'I') {
+      if (!allowSpecialFloats) {
+        *tokenEnd = p + 1;
+        return jsonTokenError;
+      }
+      return scanLiteral(begin, end, final, "-Infinity", 9, 2,
+                         jsonTokenNegInf, tokenEnd);
+    }
+    // fall through
+  case '0':
+  case '1':
+  case '2':
+  case '3':
+  case '4':
+  case '5':
+  case '6':
+  case '7':
+  case '8':
+  case '9':
+    // integral part
+    while (p != end && *p >= '0' && *p <= '9')
+      ++p;
+    // fractional part
+    if (p != end && *p == '.') {
+      ++p;
+      while (p != end && *p >= '0' && *p <= '9')
+        ++p;
+    }
+    // exponential part
+    if (p != end && (*p == 'e' || *p == 'E')) {
+      ++p;
+      if (p != end && (*p == '+' || *p == '-'))
+        ++p;
+      while (p != end && *p >= '0' && *p <= '9')
+        ++p;
+    }
+    *tokenEnd = p;
+    return (p == end && !final) ? jsonTokenIncomplete : jsonTokenNumber;
+  case 't':
+    return scanLiteral(begin, end, final, "true", 4, 1, jsonTokenTrue,
+                       tokenEnd);
+  case 'f':
+    return scanLiteral(begin, end, final, "false", 5, 1, jsonTokenFalse,
+                       tokenEnd);
+  case 'n':
+    return scanLiteral(begin, end, final, "null", 4, 1, jsonTokenNull,
+                       tokenEnd);
+  case 'N':
+    if (!allowSpecialFloats)
+      return jsonTokenError;
+    return scanLiteral(begin, end, final, "NaN", 3, 1, jsonTokenNaN,
+                       tokenEnd);
+  case 'I':
+    if (!allowSpecialFloats)
+      return jsonTokenError;
+    return scanLiteral(begin, end, final, "Infinity", 8, 1, jsonTokenPosInf,
+                       tokenEnd);
+  default:
+    return jsonTokenError;
+  }
+}
+
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+// class SaxHandler
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+
+SaxHandler::~SaxHandler() {}
+bool SaxHandler::onStartObject() { return true; }
+bool SaxHandler::onKey(char const*, char const*) { return true; }
+bool SaxHandler::onEndObject() { return true; }
+bool SaxHandler::onStartArray() { return true; }
+bool SaxHandler::onEndArray() { return true; }
+bool SaxHandler::onNull() { return true; }
+bool SaxHandler::onBool(bool) { return true; }
+bool SaxHandler::onInt(LargestInt) { return true; }
+bool SaxHandler::onUInt(LargestUInt) { return true; }
+bool SaxHandler::onDouble(double) { return true; }
+bool SaxHandler::onString(char const*, char const*) { return true; }
+
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+// class SaxReader
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+
+// Same limit as the CharReaderBuilder "stackLimit" default.
+static const unsigned kSaxReaderStackLimit = 1000;
+
+// When a token straddles chunks, the carried text grows by at least this
+// much (and otherwise doubles) before the token is scanned again.
+static const size_t kSaxReaderMinCarryGrowth = 64;
+
+SaxReader::SaxReader(SaxHandler& handler)
+    : handler_(handler), stackLimit_(kSaxReaderStackLimit) {
+  reset();
+}
+
+void SaxReader::reset() {
+  status_ = statusParsing;
+  mode_ = modeValue;
+  stack_.clear();
+  window_ = NULL;
+  windowOffset_ = 0;
+  fedOffset_ = 0;
+  carry_.clear();
+  carryOffset_ = 0;
+  countedOffset_ = 0;
+  line_ = 0;
+  lineStartOffset_ = 0;
+  lastWasCR_ = false;
+  errors_.clear();
+}
+
+bool SaxReader::feed(char const* begin, char const* end) {
+  if (status_ != statusParsing)
+    return status_ != statusFailed;
+  size_t chunkOffset = fedOffset_;
+  size_t chunkSize = size_t(end - begin);
+  fedOffset_ += chunkSize;
+
+  if (!carry_.empty()) {
+    // Finish the token the last chunk cut off before going back to scanning
+    // the caller's buffer in place.
+    size_t taken = 0;
+    for (;;) {
+      size_t take = std::min(chunkSize - taken,
+                             std::max(carry_.size(), kSaxReaderMinCarryGrowth));
+      carry_.append(begin + taken, take);
+      taken += take;
+      window_ = carry_.data();
+      windowOffset_ = carryOffset_;
+      Location stopAt = run(window_, window_ + carry_.size(), false, true);
+      if (status_ != statusParsing)
+        return status_ != statusFailed;
+      if (stopAt != window_) {
+        size_t consumed = offsetOf(stopAt);
+        countLines(consumed);
+        carry_.clear();
+        begin += consumed - chunkOffset;
+        break;
+      }
+      if (taken == chunkSize)
+        return true;
+    }
+  }
+
+  window_ = begin;
+  windowOffset_ = fedOffset_ - size_t(end - begin);
+  Location stopAt = run(begin, end, false, false);
+  if (status_ == statusParsing) {
+    countLines(offsetOf(stopAt));
+    if (stopAt != end) {
+      carryOffset_ = offsetOf(stopAt);
+      carry_.assign(stopAt, end);
+    }
+  }
+  return status_ != statusFailed;
+}
+
+bool SaxReader::finish() {
+  if (status_ == statusParsing) {
+    static const Char empty = 0;
+    if (carry_.empty()) {
+      window_ = &empty;
+      windowOffset_ = fedOffset_;
+      run(window_, window_, true, false);
+    } else {
+      window_ = carry_.data();
+      windowOffset_ = carryOffset_;
+      run(window_, window_ + carry_.size(), true, false);
+    }
+    carry_.clear();
+  }
+  return status_ == statusComplete || status_ == statusStopped;
+}
+
+bool SaxReader::parse(char const* beginDoc, char const* endDoc) {
+  reset();
+  // With the whole document in hand nothing can be cut off, so it is read
+  // as a single final window and lines are only counted if there is an error.
+  window_ = beginDoc;
+  fedOffset_ = size_t(endDoc - beginDoc);
+  run(beginDoc, endDoc, true, false);
+  return status_ == statusComplete || status_ == statusStopped;
+}
+
+std::string SaxReader::getFormattedErrorMessages() const { return errors_; }
+
+// Reads tokens from [begin, end) until the document is complete, the parse
+// stops or the input runs out. Returns where reading stopped: the start of a
+// token that needs more input to be scanned, or end.
+SaxReader::Location SaxReader::run(Location begin, Location end, bool final,
+                                   bool singleToken) {
+  Location current = begin;
+  while (status_ == statusParsing) {
+    while (current != end) {
+      Char c = *current;
+      if (c == ' ' || c == '\t' || c == '\r' || c == '\n')
+        ++current;
+      else
+        break;
+    }
+    if (mode_ == modeArrayFirst) {
+      // Like OurReader, only spaces (not comments) may separate an empty
+      // array's brackets.
+      if (current == end && !final)
+        return current;
+      if (current != end && *current == ']') {
+        ++current;
+        stack_.pop_back();
+        if (!stop(handler_.onEndArray()) || !valueDone() || singleToken)
+          break;
+        continue;
+      }
+      mode_ = modeValue;
+    }
+    Token token;
+    token.start_ = current;
+    // No single quotes or special floats, as in a default CharReaderBuilder.
+    token.type_ =
+        scanJsonToken(current, end, final, false, false, &token.end_);
+    if (token.type_ == jsonTokenIncomplete)
+      return current;
+    if (!dispatch(token, current) || singleToken)
+      break;
+  }
+  return current;
+}
+
+// Applies one token to the grammar, the way OurReader's readValue(),
+// readObject() and readArray() would have consumed it.
+bool SaxReader::dispatch(Token& token, Location& current) {
+  current = token.end_;
+  switch (mode_) {
+  case modeValue:
+    if (token.type_ == jsonTokenComment)
+      return true;
+    if (stack_.size() >= stackLimit_)
+      return addError("Exceeded stackLimit in readValue().", token);
+    switch (token.type_) {
+    case jsonTokenObjectBegin:
+      stack_.push_back(frameObjectEmptyKey);
+      mode_ = modeKey;
+      return stop(handler_.onStartObject());
+    case jsonTokenArrayBegin:
+      stack_.push_back(frameArray);
+      mode_ = modeArrayFirst;
+      return stop(handler_.onStartArray());
+    case jsonTokenNumber:
+      return decodeNumber(token) && valueDone();
+    case jsonTokenString: {
+      char const* begin;
+      char const* end;
+      return decodeString(token, &begin, &end) &&
+             stop(handler_.onString(begin, end)) && valueDone();
+    }
+    case jsonTokenTrue:
+      return stop(handler_.onBool(true)) && valueDone();
+    case jsonTokenFalse:
+      return stop(handler_.onBool(false)) && valueDone();
+    case jsonTokenNull:
+      return stop(handler_.onNull()) && valueDone();
+    default:
+      return addError("Syntax error: value, object or array expected.", token);
+    }
+
+  case modeArrayFirst:
+  case modeArrayNext:
+    if (token.type_ == jsonTokenComment)
+      return true;
+    if (token.type_ == jsonTokenArraySeparator) {
+      mode_ = modeValue;
+      return true;
+    }
+    if (token.type_ == jsonTokenArrayEnd) {
+      stack_.pop_back();
+      return stop(handler_.onEndArray()) && valueDone();
+    }
+    return addError("Missing ',' or ']' in array declaration", token);
+
+  case modeKey: {
+    if (token.type_ == jsonTokenComment)
+      return true;
+    if (token.type_ == jsonTokenObjectEnd && stack_.back() == frameObjectEmptyKey) {
+      stack_.pop_back();
+      return stop(handler_.onEndObject()) && valueDone();
+    }
+    if (token.type_ != jsonTokenString)
+      return addError("Missing '}' or object member name", token);
+    char const* begin;
+    char const* end;
+    if (!decodeString(token, &begin, &end))
+      return false;
+    if (size_t(end - begin) >= (1U << 30))
+      return addError("keylength >= 2^30", token);
+    stack_.back() = begin == end ? frameObjectEmptyKey : frameObject;
+    mode_ = modeColon;
+    return stop(handler_.onKey(begin, end));
+  }
+
+  case modeColon:
+    if (token.type_ != jsonTokenMemberSeparator)
+      return addError("Missing ':' after object member name", token);
+    mode_ = modeValue;
+    return true;
+
+  case modeObjectNext:
+  case modeObjectComment:
+    if (token.type_ == jsonTokenObjectEnd) {
+      stack_.pop_back();
+      return stop(handler_.onEndObject()) && valueDone();
+    }
+    if (token.type_ == jsonTokenComment) {
+      mode_ = modeObjectComment;
+      return true;
+    }
+    if (mode_ == modeObjectNext && token.type_ != jsonTokenArraySeparator)
+      return addError("Missing ',' or '}' in object declaration", token);
+    // Once a comment has followed a member, OurReader takes whatever token
+    // comes next as the separator. The end of input is not consumed, so it
+    // is reported as a missing member name.
+    mode_ = modeKey;
+    if (token.type_ == jsonTokenEndOfStream && token.start_ == token.end_)
+      current = token.start_;
+    return true;
+  }
+  return true;
+}
+
+bool SaxReader::valueDone() {
+  if (stack_.empty()) {
+    status_ = statusComplete;
+    return false;
+  }
+  mode_ = stack_.back() == frameArray ? modeArrayNext : modeObjectNext;
+  return true;
+}
+
+bool SaxReader::stop(bool keepGoing) {
+  if (!keepGoing)
+    status_ = statusStopped;
+  return keepGoing;
+}
+
+bool SaxReader::decodeNumber(Token& token) {
+  // Attempts to parse the number as an integer. If the number is
+  // larger than the maximum supported value of an integer then
+  // we decode the number as a double.
+  Location current = token.start_;
+  bool isNegative = *current == '-';
+  if (isNegative)
+    ++current;
+  // Negate in the unsigned domain: -minLargestInt does not fit a LargestInt.
+  Value::LargestUInt maxIntegerValue =
+      isNegative
+          ? Value::LargestUInt(0) - Value::LargestUInt(Value::minLargestInt)
+          : Value::maxLargestUInt;
+  Value::LargestUInt threshold = maxIntegerValue / 10;
+  Value::LargestUInt value = 0;
+  while (current < token.end_) {
+    Char c = *current++;
+    if (c < '0' || c > '9')
+      return decodeDouble(token);
+    Value::UInt digit(c - '0');
+    if (value >= threshold) {
+      // We've hit or exceeded the max value divided by 10 (rounded down). If
+      // a) we've only just touched the limit, b) this is the last digit, and
+      // c) it's small enough to fit in that rounding delta, we're okay.
+      // Otherwise treat this number as a double to avoid overflow.
+      if (value > threshold || current != token.end_ ||
+          digit > maxIntegerValue % 10) {
+        return decodeDouble(token);
+      }
+    }
+    value = value * 10 + digit;
+  }
+  if (isNegative)
+    return stop(
+        handler_.onInt(Value::LargestInt(Value::LargestUInt(0) - value)));
+  if (value <= Value::LargestUInt(Value::maxInt))
+    return stop(handler_.onInt(Value::LargestInt(value)));
+  return stop(handler_.onUInt(value));
+}
+
+bool SaxReader::decodeDouble(Token& token) {
+  // strtod() is what sscanf("%lf") uses underneath; calling it directly skips
+  // the format parsing, which dominates for short number tokens.
+  const int bufferSize = 32;
+  size_t length = size_t(token.end_ - token.start_);
+  char* end;
+  double value;
+  if (length <= size_t(bufferSize)) {
+    Char buffer[bufferSize + 1];
+    memcpy(buffer, token.start_, length);
+    buffer[length] = 0;
+    value = strtod(buffer, &end);
+    end = end == buffer ? NULL : end;
+  } else {
+    std::string buffer(token.start_, token.end_);
+    value = strtod(buffer.c_str(), &end);
+    end = end == buffer.c_str() ? NULL : end;
+  }
+
+  if (!end)
+    return addError("'" + std::string(token.start_, token.end_) +
+                        "' is not a number.",
+                    token);
+  return stop(handler_.onDouble(value));
+}
+
+// Writes cp as UTF-8 the way codePointToUTF8() does, without the temporary.
+static inline void appendSaxUTF8(std::string& out, unsigned int cp) {
+  if (cp <= 0x7f) {
+    out += static_cast<char>(cp);
+  } else if (cp <= 0x7FF) {
+    out += static_cast<char>(0xC0 | (0x1f & (cp >> 6)));
+    out += static_cast<char>(0x80 | (0x3f & cp));
+  } else if (cp <= 0xFFFF) {
+    out += static_cast<char>(0xE0 | (0xf & (cp >> 12)));
+    out += static_cast<char>(0x80 | (0x3f & (cp >> 6)));
+    out += static_cast<char>(0x80 | (0x3f & cp));
+  } else if (cp <= 0x10FFFF) {
+    out += static_cast<char>(0xF0 | (0x7 & (cp >> 18)));
+    out += static_cast<char>(0x80 | (0x3f & (cp >> 12)));
+    out += static_cast<char>(0x80 | (0x3f & (cp >> 6)));
+    out += static_cast<char>(0x80 | (0x3f & cp));
+  }
+}
+
+bool SaxReader::decodeString(Token& token, char const** decodedBegin,
+                             char const** decodedEnd) {
+  Location current = token.start_ + 1; // skip '"'
+  Location end = token.end_ - 1;       // do not include '"'
+  Location escape =
+      static_cast<Location>(memchr(current, '\\', size_t(end - current)));
+  if (!escape) {
+    // Nothing to decode, so hand out the input itself.
+    *decodedBegin = current;
+    *decodedEnd = end;
+    return true;
+  }
+
+  scratch_.assign(current, escape);
+  current = escape;
+  while (current != end) {
+    Char c = *current++;
+    if (c == '\\') {
+      if (current == end)
+        return addError("Empty escape sequence in string", token, current);
+      Char escape = *current++;
+      switch (escape) {
+      case '"':
+        scratch_ += '"';
+        break;
+      case '/':
+        scratch_ += '/';
+        break;
+      case '\\':
+        scratch_ += '\\';
+        break;
+      case 'b':
+        scratch_ += '\b';
+        break;
+      case 'f':
+        scratch_ += '\f';
+        break;
+      case 'n':
+        scratch_ += '\n';
+        break;
+      case 'r':
+        scratch_ += '\r';
+        break;
+      case 't':
+        scratch_ += '\t';
+        break;
+      case 'u': {
+        unsigned int unicode;
+        if (!decodeUnicodeCodePoint(token, current, end, unicode))
+          return false;
+        appendSaxUTF8(scratch_, unicode);
+      } break;
+      default:
+        return addError("Bad escape sequence in string", token, current);
+      }
+    } else {
+      scratch_ += c;
+    }
+  }
+  *decodedBegin = scratch_.data();
+  *decodedEnd = scratch_.data() + scratch_.size();
+  return true;
+}
+
+bool SaxReader::decodeUnicodeCodePoint(Token& token,
+                                       Location& current,
+                                       Location end,
+                                       unsigned int& unicode) {
+
+  if (!decodeUnicodeEscapeSequence(token, current, end, unicode))
+    return false;
+  if (unicode >= 0xD800 && unicode <= 0xDBFF) {
+    // surrogate pairs
+    if (end - current < 6)
+      return addError(
+          "additional six characters expected to parse unicode surrogate pair.",
+          token,
+          current);
+    unsigned int surrogatePair;
+    if (*(current++) == '\\' && *(current++) == 'u') {
+      if (decodeUnicodeEscapeSequence(token, current, end, surrogatePair)) {
+        unicode = 0x10000 + ((unicode & 0x3FF) << 10) + (surrogatePair & 0x3FF);
+      } else
+        return false;
+    } else
+      return addError("expecting another \\u token to begin the second half of "
+                      "a unicode surrogate pair",
+                      token,
+                      current);
+  }
+  return true;
+}
+
+bool SaxReader::decodeUnicodeEscapeSequence(Token& token,
+                                            Location& current,
+                                            Location end,
+                                            unsigned int& unicode) {
+  if (end - current < 4)
+    return addError(
+        "Bad unicode escape sequence in string: four digits expected.",
+        token,
+        current);
+  unicode = 0;
+  for (int index = 0; index < 4; ++index) {
+    Char c = *current++;
+    unicode *= 16;
+    if (c >= '0' && c <= '9')
+      unicode += c - '0';
+    else if (c >= 'a' && c <= 'f')
+      unicode += c - 'a' + 10;
+    else if (c >= 'A' && c <= 'F')
+      unicode += c - 'A' + 10;
+    else
+      return addError(
+          "Bad unicode escape sequence in string: hexadecimal digit expected.",
+          token,
+          current);
+  }
+  return true;
+}
+
+bool SaxReader::addError(const std::string& message, Token& token,
+                         Location extra) {
+  // Parsing stops at the first error, so there is only ever one to report.
+  status_ = statusFailed;
+  errors_ = "* " + getLocationLineAndColumn(offsetOf(token.start_)) + "\n";
+  errors_ += "  " + message + "\n";
+  if (extra)
+    errors_ +=
+        "See " + getLocationLineAndColumn(offsetOf(extra)) + " for detail.\n";
+  return false;
+}
+
+// Advances the line count over the current window up to uptoOffset. Lines end
+// at "\n", "\r\n" or a lone "\r", as in Reader::getLocationLineAndColumn().
+void SaxReader::countLines(size_t uptoOffset) {
+  if (uptoOffset <= countedOffset_)
+    return;
+  Location begin = window_ + (countedOffset_ - windowOffset_);
+  Location end = window_ + (uptoOffset - windowOffset_);
+  for (Location p = begin; p != end; ++p) {
+    if (static_cast<unsigned char>(*p) > '\r')
+      continue;
+    if (*p == '\n') {
+      if (!(p == begin ? lastWasCR_ : p[-1] == '\r'))
+        ++line_;
+      lineStartOffset_ = offsetOf(p) + 1;
+    } else if (*p == '\r') {
+      ++line_;
+      lineStartOffset_ = offsetOf(p) + 1;
+    }
+  }
+  lastWasCR_ = end[-1] == '\r';
+  countedOffset_ = uptoOffset;
+}
+
+std::string SaxReader::getLocationLineAndColumn(size_t offset) {
+  countLines(offset);
+  char buffer[18 + 16 + 16 + 1];
+  snprintf(buffer, sizeof(buffer), "Line %d, Column %d", line_ + 1,
+           int(offset - lineStartOffset_) + 1);
+  return buffer;
+}
+
+} // namespace Json
@@ -9,6 +9,11 @@
 #include <vrcore/strtools_public.h>
 #include <vrcore/vrpathregistry_public.h>
 #include <mutex>
+#include <chrono>
+#include <atomic>
+#include <condition_variable>
+#include <thread>
+#include <string.h>
 
 using vr::EVRInitError;
 using vr::IVRSystem;
@@ -42,21 +47,226 @@ static std::recursive_mutex g_mutexSystem;
 
 typedef void* (*VRClientCoreFactoryFn)(const char *pInterfaceName, int *pReturnCode);
 
-static uint32_t g_nVRToken = 0;
+static std::atomic<uint32_t> g_nVRToken( 0 );
 
 uint32_t VR_GetInitToken()
 {
-	return g_nVRToken;
+	return g_nVRToken.load( std::memory_order_acquire );
+}
+
+
+// -------------------------------------------------------------------------------
+// Purpose: Cache of interfaces handed out by vrclient so that VR_GetGenericInterface
+//			and VR_IsInterfaceVersionValid can be answered from any thread without
+//			taking g_mutexSystem. Entries are only written with g_mutexSystem held
+//			and are only valid for the init token they were stored under, so
+//			nothing cached before VR_Shutdown is returned once it starts.
+// -------------------------------------------------------------------------------
+static const uint32_t k_unInterfaceCacheSize = 64;	// must be a power of two
+static const uint32_t k_unMaxCachedVersionLength = 64;	// longer versions always take the slow path
+
+struct InterfaceCacheEntry_t
+{
+	char rchVersion[ k_unMaxCachedVersionLength ];	// written once, before pchVersion is set
+	std::atomic<const char *> pchVersion;	// NULL until rchVersion is filled in, then rchVersion
+	std::atomic<uint32_t> unToken;			// 0 while the entry is being written
+	std::atomic<void *> pInterface;			// NULL if only the version has been validated
+};
+
+static InterfaceCacheEntry_t g_rInterfaceCache[ k_unInterfaceCacheSize ];
+
+static uint32_t HashInterfaceVersion( const char *pchInterfaceVersion )
+{
+	// FNV-1a
+	uint32_t unHash = 2166136261u;
+	for ( const char *pch = pchInterfaceVersion; *pch; pch++ )
+	{
+		unHash = ( unHash ^ (uint8_t)*pch ) * 16777619u;
+	}
+	return unHash;
+}
+
+static InterfaceCacheEntry_t *FindInterfaceCacheEntry( const char *pchInterfaceVersion )
+{
+	uint32_t unHash = HashInterfaceVersion( pchInterfaceVersion );
+	for ( uint32_t i = 0; i < k_unInterfaceCacheSize; i++ )
+	{
+		InterfaceCacheEntry_t & entry = g_rInterfaceCache[ ( unHash + i ) & ( k_unInterfaceCacheSize - 1 ) ];
+		const char *pchEntryVersion = entry.pchVersion.load( std::memory_order_acquire );
+		if ( !pchEntryVersion )
+			return NULL;
+		if ( !strcmp( pchEntryVersion, pchInterfaceVersion ) )
+			return &entry;
+	}
+	return NULL;
+}
+
+/** Returns true if the version is cached for the current init token. May be called without g_mutexSystem. */
+static bool LookupCachedInterface( const char *pchInterfaceVersion, void **ppInterface )
+{
+	if ( !pchInterfaceVersion )
+		return false;
+
+	uint32_t unCurrentToken = g_nVRToken.load( std::memory_order_acquire );
+	InterfaceCacheEntry_t *pEntry = FindInterfaceCacheEntry( pchInterfaceVersion );
+	if ( !pEntry )
+		return false;
+
+	uint32_t unEntryToken = pEntry->unToken.load( std::memory_order_acquire );
+	if ( unEntryToken == 0 || unEntryToken != unCurrentToken )
+		return false;
+
+	void *pInterface = pEntry->pInterface.load( std::memory_order_relaxed );
+
+	// make sure the entry wasn't rewritten for a later init while we were reading it
+	std::atomic_thread_fence( std::memory_order_acquire );
+	if ( pEntry->unToken.load( std::memory_order_relaxed ) != unEntryToken )
+		return false;
+
+	*ppInterface = pInterface;
+	return true;
+}
+
+/** Records a valid interface version (and the interface itself if known). Caller must hold g_mutexSystem. */
+static void StoreCachedInterface( const char *pchInterfaceVersion, void *pInterface )
+{
+	if ( !pchInterfaceVersion )
+		return;
+
+	size_t unVersionLength = strlen( pchInterfaceVersion );
+	if ( unVersionLength >= k_unMaxCachedVersionLength )
+		return;
+
+	uint32_t unHash = HashInterfaceVersion( pchInterfaceVersion );
+	InterfaceCacheEntry_t *pEntry = NULL;
+	for ( uint32_t i = 0; i < k_unInterfaceCacheSize && !pEntry; i++ )
+	{
+		InterfaceCacheEntry_t & entry = g_rInterfaceCache[ ( unHash + i ) & ( k_unInterfaceCacheSize - 1 ) ];
+		const char *pchEntryVersion = entry.pchVersion.load( std::memory_order_relaxed );
+		if ( !pchEntryVersion )
+		{
+			memcpy( entry.rchVersion, pchInterfaceVersion, unVersionLength + 1 );
+			entry.pchVersion.store( entry.rchVersion, std::memory_order_release );
+			pEntry = &entry;
+		}
+		else if ( !strcmp( pchEntryVersion, pchInterfaceVersion ) )
+		{
+			pEntry = &entry;
+		}
+	}
+
+	// the cache is full, so this version will always take the slow path
+	if ( !pEntry )
+		return;
+
+	uint32_t unCurrentToken = g_nVRToken.load( std::memory_order_relaxed );
+	if ( !pInterface && pEntry->unToken.load( std::memory_order_relaxed ) == unCurrentToken )
+	{
+		// don't throw away an interface we already have for this init
+		return;
+	}
+
+	pEntry->unToken.store( 0, std::memory_order_relaxed );
+	std::atomic_thread_fence( std::memory_order_release );
+	pEntry->pInterface.store( pInterface, std::memory_order_relaxed );
+	pEntry->unToken.store( unCurrentToken, std::memory_order_release );
 }
 
 EVRInitError VR_LoadHmdSystemInternal();
 void CleanupInternalInterfaces();
 
+// -------------------------------------------------------------------------------
+// Purpose: State kept between VR_IsHmdPresent/VR_IsRuntimeInstalled calls made
+//			outside of VR_Init/VR_Shutdown. vrclient stays loaded between probes
+//			and is only dropped when the path registry (or the runtime override)
+//			changes, or when VR_ReleaseHmdPresentProbe is called.
+// -------------------------------------------------------------------------------
+struct HmdPresentProbe_t
+{
+	// what the cached state was resolved from
+	bool bKeyValid = false;
+	std::string sRegistryFilename;
+	PathFileStamp_t registryStamp = {};
+	std::string sRuntimeOverride;
+
+	// resolved from the key
+	bool bReadPathRegistry = false;
+	std::string sRuntimePath;
 
-uint32_t VR_InitInternal2( EVRInitError *peError, vr::EVRApplicationType eApplicationType, const char *pStartupInfo )
+	void *pModule = nullptr;
+	IVRClientCore *pClientCore = nullptr;
+
+	bool bHasHmdResult = false;
+	bool bHmdPresent = false;
+	std::chrono::steady_clock::time_point timeHmdResult;
+
+	// Drops the resident vrclient at process exit. The shared library registry is
+	// never destroyed, so unloading from a static destructor is safe.
+	~HmdPresentProbe_t()
+	{
+		pClientCore = nullptr;
+		if ( pModule )
+		{
+			SharedLib_Unload( pModule );
+			pModule = nullptr;
+		}
+	}
+};
+
+static HmdPresentProbe_t g_hmdPresentProbe;
+static uint32_t g_unHmdPresentProbeTTLMs = 0;
+
+// -------------------------------------------------------------------------------
+// Purpose: State for the single VR_InitAsyncInternal call that may be in flight.
+//			Protected by its own mutex so polling never waits on g_mutexSystem.
+//			The worker thread is owned here and joined by VR_ShutdownInternal,
+//			by the next VR_InitAsyncInternal, or at process exit.
+// -------------------------------------------------------------------------------
+struct InitAsyncState_t
+{
+	std::mutex mutex;
+	std::condition_variable condComplete;
+	std::thread worker;
+	std::thread::id threadId;	// the worker's id until it (and its callback) are done
+
+	bool bPending = false;		// started and the result hasn't been collected yet
+	bool bComplete = false;
+	EVRInitError eError = VRInitError_None;
+	uint32_t unToken = 0;
+
+	~InitAsyncState_t()
+	{
+		if ( !worker.joinable() )
+			return;
+
+		// exit() called from the init callback can't wait for itself
+		if ( worker.get_id() == std::this_thread::get_id() )
+			worker.detach();
+		else
+			worker.join();
+	}
+};
+
+static InitAsyncState_t &InitAsyncState()
+{
+	static InitAsyncState_t s_state;
+	return s_state;
+}
+
+static void VR_WaitForInitAsync();
+
+
+// -------------------------------------------------------------------------------
+// Purpose: Loads and initializes vrclient. Shared by VR_InitInternal2 and the
+//			VR_InitAsyncInternal worker.
+// -------------------------------------------------------------------------------
+static uint32_t VR_InitSystemInternal( EVRInitError *peError, vr::EVRApplicationType eApplicationType, const char *pStartupInfo )
 {
 	std::lock_guard<std::recursive_mutex> lock( g_mutexSystem );
 
+	// pick up path overrides the application set with setenv rather than SetEnvironmentVariable
+	RefreshEnvironmentSnapshot();
+
 	EVRInitError err = VR_LoadHmdSystemInternal();
 	if ( err == vr::VRInitError_None )
 	{
@@ -72,12 +282,32 @@ uint32_t VR_InitInternal2( EVRInitError *peError, vr::EVRApplicationType eApplic
 		g_pHmdSystem = NULL;
 		g_pVRModule = NULL;
 
+		// anything cached from an earlier init went away with the module
+		++g_nVRToken;
+
 		return 0;
 	}
 
 	return ++g_nVRToken;
 }
 
+uint32_t VR_InitInternal2( EVRInitError *peError, vr::EVRApplicationType eApplicationType, const char *pStartupInfo )
+{
+	// If an async init is still running, wait for it and take over its result rather
+	// than loading vrclient a second time underneath it.
+	EVRInitError eAsyncError = VRInitError_Init_NotInitialized;
+	uint32_t unAsyncToken = 0;
+	VR_PollInitAsyncInternal( true, &eAsyncError, &unAsyncToken );
+	if ( eAsyncError == VRInitError_None )
+	{
+		if ( peError )
+			*peError = VRInitError_None;
+		return unAsyncToken;
+	}
+
+	return VR_InitSystemInternal( peError, eApplicationType, pStartupInfo );
+}
+
 VR_INTERFACE uint32_t VR_CALLTYPE VR_InitInternal( EVRInitError *peError, EVRApplicationType eApplicationType );
 
 uint32_t VR_InitInternal( EVRInitError *peError, vr::EVRApplicationType eApplicationType )
@@ -87,8 +317,15 @@ uint32_t VR_InitInternal( EVRInitError *peError, vr::EVRApplicationType eApplica
 
 void VR_ShutdownInternal()
 {
+	// an init still running in the background would otherwise complete after we shut down
+	VR_WaitForInitAsync();
+
 	std::lock_guard<std::recursive_mutex> lock( g_mutexSystem );
 
+	// retire everything in the interface cache before vrclient starts tearing it down, so a
+	// lock-free lookup on another thread can't hand out an interface that's being destroyed
+	++g_nVRToken;
+
 #if !defined( VR_API_PUBLIC )
 	CleanupInternalInterfaces();
 #endif
@@ -104,20 +341,13 @@ void VR_ShutdownInternal()
 		SharedLib_Unload( g_pVRModule );
 		g_pVRModule = NULL;
 	}
-
-	++g_nVRToken;
 }
 
-EVRInitError VR_LoadHmdSystemInternal()
+// -------------------------------------------------------------------------------
+// Purpose: Computes where vrclient lives for the specified runtime path
+// -------------------------------------------------------------------------------
+static EVRInitError VR_GetClientDLLPath( const std::string & sRuntimePath, std::string *psDLLPath )
 {
-	std::string sRuntimePath, sConfigPath, sLogPath;
-
-	bool bReadPathRegistry = CVRPathRegistry_Public::GetPaths( &sRuntimePath, &sConfigPath, &sLogPath, NULL, NULL );
-	if( !bReadPathRegistry )
-	{
-		return vr::VRInitError_Init_PathRegistryNotFound;
-	}
-
 	// figure out where we're going to look for vrclient.dll
 	// see if the specified path actually exists.
 	if( !Path_IsDirectory( sRuntimePath ) )
@@ -138,11 +368,28 @@ EVRInitError VR_LoadHmdSystemInternal()
 	}
 
 #if defined( WIN64 )
-	std::string sDLLPath = Path_Join( sTestPath, "vrclient_x64" DYNAMIC_LIB_EXT );
+	*psDLLPath = Path_Join( sTestPath, "vrclient_x64" DYNAMIC_LIB_EXT );
 #else
-	std::string sDLLPath = Path_Join( sTestPath, "vrclient" DYNAMIC_LIB_EXT );
+	*psDLLPath = Path_Join( sTestPath, "vrclient" DYNAMIC_LIB_EXT );
 #endif
 
+	return VRInitError_None;
+}
+
+
+// -------------------------------------------------------------------------------
+// Purpose: Loads vrclient from the specified runtime path and gets its client
+//			core interface. Nothing is left loaded on failure.
+// -------------------------------------------------------------------------------
+static EVRInitError VR_LoadClientCore( const std::string & sRuntimePath, void **ppModule, IVRClientCore **ppClientCore )
+{
+	std::string sDLLPath;
+	EVRInitError eError = VR_GetClientDLLPath( sRuntimePath, &sDLLPath );
+	if ( eError != VRInitError_None )
+	{
+		return eError;
+	}
+
 	// only look in the override
 	void *pMod = SharedLib_Load( sDLLPath.c_str() );
 	// nothing more to do if we can't load the DLL
@@ -159,20 +406,224 @@ EVRInitError VR_LoadHmdSystemInternal()
 	}
 
 	int nReturnCode = 0;
-	g_pHmdSystem = static_cast< IVRClientCore * > ( fnFactory( vr::IVRClientCore_Version, &nReturnCode ) );
-	if( !g_pHmdSystem )
+	IVRClientCore *pClientCore = static_cast< IVRClientCore * > ( fnFactory( vr::IVRClientCore_Version, &nReturnCode ) );
+	if( !pClientCore )
 	{
 		SharedLib_Unload( pMod );
 		return vr::VRInitError_Init_InterfaceNotFound;
 	}
 
-	g_pVRModule = pMod;
+	*ppModule = pMod;
+	*ppClientCore = pClientCore;
 	return VRInitError_None;
 }
 
 
+EVRInitError VR_LoadHmdSystemInternal()
+{
+	std::string sRuntimePath, sConfigPath, sLogPath;
+
+	bool bReadPathRegistry = CVRPathRegistry_Public::GetPaths( &sRuntimePath, &sConfigPath, &sLogPath, NULL, NULL );
+	if( !bReadPathRegistry )
+	{
+		return vr::VRInitError_Init_PathRegistryNotFound;
+	}
+
+	return VR_LoadClientCore( sRuntimePath, &g_pVRModule, &g_pHmdSystem );
+}
+
+
+// -------------------------------------------------------------------------------
+// Purpose: Body of the VR_InitAsyncInternal worker thread
+// -------------------------------------------------------------------------------
+static void VR_InitAsyncThread( EVRApplicationType eApplicationType, std::string sStartupInfo, bool bHasStartupInfo,
+	VRInitAsyncCallback_t pfnCallback, void *pUserData )
+{
+	// Resolve and map vrclient before taking g_mutexSystem, so other threads only
+	// wait for the part of init that actually needs the lock. Holding our own
+	// reference to the module makes the load inside VR_InitInternal2 a refcount bump.
+	void *pPreloadedModule = NULL;
+	std::string sRuntimePath, sDLLPath;
+	if ( CVRPathRegistry_Public::GetPaths( &sRuntimePath, NULL, NULL, NULL, NULL )
+		&& VR_GetClientDLLPath( sRuntimePath, &sDLLPath ) == VRInitError_None )
+	{
+		Path_PrefetchFile( sDLLPath );
+		pPreloadedModule = SharedLib_Load( sDLLPath.c_str() );
+	}
+
+	EVRInitError eError = VRInitError_None;
+	uint32_t unToken = VR_InitSystemInternal( &eError, eApplicationType, bHasStartupInfo ? sStartupInfo.c_str() : nullptr );
+
+	SharedLib_Unload( pPreloadedModule );
+
+	InitAsyncState_t & state = InitAsyncState();
+	{
+		std::lock_guard<std::mutex> lock( state.mutex );
+		state.eError = eError;
+		state.unToken = unToken;
+		state.bComplete = true;
+	}
+	state.condComplete.notify_all();
+
+	if ( pfnCallback )
+	{
+		pfnCallback( eError, pUserData );
+	}
+
+	std::lock_guard<std::mutex> lock( state.mutex );
+	state.threadId = std::thread::id();
+	state.condComplete.notify_all();
+}
+
+
+// -------------------------------------------------------------------------------
+// Purpose: Blocks until any async init (including its callback) has finished
+//			and joins its thread, unless we're being called from that callback.
+// -------------------------------------------------------------------------------
+static void VR_WaitForInitAsync()
+{
+	InitAsyncState_t & state = InitAsyncState();
+	std::unique_lock<std::mutex> lock( state.mutex );
+	if ( state.threadId == std::this_thread::get_id() )
+		return;
+
+	state.condComplete.wait( lock, [&state]() { return state.threadId == std::thread::id(); } );
+
+	// a result nobody collected belongs to an init that is about to be shut down
+	state.bPending = false;
+
+	// the worker has nothing left to do but return, so join it outside the lock
+	std::thread worker = std::move( state.worker );
+	lock.unlock();
+	if ( worker.joinable() )
+		worker.join();
+}
+
+
+EVRInitError VR_InitAsyncInternal( EVRApplicationType eApplicationType, const char *pStartupInfo, VRInitAsyncCallback_t pfnCallback, void *pUserData )
+{
+	InitAsyncState_t & state = InitAsyncState();
+	std::lock_guard<std::mutex> lock( state.mutex );
+
+	if ( state.bPending || state.threadId != std::thread::id() )
+	{
+		return vr::VRInitError_Init_AlreadyRunning;
+	}
+
+	// the previous worker has finished its callback and is only returning
+	if ( state.worker.joinable() )
+		state.worker.join();
+
+	state.bPending = true;
+	state.bComplete = false;
+	state.eError = VRInitError_None;
+	state.unToken = 0;
+
+	state.worker = std::thread( VR_InitAsyncThread, eApplicationType, std::string( pStartupInfo ? pStartupInfo : "" ), pStartupInfo != nullptr,
+		pfnCallback, pUserData );
+	state.threadId = state.worker.get_id();
+
+	return VRInitError_None;
+}
+
+
+bool VR_PollInitAsyncInternal( bool bWait, EVRInitError *peError, uint32_t *punToken )
+{
+	InitAsyncState_t & state = InitAsyncState();
+	std::unique_lock<std::mutex> lock( state.mutex );
+
+	if ( !state.bPending )
+	{
+		// nothing to wait for
+		if ( peError )
+			*peError = vr::VRInitError_Init_NotInitialized;
+		if ( punToken )
+			*punToken = 0;
+		return true;
+	}
+
+	if ( bWait && state.threadId != std::this_thread::get_id() )
+	{
+		state.condComplete.wait( lock, [&state]() { return state.bComplete; } );
+	}
+
+	if ( !state.bComplete )
+	{
+		return false;
+	}
+
+	state.bPending = false;
+	if ( peError )
+		*peError = state.eError;
+	if ( punToken )
+		*punToken = state.unToken;
+	return true;
+}
+
+
+// -------------------------------------------------------------------------------
+// Purpose: Unloads the vrclient kept resident by the HMD present probe
+// -------------------------------------------------------------------------------
+static void VR_UnloadHmdPresentProbe()
+{
+	HmdPresentProbe_t & probe = g_hmdPresentProbe;
+
+	probe.pClientCore = nullptr;
+	if ( probe.pModule )
+	{
+		SharedLib_Unload( probe.pModule );
+		probe.pModule = nullptr;
+	}
+
+	probe.bHasHmdResult = false;
+}
+
+
+// -------------------------------------------------------------------------------
+// Purpose: Makes sure the probe state matches the current path registry file and
+//			runtime override, resolving the runtime path again if either changed.
+//			Caller must hold g_mutexSystem.
+// -------------------------------------------------------------------------------
+static void VR_RefreshHmdPresentProbe()
+{
+	HmdPresentProbe_t & probe = g_hmdPresentProbe;
+
+	// the key includes VR_PATHREG_OVERRIDE and VR_OVERRIDE, which the application may have set with setenv
+	RefreshEnvironmentSnapshot();
+	std::string sRegistryFilename = CVRPathRegistry_Public::GetVRPathRegistryFilename();
+	std::string sRuntimeOverride = GetEnvironmentVariable( k_pchRuntimeOverrideVar );
+	PathFileStamp_t registryStamp;
+	Path_GetFileStamp( sRegistryFilename, &registryStamp );
+
+	if ( probe.bKeyValid
+		&& probe.sRegistryFilename == sRegistryFilename
+		&& probe.sRuntimeOverride == sRuntimeOverride
+		&& probe.registryStamp == registryStamp )
+	{
+		return;
+	}
+
+	// the registry changed out from under us, so whatever vrclient we have loaded may be the wrong one
+	VR_UnloadHmdPresentProbe();
+
+	probe.sRegistryFilename = sRegistryFilename;
+	probe.sRuntimeOverride = sRuntimeOverride;
+	probe.registryStamp = registryStamp;
+	probe.bReadPathRegistry = CVRPathRegistry_Public::GetPaths( &probe.sRuntimePath, NULL, NULL, NULL, NULL );
+	probe.bKeyValid = true;
+}
+
+
 void *VR_GetGenericInterface(const char *pchInterfaceVersion, EVRInitError *peError)
 {
+	void *pInterface = NULL;
+	if ( LookupCachedInterface( pchInterfaceVersion, &pInterface ) && pInterface )
+	{
+		if (peError)
+			*peError = vr::VRInitError_None;
+		return pInterface;
+	}
+
 	std::lock_guard<std::recursive_mutex> lock( g_mutexSystem );
 
 	if (!g_pHmdSystem)
@@ -182,11 +633,26 @@ void *VR_GetGenericInterface(const char *pchInterfaceVersion, EVRInitError *peEr
 		return NULL;
 	}
 
-	return g_pHmdSystem->GetGenericInterface(pchInterfaceVersion, peError);
+	EVRInitError eError = vr::VRInitError_None;
+	pInterface = g_pHmdSystem->GetGenericInterface(pchInterfaceVersion, &eError);
+	if ( pInterface && eError == vr::VRInitError_None )
+	{
+		StoreCachedInterface( pchInterfaceVersion, pInterface );
+	}
+
+	if (peError)
+		*peError = eError;
+	return pInterface;
 }
 
 bool VR_IsInterfaceVersionValid(const char *pchInterfaceVersion)
 {
+	void *pInterface = NULL;
+	if ( LookupCachedInterface( pchInterfaceVersion, &pInterface ) )
+	{
+		return true;
+	}
+
 	std::lock_guard<std::recursive_mutex> lock( g_mutexSystem );
 
 	if (!g_pHmdSystem)
@@ -194,7 +660,13 @@ bool VR_IsInterfaceVersionValid(const char *pchInterfaceVersion)
 		return false;
 	}
 
-	return g_pHmdSystem->IsInterfaceVersionValid(pchInterfaceVersion) == VRInitError_None;
+	if ( g_pHmdSystem->IsInterfaceVersionValid(pchInterfaceVersion) != VRInitError_None )
+	{
+		return false;
+	}
+
+	StoreCachedInterface( pchInterfaceVersion, NULL );
+	return true;
 }
 
 bool VR_IsHmdPresent()
@@ -209,17 +681,31 @@ bool VR_IsHmdPresent()
 	else
 	{
 		// otherwise we need to do a bit more work
-		EVRInitError err = VR_LoadHmdSystemInternal();
-		if( err != VRInitError_None )
-			return false;
+		VR_RefreshHmdPresentProbe();
 
-		bool bHasHmd = g_pHmdSystem->BIsHmdPresent();
+		HmdPresentProbe_t & probe = g_hmdPresentProbe;
+		std::chrono::steady_clock::time_point timeNow = std::chrono::steady_clock::now();
+		if ( probe.bHasHmdResult && timeNow - probe.timeHmdResult < std::chrono::milliseconds( g_unHmdPresentProbeTTLMs ) )
+		{
+			return probe.bHmdPresent;
+		}
 
-		g_pHmdSystem = NULL;
-		SharedLib_Unload( g_pVRModule );
-		g_pVRModule = NULL;
+		if ( !probe.pClientCore )
+		{
+			if ( !probe.bReadPathRegistry
+				|| VR_LoadClientCore( probe.sRuntimePath, &probe.pModule, &probe.pClientCore ) != VRInitError_None )
+			{
+				probe.bHasHmdResult = true;
+				probe.bHmdPresent = false;
+				probe.timeHmdResult = timeNow;
+				return false;
+			}
+		}
 
-		return bHasHmd;
+		probe.bHasHmdResult = true;
+		probe.bHmdPresent = probe.pClientCore->BIsHmdPresent();
+		probe.timeHmdResult = timeNow;
+		return probe.bHmdPresent;
 	}
 }
 
@@ -236,17 +722,17 @@ bool VR_IsRuntimeInstalled()
 	else
 	{
 		// otherwise we need to do a bit more work
-		std::string sRuntimePath, sConfigPath, sLogPath;
+		VR_RefreshHmdPresentProbe();
 
-		bool bReadPathRegistry = CVRPathRegistry_Public::GetPaths( &sRuntimePath, &sConfigPath, &sLogPath, NULL, NULL );
-		if( !bReadPathRegistry )
+		HmdPresentProbe_t & probe = g_hmdPresentProbe;
+		if( !probe.bReadPathRegistry )
 		{
 			return false;
 		}
 
 		// figure out where we're going to look for vrclient.dll
 		// see if the specified path actually exists.
-		if( !Path_IsDirectory( sRuntimePath ) )
+		if( !Path_IsDirectory( probe.sRuntimePath ) )
 		{
 			return false;
 		}
@@ -256,6 +742,23 @@ bool VR_IsRuntimeInstalled()
 	}
 }
 
+/** Sets how long a VR_IsHmdPresent result is reused when called outside of VR_Init/VR_Shutdown. */
+void VR_SetHmdPresentProbeTTL( uint32_t unMilliseconds )
+{
+	std::lock_guard<std::recursive_mutex> lock( g_mutexSystem );
+
+	g_unHmdPresentProbeTTLMs = unMilliseconds;
+}
+
+/** Unloads the vrclient kept loaded by VR_IsHmdPresent, if any. */
+void VR_ReleaseHmdPresentProbe()
+{
+	std::lock_guard<std::recursive_mutex> lock( g_mutexSystem );
+
+	VR_UnloadHmdPresentProbe();
+	g_hmdPresentProbe.bKeyValid = false;
+}
+
 
 // -------------------------------------------------------------------------------
 // Purpose: This is the old Runtime Path interface that is no longer exported in the
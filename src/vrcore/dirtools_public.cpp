@@ -104,10 +104,84 @@ bool BCreateDirectory( const char *pchPath )
 
 #include <vrcore/log.h>
 
+#if !defined( _WIN32 )
+#include <ctype.h>
+#include <dirent.h>
+#include <algorithm>
+#endif
+
 //-----------------------------------------------------------------------------
-CDirIterator::CDirIterator( const char *pchPath, const char *pchPattern )
+// Purpose: Case-insensitive wildcard match of a file name against a mask,
+//			with the same rules the old findfirst emulation used. . and ..
+//			never match.
+//-----------------------------------------------------------------------------
+static bool BMatchesFilePattern( const char *name, const char *mask )
 {
+	if ( !strcmp( name, "." ) || !strcmp( name, ".." ) )
+		return false;
+
+	if ( !strcmp( mask, "*.*" ) || !strcmp( mask, "*" ) )
+		return true;
+
+	while ( *mask && *name )
+	{
+		if ( *mask == '*' )
+		{
+			mask++;		  // move to the next char in the mask
+			if ( !*mask ) // if this is the end of the mask its a match
+			{
+				return true;
+			}
+			while ( *name && toupper( *name ) != toupper( *mask ) )
+			{ // while the two don't meet up again
+				name++;
+			}
+			if ( !*name )
+			{ // end of the name
+				break;
+			}
+		}
+		else if ( *mask != '?' )
+		{
+			if ( toupper( *mask ) != toupper( *name ) )
+			{ // mismatched!
+				return false;
+			}
+			else
+			{
+				mask++;
+				name++;
+				if ( !*mask && !*name )
+				{ // if its at the end of the buffer
+					return true;
+				}
+			}
+		}
+		else /* mask is "?", we don't care*/
+		{
+			mask++;
+			name++;
+		}
+	}
+
+	return ( !*mask && !*name ); // both of the strings are at the end
+}
+
+//-----------------------------------------------------------------------------
+CDirIterator::CDirIterator( const char *pchPath, const char *pchPattern, bool bRecursive )
+{
+	m_bRecursive = bRecursive;
+	m_pChild = NULL;
+	m_bChildIsCurrent = false;
+
+#if defined( _WIN32 )
 	m_pFindData = NULL;
+#else
+	m_bOpened = false;
+	m_unCurrent = 0;
+	m_bStatDone = false;
+	m_bStatValid = false;
+#endif
 
 	// put in the path
 	if ( pchPath )
@@ -124,11 +198,8 @@ CDirIterator::CDirIterator( const char *pchPath, const char *pchPattern )
 #if defined( _WIN32 )
 		m_hFind = HMD_INVALID_HANDLE_VALUE;
 		m_pFindData = new WIN32_FIND_DATAW;
-#else
-		m_hFind = -1;
-		m_pFindData = new _finddata_t;
-#endif
 		memset( m_pFindData, 0, sizeof( *m_pFindData ) );
+#endif
 	}
 }
 
@@ -137,11 +208,20 @@ CDirIterator::CDirIterator( const char *pchPath, const char *pchPattern )
 //-----------------------------------------------------------------------------
 void CDirIterator::Init( const std::string &sPathAndPattern )
 {
+	m_sDir = Path_StripFilename( sPathAndPattern );
+	if ( m_sDir.empty() )
+		m_sDir = Path_GetSlash();
+	m_sPattern = Path_StripDirectory( sPathAndPattern );
+
+	// a recursive walk has to see every subdirectory, so there the pattern is
+	// applied as we go rather than by the listing
+	const char *pchListingPattern = m_bRecursive ? "*" : m_sPattern.c_str();
+
 #if defined( _WIN32 )
 	m_pFindData = new WIN32_FIND_DATAW;
 	memset( m_pFindData, 0, sizeof( *m_pFindData ) );
 
-	std::wstring sWPathAndPattern = UTF8to16( sPathAndPattern.c_str() );
+	std::wstring sWPathAndPattern = UTF8to16( Path_Join( m_sDir, pchListingPattern ).c_str() );
 
 	m_hFind = FindFirstFileW( sWPathAndPattern.c_str(), m_pFindData );
 	bool bSuccess = ( m_hFind != HMD_INVALID_HANDLE_VALUE );
@@ -151,11 +231,31 @@ void CDirIterator::Init( const std::string &sPathAndPattern )
 		m_sFilename = UTF16to8( m_pFindData->cFileName );
 	}
 #else
-	m_pFindData = new _finddata_t;
-	memset( m_pFindData, 0, sizeof( *m_pFindData ) );
+	// Read just the names and types. Anything else is stat'ed on demand, which
+	// most callers never need.
+	DIR *pDir = opendir( m_sDir.c_str() );
+	if ( pDir )
+	{
+		while ( struct dirent *pEntry = readdir( pDir ) )
+		{
+			if ( !BMatchesFilePattern( pEntry->d_name, pchListingPattern ) )
+				continue;
 
-	m_hFind = _findfirst( sPathAndPattern.c_str(), m_pFindData );
-	bool bSuccess = ( m_hFind != -1 );
+			DirEntry_t entry;
+			entry.m_sName = pEntry->d_name;
+			entry.m_unType = pEntry->d_type;
+			m_vecEntries.push_back( entry );
+		}
+		closedir( pDir );
+
+		// same order scandir( alphasort ) used to give us
+		std::sort( m_vecEntries.begin(), m_vecEntries.end(),
+			[]( const DirEntry_t &a, const DirEntry_t &b ) { return strcoll( a.m_sName.c_str(), b.m_sName.c_str() ) < 0; } );
+	}
+
+	m_unCurrent = 0;
+	m_bOpened = !m_vecEntries.empty();
+	bool bSuccess = m_bOpened;
 #endif
 
 	if ( !bSuccess )
@@ -178,27 +278,14 @@ void CDirIterator::Init( const std::string &sPathAndPattern )
 //-----------------------------------------------------------------------------
 CDirIterator::~CDirIterator()
 {
+	delete m_pChild;
+
 #if defined( _WIN32 )
 	if ( m_hFind != HMD_INVALID_HANDLE_VALUE )
 	{
 		FindClose( m_hFind );
 	}
 	delete m_pFindData;
-#else
-	if ( m_hFind != -1 )
-	{
-		_findclose( m_hFind );
-	}
-	if ( m_pFindData )
-	{
-		for ( int i = 0; i < m_pFindData->numNames; i++ )
-		{
-			// scandir allocates with malloc, so free with free
-			free( m_pFindData->namelist[ i ] );
-		}
-		free( m_pFindData->namelist );
-		delete m_pFindData;
-	}
 #endif
 }
 
@@ -211,7 +298,7 @@ bool CDirIterator::IsValid() const
 #if defined( _WIN32 )
 	return m_hFind != HMD_INVALID_HANDLE_VALUE;
 #else
-	return m_hFind != -1;
+	return m_bOpened;
 #endif
 }
 
@@ -223,7 +310,7 @@ bool CDirIterator::BValidFilename()
 #if defined( _WIN32 )
 	const char *pch = m_sFilename.c_str();
 #else
-	const char *pch = m_pFindData->name;
+	const char *pch = m_unCurrent < m_vecEntries.size() ? m_vecEntries[ m_unCurrent ].m_sName.c_str() : "";
 #endif
 
 	if ( ( pch[ 0 ] == '.' && pch[ 1 ] == 0 ) || ( pch[ 0 ] == '.' && pch[ 1 ] == '.' && pch[ 2 ] == 0 ) )
@@ -233,10 +320,61 @@ bool CDirIterator::BValidFilename()
 }
 
 
+//-----------------------------------------------------------------------------
+// Purpose: Returns the iterator that owns the current file. In recursive mode
+//			that is the deepest subdirectory being walked.
+//-----------------------------------------------------------------------------
+const CDirIterator *CDirIterator::CurrentLevel() const
+{
+	if ( m_bChildIsCurrent && m_pChild )
+		return m_pChild->CurrentLevel();
+	return this;
+}
+
+
 //-----------------------------------------------------------------------------
 // Purpose: returns true if there is a file to read
 //-----------------------------------------------------------------------------
 bool CDirIterator::BNextFile()
+{
+	if ( !m_bRecursive )
+		return BNextFileInDir();
+
+	for ( ;; )
+	{
+		// finish walking the subdirectory we're in before moving on
+		if ( m_pChild )
+		{
+			if ( m_pChild->BNextFile() )
+			{
+				m_bChildIsCurrent = true;
+				return true;
+			}
+
+			delete m_pChild;
+			m_pChild = NULL;
+		}
+		m_bChildIsCurrent = false;
+
+		if ( !BNextFileInDir() )
+			return false;
+
+		std::string sName = CurrentFileName();
+		if ( BCurrentIsDir() && !BCurrentIsLink() )
+		{
+			m_pChild = new CDirIterator( Path_Join( m_sDir, sName ).c_str(), m_sPattern.c_str(), true );
+		}
+
+		if ( BMatchesFilePattern( sName.c_str(), m_sPattern.c_str() ) )
+			return true;
+	}
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: steps to the next file in this iterator's own directory
+//-----------------------------------------------------------------------------
+bool CDirIterator::BNextFileInDir()
 {
 	if ( m_bNoFiles )
 		return false;
@@ -259,7 +397,12 @@ bool CDirIterator::BNextFile()
 			m_sFilename = UTF16to8( m_pFindData->cFileName );
 		}
 #else
-		bool bFound = ( _findnext( m_hFind, m_pFindData ) == 0 );
+		bool bFound = m_unCurrent + 1 < m_vecEntries.size();
+		if ( bFound )
+		{
+			m_unCurrent++;
+			m_bStatDone = false;
+		}
 #endif
 
 		if ( !bFound )
@@ -284,29 +427,67 @@ bool CDirIterator::BNextFile()
 //-----------------------------------------------------------------------------
 // Purpose: returns name (filename portion only) of the current file.
 // Name is emitted in UTF-8 encoding.
-// NOTE: This method returns a pointer into a static buffer, either a member
-// or the buffer inside the _finddata_t.
 //-----------------------------------------------------------------------------
 std::string CDirIterator::CurrentFileName()
 {
+	const CDirIterator *pLevel = CurrentLevel();
 #if defined( _WIN32 )
-	return m_sFilename;
+	return pLevel->m_sFilename;
 #else
-	return m_pFindData->name;
+	if ( pLevel->m_unCurrent >= pLevel->m_vecEntries.size() )
+		return std::string();
+	return pLevel->m_vecEntries[ pLevel->m_unCurrent ].m_sName;
 #endif
 }
 
 
+//-----------------------------------------------------------------------------
+// Purpose: returns the full path of the current file
+//-----------------------------------------------------------------------------
+std::string CDirIterator::CurrentFilePath()
+{
+	return Path_Join( CurrentLevel()->m_sDir, CurrentFileName() );
+}
+
+
+#if !defined( _WIN32 )
+//-----------------------------------------------------------------------------
+// Purpose: stats the current file the first time an accessor needs more than
+//			readdir gave us
+//-----------------------------------------------------------------------------
+void CDirIterator::StatCurrent() const
+{
+	if ( m_bStatDone )
+		return;
+
+	m_bStatDone = true;
+	m_bStatValid = false;
+	if ( m_unCurrent < m_vecEntries.size() )
+	{
+		std::string sFullPath = Path_Join( m_sDir, m_vecEntries[ m_unCurrent ].m_sName );
+		m_bStatValid = statBig( sFullPath.c_str(), &m_statCurrent ) == 0;
+	}
+
+	if ( !m_bStatValid )
+	{
+		memset( &m_statCurrent, 0, sizeof( m_statCurrent ) );
+	}
+}
+#endif
+
+
 //-----------------------------------------------------------------------------
 // Purpose: returns size of the file
 //-----------------------------------------------------------------------------
 int64_t CDirIterator::CurrentFileLength() const
 {
+	const CDirIterator *pLevel = CurrentLevel();
 #if defined( _WIN32 )
-	LARGE_INTEGER li = { { m_pFindData->nFileSizeLow, ( LONG )m_pFindData->nFileSizeHigh } };
+	LARGE_INTEGER li = { { pLevel->m_pFindData->nFileSizeLow, ( LONG )pLevel->m_pFindData->nFileSizeHigh } };
 	return li.QuadPart;
 #else
-	return ( int64_t )m_pFindData->size;
+	pLevel->StatCurrent();
+	return ( int64_t )pLevel->m_statCurrent.st_size;
 #endif
 }
 
@@ -344,10 +525,12 @@ int64_t FileTimeToUnixTime( FILETIME filetime )
 //-----------------------------------------------------------------------------
 int64_t CDirIterator::CurrentFileWriteTime() const
 {
+	const CDirIterator *pLevel = CurrentLevel();
 #if defined( _WIN32 )
-	return FileTimeToUnixTime( m_pFindData->ftLastWriteTime );
+	return FileTimeToUnixTime( pLevel->m_pFindData->ftLastWriteTime );
 #else
-	return m_pFindData->time_write;
+	pLevel->StatCurrent();
+	return pLevel->m_statCurrent.st_mtime;
 #endif
 }
 
@@ -357,10 +540,12 @@ int64_t CDirIterator::CurrentFileWriteTime() const
 //-----------------------------------------------------------------------------
 int64_t CDirIterator::CurrentFileCreateTime() const
 {
+	const CDirIterator *pLevel = CurrentLevel();
 #if defined( _WIN32 )
-	return FileTimeToUnixTime( m_pFindData->ftCreationTime );
+	return FileTimeToUnixTime( pLevel->m_pFindData->ftCreationTime );
 #else
-	return m_pFindData->time_create;
+	pLevel->StatCurrent();
+	return pLevel->m_statCurrent.st_ctime;
 #endif
 }
 
@@ -370,10 +555,46 @@ int64_t CDirIterator::CurrentFileCreateTime() const
 //-----------------------------------------------------------------------------
 bool CDirIterator::BCurrentIsDir() const
 {
+	const CDirIterator *pLevel = CurrentLevel();
+#if defined( _WIN32 )
+	return ( pLevel->m_pFindData->dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY ) != 0;
+#else
+	if ( pLevel->m_unCurrent >= pLevel->m_vecEntries.size() )
+		return false;
+
+	unsigned char unType = pLevel->m_vecEntries[ pLevel->m_unCurrent ].m_unType;
+	if ( unType == DT_DIR )
+		return true;
+	if ( unType != DT_UNKNOWN && unType != DT_LNK )
+		return false;
+
+	// symlinks, and filesystems that don't fill in d_type, need the stat (which follows links)
+	pLevel->StatCurrent();
+	return pLevel->m_bStatValid && S_ISDIR( pLevel->m_statCurrent.st_mode );
+#endif
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: returns whether current item under examination is a symlink or
+//			other reparse point, which recursive walks don't descend into
+//-----------------------------------------------------------------------------
+bool CDirIterator::BCurrentIsLink() const
+{
+	const CDirIterator *pLevel = CurrentLevel();
 #if defined( _WIN32 )
-	return ( m_pFindData->dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY ) != 0;
+	return ( pLevel->m_pFindData->dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT ) != 0;
 #else
-	return ( m_pFindData->attrib & _A_SUBDIR ? true : false );
+	if ( pLevel->m_unCurrent >= pLevel->m_vecEntries.size() )
+		return false;
+
+	unsigned char unType = pLevel->m_vecEntries[ pLevel->m_unCurrent ].m_unType;
+	if ( unType != DT_UNKNOWN )
+		return unType == DT_LNK;
+
+	struct stat linkStat;
+	std::string sFullPath = Path_Join( pLevel->m_sDir, pLevel->m_vecEntries[ pLevel->m_unCurrent ].m_sName );
+	return lstat( sFullPath.c_str(), &linkStat ) == 0 && S_ISLNK( linkStat.st_mode );
 #endif
 }
 
@@ -383,10 +604,12 @@ bool CDirIterator::BCurrentIsDir() const
 //-----------------------------------------------------------------------------
 bool CDirIterator::BCurrentIsHidden() const
 {
+	const CDirIterator *pLevel = CurrentLevel();
 #if defined( _WIN32 )
-	return ( m_pFindData->dwFileAttributes & FILE_ATTRIBUTE_HIDDEN ) != 0;
+	return ( pLevel->m_pFindData->dwFileAttributes & FILE_ATTRIBUTE_HIDDEN ) != 0;
 #else
-	return ( m_pFindData->attrib & _A_HIDDEN ? true : false );
+	pLevel->StatCurrent();
+	return ( pLevel->m_statCurrent.st_mode & _A_HIDDEN ? true : false );
 #endif
 }
 
@@ -396,10 +619,12 @@ bool CDirIterator::BCurrentIsHidden() const
 //-----------------------------------------------------------------------------
 bool CDirIterator::BCurrentIsReadOnly() const
 {
+	const CDirIterator *pLevel = CurrentLevel();
 #if defined( _WIN32 )
-	return ( m_pFindData->dwFileAttributes & FILE_ATTRIBUTE_READONLY ) != 0;
+	return ( pLevel->m_pFindData->dwFileAttributes & FILE_ATTRIBUTE_READONLY ) != 0;
 #else
-	return ( m_pFindData->attrib & _A_RDONLY ? true : false );
+	pLevel->StatCurrent();
+	return ( pLevel->m_statCurrent.st_mode & _A_RDONLY ? true : false );
 #endif
 }
 
@@ -409,10 +634,12 @@ bool CDirIterator::BCurrentIsReadOnly() const
 //-----------------------------------------------------------------------------
 bool CDirIterator::BCurrentIsSystem() const
 {
+	const CDirIterator *pLevel = CurrentLevel();
 #if defined( _WIN32 )
-	return ( m_pFindData->dwFileAttributes & FILE_ATTRIBUTE_SYSTEM ) != 0;
+	return ( pLevel->m_pFindData->dwFileAttributes & FILE_ATTRIBUTE_SYSTEM ) != 0;
 #else
-	return ( m_pFindData->attrib & _A_SYSTEM ? true : false );
+	pLevel->StatCurrent();
+	return ( pLevel->m_statCurrent.st_mode & _A_SYSTEM ? true : false );
 #endif
 }
 
@@ -422,218 +649,13 @@ bool CDirIterator::BCurrentIsSystem() const
 //-----------------------------------------------------------------------------
 bool CDirIterator::BCurrentIsMarkedForArchive() const
 {
+	const CDirIterator *pLevel = CurrentLevel();
 #if defined( _WIN32 )
-	return ( m_pFindData->dwFileAttributes & FILE_ATTRIBUTE_ARCHIVE ) != 0;
+	return ( pLevel->m_pFindData->dwFileAttributes & FILE_ATTRIBUTE_ARCHIVE ) != 0;
 #else
-	return ( m_pFindData->attrib & _A_ARCH ? true : false );
+	pLevel->StatCurrent();
+	return ( pLevel->m_statCurrent.st_mode & _A_ARCH ? true : false );
 #endif
 }
 
-
-//-----------------------------------------------------------------------------
-//
-// A huge pile of stuff from fileio.cpp in steam/tier1
-//
-//-----------------------------------------------------------------------------
-
-#if !defined( _WIN32 )
-// findfirst/findnext implementation from filesystem/linux_support.[h|cpp]
-
-static char selectBuf[ PATH_MAX ];
-
-#if defined( OSX ) && !defined( __MAC_10_8 )
-static int FileSelect( direntBig_t *ent )
-#elif defined( LINUX ) || defined( OSX )
-static int FileSelect( const direntBig_t *ent )
-#else
-#error
-#endif
-{
-	const char *mask = selectBuf;
-	const char *name = ent->d_name;
-
-	return FileSelect( name, mask );
-}
-
-static int FileSelect( const char *name, const char *mask )
-{
-	// printf("Test:%s %s\n",mask,name);
-
-	if ( !strcmp( name, "." ) || !strcmp( name, ".." ) )
-		return 0;
-
-	if ( !strcmp( mask, "*.*" ) || !strcmp( mask, "*" ) )
-		return 1;
-
-	while ( *mask && *name )
-	{
-		if ( *mask == '*' )
-		{
-			mask++;		  // move to the next char in the mask
-			if ( !*mask ) // if this is the end of the mask its a match
-			{
-				return 1;
-			}
-			while ( *name && toupper( *name ) != toupper( *mask ) )
-			{ // while the two don't meet up again
-				name++;
-			}
-			if ( !*name )
-			{ // end of the name
-				break;
-			}
-		}
-		else if ( *mask != '?' )
-		{
-			if ( toupper( *mask ) != toupper( *name ) )
-			{ // mismatched!
-				return 0;
-			}
-			else
-			{
-				mask++;
-				name++;
-				if ( !*mask && !*name )
-				{ // if its at the end of the buffer
-					return 1;
-				}
-			}
-		}
-		else /* mask is "?", we don't care*/
-		{
-			mask++;
-			name++;
-		}
-	}
-
-	return ( !*mask && !*name ); // both of the strings are at the end
-}
-
-int FillDataStruct( _finddata_t *dat )
-{
-	statBig_t fileStat;
-
-	if ( dat->curName >= dat->numNames )
-		return -1;
-
-	strncpy( dat->name, dat->namelist[ dat->curName ]->d_name, sizeof( dat->name ) );
-	char szFullPath[ MAX_PATH ];
-	int nWriteSize = snprintf( szFullPath, sizeof( szFullPath ), "%s%c%s", dat->dirBase, Path_GetSlash(), dat->name );
-	if ( nWriteSize >= sizeof( szFullPath ) )
-	{
-		Log( LogError, "File path truncated\n" );
-	}
-	if ( statBig( szFullPath, &fileStat ) == 0 )
-	{
-		dat->attrib = fileStat.st_mode;
-		dat->size = fileStat.st_size;
-		dat->time_write = fileStat.st_mtime;
-		dat->time_create = fileStat.st_ctime;
-	}
-	else
-	{
-		dat->attrib = 0;
-		dat->size = 0;
-		dat->time_write = 0;
-		dat->time_create = 0;
-	}
-	free( dat->namelist[ dat->curName ] );
-	dat->namelist[ dat->curName ] = NULL;
-	dat->curName++;
-	return 1;
-}
-
-int _findfirst( const char *fileName, _finddata_t *dat )
-{
-	char nameStore[ MAX_PATH ];
-	char *dir = NULL;
-	int n, iret = -1;
-
-	strncpy( nameStore, fileName, sizeof( nameStore ) );
-
-	if ( strrchr( nameStore, '/' ) )
-	{
-		dir = nameStore;
-		while ( strrchr( dir, '/' ) )
-		{
-			statBig_t dirChk;
-
-			// zero this with the dir name
-			dir = strrchr( nameStore, '/' );
-			*dir = '\0';
-			if ( dir == nameStore )
-			{
-				strcpy( nameStore, "/" ); // C++11 would prefer no `dir = "/";`
-			}
-			else
-			{
-				dir = nameStore;
-			}
-
-			if ( statBig( dir, &dirChk ) == 0 && S_ISDIR( dirChk.st_mode ) )
-			{
-				break;
-			}
-		}
-	}
-	else
-	{
-		// couldn't find a dir separator...
-		return -1;
-	}
-
-	if ( strlen( dir ) > 0 )
-	{
-		if ( strlen( dir ) == 1 )
-			strncpy( selectBuf, fileName + 1, sizeof( selectBuf ) );
-		else
-			strncpy( selectBuf, fileName + strlen( dir ) + 1, sizeof( selectBuf ) );
-
-		n = scandirBig( dir, &dat->namelist, FileSelect, alphasortBig );
-		if ( n < 0 )
-		{
-			// silently return, nothing interesting
-		}
-		else
-		{
-			dat->curName = 0;
-			dat->numNames = n; // n is the number of matches
-			strncpy( dat->dirBase, dir, sizeof( dat->dirBase ) );
-			iret = FillDataStruct( dat );
-			if ( iret < 0 )
-			{
-				free( dat->namelist );
-				dat->namelist = NULL;
-				dat->curName = 0;
-				dat->numNames = 0;
-			}
-		}
-	}
-
-	//  printf("Returning: %i \n",iret);
-	return iret;
-}
-
-int _findnext( int64_t handle, _finddata_t *dat )
-{
-	if ( dat->curName >= dat->numNames )
-	{
-		free( dat->namelist );
-		dat->namelist = NULL;
-		dat->curName = 0;
-		dat->numNames = 0;
-		return -1; // no matches left
-	}
-
-	FillDataStruct( dat );
-	return 0;
-}
-
-bool _findclose( int64_t handle )
-{
-	return true;
-}
-
-#endif // !defined( _WIN32 )
-
 #endif // VRCORE_NO_PLATFORM
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 
 #if !defined(_WIN32)
@@ -25,10 +26,15 @@ typedef void *HMDHANDLE;
 // iterator class, initialize with the path & pattern you want to want files/dirs for.
 //
 // all string setters and accessors use UTF-8 encoding.
+//
+// In recursive mode every subdirectory is walked as well (symlinks to
+// directories are reported but not followed). A directory is reported before
+// its contents, and the pattern only filters what is reported, not what is
+// walked.
 class CDirIterator
 {
 public:
-	CDirIterator( const char *pchPath, const char *pchPattern );
+	CDirIterator( const char *pchPath, const char *pchPattern, bool bRecursive = false );
 	~CDirIterator();
 
 	bool IsValid() const;
@@ -39,6 +45,9 @@ public:
 	// name of the current file - file portion only, not full path
 	std::string CurrentFileName();
 
+	// full path of the current file, which in recursive mode may be in a subdirectory
+	std::string CurrentFilePath();
+
 	// size of the current file
 	int64_t CurrentFileLength() const;
 
@@ -68,15 +77,36 @@ public:
 private:
 	void Init( const std::string &sPathAndPattern );
 	bool BValidFilename();
+	bool BNextFileInDir();
+	bool BCurrentIsLink() const;
+	const CDirIterator *CurrentLevel() const;
 	bool m_bNoFiles, m_bUsedFirstFile;
 
+	std::string m_sDir;
+	std::string m_sPattern;
+	bool m_bRecursive;
+	CDirIterator *m_pChild;
+	bool m_bChildIsCurrent;
+
 #if defined( _WIN32 )
 	HMDHANDLE m_hFind;
 	struct _WIN32_FIND_DATAW *m_pFindData;
 	std::string m_sFilename;
 #else
-	int64_t m_hFind;
-	struct _finddata_t *m_pFindData;
+	// names are read up front with readdir and only stat'ed if an accessor needs more than d_type
+	struct DirEntry_t
+	{
+		std::string m_sName;
+		unsigned char m_unType;
+	};
+	void StatCurrent() const;
+
+	bool m_bOpened;
+	std::vector< DirEntry_t > m_vecEntries;
+	size_t m_unCurrent;
+	mutable bool m_bStatDone;
+	mutable bool m_bStatValid;
+	mutable statBig_t m_statCurrent;
 #endif
 };
 
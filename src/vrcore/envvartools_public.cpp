@@ -2,87 +2,432 @@
 #include <vrcore/envvartools_public.h>
 #include <vrcore/strtools_public.h>
 #include <stdlib.h>
+#include <stdio.h>
 #include <string>
 #include <cctype>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 
 #if defined(_WIN32)
 #include <windows.h>
 
 #undef GetEnvironmentVariable
 #undef SetEnvironmentVariable
+#elif defined(OSX)
+#include <crt_externs.h>
+#elif defined(POSIX)
+#include <unistd.h>
+extern char **environ;
 #endif
 
 
-std::string GetEnvironmentVariable( const char *pchVarName )
+//-----------------------------------------------------------------------------
+// Purpose: Orders variable names the way the platform looks them up, which is
+//			case insensitive on Windows
+//-----------------------------------------------------------------------------
+static int CompareEnvVarNames( const char *pchA, size_t unLengthA, const char *pchB, size_t unLengthB )
 {
+	size_t unLength = std::min( unLengthA, unLengthB );
 #if defined(_WIN32)
-	char rchValue[32767]; // max size for an env var on Windows
-	DWORD cChars = GetEnvironmentVariableA( pchVarName, rchValue, sizeof( rchValue ) );
-	if( cChars == 0 )
-		return "";
-	else
-		return rchValue;
+	for ( size_t i = 0; i < unLength; i++ )
+	{
+		int nA = tolower( ( unsigned char )pchA[ i ] );
+		int nB = tolower( ( unsigned char )pchB[ i ] );
+		if ( nA != nB )
+			return nA < nB ? -1 : 1;
+	}
+#else
+	int nCompare = memcmp( pchA, pchB, unLength );
+	if ( nCompare != 0 )
+		return nCompare;
+#endif
+	return unLengthA == unLengthB ? 0 : ( unLengthA < unLengthB ? -1 : 1 );
+}
+
+
+void CEnvironmentSnapshot::AddVariable( const char *pchName, size_t unNameLength, const char *pchValue, size_t unValueLength )
+{
+	Variable_t var;
+	var.unName = ( uint32_t )m_bufStrings.size();
+	var.unNameLength = ( uint32_t )unNameLength;
+	m_bufStrings.insert( m_bufStrings.end(), pchName, pchName + unNameLength );
+	m_bufStrings.push_back( '\0' );
+	var.unValue = ( uint32_t )m_bufStrings.size();
+	var.unValueLength = ( uint32_t )unValueLength;
+	m_bufStrings.insert( m_bufStrings.end(), pchValue, pchValue + unValueLength );
+	m_bufStrings.push_back( '\0' );
+	m_vecVariables.push_back( var );
+}
+
+
+void CEnvironmentSnapshot::SortVariables()
+{
+	const char *pchStrings = m_bufStrings.data();
+	auto less = [pchStrings]( const Variable_t &a, const Variable_t &b )
+	{
+		return CompareEnvVarNames( pchStrings + a.unName, a.unNameLength, pchStrings + b.unName, b.unNameLength ) < 0;
+	};
+
+	// the environment can hold a name twice, and lookups have always found the first one
+	std::stable_sort( m_vecVariables.begin(), m_vecVariables.end(), less );
+	auto iterEnd = std::unique( m_vecVariables.begin(), m_vecVariables.end(),
+		[&less]( const Variable_t &a, const Variable_t &b ) { return !less( a, b ) && !less( b, a ); } );
+	m_vecVariables.erase( iterEnd, m_vecVariables.end() );
+}
+
+
+CEnvironmentSnapshot *CEnvironmentSnapshot::CreateFromProcess( uint32_t unVersion )
+{
+	CEnvironmentSnapshot *pSnapshot = new CEnvironmentSnapshot;
+	pSnapshot->m_unVersion = unVersion;
+
+#if defined(_WIN32)
+	char *pchBlock = GetEnvironmentStringsA();
+	if ( pchBlock )
+	{
+		for ( const char *pchEntry = pchBlock; *pchEntry; pchEntry += strlen( pchEntry ) + 1 )
+		{
+			// entries like "=C:=C:\dir" hold per drive directories, the name starts after the first '='
+			const char *pchEquals = strchr( pchEntry + 1, '=' );
+			if ( pchEquals )
+				pSnapshot->AddVariable( pchEntry, pchEquals - pchEntry, pchEquals + 1, strlen( pchEquals + 1 ) );
+		}
+		FreeEnvironmentStringsA( pchBlock );
+	}
 #elif defined(POSIX)
-	char *pchValue = getenv( pchVarName );
-	if( pchValue )
-		return pchValue;
-	else
-		return "";
+#if defined(OSX)
+	char **ppEnviron = *_NSGetEnviron();
+#else
+	char **ppEnviron = environ;
+#endif
+	for ( char **ppEntry = ppEnviron; ppEntry && *ppEntry; ppEntry++ )
+	{
+		const char *pchEquals = strchr( *ppEntry, '=' );
+		if ( pchEquals )
+			pSnapshot->AddVariable( *ppEntry, pchEquals - *ppEntry, pchEquals + 1, strlen( pchEquals + 1 ) );
+	}
 #else
 #error "Unsupported Platform"
 #endif
+
+	pSnapshot->SortVariables();
+	return pSnapshot;
 }
 
-bool GetEnvironmentVariableAsBool( const char *pchVarName, bool bDefault )
+
+EnvVarRef_t CEnvironmentSnapshot::GetVariable( const char *pchVarName ) const
 {
-	std::string sValue = GetEnvironmentVariable( pchVarName );
+	if ( !pchVarName )
+		return EnvVarRef_t();
 
-	if ( sValue.empty() )
+	size_t unNameLength = strlen( pchVarName );
+	const char *pchStrings = m_bufStrings.data();
+	size_t unLow = 0, unHigh = m_vecVariables.size();
+	while ( unLow < unHigh )
+	{
+		size_t unMid = ( unLow + unHigh ) / 2;
+		const Variable_t &var = m_vecVariables[ unMid ];
+		int nCompare = CompareEnvVarNames( pchStrings + var.unName, var.unNameLength, pchVarName, unNameLength );
+		if ( nCompare == 0 )
+			return EnvVarRef_t( pchStrings + var.unValue, var.unValueLength );
+		if ( nCompare < 0 )
+			unLow = unMid + 1;
+		else
+			unHigh = unMid;
+	}
+	return EnvVarRef_t();
+}
+
+
+static bool BMatchesLowercase( const EnvVarRef_t &value, const char *pchLower )
+{
+	size_t i = 0;
+	for ( ; i < value.unLength; i++ )
+	{
+		if ( pchLower[ i ] == '\0' || tolower( ( unsigned char )value.pch[ i ] ) != pchLower[ i ] )
+			return false;
+	}
+	return pchLower[ i ] == '\0';
+}
+
+
+bool CEnvironmentSnapshot::GetBool( const char *pchVarName, bool bDefault ) const
+{
+	EnvVarRef_t value = GetVariable( pchVarName );
+
+	if ( value.empty() )
 	{
 		return bDefault;
 	}
 
-	sValue = StringToLower( sValue );
-	std::string sYesValues[] = { "y", "yes", "true" };
-	std::string sNoValues[] = { "n", "no", "false" };
+	static const char *const k_rgpchYesValues[] = { "y", "yes", "true" };
+	static const char *const k_rgpchNoValues[] = { "n", "no", "false" };
 
-	for ( std::string &sMatch : sYesValues )
+	for ( const char *pchMatch : k_rgpchYesValues )
 	{
-		if ( sMatch == sValue )
+		if ( BMatchesLowercase( value, pchMatch ) )
 		{
 			return true;
 		}
 	}
 
-	for ( std::string &sMatch : sNoValues )
+	for ( const char *pchMatch : k_rgpchNoValues )
 	{
-		if ( sMatch == sValue )
+		if ( BMatchesLowercase( value, pchMatch ) )
 		{
 			return false;
 		}
 	}
 
-	if ( std::isdigit( sValue.at(0) ) )
+	if ( std::isdigit( ( unsigned char )value.pch[ 0 ] ) )
 	{
-		return atoi( sValue.c_str() ) != 0;
+		return atoi( value.pch ) != 0;
 	}
 
 	fprintf( stderr,
 			 "GetEnvironmentVariableAsBool(%s): Unable to parse value '%s', using default %d\n",
-			 pchVarName, sValue.c_str(), bDefault );
+			 pchVarName, StringToLower( value.pch ).c_str(), bDefault );
 	return bDefault;
 }
 
+
+int64_t CEnvironmentSnapshot::GetInt64( const char *pchVarName, int64_t nDefault ) const
+{
+	EnvVarRef_t value = GetVariable( pchVarName );
+	if ( value.empty() )
+		return nDefault;
+
+	char *pchEnd = nullptr;
+	long long nValue = strtoll( value.pch, &pchEnd, 10 );
+	if ( pchEnd != value.pch + value.unLength )
+		return nDefault;
+	return ( int64_t )nValue;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Publication state. Readers only touch pCurrent, unEpoch and
+//			rgunPinned; everything else belongs to whoever holds mutexWriters.
+//
+//			Replaced snapshots are reclaimed by epoch. A pin counts itself in the
+//			slot for the epoch it saw, and the writers only move the epoch on
+//			once the slot it would reuse is empty. A snapshot retired in epoch E
+//			is no longer current for any pin made in E + 1 or later, so it can
+//			be freed as soon as the epoch reaches E + 2.
+//-----------------------------------------------------------------------------
+struct EnvironmentSnapshotState_t
+{
+	std::atomic< const CEnvironmentSnapshot * > pCurrent{ nullptr };
+	std::atomic< uint64_t > unEpoch{ 0 };
+	std::atomic< uint32_t > rgunPinned[ 2 ];
+	std::mutex mutexWriters;
+	uint32_t unNextVersion = 1;
+
+	struct RetiredSnapshot_t
+	{
+		const CEnvironmentSnapshot *pSnapshot;
+		uint64_t unEpoch;
+	};
+	std::vector< RetiredSnapshot_t > vecRetired;
+	std::atomic< uint32_t > unRetiredCount{ 0 };
+
+	// what the live environment looked like when pCurrent was built, to tell if it changed since
+#if defined(_WIN32)
+	std::string sBlockSeen;
+#else
+	char **ppEnvironSeen = nullptr;
+	std::vector< char * > vecEntriesSeen;
+#endif
+
+	EnvironmentSnapshotState_t()
+	{
+		rgunPinned[ 0 ] = 0;
+		rgunPinned[ 1 ] = 0;
+	}
+};
+
+static EnvironmentSnapshotState_t &EnvironmentSnapshotState()
+{
+	// never destroyed so the environment can still be read from static destructors
+	static EnvironmentSnapshotState_t *s_pState = new EnvironmentSnapshotState_t;
+	return *s_pState;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns true if the live environment differs from what the current
+//			snapshot was built from, and remembers the live one either way.
+//			Caller must hold mutexWriters.
+//-----------------------------------------------------------------------------
+static bool BEnvironmentChangedSinceSnapshot( EnvironmentSnapshotState_t &state )
+{
+#if defined(_WIN32)
+	std::string sBlock;
+	char *pchBlock = GetEnvironmentStringsA();
+	if ( pchBlock )
+	{
+		const char *pchEnd = pchBlock;
+		while ( *pchEnd )
+			pchEnd += strlen( pchEnd ) + 1;
+		sBlock.assign( pchBlock, pchEnd );
+		FreeEnvironmentStringsA( pchBlock );
+	}
+	bool bChanged = sBlock != state.sBlockSeen;
+	state.sBlockSeen.swap( sBlock );
+	return bChanged;
+#else
+	// setenv swaps in a new entry pointer for every change, so comparing pointers is enough
+#if defined(OSX)
+	char **ppEnviron = *_NSGetEnviron();
+#else
+	char **ppEnviron = environ;
+#endif
+	size_t unEntries = 0;
+	while ( ppEnviron && ppEnviron[ unEntries ] )
+		unEntries++;
+
+	bool bChanged = ppEnviron != state.ppEnvironSeen || unEntries != state.vecEntriesSeen.size()
+		|| ( unEntries > 0 && memcmp( ppEnviron, state.vecEntriesSeen.data(), unEntries * sizeof( char * ) ) != 0 );
+	if ( bChanged )
+	{
+		state.ppEnvironSeen = ppEnviron;
+		state.vecEntriesSeen.assign( ppEnviron, ppEnviron + unEntries );
+	}
+	return bChanged;
+#endif
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Moves the epoch on as far as pins allow and frees the snapshots no
+//			pin can see any more. Caller must hold mutexWriters.
+//-----------------------------------------------------------------------------
+static void ReclaimEnvironmentSnapshots( EnvironmentSnapshotState_t &state )
+{
+	// two steps at most, after that the slot to reuse holds pins made after this call started
+	for ( int nStep = 0; nStep < 2; nStep++ )
+	{
+		uint64_t unEpoch = state.unEpoch.load();
+		if ( state.rgunPinned[ ( unEpoch + 1 ) & 1 ].load() != 0 )
+			break;
+		state.unEpoch.store( unEpoch + 1 );
+	}
+
+	uint64_t unEpoch = state.unEpoch.load();
+	auto iterKept = std::remove_if( state.vecRetired.begin(), state.vecRetired.end(),
+		[unEpoch]( const EnvironmentSnapshotState_t::RetiredSnapshot_t &retired )
+		{
+			if ( retired.unEpoch + 2 > unEpoch )
+				return false;
+			delete retired.pSnapshot;
+			return true;
+		} );
+	state.vecRetired.erase( iterKept, state.vecRetired.end() );
+	state.unRetiredCount.store( ( uint32_t )state.vecRetired.size(), std::memory_order_relaxed );
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Builds a snapshot of the live environment and makes it current.
+//			Caller must hold mutexWriters.
+//-----------------------------------------------------------------------------
+static void PublishEnvironmentSnapshot( EnvironmentSnapshotState_t &state )
+{
+	BEnvironmentChangedSinceSnapshot( state );
+	const CEnvironmentSnapshot *pSnapshot = CEnvironmentSnapshot::CreateFromProcess( state.unNextVersion++ );
+	const CEnvironmentSnapshot *pPrevious = state.pCurrent.exchange( pSnapshot );
+	if ( pPrevious )
+		state.vecRetired.push_back( { pPrevious, state.unEpoch.load() } );
+	ReclaimEnvironmentSnapshots( state );
+}
+
+
+// The epoch and slot counts are sequentially consistent: either a writer sees this pin in its
+// slot, or the pin sees the writer's newer epoch and tries again in the other slot.
+CEnvironmentSnapshotPin::CEnvironmentSnapshotPin()
+{
+	EnvironmentSnapshotState_t & state = EnvironmentSnapshotState();
+	if ( !state.pCurrent.load( std::memory_order_acquire ) )
+	{
+		std::lock_guard<std::mutex> lock( state.mutexWriters );
+		if ( !state.pCurrent.load( std::memory_order_acquire ) )
+			PublishEnvironmentSnapshot( state );
+	}
+
+	for ( ;; )
+	{
+		uint64_t unEpoch = state.unEpoch.load();
+		m_unEpochSlot = ( uint32_t )( unEpoch & 1 );
+		state.rgunPinned[ m_unEpochSlot ].fetch_add( 1 );
+		if ( state.unEpoch.load() == unEpoch )
+			break;
+		state.rgunPinned[ m_unEpochSlot ].fetch_sub( 1 );
+	}
+	m_pSnapshot = state.pCurrent.load();
+}
+
+
+CEnvironmentSnapshotPin::~CEnvironmentSnapshotPin()
+{
+	EnvironmentSnapshotState().rgunPinned[ m_unEpochSlot ].fetch_sub( 1 );
+}
+
+
+void RefreshEnvironmentSnapshot()
+{
+	EnvironmentSnapshotState_t & state = EnvironmentSnapshotState();
+	std::lock_guard<std::mutex> lock( state.mutexWriters );
+	if ( !state.pCurrent.load( std::memory_order_acquire ) || BEnvironmentChangedSinceSnapshot( state ) )
+		PublishEnvironmentSnapshot( state );
+	else
+		ReclaimEnvironmentSnapshots( state );
+}
+
+
+uint32_t GetRetiredEnvironmentSnapshotCount()
+{
+	return EnvironmentSnapshotState().unRetiredCount.load( std::memory_order_relaxed );
+}
+
+
+std::string GetEnvironmentVariable( const char *pchVarName )
+{
+	CEnvironmentSnapshotPin env;
+	return env->GetVariable( pchVarName ).ToString();
+}
+
+bool GetEnvironmentVariableAsBool( const char *pchVarName, bool bDefault )
+{
+	CEnvironmentSnapshotPin env;
+	return env->GetBool( pchVarName, bDefault );
+}
+
 bool SetEnvironmentVariable( const char *pchVarName, const char *pchVarValue )
 {
+	EnvironmentSnapshotState_t & state = EnvironmentSnapshotState();
+	std::lock_guard<std::mutex> lock( state.mutexWriters );
+
 #if defined(_WIN32)
-	return 0 != SetEnvironmentVariableA( pchVarName, pchVarValue );
+	bool bSuccess = 0 != SetEnvironmentVariableA( pchVarName, pchVarValue );
 #elif defined(POSIX)
+	bool bSuccess;
 	if( pchVarValue == NULL )
-		return 0 == unsetenv( pchVarName );
+		bSuccess = 0 == unsetenv( pchVarName );
 	else
-		return 0 == setenv( pchVarName, pchVarValue, 1 );
+		bSuccess = 0 == setenv( pchVarName, pchVarValue, 1 );
 #else
 #error "Unsupported Platform"
 #endif
+
+	// setting a variable to what it already holds, like InitSteamAppId does on every init, publishes nothing
+	if ( bSuccess )
+	{
+		const CEnvironmentSnapshot *pCurrent = state.pCurrent.load( std::memory_order_acquire );
+		EnvVarRef_t current = pCurrent ? pCurrent->GetVariable( pchVarName ) : EnvVarRef_t();
+		bool bUnchanged = pCurrent && ( pchVarValue ? current.bSet && current == pchVarValue : !current.bSet );
+		if ( !bUnchanged )
+			PublishEnvironmentSnapshot( state );
+	}
+	return bSuccess;
 }
@@ -1,8 +1,105 @@
 //========= Copyright Valve Corporation ============//
 #pragma once
 
+#include <stdint.h>
+#include <string.h>
 #include <string>
+#include <vector>
 
 std::string GetEnvironmentVariable( const char *pchVarName );
 bool GetEnvironmentVariableAsBool( const char *pchVarName, bool bDefault );
 bool SetEnvironmentVariable( const char *pchVarName, const char *pchVarValue );
+
+/** A non-owning reference to a value in an environment snapshot. The characters are null
+* terminated and stay valid for as long as the CEnvironmentSnapshotPin it was read through. */
+struct EnvVarRef_t
+{
+	EnvVarRef_t() : pch( "" ), unLength( 0 ), bSet( false ) {}
+	EnvVarRef_t( const char *pchValue, size_t unValueLength ) : pch( pchValue ), unLength( unValueLength ), bSet( true ) {}
+
+	bool empty() const { return unLength == 0; }
+	std::string ToString() const { return std::string( pch, unLength ); }
+	bool operator==( const char *pchOther ) const { return strlen( pchOther ) == unLength && memcmp( pch, pchOther, unLength ) == 0; }
+	bool operator!=( const char *pchOther ) const { return !( *this == pchOther ); }
+
+	const char *pch;
+	size_t unLength;
+	bool bSet;			// false for variables that don't exist, which read as empty
+};
+
+/** An immutable copy of the process environment. Reading one never locks, allocates or touches
+* the live environment, so it can't race with SetEnvironmentVariable on another thread. Setting a
+* variable publishes a new snapshot; readers holding an older one keep a consistent view. Old
+* snapshots are freed once no CEnvironmentSnapshotPin can still see them.
+*
+* Changes made behind SetEnvironmentVariable's back (setenv, putenv or the Windows API called
+* directly) are only picked up by RefreshEnvironmentSnapshot. */
+class CEnvironmentSnapshot
+{
+public:
+	/** Goes up by one with every published snapshot */
+	uint32_t GetVersion() const { return m_unVersion; }
+	uint32_t GetVariableCount() const { return ( uint32_t )m_vecVariables.size(); }
+
+	EnvVarRef_t GetVariable( const char *pchVarName ) const;
+	bool BHasVariable( const char *pchVarName ) const { return GetVariable( pchVarName ).bSet; }
+
+	/** Same parsing as GetEnvironmentVariableAsBool */
+	bool GetBool( const char *pchVarName, bool bDefault ) const;
+
+	/** Returns nDefault unless the whole value is a decimal integer */
+	int64_t GetInt64( const char *pchVarName, int64_t nDefault ) const;
+
+	/** Builds a snapshot of the live environment. Callers publish it through the functions in envvartools_public.cpp. */
+	static CEnvironmentSnapshot *CreateFromProcess( uint32_t unVersion );
+
+private:
+	CEnvironmentSnapshot() : m_unVersion( 0 ) {}
+	CEnvironmentSnapshot( const CEnvironmentSnapshot & ) = delete;
+	CEnvironmentSnapshot & operator=( const CEnvironmentSnapshot & ) = delete;
+
+	void AddVariable( const char *pchName, size_t unNameLength, const char *pchValue, size_t unValueLength );
+	void SortVariables();
+
+	struct Variable_t
+	{
+		uint32_t unName;
+		uint32_t unNameLength;
+		uint32_t unValue;
+		uint32_t unValueLength;
+	};
+
+	uint32_t m_unVersion;
+	std::vector< Variable_t > m_vecVariables;	// sorted by name
+	std::vector< char > m_bufStrings;			// every name and value, each null terminated
+};
+
+/** Keeps the snapshot that was current when it was made from being freed until it goes out of
+* scope, so it and the EnvVarRef_t values read from it can be used without copying. Costs a few
+* atomic operations and never blocks, but holding one stops every snapshot retired after it from
+* being freed, so keep it to the scope of a lookup. */
+class CEnvironmentSnapshotPin
+{
+public:
+	CEnvironmentSnapshotPin();
+	~CEnvironmentSnapshotPin();
+
+	const CEnvironmentSnapshot &operator*() const { return *m_pSnapshot; }
+	const CEnvironmentSnapshot *operator->() const { return m_pSnapshot; }
+
+private:
+	CEnvironmentSnapshotPin( const CEnvironmentSnapshotPin & ) = delete;
+	CEnvironmentSnapshotPin & operator=( const CEnvironmentSnapshotPin & ) = delete;
+
+	const CEnvironmentSnapshot *m_pSnapshot;
+	uint32_t m_unEpochSlot;
+};
+
+/** Re-reads the process environment if it was changed without going through SetEnvironmentVariable,
+* and publishes a new snapshot if so. Reading the live environment makes it only as thread safe as
+* getenv. When nothing changed it only compares the entry pointers (the block on Windows), so it is
+* cheap enough for the entry points that read overrides, like VR_IsHmdPresent and GetPaths. */
+void RefreshEnvironmentSnapshot();
+
+/** Snapshots that were replaced but not freed yet, because a pin may still see them */
+uint32_t GetRetiredEnvironmentSnapshotCount();
@@ -4,3 +4,6 @@
 const char *GetEnglishStringForHmdError( vr::EVRInitError eError );
 const char *GetIDForVRInitError( vr::EVRInitError eError );
 
+// Reverse of GetIDForVRInitError, for parsing logs. Also accepts the
+// "Unknown error (N)" text it produces for values it has no ID for.
+bool BGetVRInitErrorForID( const char *pchID, vr::EVRInitError *peError );
@@ -0,0 +1,257 @@
+//========= Copyright Valve Corporation ============//
+//
+// Purpose: EVRInitError ID and description tables for hmderrors_public.cpp.
+// This file is auto-generated by codegen/hmderrors_tables.h.py, do not edit it.
+//
+//=============================================================================
+#pragma once
+
+#include <stdint.h>
+
+struct HmdErrorTableEntry_t
+{
+	vr::EVRInitError eError;
+	const char *pchID;
+	const char *pchEnglish;		// nullptr if there is no description
+};
+
+// Sorted by eError
+static constexpr HmdErrorTableEntry_t k_HmdErrorTable[] =
+{
+	{ vr::VRInitError_None, "VRInitError_None", "No Error (0)" },
+	{ vr::VRInitError_Unknown, "VRInitError_Unknown", nullptr },
+	{ vr::VRInitError_Init_InstallationNotFound, "VRInitError_Init_InstallationNotFound", "Installation Not Found (100)" },
+	{ vr::VRInitError_Init_InstallationCorrupt, "VRInitError_Init_InstallationCorrupt", "Installation Corrupt (101)" },
+	{ vr::VRInitError_Init_VRClientDLLNotFound, "VRInitError_Init_VRClientDLLNotFound", "vrclient Shared Lib Not Found (102)" },
+	{ vr::VRInitError_Init_FileNotFound, "VRInitError_Init_FileNotFound", "File Not Found (103)" },
+	{ vr::VRInitError_Init_FactoryNotFound, "VRInitError_Init_FactoryNotFound", "Factory Function Not Found (104)" },
+	{ vr::VRInitError_Init_InterfaceNotFound, "VRInitError_Init_InterfaceNotFound", "Interface Not Found (105)" },
+	{ vr::VRInitError_Init_InvalidInterface, "VRInitError_Init_InvalidInterface", "Invalid Interface (106)" },
+	{ vr::VRInitError_Init_UserConfigDirectoryInvalid, "VRInitError_Init_UserConfigDirectoryInvalid", "User Config Directory Invalid (107)" },
+	{ vr::VRInitError_Init_HmdNotFound, "VRInitError_Init_HmdNotFound", "Hmd Not Found (108)" },
+	{ vr::VRInitError_Init_NotInitialized, "VRInitError_Init_NotInitialized", "Not Initialized (109)" },
+	{ vr::VRInitError_Init_PathRegistryNotFound, "VRInitError_Init_PathRegistryNotFound", "Installation path could not be located (110)" },
+	{ vr::VRInitError_Init_NoConfigPath, "VRInitError_Init_NoConfigPath", "Config path could not be located (111)" },
+	{ vr::VRInitError_Init_NoLogPath, "VRInitError_Init_NoLogPath", "Log path could not be located (112)" },
+	{ vr::VRInitError_Init_PathRegistryNotWritable, "VRInitError_Init_PathRegistryNotWritable", "Unable to write path registry (113)" },
+	{ vr::VRInitError_Init_AppInfoInitFailed, "VRInitError_Init_AppInfoInitFailed", "App info manager init failed (114)" },
+	{ vr::VRInitError_Init_Retry, "VRInitError_Init_Retry", "Internal Retry (115)" },
+	{ vr::VRInitError_Init_InitCanceledByUser, "VRInitError_Init_InitCanceledByUser", "User Canceled Init (116)" },
+	{ vr::VRInitError_Init_AnotherAppLaunching, "VRInitError_Init_AnotherAppLaunching", "Another app was already launching (117)" },
+	{ vr::VRInitError_Init_SettingsInitFailed, "VRInitError_Init_SettingsInitFailed", "Settings manager init failed (118)" },
+	{ vr::VRInitError_Init_ShuttingDown, "VRInitError_Init_ShuttingDown", "VR system shutting down (119)" },
+	{ vr::VRInitError_Init_TooManyObjects, "VRInitError_Init_TooManyObjects", "Too many tracked objects (120)" },
+	{ vr::VRInitError_Init_NoServerForBackgroundApp, "VRInitError_Init_NoServerForBackgroundApp", "Not starting vrserver for background app (121)" },
+	{ vr::VRInitError_Init_NotSupportedWithCompositor, "VRInitError_Init_NotSupportedWithCompositor", "The requested interface is incompatible with the compositor and the compositor is running (122)" },
+	{ vr::VRInitError_Init_NotAvailableToUtilityApps, "VRInitError_Init_NotAvailableToUtilityApps", "This interface is not available to utility applications (123)" },
+	{ vr::VRInitError_Init_Internal, "VRInitError_Init_Internal", "vrserver internal error (124)" },
+	{ vr::VRInitError_Init_HmdDriverIdIsNone, "VRInitError_Init_HmdDriverIdIsNone", "Hmd DriverId is invalid (125)" },
+	{ vr::VRInitError_Init_HmdNotFoundPresenceFailed, "VRInitError_Init_HmdNotFoundPresenceFailed", "Hmd Not Found Presence Failed (126)" },
+	{ vr::VRInitError_Init_VRMonitorNotFound, "VRInitError_Init_VRMonitorNotFound", "VR Monitor Not Found (127)" },
+	{ vr::VRInitError_Init_VRMonitorStartupFailed, "VRInitError_Init_VRMonitorStartupFailed", "VR Monitor startup failed (128)" },
+	{ vr::VRInitError_Init_LowPowerWatchdogNotSupported, "VRInitError_Init_LowPowerWatchdogNotSupported", "Low Power Watchdog Not Supported (129)" },
+	{ vr::VRInitError_Init_InvalidApplicationType, "VRInitError_Init_InvalidApplicationType", "Invalid Application Type (130)" },
+	{ vr::VRInitError_Init_NotAvailableToWatchdogApps, "VRInitError_Init_NotAvailableToWatchdogApps", "Not available to watchdog apps (131)" },
+	{ vr::VRInitError_Init_WatchdogDisabledInSettings, "VRInitError_Init_WatchdogDisabledInSettings", "Watchdog disabled in settings (132)" },
+	{ vr::VRInitError_Init_VRDashboardNotFound, "VRInitError_Init_VRDashboardNotFound", "VR Dashboard Not Found (133)" },
+	{ vr::VRInitError_Init_VRDashboardStartupFailed, "VRInitError_Init_VRDashboardStartupFailed", "VR Dashboard startup failed (134)" },
+	{ vr::VRInitError_Init_VRHomeNotFound, "VRInitError_Init_VRHomeNotFound", "VR Home Not Found (135)" },
+	{ vr::VRInitError_Init_VRHomeStartupFailed, "VRInitError_Init_VRHomeStartupFailed", "VR home startup failed (136)" },
+	{ vr::VRInitError_Init_RebootingBusy, "VRInitError_Init_RebootingBusy", "Rebooting In Progress (137)" },
+	{ vr::VRInitError_Init_FirmwareUpdateBusy, "VRInitError_Init_FirmwareUpdateBusy", "Firmware Update In Progress (138)" },
+	{ vr::VRInitError_Init_FirmwareRecoveryBusy, "VRInitError_Init_FirmwareRecoveryBusy", "Firmware Recovery In Progress (139)" },
+	{ vr::VRInitError_Init_USBServiceBusy, "VRInitError_Init_USBServiceBusy", "USB Service Busy (140)" },
+	{ vr::VRInitError_Init_VRWebHelperStartupFailed, "VRInitError_Init_VRWebHelperStartupFailed", nullptr },
+	{ vr::VRInitError_Init_TrackerManagerInitFailed, "VRInitError_Init_TrackerManagerInitFailed", nullptr },
+	{ vr::VRInitError_Init_AlreadyRunning, "VRInitError_Init_AlreadyRunning", nullptr },
+	{ vr::VRInitError_Init_FailedForVrMonitor, "VRInitError_Init_FailedForVrMonitor", nullptr },
+	{ vr::VRInitError_Init_PropertyManagerInitFailed, "VRInitError_Init_PropertyManagerInitFailed", nullptr },
+	{ vr::VRInitError_Init_WebServerFailed, "VRInitError_Init_WebServerFailed", nullptr },
+	{ vr::VRInitError_Init_IllegalTypeTransition, "VRInitError_Init_IllegalTypeTransition", nullptr },
+	{ vr::VRInitError_Init_MismatchedRuntimes, "VRInitError_Init_MismatchedRuntimes", nullptr },
+	{ vr::VRInitError_Init_InvalidProcessId, "VRInitError_Init_InvalidProcessId", nullptr },
+	{ vr::VRInitError_Init_VRServiceStartupFailed, "VRInitError_Init_VRServiceStartupFailed", nullptr },
+	{ vr::VRInitError_Init_PrismNeedsNewDrivers, "VRInitError_Init_PrismNeedsNewDrivers", nullptr },
+	{ vr::VRInitError_Init_PrismStartupTimedOut, "VRInitError_Init_PrismStartupTimedOut", nullptr },
+	{ vr::VRInitError_Init_CouldNotStartPrism, "VRInitError_Init_CouldNotStartPrism", nullptr },
+	{ vr::VRInitError_Init_PrismClientInitFailed, "VRInitError_Init_PrismClientInitFailed", nullptr },
+	{ vr::VRInitError_Init_PrismClientStartFailed, "VRInitError_Init_PrismClientStartFailed", nullptr },
+	{ vr::VRInitError_Init_PrismExitedUnexpectedly, "VRInitError_Init_PrismExitedUnexpectedly", nullptr },
+	{ vr::VRInitError_Init_BadLuid, "VRInitError_Init_BadLuid", nullptr },
+	{ vr::VRInitError_Init_NoServerForAppContainer, "VRInitError_Init_NoServerForAppContainer", nullptr },
+	{ vr::VRInitError_Init_DuplicateBootstrapper, "VRInitError_Init_DuplicateBootstrapper", nullptr },
+	{ vr::VRInitError_Init_VRDashboardServicePending, "VRInitError_Init_VRDashboardServicePending", "VR Dashboard startup failed, vrservice was pending for too long (160)" },
+	{ vr::VRInitError_Init_VRDashboardServiceTimeout, "VRInitError_Init_VRDashboardServiceTimeout", "VR Dashboard startup failed, attempt to communicate with vrservice timed out (161)" },
+	{ vr::VRInitError_Init_VRDashboardServiceStopped, "VRInitError_Init_VRDashboardServiceStopped", "VR Dashboard startup failed, vrservice was stopped (162)" },
+	{ vr::VRInitError_Init_VRDashboardAlreadyStarted, "VRInitError_Init_VRDashboardAlreadyStarted", "VR Dashboard startup failed, vrdashboard was already running (163)" },
+	{ vr::VRInitError_Init_VRDashboardCopyFailed, "VRInitError_Init_VRDashboardCopyFailed", "VR Dashboard startup failed, required files did not copy correctly (164)" },
+	{ vr::VRInitError_Init_VRDashboardTokenFailure, "VRInitError_Init_VRDashboardTokenFailure", "VR Dashboard startup failed, unable to create appropriate token (165)" },
+	{ vr::VRInitError_Init_VRDashboardEnvironmentFailure, "VRInitError_Init_VRDashboardEnvironmentFailure", "VR Dashboard startup failed, unable to create appropriate environment (166)" },
+	{ vr::VRInitError_Init_VRDashboardPathFailure, "VRInitError_Init_VRDashboardPathFailure", "VR Dashboard startup failed, path error (167)" },
+	{ vr::VRInitError_Driver_Failed, "VRInitError_Driver_Failed", "Driver Failed (200)" },
+	{ vr::VRInitError_Driver_Unknown, "VRInitError_Driver_Unknown", "Driver Not Known (201)" },
+	{ vr::VRInitError_Driver_HmdUnknown, "VRInitError_Driver_HmdUnknown", "HMD Not Known (202)" },
+	{ vr::VRInitError_Driver_NotLoaded, "VRInitError_Driver_NotLoaded", "Driver Not Loaded (203)" },
+	{ vr::VRInitError_Driver_RuntimeOutOfDate, "VRInitError_Driver_RuntimeOutOfDate", "Driver runtime is out of date (204)" },
+	{ vr::VRInitError_Driver_HmdInUse, "VRInitError_Driver_HmdInUse", "HMD already in use by another application (205)" },
+	{ vr::VRInitError_Driver_NotCalibrated, "VRInitError_Driver_NotCalibrated", "Device is not calibrated (206)" },
+	{ vr::VRInitError_Driver_CalibrationInvalid, "VRInitError_Driver_CalibrationInvalid", "Device Calibration is invalid (207)" },
+	{ vr::VRInitError_Driver_HmdDisplayNotFound, "VRInitError_Driver_HmdDisplayNotFound", "HMD detected over USB, but Monitor not found (208)" },
+	{ vr::VRInitError_Driver_TrackedDeviceInterfaceUnknown, "VRInitError_Driver_TrackedDeviceInterfaceUnknown", "Driver Tracked Device Interface unknown (209)" },
+	{ vr::VRInitError_Driver_HmdDriverIdOutOfBounds, "VRInitError_Driver_HmdDriverIdOutOfBounds", "Hmd DriverId is our of bounds (211)" },
+	{ vr::VRInitError_Driver_HmdDisplayMirrored, "VRInitError_Driver_HmdDisplayMirrored", "HMD detected over USB, but Monitor may be mirrored instead of extended (212)" },
+	{ vr::VRInitError_Driver_HmdDisplayNotFoundLaptop, "VRInitError_Driver_HmdDisplayNotFoundLaptop", "On laptop, HMD detected over USB, but Monitor not found (213)" },
+	{ vr::VRInitError_Driver_PeerDriverNotInstalled, "VRInitError_Driver_PeerDriverNotInstalled", "The current HMD requires an additional driver that is not installed (214)" },
+	{ vr::VRInitError_Driver_WirelessHmdNotConnected, "VRInitError_Driver_WirelessHmdNotConnected", "A wireless HMD driver is present, but the wireless HMD has not connected yet (215)" },
+	{ vr::VRInitError_IPC_ServerInitFailed, "VRInitError_IPC_ServerInitFailed", "VR Server Init Failed (300)" },
+	{ vr::VRInitError_IPC_ConnectFailed, "VRInitError_IPC_ConnectFailed", "Connect to VR Server Failed (301)" },
+	{ vr::VRInitError_IPC_SharedStateInitFailed, "VRInitError_IPC_SharedStateInitFailed", "Shared IPC State Init Failed (302)" },
+	{ vr::VRInitError_IPC_CompositorInitFailed, "VRInitError_IPC_CompositorInitFailed", "Shared IPC Compositor Init Failed (303)" },
+	{ vr::VRInitError_IPC_MutexInitFailed, "VRInitError_IPC_MutexInitFailed", "Shared IPC Mutex Init Failed (304)" },
+	{ vr::VRInitError_IPC_Failed, "VRInitError_IPC_Failed", "Shared IPC Failed (305)" },
+	{ vr::VRInitError_IPC_CompositorConnectFailed, "VRInitError_IPC_CompositorConnectFailed", "Shared IPC Compositor Connect Failed (306)" },
+	{ vr::VRInitError_IPC_CompositorInvalidConnectResponse, "VRInitError_IPC_CompositorInvalidConnectResponse", "Shared IPC Compositor Invalid Connect Response (307)" },
+	{ vr::VRInitError_IPC_ConnectFailedAfterMultipleAttempts, "VRInitError_IPC_ConnectFailedAfterMultipleAttempts", "Shared IPC Connect Failed After Multiple Attempts (308)" },
+	{ vr::VRInitError_IPC_ConnectFailedAfterTargetExited, "VRInitError_IPC_ConnectFailedAfterTargetExited", "Shared IPC Connect Failed After Target Exited (309)" },
+	{ vr::VRInitError_IPC_NamespaceUnavailable, "VRInitError_IPC_NamespaceUnavailable", "Shared IPC Namespace Unavailable (310)" },
+	{ vr::VRInitError_Compositor_Failed, "VRInitError_Compositor_Failed", "Compositor failed to initialize (400)" },
+	{ vr::VRInitError_Compositor_D3D11HardwareRequired, "VRInitError_Compositor_D3D11HardwareRequired", "Compositor failed to find DX11 hardware (401)" },
+	{ vr::VRInitError_Compositor_FirmwareRequiresUpdate, "VRInitError_Compositor_FirmwareRequiresUpdate", "Compositor requires mandatory firmware update (402)" },
+	{ vr::VRInitError_Compositor_OverlayInitFailed, "VRInitError_Compositor_OverlayInitFailed", "Compositor initialization succeeded, but overlay init failed (403)" },
+	{ vr::VRInitError_Compositor_ScreenshotsInitFailed, "VRInitError_Compositor_ScreenshotsInitFailed", "Compositor initialization succeeded, but screenshot init failed (404)" },
+	{ vr::VRInitError_Compositor_UnableToCreateDevice, "VRInitError_Compositor_UnableToCreateDevice", "Compositor unable to create graphics device (405)" },
+	{ vr::VRInitError_Compositor_SharedStateIsNull, "VRInitError_Compositor_SharedStateIsNull", nullptr },
+	{ vr::VRInitError_Compositor_NotificationManagerIsNull, "VRInitError_Compositor_NotificationManagerIsNull", nullptr },
+	{ vr::VRInitError_Compositor_ResourceManagerClientIsNull, "VRInitError_Compositor_ResourceManagerClientIsNull", nullptr },
+	{ vr::VRInitError_Compositor_MessageOverlaySharedStateInitFailure, "VRInitError_Compositor_MessageOverlaySharedStateInitFailure", nullptr },
+	{ vr::VRInitError_Compositor_PropertiesInterfaceIsNull, "VRInitError_Compositor_PropertiesInterfaceIsNull", nullptr },
+	{ vr::VRInitError_Compositor_CreateFullscreenWindowFailed, "VRInitError_Compositor_CreateFullscreenWindowFailed", nullptr },
+	{ vr::VRInitError_Compositor_SettingsInterfaceIsNull, "VRInitError_Compositor_SettingsInterfaceIsNull", nullptr },
+	{ vr::VRInitError_Compositor_FailedToShowWindow, "VRInitError_Compositor_FailedToShowWindow", nullptr },
+	{ vr::VRInitError_Compositor_DistortInterfaceIsNull, "VRInitError_Compositor_DistortInterfaceIsNull", nullptr },
+	{ vr::VRInitError_Compositor_DisplayFrequencyFailure, "VRInitError_Compositor_DisplayFrequencyFailure", nullptr },
+	{ vr::VRInitError_Compositor_RendererInitializationFailed, "VRInitError_Compositor_RendererInitializationFailed", nullptr },
+	{ vr::VRInitError_Compositor_DXGIFactoryInterfaceIsNull, "VRInitError_Compositor_DXGIFactoryInterfaceIsNull", nullptr },
+	{ vr::VRInitError_Compositor_DXGIFactoryCreateFailed, "VRInitError_Compositor_DXGIFactoryCreateFailed", nullptr },
+	{ vr::VRInitError_Compositor_DXGIFactoryQueryFailed, "VRInitError_Compositor_DXGIFactoryQueryFailed", nullptr },
+	{ vr::VRInitError_Compositor_InvalidAdapterDesktop, "VRInitError_Compositor_InvalidAdapterDesktop", nullptr },
+	{ vr::VRInitError_Compositor_InvalidHmdAttachment, "VRInitError_Compositor_InvalidHmdAttachment", nullptr },
+	{ vr::VRInitError_Compositor_InvalidOutputDesktop, "VRInitError_Compositor_InvalidOutputDesktop", nullptr },
+	{ vr::VRInitError_Compositor_InvalidDeviceProvided, "VRInitError_Compositor_InvalidDeviceProvided", nullptr },
+	{ vr::VRInitError_Compositor_D3D11RendererInitializationFailed, "VRInitError_Compositor_D3D11RendererInitializationFailed", nullptr },
+	{ vr::VRInitError_Compositor_FailedToFindDisplayMode, "VRInitError_Compositor_FailedToFindDisplayMode", nullptr },
+	{ vr::VRInitError_Compositor_FailedToCreateSwapChain, "VRInitError_Compositor_FailedToCreateSwapChain", nullptr },
+	{ vr::VRInitError_Compositor_FailedToGetBackBuffer, "VRInitError_Compositor_FailedToGetBackBuffer", nullptr },
+	{ vr::VRInitError_Compositor_FailedToCreateRenderTarget, "VRInitError_Compositor_FailedToCreateRenderTarget", nullptr },
+	{ vr::VRInitError_Compositor_FailedToCreateDXGI2SwapChain, "VRInitError_Compositor_FailedToCreateDXGI2SwapChain", nullptr },
+	{ vr::VRInitError_Compositor_FailedtoGetDXGI2BackBuffer, "VRInitError_Compositor_FailedtoGetDXGI2BackBuffer", nullptr },
+	{ vr::VRInitError_Compositor_FailedToCreateDXGI2RenderTarget, "VRInitError_Compositor_FailedToCreateDXGI2RenderTarget", nullptr },
+	{ vr::VRInitError_Compositor_FailedToGetDXGIDeviceInterface, "VRInitError_Compositor_FailedToGetDXGIDeviceInterface", nullptr },
+	{ vr::VRInitError_Compositor_SelectDisplayMode, "VRInitError_Compositor_SelectDisplayMode", nullptr },
+	{ vr::VRInitError_Compositor_FailedToCreateNvAPIRenderTargets, "VRInitError_Compositor_FailedToCreateNvAPIRenderTargets", nullptr },
+	{ vr::VRInitError_Compositor_NvAPISetDisplayMode, "VRInitError_Compositor_NvAPISetDisplayMode", nullptr },
+	{ vr::VRInitError_Compositor_FailedToCreateDirectModeDisplay, "VRInitError_Compositor_FailedToCreateDirectModeDisplay", nullptr },
+	{ vr::VRInitError_Compositor_InvalidHmdPropertyContainer, "VRInitError_Compositor_InvalidHmdPropertyContainer", nullptr },
+	{ vr::VRInitError_Compositor_UpdateDisplayFrequency, "VRInitError_Compositor_UpdateDisplayFrequency", nullptr },
+	{ vr::VRInitError_Compositor_CreateRasterizerState, "VRInitError_Compositor_CreateRasterizerState", nullptr },
+	{ vr::VRInitError_Compositor_CreateWireframeRasterizerState, "VRInitError_Compositor_CreateWireframeRasterizerState", nullptr },
+	{ vr::VRInitError_Compositor_CreateSamplerState, "VRInitError_Compositor_CreateSamplerState", nullptr },
+	{ vr::VRInitError_Compositor_CreateClampToBorderSamplerState, "VRInitError_Compositor_CreateClampToBorderSamplerState", nullptr },
+	{ vr::VRInitError_Compositor_CreateAnisoSamplerState, "VRInitError_Compositor_CreateAnisoSamplerState", nullptr },
+	{ vr::VRInitError_Compositor_CreateOverlaySamplerState, "VRInitError_Compositor_CreateOverlaySamplerState", nullptr },
+	{ vr::VRInitError_Compositor_CreatePanoramaSamplerState, "VRInitError_Compositor_CreatePanoramaSamplerState", nullptr },
+	{ vr::VRInitError_Compositor_CreateFontSamplerState, "VRInitError_Compositor_CreateFontSamplerState", nullptr },
+	{ vr::VRInitError_Compositor_CreateNoBlendState, "VRInitError_Compositor_CreateNoBlendState", nullptr },
+	{ vr::VRInitError_Compositor_CreateBlendState, "VRInitError_Compositor_CreateBlendState", nullptr },
+	{ vr::VRInitError_Compositor_CreateAlphaBlendState, "VRInitError_Compositor_CreateAlphaBlendState", nullptr },
+	{ vr::VRInitError_Compositor_CreateBlendStateMaskR, "VRInitError_Compositor_CreateBlendStateMaskR", nullptr },
+	{ vr::VRInitError_Compositor_CreateBlendStateMaskG, "VRInitError_Compositor_CreateBlendStateMaskG", nullptr },
+	{ vr::VRInitError_Compositor_CreateBlendStateMaskB, "VRInitError_Compositor_CreateBlendStateMaskB", nullptr },
+	{ vr::VRInitError_Compositor_CreateDepthStencilState, "VRInitError_Compositor_CreateDepthStencilState", nullptr },
+	{ vr::VRInitError_Compositor_CreateDepthStencilStateNoWrite, "VRInitError_Compositor_CreateDepthStencilStateNoWrite", nullptr },
+	{ vr::VRInitError_Compositor_CreateDepthStencilStateNoDepth, "VRInitError_Compositor_CreateDepthStencilStateNoDepth", nullptr },
+	{ vr::VRInitError_Compositor_CreateFlushTexture, "VRInitError_Compositor_CreateFlushTexture", nullptr },
+	{ vr::VRInitError_Compositor_CreateDistortionSurfaces, "VRInitError_Compositor_CreateDistortionSurfaces", nullptr },
+	{ vr::VRInitError_Compositor_CreateConstantBuffer, "VRInitError_Compositor_CreateConstantBuffer", nullptr },
+	{ vr::VRInitError_Compositor_CreateHmdPoseConstantBuffer, "VRInitError_Compositor_CreateHmdPoseConstantBuffer", nullptr },
+	{ vr::VRInitError_Compositor_CreateHmdPoseStagingConstantBuffer, "VRInitError_Compositor_CreateHmdPoseStagingConstantBuffer", nullptr },
+	{ vr::VRInitError_Compositor_CreateSharedFrameInfoConstantBuffer, "VRInitError_Compositor_CreateSharedFrameInfoConstantBuffer", nullptr },
+	{ vr::VRInitError_Compositor_CreateOverlayConstantBuffer, "VRInitError_Compositor_CreateOverlayConstantBuffer", nullptr },
+	{ vr::VRInitError_Compositor_CreateSceneTextureIndexConstantBuffer, "VRInitError_Compositor_CreateSceneTextureIndexConstantBuffer", nullptr },
+	{ vr::VRInitError_Compositor_CreateReadableSceneTextureIndexConstantBuffer, "VRInitError_Compositor_CreateReadableSceneTextureIndexConstantBuffer", nullptr },
+	{ vr::VRInitError_Compositor_CreateLayerGraphicsTextureIndexConstantBuffer, "VRInitError_Compositor_CreateLayerGraphicsTextureIndexConstantBuffer", nullptr },
+	{ vr::VRInitError_Compositor_CreateLayerComputeTextureIndexConstantBuffer, "VRInitError_Compositor_CreateLayerComputeTextureIndexConstantBuffer", nullptr },
+	{ vr::VRInitError_Compositor_CreateLayerComputeSceneTextureIndexConstantBuffer, "VRInitError_Compositor_CreateLayerComputeSceneTextureIndexConstantBuffer", nullptr },
+	{ vr::VRInitError_Compositor_CreateComputeHmdPoseConstantBuffer, "VRInitError_Compositor_CreateComputeHmdPoseConstantBuffer", nullptr },
+	{ vr::VRInitError_Compositor_CreateGeomConstantBuffer, "VRInitError_Compositor_CreateGeomConstantBuffer", nullptr },
+	{ vr::VRInitError_Compositor_CreatePanelMaskConstantBuffer, "VRInitError_Compositor_CreatePanelMaskConstantBuffer", nullptr },
+	{ vr::VRInitError_Compositor_CreatePixelSimUBO, "VRInitError_Compositor_CreatePixelSimUBO", nullptr },
+	{ vr::VRInitError_Compositor_CreateMSAARenderTextures, "VRInitError_Compositor_CreateMSAARenderTextures", nullptr },
+	{ vr::VRInitError_Compositor_CreateResolveRenderTextures, "VRInitError_Compositor_CreateResolveRenderTextures", nullptr },
+	{ vr::VRInitError_Compositor_CreateComputeResolveRenderTextures, "VRInitError_Compositor_CreateComputeResolveRenderTextures", nullptr },
+	{ vr::VRInitError_Compositor_CreateDriverDirectModeResolveTextures, "VRInitError_Compositor_CreateDriverDirectModeResolveTextures", nullptr },
+	{ vr::VRInitError_Compositor_OpenDriverDirectModeResolveTextures, "VRInitError_Compositor_OpenDriverDirectModeResolveTextures", nullptr },
+	{ vr::VRInitError_Compositor_CreateFallbackSyncTexture, "VRInitError_Compositor_CreateFallbackSyncTexture", nullptr },
+	{ vr::VRInitError_Compositor_ShareFallbackSyncTexture, "VRInitError_Compositor_ShareFallbackSyncTexture", nullptr },
+	{ vr::VRInitError_Compositor_CreateOverlayIndexBuffer, "VRInitError_Compositor_CreateOverlayIndexBuffer", nullptr },
+	{ vr::VRInitError_Compositor_CreateOverlayVertexBuffer, "VRInitError_Compositor_CreateOverlayVertexBuffer", nullptr },
+	{ vr::VRInitError_Compositor_CreateTextVertexBuffer, "VRInitError_Compositor_CreateTextVertexBuffer", nullptr },
+	{ vr::VRInitError_Compositor_CreateTextIndexBuffer, "VRInitError_Compositor_CreateTextIndexBuffer", nullptr },
+	{ vr::VRInitError_Compositor_CreateMirrorTextures, "VRInitError_Compositor_CreateMirrorTextures", nullptr },
+	{ vr::VRInitError_Compositor_CreateLastFrameRenderTexture, "VRInitError_Compositor_CreateLastFrameRenderTexture", nullptr },
+	{ vr::VRInitError_Compositor_CreateMirrorOverlay, "VRInitError_Compositor_CreateMirrorOverlay", nullptr },
+	{ vr::VRInitError_Compositor_FailedToCreateVirtualDisplayBackbuffer, "VRInitError_Compositor_FailedToCreateVirtualDisplayBackbuffer", nullptr },
+	{ vr::VRInitError_Compositor_DisplayModeNotSupported, "VRInitError_Compositor_DisplayModeNotSupported", nullptr },
+	{ vr::VRInitError_Compositor_CreateOverlayInvalidCall, "VRInitError_Compositor_CreateOverlayInvalidCall", nullptr },
+	{ vr::VRInitError_Compositor_CreateOverlayAlreadyInitialized, "VRInitError_Compositor_CreateOverlayAlreadyInitialized", nullptr },
+	{ vr::VRInitError_Compositor_FailedToCreateMailbox, "VRInitError_Compositor_FailedToCreateMailbox", nullptr },
+	{ vr::VRInitError_Compositor_WindowInterfaceIsNull, "VRInitError_Compositor_WindowInterfaceIsNull", nullptr },
+	{ vr::VRInitError_Compositor_SystemLayerCreateInstance, "VRInitError_Compositor_SystemLayerCreateInstance", nullptr },
+	{ vr::VRInitError_Compositor_SystemLayerCreateSession, "VRInitError_Compositor_SystemLayerCreateSession", nullptr },
+	{ vr::VRInitError_Compositor_CreateInverseDistortUVs, "VRInitError_Compositor_CreateInverseDistortUVs", nullptr },
+	{ vr::VRInitError_Compositor_CreateBackbufferDepth, "VRInitError_Compositor_CreateBackbufferDepth", nullptr },
+	{ vr::VRInitError_Compositor_CannotDRMLeaseDisplay, "VRInitError_Compositor_CannotDRMLeaseDisplay", nullptr },
+	{ vr::VRInitError_Compositor_CannotConnectToDisplayServer, "VRInitError_Compositor_CannotConnectToDisplayServer", nullptr },
+	{ vr::VRInitError_Compositor_GnomeNoDRMLeasing, "VRInitError_Compositor_GnomeNoDRMLeasing", nullptr },
+	{ vr::VRInitError_Compositor_FailedToInitializeEncoder, "VRInitError_Compositor_FailedToInitializeEncoder", "Driver unable to initialize video encoder (499)" },
+	{ vr::VRInitError_Compositor_CreateBlurTexture, "VRInitError_Compositor_CreateBlurTexture", nullptr },
+	{ vr::VRInitError_VendorSpecific_UnableToConnectToOculusRuntime, "VRInitError_VendorSpecific_UnableToConnectToOculusRuntime", "Unable to connect to Oculus Runtime (1000)" },
+	{ vr::VRInitError_VendorSpecific_WindowsNotInDevMode, "VRInitError_VendorSpecific_WindowsNotInDevMode", nullptr },
+	{ vr::VRInitError_VendorSpecific_OculusLinkNotEnabled, "VRInitError_VendorSpecific_OculusLinkNotEnabled", nullptr },
+	{ vr::VRInitError_VendorSpecific_HmdFound_CantOpenDevice, "VRInitError_VendorSpecific_HmdFound_CantOpenDevice", "HMD found, but can not open device (1101)" },
+	{ vr::VRInitError_VendorSpecific_HmdFound_UnableToRequestConfigStart, "VRInitError_VendorSpecific_HmdFound_UnableToRequestConfigStart", "HMD found, but unable to request config (1102)" },
+	{ vr::VRInitError_VendorSpecific_HmdFound_NoStoredConfig, "VRInitError_VendorSpecific_HmdFound_NoStoredConfig", "HMD found, but no stored config (1103)" },
+	{ vr::VRInitError_VendorSpecific_HmdFound_ConfigTooBig, "VRInitError_VendorSpecific_HmdFound_ConfigTooBig", "HMD found, but config too big (1104)" },
+	{ vr::VRInitError_VendorSpecific_HmdFound_ConfigTooSmall, "VRInitError_VendorSpecific_HmdFound_ConfigTooSmall", "HMD found, but config too small (1105)" },
+	{ vr::VRInitError_VendorSpecific_HmdFound_UnableToInitZLib, "VRInitError_VendorSpecific_HmdFound_UnableToInitZLib", "HMD found, but unable to init ZLib (1106)" },
+	{ vr::VRInitError_VendorSpecific_HmdFound_CantReadFirmwareVersion, "VRInitError_VendorSpecific_HmdFound_CantReadFirmwareVersion", "HMD found, but problems with the data (1107)" },
+	{ vr::VRInitError_VendorSpecific_HmdFound_UnableToSendUserDataStart, "VRInitError_VendorSpecific_HmdFound_UnableToSendUserDataStart", "HMD found, but problems with the data (1108)" },
+	{ vr::VRInitError_VendorSpecific_HmdFound_UnableToGetUserDataStart, "VRInitError_VendorSpecific_HmdFound_UnableToGetUserDataStart", "HMD found, but problems with the data (1109)" },
+	{ vr::VRInitError_VendorSpecific_HmdFound_UnableToGetUserDataNext, "VRInitError_VendorSpecific_HmdFound_UnableToGetUserDataNext", "HMD found, but problems with the data (1110)" },
+	{ vr::VRInitError_VendorSpecific_HmdFound_UserDataAddressRange, "VRInitError_VendorSpecific_HmdFound_UserDataAddressRange", "HMD found, but problems with the data (1111)" },
+	{ vr::VRInitError_VendorSpecific_HmdFound_UserDataError, "VRInitError_VendorSpecific_HmdFound_UserDataError", "HMD found, but problems with the data (1112)" },
+	{ vr::VRInitError_VendorSpecific_HmdFound_ConfigFailedSanityCheck, "VRInitError_VendorSpecific_HmdFound_ConfigFailedSanityCheck", "HMD found, but failed configuration check (1113)" },
+	{ vr::VRInitError_VendorSpecific_OculusRuntimeBadInstall, "VRInitError_VendorSpecific_OculusRuntimeBadInstall", "Unable to connect to Oculus Runtime, possible bad install (1114)" },
+	{ vr::VRInitError_VendorSpecific_HmdFound_UnexpectedConfiguration_1, "VRInitError_VendorSpecific_HmdFound_UnexpectedConfiguration_1", "HMD found, but problems with the data (1115)" },
+	{ vr::VRInitError_Steam_SteamInstallationNotFound, "VRInitError_Steam_SteamInstallationNotFound", "Unable to find Steam installation (2000)" },
+	{ vr::VRInitError_LastError, "VRInitError_LastError", nullptr },
+};
+
+// Indices into k_HmdErrorTable, sorted by pchID
+static constexpr uint16_t k_HmdErrorIndexByID[] =
+{
+	193, 192, 145, 139, 191, 144, 148, 147, 146, 196, 138, 164, 170, 154, 149, 151,
+	150, 153, 171, 173, 152, 142, 107, 165, 155, 156, 190, 180, 163, 162, 161, 168,
+	181, 179, 143, 185, 158, 175, 184, 140, 176, 166, 141, 167, 135, 160, 169, 137,
+	159, 157, 178, 177, 136, 97, 120, 114, 113, 115, 111, 183, 110, 96, 127, 125,
+	132, 186, 130, 124, 122, 182, 121, 123, 128, 195, 109, 126, 98, 194, 116, 119,
+	117, 133, 118, 105, 103, 131, 172, 99, 106, 112, 104, 100, 129, 108, 174, 102,
+	188, 189, 101, 134, 187, 77, 70, 81, 78, 82, 80, 75, 72, 76, 73, 83,
+	74, 79, 71, 84, 91, 88, 92, 86, 93, 94, 90, 89, 95, 85, 87, 45,
+	19, 16, 59, 55, 61, 6, 46, 5, 41, 40, 27, 10, 28, 49, 18, 3,
+	2, 7, 26, 32, 8, 51, 31, 50, 13, 14, 60, 23, 25, 33, 11, 24,
+	12, 15, 56, 57, 58, 53, 54, 47, 39, 17, 20, 21, 22, 44, 42, 9,
+	4, 65, 66, 68, 35, 69, 62, 64, 63, 36, 67, 37, 38, 29, 30, 52,
+	43, 34, 48, 216, 0, 215, 1, 200, 206, 212, 203, 204, 202, 209, 208, 205,
+	201, 207, 214, 210, 211, 199, 213, 197, 198,
+};
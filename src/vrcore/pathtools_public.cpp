@@ -28,7 +28,16 @@
 
 #include <sys/stat.h>
 
+#if defined( POSIX )
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <errno.h>
+#include <string.h>
+#endif
+
 #include <algorithm>
+#include <set>
 
 /** Returns the path (including filename) to the current executable */
 std::string Path_GetExecutablePath()
@@ -118,68 +127,92 @@ std::string Path_GetTemporaryDirectory()
 }
 
 /** Returns the specified path without its filename */
-std::string Path_StripFilename( const std::string & sPath, char slash )
+PathRef_t Path_StripFilenameRef( PathRef_t path, char slash )
 {
 	if( slash == 0 )
 		slash = Path_GetSlash();
 
-	std::string::size_type n = sPath.find_last_of( slash );
-	if( n == std::string::npos )
-		return sPath;
-	else
-		return std::string( sPath.begin(), sPath.begin() + n );
+	for( size_t n = path.unLength; n > 0; n-- )
+	{
+		if( path.pch[ n - 1 ] == slash )
+			return PathRef_t( path.pch, n - 1 );
+	}
+	return path;
+}
+
+std::string Path_StripFilename( const std::string & sPath, char slash )
+{
+	return Path_StripFilenameRef( sPath, slash ).ToString();
 }
 
 /** returns just the filename from the provided full or relative path. */
-std::string Path_StripDirectory( const std::string & sPath, char slash )
+PathRef_t Path_StripDirectoryRef( PathRef_t path, char slash )
 {
 	if( slash == 0 )
 		slash = Path_GetSlash();
 
-	std::string::size_type n = sPath.find_last_of( slash );
-	if( n == std::string::npos )
-		return sPath;
-	else
-		return std::string( sPath.begin() + n + 1, sPath.end() );
+	for( size_t n = path.unLength; n > 0; n-- )
+	{
+		if( path.pch[ n - 1 ] == slash )
+			return PathRef_t( path.pch + n, path.unLength - n );
+	}
+	return path;
+}
+
+std::string Path_StripDirectory( const std::string & sPath, char slash )
+{
+	return Path_StripDirectoryRef( sPath, slash ).ToString();
 }
 
 /** returns just the filename with no extension of the provided filename. 
 * If there is a path the path is left intact. */
-std::string Path_StripExtension( const std::string & sPath )
+PathRef_t Path_StripExtensionRef( PathRef_t path )
 {
-	for( std::string::const_reverse_iterator i = sPath.rbegin(); i != sPath.rend(); i++ )
+	for( size_t n = path.unLength; n > 0; n-- )
 	{
-		if( *i == '.' )
+		char c = path.pch[ n - 1 ];
+		if( c == '.' )
 		{
-			return std::string( sPath.begin(), i.base() - 1 );
+			return PathRef_t( path.pch, n - 1 );
 		}
 
 		// if we find a slash there is no extension
-		if( *i == '\\' || *i == '/' )
+		if( c == '\\' || c == '/' )
 			break;
 	}
 
 	// we didn't find an extension
-	return sPath;
+	return path;
+}
+
+std::string Path_StripExtension( const std::string & sPath )
+{
+	return Path_StripExtensionRef( sPath ).ToString();
 }
 
 /** returns just extension of the provided filename (if any). */
-std::string Path_GetExtension( const std::string & sPath )
+PathRef_t Path_GetExtensionRef( PathRef_t path )
 {
-	for ( std::string::const_reverse_iterator i = sPath.rbegin(); i != sPath.rend(); i++ )
+	for ( size_t n = path.unLength; n > 0; n-- )
 	{
-		if ( *i == '.' )
+		char c = path.pch[ n - 1 ];
+		if ( c == '.' )
 		{
-			return std::string( i.base(), sPath.end() );
+			return PathRef_t( path.pch + n, path.unLength - n );
 		}
 
 		// if we find a slash there is no extension
-		if ( *i == '\\' || *i == '/' )
+		if ( c == '\\' || c == '/' )
 			break;
 	}
 
 	// we didn't find an extension
-	return "";
+	return PathRef_t();
+}
+
+std::string Path_GetExtension( const std::string & sPath )
+{
+	return Path_GetExtensionRef( sPath ).ToString();
 }
 
 bool Path_IsAbsolute( const std::string & sPath )
@@ -226,7 +259,39 @@ std::string Path_MakeAbsolute( const std::string & sRelativePath, const std::str
 }
 
 
+char *CPathBuffer::Resize( size_t unLength )
+{
+	if ( unLength + 1 > m_unCapacity )
+	{
+		size_t unCapacity = std::max( unLength + 1, m_unCapacity * 2 );
+		char *pchData = new char[ unCapacity ];
+		memcpy( pchData, m_pchData, m_unLength + 1 );
+		if ( m_pchData != m_rchInline )
+			delete[] m_pchData;
+		m_pchData = pchData;
+		m_unCapacity = unCapacity;
+	}
+
+	m_unLength = unLength;
+	m_pchData[ unLength ] = '\0';
+	return m_pchData;
+}
+
+
 /** Fixes the directory separators for the current platform */
+void Path_FixSlashesInto( CPathBuffer *pOut, PathRef_t path, char slash )
+{
+	if( slash == 0 )
+		slash = Path_GetSlash();
+
+	char *pchOut = pOut->Resize( path.unLength );
+	for( size_t i = 0; i < path.unLength; i++ )
+	{
+		char c = path.pch[ i ];
+		pchOut[ i ] = ( c == '/' || c == '\\' ) ? slash : c;
+	}
+}
+
 std::string Path_FixSlashes( const std::string & sPath, char slash )
 {
 	if( slash == 0 )
@@ -252,37 +317,67 @@ char Path_GetSlash()
 #endif
 }
 
-/** Jams two paths together with the right kind of slash */
-std::string Path_Join( const std::string & first, const std::string & second, char slash )
+/** Jams paths together with the right kind of slash */
+size_t Path_JoinParts( char *pchOut, size_t unOutSize, char slash, const PathRef_t *rParts, size_t unPartCount )
 {
 	if( slash == 0 )
 		slash = Path_GetSlash();
 
-	// only insert a slash if we don't already have one
-	std::string::size_type nLen = first.length();
-	if( !nLen )
-		return second;
-#if defined(_WIN32)
-	if( first.back() == '\\' || first.back() == '/' )
-	    nLen--;
-#else
-	char last_char = first[first.length()-1];
-	if (last_char == '\\' || last_char == '/')
-	    nLen--;
-#endif
+	// Each step only inserts a slash if we don't already have one, and an empty
+	// result so far is simply replaced by the next part.
+	size_t unLength = 0;
+	char cLast = '\0';
+	for( size_t nPart = 0; nPart < unPartCount; nPart++ )
+	{
+		const PathRef_t & part = rParts[ nPart ];
+		if( unLength != 0 )
+		{
+			if( cLast == '\\' || cLast == '/' )
+				unLength--;
+
+			if( unLength < unOutSize )
+				pchOut[ unLength ] = slash;
+			unLength++;
+			cLast = slash;
+		}
+
+		for( size_t i = 0; i < part.unLength; i++ )
+		{
+			if( unLength + i < unOutSize )
+				pchOut[ unLength + i ] = part.pch[ i ];
+		}
+		unLength += part.unLength;
+		if( part.unLength )
+			cLast = part.pch[ part.unLength - 1 ];
+	}
+
+	return unLength;
+}
 
-	return first.substr( 0, nLen ) + std::string( 1, slash ) + second;
+static std::string Path_JoinToString( char slash, const PathRef_t *rParts, size_t unPartCount )
+{
+	std::string sJoined( Path_JoinParts( nullptr, 0, slash, rParts, unPartCount ), '\0' );
+	if( !sJoined.empty() )
+		Path_JoinParts( &sJoined[ 0 ], sJoined.length(), slash, rParts, unPartCount );
+	return sJoined;
 }
 
+std::string Path_Join( const std::string & first, const std::string & second, char slash )
+{
+	const PathRef_t rParts[] = { first, second };
+	return Path_JoinToString( slash, rParts, 2 );
+}
 
 std::string Path_Join( const std::string & first, const std::string & second, const std::string & third, char slash )
 {
-	return Path_Join( Path_Join( first, second, slash ), third, slash );
+	const PathRef_t rParts[] = { first, second, third };
+	return Path_JoinToString( slash, rParts, 3 );
 }
 
 std::string Path_Join( const std::string & first, const std::string & second, const std::string & third, const std::string &fourth, char slash )
 {
-	return Path_Join( Path_Join( Path_Join( first, second, slash ), third, slash ), fourth, slash );
+	const PathRef_t rParts[] = { first, second, third, fourth };
+	return Path_JoinToString( slash, rParts, 4 );
 }
 
 std::string Path_Join( 
@@ -293,7 +388,8 @@ std::string Path_Join(
 	const std::string & fifth, 
 	char slash )
 {
-	return Path_Join( Path_Join( Path_Join( Path_Join( first, second, slash ), third, slash ), fourth, slash ), fifth, slash );
+	const PathRef_t rParts[] = { first, second, third, fourth, fifth };
+	return Path_JoinToString( slash, rParts, 5 );
 }
 
 
@@ -331,22 +427,32 @@ std::string Path_RemoveTrailingSlash( const std::string & sRawPath, char slash )
 }
 
 
+/** Removes unCount characters starting at unPos, clamped to the end of the path */
+static void ErasePathChars( char *pchPath, size_t *punLength, size_t unPos, size_t unCount )
+{
+	if( unCount > *punLength - unPos )
+		unCount = *punLength - unPos;
+	memmove( pchPath + unPos, pchPath + unPos + unCount, *punLength - unPos - unCount );
+	*punLength -= unCount;
+}
+
 /** Removes redundant <dir>/.. elements in the path. Returns an empty path if the 
 * specified path has a broken number of directories for its number of ..s */
-std::string Path_Compact( const std::string & sRawPath, char slash )
+bool Path_CompactInto( CPathBuffer *pOut, PathRef_t rawPath, char slash )
 {
 	if( slash == 0 )
 		slash = Path_GetSlash();
 
-	std::string sPath = Path_FixSlashes( sRawPath, slash );
-	std::string sSlashString( 1, slash );
+	Path_FixSlashesInto( pOut, rawPath, slash );
+	char *pchPath = pOut->Resize( pOut->length() );
+	size_t unLength = pOut->length();
 
 	// strip out all /./
-	for( std::string::size_type i = 0; (i + 3) < sPath.length();  )
+	for( size_t i = 0; (i + 3) < unLength;  )
 	{
-		if( sPath[ i ] == slash && sPath[ i+1 ] == '.' && sPath[ i+2 ] == slash )
+		if( pchPath[ i ] == slash && pchPath[ i+1 ] == '.' && pchPath[ i+2 ] == slash )
 		{
-			sPath.replace( i, 3, sSlashString );
+			ErasePathChars( pchPath, &unLength, i + 1, 2 );
 		}
 		else
 		{
@@ -354,50 +460,49 @@ std::string Path_Compact( const std::string & sRawPath, char slash )
 		}
 	}
 
-
 	// get rid of trailing /. but leave the path separator
-	if( sPath.length() > 2 )
+	if( unLength > 2 )
 	{
-		std::string::size_type len = sPath.length();
-		if( sPath[ len-1 ] == '.'  && sPath[ len-2 ] == slash )
+		if( pchPath[ unLength-1 ] == '.'  && pchPath[ unLength-2 ] == slash )
 		{
-			sPath.pop_back();
-			//Not sure why the following line of code was used for a while.  It causes problems with strlen.
-			//sPath[len-1] = 0;  // for now, at least 
+			unLength--;
 		}
 	}
 
 	// get rid of leading ./ 
-	if( sPath.length() > 2 )
+	if( unLength > 2 )
 	{
-		if( sPath[ 0 ] == '.'  && sPath[ 1 ] == slash )
+		if( pchPath[ 0 ] == '.'  && pchPath[ 1 ] == slash )
 		{
-			sPath.replace( 0, 2, "" );
+			ErasePathChars( pchPath, &unLength, 0, 2 );
 		}
 	}
 
 	// each time we encounter .. back up until we've found the previous directory name
 	// then get rid of both
-	std::string::size_type i = 0;
-	while( i < sPath.length() )
-	{
-		if( i > 0 && sPath.length() - i >= 2 
-			&& sPath[i] == '.'
-			&& sPath[i+1] == '.'
-			&& ( i + 2 == sPath.length() || sPath[ i+2 ] == slash )
-			&& sPath[ i-1 ] == slash )
+	size_t i = 0;
+	while( i < unLength )
+	{
+		if( i > 0 && unLength - i >= 2 
+			&& pchPath[i] == '.'
+			&& pchPath[i+1] == '.'
+			&& ( i + 2 == unLength || pchPath[ i+2 ] == slash )
+			&& pchPath[ i-1 ] == slash )
 		{
 			// check if we've hit the start of the string and have a bogus path
 			if( i == 1 )
-				return "";
+			{
+				pOut->Resize( 0 );
+				return false;
+			}
 			
 			// find the separator before i-1
-			std::string::size_type iDirStart = i-2;
-			while( iDirStart > 0 && sPath[ iDirStart - 1 ] != slash )
+			size_t iDirStart = i-2;
+			while( iDirStart > 0 && pchPath[ iDirStart - 1 ] != slash )
 				--iDirStart;
 
 			// remove everything from iDirStart to i+2
-			sPath.replace( iDirStart, (i - iDirStart) + 3, "" );
+			ErasePathChars( pchPath, &unLength, iDirStart, (i - iDirStart) + 3 );
 
 			// start over
 			i = 0;
@@ -408,7 +513,15 @@ std::string Path_Compact( const std::string & sRawPath, char slash )
 		}
 	}
 
-	return sPath;
+	pOut->Resize( unLength );
+	return true;
+}
+
+std::string Path_Compact( const std::string & sRawPath, char slash )
+{
+	CPathBuffer compacted;
+	Path_CompactInto( &compacted, sRawPath, slash );
+	return compacted.ToString();
 }
 
 
@@ -534,6 +647,49 @@ bool Path_Exists( const std::string & sPath )
 }
 
 
+//-----------------------------------------------------------------------------
+// Purpose: returns the modification stamp of a file so callers can cheaply
+//			tell whether it changed since they last read it
+//-----------------------------------------------------------------------------
+bool Path_GetFileStamp( const std::string & sPath, PathFileStamp_t *pStamp )
+{
+	PathFileStamp_t stamp = {};
+
+	std::string sFixedPath = Path_FixSlashes( sPath );
+	if ( !sFixedPath.empty() )
+	{
+#if defined( WIN32 )
+		struct	_stat64	buf;
+		std::wstring wsFixedPath = UTF8to16( sFixedPath.c_str() );
+		if ( _wstat64( wsFixedPath.c_str(), &buf ) == 0 )
+		{
+			stamp.bExists = true;
+			stamp.ulModificationTime = (uint64_t)buf.st_mtime * 1000000000ull;
+			stamp.ulFileSize = (uint64_t)buf.st_size;
+		}
+#else
+		struct stat buf;
+		if ( stat( sFixedPath.c_str(), &buf ) == 0 )
+		{
+			stamp.bExists = true;
+#if defined( OSX )
+			stamp.ulModificationTime = (uint64_t)buf.st_mtimespec.tv_sec * 1000000000ull + (uint64_t)buf.st_mtimespec.tv_nsec;
+#else
+			stamp.ulModificationTime = (uint64_t)buf.st_mtim.tv_sec * 1000000000ull + (uint64_t)buf.st_mtim.tv_nsec;
+#endif
+			stamp.ulFileSize = (uint64_t)buf.st_size;
+			stamp.ulFileId = (uint64_t)buf.st_ino;
+		}
+#endif
+	}
+
+	if ( pStamp )
+		*pStamp = stamp;
+
+	return stamp.bExists;
+}
+
+
 //-----------------------------------------------------------------------------
 // Purpose: helper to find a directory upstream from a given path
 //-----------------------------------------------------------------------------
@@ -846,6 +1002,509 @@ bool Path_WriteStringToTextFileAtomic( const std::string &strFilename, const cha
 }
 
 
+CPathMappedFile::CPathMappedFile()
+	: m_bValid( false )
+	, m_pData( nullptr )
+	, m_unSize( 0 )
+	, m_pMapping( nullptr )
+{
+}
+
+CPathMappedFile::CPathMappedFile( const std::string &strFilename )
+	: m_bValid( false )
+	, m_pData( nullptr )
+	, m_unSize( 0 )
+	, m_pMapping( nullptr )
+{
+	BOpen( strFilename );
+}
+
+CPathMappedFile::~CPathMappedFile()
+{
+	Close();
+}
+
+bool CPathMappedFile::BOpen( const std::string &strFilename )
+{
+	Close();
+
+#if defined( _WIN32 )
+	std::wstring wstrFilename = UTF8to16( strFilename.c_str() );
+	HANDLE hFile = CreateFileW( wstrFilename.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+		NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+	if ( hFile != INVALID_HANDLE_VALUE )
+	{
+		LARGE_INTEGER size;
+		if ( !GetFileSizeEx( hFile, &size ) )
+		{
+			size.QuadPart = -1;
+		}
+
+		if ( size.QuadPart == 0 )
+		{
+			m_bValid = true;
+		}
+		else if ( size.QuadPart > 0 && (uint64_t)size.QuadPart <= (uint64_t)SIZE_MAX )
+		{
+			HANDLE hMapping = CreateFileMappingW( hFile, NULL, PAGE_READONLY, 0, 0, NULL );
+			if ( hMapping )
+			{
+				// the view keeps the mapping object alive
+				m_pMapping = MapViewOfFile( hMapping, FILE_MAP_READ, 0, 0, 0 );
+				CloseHandle( hMapping );
+			}
+			if ( m_pMapping )
+			{
+				m_pData = static_cast< const uint8_t * >( m_pMapping );
+				m_unSize = (size_t)size.QuadPart;
+				m_bValid = true;
+			}
+		}
+		CloseHandle( hFile );
+	}
+#elif defined( POSIX )
+	int fd = open( strFilename.c_str(), O_RDONLY | O_CLOEXEC );
+	if ( fd != -1 )
+	{
+		struct stat buf;
+		if ( fstat( fd, &buf ) == 0 )
+		{
+			if ( S_ISREG( buf.st_mode ) && buf.st_size > 0 && (uint64_t)buf.st_size <= (uint64_t)SIZE_MAX )
+			{
+				void *pMapping = mmap( nullptr, (size_t)buf.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+				if ( pMapping != MAP_FAILED )
+				{
+					m_pMapping = pMapping;
+					m_pData = static_cast< const uint8_t * >( pMapping );
+					m_unSize = (size_t)buf.st_size;
+					m_bValid = true;
+				}
+			}
+
+			// Pipes, special files and files (like those in /proc) that report a size of 0 can't be
+			// mapped, and Path_ReadBinaryFile can't size them either, so read them to the end here.
+			// A truly empty file ends up here too and opens with a size of 0.
+			if ( !m_bValid && !S_ISDIR( buf.st_mode ) )
+			{
+				uint8_t rgubChunk[ 16 * 1024 ];
+				ssize_t nRead;
+				while ( ( nRead = read( fd, rgubChunk, sizeof( rgubChunk ) ) ) > 0 || ( nRead == -1 && errno == EINTR ) )
+				{
+					if ( nRead > 0 )
+						m_vecBuffer.insert( m_vecBuffer.end(), rgubChunk, rgubChunk + nRead );
+				}
+				if ( nRead == 0 )
+				{
+					m_pData = m_vecBuffer.data();
+					m_unSize = m_vecBuffer.size();
+					m_bValid = true;
+				}
+				else
+				{
+					std::vector<uint8_t>().swap( m_vecBuffer );
+				}
+			}
+		}
+		close( fd );
+	}
+#endif
+
+	if ( !m_bValid )
+	{
+		// files Windows won't map, and platforms without mapping, get read the old fashioned way
+		m_vecBuffer = Path_ReadBinaryFile( strFilename );
+		if ( !m_vecBuffer.empty() )
+		{
+			m_pData = &m_vecBuffer[ 0 ];
+			m_unSize = m_vecBuffer.size();
+			m_bValid = true;
+		}
+	}
+
+	return m_bValid;
+}
+
+void CPathMappedFile::Close()
+{
+	if ( m_pMapping )
+	{
+#if defined( _WIN32 )
+		UnmapViewOfFile( m_pMapping );
+#elif defined( POSIX )
+		munmap( m_pMapping, m_unSize );
+#endif
+		m_pMapping = nullptr;
+	}
+
+	std::vector<uint8_t>().swap( m_vecBuffer );
+	m_pData = nullptr;
+	m_unSize = 0;
+	m_bValid = false;
+}
+
+
+bool Path_PrefetchFile( const std::string &strFilename )
+{
+#if defined( LINUX )
+	int fd = open( strFilename.c_str(), O_RDONLY | O_CLOEXEC );
+	if ( fd == -1 )
+		return false;
+
+	// offset and length of 0 cover the whole file
+	bool bSuccess = posix_fadvise( fd, 0, 0, POSIX_FADV_WILLNEED ) == 0;
+	close( fd );
+	return bSuccess;
+#elif defined( OSX )
+	int fd = open( strFilename.c_str(), O_RDONLY | O_CLOEXEC );
+	if ( fd == -1 )
+		return false;
+
+	bool bSuccess = false;
+	struct stat buf;
+	if ( fstat( fd, &buf ) == 0 )
+	{
+		struct radvisory advisory;
+		advisory.ra_offset = 0;
+		advisory.ra_count = buf.st_size > INT_MAX ? INT_MAX : (int)buf.st_size;
+		bSuccess = fcntl( fd, F_RDADVISE, &advisory ) != -1;
+	}
+	close( fd );
+	return bSuccess;
+#else
+	// nothing to hint with, the loader will read it on demand
+	(void)strFilename;
+	return false;
+#endif
+}
+
+// -----------------------------------------------------------------------------------------------------
+// Purpose: Returns a description of the last file system error on this thread
+// -----------------------------------------------------------------------------------------------------
+static std::string GetLastFileErrorString()
+{
+#if defined( _WIN32 )
+	return "error " + std::to_string( GetLastError() );
+#else
+	return strerror( errno );
+#endif
+}
+
+
+// -----------------------------------------------------------------------------------------------------
+// Purpose: Returns the directory a file lives in, even for bare filenames
+// -----------------------------------------------------------------------------------------------------
+static std::string GetContainingDirectory( const std::string &strFilename )
+{
+	std::string sDirectory = Path_StripFilename( strFilename );
+	if ( sDirectory == strFilename )
+		return ".";
+	if ( sDirectory.empty() )
+		return std::string( 1, Path_GetSlash() );
+	return sDirectory;
+}
+
+
+// -----------------------------------------------------------------------------------------------------
+// Purpose: Follows symlinks to the file that writing strFilename would actually change. The
+//			final target doesn't have to exist, so a dangling link still gets its target created.
+// -----------------------------------------------------------------------------------------------------
+static std::string ResolveFileSymlinks( const std::string &strFilename )
+{
+#if defined( _WIN32 )
+	std::wstring wsFilename = UTF8to16( strFilename.c_str() );
+	DWORD dwAttributes = GetFileAttributesW( wsFilename.c_str() );
+	if ( dwAttributes == INVALID_FILE_ATTRIBUTES || !( dwAttributes & FILE_ATTRIBUTE_REPARSE_POINT ) )
+		return strFilename;
+
+	HANDLE hFile = CreateFileW( wsFilename.c_str(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, NULL );
+	if ( hFile == INVALID_HANDLE_VALUE )
+		return strFilename;
+
+	wchar_t rwchFinalPath[ 32768 ];
+	DWORD dwLength = GetFinalPathNameByHandleW( hFile, rwchFinalPath, _countof( rwchFinalPath ), FILE_NAME_NORMALIZED | VOLUME_NAME_DOS );
+	CloseHandle( hFile );
+	if ( dwLength == 0 || dwLength >= _countof( rwchFinalPath ) )
+		return strFilename;
+
+	std::string sFinalPath = UTF16to8( rwchFinalPath );
+	if ( sFinalPath.compare( 0, 8, "\\\\?\\UNC\\" ) == 0 )
+		return "\\\\" + sFinalPath.substr( 8 );
+	if ( sFinalPath.compare( 0, 4, "\\\\?\\" ) == 0 )
+		return sFinalPath.substr( 4 );
+	return sFinalPath;
+#else
+	// same limit as the kernel's ELOOP
+	std::string sPath = strFilename;
+	for ( int nHops = 0; nHops < 40; nHops++ )
+	{
+		struct stat st;
+		if ( lstat( sPath.c_str(), &st ) != 0 || !S_ISLNK( st.st_mode ) )
+			return sPath;
+
+		char rchTarget[ PATH_MAX ];
+		ssize_t nLength = readlink( sPath.c_str(), rchTarget, sizeof( rchTarget ) - 1 );
+		if ( nLength <= 0 )
+			return sPath;
+		rchTarget[ nLength ] = '\0';
+
+		if ( rchTarget[ 0 ] == '/' )
+			sPath = rchTarget;
+		else
+			sPath = Path_Join( GetContainingDirectory( sPath ), rchTarget );
+	}
+	return sPath;
+#endif
+}
+
+
+CPathAtomicWriteBatch::CPathAtomicWriteBatch( bool bDurable )
+	: m_bDurable( bDurable )
+{
+}
+
+CPathAtomicWriteBatch::~CPathAtomicWriteBatch()
+{
+	RemoveStagedFiles();
+}
+
+void CPathAtomicWriteBatch::AddFile( const std::string &strFilename, const std::string &strData )
+{
+	for ( PendingFile_t & file : m_vecFiles )
+	{
+		if ( file.strFilename == strFilename )
+		{
+			file.strData = strData;
+			return;
+		}
+	}
+
+	PendingFile_t file;
+	file.strFilename = strFilename;
+	file.strData = strData;
+	file.bStaged = false;
+	file.bSucceeded = false;
+	m_vecFiles.push_back( file );
+}
+
+void CPathAtomicWriteBatch::AddTextFile( const std::string &strFilename, const std::string &strData )
+{
+#if defined( _WIN32 )
+	// what a "w" mode stdio write would have produced
+	std::string strTextData;
+	strTextData.reserve( strData.size() + strData.size() / 32 );
+	for ( char ch : strData )
+	{
+		if ( ch == '\n' )
+			strTextData.push_back( '\r' );
+		strTextData.push_back( ch );
+	}
+	AddFile( strFilename, strTextData );
+#else
+	AddFile( strFilename, strData );
+#endif
+}
+
+// -----------------------------------------------------------------------------------------------------
+// Purpose: Writes (and in durable mode flushes) the temporary file for one entry. The temp file
+//			goes next to the symlink-resolved target so the rename stays on one file system.
+// -----------------------------------------------------------------------------------------------------
+bool CPathAtomicWriteBatch::BStageFile( PendingFile_t *pFile )
+{
+	bool bWritten = false;
+
+	pFile->strTargetFilename = ResolveFileSymlinks( pFile->strFilename );
+	pFile->strTmpFilename = pFile->strTargetFilename + ".tmp";
+
+#if defined( _WIN32 )
+	std::wstring wsTmpFilename = UTF8to16( pFile->strTmpFilename.c_str() );
+	HANDLE hFile = CreateFileW( wsTmpFilename.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL );
+	if ( hFile == INVALID_HANDLE_VALUE )
+	{
+		pFile->strError = "Unable to create " + pFile->strTmpFilename + ": " + GetLastFileErrorString();
+		return false;
+	}
+
+	DWORD dwWritten = 0;
+	bWritten = pFile->strData.empty()
+		|| ( WriteFile( hFile, pFile->strData.data(), (DWORD)pFile->strData.size(), &dwWritten, NULL ) && dwWritten == pFile->strData.size() );
+	if ( !bWritten )
+	{
+		pFile->strError = "Unable to write " + pFile->strTmpFilename + ": " + GetLastFileErrorString();
+	}
+	else if ( m_bDurable && !FlushFileBuffers( hFile ) )
+	{
+		pFile->strError = "Unable to flush " + pFile->strTmpFilename + ": " + GetLastFileErrorString();
+		bWritten = false;
+	}
+	CloseHandle( hFile );
+#else
+	int fd = open( pFile->strTmpFilename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666 );
+	if ( fd == -1 )
+	{
+		pFile->strError = "Unable to create " + pFile->strTmpFilename + ": " + GetLastFileErrorString();
+		return false;
+	}
+
+	// the rename replaces the inode, so carry over what writing in place would have kept
+	struct stat stTarget;
+	if ( stat( pFile->strTargetFilename.c_str(), &stTarget ) == 0 )
+	{
+		if ( fchown( fd, stTarget.st_uid, stTarget.st_gid ) != 0 )
+		{
+			// only root can give a file away; keeping our own ownership is fine
+		}
+		fchmod( fd, stTarget.st_mode & 07777 );
+	}
+
+	const char *pchData = pFile->strData.data();
+	size_t unRemaining = pFile->strData.size();
+	bWritten = true;
+	while ( unRemaining > 0 )
+	{
+		ssize_t nWritten = write( fd, pchData, unRemaining );
+		if ( nWritten < 0 && errno == EINTR )
+			continue;
+		if ( nWritten <= 0 )
+		{
+			pFile->strError = "Unable to write " + pFile->strTmpFilename + ": " + GetLastFileErrorString();
+			bWritten = false;
+			break;
+		}
+		pchData += nWritten;
+		unRemaining -= (size_t)nWritten;
+	}
+
+	if ( bWritten && m_bDurable && fsync( fd ) != 0 )
+	{
+		pFile->strError = "Unable to flush " + pFile->strTmpFilename + ": " + GetLastFileErrorString();
+		bWritten = false;
+	}
+
+	if ( close( fd ) != 0 && bWritten )
+	{
+		pFile->strError = "Unable to close " + pFile->strTmpFilename + ": " + GetLastFileErrorString();
+		bWritten = false;
+	}
+#endif
+
+	// even a partial temp file needs to be cleaned up
+	pFile->bStaged = true;
+	return bWritten;
+}
+
+void CPathAtomicWriteBatch::RemoveStagedFiles()
+{
+	for ( PendingFile_t & file : m_vecFiles )
+	{
+		if ( file.bStaged )
+		{
+			Path_UnlinkFile( file.strTmpFilename );
+			file.bStaged = false;
+		}
+	}
+}
+
+bool CPathAtomicWriteBatch::Commit()
+{
+	for ( PendingFile_t & file : m_vecFiles )
+	{
+		file.bSucceeded = false;
+		file.strError.clear();
+	}
+
+	// stage everything before touching any of the real files
+	const PendingFile_t *pFailedFile = nullptr;
+	for ( PendingFile_t & file : m_vecFiles )
+	{
+		if ( !BStageFile( &file ) )
+		{
+			pFailedFile = &file;
+			break;
+		}
+	}
+
+	if ( pFailedFile )
+	{
+		for ( PendingFile_t & file : m_vecFiles )
+		{
+			if ( &file != pFailedFile )
+			{
+				file.strError = "Not written because " + pFailedFile->strFilename + " failed";
+			}
+		}
+		RemoveStagedFiles();
+		return false;
+	}
+
+	bool bAllSucceeded = true;
+	std::set< std::string > setDirectories;
+	for ( PendingFile_t & file : m_vecFiles )
+	{
+#if defined( _WIN32 )
+		std::wstring wsFilename = UTF8to16( file.strTargetFilename.c_str() );
+		std::wstring wsTmpFilename = UTF8to16( file.strTmpFilename.c_str() );
+		if ( GetFileAttributesW( wsFilename.c_str() ) != INVALID_FILE_ATTRIBUTES )
+		{
+			// ReplaceFile keeps the existing file's attributes and ACLs, which a move would not
+			file.bSucceeded = 0 != ::ReplaceFileW( wsFilename.c_str(), wsTmpFilename.c_str(), nullptr, REPLACEFILE_IGNORE_MERGE_ERRORS, nullptr, nullptr );
+		}
+		else
+		{
+			DWORD dwFlags = MOVEFILE_REPLACE_EXISTING | ( m_bDurable ? MOVEFILE_WRITE_THROUGH : 0 );
+			file.bSucceeded = 0 != ::MoveFileExW( wsTmpFilename.c_str(), wsFilename.c_str(), dwFlags );
+		}
+#else
+		file.bSucceeded = rename( file.strTmpFilename.c_str(), file.strTargetFilename.c_str() ) == 0;
+#endif
+		if ( file.bSucceeded )
+		{
+			file.bStaged = false;
+			setDirectories.insert( GetContainingDirectory( file.strTargetFilename ) );
+		}
+		else
+		{
+			file.strError = "Unable to replace " + file.strFilename + ": " + GetLastFileErrorString();
+			bAllSucceeded = false;
+		}
+	}
+
+	// any rename that failed leaves its temp file behind otherwise
+	RemoveStagedFiles();
+
+#if defined( POSIX )
+	if ( m_bDurable )
+	{
+		// one sync per directory makes all of the renames in it durable
+		for ( const std::string & sDirectory : setDirectories )
+		{
+			int fd = open( sDirectory.c_str(), O_RDONLY | O_CLOEXEC );
+			bool bSynced = fd != -1 && fsync( fd ) == 0;
+			std::string sError = bSynced ? std::string() : "Unable to sync directory " + sDirectory + ": " + GetLastFileErrorString();
+			if ( fd != -1 )
+			{
+				close( fd );
+			}
+
+			if ( !bSynced )
+			{
+				for ( PendingFile_t & file : m_vecFiles )
+				{
+					if ( file.bSucceeded && GetContainingDirectory( file.strTargetFilename ) == sDirectory )
+					{
+						file.bSucceeded = false;
+						file.strError = sError;
+					}
+				}
+				bAllSucceeded = false;
+			}
+		}
+	}
+#endif
+
+	return bAllSucceeded;
+}
+
+
 #if defined(WIN32)
 #define FILE_URL_PREFIX "file:///"
 #else
@@ -872,11 +1531,9 @@ std::string Path_FilePathToUrl( const std::string & sRelativePath, const std::st
 			return sAbsolute;
 		sAbsolute = Path_FixSlashes( sAbsolute, '/' );
 
-		size_t unBufferSize = sAbsolute.length() * 3;
-		char *pchBuffer = (char *)alloca( unBufferSize );
-		V_URLEncodeFullPath( pchBuffer, (int)unBufferSize, sAbsolute.c_str(), (int)sAbsolute.length() );
-
-		return std::string( FILE_URL_PREFIX ) + pchBuffer;
+		std::string sUrl( FILE_URL_PREFIX );
+		V_URLEncodeAppend( sUrl, sAbsolute.data(), sAbsolute.length(), k_EURLEncodeMode_FullPath );
+		return sUrl;
 	}
 }
 
@@ -887,11 +1544,12 @@ std::string Path_UrlToFilePath( const std::string & sFileUrl )
 {
 	if ( !strnicmp( sFileUrl.c_str(), FILE_URL_PREFIX, strlen( FILE_URL_PREFIX ) ) )
 	{
-		char *pchBuffer = (char *)alloca( sFileUrl.length() );
-		V_URLDecodeNoPlusForSpace( pchBuffer, (int)sFileUrl.length(), 
-			sFileUrl.c_str() + strlen( FILE_URL_PREFIX ), (int)( sFileUrl.length() - strlen( FILE_URL_PREFIX ) ) );
-
-		return Path_FixSlashes( pchBuffer );
+		// a path ends at the first %00, as it did when this was decoded into a C string
+		std::string sPath = V_URLDecodeNoPlusForSpace( sFileUrl.substr( strlen( FILE_URL_PREFIX ) ) );
+		size_t nNul = sPath.find( '\0' );
+		if ( nNul != std::string::npos )
+			sPath.resize( nNul );
+		return Path_FixSlashes( sPath );
 	}
 	else
 	{
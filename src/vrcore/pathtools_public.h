@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include <stdint.h>
+#include <string.h>
 
 /** Returns the path (including filename) to the current executable */
 std::string Path_GetExecutablePath();
@@ -75,6 +76,74 @@ bool Path_IsSamePath( const std::string & sPath1, const std::string & sPath2 );
 //** Removed trailing slashes */
 std::string Path_RemoveTrailingSlash( const std::string & sRawPath, char slash = 0 );
 
+/** A non-owning reference to a range of path characters. It is not necessarily null terminated. */
+struct PathRef_t
+{
+	PathRef_t() : pch( "" ), unLength( 0 ) {}
+	PathRef_t( const char *pchPath ) : pch( pchPath ? pchPath : "" ), unLength( pchPath ? strlen( pchPath ) : 0 ) {}
+	PathRef_t( const char *pchPath, size_t unPathLength ) : pch( pchPath ), unLength( unPathLength ) {}
+	PathRef_t( const std::string & sPath ) : pch( sPath.data() ), unLength( sPath.length() ) {}
+	PathRef_t( std::string && ) = delete;	// would point into a temporary that is gone by the next statement
+
+	bool empty() const { return unLength == 0; }
+	std::string ToString() const { return std::string( pch, unLength ); }
+
+	const char *pch;
+	size_t unLength;
+};
+
+/** Null terminated output storage for the allocation-free path functions below. Paths up to
+* MAX_PATH long stay in the inline buffer; longer ones spill to the heap. */
+class CPathBuffer
+{
+public:
+	CPathBuffer() : m_pchData( m_rchInline ), m_unLength( 0 ), m_unCapacity( sizeof( m_rchInline ) ) { m_rchInline[ 0 ] = '\0'; }
+	~CPathBuffer() { if ( m_pchData != m_rchInline ) delete[] m_pchData; }
+
+	const char *c_str() const { return m_pchData; }
+	size_t length() const { return m_unLength; }
+	bool empty() const { return m_unLength == 0; }
+	std::string ToString() const { return std::string( m_pchData, m_unLength ); }
+	operator PathRef_t() const { return PathRef_t( m_pchData, m_unLength ); }
+
+	/** Sets the length (contents up to the old length are kept) and returns the writable characters */
+	char *Resize( size_t unLength );
+
+private:
+	CPathBuffer( const CPathBuffer & );
+	CPathBuffer & operator=( const CPathBuffer & );
+
+	char m_rchInline[ 260 ];
+	char *m_pchData;
+	size_t m_unLength;
+	size_t m_unCapacity;
+};
+
+/** Allocation-free versions of the functions above. The Ref versions return a sub-range of their
+* input; the Into versions write to pOut, which must not overlap any of the inputs. Results are
+* identical to the std::string versions. */
+PathRef_t Path_StripFilenameRef( PathRef_t path, char slash = 0 );
+PathRef_t Path_StripDirectoryRef( PathRef_t path, char slash = 0 );
+PathRef_t Path_StripExtensionRef( PathRef_t path );
+PathRef_t Path_GetExtensionRef( PathRef_t path );
+void Path_FixSlashesInto( CPathBuffer *pOut, PathRef_t path, char slash = 0 );
+/** Returns false (and an empty path) under the same conditions that Path_Compact returns an empty path */
+bool Path_CompactInto( CPathBuffer *pOut, PathRef_t path, char slash = 0 );
+
+/** Joins rParts like chained calls to Path_Join would. Writes at most unOutSize characters (and no
+* null terminator) to pchOut, which may be NULL if unOutSize is 0. Returns the full joined length. */
+size_t Path_JoinParts( char *pchOut, size_t unOutSize, char slash, const PathRef_t *rParts, size_t unPartCount );
+
+/** Jams any number of paths together, sizing the result once */
+template< typename... Rest >
+void Path_JoinInto( CPathBuffer *pOut, char slash, PathRef_t first, const Rest &... rest )
+{
+	const PathRef_t rParts[] = { first, PathRef_t( rest )... };
+	size_t unPartCount = sizeof( rParts ) / sizeof( rParts[ 0 ] );
+	size_t unLength = Path_JoinParts( nullptr, 0, slash, rParts, unPartCount );
+	Path_JoinParts( pOut->Resize( unLength ), unLength, slash, rParts, unPartCount );
+}
+
 /** returns true if the specified path exists and is a directory */
 bool Path_IsDirectory( const std::string & sPath );
 
@@ -84,6 +153,27 @@ bool Path_IsAppBundle( const std::string & sPath );
 /** returns true if the the path exists */
 bool Path_Exists( const std::string & sPath );
 
+/** Identifies one version of a file on disk. Two stamps of the same path compare equal
+* only if the file was not modified or replaced in between. */
+struct PathFileStamp_t
+{
+	bool bExists;
+	uint64_t ulModificationTime;	// nanoseconds since the epoch (seconds resolution on some platforms)
+	uint64_t ulFileSize;
+	uint64_t ulFileId;				// inode on POSIX, zero where the platform doesn't provide one
+
+	bool operator==( const PathFileStamp_t & other ) const
+	{
+		return bExists == other.bExists && ulModificationTime == other.ulModificationTime
+			&& ulFileSize == other.ulFileSize && ulFileId == other.ulFileId;
+	}
+	bool operator!=( const PathFileStamp_t & other ) const { return !( *this == other ); }
+};
+
+/** Fills in the stamp for the specified file. Returns false (and a stamp with bExists == false)
+* if the file could not be found. */
+bool Path_GetFileStamp( const std::string & sPath, PathFileStamp_t *pStamp );
+
 /** Helper functions to find parent directories or subdirectories of parent directories */
 std::string Path_FindParentDirectoryRecursively( const std::string &strStartDirectory, const std::string &strDirectoryName );
 std::string Path_FindParentSubDirectoryRecursively( const std::string &strStartDirectory, const std::string &strDirectoryName );
@@ -100,6 +190,100 @@ std::string Path_ReadTextFile( const std::string &strFilename );
 bool Path_WriteStringToTextFile( const std::string &strFilename, const char *pchData );
 bool Path_WriteStringToTextFileAtomic( const std::string &strFilename, const char *pchData );
 
+/** Replaces a set of files so that each one ends up either fully written or untouched. Everything is
+* staged to temporary files first and nothing is renamed into place unless every file was staged.
+* In durable mode file data is flushed before the renames and each directory involved is synced
+* once afterwards; non-durable mode skips the flushes for callers (like tests) that don't need them.
+* A filename that is a symlink has its target replaced, and a file that already exists keeps its
+* permissions (and on POSIX, its owner where we're allowed to keep it). */
+class CPathAtomicWriteBatch
+{
+public:
+	explicit CPathAtomicWriteBatch( bool bDurable = true );
+	~CPathAtomicWriteBatch();
+
+	/** Queues a file to be written byte for byte. Nothing touches the disk until Commit is called.
+	* Adding the same filename twice replaces the earlier data. */
+	void AddFile( const std::string &strFilename, const std::string &strData );
+
+	/** Queues a file the way Path_WriteStringToTextFile would write it, with LF turned into CRLF on Windows */
+	void AddTextFile( const std::string &strFilename, const std::string &strData );
+
+	/** Writes all queued files. Returns true if every one of them was replaced. */
+	bool Commit();
+
+	/** Per-file results of the last Commit, in the order the files were added */
+	uint32_t GetFileCount() const { return (uint32_t)m_vecFiles.size(); }
+	const std::string & GetFilename( uint32_t unIndex ) const { return m_vecFiles[ unIndex ].strFilename; }
+	bool BFileSucceeded( uint32_t unIndex ) const { return m_vecFiles[ unIndex ].bSucceeded; }
+	const std::string & GetFileError( uint32_t unIndex ) const { return m_vecFiles[ unIndex ].strError; }
+
+private:
+	CPathAtomicWriteBatch( const CPathAtomicWriteBatch & );
+	CPathAtomicWriteBatch & operator=( const CPathAtomicWriteBatch & );
+
+	struct PendingFile_t
+	{
+		std::string strFilename;
+		std::string strTargetFilename;	// strFilename with any symlinks resolved, set when staged
+		std::string strTmpFilename;
+		std::string strData;
+		bool bStaged;
+		bool bSucceeded;
+		std::string strError;
+	};
+
+	bool BStageFile( PendingFile_t *pFile );
+	void RemoveStagedFiles();
+
+	bool m_bDurable;
+	std::vector< PendingFile_t > m_vecFiles;
+};
+
+/** Read-only view of a whole file. The file is memory mapped where the platform allows it and read
+* into memory otherwise, so callers see the same contiguous bytes either way without an extra copy.
+* Meant for large read-only assets: a file another process may truncate or rewrite in place should be
+* read with Path_ReadBinaryFile/Path_ReadTextFile instead, since truncating a mapped file faults the
+* reader on POSIX and an open view stops other processes writing it on Windows. */
+class CPathMappedFile
+{
+public:
+	CPathMappedFile();
+	explicit CPathMappedFile( const std::string &strFilename );
+	~CPathMappedFile();
+
+	/** Opens the file, closing any previously open one. Returns false if the file could not be read. */
+	bool BOpen( const std::string &strFilename );
+	void Close();
+
+	/** Returns true if a file (possibly an empty one) is open */
+	bool IsValid() const { return m_bValid; }
+
+	/** Returns true if the contents are mapped rather than read into a buffer */
+	bool IsMapped() const { return m_pMapping != nullptr; }
+
+	const uint8_t *Data() const { return m_pData; }
+	const char *Chars() const { return reinterpret_cast< const char * >( m_pData ); }
+	size_t Size() const { return m_unSize; }
+
+	const uint8_t *begin() const { return m_pData; }
+	const uint8_t *end() const { return m_pData + m_unSize; }
+
+private:
+	CPathMappedFile( const CPathMappedFile & );
+	CPathMappedFile & operator=( const CPathMappedFile & );
+
+	bool m_bValid;
+	const uint8_t *m_pData;
+	size_t m_unSize;
+	void *m_pMapping;
+	std::vector<uint8_t> m_vecBuffer;
+};
+
+/** Asks the OS to start reading the file into the page cache so a later load of it doesn't stall
+* on disk. Returns false if the hint could not be given. */
+bool Path_PrefetchFile( const std::string &strFilename );
+
 /** Returns a file:// url for paths, or an http or https url if that's what was provided */
 std::string Path_FilePathToUrl( const std::string & sRelativePath, const std::string & sBasePath );
 
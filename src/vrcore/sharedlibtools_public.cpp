@@ -1,6 +1,12 @@
 //========= Copyright Valve Corporation ============//
 #include <vrcore/sharedlibtools_public.h>
 #include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
 
 #if defined(_WIN32)
 #include <windows.h>
@@ -8,43 +14,227 @@
 
 #if defined(POSIX)
 #include <dlfcn.h>
+#include <sys/resource.h>
 #endif
 
-SharedLibHandle SharedLib_Load( const char *pchPath, std::string *pErrStr )
+//-----------------------------------------------------------------------------
+// Purpose: A loaded module. SharedLibHandle points at one of these.
+//-----------------------------------------------------------------------------
+struct SharedLibModule_t
+{
+	std::string sKey;
+	void *pOSHandle;
+	std::unordered_map< std::string, void * > mapSymbols;
+	SharedLibStats_t stats;
+};
+
+//-----------------------------------------------------------------------------
+// Purpose: Every loaded module by key. Recursive because a module's static
+//			constructors may load other modules from inside the OS loader.
+//-----------------------------------------------------------------------------
+struct SharedLibRegistry_t
+{
+	std::recursive_mutex mutex;
+	std::unordered_map< std::string, SharedLibModule_t * > mapModules;
+};
+
+static SharedLibRegistry_t &SharedLibRegistry()
+{
+	// never destroyed so modules unloaded from static destructors still find it
+	static SharedLibRegistry_t *s_pRegistry = new SharedLibRegistry_t;
+	return *s_pRegistry;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns the registry key for a path. Names without a directory are
+//			left alone, since the loader searches for those rather than opening
+//			them relative to the working directory.
+//-----------------------------------------------------------------------------
+static std::string GetSharedLibKey( const char *pchPath )
+{
+#if defined( _WIN32 )
+	if ( !strchr( pchPath, '\\' ) && !strchr( pchPath, '/' ) )
+		return pchPath;
+	char rchFullPath[ MAX_PATH ];
+	DWORD unLen = GetFullPathNameA( pchPath, sizeof( rchFullPath ), rchFullPath, nullptr );
+	if ( unLen == 0 || unLen >= sizeof( rchFullPath ) )
+		return pchPath;
+	std::string sKey( rchFullPath, unLen );
+	std::replace( sKey.begin(), sKey.end(), '/', '\\' );
+	std::transform( sKey.begin(), sKey.end(), sKey.begin(), []( char c ) { return ( char )tolower( ( unsigned char )c ); } );
+	return sKey;
+#else
+	if ( !strchr( pchPath, '/' ) )
+		return pchPath;
+	char *pchRealPath = realpath( pchPath, nullptr );
+	if ( !pchRealPath )
+		return pchPath;
+	std::string sKey( pchRealPath );
+	free( pchRealPath );
+	return sKey;
+#endif
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Page faults taken so far, by this thread where the platform can tell
+//-----------------------------------------------------------------------------
+static void GetPageFaults( uint64_t *pulMinor, uint64_t *pulMajor )
+{
+	*pulMinor = 0;
+	*pulMajor = 0;
+#if defined( POSIX )
+	struct rusage usage;
+#if defined( RUSAGE_THREAD )
+	int nWho = RUSAGE_THREAD;
+#else
+	int nWho = RUSAGE_SELF;
+#endif
+	if ( getrusage( nWho, &usage ) == 0 )
+	{
+		*pulMinor = ( uint64_t )usage.ru_minflt;
+		*pulMajor = ( uint64_t )usage.ru_majflt;
+	}
+#endif
+}
+
+
+static void *OSLoad( const char *pchPath, bool bLazyBinding )
 {
-	SharedLibHandle pHandle = nullptr;
 #if defined( _WIN32)
-	pHandle = ( SharedLibHandle )LoadLibraryEx( pchPath, NULL, LOAD_WITH_ALTERED_SEARCH_PATH );
-#elif defined(LINUXARM64)	
-	pHandle = (SharedLibHandle) dlopen( pchPath, RTLD_LOCAL|RTLD_DEEPBIND|RTLD_NOW );
+	( void )bLazyBinding;
+	return ( void * )LoadLibraryEx( pchPath, NULL, LOAD_WITH_ALTERED_SEARCH_PATH );
+#elif defined(LINUXARM64)
+	return dlopen( pchPath, RTLD_LOCAL|RTLD_DEEPBIND|( bLazyBinding ? RTLD_LAZY : RTLD_NOW ) );
 #elif defined(POSIX)
-	pHandle = (SharedLibHandle) dlopen( pchPath, RTLD_LOCAL|RTLD_NOW );
+	return dlopen( pchPath, RTLD_LOCAL|( bLazyBinding ? RTLD_LAZY : RTLD_NOW ) );
 #endif
+}
 
-	if ( pHandle == nullptr && pErrStr )
-	{
+
+static void OSUnload( void *pOSHandle )
+{
 #if defined( _WIN32)
-		// TODO: Consider using FormatMessage to get an error string for this error code
-		*pErrStr =  std::to_string( GetLastError() );
+	FreeLibrary( (HMODULE)pOSHandle );
 #elif defined(POSIX)
-		char * pErr = dlerror();
-		if ( pErr )
+	dlclose( pOSHandle );
+#endif
+}
+
+
+SharedLibHandle SharedLib_Load( const char *pchPath, std::string *pErrStr, uint32_t unFlags )
+{
+	bool bLazyBinding = ( unFlags & k_ESharedLibLoad_LazyBinding ) != 0;
+	std::string sKey = GetSharedLibKey( pchPath );
+
+	SharedLibRegistry_t & registry = SharedLibRegistry();
+	std::lock_guard<std::recursive_mutex> lock( registry.mutex );
+
+	auto iter = registry.mapModules.find( sKey );
+	if ( iter != registry.mapModules.end() )
+	{
+		SharedLibModule_t *pModule = iter->second;
+#if defined(POSIX)
+		if ( pModule->stats.bLazyBinding && !bLazyBinding )
 		{
-			*pErrStr = std::string ( pErr );
+			// Opening it again with RTLD_NOW binds everything that is still pending. The
+			// binding sticks after the extra reference is dropped.
+			void *pOSHandle = OSLoad( pchPath, false );
+			if ( !pOSHandle )
+			{
+				if ( pErrStr )
+				{
+					char *pErr = dlerror();
+					if ( pErr )
+						*pErrStr = std::string( pErr );
+				}
+				return nullptr;
+			}
+			OSUnload( pOSHandle );
+			pModule->stats.bLazyBinding = false;
 		}
 #endif
+		pModule->stats.unRefCount++;
+		pModule->stats.unLoadCalls++;
+		return pModule;
+	}
+
+	uint64_t ulMinorFaultsBefore, ulMajorFaultsBefore;
+	GetPageFaults( &ulMinorFaultsBefore, &ulMajorFaultsBefore );
+	std::chrono::steady_clock::time_point timeStart = std::chrono::steady_clock::now();
+
+	void *pOSHandle = OSLoad( pchPath, bLazyBinding );
+
+	std::chrono::steady_clock::time_point timeEnd = std::chrono::steady_clock::now();
+	uint64_t ulMinorFaultsAfter, ulMajorFaultsAfter;
+	GetPageFaults( &ulMinorFaultsAfter, &ulMajorFaultsAfter );
+
+	if ( pOSHandle == nullptr )
+	{
+		if ( pErrStr )
+		{
+#if defined( _WIN32)
+			// TODO: Consider using FormatMessage to get an error string for this error code
+			*pErrStr =  std::to_string( GetLastError() );
+#elif defined(POSIX)
+			char * pErr = dlerror();
+			if ( pErr )
+			{
+				*pErrStr = std::string ( pErr );
+			}
+#endif
+		}
+		return nullptr;
 	}
 
-	return pHandle;
+	SharedLibModule_t *pModule = new SharedLibModule_t;
+	pModule->sKey = sKey;
+	pModule->pOSHandle = pOSHandle;
+	memset( &pModule->stats, 0, sizeof( pModule->stats ) );
+	pModule->stats.unRefCount = 1;
+	pModule->stats.unLoadCalls = 1;
+	pModule->stats.bLazyBinding = bLazyBinding;
+	pModule->stats.ulLoadTimeUs = ( uint64_t )std::chrono::duration_cast< std::chrono::microseconds >( timeEnd - timeStart ).count();
+	pModule->stats.ulMinorPageFaults = ulMinorFaultsAfter - ulMinorFaultsBefore;
+	pModule->stats.ulMajorPageFaults = ulMajorFaultsAfter - ulMajorFaultsBefore;
+	registry.mapModules[ sKey ] = pModule;
+	return pModule;
 }
 
 void *SharedLib_GetFunction( SharedLibHandle lib, const char *pchFunctionName)
 {
+	if ( !lib || !pchFunctionName )
+		return nullptr;
+
+	SharedLibModule_t *pModule = ( SharedLibModule_t * )lib;
+
+	SharedLibRegistry_t & registry = SharedLibRegistry();
+	std::lock_guard<std::recursive_mutex> lock( registry.mutex );
+
+	pModule->stats.unSymbolLookups++;
+
+#if defined( _WIN32)
+	// ordinals aren't names and can't be cached by one
+	if ( ( uintptr_t )pchFunctionName <= 0xFFFF )
+		return (void*)GetProcAddress( (HMODULE)pModule->pOSHandle, pchFunctionName );
+#endif
+
+	auto iter = pModule->mapSymbols.find( pchFunctionName );
+	if ( iter != pModule->mapSymbols.end() )
+	{
+		pModule->stats.unSymbolCacheHits++;
+		return iter->second;
+	}
+
 #if defined( _WIN32)
-	return (void*)GetProcAddress( (HMODULE)lib, pchFunctionName );
+	void *pSymbol = (void*)GetProcAddress( (HMODULE)pModule->pOSHandle, pchFunctionName );
 #elif defined(POSIX)
-	return dlsym( lib, pchFunctionName );
+	void *pSymbol = dlsym( pModule->pOSHandle, pchFunctionName );
 #endif
+	pModule->mapSymbols.emplace( pchFunctionName, pSymbol );
+	pModule->stats.unCachedSymbols = ( uint32_t )pModule->mapSymbols.size();
+	return pSymbol;
 }
 
 
@@ -52,11 +242,40 @@ void SharedLib_Unload( SharedLibHandle lib )
 {
 	if ( !lib )
 		return;
-#if defined( _WIN32)
-	FreeLibrary( (HMODULE)lib );
-#elif defined(POSIX)
-	dlclose( lib );
-#endif
+
+	SharedLibModule_t *pModule = ( SharedLibModule_t * )lib;
+
+	SharedLibRegistry_t & registry = SharedLibRegistry();
+	std::lock_guard<std::recursive_mutex> lock( registry.mutex );
+
+	if ( --pModule->stats.unRefCount > 0 )
+		return;
+
+	registry.mapModules.erase( pModule->sKey );
+	void *pOSHandle = pModule->pOSHandle;
+	delete pModule;
+
+	// after the module is gone from the registry, in case its static destructors load or unload others
+	OSUnload( pOSHandle );
 }
 
 
+bool SharedLib_GetStats( SharedLibHandle lib, SharedLibStats_t *pStats )
+{
+	if ( !lib || !pStats )
+		return false;
+
+	SharedLibRegistry_t & registry = SharedLibRegistry();
+	std::lock_guard<std::recursive_mutex> lock( registry.mutex );
+
+	// compared by address, so a handle that has already been unloaded is never dereferenced
+	for ( auto iter = registry.mapModules.begin(); iter != registry.mapModules.end(); ++iter )
+	{
+		if ( iter->second == lib )
+		{
+			*pStats = iter->second->stats;
+			return true;
+		}
+	}
+	return false;
+}
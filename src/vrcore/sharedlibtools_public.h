@@ -6,8 +6,37 @@
 
 typedef void *SharedLibHandle;
 
-SharedLibHandle SharedLib_Load( const char *pchPath, std::string *pErrStr = nullptr );
+enum ESharedLibLoadFlags
+{
+	k_ESharedLibLoad_Default = 0,
+
+	/** Resolve the module's own imports on first call instead of at load time. Makes loading
+	* a module that only gets a few calls much cheaper, but a missing import is reported when
+	* it's first called rather than by SharedLib_Load. Has no effect on Windows. */
+	k_ESharedLibLoad_LazyBinding = 1 << 0,
+};
+
+/** Loads a module, or adds a reference to it if this path is already loaded. Paths that name a
+* file are compared after resolving them, so different spellings of the same file share one load.
+* Every successful load needs a matching SharedLib_Unload. */
+SharedLibHandle SharedLib_Load( const char *pchPath, std::string *pErrStr = nullptr, uint32_t unFlags = k_ESharedLibLoad_Default );
+
+/** Looks up an exported symbol. Results, including misses, are cached per module. */
 void *SharedLib_GetFunction( SharedLibHandle lib, const char *pchFunctionName);
 void SharedLib_Unload( SharedLibHandle lib );
 
+struct SharedLibStats_t
+{
+	uint32_t unRefCount;			// outstanding SharedLib_Load calls
+	uint32_t unLoadCalls;			// SharedLib_Load calls this module has served, including ones that only added a reference
+	bool bLazyBinding;
+	uint64_t ulLoadTimeUs;			// time spent in the OS loader, once per module
+	uint64_t ulMinorPageFaults;		// faults the loading thread took while in the OS loader
+	uint64_t ulMajorPageFaults;
+	uint32_t unCachedSymbols;		// distinct names looked up, including ones the module doesn't export
+	uint32_t unSymbolLookups;		// SharedLib_GetFunction calls
+	uint32_t unSymbolCacheHits;
+};
 
+/** Returns false if lib isn't a loaded module. Page faults are only counted on Linux and macOS. */
+bool SharedLib_GetStats( SharedLibHandle lib, SharedLibStats_t *pStats );
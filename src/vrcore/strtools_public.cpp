@@ -4,11 +4,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <sstream>
-#include <codecvt>
 #include <iostream>
 #include <functional>
-#include <locale>
-#include <codecvt>
+#include <algorithm>
 #include <cstdarg>
 
 #if !defined( VRCORE_NO_PLATFORM )
@@ -17,6 +15,14 @@
 #define AssertMsg( cond, ... )
 #endif
 
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#include <emmintrin.h>
+#define STRTOOLS_SSE2
+#elif defined( __aarch64__ ) || defined( _M_ARM64 )
+#include <arm_neon.h>
+#define STRTOOLS_NEON
+#endif
+
 #if defined( _WIN32 )
 #include <windows.h>
 #endif
@@ -96,20 +102,227 @@ std::string StringReplace( const std::string &sModify, const std::string &sFind,
 }
 
 //-----------------------------------------------------------------------------
-// Purpose: Converts a UTF-16 formatted string to a UTF-8 formatted string
+// Purpose: Returns the number of leading ASCII bytes in [p, pEnd). Long runs of
+//			ASCII are by far the common case for the strings we convert, so they
+//			are checked a vector at a time.
 //-----------------------------------------------------------------------------
-std::string UTF16to8( const std::wstring &in )
+static size_t CountLeadingASCII( const uint8_t *p, const uint8_t *pEnd )
 {
-	static std::wstring_convert< std::codecvt_utf8_utf16< wchar_t >, wchar_t > s_convert; // construction of this can be expensive (or even serialized) depending on locale
+	const uint8_t *pStart = p;
 
-	try
+#if defined( STRTOOLS_SSE2 )
+	while ( pEnd - p >= 16 )
 	{
-		return s_convert.to_bytes( in );
+		__m128i vecChars = _mm_loadu_si128( reinterpret_cast< const __m128i * >( p ) );
+		if ( _mm_movemask_epi8( vecChars ) != 0 )
+			break;
+		p += 16;
 	}
-	catch ( ... )
+#elif defined( STRTOOLS_NEON )
+	while ( pEnd - p >= 16 )
 	{
-		return std::string();
+		if ( vmaxvq_u8( vld1q_u8( p ) ) >= 0x80 )
+			break;
+		p += 16;
+	}
+#else
+	while ( pEnd - p >= 8 )
+	{
+		uint64_t ulChars;
+		memcpy( &ulChars, p, sizeof( ulChars ) );
+		if ( ulChars & 0x8080808080808080ull )
+			break;
+		p += 8;
+	}
+#endif
+
+	while ( p < pEnd && *p < 0x80 )
+		p++;
+
+	return p - pStart;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Decodes one UTF-8 sequence (no overlong forms, nothing above
+//			U+10FFFF). Encoded surrogates are let through, as the codecvt facets
+//			we used to rely on did. Returns the sequence length, or 0 if the
+//			bytes at p are not a complete valid sequence.
+//-----------------------------------------------------------------------------
+static inline size_t DecodeUTF8CodePoint( const uint8_t *p, const uint8_t *pEnd, uint32_t *punCodePoint )
+{
+	uint32_t c = p[ 0 ];
+	size_t unAvail = pEnd - p;
+	if ( c < 0x80 )
+	{
+		*punCodePoint = c;
+		return 1;
+	}
+	else if ( c < 0xC2 )
+	{
+		return 0;
+	}
+	else if ( c < 0xE0 )
+	{
+		if ( unAvail < 2 || ( p[ 1 ] & 0xC0 ) != 0x80 )
+			return 0;
+		*punCodePoint = ( ( c & 0x1F ) << 6 ) | ( p[ 1 ] & 0x3F );
+		return 2;
+	}
+	else if ( c < 0xF0 )
+	{
+		if ( unAvail < 3 || ( p[ 1 ] & 0xC0 ) != 0x80 || ( p[ 2 ] & 0xC0 ) != 0x80 )
+			return 0;
+		if ( c == 0xE0 && p[ 1 ] < 0xA0 )
+			return 0;
+		*punCodePoint = ( ( c & 0x0F ) << 12 ) | ( ( p[ 1 ] & 0x3F ) << 6 ) | ( p[ 2 ] & 0x3F );
+		return 3;
+	}
+	else if ( c < 0xF5 )
+	{
+		if ( unAvail < 4 || ( p[ 1 ] & 0xC0 ) != 0x80 || ( p[ 2 ] & 0xC0 ) != 0x80 || ( p[ 3 ] & 0xC0 ) != 0x80 )
+			return 0;
+		if ( ( c == 0xF0 && p[ 1 ] < 0x90 ) || ( c == 0xF4 && p[ 1 ] >= 0x90 ) )
+			return 0;
+		*punCodePoint = ( ( c & 0x07 ) << 18 ) | ( ( p[ 1 ] & 0x3F ) << 12 ) | ( ( p[ 2 ] & 0x3F ) << 6 ) | ( p[ 3 ] & 0x3F );
+		return 4;
+	}
+
+	return 0;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns true if p starts a multi-byte sequence that is cut off by
+//			the end of the input
+//-----------------------------------------------------------------------------
+static inline bool IsTruncatedUTF8Sequence( const uint8_t *p, const uint8_t *pEnd )
+{
+	size_t unAvail = pEnd - p;
+	uint8_t c = p[ 0 ];
+	if ( c < 0xC2 || c >= 0xF5 )
+		return false;
+	else if ( c < 0xE0 )
+		return unAvail < 2;
+	else if ( c < 0xF0 )
+		return unAvail < 3;
+	return unAvail < 4;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns true if the range is entirely well-formed UTF-8
+//-----------------------------------------------------------------------------
+bool IsValidUTF8( const char *pchBegin, const char *pchEnd )
+{
+	const uint8_t *p = reinterpret_cast< const uint8_t * >( pchBegin );
+	const uint8_t *pEnd = reinterpret_cast< const uint8_t * >( pchEnd );
+	while ( p < pEnd )
+	{
+		p += CountLeadingASCII( p, pEnd );
+		if ( p == pEnd )
+			break;
+
+		uint32_t unCodePoint;
+		size_t unLength = DecodeUTF8CodePoint( p, pEnd, &unCodePoint );
+		if ( !unLength )
+			return false;
+		p += unLength;
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Converts a UTF-16 formatted string to a UTF-8 formatted string
+//			without allocating. Where wchar_t is 32 bits a unit above 0xFFFF is
+//			taken as a whole code point. A surrogate pair cut off by the end of
+//			the input is dropped rather than failing the conversion, as the
+//			codecvt-based version did.
+//-----------------------------------------------------------------------------
+bool UTF16to8( const wchar_t *pwchIn, size_t unInLength, char *pchOut, size_t unOutSize, size_t *punRequired )
+{
+	size_t unOut = 0;
+	const wchar_t *pwchEnd = pwchIn + unInLength;
+	for ( const wchar_t *pwch = pwchIn; pwch < pwchEnd; )
+	{
+		// plain ASCII runs need no encoding, just narrowing
+		if ( (uint32_t)*pwch < 0x80 )
+		{
+			const wchar_t *pwchRunEnd = pwch;
+			while ( pwchRunEnd < pwchEnd && (uint32_t)*pwchRunEnd < 0x80 )
+				pwchRunEnd++;
+
+			size_t unRun = pwchRunEnd - pwch;
+			if ( unOut < unOutSize )
+			{
+				size_t unCopy = std::min( unRun, unOutSize - unOut );
+				for ( size_t i = 0; i < unCopy; i++ )
+					pchOut[ unOut + i ] = (char)pwch[ i ];
+			}
+			unOut += unRun;
+			pwch = pwchRunEnd;
+			continue;
+		}
+
+		uint32_t unCodePoint = (uint32_t)*pwch++;
+		if ( unCodePoint > 0x10FFFF || ( unCodePoint >= 0xDC00 && unCodePoint <= 0xDFFF ) )
+		{
+			return false;
+		}
+		else if ( unCodePoint >= 0xD800 && unCodePoint <= 0xDBFF )
+		{
+			if ( pwch == pwchEnd )
+				break;
+			uint32_t unLow = (uint32_t)*pwch++;
+			if ( unLow < 0xDC00 || unLow > 0xDFFF )
+				return false;
+			unCodePoint = 0x10000 + ( ( unCodePoint - 0xD800 ) << 10 ) + ( unLow - 0xDC00 );
+		}
+
+		char rchEncoded[ 4 ];
+		size_t unEncoded;
+		if ( unCodePoint < 0x800 )
+		{
+			rchEncoded[ 0 ] = (char)( 0xC0 | ( unCodePoint >> 6 ) );
+			rchEncoded[ 1 ] = (char)( 0x80 | ( unCodePoint & 0x3F ) );
+			unEncoded = 2;
+		}
+		else if ( unCodePoint < 0x10000 )
+		{
+			rchEncoded[ 0 ] = (char)( 0xE0 | ( unCodePoint >> 12 ) );
+			rchEncoded[ 1 ] = (char)( 0x80 | ( ( unCodePoint >> 6 ) & 0x3F ) );
+			rchEncoded[ 2 ] = (char)( 0x80 | ( unCodePoint & 0x3F ) );
+			unEncoded = 3;
+		}
+		else
+		{
+			rchEncoded[ 0 ] = (char)( 0xF0 | ( unCodePoint >> 18 ) );
+			rchEncoded[ 1 ] = (char)( 0x80 | ( ( unCodePoint >> 12 ) & 0x3F ) );
+			rchEncoded[ 2 ] = (char)( 0x80 | ( ( unCodePoint >> 6 ) & 0x3F ) );
+			rchEncoded[ 3 ] = (char)( 0x80 | ( unCodePoint & 0x3F ) );
+			unEncoded = 4;
+		}
+
+		for ( size_t i = 0; i < unEncoded; i++ )
+		{
+			if ( unOut + i < unOutSize )
+				pchOut[ unOut + i ] = rchEncoded[ i ];
+		}
+		unOut += unEncoded;
 	}
+
+	if ( punRequired )
+		*punRequired = unOut;
+	return true;
+}
+
+std::string UTF16to8( const std::wstring &in )
+{
+	size_t unRequired;
+	if ( !UTF16to8( in.data(), in.size(), nullptr, 0, &unRequired ) )
+		return std::string();
+
+	std::string sOut( unRequired, '\0' );
+	if ( unRequired )
+		UTF16to8( in.data(), in.size(), &sOut[ 0 ], unRequired, &unRequired );
+	return sOut;
 }
 
 std::string UTF16to8( const wchar_t * in )
@@ -125,19 +338,70 @@ std::string UTF16to8( const wchar_t * in )
 
 //-----------------------------------------------------------------------------
 // Purpose: Converts a UTF-8 formatted string to a UTF-16 formatted string
+//			without allocating. Like UTF16to8 a truncated final sequence is
+//			dropped.
 //-----------------------------------------------------------------------------
-std::wstring UTF8to16( const std::string &in )
+bool UTF8to16( const char *pchIn, size_t unInLength, wchar_t *pwchOut, size_t unOutSize, size_t *punRequired )
 {
-	static std::wstring_convert< std::codecvt_utf8_utf16< wchar_t >, wchar_t > s_convert; // construction of this can be expensive (or even serialized) depending on locale
-
-	try
+	size_t unOut = 0;
+	const uint8_t *p = reinterpret_cast< const uint8_t * >( pchIn );
+	const uint8_t *pEnd = p + unInLength;
+	while ( p < pEnd )
 	{
-		return s_convert.from_bytes( in );
+		size_t unRun = CountLeadingASCII( p, pEnd );
+		if ( unOut < unOutSize )
+		{
+			size_t unCopy = std::min( unRun, unOutSize - unOut );
+			for ( size_t i = 0; i < unCopy; i++ )
+				pwchOut[ unOut + i ] = (wchar_t)p[ i ];
+		}
+		unOut += unRun;
+		p += unRun;
+		if ( p == pEnd )
+			break;
+
+		uint32_t unCodePoint;
+		size_t unLength = DecodeUTF8CodePoint( p, pEnd, &unCodePoint );
+		if ( !unLength )
+		{
+			if ( IsTruncatedUTF8Sequence( p, pEnd ) )
+				break;
+			return false;
+		}
+		p += unLength;
+
+		if ( unCodePoint >= 0x10000 )
+		{
+			unCodePoint -= 0x10000;
+			if ( unOut < unOutSize )
+				pwchOut[ unOut ] = (wchar_t)( 0xD800 + ( unCodePoint >> 10 ) );
+			if ( unOut + 1 < unOutSize )
+				pwchOut[ unOut + 1 ] = (wchar_t)( 0xDC00 + ( unCodePoint & 0x3FF ) );
+			unOut += 2;
+		}
+		else
+		{
+			if ( unOut < unOutSize )
+				pwchOut[ unOut ] = (wchar_t)unCodePoint;
+			unOut++;
+		}
 	}
-	catch ( ... )
-	{
+
+	if ( punRequired )
+		*punRequired = unOut;
+	return true;
+}
+
+std::wstring UTF8to16( const std::string &in )
+{
+	size_t unRequired;
+	if ( !UTF8to16( in.data(), in.size(), nullptr, 0, &unRequired ) )
 		return std::wstring();
-	}
+
+	std::wstring wsOut( unRequired, L'\0' );
+	if ( unRequired )
+		UTF8to16( in.data(), in.size(), &wsOut[ 0 ], unRequired, &unRequired );
+	return wsOut;
 }
 
 std::wstring UTF8to16( const char * in )
@@ -342,145 +606,230 @@ static bool CharNeedsEscape_FullPath( const char c )
 
 
 //-----------------------------------------------------------------------------
-// Purpose: Internal implementation of encode, works in the strict RFC manner, or
-//          with spaces turned to + like HTML form encoding.
+// Purpose: Per-byte lookup tables for URL encode and decode, built once from
+//			the filters above.
 //-----------------------------------------------------------------------------
-void V_URLEncodeInternal( char *pchDest, int nDestLen, const char *pchSource, int nSourceLen, 
-	bool bUsePlusForSpace, std::function< bool(const char)> fnNeedsEscape )
+enum EURLEncodeAction
 {
-	//AssertMsg( nDestLen > 3*nSourceLen, "Target buffer for V_URLEncode should be 3x source length, plus one for terminating null\n" );
-	
-	int iDestPos = 0;
-	for ( int i=0; i < nSourceLen; ++i )
+	k_EURLEncodeAction_Copy = 0,
+	k_EURLEncodeAction_Plus = 1,
+	k_EURLEncodeAction_Escape = 2,
+};
+
+struct URLCharTables_t
+{
+	uint8_t m_rgEncodeAction[ k_EURLEncodeMode_Count ][ 256 ];
+	uint8_t m_rgDecodeSpecial[ 2 ][ 256 ];		// indexed by bUsePlusForSpace
+	int8_t m_rgHexValue[ 256 ];
+
+	URLCharTables_t()
 	{
-		// worst case we need 3 additional chars
-		if( (iDestPos+3) > nDestLen  )
+		for ( int i = 0; i < 256; i++ )
 		{
-			pchDest[0] = '\0';
-//			AssertMsg( false, "Target buffer too short\n" );
-			return;
+			char c = (char)i;
+
+			// We allow only a-z, A-Z, 0-9, period, underscore, and hyphen to pass through unescaped.
+			// These are the characters allowed by both the original RFC 1738 and the latest RFC 3986.
+			// Current specs also allow '~', but that is forbidden under original RFC 1738.
+			uint8_t unComponent = (uint8_t)( CharNeedsEscape_Component( c ) ? k_EURLEncodeAction_Escape : k_EURLEncodeAction_Copy );
+			m_rgEncodeAction[ k_EURLEncodeMode_Form ][ i ] = c == ' ' ? (uint8_t)k_EURLEncodeAction_Plus : unComponent;
+			m_rgEncodeAction[ k_EURLEncodeMode_Component ][ i ] = unComponent;
+			m_rgEncodeAction[ k_EURLEncodeMode_FullPath ][ i ] = (uint8_t)( CharNeedsEscape_FullPath( c ) ? k_EURLEncodeAction_Escape : k_EURLEncodeAction_Copy );
+
+			m_rgDecodeSpecial[ false ][ i ] = c == '%';
+			m_rgDecodeSpecial[ true ][ i ] = c == '%' || c == '+';
+
+			m_rgHexValue[ i ] = (int8_t)iHexCharToInt( c );
 		}
+	}
+};
+
+static const URLCharTables_t &GetURLCharTables()
+{
+	static URLCharTables_t s_tables;
+	return s_tables;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns the exact length of the encoded form of the source, not
+//			counting a terminator
+//-----------------------------------------------------------------------------
+size_t V_URLEncodedLength( const char *pchSource, size_t unSourceLen, EURLEncodeMode eMode )
+{
+	const uint8_t *rgAction = GetURLCharTables().m_rgEncodeAction[ eMode ];
+	const uint8_t *pSource = reinterpret_cast< const uint8_t * >( pchSource );
+
+	size_t unLength = unSourceLen;
+	for ( size_t i = 0; i < unSourceLen; i++ )
+	{
+		// escapes take two more chars than the source byte, everything else is one for one
+		unLength += rgAction[ pSource[ i ] ] & k_EURLEncodeAction_Escape;
+	}
+	return unLength;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Encodes the source into pchDest, which must have room for exactly
+//			V_URLEncodedLength bytes. No terminator is written.
+//-----------------------------------------------------------------------------
+static char *URLEncodeRaw( char *pchDest, const char *pchSource, size_t unSourceLen, EURLEncodeMode eMode )
+{
+	const uint8_t *rgAction = GetURLCharTables().m_rgEncodeAction[ eMode ];
+	const uint8_t *pSource = reinterpret_cast< const uint8_t * >( pchSource );
+	const uint8_t *pSourceEnd = pSource + unSourceLen;
 
-		// We allow only a-z, A-Z, 0-9, period, underscore, and hyphen to pass through unescaped.
-		// These are the characters allowed by both the original RFC 1738 and the latest RFC 3986.
-		// Current specs also allow '~', but that is forbidden under original RFC 1738.
-		if ( fnNeedsEscape( pchSource[i] ) )
+	while ( pSource < pSourceEnd )
+	{
+		uint8_t c = *pSource++;
+		uint8_t unAction = rgAction[ c ];
+		if ( unAction == k_EURLEncodeAction_Copy )
 		{
-			if ( bUsePlusForSpace && pchSource[i] == ' ' )
-			{
-				pchDest[iDestPos++] = '+';
-			}
-			else
-			{
-				pchDest[iDestPos++] = '%';
-				uint8_t iValue = pchSource[i];
-				if ( iValue == 0 )
-				{
-					pchDest[iDestPos++] = '0';
-					pchDest[iDestPos++] = '0';
-				}
-				else
-				{
-					char cHexDigit1 = cIntToHexDigit( iValue % 16 );
-					iValue /= 16;
-					char cHexDigit2 = cIntToHexDigit( iValue );
-					pchDest[iDestPos++] = cHexDigit2;
-					pchDest[iDestPos++] = cHexDigit1;
-				}
-			}
+			*pchDest++ = (char)c;
+		}
+		else if ( unAction == k_EURLEncodeAction_Plus )
+		{
+			*pchDest++ = '+';
 		}
 		else
 		{
-			pchDest[iDestPos++] = pchSource[i];
+			*pchDest++ = '%';
+			*pchDest++ = cIntToHexDigit( c >> 4 );
+			*pchDest++ = cIntToHexDigit( c & 15 );
 		}
 	}
 
-	if( (iDestPos+1) > nDestLen )
+	return pchDest;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Internal implementation of encode, works in the strict RFC manner, or
+//          with spaces turned to + like HTML form encoding. If the result and its
+//			terminator don't fit the dest buffer is set to an empty string.
+//-----------------------------------------------------------------------------
+static void V_URLEncodeInternal( char *pchDest, int nDestLen, const char *pchSource, int nSourceLen, EURLEncodeMode eMode )
+{
+	if ( nDestLen <= 0 )
+		return;
+
+	size_t unSourceLen = nSourceLen > 0 ? (size_t)nSourceLen : 0;
+	size_t unEncodedLen = V_URLEncodedLength( pchSource, unSourceLen, eMode );
+	if ( unEncodedLen + 1 > (size_t)nDestLen )
 	{
 		pchDest[0] = '\0';
-		//AssertMsg( false, "Target buffer too short to terminate\n" );
+//		AssertMsg( false, "Target buffer too short\n" );
 		return;
 	}
 
+	char *pchEnd = URLEncodeRaw( pchDest, pchSource, unSourceLen, eMode );
+
 	// Null terminate
-	pchDest[iDestPos++] = 0;
+	*pchEnd = 0;
 }
 
 
 //-----------------------------------------------------------------------------
-// Purpose: Internal implementation of decode, works in the strict RFC manner, or
-//          with spaces turned to + like HTML form encoding.
+// Purpose: Decodes as much of the source as can be decoded without looking
+//			past its end. Stops in front of a % that has fewer than two chars
+//			after it and reports how much of the source was used. pchDest may
+//			be the same as pchSource.
 //
 //			Returns the amount of space used in the output buffer.
 //-----------------------------------------------------------------------------
-size_t V_URLDecodeInternal( char *pchDecodeDest, int nDecodeDestLen, const char *pchEncodedSource, int nEncodedSourceLen, bool bUsePlusForSpace )
+static size_t URLDecodeRaw( char *pchDecodeDest, const char *pchEncodedSource, size_t unEncodedSourceLen, bool bUsePlusForSpace, size_t *punConsumed )
 {
-	if ( nDecodeDestLen < nEncodedSourceLen )
-	{
-		//AssertMsg( false, "V_URLDecode needs a dest buffer at least as large as the source" );
-		return 0;
-	}
+	const URLCharTables_t &tables = GetURLCharTables();
+	const uint8_t *rgSpecial = tables.m_rgDecodeSpecial[ bUsePlusForSpace ];
 
-	int iDestPos = 0;
-	for( int i=0; i < nEncodedSourceLen; ++i )
+	char *pchDest = pchDecodeDest;
+	size_t i = 0;
+	while ( i < unEncodedSourceLen )
 	{
-		if ( bUsePlusForSpace && pchEncodedSource[i] == '+' )
+		char c = pchEncodedSource[ i ];
+		if ( !rgSpecial[ (uint8_t)c ] )
 		{
-			pchDecodeDest[ iDestPos++ ] = ' ';
+			*pchDest++ = c;
+			i++;
+			continue;
 		}
-		else if ( pchEncodedSource[i] == '%' )
+
+		if ( pchEncodedSource[ i ] == '+' )
 		{
-			// Percent signifies an encoded value, look ahead for the hex code, convert to numeric, and use that
+			*pchDest++ = ' ';
+			i++;
+			continue;
+		}
 
-			// First make sure we have 2 more chars
-			if ( i < nEncodedSourceLen - 2 )
-			{
-				char cHexDigit1 = pchEncodedSource[i+1];
-				char cHexDigit2 = pchEncodedSource[i+2];
-
-				// Turn the chars into a hex value, if they are not valid, then we'll
-				// just place the % and the following two chars direct into the string,
-				// even though this really shouldn't happen, who knows what bad clients
-				// may do with encoding.
-				bool bValid = false;
-				int iValue = iHexCharToInt( cHexDigit1 );
-				if ( iValue != -1 )
-				{
-					iValue *= 16;
-					int iValue2 = iHexCharToInt( cHexDigit2 );
-					if ( iValue2 != -1 )
-					{
-						iValue += iValue2;
-						pchDecodeDest[ iDestPos++ ] = (char)iValue;
-						bValid = true;
-					}
-				}
-
-				if ( !bValid )
-				{
-					pchDecodeDest[ iDestPos++ ] = '%';
-					pchDecodeDest[ iDestPos++ ] = cHexDigit1;
-					pchDecodeDest[ iDestPos++ ] = cHexDigit2;
-				}
-			}
+		// Percent signifies an encoded value, look ahead for the hex code, convert to numeric, and use that
+		if ( unEncodedSourceLen - i < 3 )
+			break;
 
-			// Skip ahead
-			i += 2;
+		char cHexDigit1 = pchEncodedSource[ i + 1 ];
+		char cHexDigit2 = pchEncodedSource[ i + 2 ];
+
+		// Turn the chars into a hex value, if they are not valid, then we'll
+		// just place the % and the following two chars direct into the string,
+		// even though this really shouldn't happen, who knows what bad clients
+		// may do with encoding.
+		int nHigh = tables.m_rgHexValue[ (uint8_t)cHexDigit1 ];
+		int nLow = tables.m_rgHexValue[ (uint8_t)cHexDigit2 ];
+		if ( nHigh >= 0 && nLow >= 0 )
+		{
+			*pchDest++ = (char)( nHigh * 16 + nLow );
 		}
 		else
 		{
-			pchDecodeDest[ iDestPos++ ] = pchEncodedSource[i];
+			*pchDest++ = '%';
+			*pchDest++ = cHexDigit1;
+			*pchDest++ = cHexDigit2;
 		}
+		i += 3;
+	}
+
+	*punConsumed = i;
+	return pchDest - pchDecodeDest;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Internal implementation of decode, works in the strict RFC manner, or
+//          with spaces turned to + like HTML form encoding.
+//
+//			Returns the amount of space used in the output buffer.
+//-----------------------------------------------------------------------------
+static size_t V_URLDecodeInternal( char *pchDecodeDest, int nDecodeDestLen, const char *pchEncodedSource, int nEncodedSourceLen, bool bUsePlusForSpace )
+{
+	if ( nDecodeDestLen < nEncodedSourceLen )
+	{
+		//AssertMsg( false, "V_URLDecode needs a dest buffer at least as large as the source" );
+		return 0;
 	}
 
+	// a % too close to the end to be an escape is dropped along with whatever follows it
+	size_t unConsumed;
+	size_t unDestPos = URLDecodeRaw( pchDecodeDest, pchEncodedSource, nEncodedSourceLen > 0 ? (size_t)nEncodedSourceLen : 0, bUsePlusForSpace, &unConsumed );
+
 	// We may not have extra room to NULL terminate, since this can be used on raw data, but if we do
 	// go ahead and do it as this can avoid bugs.
-	if ( iDestPos < nDecodeDestLen )
+	if ( unDestPos < (size_t)nDecodeDestLen )
 	{
-		pchDecodeDest[iDestPos] = 0;
+		pchDecodeDest[ unDestPos ] = 0;
 	}
 
-	return (size_t)iDestPos;
+	return unDestPos;
+}
+
+static std::string URLDecodeString( const std::string &sSource, bool bUsePlusForSpace )
+{
+	std::string sDecoded( sSource );
+	if ( !sDecoded.empty() )
+	{
+		size_t unConsumed;
+		sDecoded.resize( URLDecodeRaw( &sDecoded[ 0 ], sDecoded.data(), sDecoded.size(), bUsePlusForSpace, &unConsumed ) );
+	}
+	return sDecoded;
 }
 
 //-----------------------------------------------------------------------------
@@ -492,18 +841,54 @@ size_t V_URLDecodeInternal( char *pchDecodeDest, int nDecodeDestLen, const char
 //-----------------------------------------------------------------------------
 void V_URLEncode( char *pchDest, int nDestLen, const char *pchSource, int nSourceLen )
 {
-	return V_URLEncodeInternal( pchDest, nDestLen, pchSource, nSourceLen, true, CharNeedsEscape_Component );
+	return V_URLEncodeInternal( pchDest, nDestLen, pchSource, nSourceLen, k_EURLEncodeMode_Form );
 }
 
 
 void V_URLEncodeNoPlusForSpace( char *pchDest, int nDestLen, const char *pchSource, int nSourceLen )
 {
-	return V_URLEncodeInternal( pchDest, nDestLen, pchSource, nSourceLen, false, CharNeedsEscape_Component );
+	return V_URLEncodeInternal( pchDest, nDestLen, pchSource, nSourceLen, k_EURLEncodeMode_Component );
 }
 
 void V_URLEncodeFullPath( char *pchDest, int nDestLen, const char *pchSource, int nSourceLen )
 {
-	return V_URLEncodeInternal( pchDest, nDestLen, pchSource, nSourceLen, false, CharNeedsEscape_FullPath );
+	return V_URLEncodeInternal( pchDest, nDestLen, pchSource, nSourceLen, k_EURLEncodeMode_FullPath );
+}
+
+std::string V_URLEncode( const std::string &sSource )
+{
+	std::string sEncoded;
+	V_URLEncodeAppend( sEncoded, sSource.data(), sSource.size(), k_EURLEncodeMode_Form );
+	return sEncoded;
+}
+
+std::string V_URLEncodeNoPlusForSpace( const std::string &sSource )
+{
+	std::string sEncoded;
+	V_URLEncodeAppend( sEncoded, sSource.data(), sSource.size(), k_EURLEncodeMode_Component );
+	return sEncoded;
+}
+
+std::string V_URLEncodeFullPath( const std::string &sSource )
+{
+	std::string sEncoded;
+	V_URLEncodeAppend( sEncoded, sSource.data(), sSource.size(), k_EURLEncodeMode_FullPath );
+	return sEncoded;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Appends the encoded source to sDest. Encoding has no state, so
+//			large payloads can be passed through in chunks.
+//-----------------------------------------------------------------------------
+void V_URLEncodeAppend( std::string &sDest, const char *pchSource, size_t unSourceLen, EURLEncodeMode eMode )
+{
+	size_t unEncodedLen = V_URLEncodedLength( pchSource, unSourceLen, eMode );
+	if ( !unEncodedLen )
+		return;
+
+	size_t unOldLen = sDest.size();
+	sDest.resize( unOldLen + unEncodedLen );
+	URLEncodeRaw( &sDest[ unOldLen ], pchSource, unSourceLen, eMode );
 }
 
 //-----------------------------------------------------------------------------
@@ -524,6 +909,67 @@ size_t V_URLDecodeNoPlusForSpace( char *pchDecodeDest, int nDecodeDestLen, const
 	return V_URLDecodeInternal( pchDecodeDest, nDecodeDestLen, pchEncodedSource, nEncodedSourceLen, false );
 }
 
+std::string V_URLDecode( const std::string &sSource )
+{
+	return URLDecodeString( sSource, true );
+}
+
+std::string V_URLDecodeNoPlusForSpace( const std::string &sSource )
+{
+	return URLDecodeString( sSource, false );
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Chunked decoder. An escape split across two chunks is held back
+//			until the rest of it arrives.
+//-----------------------------------------------------------------------------
+CURLDecodeStream::CURLDecodeStream( bool bUsePlusForSpace )
+	: m_bUsePlusForSpace( bUsePlusForSpace )
+	, m_unPending( 0 )
+{
+}
+
+void CURLDecodeStream::Append( const char *pchEncoded, size_t unEncodedLen, std::string &sDecoded )
+{
+	// output never exceeds input, counting the bytes we held back last time
+	size_t unOldLen = sDecoded.size();
+	sDecoded.resize( unOldLen + m_unPending + unEncodedLen );
+	char *pchDest = &sDecoded[ 0 ] + unOldLen;
+
+	if ( m_unPending )
+	{
+		while ( m_unPending < sizeof( m_rchPending ) && unEncodedLen )
+		{
+			m_rchPending[ m_unPending++ ] = *pchEncoded++;
+			unEncodedLen--;
+		}
+
+		if ( m_unPending < sizeof( m_rchPending ) )
+		{
+			sDecoded.resize( unOldLen );
+			return;
+		}
+
+		size_t unConsumed;
+		pchDest += URLDecodeRaw( pchDest, m_rchPending, m_unPending, m_bUsePlusForSpace, &unConsumed );
+		m_unPending = 0;
+	}
+
+	size_t unConsumed;
+	pchDest += URLDecodeRaw( pchDest, pchEncoded, unEncodedLen, m_bUsePlusForSpace, &unConsumed );
+	while ( unConsumed < unEncodedLen )
+	{
+		m_rchPending[ m_unPending++ ] = pchEncoded[ unConsumed++ ];
+	}
+
+	sDecoded.resize( pchDest - sDecoded.data() );
+}
+
+void CURLDecodeStream::Reset()
+{
+	m_unPending = 0;
+}
+
 //-----------------------------------------------------------------------------
 void V_StripExtension( std::string &in )
 {
@@ -565,78 +1011,55 @@ std::vector<std::string> TokenizeString( const std::string & sString, char cToke
 
 //-----------------------------------------------------------------------------
 // Purpose: Repairs a should-be-UTF-8 string to a for-sure-is-UTF-8 string, plus return boolean if we subbed in '?' somewhere
+//			Every byte that doesn't start a valid sequence becomes one '?', so the output is
+//			always exactly as long as the input and pchOut may be the same as pbegin.
 //-----------------------------------------------------------------------------
-bool RepairUTF8( const char *pbegin, const char *pend, std::string & sOutputUtf8 )
+bool RepairUTF8( const char *pbegin, const char *pend, char *pchOut )
 {
-	typedef std::codecvt_utf8<char32_t> facet_type;
-	facet_type myfacet;
-
-	std::mbstate_t mystate = std::mbstate_t();
-
-	sOutputUtf8.clear();
-	sOutputUtf8.reserve( pend - pbegin );
 	bool bSqueakyClean = true;
 
-	const char *pmid = pbegin;
-	while ( pmid != pend )
+	const uint8_t *p = reinterpret_cast< const uint8_t * >( pbegin );
+	const uint8_t *pEnd = reinterpret_cast< const uint8_t * >( pend );
+	char *pchDest = pchOut;
+	while ( p < pEnd )
 	{
-		bool bHasError = false;
-		bool bHasValidData = false;
-
-		char32_t out = 0xdeadbeef, *pout;
-		pbegin = pmid;
-		switch ( myfacet.in( mystate, pbegin, pend, pmid, &out, &out + 1, pout ) )
-		{
-		case facet_type::ok:
-			bHasValidData = true;
-			break;
-
-		case facet_type::noconv:
-			// unexpected! always converting type
-			bSqueakyClean = false;
-			break;
-
-		case facet_type::partial:
-			bHasError = pbegin == pmid;
-			if ( bHasError )
-			{
-				bSqueakyClean = false;
-			}
-			else
-			{
-				bHasValidData = true;
-			}
-			break;
-
-		case facet_type::error:
-			bHasError = true;
-			bSqueakyClean = false;
+		size_t unRun = CountLeadingASCII( p, pEnd );
+		if ( pchDest != reinterpret_cast< const char * >( p ) )
+			memmove( pchDest, p, unRun );
+		pchDest += unRun;
+		p += unRun;
+		if ( p == pEnd )
 			break;
-		}
-
-		if ( bHasValidData )
-		{
-			// could convert back, but no need
-			for ( const char *p = pbegin; p != pmid; ++p )
-			{
-				sOutputUtf8 += *p;
-			}
-		}
 
-		if ( bHasError )
+		uint32_t unCodePoint;
+		size_t unLength = DecodeUTF8CodePoint( p, pEnd, &unCodePoint );
+		if ( unLength )
 		{
-			sOutputUtf8 += '?';
+			for ( size_t i = 0; i < unLength; i++ )
+				pchDest[ i ] = (char)p[ i ];
+			pchDest += unLength;
+			p += unLength;
 		}
-
-		if ( pmid == pbegin )
+		else
 		{
-			pmid++;
+			*pchDest++ = '?';
+			p++;
+			bSqueakyClean = false;
 		}
 	}
 
 	return bSqueakyClean;
 }
 
+bool RepairUTF8( const char *pbegin, const char *pend, std::string & sOutputUtf8 )
+{
+	sOutputUtf8.resize( pend - pbegin );
+	if ( sOutputUtf8.empty() )
+		return true;
+
+	return RepairUTF8( pbegin, pend, &sOutputUtf8[ 0 ] );
+}
+
 //-----------------------------------------------------------------------------
 // Purpose: Repairs a should-be-UTF-8 string to a for-sure-is-UTF-8 string, plus return boolean if we subbed in '?' somewhere
 //-----------------------------------------------------------------------------
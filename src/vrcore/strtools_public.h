@@ -26,6 +26,15 @@ std::wstring UTF8to16(const char * in);
 std::wstring UTF8to16( const std::string & in );
 #define Utf16FromUtf8 UTF8to16
 
+/** Buffer versions of the conversions above, which don't allocate. Return false if the input is not
+* valid. Otherwise *punRequired is set to the full output length (no terminator is written) and the
+* output is complete if that fits in unOutSize. Pass a NULL buffer and 0 size to just measure. */
+bool UTF16to8( const wchar_t *pwchIn, size_t unInLength, char *pchOut, size_t unOutSize, size_t *punRequired );
+bool UTF8to16( const char *pchIn, size_t unInLength, wchar_t *pwchOut, size_t unOutSize, size_t *punRequired );
+
+/** returns true if the range is entirely well-formed UTF-8 */
+bool IsValidUTF8( const char *pchBegin, const char *pchEnd );
+
 #if defined( _WIN32 )
 std::string DefaultACPtoUTF8( const char *pszStr );
 #endif
@@ -34,6 +43,9 @@ std::string DefaultACPtoUTF8( const char *pszStr );
 bool RepairUTF8( const char *begin, const char *end, std::string & sOutputUtf8 );
 bool RepairUTF8( const std::string & sInputUtf8, std::string & sOutputUtf8 );
 
+/** Same as RepairUTF8, writing exactly end - begin bytes to pchOut. pchOut may be begin to repair in place. */
+bool RepairUTF8( const char *begin, const char *end, char *pchOut );
+
 /** Trims trailing CR, LF, Tab, and Space characters */
 std::string TrimTrailingWhitespace( const std::string& in );
 
@@ -136,6 +148,26 @@ void V_URLEncodeNoPlusForSpace( char *pchDest, int nDestLen, const char *pchSour
 /** Same as V_URLEncodeNoPlusForSpace, but without escaping / and : */
 void V_URLEncodeFullPath( char *pchDest, int nDestLen, const char *pchSource, int nSourceLen );
 
+/** std::string versions of the encoders above, which size the result exactly */
+std::string V_URLEncode( const std::string &sSource );
+std::string V_URLEncodeNoPlusForSpace( const std::string &sSource );
+std::string V_URLEncodeFullPath( const std::string &sSource );
+
+/** Selects which of the encoders above the length and append helpers below match */
+enum EURLEncodeMode
+{
+	k_EURLEncodeMode_Form = 0,		// V_URLEncode
+	k_EURLEncodeMode_Component,		// V_URLEncodeNoPlusForSpace
+	k_EURLEncodeMode_FullPath,		// V_URLEncodeFullPath
+	k_EURLEncodeMode_Count,
+};
+
+/** Returns the exact length of the encoded source, not counting a terminator */
+size_t V_URLEncodedLength( const char *pchSource, size_t unSourceLen, EURLEncodeMode eMode );
+
+/** Appends the encoded source to sDest. Encoding is stateless, so a large payload can be encoded chunk by chunk. */
+void V_URLEncodeAppend( std::string &sDest, const char *pchSource, size_t unSourceLen, EURLEncodeMode eMode );
+
 
 //-----------------------------------------------------------------------------
 // Purpose: Decodes a string (or binary data) from URL encoding format, see rfc1738 section 2.2.  
@@ -150,6 +182,33 @@ size_t V_URLDecode( char *pchDecodeDest, int nDecodeDestLen, const char *pchEnco
 /** Same as V_URLDecode, but without plus for space. */
 size_t V_URLDecodeNoPlusForSpace( char *pchDecodeDest, int nDecodeDestLen, const char *pchEncodedSource, int nEncodedSourceLen );
 
+/** std::string versions of the decoders above */
+std::string V_URLDecode( const std::string &sSource );
+std::string V_URLDecodeNoPlusForSpace( const std::string &sSource );
+
+//-----------------------------------------------------------------------------
+// Purpose: Decodes a URL encoded payload that arrives in chunks. Produces the
+//			same output as V_URLDecode on the whole payload; an escape split
+//			across chunks is held until the rest of it arrives, and one left
+//			incomplete at the end of the payload is dropped.
+//-----------------------------------------------------------------------------
+class CURLDecodeStream
+{
+public:
+	explicit CURLDecodeStream( bool bUsePlusForSpace = true );
+
+	/** Decodes the next chunk and appends the result to sDecoded */
+	void Append( const char *pchEncoded, size_t unEncodedLen, std::string &sDecoded );
+
+	/** Discards any held back partial escape so the stream can be reused */
+	void Reset();
+
+private:
+	bool m_bUsePlusForSpace;
+	char m_rchPending[ 3 ];
+	size_t m_unPending;
+};
+
 //-----------------------------------------------------------------------------
 // Purpose: strip extension from a path
 //-----------------------------------------------------------------------------
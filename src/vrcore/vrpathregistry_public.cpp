@@ -2,6 +2,8 @@
 
 #include <vrcore/vrpathregistry_public.h>
 #include <json/json.h>
+#include <json/json_buffered_writer.h>
+#include <json/json_flat.h>
 #include <vrcore/pathtools_public.h>
 #include <vrcore/envvartools_public.h>
 #include <vrcore/strtools_public.h>
@@ -21,7 +23,7 @@
 #endif
 
 #include <algorithm>
-#include <sstream>
+#include <mutex>
 
 #ifndef VRLog
 	#if defined( __MINGW32__ )
@@ -74,22 +76,23 @@ static std::string GetAppSettingsPath()
 	// As defined by XDG Base Directory Specification 
 	// https://specifications.freedesktop.org/basedir-spec/basedir-spec-latest.html
 
-	const char *pchHome = getenv("XDG_CONFIG_HOME");
-	if ( ( pchHome != NULL) && ( pchHome[0] != '\0' ) )
+	CEnvironmentSnapshotPin env;
+	EnvVarRef_t configHome = env->GetVariable( "XDG_CONFIG_HOME" );
+	if ( !configHome.empty() )
 	{
-		return pchHome;
+		return configHome.ToString();
 	}
 
 	//
 	// XDG_CONFIG_HOME is not defined, use ~/.config instead
 	// 
-	pchHome = getenv( "HOME" );
-	if ( pchHome == NULL )
+	EnvVarRef_t home = env->GetVariable( "HOME" );
+	if ( !home.bSet )
 	{
 		return "";
 	}
 
-	std::string sUserPath( pchHome );
+	std::string sUserPath( home.ToString() );
 	sUserPath = Path_Join( sUserPath, ".config" );
 	return sUserPath;
 #else
@@ -156,12 +159,12 @@ std::string CVRPathRegistry_Public::GetVRPathRegistryFilename()
 // ---------------------------------------------------------------------------
 // Purpose: Converts JSON to a history array
 // ---------------------------------------------------------------------------
-static void ParseStringListFromJson( std::vector< std::string > *pvecHistory, const Json::Value & root, const char *pchArrayName )
+static void ParseStringListFromJson( std::vector< std::string > *pvecHistory, const Json::FlatValue & root, const char *pchArrayName )
 {
 	if( !root.isMember( pchArrayName ) )
 		return;
 
-	const Json::Value & arrayNode = root[ pchArrayName ];
+	const Json::FlatValue & arrayNode = root[ pchArrayName ];
 	if( !arrayNode )
 	{
 		VRLog( "VR Path Registry node %s is not an array\n", pchArrayName );
@@ -215,7 +218,15 @@ bool CVRPathRegistry_Public::ToJsonString( std::string &sJsonString )
 // ---------------------------------------------------------------------------
 bool CVRPathRegistry_Public::BLoadFromFile( std::string *psLoadError )
 {
-	std::string sRegPath = GetVRPathRegistryFilename();
+	return BLoadFromPath( GetVRPathRegistryFilename(), psLoadError );
+}
+
+
+// ---------------------------------------------------------------------------
+// Purpose: Loads the config file from the specified path
+// ---------------------------------------------------------------------------
+bool CVRPathRegistry_Public::BLoadFromPath( const std::string & sRegPath, std::string *psLoadError )
+{
 	if( sRegPath.empty() )
 	{
 		if ( psLoadError )
@@ -225,6 +236,9 @@ bool CVRPathRegistry_Public::BLoadFromFile( std::string *psLoadError )
 		return false;
 	}
 
+	// Read into a buffer rather than mapping: other processes rewrite the registry, and a file
+	// truncated under a mapping faults the reader on POSIX while an open view blocks writers on
+	// Windows. Path_ReadTextFile also strips the UTF8 BOM and turns CRLF into LF.
 	std::string sRegistryContents = Path_ReadTextFile( sRegPath );
 	if( sRegistryContents.empty() )
 	{
@@ -235,13 +249,15 @@ bool CVRPathRegistry_Public::BLoadFromFile( std::string *psLoadError )
 		return false;
 	}
 
-	Json::Value root;
-	Json::CharReaderBuilder builder;
-	std::istringstream istream( sRegistryContents );
+	const char *pchBegin = sRegistryContents.data();
+	const char *pchEnd = pchBegin + sRegistryContents.size();
+
+	// the registry is only read here, so parse into a single arena rather than a Json::Value tree
+	Json::FlatDocument doc;
 	std::string sErrors;
 
 	try {
-		if ( !parseFromStream( builder, istream, &root, &sErrors ) )
+		if ( !doc.parse( pchBegin, pchEnd, &sErrors ) )
 		{
 			if ( psLoadError )
 			{
@@ -250,6 +266,7 @@ bool CVRPathRegistry_Public::BLoadFromFile( std::string *psLoadError )
 			return false;
 		}
 
+		const Json::FlatValue & root = doc.root();
 		ParseStringListFromJson( &m_vecRuntimePath, root, "runtime" );
 		ParseStringListFromJson( &m_vecConfigPath, root, "config" );
 		ParseStringListFromJson( &m_vecLogPath, root, "log" );
@@ -290,8 +307,10 @@ bool CVRPathRegistry_Public::BSaveToFile() const
 	StringListToJson( m_vecLogPath, root, "log" );
 	StringListToJson( m_vecExternalDrivers, root, "external_drivers" );
 
+	// same bytes as Json::writeString( builder, root ), without the stringstream
 	Json::StreamWriterBuilder builder;
-	std::string sRegistryContents = Json::writeString( builder, root );
+	Json::BufferedWriter writer( builder );
+	const std::string & sRegistryContents = writer.write( root );
 
 	// make sure the directory we're writing into actually exists
 	std::string sRegDirectory = Path_StripFilename( sRegPath );
@@ -301,9 +320,17 @@ bool CVRPathRegistry_Public::BSaveToFile() const
 		return false;
 	}
 
-	if( !Path_WriteStringToTextFile( sRegPath, sRegistryContents.c_str() ) )
+	// replace the file in one step so a crash mid-save can't leave a truncated registry behind
+	CPathAtomicWriteBatch batch;
+	batch.AddTextFile( sRegPath, sRegistryContents );
+	bool bWritten = batch.Commit();
+
+	// don't rely on the file stamp changing for a rewrite in the same tick
+	InvalidateCachedPaths();
+
+	if( !bWritten )
 	{
-		VRLog( "Unable to write VR path registry to %s\n", sRegPath.c_str() );
+		VRLog( "Unable to write VR path registry to %s: %s\n", sRegPath.c_str(), batch.GetFileError( 0 ).c_str() );
 		return false;
 	}
 
@@ -348,77 +375,139 @@ std::string CVRPathRegistry_Public::GetLogPath() const
 
 
 
+// ---------------------------------------------------------------------------
+// Purpose: The most recently parsed path registry. GetPaths is called on every
+//			VR_Init and VR_IsHmdPresent, so the file is only parsed again when
+//			its name or its stamp on disk changes.
+// ---------------------------------------------------------------------------
+struct CachedPathRegistry_t
+{
+	bool bValid = false;
+	std::string sRegPath;
+	PathFileStamp_t stamp = {};
+	bool bLoaded = false;
+	std::string sLoadError;
+	CVRPathRegistry_Public pathReg;
+};
+
+static std::mutex g_mutexCachedPathRegistry;
+static CachedPathRegistry_t g_cachedPathRegistry;
+
+void CVRPathRegistry_Public::InvalidateCachedPaths()
+{
+	std::lock_guard<std::mutex> lock( g_mutexCachedPathRegistry );
+	g_cachedPathRegistry.bValid = false;
+}
+
+
 // ---------------------------------------------------------------------------
 // Purpose: Returns paths using the path registry and the provided override 
 //			values. Pass NULL for any paths you don't care about.
 // ---------------------------------------------------------------------------
 bool CVRPathRegistry_Public::GetPaths( std::string *psRuntimePath, std::string *psConfigPath, std::string *psLogPath, const char *pchConfigPathOverride, const char *pchLogPathOverride, std::vector<std::string> *pvecExternalDrivers )
 {
-	std::string sLoadError;
-	CVRPathRegistry_Public pathReg;
-	bool bLoadedRegistry = pathReg.BLoadFromFile( &sLoadError );
 	int nCountEnvironmentVariables = 0;
 	int nRequestedPaths = 0;
 
-	if( psRuntimePath )
+	// pick up overrides the application set with setenv since the last call
+	RefreshEnvironmentSnapshot();
+
+	// read each override once
+	std::string sRuntimeOverride = psRuntimePath ? GetEnvironmentVariable( k_pchRuntimeOverrideVar ) : std::string();
+	std::string sConfigOverride = psConfigPath ? GetEnvironmentVariable( k_pchConfigOverrideVar ) : std::string();
+	std::string sLogOverride = psLogPath ? GetEnvironmentVariable( k_pchLogOverrideVar ) : std::string();
+
+	if ( psRuntimePath )
 	{
 		nRequestedPaths++;
-		if ( GetEnvironmentVariable( k_pchRuntimeOverrideVar ).length() != 0 )
-		{
-			*psRuntimePath = GetEnvironmentVariable( k_pchRuntimeOverrideVar );
+		if ( !sRuntimeOverride.empty() )
+			nCountEnvironmentVariables++;
+	}
+	if ( psConfigPath )
+	{
+		nRequestedPaths++;
+		if ( !sConfigOverride.empty() )
 			nCountEnvironmentVariables++;
+	}
+	if ( psLogPath )
+	{
+		nRequestedPaths++;
+		if ( !sLogOverride.empty() )
+			nCountEnvironmentVariables++;
+	}
+
+	std::string sLoadError;
+	CVRPathRegistry_Public pathReg;
+	bool bLoadedRegistry = false;
+
+	// the physical file is only needed if something isn't coming from the environment
+	bool bNeedRegistry = nCountEnvironmentVariables != nRequestedPaths || pvecExternalDrivers != NULL;
+	if ( bNeedRegistry )
+	{
+		std::string sRegPath = GetVRPathRegistryFilename();
+
+		// stat before reading so a change made while we read is picked up next time
+		PathFileStamp_t stamp;
+		Path_GetFileStamp( sRegPath, &stamp );
+
+		std::lock_guard<std::mutex> lock( g_mutexCachedPathRegistry );
+		CachedPathRegistry_t & cache = g_cachedPathRegistry;
+		if ( !cache.bValid || cache.sRegPath != sRegPath || cache.stamp != stamp )
+		{
+			cache.pathReg = CVRPathRegistry_Public();
+			cache.sLoadError.clear();
+			cache.bLoaded = cache.pathReg.BLoadFromPath( sRegPath, &cache.sLoadError );
+			cache.sRegPath = sRegPath;
+			cache.stamp = stamp;
+			cache.bValid = true;
 		}
-		else if( !pathReg.GetRuntimePath().empty() )
+
+		pathReg = cache.pathReg;
+		bLoadedRegistry = cache.bLoaded;
+		sLoadError = cache.sLoadError;
+	}
+
+	if( psRuntimePath )
+	{
+		if ( !sRuntimeOverride.empty() )
 		{
-			*psRuntimePath = pathReg.GetRuntimePath();
+			*psRuntimePath = sRuntimeOverride;
 		}
 		else
 		{
-			*psRuntimePath = "";
+			*psRuntimePath = pathReg.GetRuntimePath();
 		}
 	}
 
 	if( psConfigPath )
 	{
-		nRequestedPaths++;
-		if ( GetEnvironmentVariable( k_pchConfigOverrideVar ).length() != 0 )
+		if ( !sConfigOverride.empty() )
 		{
-			*psConfigPath = GetEnvironmentVariable( k_pchConfigOverrideVar );
-			nCountEnvironmentVariables++;
+			*psConfigPath = sConfigOverride;
 		}
 		else if( pchConfigPathOverride )
 		{
 			*psConfigPath = pchConfigPathOverride;
 		}
-		else if( !pathReg.GetConfigPath().empty() )
-		{
-			*psConfigPath = pathReg.GetConfigPath();
-		}
 		else
 		{
-			*psConfigPath = "";
+			*psConfigPath = pathReg.GetConfigPath();
 		}
 	}
 
 	if( psLogPath )
 	{
-		nRequestedPaths++;
-		if ( GetEnvironmentVariable( k_pchLogOverrideVar ).length() != 0 )
+		if ( !sLogOverride.empty() )
 		{
-			*psLogPath = GetEnvironmentVariable( k_pchLogOverrideVar );
-			nCountEnvironmentVariables++;
+			*psLogPath = sLogOverride;
 		}
 		else if( pchLogPathOverride )
 		{
 			*psLogPath = pchLogPathOverride;
 		}
-		else if( !pathReg.GetLogPath().empty() )
-		{
-			*psLogPath = pathReg.GetLogPath();
-		}
 		else
 		{
-			*psLogPath = "";
+			*psLogPath = pathReg.GetLogPath();
 		}
 	}
 
@@ -485,6 +574,6 @@ uint32_t CVRPathRegistry_Public::InitSteamAppId()
 //-----------------------------------------------------------------------------
 bool CVRPathRegistry_Public::IsChildOfVRServer()
 {
-	std::string app_key = GetEnvironmentVariable( "STEAMVR_APPKEY" );
-	return app_key == "openvr.component.vrserver";
+	CEnvironmentSnapshotPin env;
+	return env->GetVariable( "STEAMVR_APPKEY" ) == "openvr.component.vrserver";
 }
\ No newline at end of file
@@ -32,6 +32,9 @@ public:
 	bool BLoadFromFile( std::string *psError = nullptr );
 	bool BSaveToFile() const;
 
+	/** Forces the next GetPaths call to read the path registry from disk again */
+	static void InvalidateCachedPaths();
+
 	bool ToJsonString( std::string &sJsonString );
 
 	// methods to get the current values
@@ -42,6 +45,8 @@ public:
 protected:
 	typedef std::vector< std::string > StringVector_t;
 
+	bool BLoadFromPath( const std::string & sRegPath, std::string *psError );
+
 	// index 0 is the current setting
 	StringVector_t m_vecRuntimePath;
 	StringVector_t m_vecLogPath;
@@ -0,0 +1,206 @@
+//========= Copyright Valve Corporation ============//
+// CPathAtomicWriteBatch under injected failures (a missing directory fails staging, a
+// directory in the way fails the rename), through symlinks, and with restrictive
+// permissions; plus N-file saves against one Path_WriteStringToTextFileAtomic per file.
+#include "stub_runtime.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+static std::string ReadFile( const std::string &sFilename )
+{
+	std::vector< uint8_t > vecData = Path_ReadBinaryFile( sFilename );
+	return std::string( vecData.begin(), vecData.end() );
+}
+
+static bool BIsSymlink( const std::string &sFilename )
+{
+	struct stat st;
+	return lstat( sFilename.c_str(), &st ) == 0 && S_ISLNK( st.st_mode );
+}
+
+static unsigned GetMode( const std::string &sFilename )
+{
+	struct stat st;
+	return stat( sFilename.c_str(), &st ) == 0 ? ( st.st_mode & 07777 ) : 0;
+}
+
+static bool BHasTempFiles( const std::string &sDirectory )
+{
+	bool bFound = false;
+	DIR *pDir = opendir( sDirectory.c_str() );
+	while ( struct dirent *pEntry = pDir ? readdir( pDir ) : nullptr )
+	{
+		std::string sName = pEntry->d_name;
+		if ( sName.size() > 4 && sName.compare( sName.size() - 4, 4, ".tmp" ) == 0 )
+			bFound = true;
+	}
+	if ( pDir )
+		closedir( pDir );
+	return bFound;
+}
+
+static void TestFaults( const CTestTempDir &tempDir )
+{
+	std::string sA = tempDir.Path( "a.json" ), sB = tempDir.Path( "b.json" ), sC = tempDir.Path( "c.json" );
+	TEST_CHECK( Path_WriteStringToTextFile( sA, "old a" ) );
+	TEST_CHECK( Path_WriteStringToTextFile( sC, "old c" ) );
+
+	// everything succeeds
+	{
+		CPathAtomicWriteBatch batch( false );
+		batch.AddFile( sA, "new a" );
+		batch.AddFile( sB, "new b" );
+		batch.AddFile( sC, "new c" );
+		TEST_CHECK( batch.Commit() );
+		TEST_CHECK( ReadFile( sA ) == "new a" && ReadFile( sB ) == "new b" && ReadFile( sC ) == "new c" );
+		for ( uint32_t i = 0; i < batch.GetFileCount(); i++ )
+			TEST_CHECK( batch.BFileSucceeded( i ) && batch.GetFileError( i ).empty() );
+	}
+
+	// one file can't be staged, so nothing is replaced
+	{
+		CPathAtomicWriteBatch batch( false );
+		batch.AddFile( sA, "newer a" );
+		batch.AddFile( tempDir.Path( "missing/b.json" ), "newer b" );
+		batch.AddFile( sC, "newer c" );
+		TEST_CHECK( !batch.Commit() );
+		TEST_CHECK( ReadFile( sA ) == "new a" && ReadFile( sC ) == "new c" );
+		TEST_CHECK( !batch.BFileSucceeded( 0 ) && !batch.BFileSucceeded( 1 ) && !batch.BFileSucceeded( 2 ) );
+		TEST_CHECK( batch.GetFileError( 1 ).find( "Unable to create" ) == 0 );
+		TEST_CHECK( batch.GetFileError( 0 ).find( "Not written because" ) == 0 );
+		TEST_CHECK( batch.GetFileError( 2 ).find( "Not written because" ) == 0 );
+		TEST_CHECK( !BHasTempFiles( tempDir.Path() ) );
+	}
+
+	// one rename fails, the others still land and each result is reported
+	{
+		std::string sDir = tempDir.Path( "in_the_way" );
+		TEST_CHECK( BCreateDirectoryRecursive( ( sDir + "/child" ).c_str() ) );
+
+		CPathAtomicWriteBatch batch( false );
+		batch.AddFile( sA, "newest a" );
+		batch.AddFile( sDir, "can't replace a directory" );
+		batch.AddFile( sC, "newest c" );
+		TEST_CHECK( !batch.Commit() );
+		TEST_CHECK( batch.BFileSucceeded( 0 ) && !batch.BFileSucceeded( 1 ) && batch.BFileSucceeded( 2 ) );
+		TEST_CHECK( batch.GetFileError( 1 ).find( "Unable to replace" ) == 0 );
+		TEST_CHECK( ReadFile( sA ) == "newest a" && ReadFile( sC ) == "newest c" );
+		TEST_CHECK( Path_IsDirectory( sDir ) );
+		TEST_CHECK( !BHasTempFiles( tempDir.Path() ) );
+	}
+
+	// a batch that is never committed leaves nothing behind
+	{
+		CPathAtomicWriteBatch batch( false );
+		batch.AddFile( sA, "never written" );
+	}
+	TEST_CHECK( ReadFile( sA ) == "newest a" );
+}
+
+static void TestPreservation( const CTestTempDir &tempDir )
+{
+	std::string sTargetDir = tempDir.Path( "real" );
+	std::string sLinkDir = tempDir.Path( "links" );
+	TEST_CHECK( BCreateDirectoryRecursive( sTargetDir.c_str() ) );
+	TEST_CHECK( BCreateDirectoryRecursive( sLinkDir.c_str() ) );
+
+	// relative and absolute links, and a link to a link
+	std::string sTarget = sTargetDir + "/settings.json";
+	TEST_CHECK( Path_WriteStringToTextFile( sTarget, "old" ) );
+	TEST_CHECK( symlink( "../real/settings.json", ( sLinkDir + "/relative.json" ).c_str() ) == 0 );
+	TEST_CHECK( symlink( ( sLinkDir + "/relative.json" ).c_str(), ( sLinkDir + "/chained.json" ).c_str() ) == 0 );
+	{
+		CPathAtomicWriteBatch batch( false );
+		batch.AddFile( sLinkDir + "/chained.json", "through two links" );
+		TEST_CHECK( batch.Commit() );
+	}
+	TEST_CHECK( BIsSymlink( sLinkDir + "/chained.json" ) && BIsSymlink( sLinkDir + "/relative.json" ) );
+	TEST_CHECK( ReadFile( sTarget ) == "through two links" );
+	TEST_CHECK( !BHasTempFiles( sLinkDir ) && !BHasTempFiles( sTargetDir ) );
+
+	// a dangling link gets its target created
+	TEST_CHECK( symlink( ( sTargetDir + "/new.json" ).c_str(), ( sLinkDir + "/dangling.json" ).c_str() ) == 0 );
+	{
+		CPathAtomicWriteBatch batch( false );
+		batch.AddFile( sLinkDir + "/dangling.json", "created" );
+		TEST_CHECK( batch.Commit() );
+	}
+	TEST_CHECK( BIsSymlink( sLinkDir + "/dangling.json" ) );
+	TEST_CHECK( ReadFile( sTargetDir + "/new.json" ) == "created" );
+
+	// permissions survive the replace
+	TEST_CHECK( chmod( sTarget.c_str(), 0600 ) == 0 );
+	TEST_CHECK( chmod( ( sTargetDir + "/new.json" ).c_str(), 0644 ) == 0 );
+	{
+		CPathAtomicWriteBatch batch( false );
+		batch.AddFile( sTarget, "private" );
+		batch.AddTextFile( sLinkDir + "/dangling.json", "public\n" );
+		TEST_CHECK( batch.Commit() );
+	}
+	TEST_CHECK_EQUAL( GetMode( sTarget ), 0600 );
+	TEST_CHECK_EQUAL( GetMode( sTargetDir + "/new.json" ), 0644 );
+	TEST_CHECK( ReadFile( sTargetDir + "/new.json" ) == "public\n" );
+
+	// and a symlinked path registry stays a symlink when it's saved
+	std::string sRegistryTarget = sTargetDir + "/openvrpaths.vrpath";
+	std::string sRegistryLink = sLinkDir + "/openvrpaths.vrpath";
+	TEST_CHECK( StubRuntime_WriteRegistry( sRegistryTarget, tempDir.Path( "runtime" ) ) );
+	TEST_CHECK( chmod( sRegistryTarget.c_str(), 0640 ) == 0 );
+	TEST_CHECK( symlink( sRegistryTarget.c_str(), sRegistryLink.c_str() ) == 0 );
+	SetEnvironmentVariable( "VR_PATHREG_OVERRIDE", sRegistryLink.c_str() );
+
+	CVRPathRegistry_Public pathReg;
+	TEST_CHECK( pathReg.BLoadFromFile() );
+	TEST_CHECK( pathReg.BSaveToFile() );
+	TEST_CHECK( BIsSymlink( sRegistryLink ) );
+	TEST_CHECK_EQUAL( GetMode( sRegistryTarget ), 0640 );
+	TEST_CHECK( pathReg.GetRuntimePath() == tempDir.Path( "runtime" ) );
+}
+
+static void BenchmarkSaves( const CTestTempDir &tempDir )
+{
+	const int k_nFiles = 16;
+	int nRounds = BenchFull() ? 50 : 2;
+	std::string sDir = tempDir.Path( "bench" );
+	TEST_CHECK( BCreateDirectoryRecursive( sDir.c_str() ) );
+
+	std::string sContents( 2048, 'x' );
+	std::vector< std::string > vecFilenames;
+	for ( int i = 0; i < k_nFiles; i++ )
+		vecFilenames.push_back( sDir + "/file" + std::to_string( i ) + ".vrsettings" );
+
+	auto start = std::chrono::steady_clock::now();
+	for ( int nRound = 0; nRound < nRounds; nRound++ )
+	{
+		for ( const std::string & sFilename : vecFilenames )
+			TEST_CHECK( Path_WriteStringToTextFileAtomic( sFilename, sContents.c_str() ) );
+	}
+	double flPerFile = BenchSecondsSince( start ) * 1000.0 / nRounds;
+
+	double rflBatch[ 2 ];
+	for ( int nDurable = 0; nDurable < 2; nDurable++ )
+	{
+		start = std::chrono::steady_clock::now();
+		for ( int nRound = 0; nRound < nRounds; nRound++ )
+		{
+			CPathAtomicWriteBatch batch( nDurable != 0 );
+			for ( const std::string & sFilename : vecFilenames )
+				batch.AddFile( sFilename, sContents );
+			TEST_CHECK( batch.Commit() );
+		}
+		rflBatch[ nDurable ] = BenchSecondsSince( start ) * 1000.0 / nRounds;
+	}
+
+	printf( "%d-file save: Path_WriteStringToTextFileAtomic %.2f ms (no flush), batch %.2f ms (no flush), batch %.2f ms (durable)\n",
+		k_nFiles, flPerFile, rflBatch[ 0 ], rflBatch[ 1 ] );
+}
+
+int main()
+{
+	CTestTempDir tempDir;
+	TestFaults( tempDir );
+	TestPreservation( tempDir );
+	BenchmarkSaves( tempDir );
+	return TestResult( "atomic_write_batch_test" );
+}
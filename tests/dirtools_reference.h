@@ -0,0 +1,321 @@
+//========= Copyright Valve Corporation ============//
+#pragma once
+
+// The POSIX CDirIterator as it was before it moved to opendir/readdir: the _findfirst/_findnext
+// emulation from filesystem/linux_support, which scandirs the whole directory and stats every
+// matching entry as it's reached. Kept as it was, apart from the names and logging through
+// stderr, so dirtools_test can time both on the same tree.
+
+#include <vrcore/pathtools_public.h>
+#include <vrcore/platform.h>
+
+#include <ctype.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+namespace DirReference
+{
+
+#ifndef MAX_PATH
+#define MAX_PATH PATH_MAX
+#endif
+
+#define _A_SUBDIR S_IFDIR
+
+struct _finddata_t
+{
+	_finddata_t() : attrib( 0 ), time_create( 0 ), time_write( 0 ), size( 0 ), namelist( NULL ), numNames( 0 ), curName( 0 )
+	{
+		name[ 0 ] = 0;
+		dirBase[ 0 ] = 0;
+	}
+	unsigned attrib;
+	int64_t time_create;
+	int64_t time_write;
+	int64_t size;
+	char name[ 260 ];
+	direntBig_t **namelist;
+	int numNames;
+	int curName;
+	char dirBase[ MAX_PATH ];
+};
+
+static char selectBuf[ PATH_MAX ];
+
+inline int FileSelect( const char *name, const char *mask )
+{
+	if ( !strcmp( name, "." ) || !strcmp( name, ".." ) )
+		return 0;
+
+	if ( !strcmp( mask, "*.*" ) || !strcmp( mask, "*" ) )
+		return 1;
+
+	while ( *mask && *name )
+	{
+		if ( *mask == '*' )
+		{
+			mask++;		  // move to the next char in the mask
+			if ( !*mask ) // if this is the end of the mask its a match
+			{
+				return 1;
+			}
+			while ( *name && toupper( *name ) != toupper( *mask ) )
+			{ // while the two don't meet up again
+				name++;
+			}
+			if ( !*name )
+			{ // end of the name
+				break;
+			}
+		}
+		else if ( *mask != '?' )
+		{
+			if ( toupper( *mask ) != toupper( *name ) )
+			{ // mismatched!
+				return 0;
+			}
+			else
+			{
+				mask++;
+				name++;
+				if ( !*mask && !*name )
+				{ // if its at the end of the buffer
+					return 1;
+				}
+			}
+		}
+		else /* mask is "?", we don't care*/
+		{
+			mask++;
+			name++;
+		}
+	}
+
+	return ( !*mask && !*name ); // both of the strings are at the end
+}
+
+inline int FileSelect( const direntBig_t *ent )
+{
+	const char *mask = selectBuf;
+	const char *name = ent->d_name;
+
+	return FileSelect( name, mask );
+}
+
+inline int FillDataStruct( _finddata_t *dat )
+{
+	statBig_t fileStat;
+
+	if ( dat->curName >= dat->numNames )
+		return -1;
+
+	strncpy( dat->name, dat->namelist[ dat->curName ]->d_name, sizeof( dat->name ) );
+	char szFullPath[ MAX_PATH ];
+	int nWriteSize = snprintf( szFullPath, sizeof( szFullPath ), "%s%c%s", dat->dirBase, Path_GetSlash(), dat->name );
+	if ( nWriteSize >= (int)sizeof( szFullPath ) )
+	{
+		fprintf( stderr, "File path truncated\n" );
+	}
+	if ( statBig( szFullPath, &fileStat ) == 0 )
+	{
+		dat->attrib = fileStat.st_mode;
+		dat->size = fileStat.st_size;
+		dat->time_write = fileStat.st_mtime;
+		dat->time_create = fileStat.st_ctime;
+	}
+	else
+	{
+		dat->attrib = 0;
+		dat->size = 0;
+		dat->time_write = 0;
+		dat->time_create = 0;
+	}
+	free( dat->namelist[ dat->curName ] );
+	dat->namelist[ dat->curName ] = NULL;
+	dat->curName++;
+	return 1;
+}
+
+inline int _findfirst( const char *fileName, _finddata_t *dat )
+{
+	char nameStore[ MAX_PATH ];
+	char *dir = NULL;
+	int n, iret = -1;
+
+	strncpy( nameStore, fileName, sizeof( nameStore ) );
+
+	if ( strrchr( nameStore, '/' ) )
+	{
+		dir = nameStore;
+		while ( strrchr( dir, '/' ) )
+		{
+			statBig_t dirChk;
+
+			// zero this with the dir name
+			dir = strrchr( nameStore, '/' );
+			*dir = '\0';
+			if ( dir == nameStore )
+			{
+				strcpy( nameStore, "/" );
+			}
+			else
+			{
+				dir = nameStore;
+			}
+
+			if ( statBig( dir, &dirChk ) == 0 && S_ISDIR( dirChk.st_mode ) )
+			{
+				break;
+			}
+		}
+	}
+	else
+	{
+		// couldn't find a dir separator...
+		return -1;
+	}
+
+	if ( strlen( dir ) > 0 )
+	{
+		if ( strlen( dir ) == 1 )
+			strncpy( selectBuf, fileName + 1, sizeof( selectBuf ) );
+		else
+			strncpy( selectBuf, fileName + strlen( dir ) + 1, sizeof( selectBuf ) );
+
+		n = scandirBig( dir, &dat->namelist, FileSelect, alphasortBig );
+		if ( n < 0 )
+		{
+			// silently return, nothing interesting
+		}
+		else
+		{
+			dat->curName = 0;
+			dat->numNames = n; // n is the number of matches
+			strncpy( dat->dirBase, dir, sizeof( dat->dirBase ) );
+			iret = FillDataStruct( dat );
+			if ( iret < 0 )
+			{
+				free( dat->namelist );
+				dat->namelist = NULL;
+				dat->curName = 0;
+				dat->numNames = 0;
+			}
+		}
+	}
+
+	return iret;
+}
+
+inline int _findnext( int64_t handle, _finddata_t *dat )
+{
+	if ( dat->curName >= dat->numNames )
+	{
+		free( dat->namelist );
+		dat->namelist = NULL;
+		dat->curName = 0;
+		dat->numNames = 0;
+		return -1; // no matches left
+	}
+
+	FillDataStruct( dat );
+	return 0;
+}
+
+inline bool _findclose( int64_t handle )
+{
+	return true;
+}
+
+// The POSIX half of the old CDirIterator
+class CDirIterator
+{
+public:
+	CDirIterator( const char *pchPath, const char *pchPattern )
+	{
+		m_pFindData = new _finddata_t;
+		std::string sPathAndPattern = Path_Join( pchPath, pchPattern );
+		m_hFind = _findfirst( sPathAndPattern.c_str(), m_pFindData );
+		if ( m_hFind == -1 )
+		{
+			m_bNoFiles = true;
+			m_bUsedFirstFile = true;
+		}
+		else
+		{
+			m_bNoFiles = false;
+			m_bUsedFirstFile = !BValidFilename();
+		}
+	}
+
+	~CDirIterator()
+	{
+		if ( m_hFind != -1 )
+		{
+			_findclose( m_hFind );
+		}
+		for ( int i = 0; i < m_pFindData->numNames; i++ )
+		{
+			// scandir allocates with malloc, so free with free
+			free( m_pFindData->namelist[ i ] );
+		}
+		free( m_pFindData->namelist );
+		delete m_pFindData;
+	}
+
+	bool BNextFile()
+	{
+		if ( m_bNoFiles )
+			return false;
+
+		// use the first result
+		if ( !m_bUsedFirstFile )
+		{
+			m_bUsedFirstFile = true;
+			return true;
+		}
+
+		// find the next item
+		for ( ;; )
+		{
+			bool bFound = ( _findnext( m_hFind, m_pFindData ) == 0 );
+			if ( !bFound )
+			{
+				// done
+				m_bNoFiles = true;
+				return false;
+			}
+
+			// skip over the '.' and '..' paths
+			if ( !BValidFilename() )
+				continue;
+
+			break;
+		}
+
+		// have one more file
+		return true;
+	}
+
+	std::string CurrentFileName() { return m_pFindData->name; }
+	int64_t CurrentFileLength() const { return ( int64_t )m_pFindData->size; }
+	int64_t CurrentFileWriteTime() const { return m_pFindData->time_write; }
+	bool BCurrentIsDir() const { return ( m_pFindData->attrib & _A_SUBDIR ? true : false ); }
+
+private:
+	bool BValidFilename()
+	{
+		const char *pch = m_pFindData->name;
+		if ( ( pch[ 0 ] == '.' && pch[ 1 ] == 0 ) || ( pch[ 0 ] == '.' && pch[ 1 ] == '.' && pch[ 2 ] == 0 ) )
+			return false;
+		return true;
+	}
+
+	bool m_bNoFiles, m_bUsedFirstFile;
+	int64_t m_hFind;
+	_finddata_t *m_pFindData;
+};
+
+} // namespace DirReference
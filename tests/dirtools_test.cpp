@@ -0,0 +1,221 @@
+//========= Copyright Valve Corporation ============//
+// CDirIterator is only built when the platform layer is available, so this test compiles
+// dirtools without VRCORE_NO_PLATFORM against the stand-ins in platform_shim/. Checks flat
+// and recursive listings against readdir, the lazily stat'ed accessors, and symlinked
+// directories; then times walks of the same tree with and without file sizes, against the
+// _findfirst emulation it replaced.
+#include <vrcore/dirtools_public.h>
+#include <vrcore/pathtools_public.h>
+#include "dirtools_reference.h"
+#include "test_common.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <set>
+#include <vector>
+
+static void WriteFile( const std::string &sFilename, const std::string &sContents )
+{
+	TEST_CHECK( Path_WriteStringToTextFile( sFilename, sContents.c_str() ) );
+}
+
+static std::vector< std::string > ListFlat( const std::string &sDir, const char *pchPattern )
+{
+	std::vector< std::string > vecNames;
+	CDirIterator iter( sDir.c_str(), pchPattern );
+	while ( iter.BNextFile() )
+		vecNames.push_back( iter.CurrentFileName() );
+	return vecNames;
+}
+
+static void TestFlat( const CTestTempDir &tempDir )
+{
+	std::string sDir = tempDir.Path( "flat" );
+	TEST_CHECK( BCreateDirectoryRecursive( sDir.c_str() ) );
+	WriteFile( sDir + "/b.json", "bb" );
+	WriteFile( sDir + "/A.JSON", "a" );
+	WriteFile( sDir + "/c.txt", "ccc" );
+	WriteFile( sDir + "/.hidden.json", "" );
+	TEST_CHECK( BCreateDirectoryRecursive( ( sDir + "/sub.json" ).c_str() ) );
+
+	// sorted like readdir + strcoll, . and .. never reported, and the mask is case-insensitive.
+	// A * stops at the first match of the character after it, as the old findfirst emulation
+	// did, so *.json doesn't match .hidden.json.
+	std::vector< std::string > vecAll = ListFlat( sDir, "*" );
+	std::vector< std::string > vecExpected;
+	DIR *pDir = opendir( sDir.c_str() );
+	while ( struct dirent *pEntry = pDir ? readdir( pDir ) : nullptr )
+	{
+		if ( strcmp( pEntry->d_name, "." ) && strcmp( pEntry->d_name, ".." ) )
+			vecExpected.push_back( pEntry->d_name );
+	}
+	if ( pDir )
+		closedir( pDir );
+	std::sort( vecExpected.begin(), vecExpected.end(), []( const std::string &a, const std::string &b ) { return strcoll( a.c_str(), b.c_str() ) < 0; } );
+	TEST_CHECK( vecAll == vecExpected );
+	TEST_CHECK_EQUAL( vecAll.size(), 5 );
+
+	std::vector< std::string > vecJson = ListFlat( sDir, "*.json" );
+	TEST_CHECK( std::set< std::string >( vecJson.begin(), vecJson.end() ) == std::set< std::string >( { "A.JSON", "b.json", "sub.json" } ) );
+	TEST_CHECK( ListFlat( sDir, "?.txt" ) == std::vector< std::string >( { "c.txt" } ) );
+
+	// the accessors agree with stat
+	CDirIterator iter( sDir.c_str(), "*" );
+	TEST_CHECK( iter.IsValid() );
+	while ( iter.BNextFile() )
+	{
+		struct stat st;
+		TEST_CHECK( stat( iter.CurrentFilePath().c_str(), &st ) == 0 );
+		TEST_CHECK_EQUAL( iter.BCurrentIsDir(), S_ISDIR( st.st_mode ) );
+		if ( !iter.BCurrentIsDir() )
+			TEST_CHECK_EQUAL( iter.CurrentFileLength(), st.st_size );
+		TEST_CHECK_EQUAL( iter.CurrentFileWriteTime(), st.st_mtime );
+	}
+	TEST_CHECK( !iter.BNextFile() );
+
+	// nothing to list
+	CDirIterator none( sDir.c_str(), "*.nope" );
+	TEST_CHECK( !none.IsValid() && !none.BNextFile() );
+	CDirIterator missing( tempDir.Path( "missing" ).c_str(), "*" );
+	TEST_CHECK( !missing.IsValid() && !missing.BNextFile() );
+	CDirIterator nullPath( nullptr, "*" );
+	TEST_CHECK( !nullPath.IsValid() && !nullPath.BNextFile() );
+}
+
+static void TestRecursive( const CTestTempDir &tempDir )
+{
+	std::string sRoot = tempDir.Path( "tree" );
+	TEST_CHECK( BCreateDirectoryRecursive( ( sRoot + "/drivers/lighthouse/resources" ).c_str() ) );
+	TEST_CHECK( BCreateDirectoryRecursive( ( sRoot + "/drivers/null" ).c_str() ) );
+	WriteFile( sRoot + "/drivers/lighthouse/driver.vrdrivermanifest", "{}" );
+	WriteFile( sRoot + "/drivers/lighthouse/resources/settings.vrsettings", "{}" );
+	WriteFile( sRoot + "/drivers/null/driver.vrdrivermanifest", "{}" );
+	WriteFile( sRoot + "/readme.txt", "" );
+
+	// a link back up the tree is reported but never walked into
+	TEST_CHECK( symlink( "..", ( sRoot + "/drivers/null/up" ).c_str() ) == 0 );
+
+	std::vector< std::string > vecPaths;
+	std::vector< bool > vecIsDir;
+	CDirIterator walk( sRoot.c_str(), "*", true );
+	while ( walk.BNextFile() )
+	{
+		vecPaths.push_back( walk.CurrentFilePath().substr( sRoot.size() + 1 ) );
+		vecIsDir.push_back( walk.BCurrentIsDir() );
+	}
+
+	std::vector< std::string > vecExpected =
+	{
+		"drivers",
+		"drivers/lighthouse",
+		"drivers/lighthouse/driver.vrdrivermanifest",
+		"drivers/lighthouse/resources",
+		"drivers/lighthouse/resources/settings.vrsettings",
+		"drivers/null",
+		"drivers/null/driver.vrdrivermanifest",
+		"drivers/null/up",
+		"readme.txt",
+	};
+	TEST_CHECK( vecPaths == vecExpected );
+	if ( vecIsDir.size() == vecExpected.size() )
+	{
+		TEST_CHECK( vecIsDir[ 0 ] && vecIsDir[ 1 ] && vecIsDir[ 3 ] && vecIsDir[ 5 ] );
+		TEST_CHECK( vecIsDir[ 7 ] );		// the link points at a directory
+		TEST_CHECK( !vecIsDir[ 2 ] && !vecIsDir[ 4 ] && !vecIsDir[ 8 ] );
+	}
+
+	// the pattern filters what's reported, not what's walked
+	std::vector< std::string > vecManifests;
+	CDirIterator manifests( sRoot.c_str(), "*.VRDRIVERMANIFEST", true );
+	while ( manifests.BNextFile() )
+		vecManifests.push_back( manifests.CurrentFileName() );
+	TEST_CHECK_EQUAL( vecManifests.size(), 2 );
+}
+
+// Lists pchPattern in each directory under sRoot, the way a caller had to before bRecursive.
+// Returns the number of matches, and adds up their sizes if pnBytes is set.
+template < typename DirIterator_t >
+static size_t WalkTwoLevels( const std::string &sRoot, const char *pchPattern, int64_t *pnBytes, std::vector< std::string > *pvecNames = nullptr )
+{
+	size_t unMatches = 0;
+	DirIterator_t dirs( sRoot.c_str(), "*" );
+	while ( dirs.BNextFile() )
+	{
+		if ( !dirs.BCurrentIsDir() )
+			continue;
+		DirIterator_t files( Path_Join( sRoot, dirs.CurrentFileName() ).c_str(), pchPattern );
+		while ( files.BNextFile() )
+		{
+			unMatches++;
+			if ( pnBytes )
+				*pnBytes += files.CurrentFileLength();
+			if ( pvecNames )
+				pvecNames->push_back( dirs.CurrentFileName() + "/" + files.CurrentFileName() );
+		}
+	}
+	return unMatches;
+}
+
+static void BenchmarkWalk( const CTestTempDir &tempDir )
+{
+	int nDirs = BenchFull() ? 50 : 5;
+	int nFiles = BenchFull() ? 1000 : 200;
+	std::string sRoot = tempDir.Path( "bench" );
+	for ( int d = 0; d < nDirs; d++ )
+	{
+		std::string sDir = sRoot + "/d" + std::to_string( d );
+		TEST_CHECK( BCreateDirectoryRecursive( sDir.c_str() ) );
+		for ( int f = 0; f < nFiles; f++ )
+			WriteFile( sDir + "/f" + std::to_string( f ) + ( f % 4 ? ".txt" : ".json" ), "x" );
+	}
+	size_t unExpected = nDirs * nFiles / 4;
+
+	// both list the same files in the same order
+	std::vector< std::string > vecReference, vecCurrent;
+	int64_t nReferenceBytes = 0, nCurrentBytes = 0;
+	TEST_CHECK_EQUAL( WalkTwoLevels< DirReference::CDirIterator >( sRoot, "*.json", &nReferenceBytes, &vecReference ), unExpected );
+	TEST_CHECK_EQUAL( WalkTwoLevels< CDirIterator >( sRoot, "*.json", &nCurrentBytes, &vecCurrent ), unExpected );
+	TEST_CHECK( vecReference == vecCurrent );
+	TEST_CHECK_EQUAL( nReferenceBytes, nCurrentBytes );
+
+	auto bench = [ & ]( const char *pchLabel, size_t ( *pfnWalk )( const std::string &, int64_t * ), bool bSizes )
+	{
+		int64_t nBytes = 0;
+		auto start = std::chrono::steady_clock::now();
+		size_t unMatches = pfnWalk( sRoot, bSizes ? &nBytes : nullptr );
+		double flMs = BenchSecondsSince( start ) * 1000.0;
+		TEST_CHECK_EQUAL( unMatches, unExpected );
+		TEST_CHECK_EQUAL( nBytes, bSizes ? (int64_t)unExpected : 0 );
+		printf( "%d files, %zu matches: %-40s %7.1f ms\n", nDirs * nFiles, unMatches, pchLabel, flMs );
+	};
+
+	bench( "findfirst emulation", []( const std::string &sRoot, int64_t *pnBytes ) { return WalkTwoLevels< DirReference::CDirIterator >( sRoot, "*.json", pnBytes ); }, false );
+	bench( "findfirst emulation, with file sizes", []( const std::string &sRoot, int64_t *pnBytes ) { return WalkTwoLevels< DirReference::CDirIterator >( sRoot, "*.json", pnBytes ); }, true );
+	bench( "CDirIterator", []( const std::string &sRoot, int64_t *pnBytes ) { return WalkTwoLevels< CDirIterator >( sRoot, "*.json", pnBytes ); }, false );
+	bench( "CDirIterator, with file sizes", []( const std::string &sRoot, int64_t *pnBytes ) { return WalkTwoLevels< CDirIterator >( sRoot, "*.json", pnBytes ); }, true );
+
+	auto walkRecursive = []( const std::string &sRoot, int64_t *pnBytes )
+	{
+		size_t unMatches = 0;
+		CDirIterator walk( sRoot.c_str(), "*.json", true );
+		while ( walk.BNextFile() )
+		{
+			unMatches++;
+			if ( pnBytes )
+				*pnBytes += walk.CurrentFileLength();
+		}
+		return unMatches;
+	};
+	bench( "CDirIterator recursive", walkRecursive, false );
+	bench( "CDirIterator recursive, with file sizes", walkRecursive, true );
+}
+
+int main()
+{
+	CTestTempDir tempDir;
+	TestFlat( tempDir );
+	TestRecursive( tempDir );
+	BenchmarkWalk( tempDir );
+	return TestResult( "dirtools_test" );
+}
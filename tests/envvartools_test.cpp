@@ -0,0 +1,203 @@
+//========= Copyright Valve Corporation ============//
+// Environment snapshots: every variable reads back as getenv sees it, pinned snapshots stay valid
+// while others are published, replaced snapshots are freed once nothing pins them, and changes
+// made with setenv only show up after RefreshEnvironmentSnapshot. Then several readers check an
+// ordering invariant while a writer publishes, and lookups are timed against getenv.
+#include <vrcore/envvartools_public.h>
+#include "test_common.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+extern char **environ;
+
+static uint32_t CurrentVersion()
+{
+	CEnvironmentSnapshotPin env;
+	return env->GetVersion();
+}
+
+static void TestMatchesGetenv()
+{
+	for ( int i = 0; i < 60; i++ )
+	{
+		char rchName[ 32 ], rchValue[ 64 ];
+		snprintf( rchName, sizeof( rchName ), "ENV_TEST_VAR_%02d", i );
+		snprintf( rchValue, sizeof( rchValue ), "value-%d-some-longer-text", i );
+		TEST_CHECK( SetEnvironmentVariable( rchName, rchValue ) );
+	}
+	TEST_CHECK( SetEnvironmentVariable( "ENV_TEST_EMPTY", "" ) );
+
+	CEnvironmentSnapshotPin env;
+	for ( char **ppEntry = environ; *ppEntry; ppEntry++ )
+	{
+		std::string sEntry( *ppEntry );
+		std::string sName = sEntry.substr( 0, sEntry.find( '=' ) );
+		EnvVarRef_t value = env->GetVariable( sName.c_str() );
+		if ( !value.bSet || value.ToString() != getenv( sName.c_str() ) || value.pch[ value.unLength ] != '\0' )
+		{
+			fprintf( stderr, "%s reads back wrong\n", sName.c_str() );
+			g_nTestFailures++;
+		}
+	}
+	TEST_CHECK( !env->BHasVariable( "ENV_TEST_NOT_SET" ) );
+	TEST_CHECK( env->BHasVariable( "ENV_TEST_EMPTY" ) && env->GetVariable( "ENV_TEST_EMPTY" ).empty() );
+}
+
+static void TestSetAndUnset()
+{
+	uint32_t unVersion = CurrentVersion();
+	TEST_CHECK( SetEnvironmentVariable( "ENV_TEST_VAR_09", "changed" ) );
+	TEST_CHECK_EQUAL( CurrentVersion(), unVersion + 1 );
+	TEST_CHECK( GetEnvironmentVariable( "ENV_TEST_VAR_09" ) == "changed" );
+
+	// setting the value it already has publishes nothing
+	TEST_CHECK( SetEnvironmentVariable( "ENV_TEST_VAR_09", "changed" ) );
+	TEST_CHECK_EQUAL( CurrentVersion(), unVersion + 1 );
+
+	TEST_CHECK( SetEnvironmentVariable( "ENV_TEST_VAR_09", nullptr ) );
+	TEST_CHECK( !getenv( "ENV_TEST_VAR_09" ) );
+	TEST_CHECK( !CEnvironmentSnapshotPin()->BHasVariable( "ENV_TEST_VAR_09" ) );
+	TEST_CHECK( SetEnvironmentVariable( "ENV_TEST_VAR_09", nullptr ) );
+	TEST_CHECK_EQUAL( CurrentVersion(), unVersion + 2 );
+
+	struct BoolCase_t { const char *pchValue; bool bDefault; bool bExpected; };
+	const BoolCase_t k_rBools[] = { { "YES", false, true }, { "True", false, true }, { "y", false, true }, { "no", true, false },
+		{ "FALSE", true, false }, { "0", true, false }, { "12", false, true }, { "garbage", true, true }, { "", true, true }, { "yess", false, false } };
+	for ( const BoolCase_t &boolCase : k_rBools )
+	{
+		SetEnvironmentVariable( "ENV_TEST_BOOL", boolCase.pchValue );
+		TEST_CHECK( GetEnvironmentVariableAsBool( "ENV_TEST_BOOL", boolCase.bDefault ) == boolCase.bExpected );
+	}
+
+	SetEnvironmentVariable( "ENV_TEST_INT", "-42" );
+	TEST_CHECK_EQUAL( CEnvironmentSnapshotPin()->GetInt64( "ENV_TEST_INT", 7 ), -42 );
+	SetEnvironmentVariable( "ENV_TEST_INT", "42x" );
+	TEST_CHECK_EQUAL( CEnvironmentSnapshotPin()->GetInt64( "ENV_TEST_INT", 7 ), 7 );
+}
+
+static void TestReclaim()
+{
+	// with nothing pinned, replaced snapshots don't pile up
+	for ( int i = 0; i < 100; i++ )
+		SetEnvironmentVariable( "ENV_TEST_RECLAIM", std::to_string( i ).c_str() );
+	TEST_CHECK( GetRetiredEnvironmentSnapshotCount() <= 2 );
+
+	// a pinned snapshot and everything retired after it stay alive until the pin goes away
+	{
+		CEnvironmentSnapshotPin env;
+		EnvVarRef_t value = env->GetVariable( "ENV_TEST_RECLAIM" );
+		for ( int i = 0; i < 20; i++ )
+			SetEnvironmentVariable( "ENV_TEST_RECLAIM", std::to_string( 1000 + i ).c_str() );
+		TEST_CHECK( value == "99" );
+		TEST_CHECK( GetEnvironmentVariable( "ENV_TEST_RECLAIM" ) == "1019" );
+		TEST_CHECK( GetRetiredEnvironmentSnapshotCount() >= 20 );
+	}
+	SetEnvironmentVariable( "ENV_TEST_RECLAIM", "done" );
+	TEST_CHECK( GetRetiredEnvironmentSnapshotCount() <= 2 );
+}
+
+static void TestExternalChanges()
+{
+	setenv( "ENV_TEST_EXTERNAL", "x", 1 );
+	TEST_CHECK( !CEnvironmentSnapshotPin()->BHasVariable( "ENV_TEST_EXTERNAL" ) );
+	uint32_t unVersion = CurrentVersion();
+	RefreshEnvironmentSnapshot();
+	TEST_CHECK( GetEnvironmentVariable( "ENV_TEST_EXTERNAL" ) == "x" );
+	TEST_CHECK_EQUAL( CurrentVersion(), unVersion + 1 );
+
+	// nothing changed, nothing published
+	RefreshEnvironmentSnapshot();
+	TEST_CHECK_EQUAL( CurrentVersion(), unVersion + 1 );
+
+	setenv( "ENV_TEST_EXTERNAL", "y", 1 );
+	RefreshEnvironmentSnapshot();
+	TEST_CHECK( GetEnvironmentVariable( "ENV_TEST_EXTERNAL" ) == "y" );
+	unsetenv( "ENV_TEST_EXTERNAL" );
+	RefreshEnvironmentSnapshot();
+	TEST_CHECK( !CEnvironmentSnapshotPin()->BHasVariable( "ENV_TEST_EXTERNAL" ) );
+}
+
+// The writer sets A and then B to the same number, so every snapshot has A >= B. Readers also
+// check a variable that never changes, which would read garbage from a freed snapshot.
+static void TestConcurrentReaders()
+{
+	SetEnvironmentVariable( "ENV_TEST_A", "0" );
+	SetEnvironmentVariable( "ENV_TEST_B", "0" );
+	std::atomic< bool > bStop( false );
+	std::atomic< int > nFailures( 0 );
+	std::atomic< uint64_t > ulReads( 0 );
+	std::vector< std::thread > threads;
+	for ( int t = 0; t < 6; t++ )
+	{
+		threads.emplace_back( [ & ]
+		{
+			uint64_t ulLocalReads = 0;
+			while ( !bStop.load() )
+			{
+				CEnvironmentSnapshotPin env;
+				long nA = atol( env->GetVariable( "ENV_TEST_A" ).pch );
+				long nB = atol( env->GetVariable( "ENV_TEST_B" ).pch );
+				if ( nA < nB || env->GetVariable( "ENV_TEST_VAR_10" ) != "value-10-some-longer-text" )
+					nFailures++;
+				ulLocalReads++;
+			}
+			ulReads += ulLocalReads;
+		} );
+	}
+
+	int nWrites = BenchFull() ? 20000 : 2000;
+	for ( int i = 1; i <= nWrites; i++ )
+	{
+		std::string sValue = std::to_string( i );
+		SetEnvironmentVariable( "ENV_TEST_A", sValue.c_str() );
+		SetEnvironmentVariable( "ENV_TEST_B", sValue.c_str() );
+		if ( i % 50 == 0 )
+		{
+			setenv( "ENV_TEST_EXTERNAL", sValue.c_str(), 1 );
+			RefreshEnvironmentSnapshot();
+		}
+	}
+	bStop = true;
+	for ( std::thread &thread : threads )
+		thread.join();
+	TEST_CHECK_EQUAL( nFailures.load(), 0 );
+	SetEnvironmentVariable( "ENV_TEST_A", "0" );
+	TEST_CHECK( GetRetiredEnvironmentSnapshotCount() <= 2 );
+	printf( "%d publishes against %llu pinned reads\n", nWrites * 2, ( unsigned long long )ulReads.load() );
+}
+
+template < typename Lookup_t >
+static void BenchmarkLookup( const char *pchLabel, Lookup_t lookup )
+{
+	static const char *k_rpchNames[] = { "ENV_TEST_VAR_00", "ENV_TEST_VAR_33", "ENV_TEST_VAR_59", "PATH", "ENV_TEST_NOT_SET", "VR_OVERRIDE" };
+	int nLookups = BenchFull() ? 2000000 : 200000;
+	size_t unSink = 0;
+	auto start = std::chrono::steady_clock::now();
+	for ( int i = 0; i < nLookups; i++ )
+		unSink += lookup( k_rpchNames[ i % 6 ] );
+	double flNs = BenchSecondsSince( start ) * 1e9 / nLookups;
+	printf( "%-32s %6.1f ns/lookup (%zu)\n", pchLabel, flNs, unSink );
+}
+
+static void BenchmarkLookups()
+{
+	BenchmarkLookup( "getenv", []( const char *pchName ) { const char *pch = getenv( pchName ); return pch ? strlen( pch ) : 0; } );
+	BenchmarkLookup( "GetEnvironmentVariable", []( const char *pchName ) { return GetEnvironmentVariable( pchName ).size(); } );
+	BenchmarkLookup( "CEnvironmentSnapshotPin lookup", []( const char *pchName ) { CEnvironmentSnapshotPin env; return env->GetVariable( pchName ).unLength; } );
+	SetEnvironmentVariable( "ENV_TEST_BOOL", "yes" );
+	BenchmarkLookup( "GetEnvironmentVariableAsBool", []( const char * ) { return ( size_t )GetEnvironmentVariableAsBool( "ENV_TEST_BOOL", false ); } );
+	BenchmarkLookup( "RefreshEnvironmentSnapshot, same", []( const char * ) { RefreshEnvironmentSnapshot(); return ( size_t )1; } );
+}
+
+int main()
+{
+	TestMatchesGetenv();
+	TestSetAndUnset();
+	TestReclaim();
+	TestExternalChanges();
+	TestConcurrentReaders();
+	BenchmarkLookups();
+	return TestResult( "envvartools_test" );
+}
@@ -0,0 +1,163 @@
+//========= Copyright Valve Corporation ============//
+// Every EVRInitError value in headers/openvr_api.json has the right ID and description in the
+// generated tables, and every ID maps back to its value. Unknown values get the "Unknown error (N)"
+// text, which also maps back. Then several threads look errors up at once, which is worth running
+// under -fsanitize=thread since the fallback text lives in a per-thread buffer.
+#include <openvr.h>
+#include <hmderrors_public.h>
+#include <json/json.h>
+#include "test_common.h"
+
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+static std::string UnknownErrorText( int64_t nValue )
+{
+	return "Unknown error (" + std::to_string( nValue ) + ")";
+}
+
+static void CheckRoundTrip( vr::EVRInitError eError, const char *pchID )
+{
+	vr::EVRInitError eBack = vr::VRInitError_None;
+	bool bFound = BGetVRInitErrorForID( pchID, &eBack );
+	TEST_CHECK( bFound );
+	if ( bFound && eBack != eError )
+	{
+		fprintf( stderr, "%s maps back to %d, not %d\n", pchID, (int)eBack, (int)eError );
+		g_nTestFailures++;
+	}
+}
+
+static void TestMetadata()
+{
+	std::ifstream file( OPENVR_API_JSON_PATH );
+	std::stringstream ssJson;
+	ssJson << file.rdbuf();
+	Json::Value root;
+	std::string sErrors;
+	Json::CharReaderBuilder builder;
+	std::unique_ptr< Json::CharReader > reader( builder.newCharReader() );
+	std::string sText = ssJson.str();
+	TEST_CHECK( reader->parse( sText.data(), sText.data() + sText.size(), &root, &sErrors ) );
+
+	int nValues = 0;
+	for ( const Json::Value &enumDef : root[ "enums" ] )
+	{
+		if ( enumDef[ "enumname" ].asString() != "vr::EVRInitError" )
+			continue;
+		for ( const Json::Value &value : enumDef[ "values" ] )
+		{
+			nValues++;
+			std::string sName = value[ "name" ].asString();
+			int nValue = atoi( value[ "value" ].asString().c_str() );
+			vr::EVRInitError eError = ( vr::EVRInitError )nValue;
+
+			const char *pchID = GetIDForVRInitError( eError );
+			if ( sName != pchID )
+			{
+				fprintf( stderr, "ID for %d is %s, not %s\n", nValue, pchID, sName.c_str() );
+				g_nTestFailures++;
+			}
+			CheckRoundTrip( eError, sName.c_str() );
+
+			// a description always carries its own value; errors without one fall back to the ID
+			std::string sEnglish = GetEnglishStringForHmdError( eError );
+			std::string sSuffix = " (" + std::to_string( nValue ) + ")";
+			bool bDescribed = sEnglish.size() > sSuffix.size() && sEnglish.compare( sEnglish.size() - sSuffix.size(), sSuffix.size(), sSuffix ) == 0;
+			if ( !bDescribed && sEnglish != sName )
+			{
+				fprintf( stderr, "description for %s is [%s]\n", sName.c_str(), sEnglish.c_str() );
+				g_nTestFailures++;
+			}
+		}
+	}
+	TEST_CHECK( nValues > 200 );
+
+	// a few descriptions that tools match on
+	TEST_CHECK( strcmp( GetEnglishStringForHmdError( vr::VRInitError_None ), "No Error (0)" ) == 0 );
+	TEST_CHECK( strcmp( GetEnglishStringForHmdError( vr::VRInitError_Init_HmdNotFound ), "Hmd Not Found (108)" ) == 0 );
+	TEST_CHECK( strcmp( GetEnglishStringForHmdError( vr::VRInitError_Init_PathRegistryNotFound ), "Installation path could not be located (110)" ) == 0 );
+}
+
+static void TestUnknownValues()
+{
+	for ( int64_t nValue : { (int64_t)-1, (int64_t)-2000, (int64_t)99999, (int64_t)INT32_MIN, (int64_t)INT32_MAX } )
+	{
+		vr::EVRInitError eError = ( vr::EVRInitError )nValue;
+		std::string sExpected = UnknownErrorText( nValue );
+		TEST_CHECK( sExpected == GetIDForVRInitError( eError ) );
+		TEST_CHECK( sExpected == GetEnglishStringForHmdError( eError ) );
+		CheckRoundTrip( eError, sExpected.c_str() );
+	}
+
+	// every value in a wide range maps back to itself, known or not
+	for ( int i = -3000; i < 3000; i++ )
+	{
+		vr::EVRInitError eBack;
+		vr::EVRInitError eError = ( vr::EVRInitError )i;
+		if ( !BGetVRInitErrorForID( GetIDForVRInitError( eError ), &eBack ) || eBack != eError )
+		{
+			fprintf( stderr, "%d does not round-trip through %s\n", i, GetIDForVRInitError( eError ) );
+			g_nTestFailures++;
+		}
+	}
+
+	const char *k_rpchBad[] = { "", "VRInitError_", "VRInitError_Nonexistent", "Unknown error ()", "Unknown error (12",
+		"Unknown error (99999999999)", "Unknown error (1) ", "Unknown error (-)", "zzz" };
+	for ( const char *pchBad : k_rpchBad )
+	{
+		vr::EVRInitError eBack;
+		if ( BGetVRInitErrorForID( pchBad, &eBack ) )
+		{
+			fprintf( stderr, "accepted [%s]\n", pchBad );
+			g_nTestFailures++;
+		}
+	}
+	vr::EVRInitError eBack;
+	TEST_CHECK( !BGetVRInitErrorForID( nullptr, &eBack ) );
+	TEST_CHECK( !BGetVRInitErrorForID( "VRInitError_None", nullptr ) );
+}
+
+// Each thread formats its own range of unknown values, so a shared buffer would show up as
+// another thread's number in the text.
+static void TestConcurrentLookups()
+{
+	const int k_nThreads = 8;
+	const int k_nIterations = BenchFull() ? 200000 : 20000;
+	std::atomic< int > nMismatches( 0 );
+	std::vector< std::thread > threads;
+	for ( int t = 0; t < k_nThreads; t++ )
+	{
+		threads.emplace_back( [ t, k_nIterations, &nMismatches ]
+		{
+			for ( int i = 0; i < k_nIterations; i++ )
+			{
+				int nValue = 5000 + t * 1000 + ( i % 1000 );
+				const char *pchID = GetIDForVRInitError( ( vr::EVRInitError )nValue );
+				if ( UnknownErrorText( nValue ) != pchID )
+					nMismatches++;
+
+				vr::EVRInitError eKnown = ( vr::EVRInitError )( i % 2100 );
+				GetEnglishStringForHmdError( eKnown );
+				vr::EVRInitError eBack;
+				if ( !BGetVRInitErrorForID( GetIDForVRInitError( eKnown ), &eBack ) || eBack != eKnown )
+					nMismatches++;
+			}
+		} );
+	}
+	for ( std::thread &thread : threads )
+		thread.join();
+	TEST_CHECK_EQUAL( nMismatches.load(), 0 );
+}
+
+int main()
+{
+	TestMetadata();
+	TestUnknownValues();
+	TestConcurrentLookups();
+	return TestResult( "hmderrors_test" );
+}
@@ -0,0 +1,109 @@
+//========= Copyright Valve Corporation ============//
+// VR_IsHmdPresent keeps vrclient loaded between calls made outside VR_Init, only dropping
+// it when the path registry changes or VR_ReleaseHmdPresentProbe is called. Overrides set with
+// setenv rather than SetEnvironmentVariable are seen by the next probe and VR_GetRuntimePath.
+#include "openvr.h"
+#include "stub_runtime.h"
+
+StubVRClientCounters_t g_stubVRClientCounters;
+
+int main()
+{
+	CTestTempDir tempDir;
+	TEST_CHECK( !tempDir.Path().empty() );
+
+	std::string sRuntimePath = tempDir.Path( "runtime" );
+	std::string sRegistryPath = tempDir.Path( "openvrpaths.vrpath" );
+	TEST_CHECK( StubRuntime_Create( sRuntimePath ) );
+	TEST_CHECK( StubRuntime_WriteRegistry( sRegistryPath, sRuntimePath ) );
+
+	StubVRClientCounters_t &counters = g_stubVRClientCounters;
+	counters.bHmdPresent = true;
+
+	// repeated probes load vrclient once and ask it every time
+	for ( int i = 0; i < 5; i++ )
+	{
+		TEST_CHECK( vr::VR_IsHmdPresent() );
+	}
+	TEST_CHECK( vr::VR_IsRuntimeInstalled() );
+	TEST_CHECK_EQUAL( counters.nLoads, 1 );
+	TEST_CHECK_EQUAL( counters.nUnloads, 0 );
+	TEST_CHECK_EQUAL( counters.nFactoryCalls, 1 );
+	TEST_CHECK_EQUAL( counters.nHmdPresentCalls, 5 );
+
+	// with a TTL the answer is reused
+	vr::VR_SetHmdPresentProbeTTL( 60 * 1000 );
+	counters.bHmdPresent = false;
+	for ( int i = 0; i < 5; i++ )
+	{
+		TEST_CHECK( vr::VR_IsHmdPresent() );
+	}
+	TEST_CHECK_EQUAL( counters.nHmdPresentCalls, 5 );
+	vr::VR_SetHmdPresentProbeTTL( 0 );
+	TEST_CHECK( !vr::VR_IsHmdPresent() );
+	TEST_CHECK_EQUAL( counters.nHmdPresentCalls, 6 );
+	counters.bHmdPresent = true;
+
+	// a different registry may name a different runtime, so vrclient is loaded again
+	std::string sOtherRuntimePath = tempDir.Path( "other runtime" );
+	TEST_CHECK( StubRuntime_Create( sOtherRuntimePath ) );
+	TEST_CHECK( StubRuntime_WriteRegistry( sRegistryPath, sOtherRuntimePath ) );
+	TEST_CHECK( vr::VR_IsHmdPresent() );
+	TEST_CHECK_EQUAL( counters.nUnloads, 1 );
+	TEST_CHECK_EQUAL( counters.nLoads, 2 );
+
+	// so is a change to the runtime override
+	SetEnvironmentVariable( k_pchRuntimeOverrideVar, sRuntimePath.c_str() );
+	TEST_CHECK( vr::VR_IsHmdPresent() );
+	TEST_CHECK_EQUAL( counters.nUnloads, 2 );
+	TEST_CHECK_EQUAL( counters.nLoads, 3 );
+	SetEnvironmentVariable( k_pchRuntimeOverrideVar, nullptr );
+
+	// overrides the application sets with setenv count from the next call, without a VR_Init between
+	char rchPath[ 1024 ];
+	uint32_t unRequired = 0;
+	TEST_CHECK( vr::VR_GetRuntimePath( rchPath, sizeof( rchPath ), &unRequired ) && sOtherRuntimePath == rchPath );
+	setenv( k_pchRuntimeOverrideVar, tempDir.Path( "missing" ).c_str(), 1 );
+	TEST_CHECK( !vr::VR_IsRuntimeInstalled() );
+	TEST_CHECK( !vr::VR_GetRuntimePath( rchPath, sizeof( rchPath ), &unRequired ) );
+	setenv( k_pchRuntimeOverrideVar, sRuntimePath.c_str(), 1 );
+	TEST_CHECK( vr::VR_IsRuntimeInstalled() );
+	TEST_CHECK( vr::VR_GetRuntimePath( rchPath, sizeof( rchPath ), &unRequired ) && sRuntimePath == rchPath );
+	unsetenv( k_pchRuntimeOverrideVar );
+	TEST_CHECK( vr::VR_GetRuntimePath( rchPath, sizeof( rchPath ), &unRequired ) && sOtherRuntimePath == rchPath );
+
+	// and so does a registry override, which reloads vrclient from the runtime it names
+	std::string sOtherRegistryPath = tempDir.Path( "other.vrpath" );
+	TEST_CHECK( StubRuntime_WriteRegistry( sOtherRegistryPath, sRuntimePath ) );
+	TEST_CHECK( StubRuntime_WriteRegistry( sRegistryPath, sOtherRuntimePath ) );
+	TEST_CHECK( vr::VR_IsHmdPresent() );
+	int nLoadsBeforeSetenv = counters.nLoads;
+	setenv( "VR_PATHREG_OVERRIDE", sOtherRegistryPath.c_str(), 1 );
+	TEST_CHECK( vr::VR_GetRuntimePath( rchPath, sizeof( rchPath ), &unRequired ) && sRuntimePath == rchPath );
+	TEST_CHECK( vr::VR_IsHmdPresent() );
+	TEST_CHECK_EQUAL( counters.nLoads, nLoadsBeforeSetenv + 1 );
+	setenv( "VR_PATHREG_OVERRIDE", sRegistryPath.c_str(), 1 );
+	TEST_CHECK( vr::VR_GetRuntimePath( rchPath, sizeof( rchPath ), &unRequired ) && sOtherRuntimePath == rchPath );
+
+	// releasing the probe unloads it, and the next probe loads it again
+	TEST_CHECK( vr::VR_IsHmdPresent() );
+	int nLoadsBeforeRelease = counters.nLoads;
+	vr::VR_ReleaseHmdPresentProbe();
+	TEST_CHECK_EQUAL( counters.nUnloads, nLoadsBeforeRelease );
+	TEST_CHECK( vr::VR_IsHmdPresent() );
+	TEST_CHECK_EQUAL( counters.nLoads, nLoadsBeforeRelease + 1 );
+
+	// a registry naming a runtime that isn't there loads nothing
+	vr::VR_ReleaseHmdPresentProbe();
+	int nLoadsBeforeMissing = counters.nLoads;
+	TEST_CHECK( StubRuntime_WriteRegistry( sRegistryPath, tempDir.Path( "missing" ) ) );
+	TEST_CHECK( !vr::VR_IsHmdPresent() );
+	TEST_CHECK( !vr::VR_IsRuntimeInstalled() );
+	TEST_CHECK_EQUAL( counters.nLoads, nLoadsBeforeMissing );
+
+	// leave the stub loaded; the probe releases it at exit
+	TEST_CHECK( StubRuntime_WriteRegistry( sRegistryPath, sRuntimePath ) );
+	TEST_CHECK( vr::VR_IsHmdPresent() );
+
+	return TestResult( "hmdpresent_probe_test" );
+}
@@ -0,0 +1,106 @@
+//========= Copyright Valve Corporation ============//
+// VR_InitAsync returns before a slow vrclient Init finishes, a VR_Init made while it is
+// still running takes over its result instead of loading vrclient again, and shutdown
+// (or process exit) waits for the worker thread.
+#include "openvr.h"
+#include "stub_runtime.h"
+
+#include <atomic>
+#include <thread>
+
+StubVRClientCounters_t g_stubVRClientCounters;
+
+static std::atomic<int> g_nCallbacks( 0 );
+static std::atomic<int> g_nCallbackError( -1 );
+
+static void VR_CALLTYPE InitCallback( vr::EVRInitError eError, void *pUserData )
+{
+	g_nCallbackError = eError;
+	g_nCallbacks++;
+}
+
+static double MillisecondsSince( std::chrono::steady_clock::time_point start )
+{
+	return BenchSecondsSince( start ) * 1000.0;
+}
+
+int main()
+{
+	CTestTempDir tempDir;
+	std::string sRuntimePath = tempDir.Path( "runtime" );
+	TEST_CHECK( StubRuntime_Create( sRuntimePath ) );
+	TEST_CHECK( StubRuntime_WriteRegistry( tempDir.Path( "openvrpaths.vrpath" ), sRuntimePath ) );
+
+	StubVRClientCounters_t &counters = g_stubVRClientCounters;
+	const int k_nInitDelayMs = 200;
+	counters.nInitDelayMs = k_nInitDelayMs;
+
+	// the caller gets control back long before vrclient's Init is done
+	auto start = std::chrono::steady_clock::now();
+	TEST_CHECK_EQUAL( vr::VR_InitAsync( vr::VRApplication_Other, nullptr, InitCallback, nullptr ), vr::VRInitError_None );
+	double flStartMs = MillisecondsSince( start );
+	TEST_CHECK( flStartMs < k_nInitDelayMs / 2 );
+	TEST_CHECK_EQUAL( vr::VR_InitAsync( vr::VRApplication_Other ), vr::VRInitError_Init_AlreadyRunning );
+
+	vr::EVRInitError eError = vr::VRInitError_Unknown;
+	TEST_CHECK( !vr::VR_PollInitAsync( &eError ) );
+
+	vr::IVRSystem *pSystem = nullptr;
+	TEST_CHECK( vr::VR_PollInitAsync( &eError, &pSystem, true ) );
+	double flCompleteMs = MillisecondsSince( start );
+	TEST_CHECK_EQUAL( eError, vr::VRInitError_None );
+	TEST_CHECK( pSystem != nullptr );
+	TEST_CHECK( flCompleteMs >= k_nInitDelayMs );
+	printf( "VR_InitAsync returned in %.2f ms, init completed in %.2f ms (vrclient Init takes %d ms)\n", flStartMs, flCompleteMs, k_nInitDelayMs );
+
+	// the result is only collected once
+	TEST_CHECK( vr::VR_PollInitAsync( &eError ) );
+	TEST_CHECK_EQUAL( eError, vr::VRInitError_Init_NotInitialized );
+
+	vr::VR_Shutdown();
+	TEST_CHECK_EQUAL( g_nCallbacks.load(), 1 );
+	TEST_CHECK_EQUAL( g_nCallbackError.load(), vr::VRInitError_None );
+	TEST_CHECK_EQUAL( counters.nLoads, 1 );
+	TEST_CHECK_EQUAL( counters.nUnloads, 1 );
+	TEST_CHECK_EQUAL( counters.nCleanupCalls, 1 );
+
+	// a synchronous VR_Init while the async one is running joins it
+	TEST_CHECK_EQUAL( vr::VR_InitAsync( vr::VRApplication_Other, nullptr, InitCallback, nullptr ), vr::VRInitError_None );
+	pSystem = vr::VR_Init( &eError, vr::VRApplication_Other );
+	TEST_CHECK_EQUAL( eError, vr::VRInitError_None );
+	TEST_CHECK( pSystem != nullptr );
+	TEST_CHECK_EQUAL( counters.nInitCalls, 2 );
+	TEST_CHECK_EQUAL( counters.nLoads, 2 );
+	TEST_CHECK( vr::VR_PollInitAsync( &eError ) );
+	TEST_CHECK_EQUAL( eError, vr::VRInitError_Init_NotInitialized );
+
+	vr::VR_Shutdown();
+	TEST_CHECK_EQUAL( g_nCallbacks.load(), 2 );
+	TEST_CHECK_EQUAL( counters.nCleanupCalls, 2 );
+	TEST_CHECK_EQUAL( counters.nUnloads, 2 );
+
+	// shutting down with an init in flight waits for it and then undoes it
+	TEST_CHECK_EQUAL( vr::VR_InitAsync( vr::VRApplication_Other ), vr::VRInitError_None );
+	vr::VR_Shutdown();
+	TEST_CHECK_EQUAL( counters.nInitCalls, 3 );
+	TEST_CHECK_EQUAL( counters.nCleanupCalls, 3 );
+	TEST_CHECK_EQUAL( counters.nLoads, counters.nUnloads );
+
+	// a failed async init leaves the way clear for a synchronous one
+	TEST_CHECK( StubRuntime_WriteRegistry( tempDir.Path( "openvrpaths.vrpath" ), tempDir.Path( "missing" ) ) );
+	int nCallbacks = g_nCallbacks;
+	TEST_CHECK_EQUAL( vr::VR_InitAsync( vr::VRApplication_Other, nullptr, InitCallback, nullptr ), vr::VRInitError_None );
+	while ( g_nCallbacks == nCallbacks )
+		std::this_thread::yield();
+	TEST_CHECK( g_nCallbackError != vr::VRInitError_None );
+	TEST_CHECK( StubRuntime_WriteRegistry( tempDir.Path( "openvrpaths.vrpath" ), sRuntimePath ) );
+	vr::VR_Init( &eError, vr::VRApplication_Other );
+	TEST_CHECK_EQUAL( eError, vr::VRInitError_None );
+	vr::VR_Shutdown();
+	TEST_CHECK_EQUAL( counters.nLoads, counters.nUnloads );
+
+	// leave an init running; process exit joins the worker
+	TEST_CHECK_EQUAL( vr::VR_InitAsync( vr::VRApplication_Other ), vr::VRInitError_None );
+
+	return TestResult( "init_async_test" );
+}
@@ -0,0 +1,128 @@
+//========= Copyright Valve Corporation ============//
+// VR_GetGenericInterface and VR_IsInterfaceVersionValid answer repeat requests from the
+// lock-free interface cache, forget it as soon as VR_Shutdown starts, and scale across threads.
+// Versions too long to cache take the locked path every time, which gives the uncached baseline.
+#include "openvr.h"
+#include "stub_runtime.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+StubVRClientCounters_t g_stubVRClientCounters;
+
+static const char k_pchCachedVersion[] = "IVRStubInterface_001";
+static const char k_pchUncachedVersion[] = "IVRStubInterfaceWithAVersionStringTooLongToFitInTheInterfaceCache_001";
+
+// Returns ns per call with nThreads threads all asking for pchVersion
+static double MeasureGetInterface( const char *pchVersion, int nThreads, int nCallsPerThread, bool *pbAllMatched )
+{
+	void *pExpected = vr::VR_GetGenericInterface( pchVersion, nullptr );
+	std::atomic<bool> bStart( false );
+	std::atomic<int> nMismatches( 0 );
+
+	std::vector<std::thread> vecThreads;
+	for ( int t = 0; t < nThreads; t++ )
+	{
+		vecThreads.emplace_back( [&]()
+		{
+			while ( !bStart.load() )
+				std::this_thread::yield();
+			for ( int i = 0; i < nCallsPerThread; i++ )
+			{
+				vr::EVRInitError eError;
+				if ( vr::VR_GetGenericInterface( pchVersion, &eError ) != pExpected || eError != vr::VRInitError_None )
+					nMismatches++;
+			}
+		} );
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	bStart = true;
+	for ( std::thread & thread : vecThreads )
+		thread.join();
+	double flSeconds = BenchSecondsSince( start );
+
+	*pbAllMatched = nMismatches == 0 && pExpected != nullptr;
+	return flSeconds * 1e9 / ( (double)nCallsPerThread * nThreads );
+}
+
+int main()
+{
+	CTestTempDir tempDir;
+	std::string sRuntimePath = tempDir.Path( "runtime" );
+	TEST_CHECK( StubRuntime_Create( sRuntimePath ) );
+	TEST_CHECK( StubRuntime_WriteRegistry( tempDir.Path( "openvrpaths.vrpath" ), sRuntimePath ) );
+
+	StubVRClientCounters_t &counters = g_stubVRClientCounters;
+
+	vr::EVRInitError eError = vr::VRInitError_Unknown;
+	vr::VR_Init( &eError, vr::VRApplication_Other );
+	TEST_CHECK_EQUAL( eError, vr::VRInitError_None );
+
+	// repeat requests are answered without asking vrclient
+	int nGetInterfaceCalls = counters.nGetInterfaceCalls;
+	void *pInterface = vr::VR_GetGenericInterface( k_pchCachedVersion, &eError );
+	TEST_CHECK( pInterface != nullptr );
+	for ( int i = 0; i < 10; i++ )
+	{
+		TEST_CHECK( vr::VR_GetGenericInterface( k_pchCachedVersion, &eError ) == pInterface );
+		TEST_CHECK( vr::VR_IsInterfaceVersionValid( k_pchCachedVersion ) );
+	}
+	TEST_CHECK_EQUAL( counters.nGetInterfaceCalls, nGetInterfaceCalls + 1 );
+
+	// versions too long for the cache still work, just without it
+	nGetInterfaceCalls = counters.nGetInterfaceCalls;
+	for ( int i = 0; i < 10; i++ )
+	{
+		TEST_CHECK( vr::VR_GetGenericInterface( k_pchUncachedVersion, &eError ) != nullptr );
+	}
+	TEST_CHECK_EQUAL( counters.nGetInterfaceCalls, nGetInterfaceCalls + 10 );
+
+	// nothing cached survives VR_Shutdown
+	vr::VR_Shutdown();
+	TEST_CHECK( vr::VR_GetGenericInterface( k_pchCachedVersion, &eError ) == nullptr );
+	TEST_CHECK_EQUAL( eError, vr::VRInitError_Init_NotInitialized );
+	TEST_CHECK( !vr::VR_IsInterfaceVersionValid( k_pchCachedVersion ) );
+
+	vr::VR_Init( &eError, vr::VRApplication_Other );
+	TEST_CHECK_EQUAL( eError, vr::VRInitError_None );
+	nGetInterfaceCalls = counters.nGetInterfaceCalls;
+	TEST_CHECK( vr::VR_GetGenericInterface( k_pchCachedVersion, &eError ) != nullptr );
+	TEST_CHECK_EQUAL( counters.nGetInterfaceCalls, nGetInterfaceCalls + 1 );
+
+	// nor is it handed out while vrclient is being cleaned up on another thread
+	counters.nCleanupDelayMs = 200;
+	int nCleanupCalls = counters.nCleanupCalls;
+	std::thread shutdown( []() { vr::VR_Shutdown(); } );
+	std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+	void *pDuringShutdown = vr::VR_GetGenericInterface( k_pchCachedVersion, &eError );
+	bool bValidDuringShutdown = vr::VR_IsInterfaceVersionValid( k_pchCachedVersion );
+	shutdown.join();
+	TEST_CHECK_EQUAL( counters.nCleanupCalls, nCleanupCalls + 1 );
+	TEST_CHECK( pDuringShutdown == nullptr );
+	TEST_CHECK_EQUAL( eError, vr::VRInitError_Init_NotInitialized );
+	TEST_CHECK( !bValidDuringShutdown );
+	counters.nCleanupDelayMs = 0;
+
+	vr::VR_Init( &eError, vr::VRApplication_Other );
+	TEST_CHECK_EQUAL( eError, vr::VRInitError_None );
+	TEST_CHECK( vr::VR_GetGenericInterface( k_pchCachedVersion, &eError ) != nullptr );
+
+	// contention: every thread asking for the same interface at once
+	int nCallsPerThread = BenchFull() ? 2000000 : 20000;
+	unsigned unMaxThreads = std::max( 1u, std::min( 8u, std::thread::hardware_concurrency() ) );
+	for ( unsigned unThreads = 1; unThreads <= unMaxThreads; unThreads *= 2 )
+	{
+		bool bCachedMatched = false, bUncachedMatched = false;
+		double flCachedNs = MeasureGetInterface( k_pchCachedVersion, unThreads, nCallsPerThread, &bCachedMatched );
+		double flUncachedNs = MeasureGetInterface( k_pchUncachedVersion, unThreads, nCallsPerThread / 10, &bUncachedMatched );
+		TEST_CHECK( bCachedMatched );
+		TEST_CHECK( bUncachedMatched );
+		printf( "%u thread(s): cached %.1f ns/call, locked %.1f ns/call\n", unThreads, flCachedNs, flUncachedNs );
+	}
+
+	vr::VR_Shutdown();
+	return TestResult( "interface_cache_test" );
+}
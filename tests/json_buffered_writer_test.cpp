@@ -0,0 +1,282 @@
+//========= Copyright Valve Corporation ============//
+// BufferedWriter against the writers it replaces: for random values with comments, sparse arrays,
+// special floats and strings that need escaping, every output mode (own buffer, caller memory,
+// sink, file descriptor) must match FastWriter or the StreamWriterBuilder writer byte for byte.
+// Then times both on a large document.
+#include <json/json.h>
+#include <json/json_buffered_writer.h>
+#include "test_common.h"
+
+#include <cmath>
+#include <random>
+
+#if defined( POSIX )
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+static std::mt19937_64 g_rng( 7 );
+
+static std::string RandomString()
+{
+	static const char *k_rpchPieces[] = { "a", "hello", "\"", "\\", "\n", "\t", "\x01", "\x1f", "\x7f", "\xc3\xa9", "/", " ", "\b", "\f", "\r",
+		"abcdefghijklmnopqrstuvwxyz0123456789", "\xff" };
+	std::string s;
+	int nPieces = g_rng() % 10 == 0 ? g_rng() % 60 : g_rng() % 8;
+	for ( int i = 0; i < nPieces; i++ )
+		s += k_rpchPieces[ g_rng() % ( sizeof( k_rpchPieces ) / sizeof( k_rpchPieces[ 0 ] ) ) ];
+	if ( g_rng() % 20 == 0 )
+		s.push_back( '\0' );
+	return s;
+}
+
+static Json::Value RandomValue( int nDepth )
+{
+	Json::Value value;
+	switch ( g_rng() % ( nDepth > 4 ? 6 : 9 ) )
+	{
+	case 0:
+		break;
+	case 1:
+		value = Json::Value( (bool)( g_rng() & 1 ) );
+		break;
+	case 2:
+	{
+		static const Json::Int64 k_rnInts[] = { 0, -1, 1, 2147483647ll, -2147483648ll, INT64_MIN, INT64_MAX };
+		value = Json::Value( g_rng() % 2 ? k_rnInts[ g_rng() % 7 ] : (Json::Int64)(int32_t)g_rng() );
+		break;
+	}
+	case 3:
+		value = Json::Value( (Json::UInt64)g_rng() );
+		break;
+	case 4:
+	{
+		static const double k_rflDoubles[] = { 0.0, -0.0, 1.5, 1e300, -1e-300, 3.141592653589793, NAN, INFINITY, -INFINITY, 0.1 };
+		value = Json::Value( g_rng() % 2 ? k_rflDoubles[ g_rng() % 10 ] : (double)(int64_t)g_rng() / 1e7 );
+		break;
+	}
+	case 5:
+	{
+		std::string s = RandomString();
+		value = Json::Value( s.data(), s.data() + s.size() );
+		break;
+	}
+	case 6:
+	case 7:
+	{
+		value = Json::Value( Json::arrayValue );
+		int nElements = g_rng() % 8 == 0 ? g_rng() % 40 : g_rng() % 6;
+		for ( int i = 0; i < nElements; i++ )
+			value[ i ] = RandomValue( nDepth + 1 );
+		// leaves a hole before the last element
+		if ( g_rng() % 15 == 0 )
+			value[ nElements + 3 ] = RandomValue( nDepth + 1 );
+		break;
+	}
+	default:
+	{
+		value = Json::Value( Json::objectValue );
+		int nMembers = g_rng() % 6;
+		for ( int i = 0; i < nMembers; i++ )
+			value[ RandomString() ] = RandomValue( nDepth + 1 );
+		break;
+	}
+	}
+
+	if ( g_rng() % 12 == 0 )
+	{
+		static const Json::CommentPlacement k_rePlacements[] = { Json::commentBefore, Json::commentAfterOnSameLine, Json::commentAfter };
+		static const char *k_rpchComments[] = { "// c1", "/* multi\nline */", "// a\n// b" };
+		value.setComment( std::string( k_rpchComments[ g_rng() % 3 ] ), k_rePlacements[ g_rng() % 3 ] );
+	}
+	return value;
+}
+
+class CStringSink : public Json::BufferedWriter::Sink
+{
+public:
+	bool write( char const *pchData, size_t unSize ) override
+	{
+		m_sData.append( pchData, unSize );
+		return true;
+	}
+	std::string m_sData;
+};
+
+static int g_nReported = 0;
+
+static void CheckSame( const std::string &sExpected, const std::string &sActual, const char *pchWhat )
+{
+	if ( sExpected == sActual )
+		return;
+	g_nTestFailures++;
+	if ( g_nReported++ < 5 )
+		fprintf( stderr, "%s output differs:\nexpected [%s]\nactual   [%s]\n", pchWhat, sExpected.substr( 0, 300 ).c_str(), sActual.substr( 0, 300 ).c_str() );
+}
+
+static void CheckFastWriter( const Json::Value &value )
+{
+	for ( int nOptions = 0; nOptions < 8; nOptions++ )
+	{
+		Json::FastWriter fastWriter;
+		Json::BufferedWriter writer;
+		if ( nOptions & 1 )
+		{
+			fastWriter.enableYAMLCompatibility();
+			writer.enableYAMLCompatibility();
+		}
+		if ( nOptions & 2 )
+		{
+			fastWriter.dropNullPlaceholders();
+			writer.dropNullPlaceholders();
+		}
+		if ( nOptions & 4 )
+		{
+			fastWriter.omitEndingLineFeed();
+			writer.omitEndingLineFeed();
+		}
+		std::string sExpected = fastWriter.write( value );
+		CheckSame( sExpected, writer.write( value ), "FastWriter" );
+		CheckSame( sExpected, writer.write( value ), "FastWriter, reused buffer" );
+		if ( nOptions != 0 )
+			continue;
+
+		TEST_CHECK( writer.measure( value ) == sExpected.size() );
+		size_t unCapacity = g_rng() % ( sExpected.size() + 1 );
+		std::string sMemory( unCapacity, 'x' );
+		TEST_CHECK( writer.write( value, unCapacity ? &sMemory[ 0 ] : nullptr, unCapacity ) == sExpected.size() );
+		CheckSame( sExpected.substr( 0, unCapacity ), sMemory, "FastWriter into short memory" );
+
+		CStringSink sink;
+		writer.setChunkSize( 64 + g_rng() % 100 );
+		TEST_CHECK( writer.write( value, sink ) );
+		CheckSame( sExpected, sink.m_sData, "FastWriter into a sink" );
+	}
+}
+
+static void CheckStyledWriter( const Json::Value &value )
+{
+	const char *k_rpchIndents[] = { "\t", "", "   " };
+	for ( const char *pchIndent : k_rpchIndents )
+	{
+		for ( int nOptions = 0; nOptions < 16; nOptions++ )
+		{
+			Json::StreamWriterBuilder builder;
+			builder[ "indentation" ] = pchIndent;
+			if ( nOptions & 1 )
+				builder[ "commentStyle" ] = "None";
+			if ( nOptions & 2 )
+				builder[ "enableYAMLCompatibility" ] = true;
+			if ( nOptions & 4 )
+				builder[ "dropNullPlaceholders" ] = true;
+			if ( nOptions & 8 )
+			{
+				builder[ "useSpecialFloats" ] = true;
+				builder[ "precision" ] = 6;
+			}
+			std::string sExpected = Json::writeString( builder, value );
+			Json::BufferedWriter writer( builder );
+			CheckSame( sExpected, writer.write( value ), "StreamWriterBuilder" );
+			if ( nOptions < 2 )
+			{
+				CStringSink sink;
+				writer.setChunkSize( 64 );
+				writer.write( value, sink );
+				CheckSame( sExpected, sink.m_sData, "StreamWriterBuilder into a sink" );
+				TEST_CHECK( writer.measure( value ) == sExpected.size() );
+			}
+		}
+	}
+}
+
+// The builder's settings are validated the same way
+static void TestBadSettings()
+{
+	Json::StreamWriterBuilder builder;
+	builder[ "commentStyle" ] = "Some";
+	bool bThrew = false;
+	try
+	{
+		Json::BufferedWriter writer( builder );
+	}
+	catch ( const std::exception & )
+	{
+		bThrew = true;
+	}
+	TEST_CHECK( bThrew );
+}
+
+#if defined( POSIX )
+static void CheckFileDescriptor( const Json::Value &value )
+{
+	CTestTempDir tempDir;
+	std::string sPath = tempDir.Path( "out.json" );
+	Json::StreamWriterBuilder builder;
+	Json::BufferedWriter writer( builder );
+	int fd = open( sPath.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644 );
+	TEST_CHECK( fd >= 0 && writer.writeToFd( value, fd ) );
+	close( fd );
+
+	std::string sWritten;
+	FILE *f = fopen( sPath.c_str(), "rb" );
+	char rchBuffer[ 4096 ];
+	while ( size_t unRead = f ? fread( rchBuffer, 1, sizeof( rchBuffer ), f ) : 0 )
+		sWritten.append( rchBuffer, unRead );
+	if ( f )
+		fclose( f );
+	CheckSame( Json::writeString( builder, value ), sWritten, "file descriptor" );
+	TEST_CHECK( !writer.writeToFd( value, -1 ) );
+}
+#endif
+
+static void BenchmarkWriters( const Json::Value &value )
+{
+	int nRounds = BenchFull() ? 50 : 3;
+	size_t unBytes = 0;
+
+	Json::FastWriter fastWriter;
+	Json::BufferedWriter writer;
+	auto start = std::chrono::steady_clock::now();
+	for ( int i = 0; i < nRounds; i++ )
+		unBytes += fastWriter.write( value ).size();
+	double flFastMs = BenchSecondsSince( start ) * 1000.0;
+	start = std::chrono::steady_clock::now();
+	for ( int i = 0; i < nRounds; i++ )
+		unBytes += writer.write( value ).size();
+	double flBufferedFastMs = BenchSecondsSince( start ) * 1000.0;
+
+	Json::StreamWriterBuilder builder;
+	Json::BufferedWriter styledWriter( builder );
+	start = std::chrono::steady_clock::now();
+	for ( int i = 0; i < nRounds; i++ )
+		unBytes += Json::writeString( builder, value ).size();
+	double flStyledMs = BenchSecondsSince( start ) * 1000.0;
+	start = std::chrono::steady_clock::now();
+	for ( int i = 0; i < nRounds; i++ )
+		unBytes += styledWriter.write( value ).size();
+	double flBufferedStyledMs = BenchSecondsSince( start ) * 1000.0;
+
+	TEST_CHECK( unBytes > 0 );
+	printf( "%d writes of a %zu byte document: FastWriter %.1f ms, BufferedWriter %.1f ms; writeString %.1f ms, BufferedWriter(builder) %.1f ms\n",
+		nRounds, writer.write( value ).size(), flFastMs, flBufferedFastMs, flStyledMs, flBufferedStyledMs );
+}
+
+int main()
+{
+	TestBadSettings();
+	for ( int i = 0; i < ( BenchFull() ? 20000 : 3000 ); i++ )
+	{
+		Json::Value value = RandomValue( 0 );
+		CheckFastWriter( value );
+		CheckStyledWriter( value );
+	}
+
+	Json::Value big( Json::arrayValue );
+	for ( int i = 0; i < 20000; i++ )
+		big.append( RandomValue( 3 ) );
+#if defined( POSIX )
+	CheckFileDescriptor( big );
+#endif
+	BenchmarkWriters( big );
+	return TestResult( "json_buffered_writer_test" );
+}
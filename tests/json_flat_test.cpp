@@ -0,0 +1,248 @@
+//========= Copyright Valve Corporation ============//
+// FlatDocument against the Json::Value reader it stands in for: the same documents parse or
+// fail alike and every accessor agrees, including on randomly damaged input. Then times
+// parsing, keyed lookups and freeing a large config against CharReaderBuilder.
+#include <json/json.h>
+#include <json/json_flat.h>
+#include "test_common.h"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+static int g_nReported = 0;
+
+static bool Mismatch( const char *pchWhat, const std::string &sPath )
+{
+	g_nTestFailures++;
+	if ( g_nReported++ < 10 )
+		fprintf( stderr, "FlatValue differs from Value (%s) at '%s'\n", pchWhat, sPath.c_str() );
+	return false;
+}
+
+static bool BSame( const Json::Value &value, const Json::FlatValue &flat, const std::string &sPath )
+{
+	if ( value.type() != flat.type() || value.size() != flat.size() || value.empty() != flat.empty() )
+		return Mismatch( "type or size", sPath );
+	if ( value.isInt() != flat.isInt() || value.isUInt() != flat.isUInt() || value.isInt64() != flat.isInt64()
+		|| value.isUInt64() != flat.isUInt64() || value.isIntegral() != flat.isIntegral() || value.isDouble() != flat.isDouble() )
+		return Mismatch( "number type", sPath );
+	for ( int nType = Json::nullValue; nType <= Json::objectValue; nType++ )
+	{
+		if ( value.isConvertibleTo( (Json::ValueType)nType ) != flat.isConvertibleTo( (Json::ValueType)nType ) )
+			return Mismatch( "isConvertibleTo", sPath );
+	}
+	if ( value.asString() != flat.asString() )
+		return Mismatch( "asString", sPath );
+
+	if ( value.isObject() )
+	{
+		if ( value.getMemberNames() != flat.getMemberNames() )
+			return Mismatch( "member names", sPath );
+		Json::FlatValue::const_iterator iterFlat = flat.begin();
+		for ( Json::Value::const_iterator iter = value.begin(); iter != value.end(); ++iter, ++iterFlat )
+		{
+			if ( iter.name() != iterFlat.name() || !BSame( *iter, *iterFlat, sPath + "/" + iter.name() ) )
+				return Mismatch( "member", sPath );
+		}
+		if ( iterFlat != flat.end() || flat.isMember( "__missing__" ) || !flat[ "__missing__" ].isNull() )
+			return Mismatch( "missing member", sPath );
+		if ( value.get( "__missing__", 7 ) != flat.get( "__missing__", 7 ) )
+			return Mismatch( "get", sPath );
+	}
+	else if ( value.isArray() )
+	{
+		for ( Json::ArrayIndex i = 0; i < value.size(); i++ )
+		{
+			if ( !BSame( value[ i ], flat[ i ], sPath + "[" + std::to_string( i ) + "]" ) || value.get( i, 3 ) != flat.get( i, 3 ) )
+				return false;
+		}
+		if ( !flat[ value.size() ].isNull() )
+			return Mismatch( "index past the end", sPath );
+	}
+	else
+	{
+		if ( value.asBool() != flat.asBool() )
+			return Mismatch( "asBool", sPath );
+		bool bValueThrew = false, bFlatThrew = false;
+		Json::LargestInt nValue = 0, nFlat = 0;
+		try { nValue = value.asLargestInt(); } catch ( ... ) { bValueThrew = true; }
+		try { nFlat = flat.asLargestInt(); } catch ( ... ) { bFlatThrew = true; }
+		if ( bValueThrew != bFlatThrew || nValue != nFlat )
+			return Mismatch( "asLargestInt", sPath );
+	}
+	return true;
+}
+
+static void CheckDocument( const std::string &sDoc )
+{
+	Json::CharReaderBuilder builder;
+	std::unique_ptr< Json::CharReader > pReader( builder.newCharReader() );
+	Json::Value value;
+	std::string sError;
+	bool bThrew = false, bValueOk = false;
+	try
+	{
+		bValueOk = pReader->parse( sDoc.data(), sDoc.data() + sDoc.size(), &value, &sError );
+	}
+	catch ( ... )
+	{
+		bThrew = true;
+	}
+
+	Json::FlatDocument doc;
+	bool bFlatOk = doc.parse( sDoc.data(), sDoc.data() + sDoc.size(), &sError );
+	if ( bThrew )
+	{
+		// the Value reader throws past its depth limit; the flat one reports an error instead
+		if ( bFlatOk )
+			Mismatch( "accepted a document the reader threw on", "" );
+		return;
+	}
+	if ( bValueOk != bFlatOk )
+	{
+		Mismatch( bValueOk ? "rejected a valid document" : "accepted an invalid document", sDoc.substr( 0, 60 ) );
+		return;
+	}
+	if ( bValueOk && ( !BSame( value, doc.root(), "" ) || !( value == doc.root().toValue() ) ) )
+		Mismatch( "document", sDoc.substr( 0, 60 ) );
+}
+
+static const char *k_pchVRPathDoc =
+	"{\n"
+	"\t\"config\" : [ \"/home/user/.steam/steam/config\" ],\n"
+	"\t\"external_drivers\" : null,\n"
+	"\t\"jsonid\" : \"vrpathreg\",\n"
+	"\t\"log\" : [ \"/home/user/.steam/steam/logs\" ],\n"
+	"\t\"runtime\" : [ \"/home/user/.steam/steam/steamapps/common/SteamVR\", \"/opt/vr\\u00e9\" ],\n"
+	"\t\"version\" : 1,\n"
+	"\t\"numbers\" : [ 0, -0, 1.5e300, -9223372036854775808, 18446744073709551615, 2147483648, 3000000000 ] // trailing\n"
+	"}\n";
+
+static void TestDocuments()
+{
+	const char *k_rpchDocs[] =
+	{
+		k_pchVRPathDoc, "[]", "[ ]", "{}", "{ /*x*/ }", "{\"\":1,}", "-", "1 2", "\"abc", "", "  // c\n 5 //x", "[1,]",
+		"{\"a\":1 /*c*/ ,\"b\":2 // e\n}", "-0", "1.", ".5", "[1e]", "9223372036854775807", "9223372036854775808",
+		"\"\\ud800\\u0041\"", "\"\\udc00\"", "\"\\ud83d\\ude00\"",
+		"{\"b\":1,\"a\":2,\"b\":3,\"\":4,\"a\\u0000x\":5, \"a\":[1,2,{\"z\":null,\"y\":1.5e300}]}",
+	};
+	for ( const char *pchDoc : k_rpchDocs )
+		CheckDocument( pchDoc );
+
+	std::string sDeep( 1001, '[' );
+	CheckDocument( sDeep + std::string( 1001, ']' ) );
+
+	// get() on a member that is present but null carries the fallback along exactly as Value's does
+	std::string sNulls = "{ \"a\" : null, \"b\" : [ null, \"\" ] }";
+	Json::Value value;
+	Json::Reader reader;
+	TEST_CHECK( reader.parse( sNulls, value ) );
+	Json::FlatDocument doc;
+	TEST_CHECK( doc.parse( sNulls.data(), sNulls.data() + sNulls.size(), nullptr ) );
+	TEST_CHECK( doc.root().get( "a", "fallback" ).asString() == value.get( "a", "fallback" ).asString() );
+	for ( Json::ArrayIndex i = 0; i < 3; i++ )
+		TEST_CHECK( doc.root()[ "b" ].get( i, "fallback" ).asString() == value[ "b" ].get( i, "fallback" ).asString() );
+	TEST_CHECK( doc.root().get( "c", 5 ).asInt() == 5 );
+}
+
+static void FuzzAgainstValue( int nIterations )
+{
+	const char *k_rpchInserts[] = { "\"", "\\", "{", "}", "[", "]", ",", ":", "/*", "//", "\n", "-", "1e5", "\\u00e9", "\\ud83d",
+		"0", "18446744073709551616", "true", "nul", " ", "\"a\":1," };
+	std::mt19937 rng( 1 );
+	for ( int nIteration = 0; nIteration < nIterations; nIteration++ )
+	{
+		std::string sDoc = k_pchVRPathDoc;
+		int nEdits = 1 + rng() % 3;
+		for ( int i = 0; i < nEdits; i++ )
+		{
+			size_t unPos = rng() % sDoc.size();
+			if ( rng() % 2 )
+				sDoc.erase( unPos, 1 + rng() % 3 );
+			else
+				sDoc.insert( unPos, k_rpchInserts[ rng() % ( sizeof( k_rpchInserts ) / sizeof( k_rpchInserts[ 0 ] ) ) ] );
+			if ( sDoc.empty() )
+				sDoc = "{";
+		}
+		CheckDocument( sDoc );
+	}
+}
+
+// A device list in the shape of a driver's config, unSize bytes or a little more
+static std::string BuildBenchmarkDoc( size_t unSize, int *pnDevices )
+{
+	std::mt19937 rng( 7 );
+	std::string sDoc = "{\n";
+	int nDevice = 0;
+	while ( sDoc.size() < unSize )
+	{
+		char rchDevice[ 512 ];
+		snprintf( rchDevice, sizeof( rchDevice ), "  \"device_%06d\": { \"serial\": \"LHR-%08X\", \"model\": \"Sample HMD\", \"enabled\": %s, "
+			"\"ipd\": %.6f, \"index\": %d, \"tags\": [\"tracked\", \"hmd\"], \"pose\": [%.4f, %.4f, %.4f, 1.0] },\n",
+			nDevice, (unsigned)rng(), ( rng() & 1 ) ? "true" : "false", 0.06 + ( rng() % 1000 ) / 1e5, nDevice,
+			( rng() % 1000 ) / 100.0, ( rng() % 1000 ) / 100.0, ( rng() % 1000 ) / 100.0 );
+		sDoc += rchDevice;
+		nDevice++;
+	}
+	sDoc += "  \"end\": null\n}\n";
+	*pnDevices = nDevice;
+	return sDoc;
+}
+
+static void BenchmarkParse()
+{
+	int nDevices = 0;
+	std::string sDoc = BuildBenchmarkDoc( BenchFull() ? ( 50u << 20 ) : ( 2u << 20 ), &nDevices );
+
+	Json::CharReaderBuilder builder;
+	std::unique_ptr< Json::CharReader > pReader( builder.newCharReader() );
+	std::string sError;
+	auto start = std::chrono::steady_clock::now();
+	Json::Value *pValue = new Json::Value;
+	TEST_CHECK( pReader->parse( sDoc.data(), sDoc.data() + sDoc.size(), pValue, &sError ) );
+	double flValueParseMs = BenchSecondsSince( start ) * 1000.0;
+
+	start = std::chrono::steady_clock::now();
+	Json::FlatDocument *pDoc = new Json::FlatDocument;
+	TEST_CHECK( pDoc->parse( sDoc.data(), sDoc.data() + sDoc.size(), &sError ) );
+	double flFlatParseMs = BenchSecondsSince( start ) * 1000.0;
+
+	std::vector< std::string > vecKeys;
+	for ( int i = 0; i < nDevices; i++ )
+	{
+		char rchKey[ 32 ];
+		snprintf( rchKey, sizeof( rchKey ), "device_%06d", (int)( ( i * 7919ll ) % nDevices ) );
+		vecKeys.push_back( rchKey );
+	}
+	long long nValueSum = 0, nFlatSum = 0;
+	start = std::chrono::steady_clock::now();
+	for ( const std::string &sKey : vecKeys )
+		nValueSum += ( *pValue )[ sKey ][ "index" ].asInt();
+	double flValueLookupMs = BenchSecondsSince( start ) * 1000.0;
+	start = std::chrono::steady_clock::now();
+	for ( const std::string &sKey : vecKeys )
+		nFlatSum += pDoc->root()[ sKey ][ "index" ].asInt();
+	double flFlatLookupMs = BenchSecondsSince( start ) * 1000.0;
+	TEST_CHECK( nValueSum == nFlatSum );
+
+	start = std::chrono::steady_clock::now();
+	delete pValue;
+	double flValueFreeMs = BenchSecondsSince( start ) * 1000.0;
+	start = std::chrono::steady_clock::now();
+	delete pDoc;
+	double flFlatFreeMs = BenchSecondsSince( start ) * 1000.0;
+
+	printf( "%.1f MB config: parse Value %.1f ms, FlatDocument %.1f ms\n", sDoc.size() / ( 1024.0 * 1024.0 ), flValueParseMs, flFlatParseMs );
+	printf( "%d keyed lookups: Value %.2f ms, FlatValue %.2f ms\n", nDevices, flValueLookupMs, flFlatLookupMs );
+	printf( "free: Value %.2f ms, FlatDocument %.2f ms\n", flValueFreeMs, flFlatFreeMs );
+}
+
+int main()
+{
+	TestDocuments();
+	FuzzAgainstValue( BenchFull() ? 200000 : 20000 );
+	BenchmarkParse();
+	return TestResult( "json_flat_test" );
+}
@@ -0,0 +1,306 @@
+//========= Copyright Valve Corporation ============//
+// SaxReader against the CharReaderBuilder reader that shares its tokenizer: a Value built from
+// the events matches the DOM, errors are the same, and feeding a document in chunks of any size
+// (one byte included) gives the same events and errors as parsing it whole. Then measures
+// throughput and peak memory of streaming a large document against building it as a Value.
+#include <json/json.h>
+#include <json/json_sax.h>
+#include "test_common.h"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#if defined( POSIX )
+#include <sys/resource.h>
+#endif
+
+//-----------------------------------------------------------------------------
+// Purpose: Logs every event, and builds the Value the events describe
+//-----------------------------------------------------------------------------
+class CRecordingHandler : public Json::SaxHandler
+{
+public:
+	explicit CRecordingHandler( int nStopAfter = -1 ) : m_nStopAfter( nStopAfter ) {}
+
+	bool onStartObject() override { return BAddValue( "{", Json::Value( Json::objectValue ), true ); }
+	bool onKey( const char *pchBegin, const char *pchEnd ) override
+	{
+		m_sKey.assign( pchBegin, pchEnd );
+		return BEvent( "K" + m_sKey );
+	}
+	bool onEndObject() override { m_vecStack.pop_back(); return BEvent( "}" ); }
+	bool onStartArray() override { return BAddValue( "[", Json::Value( Json::arrayValue ), true ); }
+	bool onEndArray() override { m_vecStack.pop_back(); return BEvent( "]" ); }
+	bool onNull() override { return BAddValue( "n", Json::Value(), false ); }
+	bool onBool( bool bValue ) override { return BAddValue( bValue ? "t" : "f", Json::Value( bValue ), false ); }
+	bool onInt( Json::LargestInt nValue ) override { return BAddValue( "i" + std::to_string( nValue ), Json::Value( nValue ), false ); }
+	bool onUInt( Json::LargestUInt unValue ) override { return BAddValue( "u" + std::to_string( unValue ), Json::Value( unValue ), false ); }
+	bool onDouble( double flValue ) override
+	{
+		char rchValue[ 32 ];
+		snprintf( rchValue, sizeof( rchValue ), "d%.17g", flValue );
+		return BAddValue( rchValue, Json::Value( flValue ), false );
+	}
+	bool onString( const char *pchBegin, const char *pchEnd ) override
+	{
+		std::string sValue( pchBegin, pchEnd );
+		return BAddValue( "S" + sValue, Json::Value( sValue ), false );
+	}
+
+	std::string m_sLog;
+	Json::Value m_root;
+
+private:
+	bool BEvent( const std::string &sEvent )
+	{
+		m_sLog += sEvent;
+		m_sLog += '|';
+		return --m_nStopAfter != 0;
+	}
+
+	bool BAddValue( const std::string &sEvent, const Json::Value &value, bool bContainer )
+	{
+		Json::Value *pValue = &m_root;
+		if ( !m_vecStack.empty() )
+		{
+			Json::Value &parent = *m_vecStack.back();
+			pValue = parent.isArray() ? &parent.append( value ) : &( parent[ m_sKey ] = value );
+		}
+		else
+		{
+			m_root = value;
+		}
+		if ( bContainer )
+			m_vecStack.push_back( pValue );
+		return BEvent( sEvent );
+	}
+
+	int m_nStopAfter;
+	std::string m_sKey;
+	std::vector< Json::Value * > m_vecStack;
+};
+
+static int g_nReported = 0;
+
+static void Mismatch( const char *pchWhat, const std::string &sDoc )
+{
+	g_nTestFailures++;
+	if ( g_nReported++ < 10 )
+		fprintf( stderr, "%s for: %s\n", pchWhat, sDoc.substr( 0, 80 ).c_str() );
+}
+
+static std::string FirstLine( const std::string &s )
+{
+	return s.substr( 0, s.find( '\n' ) );
+}
+
+// Parses sDoc whole and in random chunks and checks both against each other and the DOM reader
+static void CheckDocument( const std::string &sDoc, std::mt19937 &rng, size_t unMaxChunk )
+{
+	CRecordingHandler whole;
+	Json::SaxReader wholeReader( whole );
+	bool bWholeOk = wholeReader.parse( sDoc.data(), sDoc.data() + sDoc.size() );
+
+	int nStopAfter = rng() % 8 == 0 ? 1 + rng() % 20 : -1;
+	CRecordingHandler stopped( nStopAfter ), chunked( nStopAfter );
+	Json::SaxReader stoppedReader( stopped ), chunkedReader( chunked );
+	bool bStoppedOk = stoppedReader.parse( sDoc.data(), sDoc.data() + sDoc.size() );
+	bool bFed = true;
+	for ( size_t unOffset = 0; unOffset < sDoc.size() && bFed; )
+	{
+		size_t unChunk = std::min< size_t >( 1 + rng() % unMaxChunk, sDoc.size() - unOffset );
+		bFed = chunkedReader.feed( sDoc.data() + unOffset, sDoc.data() + unOffset + unChunk );
+		unOffset += unChunk;
+	}
+	bool bChunkedOk = bFed && chunkedReader.finish();
+	if ( bStoppedOk != bChunkedOk || stopped.m_sLog != chunked.m_sLog
+		|| stoppedReader.getFormattedErrorMessages() != chunkedReader.getFormattedErrorMessages()
+		|| stoppedReader.wasStopped() != chunkedReader.wasStopped() || stoppedReader.isComplete() != chunkedReader.isComplete() )
+	{
+		Mismatch( "chunked feed differs from a whole parse", sDoc );
+	}
+
+	Json::CharReaderBuilder builder;
+	std::unique_ptr< Json::CharReader > pReader( builder.newCharReader() );
+	Json::Value value;
+	std::string sError;
+	try
+	{
+		bool bValueOk = pReader->parse( sDoc.data(), sDoc.data() + sDoc.size(), &value, &sError );
+		if ( bValueOk != bWholeOk )
+			Mismatch( bWholeOk ? "SaxReader accepted what the reader rejects" : "SaxReader rejected what the reader accepts", sDoc );
+		else if ( bValueOk && !( value == whole.m_root ) )
+			Mismatch( "events don't describe the same value", sDoc );
+		else if ( !bValueOk && FirstLine( sError ) != FirstLine( wholeReader.getFormattedErrorMessages() ) )
+			Mismatch( "error location differs", sDoc );
+	}
+	catch ( ... )
+	{
+		// past its depth limit the DOM reader throws; SaxReader reports the same limit as an error
+		if ( bWholeOk )
+			Mismatch( "SaxReader accepted a document the reader threw on", sDoc );
+	}
+}
+
+static const char *k_rpchSeedDocs[] =
+{
+	"{\n\t\"jsonid\" : \"vrpathreg\",\n\t\"runtime\" : [ \"/opt/steamvr\", \"C:\\\\Program Files\\\\SteamVR\\u00e9\" ],\n"
+	"\t\"version\" : 1, // trailing\r\n\t\"external_drivers\" : null,\n\t\"nums\" : [ -0, 1.5e-3, -9223372036854775808, 18446744073709551615,"
+	" 18446744073709551616, 2147483648, true, false ] /* end */\n}\n",
+	"[ {}, [], { \"\" : [ { \"a\" : \"\\ud83d\\ude00\" } ] }, \"\\\"\\\\\\/\\b\\f\\n\\r\\t\" ]",
+	"// leading comment\n{ \"b\" : 1, \"a\" : 2, \"b\" : 3 }",
+};
+
+static void FuzzChunked( int nIterations )
+{
+	const char *k_rpchInserts[] = { "\"", "\\", "{", "}", "[", "]", ",", ":", "/*", "*/", "//", "\n", "\r", "\r\n", "-", "1e5", "\\u00e9",
+		"\\ud83d", "0", "true", "nul", " ", "\"a\":1,", "'", "-I", "NaN" };
+	std::mt19937 rng( 3 );
+	for ( const char *pchDoc : k_rpchSeedDocs )
+	{
+		for ( size_t unMaxChunk = 1; unMaxChunk < 8; unMaxChunk++ )
+			CheckDocument( pchDoc, rng, unMaxChunk );
+	}
+	for ( int nIteration = 0; nIteration < nIterations; nIteration++ )
+	{
+		std::string sDoc = k_rpchSeedDocs[ rng() % 3 ];
+		int nEdits = rng() % 4;
+		for ( int i = 0; i < nEdits; i++ )
+		{
+			size_t unPos = rng() % ( sDoc.size() + 1 );
+			if ( rng() % 2 )
+				sDoc.erase( unPos, 1 + rng() % 3 );
+			else
+				sDoc.insert( unPos, k_rpchInserts[ rng() % ( sizeof( k_rpchInserts ) / sizeof( k_rpchInserts[ 0 ] ) ) ] );
+		}
+		CheckDocument( sDoc, rng, rng() % 3 == 0 ? 1 : 1 + rng() % 64 );
+	}
+
+	std::string sDeep( 1001, '[' );
+	CheckDocument( sDeep + std::string( 1001, ']' ), rng, 16 );
+}
+
+static Json::JsonTokenType Scan( const std::string &sToken, bool bFinal, bool bExtensions, size_t *punLength )
+{
+	const char *pchEnd = nullptr;
+	Json::JsonTokenType eType = Json::scanJsonToken( sToken.data(), sToken.data() + sToken.size(), bFinal, bExtensions, bExtensions, &pchEnd );
+	*punLength = pchEnd - sToken.data();
+	return eType;
+}
+
+static void TestTokenizer()
+{
+	size_t unLength;
+	TEST_CHECK( Scan( "\"a\\\"b\" ", true, false, &unLength ) == Json::jsonTokenString && unLength == 6 );
+	TEST_CHECK( Scan( "\"a\\\\\"b", true, false, &unLength ) == Json::jsonTokenString && unLength == 5 );
+	TEST_CHECK( Scan( "\"abc", false, false, &unLength ) == Json::jsonTokenIncomplete );
+	TEST_CHECK( Scan( "\"abc", true, false, &unLength ) == Json::jsonTokenError && unLength == 4 );
+	TEST_CHECK( Scan( "-12.5e+3,", true, false, &unLength ) == Json::jsonTokenNumber && unLength == 8 );
+	TEST_CHECK( Scan( "12", false, false, &unLength ) == Json::jsonTokenIncomplete );
+	TEST_CHECK( Scan( "tru", false, false, &unLength ) == Json::jsonTokenIncomplete );
+	TEST_CHECK( Scan( "tru", true, false, &unLength ) == Json::jsonTokenError && unLength == 1 );
+	TEST_CHECK( Scan( "// c\r\n", true, false, &unLength ) == Json::jsonTokenComment && unLength == 6 );
+	TEST_CHECK( Scan( "// c\r", false, false, &unLength ) == Json::jsonTokenIncomplete );
+	TEST_CHECK( Scan( "/* c */ 1", true, false, &unLength ) == Json::jsonTokenComment && unLength == 7 );
+	TEST_CHECK( Scan( "/x", true, false, &unLength ) == Json::jsonTokenError && unLength == 2 );
+
+	// single quotes and special floats only when enabled
+	TEST_CHECK( Scan( "'a\\'b'", true, true, &unLength ) == Json::jsonTokenString && unLength == 6 );
+	TEST_CHECK( Scan( "'/* x */'", true, false, &unLength ) == Json::jsonTokenError && unLength == 1 );
+	TEST_CHECK( Scan( "NaN", true, true, &unLength ) == Json::jsonTokenNaN && unLength == 3 );
+	TEST_CHECK( Scan( "Infinity", true, true, &unLength ) == Json::jsonTokenPosInf && unLength == 8 );
+	TEST_CHECK( Scan( "-Infinity", true, true, &unLength ) == Json::jsonTokenNegInf && unLength == 9 );
+	TEST_CHECK( Scan( "-Inf", true, true, &unLength ) == Json::jsonTokenError && unLength == 2 );
+	TEST_CHECK( Scan( "-Infinity", true, false, &unLength ) == Json::jsonTokenError && unLength == 2 );
+	TEST_CHECK( Scan( "NaN", true, false, &unLength ) == Json::jsonTokenError && unLength == 1 );
+
+	// Reader keeps its comments on the same tokenizer
+	Json::Reader reader;
+	Json::Value root;
+	TEST_CHECK( reader.parse( "// before\n{ \"a\" : 1, // after a\n \"b\" : [ 2 ] /* after b */\n}", root, true ) );
+	TEST_CHECK( root.getComment( Json::commentBefore ) == "// before" );
+	TEST_CHECK( root[ "a" ].getComment( Json::commentAfterOnSameLine ) == "// after a" );
+	TEST_CHECK( root[ "b" ].getComment( Json::commentAfterOnSameLine ) == "/* after b */" );
+	TEST_CHECK( !reader.parse( "[ -Infinity ]", root ) );
+}
+
+// Writes a config of about unSize bytes in chunks of at most unChunk to fn, never holding all of it
+template < typename Fn >
+static size_t GenerateDoc( size_t unSize, size_t unChunk, Fn fn )
+{
+	std::string sBuffer = "[\n";
+	size_t unTotal = 0;
+	for ( int nItem = 0; unTotal + sBuffer.size() < unSize; nItem++ )
+	{
+		char rchItem[ 256 ];
+		snprintf( rchItem, sizeof( rchItem ), "  { \"serial\": \"LHR-%08X\", \"index\": %d, \"enabled\": true, \"ipd\": 0.0635, \"tags\": [\"hmd\", \"tracked\"] },\n",
+			nItem * 2654435761u, nItem );
+		sBuffer += rchItem;
+		if ( sBuffer.size() >= unChunk )
+		{
+			fn( sBuffer );
+			unTotal += sBuffer.size();
+			sBuffer.clear();
+		}
+	}
+	sBuffer += "  null\n]\n";
+	fn( sBuffer );
+	return unTotal + sBuffer.size();
+}
+
+static long MaxRSSKB()
+{
+#if defined( POSIX )
+	struct rusage usage;
+	getrusage( RUSAGE_SELF, &usage );
+	return usage.ru_maxrss;
+#else
+	return 0;
+#endif
+}
+
+static void BenchmarkThroughput()
+{
+	size_t unSize = BenchFull() ? ( 200u << 20 ) : ( 8u << 20 );
+
+	// streaming first, while the peak RSS still reflects only what the reader holds
+	long nRSSBefore = MaxRSSKB();
+	Json::SaxHandler counter;
+	Json::SaxReader reader( counter );
+	auto start = std::chrono::steady_clock::now();
+	size_t unStreamed = GenerateDoc( unSize, 64 * 1024, [&]( const std::string &sChunk ) { reader.feed( sChunk.data(), sChunk.data() + sChunk.size() ); } );
+	TEST_CHECK( reader.finish() );
+	double flStreamSec = BenchSecondsSince( start );
+	long nStreamRSS = MaxRSSKB() - nRSSBefore;
+
+	std::string sDoc;
+	GenerateDoc( unSize, 64 * 1024, [&]( const std::string &sChunk ) { sDoc += sChunk; } );
+	TEST_CHECK( sDoc.size() == unStreamed );
+
+	start = std::chrono::steady_clock::now();
+	TEST_CHECK( reader.parse( sDoc.data(), sDoc.data() + sDoc.size() ) );
+	double flSaxSec = BenchSecondsSince( start );
+
+	nRSSBefore = MaxRSSKB();
+	Json::CharReaderBuilder builder;
+	std::unique_ptr< Json::CharReader > pReader( builder.newCharReader() );
+	Json::Value value;
+	std::string sError;
+	start = std::chrono::steady_clock::now();
+	TEST_CHECK( pReader->parse( sDoc.data(), sDoc.data() + sDoc.size(), &value, &sError ) );
+	double flDomSec = BenchSecondsSince( start );
+	long nDomRSS = MaxRSSKB() - nRSSBefore;
+
+	double flMB = sDoc.size() / ( 1024.0 * 1024.0 );
+	printf( "%.0f MB document: SaxReader %.0f MB/s in 64 KB chunks (+%ld KB peak RSS), %.0f MB/s whole; CharReader %.0f MB/s (+%ld KB peak RSS)\n",
+		flMB, flMB / flStreamSec, nStreamRSS, flMB / flSaxSec, flMB / flDomSec, nDomRSS );
+}
+
+int main()
+{
+	TestTokenizer();
+	FuzzChunked( BenchFull() ? 500000 : 30000 );
+	BenchmarkThroughput();
+	return TestResult( "json_sax_test" );
+}
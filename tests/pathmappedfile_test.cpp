@@ -0,0 +1,155 @@
+//========= Copyright Valve Corporation ============//
+// CPathMappedFile on regular, empty and missing files, and on the files it can't map: a pipe,
+// a /proc file that reports a size of 0, and a directory. Then compares read throughput of the
+// mapping against the Path_ReadBinaryFile overloads and Path_ReadTextFile on the same files.
+#include <vrcore/pathtools_public.h>
+#include "test_common.h"
+
+#include <stddef.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <thread>
+
+static std::string MakeContents( size_t unSize )
+{
+	std::string sContents( unSize, '\0' );
+	for ( size_t i = 0; i < unSize; i++ )
+		sContents[ i ] = ( i % 61 ) == 60 ? '\n' : (char)( 'a' + i % 26 );
+	return sContents;
+}
+
+static bool BMatches( const CPathMappedFile &file, const std::string &sExpected )
+{
+	return file.IsValid() && file.Size() == sExpected.size() && std::string( file.Chars(), file.Size() ) == sExpected;
+}
+
+static void TestRegularFiles( const CTestTempDir &tempDir )
+{
+	std::string sContents = MakeContents( 100000 );
+	std::string sFilename = tempDir.Path( "regular.bin" );
+	TEST_CHECK( Path_WriteBinaryFile( sFilename, (unsigned char *)&sContents[ 0 ], (unsigned)sContents.size() ) );
+
+	CPathMappedFile file( sFilename );
+	TEST_CHECK( BMatches( file, sContents ) );
+	TEST_CHECK( file.IsMapped() );
+	TEST_CHECK( file.end() - file.begin() == (ptrdiff_t)sContents.size() );
+
+	// an empty file is valid, just empty
+	std::string sEmpty = tempDir.Path( "empty.bin" );
+	TEST_CHECK( Path_WriteBinaryFile( sEmpty, nullptr, 0 ) );
+	TEST_CHECK( file.BOpen( sEmpty ) );
+	TEST_CHECK( file.IsValid() && file.Size() == 0 && !file.IsMapped() );
+	TEST_CHECK( file.begin() == file.end() );
+
+	// a missing file isn't, and reopening the first one still works after a failure
+	TEST_CHECK( !file.BOpen( tempDir.Path( "missing.bin" ) ) );
+	TEST_CHECK( !file.IsValid() && file.Size() == 0 && file.Data() == nullptr );
+	TEST_CHECK( file.BOpen( sFilename ) && BMatches( file, sContents ) );
+
+	file.Close();
+	TEST_CHECK( !file.IsValid() && file.Size() == 0 );
+}
+
+static void TestFallback( const CTestTempDir &tempDir )
+{
+	// a pipe is read to the end rather than mapped
+	std::string sContents = MakeContents( 200000 );
+	std::string sFifo = tempDir.Path( "pipe" );
+	TEST_CHECK( mkfifo( sFifo.c_str(), 0600 ) == 0 );
+	std::thread writer( [ & ]()
+	{
+		FILE *f = fopen( sFifo.c_str(), "wb" );
+		if ( f )
+		{
+			fwrite( sContents.data(), 1, sContents.size(), f );
+			fclose( f );
+		}
+	} );
+	CPathMappedFile pipe( sFifo );
+	writer.join();
+	TEST_CHECK( BMatches( pipe, sContents ) );
+	TEST_CHECK( !pipe.IsMapped() );
+
+	// /proc files claim to be empty, but aren't
+	CPathMappedFile proc( "/proc/self/status" );
+	if ( Path_IsDirectory( "/proc/self" ) )
+	{
+		TEST_CHECK( proc.IsValid() && !proc.IsMapped() );
+		TEST_CHECK( std::string( proc.Chars(), proc.Size() ).find( "Name:" ) == 0 );
+	}
+
+	// a directory is never a file, however it's opened
+	CPathMappedFile dir( tempDir.Path() );
+	TEST_CHECK( !dir.IsValid() );
+}
+
+static size_t SumBytes( const unsigned char *pData, size_t unSize )
+{
+	size_t unSum = 0;
+	for ( size_t i = 0; i < unSize; i++ )
+		unSum += pData[ i ];
+	return unSum;
+}
+
+static void BenchmarkRead( const CTestTempDir &tempDir, size_t unSize )
+{
+	std::string sFilename = tempDir.Path( "bench.bin" );
+	std::string sContents = MakeContents( unSize );
+	TEST_CHECK( Path_WriteBinaryFile( sFilename, (unsigned char *)&sContents[ 0 ], (unsigned)sContents.size() ) );
+	std::vector< unsigned char > vecBuffer( unSize );
+
+	// every method reads the whole file and sums it, so the mapping pays for faulting its pages in
+	size_t unBytesPerPass = BenchFull() ? 2048u << 20 : 64u << 20;
+	int nPasses = (int)std::max< size_t >( 3, unBytesPerPass / unSize );
+	auto bench = [ & ]( const char *pchLabel, size_t ( *pfnRead )( const std::string &, std::vector< unsigned char > & ) )
+	{
+		size_t unSum = 0;
+		auto start = std::chrono::steady_clock::now();
+		for ( int i = 0; i < nPasses; i++ )
+			unSum += pfnRead( sFilename, vecBuffer );
+		double flSeconds = BenchSecondsSince( start );
+		TEST_CHECK( unSum == pfnRead( sFilename, vecBuffer ) * nPasses );
+		printf( "%8zu KB %-36s %8.0f MB/s %8.1f us/read\n", unSize >> 10, pchLabel, (double)unSize * nPasses / flSeconds / ( 1 << 20 ), flSeconds * 1e6 / nPasses );
+	};
+
+	bench( "CPathMappedFile", []( const std::string &sFilename, std::vector< unsigned char > & )
+	{
+		CPathMappedFile file( sFilename );
+		return SumBytes( file.Data(), file.Size() );
+	} );
+	bench( "Path_ReadBinaryFile -> vector", []( const std::string &sFilename, std::vector< unsigned char > & )
+	{
+		std::vector< uint8_t > vecData = Path_ReadBinaryFile( sFilename );
+		return SumBytes( vecData.data(), vecData.size() );
+	} );
+	bench( "Path_ReadBinaryFile -> new[]", []( const std::string &sFilename, std::vector< unsigned char > & )
+	{
+		int nSize = 0;
+		unsigned char *pData = Path_ReadBinaryFile( sFilename, &nSize );
+		size_t unSum = SumBytes( pData, pData ? nSize : 0 );
+		delete[] pData;
+		return unSum;
+	} );
+	bench( "Path_ReadBinaryFile -> caller buffer", []( const std::string &sFilename, std::vector< unsigned char > &vecBuffer )
+	{
+		uint32_t unRead = Path_ReadBinaryFile( sFilename, vecBuffer.data(), (uint32_t)vecBuffer.size() );
+		return SumBytes( vecBuffer.data(), unRead );
+	} );
+	bench( "Path_ReadTextFile", []( const std::string &sFilename, std::vector< unsigned char > & )
+	{
+		std::string sData = Path_ReadTextFile( sFilename );
+		return SumBytes( (const unsigned char *)sData.data(), sData.size() );
+	} );
+}
+
+int main()
+{
+	CTestTempDir tempDir;
+	TestRegularFiles( tempDir );
+	TestFallback( tempDir );
+
+	// a registry sized file, then a large asset
+	BenchmarkRead( tempDir, 4 << 10 );
+	BenchmarkRead( tempDir, BenchFull() ? 256 << 20 : 32 << 20 );
+	return TestResult( "pathmappedfile_test" );
+}
@@ -0,0 +1,80 @@
+//========= Copyright Valve Corporation ============//
+// CVRPathRegistry_Public::GetPaths reuses the parsed registry until the file changes on
+// disk or an override variable changes, and how many resolutions per second that buys.
+#include "stub_runtime.h"
+
+static std::string GetRuntimePath()
+{
+	std::string sRuntimePath;
+	CVRPathRegistry_Public::GetPaths( &sRuntimePath, nullptr, nullptr, nullptr, nullptr );
+	return sRuntimePath;
+}
+
+// Returns resolutions per second, re-reading the registry every time if bInvalidate is set
+static double MeasureResolutions( int nIterations, bool bInvalidate )
+{
+	std::string sRuntimePath, sConfigPath, sLogPath;
+	auto start = std::chrono::steady_clock::now();
+	for ( int i = 0; i < nIterations; i++ )
+	{
+		if ( bInvalidate )
+			CVRPathRegistry_Public::InvalidateCachedPaths();
+		CVRPathRegistry_Public::GetPaths( &sRuntimePath, &sConfigPath, &sLogPath, nullptr, nullptr );
+	}
+	return nIterations / BenchSecondsSince( start );
+}
+
+int main()
+{
+	CTestTempDir tempDir;
+	std::string sRegistryPath = tempDir.Path( "openvrpaths.vrpath" );
+
+	TEST_CHECK( StubRuntime_WriteRegistry( sRegistryPath, tempDir.Path( "runtime_a" ) ) );
+	TEST_CHECK( GetRuntimePath() == tempDir.Path( "runtime_a" ) );
+	TEST_CHECK( GetRuntimePath() == tempDir.Path( "runtime_a" ) );
+
+	// a rewrite of the same length is still noticed
+	TEST_CHECK( StubRuntime_WriteRegistry( sRegistryPath, tempDir.Path( "runtime_b" ) ) );
+	TEST_CHECK( GetRuntimePath() == tempDir.Path( "runtime_b" ) );
+
+	// and so is a longer one
+	TEST_CHECK( StubRuntime_WriteRegistry( sRegistryPath, tempDir.Path( "another runtime" ) ) );
+	TEST_CHECK( GetRuntimePath() == tempDir.Path( "another runtime" ) );
+
+	std::string sConfigPath, sLogPath;
+	TEST_CHECK( CVRPathRegistry_Public::GetPaths( nullptr, &sConfigPath, &sLogPath, nullptr, nullptr ) );
+	TEST_CHECK( sConfigPath == tempDir.Path( "another runtime" ) + "/config" );
+	TEST_CHECK( sLogPath == tempDir.Path( "another runtime" ) + "/logs" );
+
+	// overrides take effect on the next call and stop when cleared
+	SetEnvironmentVariable( k_pchRuntimeOverrideVar, "/override/runtime" );
+	TEST_CHECK( GetRuntimePath() == "/override/runtime" );
+	SetEnvironmentVariable( k_pchRuntimeOverrideVar, nullptr );
+	TEST_CHECK( GetRuntimePath() == tempDir.Path( "another runtime" ) );
+
+	// a registry that moves somewhere else is read from its new location
+	std::string sOtherRegistryPath = tempDir.Path( "other.vrpath" );
+	TEST_CHECK( StubRuntime_WriteRegistry( sOtherRegistryPath, tempDir.Path( "runtime_c" ) ) );
+	TEST_CHECK( GetRuntimePath() == tempDir.Path( "runtime_c" ) );
+
+	// a registry that disappears resolves to nothing
+	TEST_CHECK( Path_UnlinkFile( sOtherRegistryPath ) );
+	TEST_CHECK( GetRuntimePath().empty() );
+	TEST_CHECK( !CVRPathRegistry_Public::GetPaths( nullptr, &sConfigPath, nullptr, nullptr, nullptr ) );
+
+	// registries written on Windows have CRLF line endings, including inside strings
+	std::string sCRLFRuntimePath = tempDir.Path( "crlf\nruntime" );
+	std::string sCRLFRegistry = "{\r\n\t\"runtime\" : [ \"" + tempDir.Path( "crlf\r\nruntime" ) + "\" ],\r\n\t\"version\" : 1\r\n}\r\n";
+	TEST_CHECK( Path_WriteBinaryFile( sRegistryPath, (unsigned char *)&sCRLFRegistry[ 0 ], (unsigned)sCRLFRegistry.size() ) );
+	SetEnvironmentVariable( "VR_PATHREG_OVERRIDE", sRegistryPath.c_str() );
+	TEST_CHECK( GetRuntimePath() == sCRLFRuntimePath );
+
+	TEST_CHECK( StubRuntime_WriteRegistry( sRegistryPath, tempDir.Path( "runtime_a" ) ) );
+	int nIterations = BenchFull() ? 200000 : 2000;
+	double flCached = MeasureResolutions( nIterations, false );
+	double flUncached = MeasureResolutions( nIterations / 10, true );
+	printf( "GetPaths: cached %.0f resolutions/s, re-reading the registry %.0f resolutions/s\n", flCached, flUncached );
+	TEST_CHECK( GetRuntimePath() == tempDir.Path( "runtime_a" ) );
+
+	return TestResult( "pathregistry_cache_test" );
+}
@@ -0,0 +1,174 @@
+//========= Copyright Valve Corporation ============//
+// The std::string path functions give the same answers they did before they were rebuilt
+// on PathRef_t/CPathBuffer, over a generated corpus of awkward paths, and the allocation-free
+// versions agree with them. Also counts the heap allocations each API makes.
+#include <vrcore/pathtools_public.h>
+#include "pathtools_reference.h"
+#include "test_common.h"
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+static std::atomic<uint64_t> g_ulAllocations( 0 );
+
+void *operator new( size_t unSize )
+{
+	g_ulAllocations++;
+	if ( void *p = malloc( unSize ? unSize : 1 ) )
+		return p;
+	throw std::bad_alloc();
+}
+
+void operator delete( void *p ) noexcept
+{
+	free( p );
+}
+
+void operator delete( void *p, size_t ) noexcept
+{
+	free( p );
+}
+
+// a PathRef_t must never be made from a temporary string
+static_assert( !std::is_constructible< PathRef_t, std::string && >::value, "PathRef_t binds to temporaries" );
+static_assert( std::is_constructible< PathRef_t, const std::string & >::value, "PathRef_t doesn't take strings" );
+
+// Builds paths out of the pieces the path functions treat specially
+static std::vector< std::string > BuildCorpus( uint32_t unCount )
+{
+	static const char *k_rpchPieces[] =
+	{
+		"", "a", "bc", "dir", ".", "..", "/", "\\", "//", "\\\\", "x.txt", ".hidden", "name.", "a.b.c",
+		"C:", "c:\\", "~", " ", "...", "./", "../", "/./", "/../", "\\..\\", ".\\", "\xc3\xa9", "long_directory_name_",
+	};
+	const uint32_t unPieces = sizeof( k_rpchPieces ) / sizeof( k_rpchPieces[ 0 ] );
+
+	std::vector< std::string > vecCorpus;
+	for ( uint32_t i = 0; i < unPieces; i++ )
+		for ( uint32_t j = 0; j < unPieces; j++ )
+			vecCorpus.push_back( std::string( k_rpchPieces[ i ] ) + k_rpchPieces[ j ] );
+
+	// xorshift so every run sees the same corpus
+	uint32_t unState = 0x9e3779b9u;
+	while ( vecCorpus.size() < unCount )
+	{
+		std::string sPath;
+		uint32_t unLength = 1 + ( unState % 12 );
+		for ( uint32_t i = 0; i < unLength; i++ )
+		{
+			unState ^= unState << 13; unState ^= unState >> 17; unState ^= unState << 5;
+			sPath += k_rpchPieces[ unState % unPieces ];
+		}
+		unState ^= unState << 13; unState ^= unState >> 17; unState ^= unState << 5;
+		if ( unState % 16 == 0 )
+			sPath += std::string( 300, 'z' );	// past the CPathBuffer inline storage
+		vecCorpus.push_back( sPath );
+	}
+	return vecCorpus;
+}
+
+static void CheckSame( const std::string &sExpected, const std::string &sActual, const char *pchFunction, const std::string &sInput )
+{
+	if ( sExpected != sActual )
+	{
+		fprintf( stderr, "%s( \"%s\" ): expected \"%s\", got \"%s\"\n", pchFunction, sInput.c_str(), sExpected.c_str(), sActual.c_str() );
+		g_nTestFailures++;
+	}
+}
+
+static void CompareWithReference( const std::vector< std::string > &vecCorpus )
+{
+	static const char k_rchSlashes[] = { 0, '/', '\\' };
+	CPathBuffer buffer;
+
+	for ( size_t i = 0; i < vecCorpus.size(); i++ )
+	{
+		const std::string &sPath = vecCorpus[ i ];
+		const std::string &sOther = vecCorpus[ ( i * 7919 + 13 ) % vecCorpus.size() ];
+		const std::string &sThird = vecCorpus[ ( i * 104729 + 7 ) % vecCorpus.size() ];
+
+		CheckSame( PathReference::Path_StripExtension( sPath ), Path_StripExtension( sPath ), "Path_StripExtension", sPath );
+		CheckSame( PathReference::Path_StripExtension( sPath ), Path_StripExtensionRef( sPath ).ToString(), "Path_StripExtensionRef", sPath );
+		CheckSame( PathReference::Path_GetExtension( sPath ), Path_GetExtension( sPath ), "Path_GetExtension", sPath );
+		CheckSame( PathReference::Path_GetExtension( sPath ), Path_GetExtensionRef( sPath ).ToString(), "Path_GetExtensionRef", sPath );
+
+		for ( char slash : k_rchSlashes )
+		{
+			CheckSame( PathReference::Path_StripFilename( sPath, slash ), Path_StripFilename( sPath, slash ), "Path_StripFilename", sPath );
+			CheckSame( PathReference::Path_StripFilename( sPath, slash ), Path_StripFilenameRef( sPath, slash ).ToString(), "Path_StripFilenameRef", sPath );
+			CheckSame( PathReference::Path_StripDirectory( sPath, slash ), Path_StripDirectory( sPath, slash ), "Path_StripDirectory", sPath );
+			CheckSame( PathReference::Path_StripDirectory( sPath, slash ), Path_StripDirectoryRef( sPath, slash ).ToString(), "Path_StripDirectoryRef", sPath );
+
+			CheckSame( PathReference::Path_FixSlashes( sPath, slash ), Path_FixSlashes( sPath, slash ), "Path_FixSlashes", sPath );
+			Path_FixSlashesInto( &buffer, sPath, slash );
+			CheckSame( PathReference::Path_FixSlashes( sPath, slash ), buffer.ToString(), "Path_FixSlashesInto", sPath );
+
+			std::string sCompacted = PathReference::Path_Compact( sPath, slash );
+			CheckSame( sCompacted, Path_Compact( sPath, slash ), "Path_Compact", sPath );
+			bool bCompacted = Path_CompactInto( &buffer, sPath, slash );
+			CheckSame( sCompacted, buffer.ToString(), "Path_CompactInto", sPath );
+			TEST_CHECK( bCompacted || sCompacted.empty() );
+
+			CheckSame( PathReference::Path_Join( sPath, sOther, slash ), Path_Join( sPath, sOther, slash ), "Path_Join", sPath + " + " + sOther );
+			CheckSame( PathReference::Path_Join( sPath, sOther, sThird, slash ), Path_Join( sPath, sOther, sThird, slash ), "Path_Join", sPath + " + " + sOther + " + " + sThird );
+			CheckSame( PathReference::Path_Join( sPath, sOther, sThird, sPath, slash ), Path_Join( sPath, sOther, sThird, sPath, slash ), "Path_Join", sPath );
+			CheckSame( PathReference::Path_Join( sPath, sOther, sThird, sPath, sOther, slash ), Path_Join( sPath, sOther, sThird, sPath, sOther, slash ), "Path_Join", sPath );
+
+			Path_JoinInto( &buffer, slash, sPath, sOther, sThird );
+			CheckSame( PathReference::Path_Join( sPath, sOther, sThird, slash ), buffer.ToString(), "Path_JoinInto", sPath + " + " + sOther + " + " + sThird );
+		}
+	}
+}
+
+// A manifest-scanning shaped workload: join, compact, then pick the path apart
+static void BenchmarkAllocations( const std::vector< std::string > &vecCorpus )
+{
+	int nRounds = BenchFull() ? 200 : 2;
+	size_t unCount = std::min< size_t >( vecCorpus.size(), 2000 );
+	size_t unChecksum[ 2 ] = { 0, 0 };
+
+	uint64_t ulStartAllocations = g_ulAllocations;
+	auto start = std::chrono::steady_clock::now();
+	for ( int nRound = 0; nRound < nRounds; nRound++ )
+	{
+		for ( size_t i = 0; i < unCount; i++ )
+		{
+			std::string sJoined = Path_Compact( Path_Join( "/opt/steamvr/drivers", vecCorpus[ i ], "resources", "driver.vrdrivermanifest", '/' ), '/' );
+			unChecksum[ 0 ] += Path_StripFilename( sJoined, '/' ).size() + Path_GetExtension( sJoined ).size();
+		}
+	}
+	double flStringSeconds = BenchSecondsSince( start );
+	uint64_t ulStringAllocations = g_ulAllocations - ulStartAllocations;
+
+	ulStartAllocations = g_ulAllocations;
+	start = std::chrono::steady_clock::now();
+	CPathBuffer joined, compacted;
+	for ( int nRound = 0; nRound < nRounds; nRound++ )
+	{
+		for ( size_t i = 0; i < unCount; i++ )
+		{
+			Path_JoinInto( &joined, '/', "/opt/steamvr/drivers", vecCorpus[ i ], "resources", "driver.vrdrivermanifest" );
+			Path_CompactInto( &compacted, joined, '/' );
+			unChecksum[ 1 ] += Path_StripFilenameRef( compacted, '/' ).unLength + Path_GetExtensionRef( compacted ).unLength;
+		}
+	}
+	double flRefSeconds = BenchSecondsSince( start );
+	uint64_t ulRefAllocations = g_ulAllocations - ulStartAllocations;
+
+	TEST_CHECK_EQUAL( unChecksum[ 0 ], unChecksum[ 1 ] );
+
+	double flCalls = (double)nRounds * unCount;
+	printf( "std::string API: %.1f allocations and %.0f ns per path\n", ulStringAllocations / flCalls, flStringSeconds * 1e9 / flCalls );
+	printf( "PathRef_t API: %.3f allocations and %.0f ns per path\n", ulRefAllocations / flCalls, flRefSeconds * 1e9 / flCalls );
+}
+
+int main()
+{
+	std::vector< std::string > vecCorpus = BuildCorpus( BenchFull() ? 200000 : 20000 );
+	CompareWithReference( vecCorpus );
+	BenchmarkAllocations( vecCorpus );
+	return TestResult( "pathtools_differential_test" );
+}
@@ -0,0 +1,8 @@
+//========= Copyright Valve Corporation ============//
+#pragma once
+
+// Stand-in for the SteamVR assert header; see platform.h in this directory.
+#include <assert.h>
+
+#define Assert( cond ) assert( cond )
+#define AssertMsg( cond, ... ) assert( cond )
@@ -0,0 +1,5 @@
+//========= Copyright Valve Corporation ============//
+#pragma once
+
+// Stand-in for the SteamVR logging header; see platform.h in this directory.
+#include <stdio.h>
@@ -0,0 +1,32 @@
+//========= Copyright Valve Corporation ============//
+#pragma once
+
+// The parts of the SteamVR platform layer that the !VRCORE_NO_PLATFORM code in
+// vrcore uses, so dirtools_test can build CDirIterator outside SteamVR. POSIX
+// has no attribute bits, so these are never set there.
+
+#if !defined( _WIN32 )
+#define _A_RDONLY	0
+#define _A_HIDDEN	0
+#define _A_SYSTEM	0
+#define _A_ARCH		0
+#endif
+
+// Stats that keep 64-bit sizes and times on 32-bit builds, as the platform layer has them.
+#if defined( LINUX )
+#include <dirent.h>
+#include <sys/stat.h>
+typedef struct stat64 statBig_t;
+typedef struct dirent64 direntBig_t;
+#define statBig stat64
+#define scandirBig scandir64
+#define alphasortBig alphasort64
+#elif !defined( _WIN32 )
+#include <dirent.h>
+#include <sys/stat.h>
+typedef struct stat statBig_t;
+typedef struct dirent direntBig_t;
+#define statBig stat
+#define scandirBig scandir
+#define alphasortBig alphasort
+#endif
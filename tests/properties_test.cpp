@@ -0,0 +1,672 @@
+//========= Copyright Valve Corporation ============//
+// The typed property accessors in openvr_properties.h against an IVRSystem that counts its queries.
+// Every descriptor must match its name and its entry in headers/openvr_api.json, typed reads must
+// return what the device stored, and strings and arrays must only ask twice when they outgrow the
+// inline buffer. Then counts and times the snapshot against the two-call string reads it replaced.
+#include <openvr.h>
+#include <openvr_properties.h>
+#include <json/json.h>
+#include "test_common.h"
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string.h>
+#include <type_traits>
+#include <vector>
+
+using namespace vr;
+
+//-----------------------------------------------------------------------------
+// Purpose: One device's properties, stored as tag and bytes the way the
+//			runtime keeps them. Only the property getters do anything.
+//-----------------------------------------------------------------------------
+class CCountingVRSystem : public IVRSystem
+{
+public:
+	void SetValue( ETrackedDeviceProperty eProp, PropertyTypeTag_t unTag, const void *pValue, uint32_t unSize )
+	{
+		StoredProperty_t &stored = m_mapProperties[ eProp ];
+		stored.unTag = unTag;
+		stored.vecValue.assign( ( const char * )pValue, ( const char * )pValue + unSize );
+	}
+
+	template < typename T >
+	void Set( ETrackedDeviceProperty eProp, PropertyTypeTag_t unTag, const T &value ) { SetValue( eProp, unTag, &value, sizeof( value ) ); }
+	void SetString( ETrackedDeviceProperty eProp, const std::string &sValue ) { SetValue( eProp, k_unStringPropertyTag, sValue.c_str(), ( uint32_t )sValue.size() + 1 ); }
+	void Remove( ETrackedDeviceProperty eProp ) { m_mapProperties.erase( eProp ); }
+
+	int m_nQueries = 0;
+	std::chrono::nanoseconds m_callCost{ 0 };
+
+	// IVRSystem property getters
+	virtual bool GetBoolTrackedDeviceProperty( TrackedDeviceIndex_t unDeviceIndex, ETrackedDeviceProperty prop, ETrackedPropertyError *pError ) override { return ReadScalar< bool >( unDeviceIndex, prop, k_unBoolPropertyTag, pError ); }
+	virtual float GetFloatTrackedDeviceProperty( TrackedDeviceIndex_t unDeviceIndex, ETrackedDeviceProperty prop, ETrackedPropertyError *pError ) override { return ReadScalar< float >( unDeviceIndex, prop, k_unFloatPropertyTag, pError ); }
+	virtual int32_t GetInt32TrackedDeviceProperty( TrackedDeviceIndex_t unDeviceIndex, ETrackedDeviceProperty prop, ETrackedPropertyError *pError ) override { return ReadScalar< int32_t >( unDeviceIndex, prop, k_unInt32PropertyTag, pError ); }
+	virtual uint64_t GetUint64TrackedDeviceProperty( TrackedDeviceIndex_t unDeviceIndex, ETrackedDeviceProperty prop, ETrackedPropertyError *pError ) override { return ReadScalar< uint64_t >( unDeviceIndex, prop, k_unUint64PropertyTag, pError ); }
+	virtual HmdMatrix34_t GetMatrix34TrackedDeviceProperty( TrackedDeviceIndex_t unDeviceIndex, ETrackedDeviceProperty prop, ETrackedPropertyError *pError ) override { return ReadScalar< HmdMatrix34_t >( unDeviceIndex, prop, k_unHmdMatrix34PropertyTag, pError ); }
+
+	virtual uint32_t GetArrayTrackedDeviceProperty( TrackedDeviceIndex_t unDeviceIndex, ETrackedDeviceProperty prop, PropertyTypeTag_t propType, void *pBuffer, uint32_t unBufferSize, ETrackedPropertyError *pError ) override
+	{
+		const StoredProperty_t *pStored = Find( unDeviceIndex, prop, propType, pError );
+		return pStored ? CopyOut( *pStored, pBuffer, unBufferSize, pError ) : 0;
+	}
+
+	virtual uint32_t GetStringTrackedDeviceProperty( TrackedDeviceIndex_t unDeviceIndex, ETrackedDeviceProperty prop, char *pchValue, uint32_t unBufferSize, ETrackedPropertyError *pError ) override
+	{
+		const StoredProperty_t *pStored = Find( unDeviceIndex, prop, k_unStringPropertyTag, pError );
+		return pStored ? CopyOut( *pStored, pchValue, unBufferSize, pError ) : 0;
+	}
+
+	// the rest of IVRSystem
+	virtual void GetRecommendedRenderTargetSize( uint32_t *pnWidth, uint32_t *pnHeight ) override { *pnWidth = *pnHeight = 0; }
+	virtual HmdMatrix44_t GetProjectionMatrix( EVREye eEye, float fNearZ, float fFarZ ) override { return HmdMatrix44_t(); }
+	virtual void GetProjectionRaw( EVREye eEye, float *pfLeft, float *pfRight, float *pfTop, float *pfBottom ) override {}
+	virtual bool ComputeDistortion( EVREye eEye, float fU, float fV, DistortionCoordinates_t *pDistortionCoordinates ) override { return false; }
+	virtual HmdMatrix34_t GetEyeToHeadTransform( EVREye eEye ) override { return HmdMatrix34_t(); }
+	virtual bool GetTimeSinceLastVsync( float *pfSecondsSinceLastVsync, uint64_t *pulFrameCounter ) override { return false; }
+	virtual int32_t GetD3D9AdapterIndex() override { return 0; }
+	virtual void GetDXGIOutputInfo( int32_t *pnAdapterIndex ) override {}
+	virtual void GetOutputDevice( uint64_t *pnDevice, ETextureType textureType, VkInstance_T *pInstance ) override {}
+	virtual bool IsDisplayOnDesktop() override { return false; }
+	virtual bool SetDisplayVisibility( bool bIsVisibleOnDesktop ) override { return false; }
+	virtual void GetDeviceToAbsoluteTrackingPose( ETrackingUniverseOrigin eOrigin, float fPredictedSecondsToPhotonsFromNow, TrackedDevicePose_t *pTrackedDevicePoseArray, uint32_t unTrackedDevicePoseArrayCount ) override {}
+	virtual HmdMatrix34_t GetSeatedZeroPoseToStandingAbsoluteTrackingPose() override { return HmdMatrix34_t(); }
+	virtual HmdMatrix34_t GetRawZeroPoseToStandingAbsoluteTrackingPose() override { return HmdMatrix34_t(); }
+	virtual uint32_t GetSortedTrackedDeviceIndicesOfClass( ETrackedDeviceClass eTrackedDeviceClass, TrackedDeviceIndex_t *punTrackedDeviceIndexArray, uint32_t unTrackedDeviceIndexArrayCount, TrackedDeviceIndex_t unRelativeToTrackedDeviceIndex ) override { return 0; }
+	virtual EDeviceActivityLevel GetTrackedDeviceActivityLevel( TrackedDeviceIndex_t unDeviceId ) override { return k_EDeviceActivityLevel_Unknown; }
+	virtual void ApplyTransform( TrackedDevicePose_t *pOutputPose, const TrackedDevicePose_t *pTrackedDevicePose, const HmdMatrix34_t *pTransform ) override {}
+	virtual TrackedDeviceIndex_t GetTrackedDeviceIndexForControllerRole( ETrackedControllerRole unDeviceType ) override { return k_unTrackedDeviceIndexInvalid; }
+	virtual ETrackedControllerRole GetControllerRoleForTrackedDeviceIndex( TrackedDeviceIndex_t unDeviceIndex ) override { return TrackedControllerRole_Invalid; }
+	virtual ETrackedDeviceClass GetTrackedDeviceClass( TrackedDeviceIndex_t unDeviceIndex ) override { return unDeviceIndex == k_unTrackedDeviceIndex_Hmd ? TrackedDeviceClass_HMD : TrackedDeviceClass_Invalid; }
+	virtual bool IsTrackedDeviceConnected( TrackedDeviceIndex_t unDeviceIndex ) override { return unDeviceIndex == k_unTrackedDeviceIndex_Hmd; }
+	virtual const char *GetPropErrorNameFromEnum( ETrackedPropertyError error ) override { return ""; }
+	virtual bool PollNextEvent( VREvent_t *pEvent, uint32_t uncbVREvent ) override { return false; }
+	virtual bool PollNextEventWithPose( ETrackingUniverseOrigin eOrigin, VREvent_t *pEvent, uint32_t uncbVREvent, TrackedDevicePose_t *pTrackedDevicePose ) override { return false; }
+	virtual const char *GetEventTypeNameFromEnum( EVREventType eType ) override { return ""; }
+	virtual HiddenAreaMesh_t GetHiddenAreaMesh( EVREye eEye, EHiddenAreaMeshType type ) override { return HiddenAreaMesh_t(); }
+	virtual bool GetControllerState( TrackedDeviceIndex_t unControllerDeviceIndex, VRControllerState_t *pControllerState, uint32_t unControllerStateSize ) override { return false; }
+	virtual bool GetControllerStateWithPose( ETrackingUniverseOrigin eOrigin, TrackedDeviceIndex_t unControllerDeviceIndex, VRControllerState_t *pControllerState, uint32_t unControllerStateSize, TrackedDevicePose_t *pTrackedDevicePose ) override { return false; }
+	virtual void TriggerHapticPulse( TrackedDeviceIndex_t unControllerDeviceIndex, uint32_t unAxisId, unsigned short usDurationMicroSec ) override {}
+	virtual const char *GetButtonIdNameFromEnum( EVRButtonId eButtonId ) override { return ""; }
+	virtual const char *GetControllerAxisTypeNameFromEnum( EVRControllerAxisType eAxisType ) override { return ""; }
+	virtual bool IsInputAvailable() override { return false; }
+	virtual bool IsSteamVRDrawingControllers() override { return false; }
+	virtual bool ShouldApplicationPause() override { return false; }
+	virtual bool ShouldApplicationReduceRenderingWork() override { return false; }
+	virtual EVRFirmwareError PerformFirmwareUpdate( TrackedDeviceIndex_t unDeviceIndex ) override { return VRFirmwareError_None; }
+	virtual void AcknowledgeQuit_Exiting() override {}
+	virtual uint32_t GetAppContainerFilePaths( char *pchBuffer, uint32_t unBufferSize ) override { return 0; }
+	virtual const char *GetRuntimeVersion() override { return ""; }
+
+private:
+	struct StoredProperty_t
+	{
+		PropertyTypeTag_t unTag;
+		std::vector< char > vecValue;
+	};
+
+	// Counts the query, and returns the value if the device has one with the right tag
+	const StoredProperty_t *Find( TrackedDeviceIndex_t unDeviceIndex, ETrackedDeviceProperty prop, PropertyTypeTag_t unTag, ETrackedPropertyError *pError )
+	{
+		m_nQueries++;
+		SpendCallCost();
+
+		ETrackedPropertyError eError = TrackedProp_Success;
+		const StoredProperty_t *pStored = nullptr;
+		auto iter = m_mapProperties.find( prop );
+		if ( unDeviceIndex != k_unTrackedDeviceIndex_Hmd )
+			eError = TrackedProp_InvalidDevice;
+		else if ( iter == m_mapProperties.end() )
+			eError = TrackedProp_UnknownProperty;
+		else if ( iter->second.unTag != unTag )
+			eError = TrackedProp_WrongDataType;
+		else
+			pStored = &iter->second;
+		if ( pError )
+			*pError = eError;
+		return pStored;
+	}
+
+	template < typename T >
+	T ReadScalar( TrackedDeviceIndex_t unDeviceIndex, ETrackedDeviceProperty prop, PropertyTypeTag_t unTag, ETrackedPropertyError *pError )
+	{
+		T value = {};
+		const StoredProperty_t *pStored = Find( unDeviceIndex, prop, unTag, pError );
+		if ( pStored && pStored->vecValue.size() == sizeof( T ) )
+			memcpy( &value, pStored->vecValue.data(), sizeof( T ) );
+		else if ( pStored && pError )
+			*pError = TrackedProp_WrongDataType;
+		return value;
+	}
+
+	// Like the runtime, reports the size a value needs when the buffer is missing or too small
+	static uint32_t CopyOut( const StoredProperty_t &stored, void *pBuffer, uint32_t unBufferSize, ETrackedPropertyError *pError )
+	{
+		uint32_t unSize = ( uint32_t )stored.vecValue.size();
+		if ( !pBuffer || unBufferSize < unSize )
+		{
+			if ( pError )
+				*pError = TrackedProp_BufferTooSmall;
+			return unSize;
+		}
+		memcpy( pBuffer, stored.vecValue.data(), unSize );
+		return unSize;
+	}
+
+	void SpendCallCost()
+	{
+		if ( m_callCost.count() == 0 )
+			return;
+		auto end = std::chrono::steady_clock::now() + m_callCost;
+		while ( std::chrono::steady_clock::now() < end )
+		{
+		}
+	}
+
+	std::map< ETrackedDeviceProperty, StoredProperty_t > m_mapProperties;
+};
+
+//-----------------------------------------------------------------------------
+// Purpose: The kind a property's name says it has, the same way the generator
+//			reads it
+//-----------------------------------------------------------------------------
+static bool BEndsWith( const std::string &sName, const char *pchSuffix )
+{
+	size_t unLen = strlen( pchSuffix );
+	return sName.size() > unLen && sName.compare( sName.size() - unLen, unLen, pchSuffix ) == 0;
+}
+
+static bool BKindFromName( const std::string &sName, ETrackedPropertyValueKind *peKind )
+{
+	// checked longest first, so _Matrix34_Array isn't taken for _Array of something else
+	static const struct { const char *pchSuffix; ETrackedPropertyValueKind eKind; } k_rgSuffixes[] =
+	{
+		{ "_Float_Array", TrackedPropertyValueKind_FloatArray },
+		{ "_Int32_Array", TrackedPropertyValueKind_Int32Array },
+		{ "_Vector4_Array", TrackedPropertyValueKind_Vector4Array },
+		{ "_Matrix34_Array", TrackedPropertyValueKind_Matrix34Array },
+		{ "_Bool", TrackedPropertyValueKind_Bool },
+		{ "_Float", TrackedPropertyValueKind_Float },
+		{ "_Int32", TrackedPropertyValueKind_Int32 },
+		{ "_Uint64", TrackedPropertyValueKind_Uint64 },
+		{ "_String", TrackedPropertyValueKind_String },
+		{ "_Matrix34", TrackedPropertyValueKind_Matrix34 },
+		{ "_Vector3", TrackedPropertyValueKind_Vector3 },
+	};
+	if ( sName == "Prop_ParentContainer" )
+	{
+		*peKind = TrackedPropertyValueKind_Uint64;
+		return true;
+	}
+	for ( const auto &suffix : k_rgSuffixes )
+	{
+		if ( BEndsWith( sName, suffix.pchSuffix ) )
+		{
+			*peKind = suffix.eKind;
+			return true;
+		}
+	}
+	return false;
+}
+
+static bool BIsArrayKind( ETrackedPropertyValueKind eKind )
+{
+	return eKind >= TrackedPropertyValueKind_FloatArray;
+}
+
+static void TestDescriptors()
+{
+	std::ifstream file( OPENVR_API_JSON_PATH );
+	std::stringstream ssJson;
+	ssJson << file.rdbuf();
+	Json::Value root;
+	std::string sErrors;
+	Json::CharReaderBuilder builder;
+	std::unique_ptr< Json::CharReader > reader( builder.newCharReader() );
+	std::string sText = ssJson.str();
+	TEST_CHECK( reader->parse( sText.data(), sText.data() + sText.size(), &root, &sErrors ) );
+
+	std::map< std::string, int64_t > mapJsonValues;
+	for ( const Json::Value &enumDef : root[ "enums" ] )
+	{
+		if ( enumDef[ "enumname" ].asString() != "vr::ETrackedDeviceProperty" )
+			continue;
+		for ( const Json::Value &value : enumDef[ "values" ] )
+			mapJsonValues[ value[ "name" ].asString() ] = atoll( value[ "value" ].asString().c_str() );
+	}
+	TEST_CHECK( mapJsonValues.size() > 200 );
+
+	for ( uint32_t i = 0; i < k_unTrackedPropertyDescriptorCount; i++ )
+	{
+		const TrackedPropertyDescriptor_t &desc = k_TrackedPropertyDescriptors[ i ];
+		TEST_CHECK( i == 0 || k_TrackedPropertyDescriptors[ i - 1 ].eProp < desc.eProp );
+		TEST_CHECK( FindTrackedPropertyDescriptor( desc.eProp ) == &desc );
+
+		ETrackedPropertyValueKind eKind;
+		auto iter = mapJsonValues.find( desc.pchName );
+		if ( iter == mapJsonValues.end() || iter->second != desc.eProp || !BKindFromName( desc.pchName, &eKind ) || eKind != desc.eKind )
+		{
+			fprintf( stderr, "descriptor %u (%s = %d, kind %d) doesn't match openvr_api.json\n", i, desc.pchName, (int)desc.eProp, (int)desc.eKind );
+			g_nTestFailures++;
+		}
+
+		// only strings and arrays read into a buffer, and it must hold the usual values in one query
+		bool bBuffered = desc.eKind == TrackedPropertyValueKind_String || BIsArrayKind( desc.eKind );
+		TEST_CHECK( bBuffered ? desc.unInlineBufferSize >= 256 : desc.unInlineBufferSize == 0 );
+	}
+
+	// every property whose type the name gives is described, apart from the reserved ones
+	int nDescribable = 0;
+	for ( const auto &entry : mapJsonValues )
+	{
+		ETrackedPropertyValueKind eKind;
+		if ( entry.first.find( "_Reserved" ) != std::string::npos || !BKindFromName( entry.first, &eKind ) )
+			continue;
+		nDescribable++;
+		const TrackedPropertyDescriptor_t *pDesc = FindTrackedPropertyDescriptor( ( ETrackedDeviceProperty )entry.second );
+		if ( !pDesc || entry.first != pDesc->pchName )
+		{
+			fprintf( stderr, "%s = %lld has no descriptor\n", entry.first.c_str(), (long long)entry.second );
+			g_nTestFailures++;
+		}
+	}
+	TEST_CHECK_EQUAL( nDescribable, k_unTrackedPropertyDescriptorCount );
+	TEST_CHECK( FindTrackedPropertyDescriptor( Prop_Invalid ) == nullptr );
+	TEST_CHECK( FindTrackedPropertyDescriptor( Prop_VendorSpecific_Reserved_Start ) == nullptr );
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: The compile time traits of one property agree with its descriptor
+//-----------------------------------------------------------------------------
+template < ETrackedDeviceProperty eProp, typename ExpectedValue_t >
+static void CheckTraits()
+{
+	typedef TrackedPropertyTraits< eProp > Traits_t;
+	static_assert( std::is_same< typename Traits_t::ValueType, ExpectedValue_t >::value, "property read as the wrong type" );
+	static_assert( k_TrackedPropertyDescriptors[ Traits_t::k_unIndex ].eProp == eProp, "k_unIndex doesn't point at the property's descriptor" );
+	static_assert( std::is_same< decltype( GetTrackedDeviceProperty< eProp >( nullptr, 0 ) ), ExpectedValue_t >::value, "GetTrackedDeviceProperty returns the wrong type" );
+}
+
+static void TestTraits()
+{
+	CheckTraits< Prop_WillDriftInYaw_Bool, bool >();
+	CheckTraits< Prop_DeviceBatteryPercentage_Float, float >();
+	CheckTraits< Prop_DeviceClass_Int32, int32_t >();
+	CheckTraits< Prop_HardwareRevision_Uint64, uint64_t >();
+	CheckTraits< Prop_ParentContainer, uint64_t >();
+	CheckTraits< Prop_SerialNumber_String, std::string >();
+	CheckTraits< Prop_StatusDisplayTransform_Matrix34, HmdMatrix34_t >();
+	CheckTraits< Prop_ImuFactoryGyroBias_Vector3, HmdVector3_t >();
+	CheckTraits< Prop_DisplayAvailableFrameRates_Float_Array, std::vector< float > >();
+	CheckTraits< Prop_CameraDistortionFunction_Int32_Array, std::vector< int32_t > >();
+	CheckTraits< Prop_CameraWhiteBalance_Vector4_Array, std::vector< HmdVector4_t > >();
+	CheckTraits< Prop_CameraToHeadTransforms_Matrix34_Array, std::vector< HmdMatrix34_t > >();
+	static_assert( TrackedPropertyTraits< Prop_CameraDistortionCoefficients_Float_Array >::k_unTag == k_unFloatPropertyTag, "" );
+	static_assert( TrackedPropertyTraits< Prop_CameraWhiteBalance_Vector4_Array >::k_unTag == k_unHmdVector4PropertyTag, "" );
+	static_assert( TrackedPropertyTraits< Prop_CameraToHeadTransforms_Matrix34_Array >::k_unTag == k_unHmdMatrix34PropertyTag, "" );
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Gives the mock a value for most descriptors, leaving every fifth one
+//			out so the snapshot sees missing properties too
+//-----------------------------------------------------------------------------
+static void FillDevice( CCountingVRSystem *pSystem )
+{
+	for ( uint32_t i = 0; i < k_unTrackedPropertyDescriptorCount; i++ )
+	{
+		const TrackedPropertyDescriptor_t &desc = k_TrackedPropertyDescriptors[ i ];
+		if ( i % 5 == 4 )
+		{
+			pSystem->Remove( desc.eProp );
+			continue;
+		}
+
+		switch ( desc.eKind )
+		{
+		case TrackedPropertyValueKind_Bool: pSystem->Set( desc.eProp, k_unBoolPropertyTag, ( i & 1 ) != 0 ); break;
+		case TrackedPropertyValueKind_Float: pSystem->Set( desc.eProp, k_unFloatPropertyTag, i * 0.5f ); break;
+		case TrackedPropertyValueKind_Int32: pSystem->Set( desc.eProp, k_unInt32PropertyTag, ( int32_t )i * 3 ); break;
+		case TrackedPropertyValueKind_Uint64: pSystem->Set( desc.eProp, k_unUint64PropertyTag, 0x100000000ull + i ); break;
+		case TrackedPropertyValueKind_String: pSystem->SetString( desc.eProp, std::string( "value of " ) + desc.pchName ); break;
+		case TrackedPropertyValueKind_Matrix34:
+		{
+			HmdMatrix34_t mat = {};
+			mat.m[ 0 ][ 3 ] = ( float )i;
+			pSystem->Set( desc.eProp, k_unHmdMatrix34PropertyTag, mat );
+			break;
+		}
+		case TrackedPropertyValueKind_Vector3:
+		{
+			HmdVector3_t v = { { ( float )i, 1, 2 } };
+			pSystem->Set( desc.eProp, k_unHmdVector3PropertyTag, v );
+			break;
+		}
+		case TrackedPropertyValueKind_FloatArray:
+		{
+			float rgfl[] = { 90.f, 120.f, ( float )i };
+			pSystem->Set( desc.eProp, k_unFloatPropertyTag, rgfl );
+			break;
+		}
+		case TrackedPropertyValueKind_Int32Array:
+		{
+			int32_t rgn[] = { 1, 2, ( int32_t )i };
+			pSystem->Set( desc.eProp, k_unInt32PropertyTag, rgn );
+			break;
+		}
+		case TrackedPropertyValueKind_Vector4Array:
+		{
+			HmdVector4_t rgv[ 2 ] = { { { ( float )i, 0, 0, 1 } }, { { 0, 1, 0, 1 } } };
+			pSystem->Set( desc.eProp, k_unHmdVector4PropertyTag, rgv );
+			break;
+		}
+		case TrackedPropertyValueKind_Matrix34Array:
+		{
+			HmdMatrix34_t rgmat[ 2 ] = {};
+			rgmat[ 1 ].m[ 1 ][ 3 ] = ( float )i;
+			pSystem->Set( desc.eProp, k_unHmdMatrix34PropertyTag, rgmat );
+			break;
+		}
+		}
+	}
+
+	// a few values too long for their inline buffers
+	pSystem->SetString( Prop_ModelNumber_String, std::string( 300, 'm' ) );
+	std::vector< float > vecRates( 100, 72.f );
+	pSystem->SetValue( Prop_DisplayAvailableFrameRates_Float_Array, k_unFloatPropertyTag, vecRates.data(), ( uint32_t )( vecRates.size() * sizeof( float ) ) );
+}
+
+static const uint32_t k_unLongValues = 2;
+
+static void TestTypedReads()
+{
+	CCountingVRSystem system;
+	FillDevice( &system );
+	bool bFlag = true;
+	system.Set( Prop_WillDriftInYaw_Bool, k_unBoolPropertyTag, bFlag );
+	system.Set( Prop_DeviceBatteryPercentage_Float, k_unFloatPropertyTag, 0.75f );
+	system.Set( Prop_DeviceClass_Int32, k_unInt32PropertyTag, ( int32_t )TrackedDeviceClass_HMD );
+	system.Set( Prop_HardwareRevision_Uint64, k_unUint64PropertyTag, 0x123456789ull );
+	system.SetString( Prop_SerialNumber_String, "LHR-12345678" );
+	HmdVector3_t vBias = { { 0.25f, -0.5f, 1.f } };
+	system.Set( Prop_ImuFactoryGyroBias_Vector3, k_unHmdVector3PropertyTag, vBias );
+	HmdMatrix34_t matStatus = {};
+	matStatus.m[ 2 ][ 3 ] = -1.5f;
+	system.Set( Prop_StatusDisplayTransform_Matrix34, k_unHmdMatrix34PropertyTag, matStatus );
+	int32_t rgnDistortion[] = { 4, 5, 6, 7 };
+	system.Set( Prop_CameraDistortionFunction_Int32_Array, k_unInt32PropertyTag, rgnDistortion );
+
+	ETrackedPropertyError eError = TrackedProp_ValueNotProvidedByDevice;
+	TEST_CHECK( GetTrackedDeviceProperty< Prop_WillDriftInYaw_Bool >( &system, k_unTrackedDeviceIndex_Hmd, &eError ) == true && eError == TrackedProp_Success );
+	TEST_CHECK( GetTrackedDeviceProperty< Prop_DeviceBatteryPercentage_Float >( &system, k_unTrackedDeviceIndex_Hmd ) == 0.75f );
+	TEST_CHECK( GetTrackedDeviceProperty< Prop_DeviceClass_Int32 >( &system, k_unTrackedDeviceIndex_Hmd ) == TrackedDeviceClass_HMD );
+	TEST_CHECK( GetTrackedDeviceProperty< Prop_HardwareRevision_Uint64 >( &system, k_unTrackedDeviceIndex_Hmd ) == 0x123456789ull );
+	TEST_CHECK( GetTrackedDeviceProperty< Prop_SerialNumber_String >( &system, k_unTrackedDeviceIndex_Hmd ) == "LHR-12345678" );
+	TEST_CHECK( GetTrackedDeviceProperty< Prop_StatusDisplayTransform_Matrix34 >( &system, k_unTrackedDeviceIndex_Hmd ).m[ 2 ][ 3 ] == -1.5f );
+	HmdVector3_t vRead = GetTrackedDeviceProperty< Prop_ImuFactoryGyroBias_Vector3 >( &system, k_unTrackedDeviceIndex_Hmd, &eError );
+	TEST_CHECK( eError == TrackedProp_Success && memcmp( &vRead, &vBias, sizeof( vBias ) ) == 0 );
+	std::vector< int32_t > vecDistortion = GetTrackedDeviceProperty< Prop_CameraDistortionFunction_Int32_Array >( &system, k_unTrackedDeviceIndex_Hmd, &eError );
+	TEST_CHECK( eError == TrackedProp_Success && vecDistortion == std::vector< int32_t >( rgnDistortion, rgnDistortion + 4 ) );
+	TEST_CHECK_EQUAL( system.m_nQueries, 8 );
+
+	// failures come back with the runtime's error and an empty value, still in one query each
+	system.m_nQueries = 0;
+	system.Remove( Prop_SerialNumber_String );
+	TEST_CHECK( GetTrackedDeviceProperty< Prop_SerialNumber_String >( &system, k_unTrackedDeviceIndex_Hmd, &eError ).empty() && eError == TrackedProp_UnknownProperty );
+	TEST_CHECK( GetTrackedDeviceProperty< Prop_CameraDistortionFunction_Int32_Array >( &system, 3, &eError ).empty() && eError == TrackedProp_InvalidDevice );
+	system.Set( Prop_ImuFactoryGyroBias_Vector3, k_unFloatPropertyTag, 1.f );
+	GetTrackedDeviceProperty< Prop_ImuFactoryGyroBias_Vector3 >( &system, k_unTrackedDeviceIndex_Hmd, &eError );
+	TEST_CHECK( eError == TrackedProp_WrongDataType );
+	TEST_CHECK_EQUAL( system.m_nQueries, 3 );
+}
+
+static void TestBufferGrowth()
+{
+	CCountingVRSystem system;
+	ETrackedPropertyError eError;
+
+	// a 256 byte inline buffer holds 255 characters and the terminator in one query
+	struct { ETrackedDeviceProperty eProp; uint32_t unInline; } rgProps[] =
+	{
+		{ Prop_SerialNumber_String, 256 },
+		{ Prop_Firmware_ManualUpdateURL_String, 1024 },
+	};
+	for ( const auto &prop : rgProps )
+	{
+		TEST_CHECK_EQUAL( FindTrackedPropertyDescriptor( prop.eProp )->unInlineBufferSize, prop.unInline );
+		for ( uint32_t unLength : { 0u, 1u, prop.unInline - 1, prop.unInline, prop.unInline + 1, 5000u } )
+		{
+			std::string sValue( unLength, 'x' );
+			if ( unLength > 0 )
+				sValue[ unLength - 1 ] = 'z';
+			system.SetString( prop.eProp, sValue );
+			system.m_nQueries = 0;
+			std::string sRead = prop.eProp == Prop_SerialNumber_String
+				? GetTrackedDeviceProperty< Prop_SerialNumber_String >( &system, k_unTrackedDeviceIndex_Hmd, &eError )
+				: GetTrackedDeviceProperty< Prop_Firmware_ManualUpdateURL_String >( &system, k_unTrackedDeviceIndex_Hmd, &eError );
+			TEST_CHECK( sRead == sValue && eError == TrackedProp_Success );
+			TEST_CHECK_EQUAL( system.m_nQueries, unLength < prop.unInline ? 1 : 2 );
+		}
+	}
+
+	// the untyped helper always starts with 256 bytes, whatever the property
+	system.SetString( Prop_Firmware_ManualUpdateURL_String, std::string( 600, 'u' ) );
+	system.m_nQueries = 0;
+	TEST_CHECK( GetTrackedDeviceStringProperty( &system, k_unTrackedDeviceIndex_Hmd, Prop_Firmware_ManualUpdateURL_String ) == std::string( 600, 'u' ) );
+	TEST_CHECK_EQUAL( system.m_nQueries, 2 );
+
+	// arrays grow the same way, to whole elements
+	for ( uint32_t unCount : { 0u, 64u, 65u, 100u } )
+	{
+		std::vector< float > vecValue( unCount );
+		for ( uint32_t i = 0; i < unCount; i++ )
+			vecValue[ i ] = i * 0.25f;
+		system.SetValue( Prop_DisplayAvailableFrameRates_Float_Array, k_unFloatPropertyTag, vecValue.data(), ( uint32_t )( unCount * sizeof( float ) ) );
+		system.m_nQueries = 0;
+		TEST_CHECK( GetTrackedDeviceProperty< Prop_DisplayAvailableFrameRates_Float_Array >( &system, k_unTrackedDeviceIndex_Hmd, &eError ) == vecValue );
+		TEST_CHECK( eError == TrackedProp_Success );
+		TEST_CHECK_EQUAL( system.m_nQueries, unCount * sizeof( float ) <= 256 ? 1 : 2 );
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: The string read from hellovr before it used the typed accessors:
+//			one query for the size and a second to fill a buffer of that size
+//-----------------------------------------------------------------------------
+static std::string GetTrackedDeviceStringTwoCall( IVRSystem *pSystem, TrackedDeviceIndex_t unDevice, TrackedDeviceProperty prop, TrackedPropertyError *peError = NULL )
+{
+	uint32_t unRequiredBufferLen = pSystem->GetStringTrackedDeviceProperty( unDevice, prop, NULL, 0, peError );
+	if ( unRequiredBufferLen == 0 )
+		return "";
+
+	char *pchBuffer = new char[ unRequiredBufferLen ];
+	unRequiredBufferLen = pSystem->GetStringTrackedDeviceProperty( unDevice, prop, pchBuffer, unRequiredBufferLen, peError );
+	std::string sResult = pchBuffer;
+	delete[] pchBuffer;
+	return sResult;
+}
+
+// Every descriptor read the same way: scalars directly, strings and arrays sized first
+static size_t ReadAllTwoCall( IVRSystem *pSystem, TrackedDeviceIndex_t unDevice )
+{
+	size_t unBytes = 0;
+	std::vector< char > vecArray;
+	for ( const TrackedPropertyDescriptor_t &desc : k_TrackedPropertyDescriptors )
+	{
+		switch ( desc.eKind )
+		{
+		case TrackedPropertyValueKind_Bool: unBytes += pSystem->GetBoolTrackedDeviceProperty( unDevice, desc.eProp ); break;
+		case TrackedPropertyValueKind_Float: unBytes += pSystem->GetFloatTrackedDeviceProperty( unDevice, desc.eProp ) != 0; break;
+		case TrackedPropertyValueKind_Int32: unBytes += pSystem->GetInt32TrackedDeviceProperty( unDevice, desc.eProp ) != 0; break;
+		case TrackedPropertyValueKind_Uint64: unBytes += pSystem->GetUint64TrackedDeviceProperty( unDevice, desc.eProp ) != 0; break;
+		case TrackedPropertyValueKind_Matrix34: unBytes += pSystem->GetMatrix34TrackedDeviceProperty( unDevice, desc.eProp ).m[ 0 ][ 3 ] != 0; break;
+		case TrackedPropertyValueKind_String: unBytes += GetTrackedDeviceStringTwoCall( pSystem, unDevice, desc.eProp ).size(); break;
+		case TrackedPropertyValueKind_Vector3:
+		{
+			HmdVector3_t v;
+			unBytes += pSystem->GetArrayTrackedDeviceProperty( unDevice, desc.eProp, k_unHmdVector3PropertyTag, &v, sizeof( v ) );
+			break;
+		}
+		default:
+		{
+			PropertyTypeTag_t unTag = desc.eKind == TrackedPropertyValueKind_FloatArray ? k_unFloatPropertyTag
+				: desc.eKind == TrackedPropertyValueKind_Int32Array ? k_unInt32PropertyTag
+				: desc.eKind == TrackedPropertyValueKind_Vector4Array ? k_unHmdVector4PropertyTag : k_unHmdMatrix34PropertyTag;
+			uint32_t unRequired = pSystem->GetArrayTrackedDeviceProperty( unDevice, desc.eProp, unTag, NULL, 0 );
+			if ( unRequired == 0 )
+				break;
+			vecArray.resize( unRequired );
+			unBytes += pSystem->GetArrayTrackedDeviceProperty( unDevice, desc.eProp, unTag, vecArray.data(), unRequired );
+			break;
+		}
+		}
+	}
+	return unBytes;
+}
+
+static void TestSnapshot()
+{
+	CCountingVRSystem system;
+	FillDevice( &system );
+
+	CTrackedDevicePropertySnapshot snapshot;
+	uint32_t unProvided = snapshot.Capture( &system, k_unTrackedDeviceIndex_Hmd );
+	TEST_CHECK_EQUAL( unProvided, k_unTrackedPropertyDescriptorCount - k_unTrackedPropertyDescriptorCount / 5 );
+	TEST_CHECK_EQUAL( snapshot.GetQueryCount(), system.m_nQueries );
+	TEST_CHECK_EQUAL( snapshot.GetQueryCount(), k_unTrackedPropertyDescriptorCount + k_unLongValues );
+
+	// the snapshot holds what each typed read returns
+	for ( uint32_t i = 0; i < k_unTrackedPropertyDescriptorCount; i++ )
+	{
+		const TrackedPropertyDescriptor_t &desc = k_TrackedPropertyDescriptors[ i ];
+		ETrackedPropertyError eError;
+		bool bMatches = true;
+		switch ( desc.eKind )
+		{
+		case TrackedPropertyValueKind_Bool: bMatches = snapshot.GetBool( desc.eProp ) == system.GetBoolTrackedDeviceProperty( 0, desc.eProp, &eError ); break;
+		case TrackedPropertyValueKind_Float: bMatches = snapshot.GetFloat( desc.eProp ) == system.GetFloatTrackedDeviceProperty( 0, desc.eProp, &eError ); break;
+		case TrackedPropertyValueKind_Int32: bMatches = snapshot.GetInt32( desc.eProp ) == system.GetInt32TrackedDeviceProperty( 0, desc.eProp, &eError ); break;
+		case TrackedPropertyValueKind_Uint64: bMatches = snapshot.GetUint64( desc.eProp ) == system.GetUint64TrackedDeviceProperty( 0, desc.eProp, &eError ); break;
+		case TrackedPropertyValueKind_Matrix34:
+		{
+			HmdMatrix34_t mat = system.GetMatrix34TrackedDeviceProperty( 0, desc.eProp, &eError );
+			HmdMatrix34_t matSnapshot = snapshot.GetMatrix34( desc.eProp );
+			bMatches = eError != TrackedProp_Success || memcmp( &mat, &matSnapshot, sizeof( mat ) ) == 0;
+			break;
+		}
+		case TrackedPropertyValueKind_Vector3:
+		{
+			HmdVector3_t v = {};
+			system.GetArrayTrackedDeviceProperty( 0, desc.eProp, k_unHmdVector3PropertyTag, &v, sizeof( v ), &eError );
+			HmdVector3_t vSnapshot = snapshot.GetVector3( desc.eProp );
+			bMatches = memcmp( &v, &vSnapshot, sizeof( v ) ) == 0;
+			break;
+		}
+		case TrackedPropertyValueKind_String: bMatches = GetTrackedDeviceStringTwoCall( &system, 0, desc.eProp, &eError ) == snapshot.GetString( desc.eProp ); break;
+		default:
+		{
+			uint32_t unSize = 0;
+			const void *pData = snapshot.GetArray( desc.eProp, &unSize );
+			std::vector< char > vecValue( 4096 );
+			PropertyTypeTag_t unTag = desc.eKind == TrackedPropertyValueKind_FloatArray ? k_unFloatPropertyTag
+				: desc.eKind == TrackedPropertyValueKind_Int32Array ? k_unInt32PropertyTag
+				: desc.eKind == TrackedPropertyValueKind_Vector4Array ? k_unHmdVector4PropertyTag : k_unHmdMatrix34PropertyTag;
+			uint32_t unExpected = system.GetArrayTrackedDeviceProperty( 0, desc.eProp, unTag, vecValue.data(), ( uint32_t )vecValue.size(), &eError );
+			bMatches = eError != TrackedProp_Success ? pData == nullptr && unSize == 0 : unSize == unExpected && memcmp( pData, vecValue.data(), unSize ) == 0;
+			break;
+		}
+		}
+		bool bErrorMatches = snapshot.GetError( desc.eProp ) == eError;
+		if ( !bMatches || !bErrorMatches )
+		{
+			fprintf( stderr, "snapshot of %s doesn't match the device\n", desc.pchName );
+			g_nTestFailures++;
+		}
+	}
+	TEST_CHECK( snapshot.GetError( Prop_Invalid ) == TrackedProp_UnknownProperty );
+	TEST_CHECK( strcmp( snapshot.GetString( Prop_DeviceClass_Int32 ), "" ) == 0 );
+
+	// the two-call code pays a sizing query for every string and array the device has
+	uint32_t unTwoCallExpected = 0;
+	for ( uint32_t i = 0; i < k_unTrackedPropertyDescriptorCount; i++ )
+	{
+		const TrackedPropertyDescriptor_t &desc = k_TrackedPropertyDescriptors[ i ];
+		bool bBuffered = desc.eKind == TrackedPropertyValueKind_String || BIsArrayKind( desc.eKind );
+		unTwoCallExpected += bBuffered && i % 5 != 4 ? 2 : 1;
+	}
+	system.m_nQueries = 0;
+	ReadAllTwoCall( &system, k_unTrackedDeviceIndex_Hmd );
+	TEST_CHECK_EQUAL( system.m_nQueries, unTwoCallExpected );
+	printf( "every property of a device: %u queries two-call, %u with the snapshot\n", unTwoCallExpected, snapshot.GetQueryCount() );
+	TEST_CHECK( snapshot.GetQueryCount() < unTwoCallExpected );
+
+	// hellovr's two strings per device
+	system.m_nQueries = 0;
+	std::string sDriver = GetTrackedDeviceStringTwoCall( &system, 0, Prop_TrackingSystemName_String );
+	std::string sDisplay = GetTrackedDeviceStringTwoCall( &system, 0, Prop_SerialNumber_String );
+	TEST_CHECK_EQUAL( system.m_nQueries, 4 );
+	system.m_nQueries = 0;
+	TEST_CHECK( GetTrackedDeviceStringProperty( &system, 0, Prop_TrackingSystemName_String ) == sDriver );
+	TEST_CHECK( GetTrackedDeviceStringProperty( &system, 0, Prop_SerialNumber_String ) == sDisplay );
+	TEST_CHECK_EQUAL( system.m_nQueries, 2 );
+
+	// capturing again reads the new values into the same snapshot
+	system.SetString( Prop_SerialNumber_String, "replaced" );
+	system.m_nQueries = 0;
+	snapshot.Capture( &system, k_unTrackedDeviceIndex_Hmd );
+	TEST_CHECK( strcmp( snapshot.GetString( Prop_SerialNumber_String ), "replaced" ) == 0 );
+	TEST_CHECK_EQUAL( snapshot.GetQueryCount(), system.m_nQueries );
+}
+
+template < typename Read_t >
+static double BenchNsPerRun( int nRuns, Read_t read )
+{
+	size_t unSink = 0;
+	auto start = std::chrono::steady_clock::now();
+	for ( int i = 0; i < nRuns; i++ )
+		unSink += read();
+	double flNs = BenchSecondsSince( start ) * 1e9 / nRuns;
+	TEST_CHECK( unSink > 0 );
+	return flNs;
+}
+
+static void BenchmarkReads()
+{
+	CCountingVRSystem system;
+	FillDevice( &system );
+	CTrackedDevicePropertySnapshot snapshot;
+
+	// free calls show the cost of the helpers themselves; a runtime call is a round trip to vrserver
+	for ( int nCallCostNs : { 0, 2000 } )
+	{
+		system.m_callCost = std::chrono::nanoseconds( nCallCostNs );
+		int nStringRuns = ( BenchFull() ? 1000000 : 100000 ) / ( nCallCostNs ? 50 : 1 );
+		int nDeviceRuns = ( BenchFull() ? 20000 : 2000 ) / ( nCallCostNs ? 50 : 1 );
+
+		double flTwoCallNs = BenchNsPerRun( nStringRuns, [ & ]()
+		{
+			return GetTrackedDeviceStringTwoCall( &system, 0, Prop_TrackingSystemName_String ).size() + GetTrackedDeviceStringTwoCall( &system, 0, Prop_SerialNumber_String ).size();
+		} );
+		double flTypedNs = BenchNsPerRun( nStringRuns, [ & ]()
+		{
+			return GetTrackedDeviceProperty< Prop_TrackingSystemName_String >( &system, 0 ).size() + GetTrackedDeviceProperty< Prop_SerialNumber_String >( &system, 0 ).size();
+		} );
+		double flReadAllNs = BenchNsPerRun( nDeviceRuns, [ & ]() { return ReadAllTwoCall( &system, 0 ); } );
+		double flCaptureNs = BenchNsPerRun( nDeviceRuns, [ & ]() { return ( size_t )snapshot.Capture( &system, 0 ); } );
+
+		printf( "call cost %4d ns: hellovr strings %8.0f ns two-call, %8.0f ns typed; every property %9.0f ns two-call, %9.0f ns snapshot\n",
+			nCallCostNs, flTwoCallNs, flTypedNs, flReadAllNs, flCaptureNs );
+	}
+}
+
+int main()
+{
+	TestDescriptors();
+	TestTraits();
+	TestTypedReads();
+	TestBufferGrowth();
+	TestSnapshot();
+	BenchmarkReads();
+	return TestResult( "properties_test" );
+}
@@ -0,0 +1,189 @@
+//========= Copyright Valve Corporation ============//
+// The shared library registry against stub modules built next to this test: different spellings
+// of one path share a load, references are counted down to a real unload, symbol lookups are
+// cached (misses too), and a lazily bound module is bound fully when it's loaded again without
+// the flag. Then times eager against lazy loads and cached lookups against dlsym.
+#include <vrcore/sharedlibtools_public.h>
+#include "test_common.h"
+
+#include <dlfcn.h>
+#include <sys/stat.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+typedef int ( *StubFn_t )( int );
+
+// true if the OS loader still has the module mapped, without adding a reference
+static bool BIsMapped( const std::string &sPath )
+{
+	void *pHandle = dlopen( sPath.c_str(), RTLD_NOW | RTLD_NOLOAD );
+	if ( pHandle )
+		dlclose( pHandle );
+	return pHandle != nullptr;
+}
+
+static bool CopyFile( const char *pchFrom, const std::string &sTo )
+{
+	FILE *pFrom = fopen( pchFrom, "rb" );
+	FILE *pTo = fopen( sTo.c_str(), "wb" );
+	bool bOK = pFrom && pTo;
+	char rchBuffer[ 4096 ];
+	while ( bOK )
+	{
+		size_t unRead = fread( rchBuffer, 1, sizeof( rchBuffer ), pFrom );
+		if ( unRead == 0 )
+			break;
+		bOK = fwrite( rchBuffer, 1, unRead, pTo ) == unRead;
+	}
+	if ( pFrom )
+		fclose( pFrom );
+	if ( pTo )
+		fclose( pTo );
+	return bOK;
+}
+
+static void TestLoadAndUnload( const CTestTempDir &tempDir )
+{
+	std::string sPath = STUB_SHAREDLIB_PATH;
+	std::string sDir = sPath.substr( 0, sPath.rfind( '/' ) );
+	std::string sDotted = sDir + "/./" + sPath.substr( sDir.size() + 1 );
+	std::string sLink = tempDir.Path( "link.so" );
+	std::string sCopy = tempDir.Path( "copy.so" );
+	TEST_CHECK( symlink( sPath.c_str(), sLink.c_str() ) == 0 );
+	TEST_CHECK( CopyFile( STUB_SHAREDLIB_PATH, sCopy ) );
+	TEST_CHECK( !BIsMapped( sPath ) );
+
+	SharedLibHandle hModule = SharedLib_Load( sPath.c_str() );
+	SharedLibHandle hDotted = SharedLib_Load( sDotted.c_str() );
+	SharedLibHandle hLink = SharedLib_Load( sLink.c_str() );
+	TEST_CHECK( hModule && hModule == hDotted && hModule == hLink );
+	SharedLibStats_t stats;
+	TEST_CHECK( SharedLib_GetStats( hModule, &stats ) );
+	TEST_CHECK_EQUAL( stats.unRefCount, 3 );
+	TEST_CHECK_EQUAL( stats.unLoadCalls, 3 );
+
+	// a copy is another module
+	SharedLibHandle hCopy = SharedLib_Load( sCopy.c_str() );
+	TEST_CHECK( hCopy && hCopy != hModule );
+
+	StubFn_t pfnDouble = ( StubFn_t )SharedLib_GetFunction( hModule, "StubSharedLib_Double" );
+	TEST_CHECK( pfnDouble && pfnDouble( 4 ) == 8 );
+	TEST_CHECK( SharedLib_GetFunction( hModule, "StubSharedLib_Double" ) == ( void * )pfnDouble );
+	TEST_CHECK( SharedLib_GetFunction( hCopy, "StubSharedLib_Double" ) != ( void * )pfnDouble );
+	TEST_CHECK( !SharedLib_GetFunction( hModule, "StubSharedLib_Missing" ) );
+	TEST_CHECK( !SharedLib_GetFunction( hModule, "StubSharedLib_Missing" ) );
+	TEST_CHECK( SharedLib_GetStats( hModule, &stats ) );
+	TEST_CHECK_EQUAL( stats.unSymbolLookups, 4 );
+	TEST_CHECK_EQUAL( stats.unSymbolCacheHits, 2 );
+	TEST_CHECK_EQUAL( stats.unCachedSymbols, 2 );
+
+	std::string sErr;
+	TEST_CHECK( !SharedLib_Load( tempDir.Path( "missing.so" ).c_str(), &sErr ) );
+	TEST_CHECK( !sErr.empty() );
+
+	// only the last reference unloads
+	SharedLib_Unload( hDotted );
+	SharedLib_Unload( hLink );
+	TEST_CHECK( BIsMapped( sPath ) );
+	SharedLib_Unload( hModule );
+	TEST_CHECK( !SharedLib_GetStats( hModule, &stats ) );
+	TEST_CHECK( !BIsMapped( sPath ) );
+	TEST_CHECK( BIsMapped( sCopy ) );
+	SharedLib_Unload( hCopy );
+	TEST_CHECK( !BIsMapped( sCopy ) );
+}
+
+static void TestLazyBinding()
+{
+	const char *pchLastImport = STUB_SHAREDLIB_LAST_IMPORT;
+	SharedLibHandle hLazy = SharedLib_Load( STUB_SHAREDLIB_IMPORTS_PATH, nullptr, k_ESharedLibLoad_LazyBinding );
+	SharedLibStats_t stats;
+	TEST_CHECK( hLazy && SharedLib_GetStats( hLazy, &stats ) && stats.bLazyBinding );
+	StubFn_t pfnImport = ( StubFn_t )SharedLib_GetFunction( hLazy, pchLastImport );
+	TEST_CHECK( pfnImport && pfnImport( 1 ) == STUB_SHAREDLIB_IMPORTS );
+
+	SharedLibHandle hEager = SharedLib_Load( STUB_SHAREDLIB_IMPORTS_PATH );
+	TEST_CHECK( hEager == hLazy );
+	TEST_CHECK( SharedLib_GetStats( hEager, &stats ) && !stats.bLazyBinding );
+	TEST_CHECK_EQUAL( stats.unRefCount, 2 );
+	SharedLib_Unload( hEager );
+	SharedLib_Unload( hLazy );
+	TEST_CHECK( !BIsMapped( STUB_SHAREDLIB_IMPORTS_PATH ) );
+}
+
+static void TestConcurrentLoads()
+{
+	std::atomic< int > nFailures( 0 );
+	std::vector< std::thread > threads;
+	for ( int t = 0; t < 8; t++ )
+	{
+		threads.emplace_back( [ &nFailures ]
+		{
+			for ( int i = 0; i < 500; i++ )
+			{
+				SharedLibHandle hModule = SharedLib_Load( STUB_SHAREDLIB_PATH );
+				if ( !hModule || !SharedLib_GetFunction( hModule, "StubSharedLib_Double" ) )
+					nFailures++;
+				SharedLib_Unload( hModule );
+			}
+		} );
+	}
+	for ( std::thread &thread : threads )
+		thread.join();
+	TEST_CHECK_EQUAL( nFailures.load(), 0 );
+	TEST_CHECK( !BIsMapped( STUB_SHAREDLIB_PATH ) );
+}
+
+static void BenchmarkLoads()
+{
+	const char *pchLastImport = STUB_SHAREDLIB_LAST_IMPORT;
+	int nLoads = BenchFull() ? 50 : 5;
+	for ( uint32_t unFlags : { ( uint32_t )k_ESharedLibLoad_Default, ( uint32_t )k_ESharedLibLoad_LazyBinding } )
+	{
+		uint64_t ulLoadTimeUs = 0;
+		uint64_t ulMinorPageFaults = 0;
+		for ( int i = 0; i < nLoads; i++ )
+		{
+			SharedLibHandle hModule = SharedLib_Load( STUB_SHAREDLIB_IMPORTS_PATH, nullptr, unFlags );
+			SharedLibStats_t stats;
+			TEST_CHECK( hModule && SharedLib_GetStats( hModule, &stats ) );
+			ulLoadTimeUs += stats.ulLoadTimeUs;
+			ulMinorPageFaults += stats.ulMinorPageFaults;
+			SharedLib_Unload( hModule );
+		}
+		printf( "%s load of a module with %d imports: %.1f us, %.1f minor page faults\n", unFlags ? "lazy" : "eager",
+			STUB_SHAREDLIB_IMPORTS, ( double )ulLoadTimeUs / nLoads, ( double )ulMinorPageFaults / nLoads );
+	}
+
+	SharedLibHandle hModule = SharedLib_Load( STUB_SHAREDLIB_IMPORTS_PATH );
+	void *pOSHandle = dlopen( STUB_SHAREDLIB_IMPORTS_PATH, RTLD_NOW );
+	int nLookups = BenchFull() ? 1000000 : 100000;
+	void *pCached = nullptr;
+	auto start = std::chrono::steady_clock::now();
+	for ( int i = 0; i < nLookups; i++ )
+		pCached = SharedLib_GetFunction( hModule, pchLastImport );
+	double flCachedNs = BenchSecondsSince( start ) * 1e9 / nLookups;
+	void *pDlsym = nullptr;
+	start = std::chrono::steady_clock::now();
+	for ( int i = 0; i < nLookups; i++ )
+	{
+		pDlsym = dlsym( pOSHandle, pchLastImport );
+		asm volatile( "" : : "r"( pDlsym ) );
+	}
+	double flDlsymNs = BenchSecondsSince( start ) * 1e9 / nLookups;
+	TEST_CHECK( pCached && pCached == pDlsym );
+	printf( "SharedLib_GetFunction %.1f ns, dlsym %.1f ns\n", flCachedNs, flDlsymNs );
+	dlclose( pOSHandle );
+	SharedLib_Unload( hModule );
+}
+
+int main()
+{
+	CTestTempDir tempDir;
+	TestLoadAndUnload( tempDir );
+	TestLazyBinding();
+	TestConcurrentLoads();
+	BenchmarkLoads();
+	return TestResult( "sharedlibtools_test" );
+}
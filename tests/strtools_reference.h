@@ -0,0 +1,152 @@
+//========= Copyright Valve Corporation ============//
+#pragma once
+
+// The codecvt based UTF conversions and RepairUTF8 as they were before strtools got its own
+// converters, kept verbatim as the reference for strtools_utf_test.
+
+#include <codecvt>
+#include <locale>
+#include <string>
+
+namespace StrReference
+{
+
+//-----------------------------------------------------------------------------
+// Purpose: Converts a UTF-16 formatted string to a UTF-8 formatted string
+//-----------------------------------------------------------------------------
+inline std::string UTF16to8( const std::wstring &in )
+{
+	static std::wstring_convert< std::codecvt_utf8_utf16< wchar_t >, wchar_t > s_convert; // construction of this can be expensive (or even serialized) depending on locale
+
+	try
+	{
+		return s_convert.to_bytes( in );
+	}
+	catch ( ... )
+	{
+		return std::string();
+	}
+}
+
+inline std::string UTF16to8( const wchar_t * in )
+{
+	if (in == nullptr)
+	{
+		return std::string();
+	}
+
+	std::wstring wstr( in );
+	return UTF16to8( wstr );
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Converts a UTF-8 formatted string to a UTF-16 formatted string
+//-----------------------------------------------------------------------------
+inline std::wstring UTF8to16( const std::string &in )
+{
+	static std::wstring_convert< std::codecvt_utf8_utf16< wchar_t >, wchar_t > s_convert; // construction of this can be expensive (or even serialized) depending on locale
+
+	try
+	{
+		return s_convert.from_bytes( in );
+	}
+	catch ( ... )
+	{
+		return std::wstring();
+	}
+}
+
+inline std::wstring UTF8to16( const char * in )
+{
+	if ( in == nullptr )
+	{
+		return std::wstring();
+	}
+
+	std::string str( in );
+	return UTF8to16( str );
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Repairs a should-be-UTF-8 string to a for-sure-is-UTF-8 string, plus return boolean if we subbed in '?' somewhere
+//-----------------------------------------------------------------------------
+inline bool RepairUTF8( const char *pbegin, const char *pend, std::string & sOutputUtf8 )
+{
+	typedef std::codecvt_utf8<char32_t> facet_type;
+	facet_type myfacet;
+
+	std::mbstate_t mystate = std::mbstate_t();
+
+	sOutputUtf8.clear();
+	sOutputUtf8.reserve( pend - pbegin );
+	bool bSqueakyClean = true;
+
+	const char *pmid = pbegin;
+	while ( pmid != pend )
+	{
+		bool bHasError = false;
+		bool bHasValidData = false;
+
+		char32_t out = 0xdeadbeef, *pout;
+		pbegin = pmid;
+		switch ( myfacet.in( mystate, pbegin, pend, pmid, &out, &out + 1, pout ) )
+		{
+		case facet_type::ok:
+			bHasValidData = true;
+			break;
+
+		case facet_type::noconv:
+			// unexpected! always converting type
+			bSqueakyClean = false;
+			break;
+
+		case facet_type::partial:
+			bHasError = pbegin == pmid;
+			if ( bHasError )
+			{
+				bSqueakyClean = false;
+			}
+			else
+			{
+				bHasValidData = true;
+			}
+			break;
+
+		case facet_type::error:
+			bHasError = true;
+			bSqueakyClean = false;
+			break;
+		}
+
+		if ( bHasValidData )
+		{
+			// could convert back, but no need
+			for ( const char *p = pbegin; p != pmid; ++p )
+			{
+				sOutputUtf8 += *p;
+			}
+		}
+
+		if ( bHasError )
+		{
+			sOutputUtf8 += '?';
+		}
+
+		if ( pmid == pbegin )
+		{
+			pmid++;
+		}
+	}
+
+	return bSqueakyClean;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Repairs a should-be-UTF-8 string to a for-sure-is-UTF-8 string, plus return boolean if we subbed in '?' somewhere
+//-----------------------------------------------------------------------------
+inline bool RepairUTF8( const std::string & sInputUtf8, std::string & sOutputUtf8 )
+{
+	return RepairUTF8( sInputUtf8.data(), sInputUtf8.data() + sInputUtf8.size(), sOutputUtf8 );
+}
+
+} // namespace StrReference
@@ -0,0 +1,97 @@
+//========= Copyright Valve Corporation ============//
+// URL encode/decode: every byte pair round-trips in each mode with the exact predicted length,
+// chunked decoding matches whole-payload decoding, and file URLs stop at an escaped NUL.
+#include <vrcore/strtools_public.h>
+#include <vrcore/pathtools_public.h>
+#include "test_common.h"
+
+#include <algorithm>
+#include <random>
+
+static std::string Encode( const std::string &s, EURLEncodeMode eMode )
+{
+	switch ( eMode )
+	{
+	case k_EURLEncodeMode_Form: return V_URLEncode( s );
+	case k_EURLEncodeMode_Component: return V_URLEncodeNoPlusForSpace( s );
+	default: return V_URLEncodeFullPath( s );
+	}
+}
+
+static void TestRoundTrip()
+{
+	for ( int nMode = 0; nMode < k_EURLEncodeMode_Count; nMode++ )
+	{
+		EURLEncodeMode eMode = (EURLEncodeMode)nMode;
+		for ( int a = 0; a < 256; a++ )
+		{
+			for ( int b = 0; b < 256; b++ )
+			{
+				std::string s;
+				s += (char)a;
+				s += (char)b;
+				std::string sEncoded = Encode( s, eMode );
+				TEST_CHECK( sEncoded.size() == V_URLEncodedLength( s.data(), s.size(), eMode ) );
+
+				std::string sDecoded = eMode == k_EURLEncodeMode_Form ? V_URLDecode( sEncoded ) : V_URLDecodeNoPlusForSpace( sEncoded );
+				if ( sDecoded != s )
+				{
+					fprintf( stderr, "mode %d: 0x%02x 0x%02x didn't round trip\n", nMode, a, b );
+					g_nTestFailures++;
+				}
+			}
+		}
+	}
+
+	// the C buffer form succeeds whenever the result and its terminator fit
+	char rchBuffer[ 4 ];
+	V_URLEncode( rchBuffer, sizeof( rchBuffer ), " ", 1 );
+	TEST_CHECK( std::string( rchBuffer ) == "+" );
+	V_URLEncode( rchBuffer, sizeof( rchBuffer ), "/", 1 );
+	TEST_CHECK( std::string( rchBuffer ) == "%2F" );
+}
+
+static void TestStream()
+{
+	std::mt19937 rng( 5 );
+	const char k_rchAlphabet[] = "%+ aZ09/:.-_~%%%fF0gG";
+	for ( int nIteration = 0; nIteration < 20000; nIteration++ )
+	{
+		std::string sEncoded;
+		int nLength = rng() % 32;
+		for ( int i = 0; i < nLength; i++ )
+			sEncoded += k_rchAlphabet[ rng() % ( sizeof( k_rchAlphabet ) - 1 ) ];
+
+		CURLDecodeStream stream;
+		std::string sDecoded;
+		size_t unOffset = 0;
+		while ( unOffset < sEncoded.size() )
+		{
+			size_t unChunk = std::min< size_t >( 1 + rng() % 4, sEncoded.size() - unOffset );
+			stream.Append( sEncoded.data() + unOffset, unChunk, sDecoded );
+			unOffset += unChunk;
+		}
+		TEST_CHECK( sDecoded == V_URLDecode( sEncoded ) );
+	}
+}
+
+static void TestFileUrls()
+{
+	TEST_CHECK( Path_UrlToFilePath( "file:///tmp/a%20b/c.json" ) == Path_FixSlashes( "/tmp/a b/c.json" ) );
+	TEST_CHECK( Path_UrlToFilePath( "FILE:///tmp/x" ) == Path_FixSlashes( "/tmp/x" ) );
+	TEST_CHECK( Path_UrlToFilePath( "http://example.com/x" ).empty() );
+
+	// an escaped NUL ends the path instead of hiding the rest of it behind the terminator
+	std::string sPath = Path_UrlToFilePath( "file:///tmp/safe.json%00/../../etc/passwd" );
+	TEST_CHECK( sPath == Path_FixSlashes( "/tmp/safe.json" ) );
+	TEST_CHECK( sPath.find( '\0' ) == std::string::npos );
+	TEST_CHECK( Path_UrlToFilePath( "file://%00" ).empty() );
+}
+
+int main()
+{
+	TestRoundTrip();
+	TestStream();
+	TestFileUrls();
+	return TestResult( "strtools_url_test" );
+}
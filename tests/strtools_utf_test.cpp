@@ -0,0 +1,167 @@
+//========= Copyright Valve Corporation ============//
+// Fuzzes UTF8to16, UTF16to8 and RepairUTF8 (string, buffer and in-place forms) against the
+// codecvt versions they replaced, then measures throughput of both in MB/s.
+#include <vrcore/strtools_public.h>
+#include "strtools_reference.h"
+#include "test_common.h"
+
+#include <random>
+#include <vector>
+
+static const unsigned char k_rucInterestingBytes[] =
+{
+	0x00, 0x41, 0x7f, 0x80, 0x8f, 0x90, 0x9f, 0xa0, 0xbf, 0xc0, 0xc1, 0xc2, 0xdf, 0xe0,
+	0xe1, 0xec, 0xed, 0xee, 0xef, 0xf0, 0xf1, 0xf3, 0xf4, 0xf5, 0xf7, 0xf8, 0xfe, 0xff,
+};
+
+static std::string RandomBytes( std::mt19937 &rng )
+{
+	std::string s;
+	int nLength = rng() % 40;
+	for ( int i = 0; i < nLength; i++ )
+	{
+		if ( rng() % 3 == 0 )
+			s += (char)( 'a' + rng() % 26 );
+		else if ( rng() % 2 )
+			s += (char)k_rucInterestingBytes[ rng() % sizeof( k_rucInterestingBytes ) ];
+		else
+			s += (char)( rng() & 0xff );
+	}
+	return s;
+}
+
+static std::wstring RandomUnits( std::mt19937 &rng )
+{
+	std::wstring ws;
+	int nLength = rng() % 20;
+	for ( int i = 0; i < nLength; i++ )
+	{
+		switch ( rng() % 6 )
+		{
+		case 0: ws += (wchar_t)( 'a' + rng() % 26 ); break;
+		case 1: ws += (wchar_t)( 0xD800 + rng() % 0x800 ); break;
+		case 2: ws += (wchar_t)( rng() % 0x800 ); break;
+		case 3: ws += (wchar_t)( rng() % 0x10000 ); break;
+		case 4: ws += (wchar_t)( rng() % 0x120000 ); break;
+		default: ws += (wchar_t)rng(); break;
+		}
+	}
+	return ws;
+}
+
+static int g_nReported = 0;
+
+static void Mismatch( const char *pchFunction, size_t unInputLength )
+{
+	g_nTestFailures++;
+	if ( g_nReported++ < 10 )
+		fprintf( stderr, "%s differs from the reference for a %zu unit input\n", pchFunction, unInputLength );
+}
+
+static void FuzzAgainstReference( int nIterations )
+{
+	std::mt19937 rng( 1 );
+	for ( int nIteration = 0; nIteration < nIterations; nIteration++ )
+	{
+		std::string s = RandomBytes( rng );
+
+		std::string sExpected, sRepaired;
+		bool bExpectedClean = StrReference::RepairUTF8( s, sExpected );
+		if ( RepairUTF8( s, sRepaired ) != bExpectedClean || sRepaired != sExpected )
+			Mismatch( "RepairUTF8", s.size() );
+
+		// the buffer form writes exactly as many bytes as it reads, so check it only where the
+		// reference did the same (a '?' stands in for every bad byte)
+		std::string sInPlace = s;
+		bool bInPlaceClean = RepairUTF8( &sInPlace[ 0 ], &sInPlace[ 0 ] + sInPlace.size(), &sInPlace[ 0 ] );
+		if ( bInPlaceClean != bExpectedClean || ( sExpected.size() == s.size() && sInPlace != sExpected ) )
+			Mismatch( "RepairUTF8 in place", s.size() );
+		if ( IsValidUTF8( s.data(), s.data() + s.size() ) != bExpectedClean )
+			Mismatch( "IsValidUTF8", s.size() );
+
+		std::wstring wsExpected = StrReference::UTF8to16( s );
+		if ( UTF8to16( s ) != wsExpected )
+			Mismatch( "UTF8to16", s.size() );
+
+		size_t unRequired = 0;
+		wchar_t rwchBuffer[ 64 ];
+		if ( UTF8to16( s.data(), s.size(), rwchBuffer, 64, &unRequired ) && std::wstring( rwchBuffer, unRequired ) != UTF8to16( s ) )
+			Mismatch( "UTF8to16 into a buffer", s.size() );
+
+		std::wstring ws = RandomUnits( rng );
+		std::string sExpected8 = StrReference::UTF16to8( ws );
+		if ( UTF16to8( ws ) != sExpected8 )
+			Mismatch( "UTF16to8", ws.size() );
+
+		char rchBuffer[ 128 ];
+		if ( UTF16to8( ws.data(), ws.size(), rchBuffer, sizeof( rchBuffer ), &unRequired ) && std::string( rchBuffer, unRequired ) != UTF16to8( ws ) )
+			Mismatch( "UTF16to8 into a buffer", ws.size() );
+
+		// a buffer that is too small reports the size it needed without overrunning
+		if ( sExpected8.size() > 1 )
+		{
+			char rchSmall[ 2 ] = { 'x', 'x' };
+			UTF16to8( ws.data(), ws.size(), rchSmall, 1, &unRequired );
+			if ( unRequired != sExpected8.size() || rchSmall[ 1 ] != 'x' )
+				Mismatch( "UTF16to8 into a short buffer", ws.size() );
+		}
+
+		if ( !sExpected8.empty() && StrReference::UTF8to16( sExpected8 ) != UTF8to16( sExpected8 ) )
+			Mismatch( "UTF8to16 round trip", sExpected8.size() );
+	}
+}
+
+// Mostly ASCII with some accented and CJK text, like a localization table
+static std::string BuildBenchmarkText( size_t unSize )
+{
+	std::string sText;
+	sText.reserve( unSize + 8 );
+	static const char *k_rpchWords[] = { "settings ", "controller ", "\xc3\xa9tat ", "\xe8\xae\xbe\xe7\xbd\xae ", "battery ", "m\xc3\xbcnchen ", "\xf0\x9f\x8e\xae " };
+	uint32_t unWord = 0;
+	while ( sText.size() < unSize )
+	{
+		sText += k_rpchWords[ ( unWord >> 16 ) % 7 ];
+		unWord = unWord * 1103515245u + 12345u;
+	}
+	return sText;
+}
+
+template< typename Fn >
+static double MeasureMBps( size_t unBytes, int nRounds, Fn fn )
+{
+	auto start = std::chrono::steady_clock::now();
+	for ( int i = 0; i < nRounds; i++ )
+		fn();
+	return unBytes * (double)nRounds / ( 1024.0 * 1024.0 ) / BenchSecondsSince( start );
+}
+
+static void BenchmarkThroughput()
+{
+	int nRounds = BenchFull() ? 50 : 2;
+	std::string sText = BuildBenchmarkText( 1 << 20 );
+	std::wstring wsText = UTF8to16( sText );
+	TEST_CHECK( wsText == StrReference::UTF8to16( sText ) );
+
+	std::string sOut;
+	std::vector< wchar_t > vecWide( wsText.size() );
+	std::vector< char > vecNarrow( sText.size() );
+	size_t unRequired;
+
+	double flRepairRef = MeasureMBps( sText.size(), nRounds, [&]() { StrReference::RepairUTF8( sText, sOut ); } );
+	double flRepair = MeasureMBps( sText.size(), nRounds, [&]() { RepairUTF8( sText, sOut ); } );
+	double flTo16Ref = MeasureMBps( sText.size(), nRounds, [&]() { StrReference::UTF8to16( sText ); } );
+	double flTo16 = MeasureMBps( sText.size(), nRounds, [&]() { UTF8to16( sText.data(), sText.size(), vecWide.data(), vecWide.size(), &unRequired ); } );
+	double flTo8Ref = MeasureMBps( sText.size(), nRounds, [&]() { StrReference::UTF16to8( wsText ); } );
+	double flTo8 = MeasureMBps( sText.size(), nRounds, [&]() { UTF16to8( wsText.data(), wsText.size(), vecNarrow.data(), vecNarrow.size(), &unRequired ); } );
+
+	printf( "RepairUTF8: %.0f MB/s (codecvt %.0f MB/s)\n", flRepair, flRepairRef );
+	printf( "UTF8to16 into a buffer: %.0f MB/s (codecvt %.0f MB/s)\n", flTo16, flTo16Ref );
+	printf( "UTF16to8 into a buffer: %.0f MB/s (codecvt %.0f MB/s)\n", flTo8, flTo8Ref );
+}
+
+int main()
+{
+	FuzzAgainstReference( BenchFull() ? 2000000 : 100000 );
+	BenchmarkThroughput();
+	return TestResult( "strtools_utf_test" );
+}
@@ -0,0 +1,50 @@
+//========= Copyright Valve Corporation ============//
+#pragma once
+
+// Lays out a runtime directory holding the stub vrclient, and a path registry that points
+// at it, so VR_Init and VR_IsHmdPresent find the stub instead of an installed SteamVR.
+
+#include <vrcore/pathtools_public.h>
+#include <vrcore/envvartools_public.h>
+#include <vrcore/vrpathregistry_public.h>
+#include <vrcore/dirtools_public.h>
+
+#include "test_common.h"
+#include "stub_vrclient.h"
+
+#include <string.h>
+
+/** Writes a registry whose runtime is sRuntimePath and points VR_PATHREG_OVERRIDE at it */
+inline bool StubRuntime_WriteRegistry( const std::string &sRegistryPath, const std::string &sRuntimePath )
+{
+	std::string sContents = "{\n\t\"jsonid\" : \"vrpathreg\",\n\t\"runtime\" : [ \"" + sRuntimePath + "\" ],\n"
+		"\t\"config\" : [ \"" + sRuntimePath + "/config\" ],\n\t\"log\" : [ \"" + sRuntimePath + "/logs\" ],\n\t\"version\" : 1\n}\n";
+	if ( !Path_WriteStringToTextFile( sRegistryPath, sContents.c_str() ) )
+		return false;
+
+	// nothing in the test's environment should take precedence over the registry
+	SetEnvironmentVariable( k_pchRuntimeOverrideVar, nullptr );
+	SetEnvironmentVariable( k_pchConfigOverrideVar, nullptr );
+	SetEnvironmentVariable( k_pchLogOverrideVar, nullptr );
+	return SetEnvironmentVariable( "VR_PATHREG_OVERRIDE", sRegistryPath.c_str() );
+}
+
+/** Copies the stub vrclient to where a runtime at sRuntimePath keeps vrclient */
+inline bool StubRuntime_Create( const std::string &sRuntimePath )
+{
+#if defined( WIN32 ) || defined( LINUX32 )
+	std::string sBinPath = Path_Join( sRuntimePath, "bin" );
+#else
+	std::string sBinPath = Path_Join( sRuntimePath, "bin", PLATSUBDIR );
+#endif
+	if ( !BCreateDirectoryRecursive( sBinPath.c_str() ) )
+		return false;
+
+#if defined( WIN64 )
+	std::string sClientPath = Path_Join( sBinPath, "vrclient_x64" DYNAMIC_LIB_EXT );
+#else
+	std::string sClientPath = Path_Join( sBinPath, "vrclient" DYNAMIC_LIB_EXT );
+#endif
+	std::vector< uint8_t > vecStub = Path_ReadBinaryFile( STUB_VRCLIENT_PATH );
+	return !vecStub.empty() && Path_WriteBinaryFile( sClientPath, vecStub.data(), ( unsigned )vecStub.size() );
+}
@@ -0,0 +1,7 @@
+//========= Copyright Valve Corporation ============//
+// A module with one export, for the sharedlibtools load and unload checks.
+
+extern "C" __attribute__( ( visibility( "default" ) ) ) int StubSharedLib_Double( int nValue )
+{
+	return nValue * 2;
+}
@@ -0,0 +1,85 @@
+//========= Copyright Valve Corporation ============//
+// A vrclient that does nothing but count what it was asked to do. Tests copy it into a
+// fake runtime directory and point the path registry at it.
+#include "openvr.h"
+#include "ivrclientcore.h"
+#include "stub_vrclient.h"
+
+#include <chrono>
+#include <thread>
+
+#if defined( POSIX )
+#include <dlfcn.h>
+#endif
+
+static StubVRClientCounters_t *GetCounters()
+{
+	static StubVRClientCounters_t s_localCounters;
+#if defined( POSIX )
+	static StubVRClientCounters_t *s_pCounters = ( StubVRClientCounters_t * )dlsym( RTLD_DEFAULT, STUB_VRCLIENT_COUNTERS_NAME );
+	if ( s_pCounters )
+		return s_pCounters;
+#endif
+	return &s_localCounters;
+}
+
+// The interface pointers handed out are never called through, they only need to be distinct
+static char g_rchInterfaces[ 1 ];
+
+class CStubVRClientCore : public vr::IVRClientCore
+{
+public:
+	vr::EVRInitError Init( vr::EVRApplicationType eApplicationType, const char *pStartupInfo ) override
+	{
+		GetCounters()->nInitCalls++;
+		if ( GetCounters()->nInitDelayMs > 0 )
+			std::this_thread::sleep_for( std::chrono::milliseconds( GetCounters()->nInitDelayMs ) );
+		return vr::VRInitError_None;
+	}
+
+	void Cleanup() override
+	{
+		GetCounters()->nCleanupCalls++;
+		if ( GetCounters()->nCleanupDelayMs > 0 )
+			std::this_thread::sleep_for( std::chrono::milliseconds( GetCounters()->nCleanupDelayMs ) );
+	}
+
+	vr::EVRInitError IsInterfaceVersionValid( const char *pchInterfaceVersion ) override
+	{
+		GetCounters()->nInterfaceValidCalls++;
+		return vr::VRInitError_None;
+	}
+
+	void *GetGenericInterface( const char *pchNameAndVersion, vr::EVRInitError *peError ) override
+	{
+		GetCounters()->nGetInterfaceCalls++;
+		if ( peError )
+			*peError = vr::VRInitError_None;
+		return g_rchInterfaces;
+	}
+
+	bool BIsHmdPresent() override
+	{
+		GetCounters()->nHmdPresentCalls++;
+		return GetCounters()->bHmdPresent;
+	}
+
+	const char *GetEnglishStringForHmdError( vr::EVRInitError eError ) override { return "stub error"; }
+	const char *GetIDForVRInitError( vr::EVRInitError eError ) override { return "StubError"; }
+};
+
+static CStubVRClientCore g_stubClientCore;
+
+struct StubLoadTracker_t
+{
+	StubLoadTracker_t() { GetCounters()->nLoads++; }
+	~StubLoadTracker_t() { GetCounters()->nUnloads++; }
+};
+
+static StubLoadTracker_t g_stubLoadTracker;
+
+STUB_VRCLIENT_EXPORT void *VRClientCoreFactory( const char *pInterfaceName, int *pReturnCode )
+{
+	GetCounters()->nFactoryCalls++;
+	return &g_stubClientCore;
+}
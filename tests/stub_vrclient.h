@@ -0,0 +1,33 @@
+//========= Copyright Valve Corporation ============//
+#pragma once
+
+// What the stub vrclient records about how it was used. The test executable defines
+// g_stubVRClientCounters and the stub finds it by name when it's loaded, so the counts
+// survive the stub being unloaded and loaded again.
+
+struct StubVRClientCounters_t
+{
+	int nLoads;					// static constructors run
+	int nUnloads;				// static destructors run
+	int nFactoryCalls;
+	int nInitCalls;
+	int nCleanupCalls;
+	int nHmdPresentCalls;
+	int nGetInterfaceCalls;
+	int nInterfaceValidCalls;
+
+	bool bHmdPresent;			// what BIsHmdPresent returns
+	int nInitDelayMs;			// how long Init takes, to stand in for a real runtime starting up
+	int nCleanupDelayMs;		// how long Cleanup takes, to stand in for a real runtime shutting down
+};
+
+#define STUB_VRCLIENT_COUNTERS_NAME "g_stubVRClientCounters"
+
+#if defined( _WIN32 )
+#define STUB_VRCLIENT_EXPORT extern "C" __declspec( dllexport )
+#else
+#define STUB_VRCLIENT_EXPORT extern "C" __attribute__( ( visibility( "default" ) ) )
+#endif
+
+/** Defined by every test that loads the stub */
+STUB_VRCLIENT_EXPORT StubVRClientCounters_t g_stubVRClientCounters;
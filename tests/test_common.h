@@ -0,0 +1,96 @@
+//========= Copyright Valve Corporation ============//
+#pragma once
+
+// Minimal checks shared by the tests. Each test is its own executable that returns
+// non-zero if any check failed, which is all ctest needs.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <chrono>
+
+#if defined( POSIX )
+#include <unistd.h>
+#include <ftw.h>
+#endif
+
+static int g_nTestFailures = 0;
+
+#define TEST_CHECK( cond ) \
+	do { \
+		if ( !( cond ) ) \
+		{ \
+			fprintf( stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond ); \
+			g_nTestFailures++; \
+		} \
+	} while ( 0 )
+
+#define TEST_CHECK_EQUAL( a, b ) \
+	do { \
+		long long _nA = ( long long )( a ); \
+		long long _nB = ( long long )( b ); \
+		if ( _nA != _nB ) \
+		{ \
+			fprintf( stderr, "%s:%d: check failed: %s == %s (%lld != %lld)\n", __FILE__, __LINE__, #a, #b, _nA, _nB ); \
+			g_nTestFailures++; \
+		} \
+	} while ( 0 )
+
+/** Returns the exit code for main */
+inline int TestResult( const char *pchTestName )
+{
+	if ( g_nTestFailures )
+		fprintf( stderr, "%s: %d check(s) failed\n", pchTestName, g_nTestFailures );
+	else
+		printf( "%s: passed\n", pchTestName );
+	return g_nTestFailures ? 1 : 0;
+}
+
+/** Benchmarks run a shorter pass under ctest. Set OPENVR_BENCH_FULL=1 for the numbers quoted in commits. */
+inline bool BenchFull()
+{
+	const char *pchFull = getenv( "OPENVR_BENCH_FULL" );
+	return pchFull && *pchFull && *pchFull != '0';
+}
+
+inline double BenchSecondsSince( std::chrono::steady_clock::time_point start )
+{
+	return std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+}
+
+#if defined( POSIX )
+//-----------------------------------------------------------------------------
+// Purpose: A scratch directory that is deleted with everything in it when the
+//			test is done with it
+//-----------------------------------------------------------------------------
+class CTestTempDir
+{
+public:
+	CTestTempDir()
+	{
+		char rchTemplate[] = "/tmp/openvr_test_XXXXXX";
+		const char *pchDir = mkdtemp( rchTemplate );
+		if ( pchDir )
+			m_sPath = pchDir;
+	}
+
+	~CTestTempDir()
+	{
+		if ( !m_sPath.empty() )
+			nftw( m_sPath.c_str(), RemoveEntry, 16, FTW_DEPTH | FTW_PHYS );
+	}
+
+	const std::string &Path() const { return m_sPath; }
+	std::string Path( const char *pchRelative ) const { return m_sPath + "/" + pchRelative; }
+
+private:
+	static int RemoveEntry( const char *pchPath, const struct stat *, int, struct FTW * )
+	{
+		remove( pchPath );
+		return 0;
+	}
+
+	std::string m_sPath;
+};
+#endif